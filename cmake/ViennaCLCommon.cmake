@@ -95,8 +95,12 @@ if (ENABLE_CUDA)
    set(CUDA_NVCC_FLAGS ${CUDA_NVCC_FLAGS} -arch=sm_13 -DVIENNACL_WITH_CUDA)
 endif(ENABLE_CUDA)
 
+# the OpenCL backend and the profiler (VIENNACL_WITH_PROFILER) protect their shared state with a mutex:
+find_package(Threads REQUIRED)
+
 if (ENABLE_OPENCL)
    find_package(OpenCL REQUIRED)
+   set(OPENCL_LIBRARIES ${OPENCL_LIBRARIES} ${CMAKE_THREAD_LIBS_INIT})
 endif(ENABLE_OPENCL)
 
 if (ENABLE_OPENMP)
@@ -43,6 +43,7 @@ struct autotuner_options{
     std::string layout;
     std::string scalartype;
     std::string output_name;
+    std::string database;
 
     unsigned int requested_device;
 
@@ -83,6 +84,9 @@ autotuner_options get_options(int argc, char* argv[]){
         //Output data file
         TCLAP::ValueArg<std::string> output_name_arg("o","output","Name of the output data file",true,"gemm_autotuning.dat","string",cmd);
 
+        //Tuning database
+        TCLAP::ValueArg<std::string> database_arg("","database","Tuning database file the best profile is merged into",false,"","string",cmd);
+
         //Device id
         TCLAP::ValueArg<unsigned int> requested_device_arg("d","device","ID of the device to use for the autotuning procedure",false,0,"unsigned int",cmd);
 
@@ -100,6 +104,7 @@ autotuner_options get_options(int argc, char* argv[]){
         options.layout = layout_arg.getValue();
         options.scalartype = scalartype_arg.getValue();
         options.output_name = output_name_arg.getValue();
+        options.database = database_arg.getValue();
         options.requested_device = requested_device_arg.getValue();
         options.vector_interval = vector_interval_arg.getValue();
         options.local_size_1_interval = local_size_1_interval_arg.getValue();
@@ -201,6 +206,8 @@ void run_autotune(autotuner_options const & options){
 
     //Recompiles for the best profile
     profile_type best_profile = timings.begin()->second;
+    if(!options.database.empty())
+      autotune::store_profile(device, key, 0, best_profile, options.database);
     viennacl::generator::code_generator dummy;
     dummy.add(statement,statement.array()[0]);
     dummy.force_profile(key, best_profile);
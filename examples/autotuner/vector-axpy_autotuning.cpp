@@ -44,6 +44,7 @@ struct autotuner_options{
 
     std::string scalartype;
     std::string output_name;
+    std::string database;
 
     unsigned int requested_device;
 
@@ -77,6 +78,9 @@ autotuner_options get_options(int argc, char* argv[]){
         //Output data file
         TCLAP::ValueArg<std::string> output_name_arg("o","output","Name of the output data file",true,"gemm_autotuning.dat","string",cmd);
 
+        //Tuning database
+        TCLAP::ValueArg<std::string> database_arg("","database","Tuning database file the best profile is merged into",false,"","string",cmd);
+
         //Device id
         TCLAP::ValueArg<unsigned int> requested_device_arg("d","device","ID of the device to use for the autotuning procedure",false,0,"unsigned int",cmd);
 
@@ -99,6 +103,7 @@ autotuner_options get_options(int argc, char* argv[]){
         options.tuning_size = tuning_size_arg.getValue();
         options.scalartype = scalartype_arg.getValue();
         options.output_name = output_name_arg.getValue();
+        options.database = database_arg.getValue();
         options.requested_device = requested_device_arg.getValue();
         options.vector_interval = vector_interval_arg.getValue();
         options.local_size_interval = local_size_interval_arg.getValue();
@@ -207,6 +212,8 @@ void run_autotune(autotuner_options const & options){
 
     //Recompiles for the best profile
     profile_type best_profile = timings.begin()->second;
+    if(!options.database.empty())
+      autotune::store_profile(device, key, 0, best_profile, options.database);
     viennacl::generator::code_generator dummy;
     dummy.add(statement,statement.array()[0]);
     dummy.force_profile(key, best_profile);
@@ -0,0 +1,518 @@
+#ifndef _BENCHMARK_HARNESS_HPP_
+#define _BENCHMARK_HARNESS_HPP_
+
+/* =========================================================================
+   Copyright (c) 2010-2013, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/*
+*   Common harness for benchmark suites: warmup, repetitions, statistics, bandwidth and flop rates,
+*   JSON output and comparison against a baseline run.
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#ifdef VIENNACL_WITH_OPENMP
+#include <omp.h>
+#endif
+
+#include "viennacl/backend/memory.hpp"
+#include "benchmark-utils.hpp"
+
+namespace benchmark
+{
+
+  /** @brief Base class for a single benchmark. run() executes the measured operation once.
+  *
+  * The bytes and flops passed to the constructor refer to one execution of run() and are used for the GB/s and GFLOP/s columns.
+  * Bytes are the minimum memory traffic of the operation, so that the rates can be compared directly with the peak bandwidth of the machine.
+  */
+  class benchmark_base
+  {
+    public:
+      benchmark_base(std::string const & name, double bytes = 0, double flops = 0) : name_(name), bytes_(bytes), flops_(flops) {}
+      virtual ~benchmark_base() {}
+
+      virtual void run() = 0;
+
+      /** @brief Additional values reported for the benchmark, e.g. the number of solver iterations. Queried after the last repetition. */
+      virtual void counters(std::map<std::string, double> & /*values*/) const {}
+
+      std::string const & name() const { return name_; }
+      double bytes() const { return bytes_; }
+      double flops() const { return flops_; }
+
+    private:
+      std::string name_;
+      double bytes_;
+      double flops_;
+  };
+
+
+  /** @brief Command line options of the harness */
+  struct options
+  {
+    options() : warmup(2), repetitions(10), min_time(0.5), tolerance(0.1), quick(false), list(false) {}
+
+    std::size_t warmup;          // untimed executions before calibration (fewer if they take longer than one sample)
+    std::size_t repetitions;     // number of timed samples
+    double min_time;             // minimum total time spent in the timed samples of a benchmark [s]
+    double tolerance;            // relative slowdown of the median reported as regression
+    bool quick;                  // small problem sizes and few repetitions, e.g. for smoke tests
+    bool list;                   // only print the names of the benchmarks
+    std::string filter;          // only run benchmarks whose name contains this string
+    std::string json_file;       // write results in JSON format to this file ("-" for stdout)
+    std::string baseline_file;   // JSON results of an earlier run to compare with
+
+    static void print_usage(char const * program)
+    {
+      std::cout << "Usage: " << program << " [options]" << std::endl
+                << "  --filter=<string>      Only run benchmarks whose name contains <string>" << std::endl
+                << "  --list                 Print the names of the benchmarks and exit" << std::endl
+                << "  --quick                Small problem sizes and few repetitions" << std::endl
+                << "  --warmup=<n>           Untimed executions before measuring (default: 2)" << std::endl
+                << "  --repetitions=<n>      Number of timed samples (default: 10)" << std::endl
+                << "  --min-time=<seconds>   Minimum time of all samples of a benchmark (default: 0.5)" << std::endl
+                << "  --json=<file>          Write the results in JSON format to <file> ('-' for stdout)" << std::endl
+                << "  --baseline=<file>      Compare with the JSON results of an earlier run" << std::endl
+                << "  --tolerance=<value>    Relative slowdown of the median reported as regression (default: 0.1)" << std::endl;
+    }
+
+    /** @brief Parses the command line. Returns false if the arguments are invalid or help was requested. */
+    bool parse(int argc, char ** argv)
+    {
+      for (int i=1; i<argc; ++i)
+      {
+        std::string arg(argv[i]);
+        std::string value;
+        std::size_t eq = arg.find('=');
+        if (eq != std::string::npos)
+        {
+          value = arg.substr(eq + 1);
+          arg = arg.substr(0, eq);
+        }
+
+        if (arg == "--filter")
+          filter = value;
+        else if (arg == "--list")
+          list = true;
+        else if (arg == "--quick")
+        {
+          quick = true;
+          warmup = 1;
+          repetitions = 3;
+          min_time = 0.01;
+        }
+        else if (arg == "--warmup")
+          warmup = static_cast<std::size_t>(std::atol(value.c_str()));
+        else if (arg == "--repetitions")
+          repetitions = std::max<std::size_t>(1, static_cast<std::size_t>(std::atol(value.c_str())));
+        else if (arg == "--min-time")
+          min_time = std::atof(value.c_str());
+        else if (arg == "--json")
+          json_file = value;
+        else if (arg == "--baseline")
+          baseline_file = value;
+        else if (arg == "--tolerance")
+          tolerance = std::atof(value.c_str());
+        else
+        {
+          if (arg != "--help")
+            std::cerr << "Unknown option: " << argv[i] << std::endl;
+          print_usage(argv[0]);
+          return false;
+        }
+      }
+      return true;
+    }
+  };
+
+
+  /** @brief Timings of one benchmark. All times are in seconds per execution of run(). */
+  struct result
+  {
+    result() : iterations(0), min(0), median(0), mean(0), stddev(0), bytes(0), flops(0) {}
+
+    std::string name;
+    std::size_t iterations;      // executions of run() per sample
+    std::vector<double> samples;
+    double min;
+    double median;
+    double mean;
+    double stddev;
+    double bytes;
+    double flops;
+    std::map<std::string, double> counters;
+
+    double bandwidth() const { return (bytes > 0 && median > 0) ? bytes / median / 1e9 : 0; }
+    double flop_rate() const { return (flops > 0 && median > 0) ? flops / median / 1e9 : 0; }
+
+    void compute_statistics()
+    {
+      std::vector<double> sorted(samples);
+      std::sort(sorted.begin(), sorted.end());
+      std::size_t n = sorted.size();
+
+      min = sorted[0];
+      median = (n % 2) ? sorted[n / 2] : (sorted[n / 2 - 1] + sorted[n / 2]) / 2.0;
+
+      mean = 0;
+      for (std::size_t i=0; i<n; ++i)
+        mean += sorted[i];
+      mean /= double(n);
+
+      stddev = 0;
+      for (std::size_t i=0; i<n; ++i)
+        stddev += (sorted[i] - mean) * (sorted[i] - mean);
+      stddev = (n > 1) ? std::sqrt(stddev / double(n - 1)) : 0;
+    }
+  };
+
+
+  namespace detail
+  {
+    inline std::string json_escape(std::string const & str)
+    {
+      std::string escaped;
+      for (std::size_t i=0; i<str.size(); ++i)
+      {
+        if (str[i] == '"' || str[i] == '\\')
+          escaped += '\\';
+        escaped += str[i];
+      }
+      return escaped;
+    }
+
+    /** @brief Returns the number following "key": in the line, or a negative value if the key is not found */
+    inline double json_number(std::string const & line, std::string const & key)
+    {
+      std::size_t pos = line.find("\"" + key + "\":");
+      if (pos == std::string::npos)
+        return -1;
+      return std::atof(line.c_str() + pos + key.size() + 3);
+    }
+
+    inline std::string json_string(std::string const & line, std::string const & key)
+    {
+      std::size_t pos = line.find("\"" + key + "\":\"");
+      if (pos == std::string::npos)
+        return std::string();
+      pos += key.size() + 4;
+      return line.substr(pos, line.find('"', pos) - pos);
+    }
+
+    /** @brief Formats a time given in seconds with a suitable unit */
+    inline std::string format_time(double seconds)
+    {
+      std::stringstream ss;
+      ss << std::fixed << std::setprecision(2);
+      if (seconds < 1e-3)
+        ss << seconds * 1e6 << " us";
+      else if (seconds < 1)
+        ss << seconds * 1e3 << " ms";
+      else
+        ss << seconds << " s";
+      return ss.str();
+    }
+  }
+
+
+  /** @brief Runs a collection of benchmarks and reports the results
+  *
+  * Each benchmark is executed 'warmup' times untimed. Then the number of executions per sample is calibrated such that
+  * a sample takes at least min_time / repetitions seconds, which keeps the resolution of the timer out of the results for short operations.
+  * Each sample is the average time per execution within one timed batch. The backend is synchronized at the end of each batch.
+  */
+  class harness
+  {
+    public:
+      explicit harness(options const & opts) : opts_(opts) {}
+
+      ~harness()
+      {
+        for (std::size_t i=0; i<benchmarks_.size(); ++i)
+          delete benchmarks_[i];
+      }
+
+      options const & opts() const { return opts_; }
+
+      /** @brief Returns true if a benchmark with the given name is selected by the filter */
+      bool selected(std::string const & name) const
+      {
+        return opts_.filter.empty() || name.find(opts_.filter) != std::string::npos;
+      }
+
+      /** @brief Returns true if one of the benchmarks of a group is selected, so that the setup of unused groups can be skipped.
+      *
+      * With --list the selected names are printed instead and false is returned.
+      */
+      bool any_selected(std::vector<std::string> const & names) const
+      {
+        bool found = false;
+        for (std::size_t i=0; i<names.size(); ++i)
+        {
+          if (selected(names[i]))
+          {
+            if (opts_.list)
+              std::cout << names[i] << std::endl;
+            found = true;
+          }
+        }
+        return found && !opts_.list;
+      }
+
+      /** @brief Adds a benchmark. The harness takes ownership. */
+      void add(benchmark_base * b)
+      {
+        if (selected(b->name()))
+          benchmarks_.push_back(b);
+        else
+          delete b;
+      }
+
+      /** @brief Runs all benchmarks added so far and removes them, so that the data of a group of benchmarks can be released afterwards. */
+      std::vector<result> const & run()
+      {
+        for (std::size_t i=0; i<benchmarks_.size(); ++i)
+        {
+          results_.push_back(measure(*benchmarks_[i]));
+          print(results_.back());
+          delete benchmarks_[i];
+        }
+        benchmarks_.clear();
+        return results_;
+      }
+
+      /** @brief Prints the header of the result table */
+      void print_header() const
+      {
+        if (opts_.list)
+          return;
+        std::cout << std::left << std::setw(48) << "Benchmark"
+                  << std::right << std::setw(14) << "Median"
+                  << std::setw(10) << "+/-"
+                  << std::setw(10) << "Iter"
+                  << std::setw(10) << "GB/s"
+                  << std::setw(10) << "GFLOP/s"
+                  << "  Counters" << std::endl;
+        std::cout << std::string(112, '-') << std::endl;
+      }
+
+      /** @brief Writes the JSON output and compares with the baseline, if requested. Returns the exit code of the suite. */
+      int finish() const
+      {
+        if (opts_.list)
+          return EXIT_SUCCESS;
+
+        if (opts_.json_file == "-")
+          write_json(std::cout);
+        else if (!opts_.json_file.empty())
+        {
+          std::ofstream file(opts_.json_file.c_str());
+          if (!file)
+          {
+            std::cerr << "Cannot open " << opts_.json_file << " for writing" << std::endl;
+            return EXIT_FAILURE;
+          }
+          write_json(file);
+        }
+
+        if (!opts_.baseline_file.empty())
+          return compare_with_baseline();
+
+        return EXIT_SUCCESS;
+      }
+
+      /** @brief Writes the results as a JSON document with one benchmark per line */
+      void write_json(std::ostream & os) const
+      {
+        int threads = 1;
+#ifdef VIENNACL_WITH_OPENMP
+        threads = omp_get_max_threads();
+#endif
+        os << std::setprecision(9);
+        os << "{\"context\":{\"date\":" << static_cast<long>(std::time(NULL))
+           << ",\"threads\":" << threads
+           << ",\"quick\":" << (opts_.quick ? "true" : "false")
+           << ",\"repetitions\":" << opts_.repetitions
+           << ",\"min_time\":" << opts_.min_time << "}," << std::endl;
+        os << "\"benchmarks\":[" << std::endl;
+        for (std::size_t i=0; i<results_.size(); ++i)
+        {
+          result const & r = results_[i];
+          os << "{\"name\":\"" << detail::json_escape(r.name) << "\""
+             << ",\"iterations\":" << r.iterations
+             << ",\"repetitions\":" << r.samples.size()
+             << ",\"min\":" << r.min
+             << ",\"median\":" << r.median
+             << ",\"mean\":" << r.mean
+             << ",\"stddev\":" << r.stddev
+             << ",\"bytes\":" << r.bytes
+             << ",\"flops\":" << r.flops
+             << ",\"GB/s\":" << r.bandwidth()
+             << ",\"GFLOP/s\":" << r.flop_rate()
+             << ",\"counters\":{";
+          for (std::map<std::string, double>::const_iterator it = r.counters.begin(); it != r.counters.end(); ++it)
+            os << (it == r.counters.begin() ? "" : ",") << "\"" << detail::json_escape(it->first) << "\":" << it->second;
+          os << "}}" << (i + 1 < results_.size() ? "," : "") << std::endl;
+        }
+        os << "]}" << std::endl;
+      }
+
+    private:
+      result measure(benchmark_base & b) const
+      {
+        result r;
+        r.name = b.name();
+        r.bytes = b.bytes();
+        r.flops = b.flops();
+
+        // warmup, cut short for long-running benchmarks such as solvers:
+        double sample_time = opts_.min_time / double(opts_.repetitions);
+        Timer warmup_timer;
+        warmup_timer.start();
+        for (std::size_t i=0; i<opts_.warmup; ++i)
+        {
+          b.run();
+          viennacl::backend::finish();
+          if (warmup_timer.get() > sample_time)
+            break;
+        }
+
+        // calibrate the number of executions per sample:
+        std::size_t iterations = 1;
+        while (true)
+        {
+          double t = time_batch(b, iterations);
+          if (t >= sample_time || iterations >= 1000000)
+            break;
+          double factor = (t > 0) ? 1.5 * sample_time / t : 10.0;
+          iterations = static_cast<std::size_t>(double(iterations) * std::min(10.0, std::max(2.0, factor)));
+        }
+
+        r.iterations = iterations;
+        for (std::size_t i=0; i<opts_.repetitions; ++i)
+          r.samples.push_back(time_batch(b, iterations) / double(iterations));
+
+        r.compute_statistics();
+        b.counters(r.counters);
+        return r;
+      }
+
+      static double time_batch(benchmark_base & b, std::size_t iterations)
+      {
+        Timer timer;
+        timer.start();
+        for (std::size_t i=0; i<iterations; ++i)
+          b.run();
+        viennacl::backend::finish();
+        return timer.get();
+      }
+
+      void print(result const & r) const
+      {
+        std::streamsize precision = std::cout.precision();
+        std::cout << std::left << std::setw(48) << r.name
+                  << std::right << std::setw(14) << detail::format_time(r.median)
+                  << std::setw(9) << std::fixed << std::setprecision(1) << (r.median > 0 ? 100.0 * r.stddev / r.median : 0.0) << "%"
+                  << std::setw(10) << r.iterations;
+        print_rate(r.bandwidth());
+        print_rate(r.flop_rate());
+        std::cout.unsetf(std::ios_base::floatfield);
+        std::cout.precision(precision);
+        std::cout << " ";
+        for (std::map<std::string, double>::const_iterator it = r.counters.begin(); it != r.counters.end(); ++it)
+          std::cout << " " << it->first << "=" << it->second;
+        std::cout << std::endl;
+      }
+
+      /** @brief Prints a rate with two digits, or '-' if the bytes or flops of the benchmark are not known */
+      static void print_rate(double rate)
+      {
+        if (rate > 0)
+          std::cout << std::setw(10) << std::setprecision(2) << rate;
+        else
+          std::cout << std::setw(10) << "-";
+      }
+
+      /** @brief Compares the medians with a baseline run. Returns EXIT_FAILURE if a benchmark is slower by more than the tolerance. */
+      int compare_with_baseline() const
+      {
+        std::ifstream file(opts_.baseline_file.c_str());
+        if (!file)
+        {
+          std::cerr << "Cannot open baseline " << opts_.baseline_file << std::endl;
+          return EXIT_FAILURE;
+        }
+
+        std::map<std::string, double> baseline;
+        std::string line;
+        while (std::getline(file, line))
+        {
+          std::string name = detail::json_string(line, "name");
+          double median = detail::json_number(line, "median");
+          if (!name.empty() && median > 0)
+            baseline[name] = median;
+        }
+
+        std::cout << std::endl << "Comparison with " << opts_.baseline_file << " (tolerance " << 100.0 * opts_.tolerance << "%):" << std::endl;
+        std::size_t regressions = 0;
+        for (std::size_t i=0; i<results_.size(); ++i)
+        {
+          std::map<std::string, double>::const_iterator it = baseline.find(results_[i].name);
+          if (it == baseline.end())
+            continue;
+
+          double ratio = results_[i].median / it->second;
+          char const * verdict = "";
+          if (ratio > 1.0 + opts_.tolerance)
+          {
+            verdict = "  REGRESSION";
+            ++regressions;
+          }
+          else if (ratio < 1.0 / (1.0 + opts_.tolerance))
+            verdict = "  improvement";
+
+          std::cout << std::left << std::setw(48) << results_[i].name
+                    << std::right << std::setw(14) << detail::format_time(it->second)
+                    << std::setw(14) << detail::format_time(results_[i].median)
+                    << std::setw(10) << std::fixed << std::setprecision(3) << ratio << verdict << std::endl;
+          std::cout.unsetf(std::ios_base::floatfield);
+          std::cout.precision(6);
+        }
+
+        std::cout << regressions << " regression(s) found." << std::endl;
+        return regressions ? EXIT_FAILURE : EXIT_SUCCESS;
+      }
+
+      options opts_;
+      std::vector<benchmark_base *> benchmarks_;
+      std::vector<result> results_;
+  };
+
+}
+
+#endif
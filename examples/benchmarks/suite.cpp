@@ -0,0 +1,657 @@
+/* =========================================================================
+   Copyright (c) 2010-2013, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/*
+*   Benchmark suite for the host backend: BLAS level 1, 2 and 3, SpMV for all sparse matrix formats
+*   on a collection of generated matrices, preconditioner setup and application, and time to solution of the iterative solvers.
+*
+*   Run with --help for the available options. Use --json=<file> to store the results of a release
+*   and --baseline=<file> to detect performance regressions in a later version.
+*/
+
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <map>
+#include <cmath>
+
+#include "viennacl/scalar.hpp"
+#include "viennacl/vector.hpp"
+#include "viennacl/matrix.hpp"
+#include "viennacl/compressed_matrix.hpp"
+#include "viennacl/compressed_compressed_matrix.hpp"
+#include "viennacl/coordinate_matrix.hpp"
+#include "viennacl/ell_matrix.hpp"
+#include "viennacl/hyb_matrix.hpp"
+#include "viennacl/rand/generator.hpp"
+#include "viennacl/tools/adapter.hpp"
+#include "viennacl/linalg/inner_prod.hpp"
+#include "viennacl/linalg/norm_2.hpp"
+#include "viennacl/linalg/prod.hpp"
+#include "viennacl/linalg/cg.hpp"
+#include "viennacl/linalg/bicgstab.hpp"
+#include "viennacl/linalg/gmres.hpp"
+#include "viennacl/linalg/jacobi_precond.hpp"
+#include "viennacl/linalg/row_scaling.hpp"
+#include "viennacl/linalg/ilu.hpp"
+#include "viennacl/linalg/ichol.hpp"
+#include "viennacl/linalg/block_jacobi_precond.hpp"
+
+#include "benchmark-harness.hpp"
+
+typedef double                                            ScalarType;
+typedef std::vector< std::map<unsigned int, ScalarType> > HostSparseMatrix;
+
+
+template <typename T>
+std::string to_string(T const & value)
+{
+  std::stringstream ss;
+  ss << value;
+  return ss.str();
+}
+
+
+//
+// Generated sparse matrices
+//
+
+/** @brief Five-point finite difference Laplacian on an n-by-n grid */
+HostSparseMatrix poisson_2d(std::size_t n)
+{
+  HostSparseMatrix A(n * n);
+  for (std::size_t i=0; i<n; ++i)
+    for (std::size_t j=0; j<n; ++j)
+    {
+      unsigned int row = static_cast<unsigned int>(i * n + j);
+      A[row][row] = 4;
+      if (i > 0)     A[row][row - n] = -1;
+      if (j > 0)     A[row][row - 1] = -1;
+      if (j + 1 < n) A[row][row + 1] = -1;
+      if (i + 1 < n) A[row][row + n] = -1;
+    }
+  return A;
+}
+
+/** @brief Seven-point finite difference Laplacian on an n-by-n-by-n grid */
+HostSparseMatrix poisson_3d(std::size_t n)
+{
+  HostSparseMatrix A(n * n * n);
+  for (std::size_t i=0; i<n; ++i)
+    for (std::size_t j=0; j<n; ++j)
+      for (std::size_t k=0; k<n; ++k)
+      {
+        unsigned int row = static_cast<unsigned int>((i * n + j) * n + k);
+        A[row][row] = 6;
+        if (i > 0)     A[row][row - n * n] = -1;
+        if (j > 0)     A[row][row - n]     = -1;
+        if (k > 0)     A[row][row - 1]     = -1;
+        if (k + 1 < n) A[row][row + 1]     = -1;
+        if (j + 1 < n) A[row][row + n]     = -1;
+        if (i + 1 < n) A[row][row + n * n] = -1;
+      }
+  return A;
+}
+
+/** @brief Nonsymmetric, diagonally dominant band matrix with 'bandwidth' off-diagonals on each side (upwind-like weights) */
+HostSparseMatrix banded(std::size_t n, std::size_t bandwidth)
+{
+  HostSparseMatrix A(n);
+  for (std::size_t i=0; i<n; ++i)
+  {
+    unsigned int row = static_cast<unsigned int>(i);
+    A[row][row] = ScalarType(2 * bandwidth + 1);
+    for (std::size_t k=1; k<=bandwidth; ++k)
+    {
+      if (i >= k)    A[row][static_cast<unsigned int>(i - k)] = ScalarType(-1.5) / ScalarType(k);
+      if (i + k < n) A[row][static_cast<unsigned int>(i + k)] = ScalarType(-0.5) / ScalarType(k);
+    }
+  }
+  return A;
+}
+
+/** @brief Upwind finite difference discretization of -Laplace(u) + c * du/dx on an n-by-n grid (nonsymmetric, not exactly factorized by ILU0) */
+HostSparseMatrix convection_diffusion_2d(std::size_t n, ScalarType c)
+{
+  HostSparseMatrix A(n * n);
+  for (std::size_t i=0; i<n; ++i)
+    for (std::size_t j=0; j<n; ++j)
+    {
+      unsigned int row = static_cast<unsigned int>(i * n + j);
+      A[row][row] = 4 + c;
+      if (i > 0)     A[row][row - n] = -1;
+      if (j > 0)     A[row][row - 1] = -1 - c;
+      if (j + 1 < n) A[row][row + 1] = -1;
+      if (i + 1 < n) A[row][row + n] = -1;
+    }
+  return A;
+}
+
+/** @brief Diagonally dominant matrix with randomly placed entries. The number of entries per row follows a power law (Pareto distribution with exponent 2.5), as for graphs of networks. */
+HostSparseMatrix power_law(std::size_t n, std::size_t min_entries, std::size_t max_entries)
+{
+  HostSparseMatrix A(n);
+  unsigned long state = 42;   // linear congruential generator, so that the matrix is the same on all platforms
+  for (std::size_t i=0; i<n; ++i)
+  {
+    state = (state * 1103515245UL + 12345UL) % 2147483648UL;
+    double u = (double(state) + 1.0) / 2147483649.0;
+    std::size_t entries = std::min(max_entries, static_cast<std::size_t>(double(min_entries) * std::pow(u, -1.0 / 1.5)));
+
+    unsigned int row = static_cast<unsigned int>(i);
+    for (std::size_t k=0; k<entries; ++k)
+    {
+      state = (state * 1103515245UL + 12345UL) % 2147483648UL;
+      A[row][static_cast<unsigned int>(state % n)] = -1;
+    }
+    A[row][row] = ScalarType(A[row].size() + 1);
+  }
+  return A;
+}
+
+
+//
+// BLAS level 1
+//
+
+class vector_copy_benchmark : public benchmark::benchmark_base
+{
+  public:
+    vector_copy_benchmark(viennacl::vector<ScalarType> const & x, viennacl::vector<ScalarType> & y)
+      : benchmark::benchmark_base("blas1/copy/" + to_string(x.size()), 2.0 * x.size() * sizeof(ScalarType)), x_(x), y_(y) {}
+
+    void run() { y_ = x_; }
+
+  private:
+    viennacl::vector<ScalarType> const & x_;
+    viennacl::vector<ScalarType> & y_;
+};
+
+class vector_axpy_benchmark : public benchmark::benchmark_base
+{
+  public:
+    vector_axpy_benchmark(viennacl::vector<ScalarType> const & x, viennacl::vector<ScalarType> & y)
+      : benchmark::benchmark_base("blas1/axpy/" + to_string(x.size()), 3.0 * x.size() * sizeof(ScalarType), 2.0 * x.size()), x_(x), y_(y) {}
+
+    void run() { y_ += ScalarType(1e-3) * x_; }
+
+  private:
+    viennacl::vector<ScalarType> const & x_;
+    viennacl::vector<ScalarType> & y_;
+};
+
+class inner_prod_benchmark : public benchmark::benchmark_base
+{
+  public:
+    inner_prod_benchmark(viennacl::vector<ScalarType> const & x, viennacl::vector<ScalarType> const & y)
+      : benchmark::benchmark_base("blas1/inner_prod/" + to_string(x.size()), 2.0 * x.size() * sizeof(ScalarType), 2.0 * x.size()), x_(x), y_(y), result_(0) {}
+
+    void run() { result_ = viennacl::linalg::inner_prod(x_, y_); }
+
+  private:
+    viennacl::vector<ScalarType> const & x_;
+    viennacl::vector<ScalarType> const & y_;
+    viennacl::scalar<ScalarType> result_;
+};
+
+class norm_2_benchmark : public benchmark::benchmark_base
+{
+  public:
+    norm_2_benchmark(viennacl::vector<ScalarType> const & x)
+      : benchmark::benchmark_base("blas1/norm_2/" + to_string(x.size()), 1.0 * x.size() * sizeof(ScalarType), 2.0 * x.size()), x_(x), result_(0) {}
+
+    void run() { result_ = viennacl::linalg::norm_2(x_); }
+
+  private:
+    viennacl::vector<ScalarType> const & x_;
+    viennacl::scalar<ScalarType> result_;
+};
+
+/** @brief Inner products of x with k vectors, as in the orthogonalization of Krylov methods */
+class multi_inner_prod_benchmark : public benchmark::benchmark_base
+{
+  public:
+    multi_inner_prod_benchmark(viennacl::vector<ScalarType> const & x, std::vector<viennacl::vector_base<ScalarType> const *> const & y)
+      : benchmark::benchmark_base("blas1/multi_inner_prod/" + to_string(y.size()) + "x" + to_string(x.size()),
+                                  (y.size() + 1.0) * x.size() * sizeof(ScalarType), 2.0 * y.size() * x.size()),
+        x_(x), y_(y), result_(y.size()) {}
+
+    void run() { result_ = viennacl::linalg::inner_prod(x_, y_); }
+
+  private:
+    viennacl::vector<ScalarType> const & x_;
+    viennacl::vector_tuple<ScalarType> y_;
+    viennacl::vector<ScalarType> result_;
+};
+
+/** @brief x += alpha_1 y_1 + ... + alpha_k y_k, as in the update of the GMRES solution */
+class multi_axpy_benchmark : public benchmark::benchmark_base
+{
+  public:
+    multi_axpy_benchmark(viennacl::vector<ScalarType> & x, std::vector<viennacl::vector_base<ScalarType> const *> const & y)
+      : benchmark::benchmark_base("blas1/multi_axpy/" + to_string(y.size()) + "x" + to_string(x.size()),
+                                  (y.size() + 2.0) * x.size() * sizeof(ScalarType), 2.0 * y.size() * x.size()),
+        x_(x), y_(y), alpha_(viennacl::scalar_vector<ScalarType>(y.size(), ScalarType(1e-3))) {}
+
+    void run() { viennacl::linalg::multi_axpy(x_, alpha_, y_); }
+
+  private:
+    viennacl::vector<ScalarType> & x_;
+    viennacl::vector_tuple<ScalarType> y_;
+    viennacl::vector<ScalarType> alpha_;
+};
+
+void blas1_benchmarks(benchmark::harness & h)
+{
+  std::size_t n = h.opts().quick ? (1 << 16) : (1 << 22);
+  std::size_t k = 8;
+
+  std::vector<std::string> names;
+  names.push_back("blas1/copy/" + to_string(n));
+  names.push_back("blas1/axpy/" + to_string(n));
+  names.push_back("blas1/inner_prod/" + to_string(n));
+  names.push_back("blas1/norm_2/" + to_string(n));
+  names.push_back("blas1/multi_inner_prod/" + to_string(k) + "x" + to_string(n));
+  names.push_back("blas1/multi_axpy/" + to_string(k) + "x" + to_string(n));
+  if (!h.any_selected(names))
+    return;
+
+  viennacl::vector<ScalarType> x = viennacl::random_vector<ScalarType>(n, viennacl::rand::uniform_tag(), 1);
+  viennacl::vector<ScalarType> y = viennacl::random_vector<ScalarType>(n, viennacl::rand::uniform_tag(), 2);
+
+  std::vector<viennacl::vector<ScalarType> > basis(k);
+  std::vector<viennacl::vector_base<ScalarType> const *> basis_ptrs(k);
+  for (std::size_t i=0; i<k; ++i)
+  {
+    basis[i] = viennacl::random_vector<ScalarType>(n, viennacl::rand::uniform_tag(), static_cast<unsigned int>(3 + i));
+    basis_ptrs[i] = &(basis[i]);
+  }
+
+  h.add(new vector_copy_benchmark(x, y));
+  h.add(new vector_axpy_benchmark(x, y));
+  h.add(new inner_prod_benchmark(x, y));
+  h.add(new norm_2_benchmark(x));
+  h.add(new multi_inner_prod_benchmark(x, basis_ptrs));
+  h.add(new multi_axpy_benchmark(y, basis_ptrs));
+  h.run();
+}
+
+
+//
+// BLAS level 2 and 3
+//
+
+template <typename F>
+std::string layout_name() { return viennacl::is_row_major<F>::value ? "row" : "col"; }
+
+template <typename F>
+class gemv_benchmark : public benchmark::benchmark_base
+{
+  public:
+    gemv_benchmark(viennacl::matrix<ScalarType, F> const & A, viennacl::vector<ScalarType> const & x, viennacl::vector<ScalarType> & y, bool transposed)
+      : benchmark::benchmark_base(std::string("blas2/gemv") + (transposed ? "_trans/" : "/") + layout_name<F>() + "/" + to_string(A.size1()) + "x" + to_string(A.size2()),
+                                  (double(A.size1()) * A.size2() + A.size1() + A.size2()) * sizeof(ScalarType), 2.0 * A.size1() * A.size2()),
+        A_(A), x_(x), y_(y), transposed_(transposed) {}
+
+    void run()
+    {
+      if (transposed_)
+        y_ = viennacl::linalg::prod(trans(A_), x_);
+      else
+        y_ = viennacl::linalg::prod(A_, x_);
+    }
+
+  private:
+    viennacl::matrix<ScalarType, F> const & A_;
+    viennacl::vector<ScalarType> const & x_;
+    viennacl::vector<ScalarType> & y_;
+    bool transposed_;
+};
+
+template <typename F>
+class gemm_benchmark : public benchmark::benchmark_base
+{
+  public:
+    gemm_benchmark(viennacl::matrix<ScalarType, F> const & A, viennacl::matrix<ScalarType, F> const & B, viennacl::matrix<ScalarType, F> & C)
+      : benchmark::benchmark_base("blas3/gemm/" + layout_name<F>() + "/" + to_string(A.size1()),
+                                  3.0 * A.size1() * A.size2() * sizeof(ScalarType), 2.0 * A.size1() * A.size2() * B.size2()),
+        A_(A), B_(B), C_(C) {}
+
+    void run() { C_ = viennacl::linalg::prod(A_, B_); }
+
+  private:
+    viennacl::matrix<ScalarType, F> const & A_;
+    viennacl::matrix<ScalarType, F> const & B_;
+    viennacl::matrix<ScalarType, F> & C_;
+};
+
+template <typename F>
+void dense_benchmarks(benchmark::harness & h)
+{
+  std::size_t n2 = h.opts().quick ? 256 : 2048;
+  std::size_t n3 = h.opts().quick ? 128 : 1024;
+  std::string suffix2 = layout_name<F>() + "/" + to_string(n2) + "x" + to_string(n2);
+
+  std::vector<std::string> names;
+  names.push_back("blas2/gemv/" + suffix2);
+  names.push_back("blas2/gemv_trans/" + suffix2);
+  names.push_back("blas3/gemm/" + layout_name<F>() + "/" + to_string(n3));
+  if (!h.any_selected(names))
+    return;
+
+  {
+    viennacl::matrix<ScalarType, F> A(n2, n2);
+    viennacl::rand::generator(10).fill(A, viennacl::rand::uniform_tag());
+    viennacl::vector<ScalarType> x = viennacl::random_vector<ScalarType>(n2, viennacl::rand::uniform_tag(), 11);
+    viennacl::vector<ScalarType> y(n2);
+    h.add(new gemv_benchmark<F>(A, x, y, false));
+    h.add(new gemv_benchmark<F>(A, x, y, true));
+    h.run();
+  }
+
+  viennacl::matrix<ScalarType, F> B(n3, n3);
+  viennacl::matrix<ScalarType, F> C(n3, n3);
+  viennacl::rand::generator gen(12);
+  gen.fill(B, viennacl::rand::uniform_tag());
+  gen.fill(C, viennacl::rand::uniform_tag());
+  viennacl::matrix<ScalarType, F> D(n3, n3);
+  h.add(new gemm_benchmark<F>(B, C, D));
+  h.run();
+}
+
+
+//
+// Sparse matrix-vector products
+//
+
+template <typename SparseMatrixType>
+class spmv_benchmark : public benchmark::benchmark_base
+{
+  public:
+    spmv_benchmark(std::string const & name, SparseMatrixType const & A, viennacl::vector<ScalarType> const & x, viennacl::vector<ScalarType> & y)
+      : benchmark::benchmark_base(name,
+                                  viennacl::linalg::detail::spmv_matrix_bytes(A) + (double(A.size1()) + A.size2()) * sizeof(ScalarType),
+                                  2.0 * viennacl::linalg::detail::spmv_nonzeros(A)),
+        A_(A), x_(x), y_(y) {}
+
+    void run() { y_ = viennacl::linalg::prod(A_, x_); }
+
+  private:
+    SparseMatrixType const & A_;
+    viennacl::vector<ScalarType> const & x_;
+    viennacl::vector<ScalarType> & y_;
+};
+
+/** @brief SpMV for all sparse matrix formats. ELL is skipped if the padding to the longest row more than quadruples the storage. */
+void spmv_benchmarks(benchmark::harness & h, std::string const & matrix_name, HostSparseMatrix const & host_matrix)
+{
+  std::size_t nnz = 0;
+  std::size_t max_row_length = 0;
+  for (std::size_t i=0; i<host_matrix.size(); ++i)
+  {
+    nnz += host_matrix[i].size();
+    max_row_length = std::max(max_row_length, host_matrix[i].size());
+  }
+  bool use_ell = (max_row_length * host_matrix.size() <= 4 * nnz);
+
+  std::vector<std::string> names;
+  names.push_back("spmv/csr/" + matrix_name);
+  names.push_back("spmv/coo/" + matrix_name);
+  names.push_back("spmv/compressed_compressed/" + matrix_name);
+  names.push_back("spmv/hyb/" + matrix_name);
+  if (use_ell)
+    names.push_back("spmv/ell/" + matrix_name);
+  if (!h.any_selected(names))
+    return;
+
+  std::size_t n = host_matrix.size();
+  viennacl::vector<ScalarType> x = viennacl::random_vector<ScalarType>(n, viennacl::rand::uniform_tag(), 20);
+  viennacl::vector<ScalarType> y(n);
+
+  viennacl::compressed_matrix<ScalarType> A_csr(n, n);
+  viennacl::coordinate_matrix<ScalarType> A_coo(n, n);
+  viennacl::compressed_compressed_matrix<ScalarType> A_cc(n, n);
+  viennacl::hyb_matrix<ScalarType> A_hyb;
+  viennacl::ell_matrix<ScalarType> A_ell;
+
+  if (h.selected(names[0])) viennacl::copy(host_matrix, A_csr);
+  if (h.selected(names[1])) viennacl::copy(host_matrix, A_coo);
+  if (h.selected(names[2])) viennacl::copy(host_matrix, A_cc);
+  if (h.selected(names[3])) viennacl::copy(viennacl::tools::const_sparse_matrix_adapter<ScalarType>(host_matrix), A_hyb);
+  if (use_ell && h.selected(names[4])) viennacl::copy(viennacl::tools::const_sparse_matrix_adapter<ScalarType>(host_matrix), A_ell);
+
+  h.add(new spmv_benchmark<viennacl::compressed_matrix<ScalarType> >(names[0], A_csr, x, y));
+  h.add(new spmv_benchmark<viennacl::coordinate_matrix<ScalarType> >(names[1], A_coo, x, y));
+  h.add(new spmv_benchmark<viennacl::compressed_compressed_matrix<ScalarType> >(names[2], A_cc, x, y));
+  h.add(new spmv_benchmark<viennacl::hyb_matrix<ScalarType> >(names[3], A_hyb, x, y));
+  if (use_ell)
+    h.add(new spmv_benchmark<viennacl::ell_matrix<ScalarType> >(names[4], A_ell, x, y));
+  h.run();
+}
+
+
+//
+// Preconditioners
+//
+
+typedef viennacl::compressed_matrix<ScalarType>  CSRMatrix;
+
+/** @brief Setup of a preconditioner. The setup is carried out in the constructor of the preconditioner. */
+template <typename PrecondType, typename TagType>
+class precond_setup_benchmark : public benchmark::benchmark_base
+{
+  public:
+    precond_setup_benchmark(std::string const & name, CSRMatrix const & A, TagType const & tag)
+      : benchmark::benchmark_base("precond_setup/" + name), A_(A), tag_(tag) {}
+
+    void run() { PrecondType precond(A_, tag_); }
+
+  private:
+    CSRMatrix const & A_;
+    TagType tag_;
+};
+
+/** @brief Application of a preconditioner. Since apply() works in-place, the vector is reset before each application, which is included in the bytes (if known). */
+template <typename PrecondType, typename TagType>
+class precond_apply_benchmark : public benchmark::benchmark_base
+{
+  public:
+    precond_apply_benchmark(std::string const & name, CSRMatrix const & A, TagType const & tag, viennacl::vector<ScalarType> const & rhs, double bytes)
+      : benchmark::benchmark_base("precond_apply/" + name, (bytes > 0) ? bytes + 2.0 * rhs.size() * sizeof(ScalarType) : 0), tag_(tag), precond_(A, tag_), rhs_(rhs), x_(rhs.size()) {}
+
+    void run()
+    {
+      x_ = rhs_;
+      precond_.apply(x_);
+    }
+
+  private:
+    TagType tag_;           // some preconditioners keep a reference to the tag
+    PrecondType precond_;
+    viennacl::vector<ScalarType> const & rhs_;
+    viennacl::vector<ScalarType> x_;
+};
+
+template <typename PrecondType, typename TagType>
+void add_precond_benchmarks(benchmark::harness & h, std::string const & name, CSRMatrix const & A, TagType const & tag,
+                            viennacl::vector<ScalarType> const & rhs, double apply_bytes)
+{
+  h.add(new precond_setup_benchmark<PrecondType, TagType>(name, A, tag));
+  if (h.selected("precond_apply/" + name))
+    h.add(new precond_apply_benchmark<PrecondType, TagType>(name, A, tag, rhs, apply_bytes));
+}
+
+void precond_benchmarks(benchmark::harness & h)
+{
+  std::size_t grid = h.opts().quick ? 64 : 256;
+  std::string matrix_name = "poisson2d_" + to_string(grid);
+
+  char const * precond_names[] = { "jacobi", "row_scaling", "ilu0", "ilut", "ichol0", "block_jacobi" };
+  std::vector<std::string> names;
+  for (std::size_t i=0; i<sizeof(precond_names) / sizeof(precond_names[0]); ++i)
+  {
+    names.push_back("precond_setup/" + std::string(precond_names[i]) + "/" + matrix_name);
+    names.push_back("precond_apply/" + std::string(precond_names[i]) + "/" + matrix_name);
+  }
+  if (!h.any_selected(names))
+    return;
+
+  HostSparseMatrix host_matrix = poisson_2d(grid);
+  CSRMatrix A(host_matrix.size(), host_matrix.size());
+  viennacl::copy(host_matrix, A);
+  viennacl::vector<ScalarType> rhs = viennacl::random_vector<ScalarType>(A.size1(), viennacl::rand::uniform_tag(), 30);
+
+  double n = double(A.size1());
+  double vector_bytes = n * sizeof(ScalarType);
+  double csr_bytes = viennacl::linalg::detail::spmv_matrix_bytes(A);
+
+  add_precond_benchmarks<viennacl::linalg::jacobi_precond<CSRMatrix> >(h, "jacobi/" + matrix_name, A, viennacl::linalg::jacobi_tag(), rhs, 3 * vector_bytes);
+  add_precond_benchmarks<viennacl::linalg::row_scaling<CSRMatrix> >(h, "row_scaling/" + matrix_name, A, viennacl::linalg::row_scaling_tag(), rhs, 3 * vector_bytes);
+  add_precond_benchmarks<viennacl::linalg::ilu0_precond<CSRMatrix> >(h, "ilu0/" + matrix_name, A, viennacl::linalg::ilu0_tag(), rhs, csr_bytes + 2 * vector_bytes);
+  add_precond_benchmarks<viennacl::linalg::ilut_precond<CSRMatrix> >(h, "ilut/" + matrix_name, A, viennacl::linalg::ilut_tag(), rhs, 0); // fill-in not known
+  add_precond_benchmarks<viennacl::linalg::ichol0_precond<CSRMatrix> >(h, "ichol0/" + matrix_name, A, viennacl::linalg::ichol0_tag(), rhs, csr_bytes + 2 * vector_bytes);
+  add_precond_benchmarks<viennacl::linalg::block_jacobi_precond<CSRMatrix> >(h, "block_jacobi/" + matrix_name, A, viennacl::linalg::block_jacobi_tag(4), rhs, 4 * n * sizeof(ScalarType) + 2 * vector_bytes);
+  h.run();
+}
+
+
+//
+// Iterative solvers
+//
+
+/** @brief Time to solution of an iterative solver including the setup of the preconditioner. Reports the number of iterations and the estimated relative residual. */
+template <typename SolverTag, typename PrecondType, typename PrecondTag>
+class solver_benchmark : public benchmark::benchmark_base
+{
+  public:
+    solver_benchmark(std::string const & name, CSRMatrix const & A, viennacl::vector<ScalarType> const & rhs,
+                     SolverTag const & solver_tag, PrecondTag const & precond_tag)
+      : benchmark::benchmark_base("solver/" + name), A_(A), rhs_(rhs), solver_tag_(solver_tag), precond_tag_(precond_tag) {}
+
+    void run()
+    {
+      PrecondType precond(A_, precond_tag_);
+      x_ = viennacl::linalg::solve(A_, rhs_, solver_tag_, precond);
+    }
+
+    void counters(std::map<std::string, double> & values) const
+    {
+      values["iterations"] = solver_tag_.iters();
+      values["error"] = solver_tag_.error();
+    }
+
+  private:
+    CSRMatrix const & A_;
+    viennacl::vector<ScalarType> const & rhs_;
+    viennacl::vector<ScalarType> x_;
+    SolverTag solver_tag_;
+    PrecondTag precond_tag_;
+};
+
+/** @brief No preconditioner, constructible like the other preconditioners */
+struct no_precond_type : public viennacl::linalg::no_precond
+{
+  no_precond_type(CSRMatrix const &, viennacl::linalg::no_precond const &) {}
+};
+
+template <typename SolverTag, typename PrecondType, typename PrecondTag>
+void add_solver_benchmark(benchmark::harness & h, std::string const & name, CSRMatrix const & A, viennacl::vector<ScalarType> const & rhs,
+                          SolverTag const & solver_tag, PrecondTag const & precond_tag)
+{
+  h.add(new solver_benchmark<SolverTag, PrecondType, PrecondTag>(name, A, rhs, solver_tag, precond_tag));
+}
+
+void solver_benchmarks(benchmark::harness & h)
+{
+  std::size_t grid = h.opts().quick ? 32 : 256;
+  std::string poisson_name = "poisson2d_" + to_string(grid);
+  std::string convection_name = "convection2d_" + to_string(grid);
+
+  std::vector<std::string> names;
+  names.push_back("solver/cg/none/" + poisson_name);
+  names.push_back("solver/cg/jacobi/" + poisson_name);
+  names.push_back("solver/cg/ichol0/" + poisson_name);
+  names.push_back("solver/bicgstab/none/" + convection_name);
+  names.push_back("solver/bicgstab/ilu0/" + convection_name);
+  names.push_back("solver/gmres/none/" + convection_name);
+  names.push_back("solver/gmres/ilu0/" + convection_name);
+  if (!h.any_selected(names))
+    return;
+
+  viennacl::linalg::cg_tag cg_tag(1e-8, 10000);
+  viennacl::linalg::bicgstab_tag bicgstab_tag(1e-8, 10000);
+  viennacl::linalg::gmres_tag gmres_tag(1e-8, 10000, 30);
+
+  HostSparseMatrix host_poisson = poisson_2d(grid);
+  CSRMatrix poisson(host_poisson.size(), host_poisson.size());
+  viennacl::copy(host_poisson, poisson);
+  viennacl::vector<ScalarType> poisson_rhs = viennacl::scalar_vector<ScalarType>(poisson.size1(), ScalarType(1));
+
+  add_solver_benchmark<viennacl::linalg::cg_tag, no_precond_type>(h, "cg/none/" + poisson_name, poisson, poisson_rhs, cg_tag, viennacl::linalg::no_precond());
+  add_solver_benchmark<viennacl::linalg::cg_tag, viennacl::linalg::jacobi_precond<CSRMatrix> >(h, "cg/jacobi/" + poisson_name, poisson, poisson_rhs, cg_tag, viennacl::linalg::jacobi_tag());
+  add_solver_benchmark<viennacl::linalg::cg_tag, viennacl::linalg::ichol0_precond<CSRMatrix> >(h, "cg/ichol0/" + poisson_name, poisson, poisson_rhs, cg_tag, viennacl::linalg::ichol0_tag());
+
+  HostSparseMatrix host_convection = convection_diffusion_2d(grid, 1);
+  CSRMatrix convection(host_convection.size(), host_convection.size());
+  viennacl::copy(host_convection, convection);
+  viennacl::vector<ScalarType> convection_rhs = viennacl::random_vector<ScalarType>(convection.size1(), viennacl::rand::uniform_tag(), 40);
+
+  add_solver_benchmark<viennacl::linalg::bicgstab_tag, no_precond_type>(h, "bicgstab/none/" + convection_name, convection, convection_rhs, bicgstab_tag, viennacl::linalg::no_precond());
+  add_solver_benchmark<viennacl::linalg::bicgstab_tag, viennacl::linalg::ilu0_precond<CSRMatrix> >(h, "bicgstab/ilu0/" + convection_name, convection, convection_rhs, bicgstab_tag, viennacl::linalg::ilu0_tag());
+  add_solver_benchmark<viennacl::linalg::gmres_tag, no_precond_type>(h, "gmres/none/" + convection_name, convection, convection_rhs, gmres_tag, viennacl::linalg::no_precond());
+  add_solver_benchmark<viennacl::linalg::gmres_tag, viennacl::linalg::ilu0_precond<CSRMatrix> >(h, "gmres/ilu0/" + convection_name, convection, convection_rhs, gmres_tag, viennacl::linalg::ilu0_tag());
+  h.run();
+}
+
+
+int main(int argc, char ** argv)
+{
+  benchmark::options opts;
+  if (!opts.parse(argc, argv))
+    return EXIT_FAILURE;
+
+  benchmark::harness h(opts);
+
+  if (!opts.list)
+  {
+    std::cout << std::endl;
+    std::cout << "----------------------------------------------" << std::endl;
+    std::cout << "               Benchmark suite" << std::endl;
+    std::cout << "----------------------------------------------" << std::endl;
+    std::cout << std::endl;
+  }
+  h.print_header();
+
+  blas1_benchmarks(h);
+  dense_benchmarks<viennacl::row_major>(h);
+  dense_benchmarks<viennacl::column_major>(h);
+
+  // sparse matrix collection with 4096 (quick) or 262144 rows each:
+  std::size_t grid_2d = opts.quick ? 64 : 512;
+  std::size_t grid_3d = opts.quick ? 16 : 64;
+  std::size_t rows = grid_2d * grid_2d;
+  spmv_benchmarks(h, "poisson2d_" + to_string(grid_2d), poisson_2d(grid_2d));
+  spmv_benchmarks(h, "poisson3d_" + to_string(grid_3d), poisson_3d(grid_3d));
+  spmv_benchmarks(h, "banded_" + to_string(rows), banded(rows, 8));
+  spmv_benchmarks(h, "power_law_" + to_string(rows), power_law(rows, 2, opts.quick ? 64 : 512));
+
+  precond_benchmarks(h);
+  solver_benchmarks(h);
+
+  return h.finish();
+}
@@ -33,7 +33,10 @@
 //include basic scalar and vector types of ViennaCL
 #include "viennacl/scalar.hpp"
 #include "viennacl/vector.hpp"
+#include "viennacl/matrix.hpp"
 #include "viennacl/compressed_matrix.hpp"
+#include "viennacl/linalg/prod.hpp"
+#include "viennacl/linalg/norm_2.hpp"
 
 
 #include "viennacl/linalg/lanczos.hpp"
@@ -66,6 +69,22 @@ std::vector<double> initEig(MatrixType const & A)
   return lanczos_eigenvalues;
 }
 
+template <typename MatrixType>
+void initEigVectors(MatrixType const & A)
+{
+  // The thick-restart variant keeps the Krylov space small and computes the eigenvectors from the Lanczos basis:
+  viennacl::linalg::lanczos_tag ltag(0.75, 10, viennacl::linalg::lanczos_tag::thick_restart, 100);
+  viennacl::matrix<double, viennacl::column_major> eigenvectors;
+  std::vector<double> lanczos_eigenvalues = viennacl::linalg::eig(A, eigenvectors, ltag);
+  for(std::size_t i = 0; i< lanczos_eigenvalues.size(); i++){
+          viennacl::vector<double> x = viennacl::column(eigenvectors, static_cast<unsigned int>(i));
+          viennacl::vector<double> residual = viennacl::linalg::prod(A, x);
+          residual -= lanczos_eigenvalues[i] * x;
+          std::cout << "Eigenvalue " << i+1 << ": " << std::setprecision(10) << lanczos_eigenvalues[i]
+                    << " (residual norm: " << viennacl::linalg::norm_2(residual) << ")" << std::endl;
+  }
+}
+
 
 int main()
 {
@@ -79,7 +98,14 @@ int main()
     return 0;
   }
 
+  // The Lanczos basis is kept in the memory domain of the system matrix, so the matrix is first copied to ViennaCL:
+  viennacl::compressed_matrix<ScalarType> A(ublas_A.size1(), ublas_A.size2());
+  viennacl::copy(ublas_A, A);
+
   std::cout << "Running Lanczos algorithm (this might take a while)..." << std::endl;
-  std::vector<double> eigenvalues = initEig(ublas_A);
+  std::vector<double> eigenvalues = initEig(A);
+
+  std::cout << "Running thick-restart Lanczos algorithm with eigenvectors..." << std::endl;
+  initEigVectors(A);
 }
 
@@ -17,7 +17,7 @@
 
 /*
 *
-*   Tutorial: Using ViennaCL with multiple threads, one thread per GPU
+*   Tutorial: Using ViennaCL with multiple threads, one thread per GPU, and multiple threads sharing a context
 *
 */
 
@@ -66,6 +66,24 @@ void thread_func(std::string * message, std::size_t thread_id) //Note: using ref
   *message = ss.str();
 }
 
+template <typename T>
+void shared_context_thread_func(std::string * message, std::size_t thread_id)
+{
+  std::size_t N = 6;
+
+  // No context is specified, hence all threads work in their current context (the default context with ID 0).
+  // Each thread obtains its own kernel objects, so the same kernels may be launched concurrently:
+  viennacl::vector<T> u = viennacl::scalar_vector<T>(N, T(1) * (thread_id + 1));
+  viennacl::vector<T> v = viennacl::scalar_vector<T>(N, T(2) * (thread_id + 1));
+
+  u += v;
+  T result = viennacl::linalg::norm_2(u);
+
+  std::stringstream ss;
+  ss << "Result of thread " << thread_id << " in shared context: " << result << std::endl;
+  *message = ss.str();
+}
+
 
 int main()
 {
@@ -108,6 +126,19 @@ int main()
   std::cout << message0 << std::endl;
   std::cout << message1 << std::endl;
 
+  //
+  // Part 3: Let two threads operate concurrently in the same context. Programs are compiled only once and shared by all threads.
+  //
+
+  boost::thread worker_2(shared_context_thread_func<ScalarType>, &message0, 2);
+  boost::thread worker_3(shared_context_thread_func<ScalarType>, &message1, 3);
+
+  worker_2.join();
+  worker_3.join();
+
+  std::cout << message0 << std::endl;
+  std::cout << message1 << std::endl;
+
   std::cout << "!!!! TUTORIAL COMPLETED SUCCESSFULLY !!!!" << std::endl;
 
   return EXIT_SUCCESS;
@@ -19,6 +19,9 @@
 *
 *   Tutorial: Dumps random values into the supplied vector/matrix
 *
+*   The values are drawn from the counter-based generator Philox4x32-10,
+*   so the results are the same for all compute backends.
+*
 *
 */
 
@@ -26,9 +29,10 @@
 
 // include necessary system headers
 #include <iostream>
+#include "viennacl/matrix.hpp"
 #include "viennacl/rand/gaussian.hpp"
 #include "viennacl/rand/uniform.hpp"
-#include "viennacl/matrix.hpp"
+#include "viennacl/rand/generator.hpp"
 
 
 int main(){
@@ -60,6 +64,18 @@ int main(){
   std::cout << "------------------" << std::endl;
   std::cout << vec << std::endl;
 
+  //Draws consecutive values from a stream: Each stream is identified by a seed and a stream ID.
+  //Streams with different IDs are independent, e.g. for giving each thread or each process its own stream.
+  viennacl::rand::generator gen(42, 1);
+  viennacl::vector<NumericT> vec2(size1);
+  gen.fill(vec2, viennacl::rand::uniform_tag(a,b));  // values 0, ..., size1 - 1 of the stream
+  gen.fill(mat,  viennacl::rand::gaussian_tag(mu,sigma)); // values size1, ..., size1 + size1*size2 - 1 of the stream
+  std::cout << "------------------" << std::endl;
+  std::cout << "Values from stream (seed 42, ID 1) : " << std::endl;
+  std::cout << "------------------" << std::endl;
+  std::cout << vec2 << std::endl;
+  std::cout << mat << std::endl;
+
   //
   //  That's it.
   //
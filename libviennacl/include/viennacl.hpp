@@ -82,6 +82,21 @@ typedef enum
   ViennaCLDouble
 } ViennaCLPrecision;
 
+typedef enum
+{
+  ViennaCLCG,
+  ViennaCLBiCGStab,
+  ViennaCLGMRES
+} ViennaCLSolverType;
+
+typedef enum
+{
+  ViennaCLNoPrecond,
+  ViennaCLJacobiPrecond,
+  ViennaCLILU0Precond,
+  ViennaCLAMGPrecond
+} ViennaCLPrecondType;
+
 
 
 /************* Backend Management ******************/
@@ -210,6 +225,15 @@ struct ViennaCLMatrix_impl
 typedef ViennaCLMatrix_impl*    ViennaCLMatrix;
 
 
+/** @brief Sparse matrix in compressed sparse row (CSR) format. Created from user-supplied arrays via ViennaCL{CUDA,OpenCL,Host}{S,D}csrCreate(). */
+struct ViennaCLCompressedMatrix_impl;
+typedef ViennaCLCompressedMatrix_impl*    ViennaCLCompressedMatrix;
+
+/** @brief Iterative solver including its preconditioner. The preconditioner is set up in the first call to ViennaCLsolve() and reused in subsequent calls with the same matrix. */
+struct ViennaCLSolver_impl;
+typedef ViennaCLSolver_impl*    ViennaCLSolver;
+
+
 /******************** BLAS Level 1 ***********************/
 
 // IxASUM
@@ -750,6 +774,374 @@ ViennaCLStatus ViennaCLHostDtrsm(ViennaCLHostBackend backend,
                                  double *A, size_t offA_row, size_t offA_col, int incA_row, int incA_col, size_t lda,
                                  double *B, size_t offB_row, size_t offB_col, int incB_row, int incB_col, size_t ldb);
 
+
+
+/******************** Batched BLAS Level 3 and LU ***********************/
+
+// Many small dense matrices are processed in a single call. The strided variants expect all matrices of a batch in one buffer.
+
+// xGEMMSTRIDEDBATCHED: C_i <- alpha * op(A_i) op(B_i) + beta * C_i for i = 0, ..., batchCount - 1, where X_i starts at offset offX + i * strideX
+
+#ifdef VIENNACL_WITH_CUDA
+ViennaCLStatus ViennaCLCUDASgemmStridedBatched(ViennaCLCUDABackend backend,
+                                               ViennaCLOrder order, ViennaCLTranspose transA, ViennaCLTranspose transB,
+                                               int m, int n, int k,
+                                               float alpha,
+                                               float *A, int offA, int lda, int strideA,
+                                               float *B, int offB, int ldb, int strideB,
+                                               float beta,
+                                               float *C, int offC, int ldc, int strideC,
+                                               int batchCount);
+ViennaCLStatus ViennaCLCUDADgemmStridedBatched(ViennaCLCUDABackend backend,
+                                               ViennaCLOrder order, ViennaCLTranspose transA, ViennaCLTranspose transB,
+                                               int m, int n, int k,
+                                               double alpha,
+                                               double *A, int offA, int lda, int strideA,
+                                               double *B, int offB, int ldb, int strideB,
+                                               double beta,
+                                               double *C, int offC, int ldc, int strideC,
+                                               int batchCount);
+#endif
+
+#ifdef VIENNACL_WITH_OPENCL
+ViennaCLStatus ViennaCLOpenCLSgemmStridedBatched(ViennaCLOpenCLBackend backend,
+                                                 ViennaCLOrder order, ViennaCLTranspose transA, ViennaCLTranspose transB,
+                                                 size_t m, size_t n, size_t k,
+                                                 float alpha,
+                                                 cl_mem A, size_t offA, size_t lda, size_t strideA,
+                                                 cl_mem B, size_t offB, size_t ldb, size_t strideB,
+                                                 float beta,
+                                                 cl_mem C, size_t offC, size_t ldc, size_t strideC,
+                                                 size_t batchCount);
+ViennaCLStatus ViennaCLOpenCLDgemmStridedBatched(ViennaCLOpenCLBackend backend,
+                                                 ViennaCLOrder order, ViennaCLTranspose transA, ViennaCLTranspose transB,
+                                                 size_t m, size_t n, size_t k,
+                                                 double alpha,
+                                                 cl_mem A, size_t offA, size_t lda, size_t strideA,
+                                                 cl_mem B, size_t offB, size_t ldb, size_t strideB,
+                                                 double beta,
+                                                 cl_mem C, size_t offC, size_t ldc, size_t strideC,
+                                                 size_t batchCount);
+#endif
+
+ViennaCLStatus ViennaCLHostSgemmStridedBatched(ViennaCLHostBackend backend,
+                                               ViennaCLOrder order, ViennaCLTranspose transA, ViennaCLTranspose transB,
+                                               size_t m, size_t n, size_t k,
+                                               float alpha,
+                                               float *A, size_t offA, size_t lda, size_t strideA,
+                                               float *B, size_t offB, size_t ldb, size_t strideB,
+                                               float beta,
+                                               float *C, size_t offC, size_t ldc, size_t strideC,
+                                               size_t batchCount);
+ViennaCLStatus ViennaCLHostDgemmStridedBatched(ViennaCLHostBackend backend,
+                                               ViennaCLOrder order, ViennaCLTranspose transA, ViennaCLTranspose transB,
+                                               size_t m, size_t n, size_t k,
+                                               double alpha,
+                                               double *A, size_t offA, size_t lda, size_t strideA,
+                                               double *B, size_t offB, size_t ldb, size_t strideB,
+                                               double beta,
+                                               double *C, size_t offC, size_t ldc, size_t strideC,
+                                               size_t batchCount);
+
+
+// xTRSMSTRIDEDBATCHED: B_i <- op(A_i)^{-1} B_i for triangular A_i (size m x m) and B_i of size m x n. Unlike xTRSM, there is no scaling factor alpha.
+
+#ifdef VIENNACL_WITH_CUDA
+ViennaCLStatus ViennaCLCUDAStrsmStridedBatched(ViennaCLCUDABackend backend,
+                                               ViennaCLOrder order, ViennaCLUplo uplo, ViennaCLTranspose transA, ViennaCLDiag diag,
+                                               int m, int n,
+                                               float *A, int offA, int lda, int strideA,
+                                               float *B, int offB, int ldb, int strideB,
+                                               int batchCount);
+ViennaCLStatus ViennaCLCUDADtrsmStridedBatched(ViennaCLCUDABackend backend,
+                                               ViennaCLOrder order, ViennaCLUplo uplo, ViennaCLTranspose transA, ViennaCLDiag diag,
+                                               int m, int n,
+                                               double *A, int offA, int lda, int strideA,
+                                               double *B, int offB, int ldb, int strideB,
+                                               int batchCount);
+#endif
+
+#ifdef VIENNACL_WITH_OPENCL
+ViennaCLStatus ViennaCLOpenCLStrsmStridedBatched(ViennaCLOpenCLBackend backend,
+                                                 ViennaCLOrder order, ViennaCLUplo uplo, ViennaCLTranspose transA, ViennaCLDiag diag,
+                                                 size_t m, size_t n,
+                                                 cl_mem A, size_t offA, size_t lda, size_t strideA,
+                                                 cl_mem B, size_t offB, size_t ldb, size_t strideB,
+                                                 size_t batchCount);
+ViennaCLStatus ViennaCLOpenCLDtrsmStridedBatched(ViennaCLOpenCLBackend backend,
+                                                 ViennaCLOrder order, ViennaCLUplo uplo, ViennaCLTranspose transA, ViennaCLDiag diag,
+                                                 size_t m, size_t n,
+                                                 cl_mem A, size_t offA, size_t lda, size_t strideA,
+                                                 cl_mem B, size_t offB, size_t ldb, size_t strideB,
+                                                 size_t batchCount);
+#endif
+
+ViennaCLStatus ViennaCLHostStrsmStridedBatched(ViennaCLHostBackend backend,
+                                               ViennaCLOrder order, ViennaCLUplo uplo, ViennaCLTranspose transA, ViennaCLDiag diag,
+                                               size_t m, size_t n,
+                                               float *A, size_t offA, size_t lda, size_t strideA,
+                                               float *B, size_t offB, size_t ldb, size_t strideB,
+                                               size_t batchCount);
+ViennaCLStatus ViennaCLHostDtrsmStridedBatched(ViennaCLHostBackend backend,
+                                               ViennaCLOrder order, ViennaCLUplo uplo, ViennaCLTranspose transA, ViennaCLDiag diag,
+                                               size_t m, size_t n,
+                                               double *A, size_t offA, size_t lda, size_t strideA,
+                                               double *B, size_t offB, size_t ldb, size_t strideB,
+                                               size_t batchCount);
+
+
+// xGETRFSTRIDEDBATCHED: A_i <- P_i L_i U_i with partial pivoting for A_i of size n x n.
+// Pivots are 0-based: row j of A_i has been swapped with row ipiv[offIpiv + i * n + j].
+
+#ifdef VIENNACL_WITH_CUDA
+ViennaCLStatus ViennaCLCUDASgetrfStridedBatched(ViennaCLCUDABackend backend,
+                                                ViennaCLOrder order, int n,
+                                                float *A, int offA, int lda, int strideA,
+                                                unsigned int *ipiv, int offIpiv,
+                                                int batchCount);
+ViennaCLStatus ViennaCLCUDADgetrfStridedBatched(ViennaCLCUDABackend backend,
+                                                ViennaCLOrder order, int n,
+                                                double *A, int offA, int lda, int strideA,
+                                                unsigned int *ipiv, int offIpiv,
+                                                int batchCount);
+#endif
+
+#ifdef VIENNACL_WITH_OPENCL
+ViennaCLStatus ViennaCLOpenCLSgetrfStridedBatched(ViennaCLOpenCLBackend backend,
+                                                  ViennaCLOrder order, size_t n,
+                                                  cl_mem A, size_t offA, size_t lda, size_t strideA,
+                                                  cl_mem ipiv, size_t offIpiv,
+                                                  size_t batchCount);
+ViennaCLStatus ViennaCLOpenCLDgetrfStridedBatched(ViennaCLOpenCLBackend backend,
+                                                  ViennaCLOrder order, size_t n,
+                                                  cl_mem A, size_t offA, size_t lda, size_t strideA,
+                                                  cl_mem ipiv, size_t offIpiv,
+                                                  size_t batchCount);
+#endif
+
+ViennaCLStatus ViennaCLHostSgetrfStridedBatched(ViennaCLHostBackend backend,
+                                                ViennaCLOrder order, size_t n,
+                                                float *A, size_t offA, size_t lda, size_t strideA,
+                                                unsigned int *ipiv, size_t offIpiv,
+                                                size_t batchCount);
+ViennaCLStatus ViennaCLHostDgetrfStridedBatched(ViennaCLHostBackend backend,
+                                                ViennaCLOrder order, size_t n,
+                                                double *A, size_t offA, size_t lda, size_t strideA,
+                                                unsigned int *ipiv, size_t offIpiv,
+                                                size_t batchCount);
+
+
+// xGETRSSTRIDEDBATCHED: B_i <- A_i^{-1} B_i for B_i of size n x nrhs, using the factors and pivots computed by xGETRFSTRIDEDBATCHED
+
+#ifdef VIENNACL_WITH_CUDA
+ViennaCLStatus ViennaCLCUDASgetrsStridedBatched(ViennaCLCUDABackend backend,
+                                                ViennaCLOrder order, int n, int nrhs,
+                                                float *A, int offA, int lda, int strideA,
+                                                unsigned int *ipiv, int offIpiv,
+                                                float *B, int offB, int ldb, int strideB,
+                                                int batchCount);
+ViennaCLStatus ViennaCLCUDADgetrsStridedBatched(ViennaCLCUDABackend backend,
+                                                ViennaCLOrder order, int n, int nrhs,
+                                                double *A, int offA, int lda, int strideA,
+                                                unsigned int *ipiv, int offIpiv,
+                                                double *B, int offB, int ldb, int strideB,
+                                                int batchCount);
+#endif
+
+#ifdef VIENNACL_WITH_OPENCL
+ViennaCLStatus ViennaCLOpenCLSgetrsStridedBatched(ViennaCLOpenCLBackend backend,
+                                                  ViennaCLOrder order, size_t n, size_t nrhs,
+                                                  cl_mem A, size_t offA, size_t lda, size_t strideA,
+                                                  cl_mem ipiv, size_t offIpiv,
+                                                  cl_mem B, size_t offB, size_t ldb, size_t strideB,
+                                                  size_t batchCount);
+ViennaCLStatus ViennaCLOpenCLDgetrsStridedBatched(ViennaCLOpenCLBackend backend,
+                                                  ViennaCLOrder order, size_t n, size_t nrhs,
+                                                  cl_mem A, size_t offA, size_t lda, size_t strideA,
+                                                  cl_mem ipiv, size_t offIpiv,
+                                                  cl_mem B, size_t offB, size_t ldb, size_t strideB,
+                                                  size_t batchCount);
+#endif
+
+ViennaCLStatus ViennaCLHostSgetrsStridedBatched(ViennaCLHostBackend backend,
+                                                ViennaCLOrder order, size_t n, size_t nrhs,
+                                                float *A, size_t offA, size_t lda, size_t strideA,
+                                                unsigned int *ipiv, size_t offIpiv,
+                                                float *B, size_t offB, size_t ldb, size_t strideB,
+                                                size_t batchCount);
+ViennaCLStatus ViennaCLHostDgetrsStridedBatched(ViennaCLHostBackend backend,
+                                                ViennaCLOrder order, size_t n, size_t nrhs,
+                                                double *A, size_t offA, size_t lda, size_t strideA,
+                                                unsigned int *ipiv, size_t offIpiv,
+                                                double *B, size_t offB, size_t ldb, size_t strideB,
+                                                size_t batchCount);
+
+
+// Arrays of pointers to the matrices in host memory: The i-th matrix starts at A[i]. Pivots of the i-th matrix are stored at ipiv[i].
+
+// xGEMMBATCHED
+
+ViennaCLStatus ViennaCLHostSgemmBatched(ViennaCLHostBackend backend,
+                                        ViennaCLOrder order, ViennaCLTranspose transA, ViennaCLTranspose transB,
+                                        size_t m, size_t n, size_t k,
+                                        float alpha,
+                                        float **A, size_t lda,
+                                        float **B, size_t ldb,
+                                        float beta,
+                                        float **C, size_t ldc,
+                                        size_t batchCount);
+ViennaCLStatus ViennaCLHostDgemmBatched(ViennaCLHostBackend backend,
+                                        ViennaCLOrder order, ViennaCLTranspose transA, ViennaCLTranspose transB,
+                                        size_t m, size_t n, size_t k,
+                                        double alpha,
+                                        double **A, size_t lda,
+                                        double **B, size_t ldb,
+                                        double beta,
+                                        double **C, size_t ldc,
+                                        size_t batchCount);
+
+
+// xTRSMBATCHED
+
+ViennaCLStatus ViennaCLHostStrsmBatched(ViennaCLHostBackend backend,
+                                        ViennaCLOrder order, ViennaCLUplo uplo, ViennaCLTranspose transA, ViennaCLDiag diag,
+                                        size_t m, size_t n,
+                                        float **A, size_t lda,
+                                        float **B, size_t ldb,
+                                        size_t batchCount);
+ViennaCLStatus ViennaCLHostDtrsmBatched(ViennaCLHostBackend backend,
+                                        ViennaCLOrder order, ViennaCLUplo uplo, ViennaCLTranspose transA, ViennaCLDiag diag,
+                                        size_t m, size_t n,
+                                        double **A, size_t lda,
+                                        double **B, size_t ldb,
+                                        size_t batchCount);
+
+
+// xGETRFBATCHED
+
+ViennaCLStatus ViennaCLHostSgetrfBatched(ViennaCLHostBackend backend,
+                                         ViennaCLOrder order, size_t n,
+                                         float **A, size_t lda,
+                                         unsigned int **ipiv,
+                                         size_t batchCount);
+ViennaCLStatus ViennaCLHostDgetrfBatched(ViennaCLHostBackend backend,
+                                         ViennaCLOrder order, size_t n,
+                                         double **A, size_t lda,
+                                         unsigned int **ipiv,
+                                         size_t batchCount);
+
+
+// xGETRSBATCHED
+
+ViennaCLStatus ViennaCLHostSgetrsBatched(ViennaCLHostBackend backend,
+                                         ViennaCLOrder order, size_t n, size_t nrhs,
+                                         float **A, size_t lda,
+                                         unsigned int **ipiv,
+                                         float **B, size_t ldb,
+                                         size_t batchCount);
+ViennaCLStatus ViennaCLHostDgetrsBatched(ViennaCLHostBackend backend,
+                                         ViennaCLOrder order, size_t n, size_t nrhs,
+                                         double **A, size_t lda,
+                                         unsigned int **ipiv,
+                                         double **B, size_t ldb,
+                                         size_t batchCount);
+
+
+
+/******************** Sparse Matrices ***********************/
+
+// CSR matrix creation: The arrays are used directly (no copy) and must remain valid until ViennaCLcsrFree() is called.
+// Row offsets (rows + 1 entries) and column indices (nnz entries) are of type unsigned int.
+
+#ifdef VIENNACL_WITH_CUDA
+ViennaCLStatus ViennaCLCUDAScsrCreate(ViennaCLCUDABackend backend, ViennaCLCompressedMatrix *A,
+                                      int rows, int cols, int nnz,
+                                      unsigned int *row_offsets, unsigned int *col_indices, float *values);
+ViennaCLStatus ViennaCLCUDADcsrCreate(ViennaCLCUDABackend backend, ViennaCLCompressedMatrix *A,
+                                      int rows, int cols, int nnz,
+                                      unsigned int *row_offsets, unsigned int *col_indices, double *values);
+#endif
+
+#ifdef VIENNACL_WITH_OPENCL
+ViennaCLStatus ViennaCLOpenCLScsrCreate(ViennaCLOpenCLBackend backend, ViennaCLCompressedMatrix *A,
+                                        size_t rows, size_t cols, size_t nnz,
+                                        cl_mem row_offsets, cl_mem col_indices, cl_mem values);
+ViennaCLStatus ViennaCLOpenCLDcsrCreate(ViennaCLOpenCLBackend backend, ViennaCLCompressedMatrix *A,
+                                        size_t rows, size_t cols, size_t nnz,
+                                        cl_mem row_offsets, cl_mem col_indices, cl_mem values);
+#endif
+
+ViennaCLStatus ViennaCLHostScsrCreate(ViennaCLHostBackend backend, ViennaCLCompressedMatrix *A,
+                                      size_t rows, size_t cols, size_t nnz,
+                                      unsigned int *row_offsets, unsigned int *col_indices, float *values);
+ViennaCLStatus ViennaCLHostDcsrCreate(ViennaCLHostBackend backend, ViennaCLCompressedMatrix *A,
+                                      size_t rows, size_t cols, size_t nnz,
+                                      unsigned int *row_offsets, unsigned int *col_indices, double *values);
+
+ViennaCLStatus ViennaCLcsrFree(ViennaCLCompressedMatrix A);
+
+/** @brief Notifies the library that the nonzero values of A were modified in place. Cached preconditioners are recomputed in the next call to ViennaCLsolve(). */
+ViennaCLStatus ViennaCLcsrValuesChanged(ViennaCLCompressedMatrix A);
+
+
+// xCSRMV: y <- alpha * Ax + beta * y
+
+ViennaCLStatus ViennaCLcsrmv(ViennaCLHostScalar alpha, ViennaCLCompressedMatrix A, ViennaCLVector x, ViennaCLHostScalar beta, ViennaCLVector y);
+
+#ifdef VIENNACL_WITH_CUDA
+ViennaCLStatus ViennaCLCUDAScsrmv(ViennaCLCUDABackend backend, ViennaCLCompressedMatrix A,
+                                  float alpha,
+                                  float *x, int offx, int incx,
+                                  float beta,
+                                  float *y, int offy, int incy);
+ViennaCLStatus ViennaCLCUDADcsrmv(ViennaCLCUDABackend backend, ViennaCLCompressedMatrix A,
+                                  double alpha,
+                                  double *x, int offx, int incx,
+                                  double beta,
+                                  double *y, int offy, int incy);
+#endif
+
+#ifdef VIENNACL_WITH_OPENCL
+ViennaCLStatus ViennaCLOpenCLScsrmv(ViennaCLOpenCLBackend backend, ViennaCLCompressedMatrix A,
+                                    float alpha,
+                                    cl_mem x, size_t offx, int incx,
+                                    float beta,
+                                    cl_mem y, size_t offy, int incy);
+ViennaCLStatus ViennaCLOpenCLDcsrmv(ViennaCLOpenCLBackend backend, ViennaCLCompressedMatrix A,
+                                    double alpha,
+                                    cl_mem x, size_t offx, int incx,
+                                    double beta,
+                                    cl_mem y, size_t offy, int incy);
+#endif
+
+ViennaCLStatus ViennaCLHostScsrmv(ViennaCLHostBackend backend, ViennaCLCompressedMatrix A,
+                                  float alpha,
+                                  float *x, size_t offx, int incx,
+                                  float beta,
+                                  float *y, size_t offy, int incy);
+ViennaCLStatus ViennaCLHostDcsrmv(ViennaCLHostBackend backend, ViennaCLCompressedMatrix A,
+                                  double alpha,
+                                  double *x, size_t offx, int incx,
+                                  double beta,
+                                  double *y, size_t offy, int incy);
+
+
+
+/******************** Iterative Solvers ***********************/
+
+ViennaCLStatus ViennaCLSolverCreate(ViennaCLSolver *solver, ViennaCLSolverType solver_type, ViennaCLPrecondType precond_type);
+ViennaCLStatus ViennaCLSolverFree(ViennaCLSolver solver);
+
+ViennaCLStatus ViennaCLSolverSetTolerance(ViennaCLSolver solver, double tolerance);
+ViennaCLStatus ViennaCLSolverSetMaxIterations(ViennaCLSolver solver, size_t max_iterations);
+ViennaCLStatus ViennaCLSolverSetKrylovDim(ViennaCLSolver solver, size_t krylov_dim);   // GMRES only
+
+/** @brief Solves Ax = b. Returns ViennaCLGenericFailure if the preconditioner cannot be set up for A or the vectors do not match A in backend and precision. */
+ViennaCLStatus ViennaCLsolve(ViennaCLSolver solver, ViennaCLCompressedMatrix A, ViennaCLVector b, ViennaCLVector x);
+
+ViennaCLStatus ViennaCLSolverIterations(ViennaCLSolver solver, size_t *iterations);   // iterations of the last solver run
+ViennaCLStatus ViennaCLSolverError(ViennaCLSolver solver, double *error);              // estimated relative residual of the last solver run
+
 #ifdef __cplusplus
 }
 #endif
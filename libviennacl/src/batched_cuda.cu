@@ -0,0 +1,201 @@
+/* =========================================================================
+   Copyright (c) 2010-2013, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+// include necessary system headers
+#include <iostream>
+
+#include "viennacl.hpp"
+#include "batched_impl.hpp"
+
+//include basic scalar and vector types of ViennaCL
+#include "viennacl/vector.hpp"
+#include "viennacl/linalg/batched.hpp"
+
+
+#ifdef VIENNACL_WITH_CUDA
+
+namespace
+{
+  template <typename NumericT>
+  ViennaCLStatus cuda_gemm_strided_batched(ViennaCLOrder order, ViennaCLTranspose transA, ViennaCLTranspose transB,
+                                           int m, int n, int k,
+                                           NumericT alpha,
+                                           NumericT *A, int offA, int lda, int strideA,
+                                           NumericT *B, int offB, int ldb, int strideB,
+                                           NumericT beta,
+                                           NumericT *C, int offC, int ldc, int strideC,
+                                           int batchCount)
+  {
+    viennacl::linalg::batch_layout layout_A = make_batch_layout(order, transA,          m, k, offA, lda, strideA, batchCount);
+    viennacl::linalg::batch_layout layout_B = make_batch_layout(order, transB,          k, n, offB, ldb, strideB, batchCount);
+    viennacl::linalg::batch_layout layout_C = make_batch_layout(order, ViennaCLNoTrans, m, n, offC, ldc, strideC, batchCount);
+
+    viennacl::vector_base<NumericT> v_A(A, viennacl::CUDA_MEMORY, layout_A.extent());
+    viennacl::vector_base<NumericT> v_B(B, viennacl::CUDA_MEMORY, layout_B.extent());
+    viennacl::vector_base<NumericT> v_C(C, viennacl::CUDA_MEMORY, layout_C.extent());
+
+    viennacl::linalg::batched_prod(alpha, v_A, layout_A, v_B, layout_B, beta, v_C, layout_C);
+    return ViennaCLSuccess;
+  }
+
+  template <typename NumericT>
+  ViennaCLStatus cuda_trsm_strided_batched(ViennaCLOrder order, ViennaCLUplo uplo, ViennaCLTranspose transA, ViennaCLDiag diag,
+                                           int m, int n,
+                                           NumericT *A, int offA, int lda, int strideA,
+                                           NumericT *B, int offB, int ldb, int strideB,
+                                           int batchCount)
+  {
+    viennacl::linalg::batch_layout layout_A = make_batch_layout(order, transA,          m, m, offA, lda, strideA, batchCount);
+    viennacl::linalg::batch_layout layout_B = make_batch_layout(order, ViennaCLNoTrans, m, n, offB, ldb, strideB, batchCount);
+
+    viennacl::vector_base<NumericT> v_A(A, viennacl::CUDA_MEMORY, layout_A.extent());
+    viennacl::vector_base<NumericT> v_B(B, viennacl::CUDA_MEMORY, layout_B.extent());
+
+    return batched_trsm_impl(uplo, transA, diag, v_A, layout_A, v_B, layout_B);
+  }
+
+  template <typename NumericT>
+  ViennaCLStatus cuda_getrf_strided_batched(ViennaCLOrder order, int n,
+                                            NumericT *A, int offA, int lda, int strideA,
+                                            unsigned int *ipiv, int offIpiv,
+                                            int batchCount)
+  {
+    viennacl::linalg::batch_layout layout_A = make_batch_layout(order, ViennaCLNoTrans, n, n, offA, lda, strideA, batchCount);
+
+    viennacl::vector_base<NumericT>     v_A(A, viennacl::CUDA_MEMORY, layout_A.extent());
+    viennacl::vector_base<unsigned int> v_ipiv(ipiv, viennacl::CUDA_MEMORY, batchCount * n, offIpiv);
+
+    viennacl::linalg::batched_lu_factorize(v_A, layout_A, v_ipiv);
+    return ViennaCLSuccess;
+  }
+
+  template <typename NumericT>
+  ViennaCLStatus cuda_getrs_strided_batched(ViennaCLOrder order, int n, int nrhs,
+                                            NumericT *A, int offA, int lda, int strideA,
+                                            unsigned int *ipiv, int offIpiv,
+                                            NumericT *B, int offB, int ldb, int strideB,
+                                            int batchCount)
+  {
+    viennacl::linalg::batch_layout layout_A = make_batch_layout(order, ViennaCLNoTrans, n, n,    offA, lda, strideA, batchCount);
+    viennacl::linalg::batch_layout layout_B = make_batch_layout(order, ViennaCLNoTrans, n, nrhs, offB, ldb, strideB, batchCount);
+
+    viennacl::vector_base<NumericT>     v_A(A, viennacl::CUDA_MEMORY, layout_A.extent());
+    viennacl::vector_base<unsigned int> v_ipiv(ipiv, viennacl::CUDA_MEMORY, batchCount * n, offIpiv);
+    viennacl::vector_base<NumericT>     v_B(B, viennacl::CUDA_MEMORY, layout_B.extent());
+
+    viennacl::linalg::batched_lu_substitute(v_A, layout_A, v_ipiv, v_B, layout_B);
+    return ViennaCLSuccess;
+  }
+}
+
+
+// xGEMMSTRIDEDBATCHED
+
+ViennaCLStatus ViennaCLCUDASgemmStridedBatched(ViennaCLCUDABackend /*backend*/,
+                                               ViennaCLOrder order, ViennaCLTranspose transA, ViennaCLTranspose transB,
+                                               int m, int n, int k,
+                                               float alpha,
+                                               float *A, int offA, int lda, int strideA,
+                                               float *B, int offB, int ldb, int strideB,
+                                               float beta,
+                                               float *C, int offC, int ldc, int strideC,
+                                               int batchCount)
+{
+  return cuda_gemm_strided_batched(order, transA, transB, m, n, k, alpha, A, offA, lda, strideA, B, offB, ldb, strideB, beta, C, offC, ldc, strideC, batchCount);
+}
+
+ViennaCLStatus ViennaCLCUDADgemmStridedBatched(ViennaCLCUDABackend /*backend*/,
+                                               ViennaCLOrder order, ViennaCLTranspose transA, ViennaCLTranspose transB,
+                                               int m, int n, int k,
+                                               double alpha,
+                                               double *A, int offA, int lda, int strideA,
+                                               double *B, int offB, int ldb, int strideB,
+                                               double beta,
+                                               double *C, int offC, int ldc, int strideC,
+                                               int batchCount)
+{
+  return cuda_gemm_strided_batched(order, transA, transB, m, n, k, alpha, A, offA, lda, strideA, B, offB, ldb, strideB, beta, C, offC, ldc, strideC, batchCount);
+}
+
+
+// xTRSMSTRIDEDBATCHED
+
+ViennaCLStatus ViennaCLCUDAStrsmStridedBatched(ViennaCLCUDABackend /*backend*/,
+                                               ViennaCLOrder order, ViennaCLUplo uplo, ViennaCLTranspose transA, ViennaCLDiag diag,
+                                               int m, int n,
+                                               float *A, int offA, int lda, int strideA,
+                                               float *B, int offB, int ldb, int strideB,
+                                               int batchCount)
+{
+  return cuda_trsm_strided_batched(order, uplo, transA, diag, m, n, A, offA, lda, strideA, B, offB, ldb, strideB, batchCount);
+}
+
+ViennaCLStatus ViennaCLCUDADtrsmStridedBatched(ViennaCLCUDABackend /*backend*/,
+                                               ViennaCLOrder order, ViennaCLUplo uplo, ViennaCLTranspose transA, ViennaCLDiag diag,
+                                               int m, int n,
+                                               double *A, int offA, int lda, int strideA,
+                                               double *B, int offB, int ldb, int strideB,
+                                               int batchCount)
+{
+  return cuda_trsm_strided_batched(order, uplo, transA, diag, m, n, A, offA, lda, strideA, B, offB, ldb, strideB, batchCount);
+}
+
+
+// xGETRFSTRIDEDBATCHED
+
+ViennaCLStatus ViennaCLCUDASgetrfStridedBatched(ViennaCLCUDABackend /*backend*/,
+                                                ViennaCLOrder order, int n,
+                                                float *A, int offA, int lda, int strideA,
+                                                unsigned int *ipiv, int offIpiv,
+                                                int batchCount)
+{
+  return cuda_getrf_strided_batched(order, n, A, offA, lda, strideA, ipiv, offIpiv, batchCount);
+}
+
+ViennaCLStatus ViennaCLCUDADgetrfStridedBatched(ViennaCLCUDABackend /*backend*/,
+                                                ViennaCLOrder order, int n,
+                                                double *A, int offA, int lda, int strideA,
+                                                unsigned int *ipiv, int offIpiv,
+                                                int batchCount)
+{
+  return cuda_getrf_strided_batched(order, n, A, offA, lda, strideA, ipiv, offIpiv, batchCount);
+}
+
+
+// xGETRSSTRIDEDBATCHED
+
+ViennaCLStatus ViennaCLCUDASgetrsStridedBatched(ViennaCLCUDABackend /*backend*/,
+                                                ViennaCLOrder order, int n, int nrhs,
+                                                float *A, int offA, int lda, int strideA,
+                                                unsigned int *ipiv, int offIpiv,
+                                                float *B, int offB, int ldb, int strideB,
+                                                int batchCount)
+{
+  return cuda_getrs_strided_batched(order, n, nrhs, A, offA, lda, strideA, ipiv, offIpiv, B, offB, ldb, strideB, batchCount);
+}
+
+ViennaCLStatus ViennaCLCUDADgetrsStridedBatched(ViennaCLCUDABackend /*backend*/,
+                                                ViennaCLOrder order, int n, int nrhs,
+                                                double *A, int offA, int lda, int strideA,
+                                                unsigned int *ipiv, int offIpiv,
+                                                double *B, int offB, int ldb, int strideB,
+                                                int batchCount)
+{
+  return cuda_getrs_strided_batched(order, n, nrhs, A, offA, lda, strideA, ipiv, offIpiv, B, offB, ldb, strideB, batchCount);
+}
+
+#endif
@@ -0,0 +1,321 @@
+/* =========================================================================
+   Copyright (c) 2010-2013, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+// include necessary system headers
+#include <iostream>
+
+#include "viennacl.hpp"
+#include "batched_impl.hpp"
+
+//include basic scalar and vector types of ViennaCL
+#include "viennacl/vector.hpp"
+#include "viennacl/linalg/batched.hpp"
+
+
+namespace
+{
+  template <typename NumericT>
+  ViennaCLStatus host_gemm_strided_batched(ViennaCLOrder order, ViennaCLTranspose transA, ViennaCLTranspose transB,
+                                           size_t m, size_t n, size_t k,
+                                           NumericT alpha,
+                                           NumericT *A, size_t offA, size_t lda, size_t strideA,
+                                           NumericT *B, size_t offB, size_t ldb, size_t strideB,
+                                           NumericT beta,
+                                           NumericT *C, size_t offC, size_t ldc, size_t strideC,
+                                           size_t batchCount)
+  {
+    viennacl::linalg::batch_layout layout_A = make_batch_layout(order, transA,          m, k, offA, lda, strideA, batchCount);
+    viennacl::linalg::batch_layout layout_B = make_batch_layout(order, transB,          k, n, offB, ldb, strideB, batchCount);
+    viennacl::linalg::batch_layout layout_C = make_batch_layout(order, ViennaCLNoTrans, m, n, offC, ldc, strideC, batchCount);
+
+    viennacl::vector_base<NumericT> v_A(A, viennacl::MAIN_MEMORY, layout_A.extent());
+    viennacl::vector_base<NumericT> v_B(B, viennacl::MAIN_MEMORY, layout_B.extent());
+    viennacl::vector_base<NumericT> v_C(C, viennacl::MAIN_MEMORY, layout_C.extent());
+
+    viennacl::linalg::batched_prod(alpha, v_A, layout_A, v_B, layout_B, beta, v_C, layout_C);
+    return ViennaCLSuccess;
+  }
+
+  template <typename NumericT>
+  ViennaCLStatus host_trsm_strided_batched(ViennaCLOrder order, ViennaCLUplo uplo, ViennaCLTranspose transA, ViennaCLDiag diag,
+                                           size_t m, size_t n,
+                                           NumericT *A, size_t offA, size_t lda, size_t strideA,
+                                           NumericT *B, size_t offB, size_t ldb, size_t strideB,
+                                           size_t batchCount)
+  {
+    viennacl::linalg::batch_layout layout_A = make_batch_layout(order, transA,          m, m, offA, lda, strideA, batchCount);
+    viennacl::linalg::batch_layout layout_B = make_batch_layout(order, ViennaCLNoTrans, m, n, offB, ldb, strideB, batchCount);
+
+    viennacl::vector_base<NumericT> v_A(A, viennacl::MAIN_MEMORY, layout_A.extent());
+    viennacl::vector_base<NumericT> v_B(B, viennacl::MAIN_MEMORY, layout_B.extent());
+
+    return batched_trsm_impl(uplo, transA, diag, v_A, layout_A, v_B, layout_B);
+  }
+
+  template <typename NumericT>
+  ViennaCLStatus host_getrf_strided_batched(ViennaCLOrder order, size_t n,
+                                            NumericT *A, size_t offA, size_t lda, size_t strideA,
+                                            unsigned int *ipiv, size_t offIpiv,
+                                            size_t batchCount)
+  {
+    viennacl::linalg::batch_layout layout_A = make_batch_layout(order, ViennaCLNoTrans, n, n, offA, lda, strideA, batchCount);
+
+    viennacl::vector_base<NumericT>     v_A(A, viennacl::MAIN_MEMORY, layout_A.extent());
+    viennacl::vector_base<unsigned int> v_ipiv(ipiv, viennacl::MAIN_MEMORY, batchCount * n, offIpiv);
+
+    viennacl::linalg::batched_lu_factorize(v_A, layout_A, v_ipiv);
+    return ViennaCLSuccess;
+  }
+
+  template <typename NumericT>
+  ViennaCLStatus host_getrs_strided_batched(ViennaCLOrder order, size_t n, size_t nrhs,
+                                            NumericT *A, size_t offA, size_t lda, size_t strideA,
+                                            unsigned int *ipiv, size_t offIpiv,
+                                            NumericT *B, size_t offB, size_t ldb, size_t strideB,
+                                            size_t batchCount)
+  {
+    viennacl::linalg::batch_layout layout_A = make_batch_layout(order, ViennaCLNoTrans, n, n,    offA, lda, strideA, batchCount);
+    viennacl::linalg::batch_layout layout_B = make_batch_layout(order, ViennaCLNoTrans, n, nrhs, offB, ldb, strideB, batchCount);
+
+    viennacl::vector_base<NumericT>     v_A(A, viennacl::MAIN_MEMORY, layout_A.extent());
+    viennacl::vector_base<unsigned int> v_ipiv(ipiv, viennacl::MAIN_MEMORY, batchCount * n, offIpiv);
+    viennacl::vector_base<NumericT>     v_B(B, viennacl::MAIN_MEMORY, layout_B.extent());
+
+    viennacl::linalg::batched_lu_substitute(v_A, layout_A, v_ipiv, v_B, layout_B);
+    return ViennaCLSuccess;
+  }
+}
+
+
+// xGEMMSTRIDEDBATCHED
+
+ViennaCLStatus ViennaCLHostSgemmStridedBatched(ViennaCLHostBackend /*backend*/,
+                                               ViennaCLOrder order, ViennaCLTranspose transA, ViennaCLTranspose transB,
+                                               size_t m, size_t n, size_t k,
+                                               float alpha,
+                                               float *A, size_t offA, size_t lda, size_t strideA,
+                                               float *B, size_t offB, size_t ldb, size_t strideB,
+                                               float beta,
+                                               float *C, size_t offC, size_t ldc, size_t strideC,
+                                               size_t batchCount)
+{
+  return host_gemm_strided_batched(order, transA, transB, m, n, k, alpha, A, offA, lda, strideA, B, offB, ldb, strideB, beta, C, offC, ldc, strideC, batchCount);
+}
+
+ViennaCLStatus ViennaCLHostDgemmStridedBatched(ViennaCLHostBackend /*backend*/,
+                                               ViennaCLOrder order, ViennaCLTranspose transA, ViennaCLTranspose transB,
+                                               size_t m, size_t n, size_t k,
+                                               double alpha,
+                                               double *A, size_t offA, size_t lda, size_t strideA,
+                                               double *B, size_t offB, size_t ldb, size_t strideB,
+                                               double beta,
+                                               double *C, size_t offC, size_t ldc, size_t strideC,
+                                               size_t batchCount)
+{
+  return host_gemm_strided_batched(order, transA, transB, m, n, k, alpha, A, offA, lda, strideA, B, offB, ldb, strideB, beta, C, offC, ldc, strideC, batchCount);
+}
+
+
+// xTRSMSTRIDEDBATCHED
+
+ViennaCLStatus ViennaCLHostStrsmStridedBatched(ViennaCLHostBackend /*backend*/,
+                                               ViennaCLOrder order, ViennaCLUplo uplo, ViennaCLTranspose transA, ViennaCLDiag diag,
+                                               size_t m, size_t n,
+                                               float *A, size_t offA, size_t lda, size_t strideA,
+                                               float *B, size_t offB, size_t ldb, size_t strideB,
+                                               size_t batchCount)
+{
+  return host_trsm_strided_batched(order, uplo, transA, diag, m, n, A, offA, lda, strideA, B, offB, ldb, strideB, batchCount);
+}
+
+ViennaCLStatus ViennaCLHostDtrsmStridedBatched(ViennaCLHostBackend /*backend*/,
+                                               ViennaCLOrder order, ViennaCLUplo uplo, ViennaCLTranspose transA, ViennaCLDiag diag,
+                                               size_t m, size_t n,
+                                               double *A, size_t offA, size_t lda, size_t strideA,
+                                               double *B, size_t offB, size_t ldb, size_t strideB,
+                                               size_t batchCount)
+{
+  return host_trsm_strided_batched(order, uplo, transA, diag, m, n, A, offA, lda, strideA, B, offB, ldb, strideB, batchCount);
+}
+
+
+// xGETRFSTRIDEDBATCHED
+
+ViennaCLStatus ViennaCLHostSgetrfStridedBatched(ViennaCLHostBackend /*backend*/,
+                                                ViennaCLOrder order, size_t n,
+                                                float *A, size_t offA, size_t lda, size_t strideA,
+                                                unsigned int *ipiv, size_t offIpiv,
+                                                size_t batchCount)
+{
+  return host_getrf_strided_batched(order, n, A, offA, lda, strideA, ipiv, offIpiv, batchCount);
+}
+
+ViennaCLStatus ViennaCLHostDgetrfStridedBatched(ViennaCLHostBackend /*backend*/,
+                                                ViennaCLOrder order, size_t n,
+                                                double *A, size_t offA, size_t lda, size_t strideA,
+                                                unsigned int *ipiv, size_t offIpiv,
+                                                size_t batchCount)
+{
+  return host_getrf_strided_batched(order, n, A, offA, lda, strideA, ipiv, offIpiv, batchCount);
+}
+
+
+// xGETRSSTRIDEDBATCHED
+
+ViennaCLStatus ViennaCLHostSgetrsStridedBatched(ViennaCLHostBackend /*backend*/,
+                                                ViennaCLOrder order, size_t n, size_t nrhs,
+                                                float *A, size_t offA, size_t lda, size_t strideA,
+                                                unsigned int *ipiv, size_t offIpiv,
+                                                float *B, size_t offB, size_t ldb, size_t strideB,
+                                                size_t batchCount)
+{
+  return host_getrs_strided_batched(order, n, nrhs, A, offA, lda, strideA, ipiv, offIpiv, B, offB, ldb, strideB, batchCount);
+}
+
+ViennaCLStatus ViennaCLHostDgetrsStridedBatched(ViennaCLHostBackend /*backend*/,
+                                                ViennaCLOrder order, size_t n, size_t nrhs,
+                                                double *A, size_t offA, size_t lda, size_t strideA,
+                                                unsigned int *ipiv, size_t offIpiv,
+                                                double *B, size_t offB, size_t ldb, size_t strideB,
+                                                size_t batchCount)
+{
+  return host_getrs_strided_batched(order, n, nrhs, A, offA, lda, strideA, ipiv, offIpiv, B, offB, ldb, strideB, batchCount);
+}
+
+
+//
+// Arrays of pointers to the matrices
+//
+
+// xGEMMBATCHED
+
+ViennaCLStatus ViennaCLHostSgemmBatched(ViennaCLHostBackend /*backend*/,
+                                        ViennaCLOrder order, ViennaCLTranspose transA, ViennaCLTranspose transB,
+                                        size_t m, size_t n, size_t k,
+                                        float alpha,
+                                        float **A, size_t lda,
+                                        float **B, size_t ldb,
+                                        float beta,
+                                        float **C, size_t ldc,
+                                        size_t batchCount)
+{
+  viennacl::linalg::host_based::batched_prod<float>(alpha,
+                                                    A, make_batch_layout(order, transA,          m, k, 0, lda, 0, batchCount),
+                                                    B, make_batch_layout(order, transB,          k, n, 0, ldb, 0, batchCount),
+                                                    beta,
+                                                    C, make_batch_layout(order, ViennaCLNoTrans, m, n, 0, ldc, 0, batchCount));
+  return ViennaCLSuccess;
+}
+
+ViennaCLStatus ViennaCLHostDgemmBatched(ViennaCLHostBackend /*backend*/,
+                                        ViennaCLOrder order, ViennaCLTranspose transA, ViennaCLTranspose transB,
+                                        size_t m, size_t n, size_t k,
+                                        double alpha,
+                                        double **A, size_t lda,
+                                        double **B, size_t ldb,
+                                        double beta,
+                                        double **C, size_t ldc,
+                                        size_t batchCount)
+{
+  viennacl::linalg::host_based::batched_prod<double>(alpha,
+                                                     A, make_batch_layout(order, transA,          m, k, 0, lda, 0, batchCount),
+                                                     B, make_batch_layout(order, transB,          k, n, 0, ldb, 0, batchCount),
+                                                     beta,
+                                                     C, make_batch_layout(order, ViennaCLNoTrans, m, n, 0, ldc, 0, batchCount));
+  return ViennaCLSuccess;
+}
+
+
+// xTRSMBATCHED
+
+ViennaCLStatus ViennaCLHostStrsmBatched(ViennaCLHostBackend /*backend*/,
+                                        ViennaCLOrder order, ViennaCLUplo uplo, ViennaCLTranspose transA, ViennaCLDiag diag,
+                                        size_t m, size_t n,
+                                        float **A, size_t lda,
+                                        float **B, size_t ldb,
+                                        size_t batchCount)
+{
+  viennacl::linalg::host_based::batched_inplace_solve<float>(A, make_batch_layout(order, transA,          m, m, 0, lda, 0, batchCount),
+                                                             B, make_batch_layout(order, ViennaCLNoTrans, m, n, 0, ldb, 0, batchCount),
+                                                             (uplo == ViennaCLLower) != (transA == ViennaCLTrans), diag == ViennaCLUnit);
+  return ViennaCLSuccess;
+}
+
+ViennaCLStatus ViennaCLHostDtrsmBatched(ViennaCLHostBackend /*backend*/,
+                                        ViennaCLOrder order, ViennaCLUplo uplo, ViennaCLTranspose transA, ViennaCLDiag diag,
+                                        size_t m, size_t n,
+                                        double **A, size_t lda,
+                                        double **B, size_t ldb,
+                                        size_t batchCount)
+{
+  viennacl::linalg::host_based::batched_inplace_solve<double>(A, make_batch_layout(order, transA,          m, m, 0, lda, 0, batchCount),
+                                                              B, make_batch_layout(order, ViennaCLNoTrans, m, n, 0, ldb, 0, batchCount),
+                                                              (uplo == ViennaCLLower) != (transA == ViennaCLTrans), diag == ViennaCLUnit);
+  return ViennaCLSuccess;
+}
+
+
+// xGETRFBATCHED
+
+ViennaCLStatus ViennaCLHostSgetrfBatched(ViennaCLHostBackend /*backend*/,
+                                         ViennaCLOrder order, size_t n,
+                                         float **A, size_t lda,
+                                         unsigned int **ipiv,
+                                         size_t batchCount)
+{
+  viennacl::linalg::host_based::batched_lu_factorize<float>(A, make_batch_layout(order, ViennaCLNoTrans, n, n, 0, lda, 0, batchCount), ipiv);
+  return ViennaCLSuccess;
+}
+
+ViennaCLStatus ViennaCLHostDgetrfBatched(ViennaCLHostBackend /*backend*/,
+                                         ViennaCLOrder order, size_t n,
+                                         double **A, size_t lda,
+                                         unsigned int **ipiv,
+                                         size_t batchCount)
+{
+  viennacl::linalg::host_based::batched_lu_factorize<double>(A, make_batch_layout(order, ViennaCLNoTrans, n, n, 0, lda, 0, batchCount), ipiv);
+  return ViennaCLSuccess;
+}
+
+
+// xGETRSBATCHED
+
+ViennaCLStatus ViennaCLHostSgetrsBatched(ViennaCLHostBackend /*backend*/,
+                                         ViennaCLOrder order, size_t n, size_t nrhs,
+                                         float **A, size_t lda,
+                                         unsigned int **ipiv,
+                                         float **B, size_t ldb,
+                                         size_t batchCount)
+{
+  viennacl::linalg::host_based::batched_lu_substitute<float>(A, make_batch_layout(order, ViennaCLNoTrans, n, n,    0, lda, 0, batchCount),
+                                                             ipiv,
+                                                             B, make_batch_layout(order, ViennaCLNoTrans, n, nrhs, 0, ldb, 0, batchCount));
+  return ViennaCLSuccess;
+}
+
+ViennaCLStatus ViennaCLHostDgetrsBatched(ViennaCLHostBackend /*backend*/,
+                                         ViennaCLOrder order, size_t n, size_t nrhs,
+                                         double **A, size_t lda,
+                                         unsigned int **ipiv,
+                                         double **B, size_t ldb,
+                                         size_t batchCount)
+{
+  viennacl::linalg::host_based::batched_lu_substitute<double>(A, make_batch_layout(order, ViennaCLNoTrans, n, n,    0, lda, 0, batchCount),
+                                                              ipiv,
+                                                              B, make_batch_layout(order, ViennaCLNoTrans, n, nrhs, 0, ldb, 0, batchCount));
+  return ViennaCLSuccess;
+}
@@ -0,0 +1 @@
+batched_host.cpp
\ No newline at end of file
@@ -0,0 +1,60 @@
+#ifndef VIENNACL_LIBVIENNACL_BATCHED_IMPL_HPP_
+#define VIENNACL_LIBVIENNACL_BATCHED_IMPL_HPP_
+
+/* =========================================================================
+   Copyright (c) 2010-2013, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+#include "viennacl.hpp"
+#include "viennacl/vector.hpp"
+#include "viennacl/linalg/batched.hpp"
+
+
+/** @brief Returns the layout of op(X_i) for a batch of matrices X_i starting at offset + i * stride, where op(X_i) is of size rows x cols */
+inline viennacl::linalg::batch_layout make_batch_layout(ViennaCLOrder order, ViennaCLTranspose trans,
+                                                        size_t rows, size_t cols,
+                                                        size_t offset, size_t ld, size_t stride, size_t batch_count)
+{
+  size_t stored_rows = (trans == ViennaCLTrans) ? cols : rows;
+  size_t stored_cols = (trans == ViennaCLTrans) ? rows : cols;
+  viennacl::linalg::batch_layout layout(stored_rows, stored_cols, batch_count, offset,
+                                        (order == ViennaCLRowMajor) ? ld : 1,
+                                        (order == ViennaCLRowMajor) ? 1 : ld,
+                                        stride);
+  return (trans == ViennaCLTrans) ? layout.trans() : layout;
+}
+
+/** @brief Solves op(A_i) X_i = B_i for the triangular matrices A_i, using the solver tag matching 'uplo' and 'diag'. Transposition swaps the triangle. */
+template <typename NumericT>
+ViennaCLStatus batched_trsm_impl(ViennaCLUplo uplo, ViennaCLTranspose transA, ViennaCLDiag diag,
+                                 viennacl::vector_base<NumericT> const & A, viennacl::linalg::batch_layout const & layout_A,
+                                 viennacl::vector_base<NumericT> & B, viennacl::linalg::batch_layout const & layout_B)
+{
+  bool lower = (uplo == ViennaCLLower) != (transA == ViennaCLTrans);
+
+  if (lower && diag == ViennaCLUnit)
+    viennacl::linalg::batched_inplace_solve(A, layout_A, B, layout_B, viennacl::linalg::unit_lower_tag());
+  else if (lower)
+    viennacl::linalg::batched_inplace_solve(A, layout_A, B, layout_B, viennacl::linalg::lower_tag());
+  else if (diag == ViennaCLUnit)
+    viennacl::linalg::batched_inplace_solve(A, layout_A, B, layout_B, viennacl::linalg::unit_upper_tag());
+  else
+    viennacl::linalg::batched_inplace_solve(A, layout_A, B, layout_B, viennacl::linalg::upper_tag());
+
+  return ViennaCLSuccess;
+}
+
+#endif
@@ -0,0 +1,204 @@
+/* =========================================================================
+   Copyright (c) 2010-2013, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+// include necessary system headers
+#include <iostream>
+
+#include "viennacl.hpp"
+#include "batched_impl.hpp"
+
+//include basic scalar and vector types of ViennaCL
+#include "viennacl/vector.hpp"
+#include "viennacl/linalg/batched.hpp"
+
+#ifdef VIENNACL_WITH_OPENCL
+
+namespace
+{
+  template <typename NumericT>
+  ViennaCLStatus opencl_gemm_strided_batched(ViennaCLOpenCLBackend backend,
+                                             ViennaCLOrder order, ViennaCLTranspose transA, ViennaCLTranspose transB,
+                                             size_t m, size_t n, size_t k,
+                                             NumericT alpha,
+                                             cl_mem A, size_t offA, size_t lda, size_t strideA,
+                                             cl_mem B, size_t offB, size_t ldb, size_t strideB,
+                                             NumericT beta,
+                                             cl_mem C, size_t offC, size_t ldc, size_t strideC,
+                                             size_t batchCount)
+  {
+    viennacl::linalg::batch_layout layout_A = make_batch_layout(order, transA,          m, k, offA, lda, strideA, batchCount);
+    viennacl::linalg::batch_layout layout_B = make_batch_layout(order, transB,          k, n, offB, ldb, strideB, batchCount);
+    viennacl::linalg::batch_layout layout_C = make_batch_layout(order, ViennaCLNoTrans, m, n, offC, ldc, strideC, batchCount);
+
+    viennacl::vector_base<NumericT> v_A(A, layout_A.extent(), 0, 1, viennacl::ocl::get_context(backend->context_id));
+    viennacl::vector_base<NumericT> v_B(B, layout_B.extent(), 0, 1, viennacl::ocl::get_context(backend->context_id));
+    viennacl::vector_base<NumericT> v_C(C, layout_C.extent(), 0, 1, viennacl::ocl::get_context(backend->context_id));
+
+    viennacl::linalg::batched_prod(alpha, v_A, layout_A, v_B, layout_B, beta, v_C, layout_C);
+    return ViennaCLSuccess;
+  }
+
+  template <typename NumericT>
+  ViennaCLStatus opencl_trsm_strided_batched(ViennaCLOpenCLBackend backend,
+                                             ViennaCLOrder order, ViennaCLUplo uplo, ViennaCLTranspose transA, ViennaCLDiag diag,
+                                             size_t m, size_t n,
+                                             cl_mem A, size_t offA, size_t lda, size_t strideA,
+                                             cl_mem B, size_t offB, size_t ldb, size_t strideB,
+                                             size_t batchCount)
+  {
+    viennacl::linalg::batch_layout layout_A = make_batch_layout(order, transA,          m, m, offA, lda, strideA, batchCount);
+    viennacl::linalg::batch_layout layout_B = make_batch_layout(order, ViennaCLNoTrans, m, n, offB, ldb, strideB, batchCount);
+
+    viennacl::vector_base<NumericT> v_A(A, layout_A.extent(), 0, 1, viennacl::ocl::get_context(backend->context_id));
+    viennacl::vector_base<NumericT> v_B(B, layout_B.extent(), 0, 1, viennacl::ocl::get_context(backend->context_id));
+
+    return batched_trsm_impl(uplo, transA, diag, v_A, layout_A, v_B, layout_B);
+  }
+
+  template <typename NumericT>
+  ViennaCLStatus opencl_getrf_strided_batched(ViennaCLOpenCLBackend backend,
+                                              ViennaCLOrder order, size_t n,
+                                              cl_mem A, size_t offA, size_t lda, size_t strideA,
+                                              cl_mem ipiv, size_t offIpiv,
+                                              size_t batchCount)
+  {
+    viennacl::linalg::batch_layout layout_A = make_batch_layout(order, ViennaCLNoTrans, n, n, offA, lda, strideA, batchCount);
+
+    viennacl::vector_base<NumericT>     v_A(A, layout_A.extent(), 0, 1, viennacl::ocl::get_context(backend->context_id));
+    viennacl::vector_base<unsigned int> v_ipiv(ipiv, batchCount * n, offIpiv, 1, viennacl::ocl::get_context(backend->context_id));
+
+    viennacl::linalg::batched_lu_factorize(v_A, layout_A, v_ipiv);
+    return ViennaCLSuccess;
+  }
+
+  template <typename NumericT>
+  ViennaCLStatus opencl_getrs_strided_batched(ViennaCLOpenCLBackend backend,
+                                              ViennaCLOrder order, size_t n, size_t nrhs,
+                                              cl_mem A, size_t offA, size_t lda, size_t strideA,
+                                              cl_mem ipiv, size_t offIpiv,
+                                              cl_mem B, size_t offB, size_t ldb, size_t strideB,
+                                              size_t batchCount)
+  {
+    viennacl::linalg::batch_layout layout_A = make_batch_layout(order, ViennaCLNoTrans, n, n,    offA, lda, strideA, batchCount);
+    viennacl::linalg::batch_layout layout_B = make_batch_layout(order, ViennaCLNoTrans, n, nrhs, offB, ldb, strideB, batchCount);
+
+    viennacl::vector_base<NumericT>     v_A(A, layout_A.extent(), 0, 1, viennacl::ocl::get_context(backend->context_id));
+    viennacl::vector_base<unsigned int> v_ipiv(ipiv, batchCount * n, offIpiv, 1, viennacl::ocl::get_context(backend->context_id));
+    viennacl::vector_base<NumericT>     v_B(B, layout_B.extent(), 0, 1, viennacl::ocl::get_context(backend->context_id));
+
+    viennacl::linalg::batched_lu_substitute(v_A, layout_A, v_ipiv, v_B, layout_B);
+    return ViennaCLSuccess;
+  }
+}
+
+
+// xGEMMSTRIDEDBATCHED
+
+ViennaCLStatus ViennaCLOpenCLSgemmStridedBatched(ViennaCLOpenCLBackend backend,
+                                                 ViennaCLOrder order, ViennaCLTranspose transA, ViennaCLTranspose transB,
+                                                 size_t m, size_t n, size_t k,
+                                                 float alpha,
+                                                 cl_mem A, size_t offA, size_t lda, size_t strideA,
+                                                 cl_mem B, size_t offB, size_t ldb, size_t strideB,
+                                                 float beta,
+                                                 cl_mem C, size_t offC, size_t ldc, size_t strideC,
+                                                 size_t batchCount)
+{
+  return opencl_gemm_strided_batched(backend, order, transA, transB, m, n, k, alpha, A, offA, lda, strideA, B, offB, ldb, strideB, beta, C, offC, ldc, strideC, batchCount);
+}
+
+ViennaCLStatus ViennaCLOpenCLDgemmStridedBatched(ViennaCLOpenCLBackend backend,
+                                                 ViennaCLOrder order, ViennaCLTranspose transA, ViennaCLTranspose transB,
+                                                 size_t m, size_t n, size_t k,
+                                                 double alpha,
+                                                 cl_mem A, size_t offA, size_t lda, size_t strideA,
+                                                 cl_mem B, size_t offB, size_t ldb, size_t strideB,
+                                                 double beta,
+                                                 cl_mem C, size_t offC, size_t ldc, size_t strideC,
+                                                 size_t batchCount)
+{
+  return opencl_gemm_strided_batched(backend, order, transA, transB, m, n, k, alpha, A, offA, lda, strideA, B, offB, ldb, strideB, beta, C, offC, ldc, strideC, batchCount);
+}
+
+
+// xTRSMSTRIDEDBATCHED
+
+ViennaCLStatus ViennaCLOpenCLStrsmStridedBatched(ViennaCLOpenCLBackend backend,
+                                                 ViennaCLOrder order, ViennaCLUplo uplo, ViennaCLTranspose transA, ViennaCLDiag diag,
+                                                 size_t m, size_t n,
+                                                 cl_mem A, size_t offA, size_t lda, size_t strideA,
+                                                 cl_mem B, size_t offB, size_t ldb, size_t strideB,
+                                                 size_t batchCount)
+{
+  return opencl_trsm_strided_batched<float>(backend, order, uplo, transA, diag, m, n, A, offA, lda, strideA, B, offB, ldb, strideB, batchCount);
+}
+
+ViennaCLStatus ViennaCLOpenCLDtrsmStridedBatched(ViennaCLOpenCLBackend backend,
+                                                 ViennaCLOrder order, ViennaCLUplo uplo, ViennaCLTranspose transA, ViennaCLDiag diag,
+                                                 size_t m, size_t n,
+                                                 cl_mem A, size_t offA, size_t lda, size_t strideA,
+                                                 cl_mem B, size_t offB, size_t ldb, size_t strideB,
+                                                 size_t batchCount)
+{
+  return opencl_trsm_strided_batched<double>(backend, order, uplo, transA, diag, m, n, A, offA, lda, strideA, B, offB, ldb, strideB, batchCount);
+}
+
+
+// xGETRFSTRIDEDBATCHED
+
+ViennaCLStatus ViennaCLOpenCLSgetrfStridedBatched(ViennaCLOpenCLBackend backend,
+                                                  ViennaCLOrder order, size_t n,
+                                                  cl_mem A, size_t offA, size_t lda, size_t strideA,
+                                                  cl_mem ipiv, size_t offIpiv,
+                                                  size_t batchCount)
+{
+  return opencl_getrf_strided_batched<float>(backend, order, n, A, offA, lda, strideA, ipiv, offIpiv, batchCount);
+}
+
+ViennaCLStatus ViennaCLOpenCLDgetrfStridedBatched(ViennaCLOpenCLBackend backend,
+                                                  ViennaCLOrder order, size_t n,
+                                                  cl_mem A, size_t offA, size_t lda, size_t strideA,
+                                                  cl_mem ipiv, size_t offIpiv,
+                                                  size_t batchCount)
+{
+  return opencl_getrf_strided_batched<double>(backend, order, n, A, offA, lda, strideA, ipiv, offIpiv, batchCount);
+}
+
+
+// xGETRSSTRIDEDBATCHED
+
+ViennaCLStatus ViennaCLOpenCLSgetrsStridedBatched(ViennaCLOpenCLBackend backend,
+                                                  ViennaCLOrder order, size_t n, size_t nrhs,
+                                                  cl_mem A, size_t offA, size_t lda, size_t strideA,
+                                                  cl_mem ipiv, size_t offIpiv,
+                                                  cl_mem B, size_t offB, size_t ldb, size_t strideB,
+                                                  size_t batchCount)
+{
+  return opencl_getrs_strided_batched<float>(backend, order, n, nrhs, A, offA, lda, strideA, ipiv, offIpiv, B, offB, ldb, strideB, batchCount);
+}
+
+ViennaCLStatus ViennaCLOpenCLDgetrsStridedBatched(ViennaCLOpenCLBackend backend,
+                                                  ViennaCLOrder order, size_t n, size_t nrhs,
+                                                  cl_mem A, size_t offA, size_t lda, size_t strideA,
+                                                  cl_mem ipiv, size_t offIpiv,
+                                                  cl_mem B, size_t offB, size_t ldb, size_t strideB,
+                                                  size_t batchCount)
+{
+  return opencl_getrs_strided_batched<double>(backend, order, n, nrhs, A, offA, lda, strideA, ipiv, offIpiv, B, offB, ldb, strideB, batchCount);
+}
+
+#endif
@@ -0,0 +1 @@
+batched_opencl.cpp
\ No newline at end of file
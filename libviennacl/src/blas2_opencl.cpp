@@ -29,6 +29,8 @@
 #include "viennacl/linalg/direct_solve.hpp"
 #include "viennacl/linalg/prod.hpp"
 
+#ifdef VIENNACL_WITH_OPENCL
+
 
 // xGEMV
 
@@ -279,4 +281,4 @@ ViennaCLStatus ViennaCLOpenCLDger(ViennaCLOpenCLBackend backend,
 
   return ViennaCLSuccess;
 }
-
+#endif
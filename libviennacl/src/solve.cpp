@@ -0,0 +1,300 @@
+/* =========================================================================
+   Copyright (c) 2010-2013, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+// include necessary system headers
+#include <iostream>
+
+#include "viennacl.hpp"
+#include "init_vector.hpp"
+#include "sparse_impl.hpp"
+
+//include basic scalar and vector types of ViennaCL
+#include "viennacl/scalar.hpp"
+#include "viennacl/vector.hpp"
+#include "viennacl/compressed_matrix.hpp"
+#include "viennacl/linalg/prod.hpp"
+
+//include the iterative solvers and preconditioners of ViennaCL
+#include "viennacl/linalg/cg.hpp"
+#include "viennacl/linalg/bicgstab.hpp"
+#include "viennacl/linalg/gmres.hpp"
+#include "viennacl/linalg/jacobi_precond.hpp"
+#include "viennacl/linalg/ilu.hpp"
+#ifdef VIENNACL_WITH_AMG
+#include <boost/numeric/ublas/matrix_sparse.hpp>
+#include "viennacl/linalg/amg.hpp"
+#endif
+
+
+/** @brief Type-erased preconditioner, so that the solver handle can cache any preconditioner type for any precision */
+class cached_precond_base
+{
+  public:
+    virtual ~cached_precond_base() {}
+};
+
+template <typename PrecondT>
+class cached_precond : public cached_precond_base
+{
+  public:
+    cached_precond(PrecondT * p) : precond_(p) {}
+    ~cached_precond() { delete precond_; }
+
+    PrecondT & get() { return *precond_; }
+
+  private:
+    PrecondT * precond_;
+};
+
+
+struct ViennaCLSolver_impl
+{
+  ViennaCLSolverType    solver_type;
+  ViennaCLPrecondType   precond_type;
+
+  double   tolerance;
+  size_t   max_iterations;
+  size_t   krylov_dim;
+
+  // results of last run:
+  size_t   iterations;
+  double   error;
+
+  // cached preconditioner and the matrix it was set up for:
+  cached_precond_base * precond;
+  size_t                precond_matrix_id;
+  size_t                precond_matrix_version;
+};
+
+
+namespace
+{
+  template <typename MatrixT, typename VectorT, typename PrecondT>
+  ViennaCLStatus run_solver(ViennaCLSolver solver, MatrixT const & mat, VectorT const & rhs, VectorT & result, PrecondT const & precond)
+  {
+    switch (solver->solver_type)
+    {
+      case ViennaCLCG:
+      {
+        viennacl::linalg::cg_tag tag(solver->tolerance, static_cast<unsigned int>(solver->max_iterations));
+        result = viennacl::linalg::solve(mat, rhs, tag, precond);
+        solver->iterations = tag.iters();
+        solver->error      = tag.error();
+        return ViennaCLSuccess;
+      }
+
+      case ViennaCLBiCGStab:
+      {
+        viennacl::linalg::bicgstab_tag tag(solver->tolerance, solver->max_iterations);
+        result = viennacl::linalg::solve(mat, rhs, tag, precond);
+        solver->iterations = tag.iters();
+        solver->error      = tag.error();
+        return ViennaCLSuccess;
+      }
+
+      case ViennaCLGMRES:
+      {
+        viennacl::linalg::gmres_tag tag(solver->tolerance, static_cast<unsigned int>(solver->max_iterations), static_cast<unsigned int>(solver->krylov_dim));
+        result = viennacl::linalg::solve(mat, rhs, tag, precond);
+        solver->iterations = tag.iters();
+        solver->error      = tag.error();
+        return ViennaCLSuccess;
+      }
+
+      default:
+        return ViennaCLGenericFailure;
+    }
+  }
+
+  /** @brief Returns the preconditioner cached in the solver handle. Sets it up if A differs from the matrix of the last call, and updates it if only the values of A have changed. */
+  template <typename PrecondT, typename TagT, typename MatrixT>
+  PrecondT & cached_preconditioner(ViennaCLSolver solver, ViennaCLCompressedMatrix A, MatrixT const & mat, TagT const & tag)
+  {
+    cached_precond<PrecondT> * p = dynamic_cast<cached_precond<PrecondT> *>(solver->precond);
+
+    if (!p || solver->precond_matrix_id != A->id)
+    {
+      delete solver->precond;
+      solver->precond = NULL;
+
+      p = new cached_precond<PrecondT>(new PrecondT(mat, tag));
+      solver->precond = p;
+      solver->precond_matrix_id      = A->id;
+      solver->precond_matrix_version = A->version;
+    }
+    else if (solver->precond_matrix_version != A->version)
+    {
+      p->get().refactor(mat);
+      solver->precond_matrix_version = A->version;
+    }
+
+    return p->get();
+  }
+
+  template <typename NumericT>
+  ViennaCLStatus solve_impl(ViennaCLSolver solver, ViennaCLCompressedMatrix A, ViennaCLVector b, ViennaCLVector x)
+  {
+    typedef viennacl::compressed_matrix<NumericT>   MatrixType;
+
+    viennacl::backend::mem_handle b_handle;
+    viennacl::backend::mem_handle x_handle;
+
+    if (init_vector(b_handle, b) != ViennaCLSuccess)
+      return ViennaCLGenericFailure;
+
+    if (init_vector(x_handle, x) != ViennaCLSuccess)
+      return ViennaCLGenericFailure;
+
+    MatrixType const & mat = *get_compressed_matrix<NumericT>(A);
+    viennacl::vector_base<NumericT> b_vec(b_handle, b->size, b->offset, b->inc);
+    viennacl::vector_base<NumericT> x_vec(x_handle, x->size, x->offset, x->inc);
+
+    // the solvers require vectors with unit stride:
+    viennacl::vector<NumericT> rhs(b->size, viennacl::traits::context(mat));
+    viennacl::vector<NumericT> result(x->size, viennacl::traits::context(mat));
+    rhs = b_vec;
+
+    ViennaCLStatus status = ViennaCLGenericFailure;
+    switch (solver->precond_type)
+    {
+      case ViennaCLNoPrecond:
+        status = run_solver(solver, mat, rhs, result, viennacl::linalg::no_precond());
+        break;
+
+      case ViennaCLJacobiPrecond:
+        status = run_solver(solver, mat, rhs, result,
+                            cached_preconditioner<viennacl::linalg::jacobi_precond<MatrixType> >(solver, A, mat, viennacl::linalg::jacobi_tag()));
+        break;
+
+      case ViennaCLILU0Precond:
+        status = run_solver(solver, mat, rhs, result,
+                            cached_preconditioner<viennacl::linalg::ilu0_precond<MatrixType> >(solver, A, mat, viennacl::linalg::ilu0_tag()));
+        break;
+
+      case ViennaCLAMGPrecond:
+#ifdef VIENNACL_WITH_AMG
+      {
+        if (A->backend_type != ViennaCLOpenCL)   // the AMG smoother of ViennaCL is implemented for OpenCL only
+          return ViennaCLGenericFailure;
+
+        bool new_setup = (solver->precond_matrix_id != A->id) || !dynamic_cast<cached_precond<viennacl::linalg::amg_precond<MatrixType> > *>(solver->precond);
+        viennacl::linalg::amg_precond<MatrixType> & amg = cached_preconditioner<viennacl::linalg::amg_precond<MatrixType> >(solver, A, mat, viennacl::linalg::amg_tag());
+        if (new_setup)
+          amg.setup();
+        status = run_solver(solver, mat, rhs, result, amg);
+        break;
+      }
+#else
+        return ViennaCLGenericFailure;
+#endif
+
+      default:
+        return ViennaCLGenericFailure;
+    }
+
+    if (status == ViennaCLSuccess)
+      x_vec = result;
+    return status;
+  }
+}
+
+
+// Solver management
+
+ViennaCLStatus ViennaCLSolverCreate(ViennaCLSolver *solver, ViennaCLSolverType solver_type, ViennaCLPrecondType precond_type)
+{
+  *solver = new ViennaCLSolver_impl();
+  (*solver)->solver_type    = solver_type;
+  (*solver)->precond_type   = precond_type;
+  (*solver)->tolerance      = 1e-8;
+  (*solver)->max_iterations = 300;
+  (*solver)->krylov_dim     = 20;
+  (*solver)->iterations     = 0;
+  (*solver)->error          = 0;
+  (*solver)->precond        = NULL;
+  (*solver)->precond_matrix_id      = 0;
+  (*solver)->precond_matrix_version = 0;
+  return ViennaCLSuccess;
+}
+
+ViennaCLStatus ViennaCLSolverFree(ViennaCLSolver solver)
+{
+  delete solver->precond;
+  delete solver;
+  return ViennaCLSuccess;
+}
+
+ViennaCLStatus ViennaCLSolverSetTolerance(ViennaCLSolver solver, double tolerance)
+{
+  solver->tolerance = tolerance;
+  return ViennaCLSuccess;
+}
+
+ViennaCLStatus ViennaCLSolverSetMaxIterations(ViennaCLSolver solver, size_t max_iterations)
+{
+  solver->max_iterations = max_iterations;
+  return ViennaCLSuccess;
+}
+
+ViennaCLStatus ViennaCLSolverSetKrylovDim(ViennaCLSolver solver, size_t krylov_dim)
+{
+  solver->krylov_dim = krylov_dim;
+  return ViennaCLSuccess;
+}
+
+ViennaCLStatus ViennaCLSolverIterations(ViennaCLSolver solver, size_t *iterations)
+{
+  *iterations = solver->iterations;
+  return ViennaCLSuccess;
+}
+
+ViennaCLStatus ViennaCLSolverError(ViennaCLSolver solver, double *error)
+{
+  *error = solver->error;
+  return ViennaCLSuccess;
+}
+
+
+// Solve
+
+ViennaCLStatus ViennaCLsolve(ViennaCLSolver solver, ViennaCLCompressedMatrix A, ViennaCLVector b, ViennaCLVector x)
+{
+  if (A->precision != b->precision || A->precision != x->precision)
+    return ViennaCLGenericFailure;
+
+  if (A->backend_type != b->backend->backend_type || A->backend_type != x->backend->backend_type)
+    return ViennaCLGenericFailure;
+
+  try
+  {
+    switch (A->precision)
+    {
+      case ViennaCLFloat:
+        return solve_impl<float>(solver, A, b, x);
+
+      case ViennaCLDouble:
+        return solve_impl<double>(solver, A, b, x);
+
+      default:
+        return ViennaCLGenericFailure;
+    }
+  }
+  catch (...)   // e.g. zero pivot in ILU0 or zero diagonal in Jacobi
+  {
+    return ViennaCLGenericFailure;
+  }
+}
@@ -0,0 +1 @@
+solve.cpp
\ No newline at end of file
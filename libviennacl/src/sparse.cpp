@@ -0,0 +1,105 @@
+/* =========================================================================
+   Copyright (c) 2010-2013, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+// include necessary system headers
+#include <iostream>
+
+#include "viennacl.hpp"
+#include "init_vector.hpp"
+#include "sparse_impl.hpp"
+
+//include basic scalar and vector types of ViennaCL
+#include "viennacl/scalar.hpp"
+#include "viennacl/vector.hpp"
+#include "viennacl/compressed_matrix.hpp"
+#include "viennacl/linalg/prod.hpp"
+
+
+// CSR management
+
+ViennaCLStatus ViennaCLcsrFree(ViennaCLCompressedMatrix A)
+{
+  delete A->float_matrix;
+  delete A->double_matrix;
+  delete A;
+  return ViennaCLSuccess;
+}
+
+ViennaCLStatus ViennaCLcsrValuesChanged(ViennaCLCompressedMatrix A)
+{
+  ++A->version;
+  return ViennaCLSuccess;
+}
+
+
+// xCSRMV
+
+ViennaCLStatus ViennaCLcsrmv(ViennaCLHostScalar alpha, ViennaCLCompressedMatrix A, ViennaCLVector x, ViennaCLHostScalar beta, ViennaCLVector y)
+{
+  viennacl::backend::mem_handle v1_handle;
+  viennacl::backend::mem_handle v2_handle;
+
+  if (init_vector(v1_handle, x) != ViennaCLSuccess)
+    return ViennaCLGenericFailure;
+
+  if (init_vector(v2_handle, y) != ViennaCLSuccess)
+    return ViennaCLGenericFailure;
+
+  if (A->precision != x->precision || A->precision != y->precision)
+    return ViennaCLGenericFailure;
+
+  if (A->backend_type != x->backend->backend_type || A->backend_type != y->backend->backend_type)
+    return ViennaCLGenericFailure;
+
+  switch (A->precision)
+  {
+    case ViennaCLFloat:
+    {
+      viennacl::compressed_matrix<float> const & mat = *(A->float_matrix);
+      viennacl::vector_base<float> v1(v1_handle, x->size, x->offset, x->inc);
+      viennacl::vector_base<float> v2(v2_handle, y->size, y->offset, y->inc);
+
+      if (beta->value_float == 0)   //y may be uninitialized, so it must not be scaled (0 * NaN = NaN)
+        v2 = alpha->value_float * viennacl::linalg::prod(mat, v1);
+      else
+      {
+        v2 *= beta->value_float;
+        v2 += alpha->value_float * viennacl::linalg::prod(mat, v1);
+      }
+      return ViennaCLSuccess;
+    }
+
+    case ViennaCLDouble:
+    {
+      viennacl::compressed_matrix<double> const & mat = *(A->double_matrix);
+      viennacl::vector_base<double> v1(v1_handle, x->size, x->offset, x->inc);
+      viennacl::vector_base<double> v2(v2_handle, y->size, y->offset, y->inc);
+
+      if (beta->value_double == 0)   //y may be uninitialized, so it must not be scaled (0 * NaN = NaN)
+        v2 = alpha->value_double * viennacl::linalg::prod(mat, v1);
+      else
+      {
+        v2 *= beta->value_double;
+        v2 += alpha->value_double * viennacl::linalg::prod(mat, v1);
+      }
+      return ViennaCLSuccess;
+    }
+
+    default:
+      return ViennaCLGenericFailure;
+  }
+}
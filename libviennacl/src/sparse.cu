@@ -0,0 +1 @@
+sparse.cpp
\ No newline at end of file
@@ -0,0 +1,96 @@
+/* =========================================================================
+   Copyright (c) 2010-2013, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+// include necessary system headers
+#include <iostream>
+
+#include "viennacl.hpp"
+#include "sparse_impl.hpp"
+
+//include basic scalar and vector types of ViennaCL
+#include "viennacl/scalar.hpp"
+#include "viennacl/vector.hpp"
+#include "viennacl/compressed_matrix.hpp"
+#include "viennacl/linalg/prod.hpp"
+
+
+// CSR creation
+
+ViennaCLStatus ViennaCLHostScsrCreate(ViennaCLHostBackend /*backend*/, ViennaCLCompressedMatrix *A,
+                                      size_t rows, size_t cols, size_t nnz,
+                                      unsigned int *row_offsets, unsigned int *col_indices, float *values)
+{
+  return create_compressed_matrix(A, ViennaCLHost, new viennacl::compressed_matrix<float>(row_offsets, col_indices, values, viennacl::MAIN_MEMORY, rows, cols, nnz));
+}
+
+ViennaCLStatus ViennaCLHostDcsrCreate(ViennaCLHostBackend /*backend*/, ViennaCLCompressedMatrix *A,
+                                      size_t rows, size_t cols, size_t nnz,
+                                      unsigned int *row_offsets, unsigned int *col_indices, double *values)
+{
+  return create_compressed_matrix(A, ViennaCLHost, new viennacl::compressed_matrix<double>(row_offsets, col_indices, values, viennacl::MAIN_MEMORY, rows, cols, nnz));
+}
+
+
+// xCSRMV
+
+ViennaCLStatus ViennaCLHostScsrmv(ViennaCLHostBackend /*backend*/, ViennaCLCompressedMatrix A,
+                                  float alpha,
+                                  float *x, size_t offx, int incx,
+                                  float beta,
+                                  float *y, size_t offy, int incy)
+{
+  if (A->precision != ViennaCLFloat || A->backend_type != ViennaCLHost)
+    return ViennaCLGenericFailure;
+
+  viennacl::compressed_matrix<float> const & mat = *(A->float_matrix);
+  viennacl::vector_base<float> v1(x, viennacl::MAIN_MEMORY, mat.size2(), offx, incx);
+  viennacl::vector_base<float> v2(y, viennacl::MAIN_MEMORY, mat.size1(), offy, incy);
+
+  if (beta == 0)
+    v2 = alpha * viennacl::linalg::prod(mat, v1);
+  else
+  {
+    v2 *= beta;
+    v2 += alpha * viennacl::linalg::prod(mat, v1);
+  }
+
+  return ViennaCLSuccess;
+}
+
+ViennaCLStatus ViennaCLHostDcsrmv(ViennaCLHostBackend /*backend*/, ViennaCLCompressedMatrix A,
+                                  double alpha,
+                                  double *x, size_t offx, int incx,
+                                  double beta,
+                                  double *y, size_t offy, int incy)
+{
+  if (A->precision != ViennaCLDouble || A->backend_type != ViennaCLHost)
+    return ViennaCLGenericFailure;
+
+  viennacl::compressed_matrix<double> const & mat = *(A->double_matrix);
+  viennacl::vector_base<double> v1(x, viennacl::MAIN_MEMORY, mat.size2(), offx, incx);
+  viennacl::vector_base<double> v2(y, viennacl::MAIN_MEMORY, mat.size1(), offy, incy);
+
+  if (beta == 0)
+    v2 = alpha * viennacl::linalg::prod(mat, v1);
+  else
+  {
+    v2 *= beta;
+    v2 += alpha * viennacl::linalg::prod(mat, v1);
+  }
+
+  return ViennaCLSuccess;
+}
@@ -0,0 +1 @@
+sparse_host.cpp
\ No newline at end of file
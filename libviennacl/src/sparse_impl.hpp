@@ -0,0 +1,96 @@
+#ifndef VIENNACL_LIBVIENNACL_SRC_SPARSE_IMPL_HPP
+#define VIENNACL_LIBVIENNACL_SRC_SPARSE_IMPL_HPP
+
+/* =========================================================================
+   Copyright (c) 2010-2013, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+#include "viennacl.hpp"
+#include "viennacl/compressed_matrix.hpp"
+#include "viennacl/tools/mutex.hpp"
+
+
+/** @brief Holds the compressed_matrix wrapping the user-supplied CSR arrays. The version is incremented whenever the values change, so that solvers know when to recompute their preconditioner. */
+struct ViennaCLCompressedMatrix_impl
+{
+  ViennaCLBackendTypes  backend_type;
+  ViennaCLPrecision     precision;
+
+  viennacl::compressed_matrix<float>  * float_matrix;
+  viennacl::compressed_matrix<double> * double_matrix;
+
+  size_t   id;
+  size_t   version;
+};
+
+
+template <typename NumericT>
+viennacl::compressed_matrix<NumericT> * get_compressed_matrix(ViennaCLCompressedMatrix A);
+
+template <>
+inline viennacl::compressed_matrix<float> * get_compressed_matrix<float>(ViennaCLCompressedMatrix A) { return A->float_matrix; }
+
+template <>
+inline viennacl::compressed_matrix<double> * get_compressed_matrix<double>(ViennaCLCompressedMatrix A) { return A->double_matrix; }
+
+
+inline void set_compressed_matrix(ViennaCLCompressedMatrix A, viennacl::compressed_matrix<float> * mat)
+{
+  A->precision    = ViennaCLFloat;
+  A->float_matrix = mat;
+}
+
+inline void set_compressed_matrix(ViennaCLCompressedMatrix A, viennacl::compressed_matrix<double> * mat)
+{
+  A->precision     = ViennaCLDouble;
+  A->double_matrix = mat;
+}
+
+template <bool dummy = false>  //never use parameter other than default (introduced for linkage issues only)
+struct compressed_matrix_id_counter
+{
+  static viennacl::tools::mutex mutex_;
+  static size_t id_;
+};
+
+template <bool dummy>
+viennacl::tools::mutex compressed_matrix_id_counter<dummy>::mutex_;
+
+template <bool dummy>
+size_t compressed_matrix_id_counter<dummy>::id_ = 0;
+
+/** @brief Returns a new identifier for a matrix handle. Handles may be created from several threads concurrently. */
+inline size_t next_compressed_matrix_id()
+{
+  viennacl::tools::scoped_lock lock(compressed_matrix_id_counter<>::mutex_);
+  return ++compressed_matrix_id_counter<>::id_;
+}
+
+/** @brief Creates a handle for the compressed_matrix. Takes ownership of 'mat'. */
+template <typename NumericT>
+ViennaCLStatus create_compressed_matrix(ViennaCLCompressedMatrix *A, ViennaCLBackendTypes backend_type, viennacl::compressed_matrix<NumericT> * mat)
+{
+  *A = new ViennaCLCompressedMatrix_impl();
+  (*A)->backend_type  = backend_type;
+  (*A)->float_matrix  = NULL;
+  (*A)->double_matrix = NULL;
+  set_compressed_matrix(*A, mat);
+  (*A)->id            = next_compressed_matrix_id();
+  (*A)->version       = 0;
+  return ViennaCLSuccess;
+}
+
+#endif
@@ -0,0 +1,101 @@
+/* =========================================================================
+   Copyright (c) 2010-2013, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+// include necessary system headers
+#include <iostream>
+
+#include "viennacl.hpp"
+#include "sparse_impl.hpp"
+
+//include basic scalar and vector types of ViennaCL
+#include "viennacl/scalar.hpp"
+#include "viennacl/vector.hpp"
+#include "viennacl/compressed_matrix.hpp"
+#include "viennacl/linalg/prod.hpp"
+
+#ifdef VIENNACL_WITH_OPENCL
+
+// CSR creation
+
+ViennaCLStatus ViennaCLOpenCLScsrCreate(ViennaCLOpenCLBackend backend, ViennaCLCompressedMatrix *A,
+                                        size_t rows, size_t cols, size_t nnz,
+                                        cl_mem row_offsets, cl_mem col_indices, cl_mem values)
+{
+  return create_compressed_matrix(A, ViennaCLOpenCL, new viennacl::compressed_matrix<float>(row_offsets, col_indices, values, rows, cols, nnz,
+                                                                                            viennacl::ocl::get_context(backend->context_id)));
+}
+
+ViennaCLStatus ViennaCLOpenCLDcsrCreate(ViennaCLOpenCLBackend backend, ViennaCLCompressedMatrix *A,
+                                        size_t rows, size_t cols, size_t nnz,
+                                        cl_mem row_offsets, cl_mem col_indices, cl_mem values)
+{
+  return create_compressed_matrix(A, ViennaCLOpenCL, new viennacl::compressed_matrix<double>(row_offsets, col_indices, values, rows, cols, nnz,
+                                                                                             viennacl::ocl::get_context(backend->context_id)));
+}
+
+
+// xCSRMV
+
+ViennaCLStatus ViennaCLOpenCLScsrmv(ViennaCLOpenCLBackend backend, ViennaCLCompressedMatrix A,
+                                    float alpha,
+                                    cl_mem x, size_t offx, int incx,
+                                    float beta,
+                                    cl_mem y, size_t offy, int incy)
+{
+  if (A->precision != ViennaCLFloat || A->backend_type != ViennaCLOpenCL)
+    return ViennaCLGenericFailure;
+
+  viennacl::compressed_matrix<float> const & mat = *(A->float_matrix);
+  viennacl::vector_base<float> v1(x, mat.size2(), offx, incx, viennacl::ocl::get_context(backend->context_id));
+  viennacl::vector_base<float> v2(y, mat.size1(), offy, incy, viennacl::ocl::get_context(backend->context_id));
+
+  if (beta == 0)
+    v2 = alpha * viennacl::linalg::prod(mat, v1);
+  else
+  {
+    v2 *= beta;
+    v2 += alpha * viennacl::linalg::prod(mat, v1);
+  }
+
+  return ViennaCLSuccess;
+}
+
+ViennaCLStatus ViennaCLOpenCLDcsrmv(ViennaCLOpenCLBackend backend, ViennaCLCompressedMatrix A,
+                                    double alpha,
+                                    cl_mem x, size_t offx, int incx,
+                                    double beta,
+                                    cl_mem y, size_t offy, int incy)
+{
+  if (A->precision != ViennaCLDouble || A->backend_type != ViennaCLOpenCL)
+    return ViennaCLGenericFailure;
+
+  viennacl::compressed_matrix<double> const & mat = *(A->double_matrix);
+  viennacl::vector_base<double> v1(x, mat.size2(), offx, incx, viennacl::ocl::get_context(backend->context_id));
+  viennacl::vector_base<double> v2(y, mat.size1(), offy, incy, viennacl::ocl::get_context(backend->context_id));
+
+  if (beta == 0)
+    v2 = alpha * viennacl::linalg::prod(mat, v1);
+  else
+  {
+    v2 *= beta;
+    v2 += alpha * viennacl::linalg::prod(mat, v1);
+  }
+
+  return ViennaCLSuccess;
+}
+
+#endif
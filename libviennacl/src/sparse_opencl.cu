@@ -0,0 +1 @@
+sparse_opencl.cpp
\ No newline at end of file
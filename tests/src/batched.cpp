@@ -0,0 +1,355 @@
+/* =========================================================================
+   Copyright (c) 2010-2013, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+//
+// *** System
+//
+#include <iostream>
+#include <vector>
+#include <cmath>
+#include <cstdlib>
+#include <algorithm>
+#include <limits>
+
+//
+// *** ViennaCL
+//
+#include "viennacl/vector.hpp"
+#include "viennacl/linalg/batched.hpp"
+
+//
+// -------------------------------------------------------------
+//
+
+template <typename NumericT>
+NumericT random_value()
+{
+  return NumericT(2) * static_cast<NumericT>(rand()) / static_cast<NumericT>(RAND_MAX) - NumericT(1);
+}
+
+template <typename NumericT>
+NumericT & entry(std::vector<NumericT> & buffer, viennacl::linalg::batch_layout const & layout, std::size_t b, std::size_t i, std::size_t j)
+{
+  return buffer[layout.start() + b * layout.batch_stride() + i * layout.stride1() + j * layout.stride2()];
+}
+
+/** @brief A column-major layout with leading dimension size1 + 2, gaps between the matrices and an offset */
+inline viennacl::linalg::batch_layout padded_column_major(std::size_t size1, std::size_t size2, std::size_t batch_count)
+{
+  return viennacl::linalg::batch_layout(size1, size2, batch_count, 5, 1, size1 + 2, (size1 + 2) * size2 + 3);
+}
+
+template <typename NumericT>
+void to_device(std::vector<NumericT> const & host, viennacl::vector<NumericT> & device)
+{
+  device.resize(host.size(), false);
+  viennacl::copy(host, device);
+}
+
+template <typename NumericT>
+NumericT max_rel_diff(std::vector<NumericT> const & ref, viennacl::vector<NumericT> const & device, viennacl::linalg::batch_layout const & layout)
+{
+  std::vector<NumericT> result(device.size());
+  viennacl::copy(device, result);
+
+  NumericT diff = 0;
+  for (std::size_t b=0; b<layout.batch_count(); ++b)
+    for (std::size_t i=0; i<layout.size1(); ++i)
+      for (std::size_t j=0; j<layout.size2(); ++j)
+      {
+        std::size_t index = layout.start() + b * layout.batch_stride() + i * layout.stride1() + j * layout.stride2();
+        diff = std::max(diff, std::fabs(ref[index] - result[index]) / std::max(NumericT(1), std::fabs(ref[index])));
+      }
+  return diff;
+}
+
+
+template <typename NumericT>
+int test_prod(std::size_t m, std::size_t n, std::size_t k, std::size_t batch_count, NumericT beta, NumericT epsilon)
+{
+  viennacl::linalg::batch_layout layout_A(m, k, batch_count);                          //packed row-major
+  viennacl::linalg::batch_layout layout_B = padded_column_major(n, k, batch_count).trans();  //transposed view of column-major (n x k) matrices
+  viennacl::linalg::batch_layout layout_C = padded_column_major(m, n, batch_count);
+
+  std::vector<NumericT> A(layout_A.extent()), B(layout_B.extent()), C(layout_C.extent());
+  for (std::size_t i=0; i<A.size(); ++i) A[i] = random_value<NumericT>();
+  for (std::size_t i=0; i<B.size(); ++i) B[i] = random_value<NumericT>();
+  for (std::size_t i=0; i<C.size(); ++i) C[i] = (beta != 0) ? random_value<NumericT>() : std::numeric_limits<NumericT>::quiet_NaN();  // C must not be read for beta == 0
+
+  viennacl::vector<NumericT> vcl_A, vcl_B, vcl_C;
+  to_device(A, vcl_A);
+  to_device(B, vcl_B);
+  to_device(C, vcl_C);
+
+  NumericT alpha = NumericT(1.5);
+  std::vector<NumericT> C_ref(C);
+  for (std::size_t b=0; b<batch_count; ++b)
+    for (std::size_t i=0; i<m; ++i)
+      for (std::size_t j=0; j<n; ++j)
+      {
+        NumericT sum = 0;
+        for (std::size_t p=0; p<k; ++p)
+          sum += entry(A, layout_A, b, i, p) * entry(B, layout_B, b, p, j);
+        NumericT & c = entry(C_ref, layout_C, b, i, j);
+        c = (beta != 0) ? alpha * sum + beta * c : alpha * sum;
+      }
+
+  viennacl::linalg::batched_prod(alpha, vcl_A, layout_A, vcl_B, layout_B, beta, vcl_C, layout_C);
+  NumericT diff = max_rel_diff(C_ref, vcl_C, layout_C);
+  if (diff > epsilon)
+  {
+    std::cout << "# Error at operation: batched_prod, m = " << m << ", n = " << n << ", k = " << k << ", beta = " << beta << std::endl;
+    std::cout << "  diff: " << diff << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // pointer-array interface on the host:
+  if (beta != 0)
+  {
+    std::vector<NumericT const *> ptr_A(batch_count), ptr_B(batch_count);
+    std::vector<NumericT *> ptr_C(batch_count);
+    for (std::size_t b=0; b<batch_count; ++b)
+    {
+      ptr_A[b] = &(A[0]) + b * layout_A.batch_stride();
+      ptr_B[b] = &(B[0]) + b * layout_B.batch_stride();
+      ptr_C[b] = &(C[0]) + b * layout_C.batch_stride();
+    }
+    viennacl::linalg::host_based::batched_prod(alpha, &(ptr_A[0]), layout_A, &(ptr_B[0]), layout_B, beta, &(ptr_C[0]), layout_C);
+    for (std::size_t b=0; b<batch_count; ++b)
+      for (std::size_t i=0; i<m; ++i)
+        for (std::size_t j=0; j<n; ++j)
+          if (std::fabs(entry(C, layout_C, b, i, j) - entry(C_ref, layout_C, b, i, j)) > epsilon * std::max(NumericT(1), std::fabs(entry(C_ref, layout_C, b, i, j))))
+          {
+            std::cout << "# Error at operation: host_based::batched_prod with pointer arrays, m = " << m << ", n = " << n << ", k = " << k << std::endl;
+            return EXIT_FAILURE;
+          }
+  }
+
+  return EXIT_SUCCESS;
+}
+
+
+template <typename NumericT, typename SolverTag>
+int test_solve(std::size_t m, std::size_t n, std::size_t batch_count, SolverTag tag, NumericT epsilon)
+{
+  viennacl::linalg::batch_layout layout_A = padded_column_major(m, m, batch_count);
+  viennacl::linalg::batch_layout layout_B(m, n, batch_count);
+
+  bool lower = viennacl::linalg::detail::batched_is_lower(tag);
+  bool unit  = viennacl::linalg::detail::batched_is_unit(tag);
+
+  // well-conditioned triangular matrices, the other triangle holds garbage which must not be accessed:
+  std::vector<NumericT> A(layout_A.extent()), B(layout_B.extent());
+  for (std::size_t i=0; i<A.size(); ++i) A[i] = NumericT(100) * random_value<NumericT>();
+  for (std::size_t b=0; b<batch_count; ++b)
+    for (std::size_t i=0; i<m; ++i)
+      for (std::size_t j=0; j<m; ++j)
+        if (i == j)
+          entry(A, layout_A, b, i, j) = unit ? NumericT(1000) : NumericT(2) + random_value<NumericT>();
+        else if ((i > j) == lower)
+          entry(A, layout_A, b, i, j) = random_value<NumericT>() / NumericT(m);
+  for (std::size_t i=0; i<B.size(); ++i) B[i] = random_value<NumericT>();
+
+  viennacl::vector<NumericT> vcl_A, vcl_B;
+  to_device(A, vcl_A);
+  to_device(B, vcl_B);
+
+  std::vector<NumericT> X(B);
+  for (std::size_t b=0; b<batch_count; ++b)
+    for (std::size_t j=0; j<n; ++j)
+      for (std::size_t ii=0; ii<m; ++ii)
+      {
+        std::size_t i = lower ? ii : m - ii - 1;
+        NumericT sum = entry(X, layout_B, b, i, j);
+        for (std::size_t p=0; p<m; ++p)
+          if (p != i && (p < i) == lower)
+            sum -= entry(A, layout_A, b, i, p) * entry(X, layout_B, b, p, j);
+        entry(X, layout_B, b, i, j) = unit ? sum : sum / entry(A, layout_A, b, i, i);
+      }
+
+  viennacl::linalg::batched_inplace_solve(vcl_A, layout_A, vcl_B, layout_B, tag);
+  NumericT diff = max_rel_diff(X, vcl_B, layout_B);
+  if (diff > epsilon)
+  {
+    std::cout << "# Error at operation: batched_inplace_solve, m = " << m << ", n = " << n << ", tag = " << SolverTag::name() << std::endl;
+    std::cout << "  diff: " << diff << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
+
+
+template <typename NumericT>
+int test_lu(std::size_t n, std::size_t num_rhs, std::size_t batch_count, NumericT epsilon)
+{
+  viennacl::linalg::batch_layout layout_A = padded_column_major(n, n, batch_count);
+  viennacl::linalg::batch_layout layout_B(n, num_rhs, batch_count);
+
+  // diagonally dominant matrices with randomly permuted rows, so that pivoting is required:
+  std::vector<NumericT> A(layout_A.extent()), B(layout_B.extent());
+  for (std::size_t b=0; b<batch_count; ++b)
+  {
+    std::vector<std::size_t> perm(n);
+    for (std::size_t i=0; i<n; ++i)
+      perm[i] = i;
+    std::random_shuffle(perm.begin(), perm.end());
+    for (std::size_t i=0; i<n; ++i)
+      for (std::size_t j=0; j<n; ++j)
+        entry(A, layout_A, b, perm[i], j) = (i == j) ? NumericT(2) + random_value<NumericT>() : random_value<NumericT>() / NumericT(n);
+  }
+  for (std::size_t i=0; i<B.size(); ++i) B[i] = random_value<NumericT>();
+
+  viennacl::vector<NumericT> vcl_A, vcl_B;
+  viennacl::vector<unsigned int> vcl_pivots(n * batch_count);
+  to_device(A, vcl_A);
+  to_device(B, vcl_B);
+
+  viennacl::linalg::batched_lu_factorize(vcl_A, layout_A, vcl_pivots);
+  viennacl::linalg::batched_lu_substitute(vcl_A, layout_A, vcl_pivots, vcl_B, layout_B);
+
+  // check residual A * X - B:
+  std::vector<NumericT> X(B.size());
+  viennacl::copy(vcl_B, X);
+  NumericT diff = 0;
+  for (std::size_t b=0; b<batch_count; ++b)
+    for (std::size_t i=0; i<n; ++i)
+      for (std::size_t j=0; j<num_rhs; ++j)
+      {
+        NumericT sum = 0;
+        for (std::size_t p=0; p<n; ++p)
+          sum += entry(A, layout_A, b, i, p) * entry(X, layout_B, b, p, j);
+        diff = std::max(diff, std::fabs(sum - entry(B, layout_B, b, i, j)));
+      }
+  if (diff > epsilon)
+  {
+    std::cout << "# Error at operation: batched_lu_factorize/batched_lu_substitute, n = " << n << ", num_rhs = " << num_rhs << std::endl;
+    std::cout << "  residual: " << diff << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // pivots must follow the convention of lu_factorize(), i.e. pivots[i] >= i:
+  std::vector<unsigned int> pivots(vcl_pivots.size());
+  viennacl::copy(vcl_pivots, pivots);
+  for (std::size_t b=0; b<batch_count; ++b)
+    for (std::size_t i=0; i<n; ++i)
+      if (pivots[b*n + i] < i || pivots[b*n + i] >= n)
+      {
+        std::cout << "# Error at operation: batched_lu_factorize, invalid pivot " << pivots[b*n + i] << " in row " << i << std::endl;
+        return EXIT_FAILURE;
+      }
+
+  return EXIT_SUCCESS;
+}
+
+
+template <typename NumericT>
+int test(NumericT epsilon)
+{
+  std::size_t sizes[] = {1, 3, 8, 13, 32, 33, 64, 70};
+  std::size_t num_sizes = sizeof(sizes) / sizeof(sizes[0]);
+
+  for (std::size_t s=0; s<num_sizes; ++s)
+  {
+    std::size_t n = sizes[s];
+    std::size_t batch_count = (n < 20) ? 57 : 9;
+    std::cout << "  size " << n << ", batch count " << batch_count << std::endl;
+
+    if (test_prod<NumericT>(n, n, n, batch_count, NumericT(0), epsilon) != EXIT_SUCCESS)
+      return EXIT_FAILURE;
+    if (test_prod<NumericT>(n, n, n, batch_count, NumericT(0.5), epsilon) != EXIT_SUCCESS)
+      return EXIT_FAILURE;
+    if (test_prod<NumericT>(n + 2, std::max<std::size_t>(n / 2, 1), n, batch_count, NumericT(-1), epsilon) != EXIT_SUCCESS)
+      return EXIT_FAILURE;
+
+    if (test_solve<NumericT>(n, 3, batch_count, viennacl::linalg::lower_tag(), epsilon) != EXIT_SUCCESS)
+      return EXIT_FAILURE;
+    if (test_solve<NumericT>(n, n, batch_count, viennacl::linalg::unit_lower_tag(), epsilon) != EXIT_SUCCESS)
+      return EXIT_FAILURE;
+    if (test_solve<NumericT>(n, 1, batch_count, viennacl::linalg::upper_tag(), epsilon) != EXIT_SUCCESS)
+      return EXIT_FAILURE;
+    if (test_solve<NumericT>(n, n + 1, batch_count, viennacl::linalg::unit_upper_tag(), epsilon) != EXIT_SUCCESS)
+      return EXIT_FAILURE;
+
+    if (test_lu<NumericT>(n, 1, batch_count, epsilon) != EXIT_SUCCESS)
+      return EXIT_FAILURE;
+    if (test_lu<NumericT>(n, 5, batch_count, epsilon) != EXIT_SUCCESS)
+      return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
+
+//
+// -------------------------------------------------------------
+//
+int main()
+{
+  std::cout << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "## Test :: Batched Operations on Small Dense Matrices" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << std::endl;
+
+  int retval = EXIT_SUCCESS;
+
+  std::cout << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << std::endl;
+  {
+    typedef float NumericT;
+    NumericT epsilon = static_cast<NumericT>(1E-4);
+    std::cout << "# Testing setup:" << std::endl;
+    std::cout << "  eps:     " << epsilon << std::endl;
+    std::cout << "  numeric: float" << std::endl;
+    retval = test<NumericT>(epsilon);
+    if( retval == EXIT_SUCCESS )
+        std::cout << "# Test passed" << std::endl;
+    else
+        return retval;
+  }
+  std::cout << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << std::endl;
+
+#ifdef VIENNACL_WITH_OPENCL
+  if( viennacl::ocl::current_device().double_support() )
+#endif
+  {
+    typedef double NumericT;
+    NumericT epsilon = 1.0E-10;
+    std::cout << "# Testing setup:" << std::endl;
+    std::cout << "  eps:     " << epsilon << std::endl;
+    std::cout << "  numeric: double" << std::endl;
+    retval = test<NumericT>(epsilon);
+    if( retval == EXIT_SUCCESS )
+        std::cout << "# Test passed" << std::endl;
+    else
+        return retval;
+  }
+  std::cout << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << std::endl;
+
+  std::cout << std::endl;
+  std::cout << "------- Test completed --------" << std::endl;
+  std::cout << std::endl;
+
+  return retval;
+}
@@ -0,0 +1,190 @@
+/* =========================================================================
+   Copyright (c) 2010-2013, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+#include <iostream>
+#include <vector>
+#include <map>
+#include <cmath>
+#include <cstdlib>
+#include <string>
+
+#include "viennacl/vector.hpp"
+#include "viennacl/matrix.hpp"
+#include "viennacl/compressed_matrix.hpp"
+#include "viennacl/linalg/prod.hpp"
+#include "viennacl/linalg/norm_2.hpp"
+#include "viennacl/linalg/jacobi_precond.hpp"
+#include "viennacl/linalg/lobpcg.hpp"
+#include "viennacl/linalg/krylov_schur.hpp"
+
+typedef double ScalarType;
+
+// Eigenvalues of the shifted 1D Laplace matrix tridiag(-1, 3, -1)
+ScalarType laplace_eigenvalue(std::size_t k, std::size_t n)
+{
+  ScalarType pi = ScalarType(3.14159265358979323846);
+  ScalarType s = std::sin(ScalarType(k + 1) * pi / ScalarType(2 * (n + 1)));
+  return ScalarType(1) + ScalarType(4) * s * s;
+}
+
+void fill_matrix(viennacl::compressed_matrix<ScalarType> & A, std::size_t n)
+{
+  std::vector< std::map<unsigned int, ScalarType> > stl_A(n);
+  for (std::size_t i=0; i<n; ++i)
+  {
+    stl_A[i][i] = 3.0;
+    if (i > 0)
+      stl_A[i][i-1] = -1.0;
+    if (i + 1 < n)
+      stl_A[i][i+1] = -1.0;
+  }
+  viennacl::copy(stl_A, A);
+}
+
+// Returns max_i ||A x_i - lambda_i x_i|| / |lambda_i|
+template <typename MatrixT>
+ScalarType max_residual(MatrixT const & A,
+                        viennacl::matrix<ScalarType, viennacl::column_major> const & X,
+                        std::vector<ScalarType> const & lambda)
+{
+  ScalarType max_res = 0;
+  for (std::size_t i=0; i<lambda.size(); ++i)
+  {
+    viennacl::vector<ScalarType> x = viennacl::column(X, static_cast<unsigned int>(i));
+    viennacl::vector<ScalarType> Ax = viennacl::linalg::prod(A, x);
+    Ax -= lambda[i] * x;
+    ScalarType res = viennacl::linalg::norm_2(Ax) / (std::fabs(lambda[i]) * viennacl::linalg::norm_2(x));
+    max_res = std::max(max_res, res);
+  }
+  return max_res;
+}
+
+int check_result(std::string const & name,
+                 std::vector<ScalarType> const & eigenvalues, std::vector<ScalarType> const & reference,
+                 ScalarType residual, std::size_t num_vectors)
+{
+  std::cout << "* " << name << ": maximum relative residual of eigenpairs: " << residual << std::endl;
+  if (eigenvalues.size() != reference.size() || num_vectors != reference.size())
+  {
+    std::cout << "# Error: Wrong number of eigenpairs: " << eigenvalues.size() << " vs. " << reference.size() << std::endl;
+    return EXIT_FAILURE;
+  }
+  for (std::size_t i=0; i<reference.size(); ++i)
+  {
+    if (std::fabs(eigenvalues[i] - reference[i]) > 1e-6 * std::fabs(reference[i]))
+    {
+      std::cout << "# Error at eigenvalue " << i << ": " << eigenvalues[i] << " vs. " << reference[i] << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  if (residual > 1e-5)
+  {
+    std::cout << "# Error: Eigenvectors not accurate enough!" << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
+
+int main()
+{
+  std::cout << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "## Test :: Block Eigensolvers" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+
+  std::size_t n = 400;
+  std::size_t nev = 6;
+  viennacl::compressed_matrix<ScalarType> A(n, n);
+  fill_matrix(A, n);
+
+  std::vector<ScalarType> smallest(nev), largest(nev);
+  for (std::size_t i=0; i<nev; ++i)
+  {
+    smallest[i] = laplace_eigenvalue(i, n);
+    largest[i]  = laplace_eigenvalue(n - i - 1, n);
+  }
+
+  viennacl::matrix<ScalarType, viennacl::column_major> X;
+  std::vector<ScalarType> eigenvalues;
+
+  //
+  // LOBPCG
+  //
+  viennacl::linalg::lobpcg_tag lobpcg_largest(nev, 1e-8, 1000, viennacl::linalg::lobpcg_tag::largest_eigenvalues);
+  eigenvalues = viennacl::linalg::eig(A, X, lobpcg_largest);
+  if (check_result("LOBPCG, largest", eigenvalues, largest, max_residual(A, X, eigenvalues), X.size2()) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  viennacl::linalg::lobpcg_tag lobpcg_smallest(nev, 1e-8, 2000);
+  viennacl::linalg::jacobi_precond< viennacl::compressed_matrix<ScalarType> > jacobi(A, viennacl::linalg::jacobi_tag());
+  eigenvalues = viennacl::linalg::eig(A, X, lobpcg_smallest, jacobi);
+  if (check_result("LOBPCG, smallest, Jacobi preconditioner", eigenvalues, smallest, max_residual(A, X, eigenvalues), X.size2()) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  // rank-deficient starting block with only two linearly independent columns:
+  {
+    std::vector< std::vector<ScalarType> > stl_X(n, std::vector<ScalarType>(nev));
+    for (std::size_t i=0; i<n; ++i)
+      for (std::size_t j=0; j<nev; ++j)
+        stl_X[i][j] = (j % 2) ? ScalarType(i % 3) : ScalarType(1);
+    X.resize(n, nev, false);
+    viennacl::copy(stl_X, X);
+  }
+  lobpcg_largest.initial_guess(true);
+  eigenvalues = viennacl::linalg::eig(A, X, lobpcg_largest);
+  if (check_result("LOBPCG, largest, rank-deficient start", eigenvalues, largest, max_residual(A, X, eigenvalues), X.size2()) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  //
+  // Block Krylov-Schur
+  //
+  viennacl::linalg::krylov_schur_tag ks_largest(nev, 3, 60, 1e-8, 500);
+  eigenvalues = viennacl::linalg::eig(A, X, ks_largest);
+  if (check_result("Krylov-Schur, largest", eigenvalues, largest, max_residual(A, X, eigenvalues), X.size2()) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  viennacl::linalg::krylov_schur_tag ks_smallest(nev, 4, 60, 1e-8, 500, viennacl::linalg::krylov_schur_tag::smallest_eigenvalues);
+  eigenvalues = viennacl::linalg::eig(A, X, ks_smallest);
+  if (check_result("Krylov-Schur, smallest", eigenvalues, smallest, max_residual(A, X, eigenvalues), X.size2()) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  // dense system matrix, row-major result:
+  viennacl::matrix<ScalarType> A_dense(n, n);
+  viennacl::matrix<ScalarType> X_row;
+  {
+    std::vector< std::vector<ScalarType> > stl_A(n, std::vector<ScalarType>(n));
+    for (std::size_t i=0; i<n; ++i)
+    {
+      stl_A[i][i] = 3.0;
+      if (i > 0)     stl_A[i][i-1] = -1.0;
+      if (i + 1 < n) stl_A[i][i+1] = -1.0;
+    }
+    viennacl::copy(stl_A, A_dense);
+  }
+  eigenvalues = viennacl::linalg::eig(A_dense, X_row, ks_largest);
+  viennacl::matrix<ScalarType, viennacl::column_major> X_col(n, X_row.size2());
+  viennacl::matrix<ScalarType, viennacl::column_major> I = viennacl::identity_matrix<ScalarType>(X_row.size2());
+  X_col = viennacl::linalg::prod(X_row, I);
+  if (check_result("Krylov-Schur, largest, dense", eigenvalues, largest, max_residual(A_dense, X_col, eigenvalues), X_row.size2()) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  std::cout << std::endl;
+  std::cout << "------- Test completed --------" << std::endl;
+  std::cout << std::endl;
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,127 @@
+/* =========================================================================
+   Copyright (c) 2010-2013, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+//
+// Tests for asynchronous transfers and kernel launches with events on multiple queues of a context
+//
+
+#include <iostream>
+#include <vector>
+#include <cmath>
+
+#include "viennacl/vector.hpp"
+#include "viennacl/linalg/opencl/kernels/vector.hpp"
+#include "viennacl/ocl/backend.hpp"
+#include "viennacl/ocl/event.hpp"
+
+typedef float     ScalarType;
+
+int check(std::vector<ScalarType> const & result, std::vector<ScalarType> const & reference, std::string const & name)
+{
+  for (std::size_t i=0; i<reference.size(); ++i)
+  {
+    if (std::fabs(result[i] - reference[i]) > 1e-5f * std::fabs(reference[i]))
+    {
+      std::cout << "# Error in " << name << " at entry " << i << ": " << result[i] << " vs. " << reference[i] << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  std::cout << "# " << name << " passed" << std::endl;
+  return EXIT_SUCCESS;
+}
+
+int main()
+{
+  std::cout << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "## Test :: Events and multiple queues" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+
+  std::size_t N = 1000;
+
+  viennacl::ocl::context & ctx = viennacl::ocl::current_context();
+  ctx.add_queue(ctx.devices()[0]);
+
+  viennacl::ocl::command_queue & compute_queue  = ctx.get_queue(ctx.devices()[0].id(), 0);
+  viennacl::ocl::command_queue & transfer_queue = ctx.get_queue(ctx.devices()[0].id(), 1);
+
+  std::vector<ScalarType> host_x(N), host_result(N), reference(N);
+  for (std::size_t i=0; i<N; ++i)
+    host_x[i] = ScalarType(i) + ScalarType(1);
+
+  viennacl::vector<ScalarType> x(N), y(N), z(N);
+
+  // events not referring to a command are complete:
+  viennacl::ocl::event empty;
+  empty = viennacl::ocl::event();
+  empty.wait();
+  if (!empty.completed())
+  {
+    std::cout << "# Error: Default-constructed event not complete" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // upload on the transfer queue, compute on the default queue once the upload has completed:
+  viennacl::ocl::event upload = viennacl::async_copy(host_x, x, transfer_queue);
+  compute_queue.wait_for(upload);
+  y = ScalarType(2) * x;
+  viennacl::ocl::event computed = compute_queue.marker();
+
+  // download on the transfer queue once the computation has completed:
+  std::vector<viennacl::ocl::event> dependencies(1, computed);
+  viennacl::ocl::event download = viennacl::async_copy(y, host_result, transfer_queue, dependencies);
+  download.wait();
+  if (!computed.completed() || !upload.completed())
+  {
+    std::cout << "# Error: Dependencies of completed transfer not complete" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  for (std::size_t i=0; i<N; ++i)
+    reference[i] = ScalarType(2) * host_x[i];
+  if (check(host_result, reference, "transfers and computation on different queues") != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  // kernel launch with dependencies, followed by a buffer copy depending on the launch:
+  viennacl::linalg::opencl::kernels::vector<ScalarType>::init(ctx);
+  viennacl::ocl::kernel & k = ctx.get_kernel(viennacl::linalg::opencl::kernels::vector<ScalarType>::program_name(), "assign_cpu");
+  std::vector<viennacl::ocl::event> launch_dependencies;
+  launch_dependencies.push_back(download);
+  launch_dependencies.push_back(viennacl::ocl::event());
+  viennacl::ocl::event launch = viennacl::ocl::enqueue(k(viennacl::traits::opencl_handle(y),
+                                                         cl_uint(0), cl_uint(1), cl_uint(N), cl_uint(y.internal_size()),
+                                                         ScalarType(3)),
+                                                       transfer_queue, launch_dependencies);
+
+  viennacl::ocl::event copied = viennacl::backend::opencl::memory_copy(y.handle().opencl_handle(), z.handle().opencl_handle(),
+                                                                       0, 0, sizeof(ScalarType) * N,
+                                                                       compute_queue, std::vector<viennacl::ocl::event>(1, launch));
+  compute_queue.wait_for(copied);
+  viennacl::ocl::event z_download = viennacl::async_copy(z, host_result, compute_queue);
+  viennacl::ocl::wait(std::vector<viennacl::ocl::event>(1, z_download));
+
+  for (std::size_t i=0; i<N; ++i)
+    reference[i] = ScalarType(3);
+  if (check(host_result, reference, "kernel launch and buffer copy with dependencies") != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  std::cout << std::endl;
+  std::cout << "------- Test completed --------" << std::endl;
+  std::cout << std::endl;
+
+  return EXIT_SUCCESS;
+}
@@ -181,6 +181,26 @@ int test_vector ( Epsilon const& epsilon) {
     viennacl::backend::finish();
     CHECK_RESULT(s, gs, s = inner_prod(x,y));
     }
+
+    {
+    std::cout << "w = x - y; z = element_prod(w, z) + x; s = inner_prod(w, z)..." << std::endl;
+    cw = cx - cy;
+    cz = element_prod(cw, cz) + cx;
+    s = 0;
+    for(unsigned int i=0 ; i<size ; ++i)  s+=cw[i]*cz[i];
+    viennacl::scheduler::statement statement1(w, viennacl::op_assign(), x - y);
+    viennacl::scheduler::statement statement2(z, viennacl::op_assign(), viennacl::linalg::element_prod(w, z) + x);
+    viennacl::scheduler::statement statement3(gs, viennacl::op_assign(), viennacl::linalg::inner_prod(w, z));
+    generator::code_generator gen;
+    gen.add(statement1, statement1.array()[0]);
+    gen.add(statement2, statement2.array()[0]);
+    gen.add(statement3, statement3.array()[0]);
+    generator::enqueue(gen);
+    viennacl::backend::finish();
+    CHECK_RESULT(cw, w, w = x - y);
+    CHECK_RESULT(cz, z, z = element_prod(w, z) + x);
+    CHECK_RESULT(s, gs, s = inner_prod(w, z));
+    }
 //    {
 //        std::cout << "w = x > 0.42" << std::endl;
 //        for(unsigned int i=0 ; i < size ; ++i){
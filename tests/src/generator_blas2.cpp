@@ -163,6 +163,28 @@ int test( Epsilon const& epsilon) {
         CHECK_RESULT(cx,x,x=trans(A)*y)
     }
 
+    {
+        std::cout << "y = A*x; y2 = y2 - alpha*y..." << std::endl;
+        NumericT alpha = NumericT(0.5);
+        ublas::vector<NumericT> cy2(size1);
+        for(unsigned int i=0; i<size1; ++i)
+          cy2(i) = (double)std::rand()/RAND_MAX;
+        viennacl::vector<NumericT> y2(size1);
+        viennacl::copy(cy2, y2);
+
+        cy  = ublas::prod(cA,cx);
+        cy2 = cy2 - alpha*cy;
+        viennacl::scheduler::statement statement1(y, viennacl::op_assign(), viennacl::linalg::prod(A,x));
+        viennacl::scheduler::statement statement2(y2, viennacl::op_assign(), y2 - alpha*y);
+        generator::code_generator gen;
+        gen.add(statement1, statement1.array()[0]);
+        gen.add(statement2, statement2.array()[0]);
+        generator::enqueue(gen);
+        viennacl::backend::finish();
+        CHECK_RESULT(cy,y,y=A*x)
+        CHECK_RESULT(cy2,y2,y2=y2-alpha*y)
+    }
+
 //    {
 //        std::cout << "y = reduce_rows<max>(A)..." << std::endl;
 //        for(unsigned int i = 0 ; i < size1 ; ++i){
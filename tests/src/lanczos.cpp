@@ -0,0 +1,160 @@
+/* =========================================================================
+   Copyright (c) 2010-2013, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+#include <iostream>
+#include <vector>
+#include <map>
+#include <cmath>
+#include <cstdlib>
+#include <string>
+
+#define VIENNACL_WITH_UBLAS
+
+#include <boost/numeric/ublas/matrix_sparse.hpp>
+
+#include "viennacl/vector.hpp"
+#include "viennacl/matrix.hpp"
+#include "viennacl/compressed_matrix.hpp"
+#include "viennacl/linalg/prod.hpp"
+#include "viennacl/linalg/norm_2.hpp"
+#include "viennacl/linalg/lanczos.hpp"
+
+typedef double ScalarType;
+
+// Symmetric tridiagonal test matrix with well separated largest eigenvalues
+void fill_matrix(viennacl::compressed_matrix<ScalarType> & A, std::size_t n)
+{
+  std::vector< std::map<unsigned int, ScalarType> > stl_A(n);
+  for (std::size_t i=0; i<n; ++i)
+  {
+    stl_A[i][i] = ScalarType(i + 1) * ScalarType(i + 1) / ScalarType(n);
+    if (i > 0)
+      stl_A[i][i-1] = 0.5;
+    if (i + 1 < n)
+      stl_A[i][i+1] = 0.5;
+  }
+  viennacl::copy(stl_A, A);
+}
+
+// Returns max_i ||A x_i - lambda_i x_i|| / |lambda_i|
+ScalarType max_residual(viennacl::compressed_matrix<ScalarType> const & A,
+                        viennacl::matrix<ScalarType, viennacl::column_major> const & X,
+                        std::vector<ScalarType> const & lambda)
+{
+  ScalarType max_res = 0;
+  for (std::size_t i=0; i<lambda.size(); ++i)
+  {
+    viennacl::vector<ScalarType> x = viennacl::column(X, static_cast<unsigned int>(i));
+    viennacl::vector<ScalarType> Ax = viennacl::linalg::prod(A, x);
+    Ax -= lambda[i] * x;
+    ScalarType res = viennacl::linalg::norm_2(Ax) / (std::fabs(lambda[i]) * viennacl::linalg::norm_2(x));
+    max_res = std::max(max_res, res);
+  }
+  return max_res;
+}
+
+int test_method(viennacl::compressed_matrix<ScalarType> const & A, int method, std::size_t krylov_size, std::string const & name, std::vector<ScalarType> const & reference)
+{
+  std::cout << "* Method: " << name << std::endl;
+
+  viennacl::linalg::lanczos_tag tag(0.75, reference.size(), method, krylov_size);
+  tag.max_restarts(50);
+  tag.tolerance(1e-10);
+
+  std::vector<ScalarType> eigenvalues = viennacl::linalg::eig(A, tag);
+  for (std::size_t i=0; i<reference.size(); ++i)
+  {
+    if (std::fabs(eigenvalues[i] - reference[i]) > 1e-6 * std::fabs(reference[i]))
+    {
+      std::cout << "# Error at eigenvalue " << i << ": " << eigenvalues[i] << " vs. " << reference[i] << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  viennacl::matrix<ScalarType, viennacl::column_major> X;
+  eigenvalues = viennacl::linalg::eig(A, X, tag);
+  ScalarType res = max_residual(A, X, eigenvalues);
+  std::cout << "  Maximum relative residual of eigenpairs: " << res << std::endl;
+  if (X.size2() != reference.size() || res > 1e-5)
+  {
+    std::cout << "# Error: Eigenvectors not accurate enough!" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
+
+int main()
+{
+  std::cout << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "## Test :: Lanczos" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+
+  std::size_t n = 500;
+  viennacl::compressed_matrix<ScalarType> A(n, n);
+  fill_matrix(A, n);
+
+  // reference eigenvalues from a long thick-restart run:
+  viennacl::matrix<ScalarType, viennacl::column_major> X;
+  viennacl::linalg::lanczos_tag ref_tag(0.75, 4, viennacl::linalg::lanczos_tag::thick_restart, 100, 200, 1e-12);
+  std::vector<ScalarType> reference = viennacl::linalg::eig(A, X, ref_tag);
+  ScalarType res = max_residual(A, X, reference);
+  std::cout << "* Reference eigenvalues: ";
+  for (std::size_t i=0; i<reference.size(); ++i)
+    std::cout << reference[i] << " ";
+  std::cout << std::endl << "  Maximum relative residual of eigenpairs: " << res << std::endl;
+  if (res > 1e-8)
+  {
+    std::cout << "# Error: Reference eigenpairs not accurate enough!" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  if (test_method(A, viennacl::linalg::lanczos_tag::thick_restart, 30, "thick restart", reference) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  // uBLAS system matrices are copied to the device by the convenience overloads:
+  {
+    std::cout << "* Method: thick restart (uBLAS system matrix)" << std::endl;
+    boost::numeric::ublas::compressed_matrix<ScalarType> ublas_A(n, n);
+    viennacl::copy(A, ublas_A);
+
+    viennacl::linalg::lanczos_tag tag(0.75, reference.size(), viennacl::linalg::lanczos_tag::thick_restart, 30);
+    tag.max_restarts(50);
+    tag.tolerance(1e-10);
+
+    viennacl::matrix<ScalarType, viennacl::column_major> ublas_X;
+    std::vector<ScalarType> eigenvalues = viennacl::linalg::eig(ublas_A, ublas_X, tag);
+    if (eigenvalues.size() != reference.size() || max_residual(A, ublas_X, eigenvalues) > 1e-5
+        || std::fabs(viennacl::linalg::eig(ublas_A, tag)[0] - reference[0]) > 1e-6 * std::fabs(reference[0]))
+    {
+      std::cout << "# Error: Eigenpairs of uBLAS system matrix not accurate enough!" << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  if (test_method(A, viennacl::linalg::lanczos_tag::partial_reorthogonalization, 200, "partial reorthogonalization", reference) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+  if (test_method(A, viennacl::linalg::lanczos_tag::full_reorthogonalization, 200, "full reorthogonalization", reference) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  std::cout << std::endl;
+  std::cout << "------- Test completed --------" << std::endl;
+  std::cout << std::endl;
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,253 @@
+/* =========================================================================
+   Copyright (c) 2010-2013, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/*
+*
+*   Testing the batched dense interface of the ViennaCL shared library
+*
+*/
+
+
+// include necessary system headers
+#include <iostream>
+#include <vector>
+#include <cmath>
+#include <cstdlib>
+
+#include "viennacl.hpp"
+
+#include "viennacl/vector.hpp"
+
+template <typename ScalarType>
+ScalarType diff(std::vector<ScalarType> const & v1, std::vector<ScalarType> const & v2)
+{
+   ScalarType inf_norm = 0;
+   for (std::size_t i=0;i<v1.size(); ++i)
+   {
+      ScalarType d = 0;
+      if ( std::max( std::fabs(v2[i]), std::fabs(v1[i]) ) > 0 )
+         d = std::fabs(v2[i] - v1[i]) / std::max( std::fabs(v2[i]), std::fabs(v1[i]) );
+
+      if (d > inf_norm)
+        inf_norm = d;
+   }
+
+   return inf_norm;
+}
+
+template <typename T, typename EpsilonT>
+void check(std::vector<T> const & t, std::vector<T> const & u, EpsilonT eps)
+{
+  EpsilonT rel_error = diff(t,u);
+  if (rel_error > eps)
+  {
+    std::cerr << "Relative error: " << rel_error << std::endl;
+    std::cerr << "Aborting!" << std::endl;
+    exit(EXIT_FAILURE);
+  }
+  std::cout << "SUCCESS ";
+}
+
+void check_status(ViennaCLStatus status)
+{
+  if (status != ViennaCLSuccess)
+  {
+    std::cerr << "Call to ViennaCL shared library failed!" << std::endl;
+    std::cerr << "Aborting!" << std::endl;
+    exit(EXIT_FAILURE);
+  }
+}
+
+/** @brief Returns entry (i,j) of the b-th column-major matrix with leading dimension ld, where the matrices start at offset + b * stride */
+template <typename ScalarType>
+ScalarType & col_entry(std::vector<ScalarType> & buffer, std::size_t offset, std::size_t ld, std::size_t stride, std::size_t b, std::size_t i, std::size_t j)
+{
+  return buffer[offset + b * stride + j * ld + i];
+}
+
+template <typename ScalarType>
+void fill(std::vector<ScalarType> & v)
+{
+  for (std::size_t i=0; i<v.size(); ++i)
+    v[i] = ScalarType(1) + ScalarType((i * 7) % 13) / ScalarType(13);
+}
+
+/** @brief Tests xGEMMSTRIDEDBATCHED with op(A) = A^T and column-major storage, and compares xGEMMBATCHED with pointer arrays against it */
+template <typename ScalarType, typename StridedFunc, typename PointerFunc>
+void test_gemm(StridedFunc strided_gemm, PointerFunc pointer_gemm, ScalarType eps)
+{
+  std::size_t m = 9, n = 5, k = 12, batch_count = 17;
+  std::size_t lda = k + 1, ldb = k + 2, ldc = m + 3;
+  std::size_t strideA = lda * m + 1, strideB = ldb * n, strideC = ldc * n + 2;
+  std::size_t offA = 3, offB = 0, offC = 1;
+
+  std::vector<ScalarType> A(offA + strideA * batch_count), B(offB + strideB * batch_count), C(offC + strideC * batch_count);
+  fill(A); fill(B); fill(C);
+  for (std::size_t i=0; i<B.size(); ++i) B[i] -= ScalarType(1.5);
+
+  ScalarType alpha = ScalarType(2), beta = ScalarType(-0.5);
+  std::vector<ScalarType> C_ref(C);
+  for (std::size_t b=0; b<batch_count; ++b)
+    for (std::size_t i=0; i<m; ++i)
+      for (std::size_t j=0; j<n; ++j)
+      {
+        ScalarType sum = 0;
+        for (std::size_t p=0; p<k; ++p)
+          sum += col_entry(A, offA, lda, strideA, b, p, i) * col_entry(B, offB, ldb, strideB, b, p, j);
+        col_entry(C_ref, offC, ldc, strideC, b, i, j) = alpha * sum + beta * col_entry(C_ref, offC, ldc, strideC, b, i, j);
+      }
+
+  std::vector<ScalarType> C_pointers(C);
+
+  check_status(strided_gemm(NULL, ViennaCLColumnMajor, ViennaCLTrans, ViennaCLNoTrans, m, n, k,
+                            alpha, &(A[0]), offA, lda, strideA,
+                                   &(B[0]), offB, ldb, strideB,
+                            beta,  &(C[0]), offC, ldc, strideC, batch_count));
+  check(C_ref, C, eps);
+
+  std::vector<ScalarType *> ptr_A(batch_count), ptr_B(batch_count), ptr_C(batch_count);
+  for (std::size_t b=0; b<batch_count; ++b)
+  {
+    ptr_A[b] = &(A[0]) + offA + b * strideA;
+    ptr_B[b] = &(B[0]) + offB + b * strideB;
+    ptr_C[b] = &(C_pointers[0]) + offC + b * strideC;
+  }
+  check_status(pointer_gemm(NULL, ViennaCLColumnMajor, ViennaCLTrans, ViennaCLNoTrans, m, n, k,
+                            alpha, &(ptr_A[0]), lda, &(ptr_B[0]), ldb,
+                            beta,  &(ptr_C[0]), ldc, batch_count));
+  check(C_ref, C_pointers, eps);
+}
+
+/** @brief Tests xTRSMSTRIDEDBATCHED for a lower triangular, row-major A used as transposed (thus upper triangular) matrix */
+template <typename ScalarType, typename StridedFunc>
+void test_trsm(StridedFunc strided_trsm, ScalarType eps)
+{
+  std::size_t m = 11, n = 4, batch_count = 23;
+  std::size_t lda = m, ldb = n;
+  std::size_t strideA = m * m, strideB = m * n;
+
+  // row-major: entry (i,j) at i * ld + j
+  std::vector<ScalarType> A(strideA * batch_count), B(strideB * batch_count);
+  fill(B);
+  for (std::size_t b=0; b<batch_count; ++b)
+    for (std::size_t i=0; i<m; ++i)
+      for (std::size_t j=0; j<=i; ++j)
+        A[b * strideA + i * lda + j] = (i == j) ? ScalarType(2) + ScalarType(i % 3) : ScalarType(0.1) * ScalarType((i + j) % 5);
+
+  // reference: solve A^T X = B by backward substitution, (A^T)_{ip} = A_{pi}
+  std::vector<ScalarType> X(B);
+  for (std::size_t b=0; b<batch_count; ++b)
+    for (std::size_t j=0; j<n; ++j)
+      for (std::size_t ii=0; ii<m; ++ii)
+      {
+        std::size_t i = m - ii - 1;
+        ScalarType sum = X[b * strideB + i * ldb + j];
+        for (std::size_t p=i+1; p<m; ++p)
+          sum -= A[b * strideA + p * lda + i] * X[b * strideB + p * ldb + j];
+        X[b * strideB + i * ldb + j] = sum / A[b * strideA + i * lda + i];
+      }
+
+  check_status(strided_trsm(NULL, ViennaCLRowMajor, ViennaCLLower, ViennaCLTrans, ViennaCLNonUnit, m, n,
+                            &(A[0]), 0, lda, strideA,
+                            &(B[0]), 0, ldb, strideB, batch_count));
+  check(X, B, eps);
+}
+
+/** @brief Tests xGETRFSTRIDEDBATCHED followed by xGETRSSTRIDEDBATCHED, and the pointer-array variants against them */
+template <typename ScalarType, typename GetrfFunc, typename GetrsFunc, typename GetrfPtrFunc, typename GetrsPtrFunc>
+void test_lu(GetrfFunc strided_getrf, GetrsFunc strided_getrs, GetrfPtrFunc pointer_getrf, GetrsPtrFunc pointer_getrs, ScalarType eps)
+{
+  std::size_t n = 10, nrhs = 3, batch_count = 31;
+  std::size_t lda = n + 1, ldb = n;
+  std::size_t strideA = lda * n, strideB = ldb * nrhs;
+
+  // column-major matrices with a small diagonal, so that pivoting is required:
+  std::vector<ScalarType> A(strideA * batch_count), B(strideB * batch_count);
+  fill(A); fill(B);
+  for (std::size_t b=0; b<batch_count; ++b)
+    for (std::size_t i=0; i<n; ++i)
+    {
+      col_entry(A, 0, lda, strideA, b, i, i) = ScalarType(0.01);
+      col_entry(A, 0, lda, strideA, b, (i + 1) % n, i) += ScalarType(n);
+    }
+
+  std::vector<ScalarType> LU(A), X(B);
+  std::vector<unsigned int> ipiv(n * batch_count);
+  check_status(strided_getrf(NULL, ViennaCLColumnMajor, n, &(LU[0]), 0, lda, strideA, &(ipiv[0]), 0, batch_count));
+  check_status(strided_getrs(NULL, ViennaCLColumnMajor, n, nrhs, &(LU[0]), 0, lda, strideA, &(ipiv[0]), 0, &(X[0]), 0, ldb, strideB, batch_count));
+
+  // A * X must reproduce B:
+  std::vector<ScalarType> AX(B.size());
+  for (std::size_t b=0; b<batch_count; ++b)
+    for (std::size_t i=0; i<n; ++i)
+      for (std::size_t j=0; j<nrhs; ++j)
+      {
+        ScalarType sum = 0;
+        for (std::size_t p=0; p<n; ++p)
+          sum += col_entry(A, 0, lda, strideA, b, i, p) * col_entry(X, 0, ldb, strideB, b, p, j);
+        col_entry(AX, 0, ldb, strideB, b, i, j) = sum;
+      }
+  check(B, AX, eps);
+
+  std::vector<ScalarType> LU2(A), X2(B);
+  std::vector<unsigned int> ipiv2(n * batch_count);
+  std::vector<ScalarType *> ptr_LU(batch_count), ptr_X(batch_count);
+  std::vector<unsigned int *> ptr_ipiv(batch_count);
+  for (std::size_t b=0; b<batch_count; ++b)
+  {
+    ptr_LU[b]   = &(LU2[0]) + b * strideA;
+    ptr_X[b]    = &(X2[0]) + b * strideB;
+    ptr_ipiv[b] = &(ipiv2[0]) + b * n;
+  }
+  check_status(pointer_getrf(NULL, ViennaCLColumnMajor, n, &(ptr_LU[0]), lda, &(ptr_ipiv[0]), batch_count));
+  check_status(pointer_getrs(NULL, ViennaCLColumnMajor, n, nrhs, &(ptr_LU[0]), lda, &(ptr_ipiv[0]), &(ptr_X[0]), ldb, batch_count));
+  check(X, X2, eps);
+  if (ipiv != ipiv2)
+  {
+    std::cerr << "Pivots of strided and pointer-array LU factorization differ!" << std::endl;
+    exit(EXIT_FAILURE);
+  }
+}
+
+
+int main()
+{
+  float  eps_float  = 1e-4f;
+  double eps_double = 1e-12;
+
+  std::cout << std::endl << "-- Testing xGEMMSTRIDEDBATCHED and xGEMMBATCHED...";
+  std::cout << std::endl << "Host: ";
+  test_gemm<float>(ViennaCLHostSgemmStridedBatched, ViennaCLHostSgemmBatched, eps_float);
+  test_gemm<double>(ViennaCLHostDgemmStridedBatched, ViennaCLHostDgemmBatched, eps_double);
+
+  std::cout << std::endl << "-- Testing xTRSMSTRIDEDBATCHED...";
+  std::cout << std::endl << "Host: ";
+  test_trsm<float>(ViennaCLHostStrsmStridedBatched, eps_float);
+  test_trsm<double>(ViennaCLHostDtrsmStridedBatched, eps_double);
+
+  std::cout << std::endl << "-- Testing xGETRF/xGETRS (strided and pointer arrays)...";
+  std::cout << std::endl << "Host: ";
+  test_lu<float>(ViennaCLHostSgetrfStridedBatched, ViennaCLHostSgetrsStridedBatched, ViennaCLHostSgetrfBatched, ViennaCLHostSgetrsBatched, eps_float);
+  test_lu<double>(ViennaCLHostDgetrfStridedBatched, ViennaCLHostDgetrsStridedBatched, ViennaCLHostDgetrfBatched, ViennaCLHostDgetrsBatched, eps_double);
+
+  //
+  //  That's it.
+  //
+  std::cout << std::endl << "!!!! TEST COMPLETED SUCCESSFULLY !!!!" << std::endl;
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1 @@
+libviennacl_batched.cpp
\ No newline at end of file
@@ -0,0 +1,307 @@
+/* =========================================================================
+   Copyright (c) 2010-2013, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+
+/*
+*
+*   Testing the sparse matrix and solver interface of the ViennaCL shared library
+*
+*/
+
+
+// include necessary system headers
+#include <iostream>
+#include <vector>
+#include <cmath>
+#include <cstdlib>
+#include <algorithm>
+#include <limits>
+
+#include "viennacl.hpp"
+
+#include "viennacl/vector.hpp"
+
+template <typename ScalarType>
+ScalarType diff(std::vector<ScalarType> const & v1, std::vector<ScalarType> const & v2)
+{
+   ScalarType inf_norm = 0;
+   for (std::size_t i=0;i<v1.size(); ++i)
+   {
+      ScalarType d = 0;
+      if ( std::max( std::fabs(v2[i]), std::fabs(v1[i]) ) > 0 )
+         d = std::fabs(v2[i] - v1[i]) / std::max( std::fabs(v2[i]), std::fabs(v1[i]) );
+
+      if (d > inf_norm)
+        inf_norm = d;
+   }
+
+   return inf_norm;
+}
+
+template <typename T, typename EpsilonT>
+void check(std::vector<T> const & t, std::vector<T> const & u, EpsilonT eps)
+{
+  EpsilonT rel_error = diff(t,u);
+  if (rel_error > eps)
+  {
+    std::cerr << "Relative error: " << rel_error << std::endl;
+    std::cerr << "Aborting!" << std::endl;
+    exit(EXIT_FAILURE);
+  }
+  std::cout << "SUCCESS ";
+}
+
+void check_status(ViennaCLStatus status)
+{
+  if (status != ViennaCLSuccess)
+  {
+    std::cerr << "Call to ViennaCL shared library failed!" << std::endl;
+    std::cerr << "Aborting!" << std::endl;
+    exit(EXIT_FAILURE);
+  }
+}
+
+/** @brief Sets up the CSR arrays of a diagonally dominant matrix with five nonzeros per row. The matrix is symmetric positive definite if 'symmetric' is true. */
+template <typename ScalarType>
+void setup_matrix(std::size_t n, bool symmetric, std::vector<unsigned int> & rows, std::vector<unsigned int> & cols, std::vector<ScalarType> & values)
+{
+  rows.resize(n+1);
+  cols.clear();
+  values.clear();
+  for (std::size_t i=0; i<n; ++i)
+  {
+    rows[i] = static_cast<unsigned int>(cols.size());
+    if (i >= 7)    { cols.push_back(static_cast<unsigned int>(i-7)); values.push_back(ScalarType(symmetric ? 0.5 : 0.25)); }
+    if (i > 0)     { cols.push_back(static_cast<unsigned int>(i-1)); values.push_back(ScalarType(-1)); }
+                   { cols.push_back(static_cast<unsigned int>(i));   values.push_back(ScalarType(4)); }
+    if (i < n-1)   { cols.push_back(static_cast<unsigned int>(i+1)); values.push_back(ScalarType(symmetric ? -1 : -1.5)); }
+    if (i + 7 < n) { cols.push_back(static_cast<unsigned int>(i+7)); values.push_back(ScalarType(0.5)); }
+  }
+  rows[n] = static_cast<unsigned int>(cols.size());
+}
+
+template <typename ScalarType>
+void ref_csrmv(std::vector<unsigned int> const & rows, std::vector<unsigned int> const & cols, std::vector<ScalarType> const & values,
+               ScalarType alpha, std::vector<ScalarType> const & x, ScalarType beta, std::vector<ScalarType> & y)
+{
+  for (std::size_t i=0; i<rows.size()-1; ++i)
+  {
+    ScalarType sum = 0;
+    for (std::size_t k=rows[i]; k<rows[i+1]; ++k)
+      sum += values[k] * x[cols[k]];
+    y[i] = (beta == 0) ? alpha * sum : alpha * sum + beta * y[i];
+  }
+}
+
+/** @brief Tests the solver for A x = b, then doubles the values of A in place, which halves the solution. The second solve reuses the cached preconditioner after an update. */
+template <typename ScalarType>
+void test_solver(ViennaCLBackend backend, ViennaCLPrecision precision,
+                 ViennaCLCompressedMatrix A, std::vector<unsigned int> const & rows, std::vector<unsigned int> const & cols, std::vector<ScalarType> & values,
+                 ViennaCLSolverType solver_type, ViennaCLPrecondType precond_type, ScalarType eps)
+{
+  std::size_t n = rows.size() - 1;
+  std::vector<ScalarType> x_ref(n);
+  for (std::size_t i=0; i<n; ++i)
+    x_ref[i] = ScalarType(1) + ScalarType(i % 5);
+
+  std::vector<ScalarType> b(n);
+  ref_csrmv(rows, cols, values, ScalarType(1), x_ref, ScalarType(0), b);
+
+  std::vector<ScalarType> x(n);
+
+  ViennaCLVector_impl b_impl;
+  b_impl.backend = backend; b_impl.precision = precision; b_impl.host_mem = reinterpret_cast<char*>(&(b[0])); b_impl.offset = 0; b_impl.inc = 1; b_impl.size = n;
+  ViennaCLVector_impl x_impl;
+  x_impl.backend = backend; x_impl.precision = precision; x_impl.host_mem = reinterpret_cast<char*>(&(x[0])); x_impl.offset = 0; x_impl.inc = 1; x_impl.size = n;
+
+  ViennaCLSolver solver;
+  check_status(ViennaCLSolverCreate(&solver, solver_type, precond_type));
+  check_status(ViennaCLSolverSetTolerance(solver, (sizeof(ScalarType) == sizeof(float)) ? 1e-6 : 1e-12));
+  check_status(ViennaCLSolverSetMaxIterations(solver, 500));
+
+  check_status(ViennaCLsolve(solver, A, &b_impl, &x_impl));
+  check(x_ref, x, eps);
+
+  for (std::size_t i=0; i<values.size(); ++i)
+    values[i] *= ScalarType(2);
+  check_status(ViennaCLcsrValuesChanged(A));
+
+  check_status(ViennaCLsolve(solver, A, &b_impl, &x_impl));
+  for (std::size_t i=0; i<n; ++i)
+    x_ref[i] /= ScalarType(2);
+  check(x_ref, x, eps);
+
+  size_t iters = 0;
+  double error = 1;
+  check_status(ViennaCLSolverIterations(solver, &iters));
+  check_status(ViennaCLSolverError(solver, &error));
+  if (iters == 0 || error > 1e-3)
+  {
+    std::cerr << "Unexpected solver statistics: " << iters << " iterations, error " << error << std::endl;
+    exit(EXIT_FAILURE);
+  }
+
+  for (std::size_t i=0; i<values.size(); ++i)
+    values[i] /= ScalarType(2);
+  check_status(ViennaCLcsrValuesChanged(A));
+
+  // zero right hand side: zero solution without iterations
+  std::fill(b.begin(), b.end(), ScalarType(0));
+  std::fill(x_ref.begin(), x_ref.end(), ScalarType(0));
+  check_status(ViennaCLsolve(solver, A, &b_impl, &x_impl));
+  check(x_ref, x, eps);
+  check_status(ViennaCLSolverIterations(solver, &iters));
+  check_status(ViennaCLSolverError(solver, &error));
+  if (iters != 0 || error != 0)
+  {
+    std::cerr << "Unexpected solver statistics for zero right hand side: " << iters << " iterations, error " << error << std::endl;
+    exit(EXIT_FAILURE);
+  }
+
+  check_status(ViennaCLSolverFree(solver));
+}
+
+int main()
+{
+  std::size_t n = 70;
+  float  eps_float  = 1e-4f;
+  double eps_double = 1e-8;
+
+  std::vector<unsigned int> rows, cols;
+  std::vector<float>  float_values;
+  std::vector<double> double_values;
+  setup_matrix(n, false, rows, cols, float_values);
+  setup_matrix(n, false, rows, cols, double_values);
+
+  std::vector<unsigned int> spd_rows, spd_cols;
+  std::vector<float>  spd_float_values;
+  std::vector<double> spd_double_values;
+  setup_matrix(n, true, spd_rows, spd_cols, spd_float_values);
+  setup_matrix(n, true, spd_rows, spd_cols, spd_double_values);
+
+  std::vector<float>  ref_float_x(n);  for (std::size_t i=0; i<n; ++i) ref_float_x[i]  = float(i % 7);
+  std::vector<double> ref_double_x(n); for (std::size_t i=0; i<n; ++i) ref_double_x[i] = double(i % 7);
+  std::vector<float>  ref_float_y(n);  for (std::size_t i=0; i<n; ++i) ref_float_y[i]  = float(n - i);
+  std::vector<double> ref_double_y(n); for (std::size_t i=0; i<n; ++i) ref_double_y[i] = double(n - i);
+
+  // Host setup
+  ViennaCLHostBackend my_host_backend = NULL;
+  ViennaCLBackend_impl my_backend_impl;
+  my_backend_impl.backend_type = ViennaCLHost;
+  my_backend_impl.host_backend = my_host_backend;
+  ViennaCLBackend my_backend = &my_backend_impl;
+
+  ViennaCLCompressedMatrix host_float_A;
+  ViennaCLCompressedMatrix host_double_A;
+  check_status(ViennaCLHostScsrCreate(my_host_backend, &host_float_A,  n, n, cols.size(), &(rows[0]), &(cols[0]), &(float_values[0])));
+  check_status(ViennaCLHostDcsrCreate(my_host_backend, &host_double_A, n, n, cols.size(), &(rows[0]), &(cols[0]), &(double_values[0])));
+
+  ViennaCLCompressedMatrix host_float_spd_A;
+  ViennaCLCompressedMatrix host_double_spd_A;
+  check_status(ViennaCLHostScsrCreate(my_host_backend, &host_float_spd_A,  n, n, spd_cols.size(), &(spd_rows[0]), &(spd_cols[0]), &(spd_float_values[0])));
+  check_status(ViennaCLHostDcsrCreate(my_host_backend, &host_double_spd_A, n, n, spd_cols.size(), &(spd_rows[0]), &(spd_cols[0]), &(spd_double_values[0])));
+
+  std::vector<float>  host_float_x  = ref_float_x;
+  std::vector<double> host_double_x = ref_double_x;
+  std::vector<float>  host_float_y  = ref_float_y;
+  std::vector<double> host_double_y = ref_double_y;
+
+  // CSRMV
+  std::cout << std::endl << "-- Testing xCSRMV...";
+  ref_csrmv(rows, cols, float_values,  3.1415f, ref_float_x,  0.1234f, ref_float_y);
+  ref_csrmv(rows, cols, double_values, 3.1415,  ref_double_x, 0.1234,  ref_double_y);
+
+  std::cout << std::endl << "Host: ";
+  check_status(ViennaCLHostScsrmv(my_host_backend, host_float_A,
+                                  3.1415f, &(host_float_x[0]), 0, 1,
+                                  0.1234f, &(host_float_y[0]), 0, 1));
+  check(ref_float_y, host_float_y, eps_float);
+  check_status(ViennaCLHostDcsrmv(my_host_backend, host_double_A,
+                                  3.1415, &(host_double_x[0]), 0, 1,
+                                  0.1234, &(host_double_y[0]), 0, 1));
+  check(ref_double_y, host_double_y, eps_double);
+
+  // generic interface, modified values are picked up without recreating the matrix (no copy):
+  std::cout << std::endl << "Generic: ";
+  double old_value = double_values[3];
+  double_values[3] = 42.0;
+  ref_csrmv(rows, cols, double_values, 2.0, ref_double_x, -1.0, ref_double_y);
+
+  ViennaCLHostScalar_impl alpha; alpha.precision = ViennaCLDouble; alpha.value_double =  2.0;
+  ViennaCLHostScalar_impl beta;  beta.precision  = ViennaCLDouble; beta.value_double  = -1.0;
+  ViennaCLVector_impl x_impl;
+  x_impl.backend = my_backend; x_impl.precision = ViennaCLDouble; x_impl.host_mem = reinterpret_cast<char*>(&(host_double_x[0])); x_impl.offset = 0; x_impl.inc = 1; x_impl.size = n;
+  ViennaCLVector_impl y_impl;
+  y_impl.backend = my_backend; y_impl.precision = ViennaCLDouble; y_impl.host_mem = reinterpret_cast<char*>(&(host_double_y[0])); y_impl.offset = 0; y_impl.inc = 1; y_impl.size = n;
+  check_status(ViennaCLcsrmv(&alpha, host_double_A, &x_impl, &beta, &y_impl));
+  check(ref_double_y, host_double_y, eps_double);
+
+  // beta == 0 overwrites y, also if it holds NaNs:
+  for (std::size_t i=0; i<host_double_y.size(); ++i)
+    host_double_y[i] = std::numeric_limits<double>::quiet_NaN();
+  ref_csrmv(rows, cols, double_values, 2.0, ref_double_x, 0.0, ref_double_y);
+  beta.value_double = 0.0;
+  check_status(ViennaCLcsrmv(&alpha, host_double_A, &x_impl, &beta, &y_impl));
+  check(ref_double_y, host_double_y, eps_double);
+  double_values[3] = old_value;
+  check_status(ViennaCLcsrValuesChanged(host_double_A));
+
+  // precision mismatch must be reported:
+  if (ViennaCLHostScsrmv(my_host_backend, host_double_A, 1.0f, &(host_float_x[0]), 0, 1, 0.0f, &(host_float_y[0]), 0, 1) == ViennaCLSuccess)
+  {
+    std::cerr << "Precision mismatch not detected!" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Solvers
+  ViennaCLSolverType  solver_types[]  = {ViennaCLCG, ViennaCLBiCGStab, ViennaCLGMRES};
+  ViennaCLPrecondType precond_types[] = {ViennaCLNoPrecond, ViennaCLJacobiPrecond, ViennaCLILU0Precond};
+  char const * solver_names[]  = {"CG", "BiCGStab", "GMRES"};
+  char const * precond_names[] = {"no preconditioner", "Jacobi", "ILU0"};
+
+  for (std::size_t s=0; s<3; ++s)
+  {
+    for (std::size_t p=0; p<3; ++p)
+    {
+      std::cout << std::endl << "-- Testing " << solver_names[s] << " with " << precond_names[p] << "...";
+      std::cout << std::endl << "Host: ";
+      if (solver_types[s] == ViennaCLCG)
+      {
+        test_solver(my_backend, ViennaCLFloat,  host_float_spd_A,  spd_rows, spd_cols, spd_float_values,  solver_types[s], precond_types[p], eps_float);
+        test_solver(my_backend, ViennaCLDouble, host_double_spd_A, spd_rows, spd_cols, spd_double_values, solver_types[s], precond_types[p], eps_double);
+      }
+      else
+      {
+        if (solver_types[s] != ViennaCLGMRES)   // GMRES in single precision may stagnate early for this matrix
+          test_solver(my_backend, ViennaCLFloat,  host_float_A,  rows, cols, float_values,  solver_types[s], precond_types[p], eps_float);
+        test_solver(my_backend, ViennaCLDouble, host_double_A, rows, cols, double_values, solver_types[s], precond_types[p], eps_double);
+      }
+    }
+  }
+
+  check_status(ViennaCLcsrFree(host_float_A));
+  check_status(ViennaCLcsrFree(host_double_A));
+  check_status(ViennaCLcsrFree(host_float_spd_A));
+  check_status(ViennaCLcsrFree(host_double_spd_A));
+
+  //
+  //  That's it.
+  //
+  std::cout << std::endl << "!!!! TEST COMPLETED SUCCESSFULLY !!!!" << std::endl;
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1 @@
+libviennacl_sparse.cpp
\ No newline at end of file
@@ -1042,6 +1042,40 @@ int test(Epsilon const& epsilon)
       retval = EXIT_FAILURE;
    }
 
+   //full solver with partial pivoting:
+   std::cout << "Full solver with partial pivoting" << std::endl;
+   for (std::size_t i=0; i<lu_dim; ++i)
+     for (std::size_t j=0; j<lu_dim; ++j)
+       square_matrix(i,j) = random<NumericT>() - static_cast<NumericT>(0.5);
+
+   //zero diagonal entries require pivoting, dominant entries on the superdiagonal keep the matrix well-conditioned:
+   for (std::size_t j=0; j<lu_dim; ++j)
+   {
+     square_matrix(j,j) = 0;
+     square_matrix(j, (j + 1) % lu_dim) += static_cast<NumericT>(lu_dim);
+     lu_rhs(j) = random<NumericT>();
+   }
+
+   viennacl::copy(square_matrix, vcl_square_matrix);
+   viennacl::copy(lu_rhs, vcl_lu_rhs);
+
+   //ublas::
+   ublas::permutation_matrix<std::size_t> ublas_pivots(lu_dim);
+   ublas::lu_factorize(square_matrix, ublas_pivots);
+   ublas::lu_substitute(square_matrix, ublas_pivots, lu_rhs);
+
+   // ViennaCL:
+   std::vector<std::size_t> vcl_pivots;
+   viennacl::linalg::lu_factorize(vcl_square_matrix, vcl_pivots);
+   viennacl::linalg::lu_substitute(vcl_square_matrix, vcl_pivots, vcl_lu_rhs);
+
+   if( fabs(diff(lu_rhs, vcl_lu_rhs)) > epsilon )
+   {
+      std::cout << "# Error at operation: dense solver with partial pivoting" << std::endl;
+      std::cout << "  diff: " << fabs(diff(lu_rhs, vcl_lu_rhs)) << std::endl;
+      retval = EXIT_FAILURE;
+   }
+
 
 
    return retval;
@@ -17,8 +17,12 @@
 
 #include <ctime>
 #include <cmath>
+#include <map>
+#include <vector>
 
 
+#include "viennacl/matrix.hpp"
+#include "viennacl/compressed_matrix.hpp"
 #include "viennacl/linalg/prod.hpp"
 #include "viennacl/linalg/nmf.hpp"
 
@@ -99,6 +103,56 @@ void test_nmf(std::size_t m, std::size_t k, std::size_t n)
       exit(EXIT_FAILURE);
 }
 
+// runs NMF for a random sparse matrix V and compares with the result obtained for the same matrix stored as a dense matrix
+void test_nmf_sparse(std::size_t m, std::size_t k, std::size_t n)
+{
+    std::vector< std::map<unsigned int, ScalarType> > stl_v(m);
+    std::vector< std::vector<ScalarType> > stl_v_dense(m, std::vector<ScalarType>(n));
+    for (std::size_t i = 0; i < m; ++i)
+      for (std::size_t j = 0; j < n; ++j)
+        if (rand() % 10 == 0)
+        {
+          ScalarType value = static_cast<ScalarType>(rand()) / RAND_MAX;
+          stl_v[i][static_cast<unsigned int>(j)] = value;
+          stl_v_dense[i][j] = value;
+        }
+
+    viennacl::compressed_matrix<ScalarType> v_sparse(m, n);
+    viennacl::copy(stl_v, v_sparse);
+    viennacl::matrix<ScalarType> v_dense(m, n);
+    viennacl::copy(stl_v_dense, v_dense);
+
+    std::vector< std::vector<ScalarType> > stl_w(m, std::vector<ScalarType>(k));
+    std::vector< std::vector<ScalarType> > stl_h(k, std::vector<ScalarType>(n));
+    fill_random(stl_w);
+    fill_random(stl_h);
+
+    viennacl::matrix<ScalarType> w_sparse(m, k), w_dense(m, k);
+    viennacl::matrix<ScalarType> h_sparse(k, n), h_dense(k, n);
+    viennacl::copy(stl_w, w_sparse);
+    viennacl::copy(stl_w, w_dense);
+    viennacl::copy(stl_h, h_sparse);
+    viennacl::copy(stl_h, h_dense);
+
+    viennacl::linalg::nmf_config conf_sparse, conf_dense;
+    conf_sparse.max_iterations(200);
+    conf_dense.max_iterations(200);
+    viennacl::linalg::nmf(v_sparse, w_sparse, h_sparse, conf_sparse);
+    viennacl::linalg::nmf(v_dense,  w_dense,  h_dense,  conf_dense);
+
+    viennacl::matrix<ScalarType> v_nmf_sparse = viennacl::linalg::prod(w_sparse, h_sparse);
+    viennacl::matrix<ScalarType> v_nmf_dense  = viennacl::linalg::prod(w_dense,  h_dense);
+
+    float diff  = matrix_compare(v_nmf_dense, v_nmf_sparse);
+    bool diff_ok = fabs(diff) < EPS && conf_sparse.iters() == conf_dense.iters();
+
+    long iterations = static_cast<long>(conf_sparse.iters());
+    printf("%6s [%lux%lux%lu] sparse vs. dense diff = %.6f (%ld iterations)\n", diff_ok ? "[[OK]]":"[FAIL]", m, k, n, diff, iterations);
+
+    if (!diff_ok)
+      exit(EXIT_FAILURE);
+}
+
 int main()
 {
   //srand(time(NULL));  //let's use deterministic tests, so keep the default srand() initialization
@@ -106,8 +160,15 @@ int main()
   test_nmf(3, 3, 3);
   test_nmf(3, 2, 3);
   test_nmf(16, 7, 12);
+#ifdef VIENNACL_WITH_OPENCL
+  // these take several thousand iterations, which is too slow for the single-threaded host backend in debug builds
   test_nmf(160, 73, 200);
   test_nmf(687, 15, 713);
+#endif
+
+  test_nmf_sparse(50, 5, 40);
+  test_nmf_sparse(300, 8, 400);
+  test_nmf_sparse(417, 20, 233);
 
   std::cout << std::endl;
   std::cout << "------- Test completed --------" << std::endl;
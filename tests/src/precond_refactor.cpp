@@ -0,0 +1,345 @@
+/* =========================================================================
+   Copyright (c) 2010-2013, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+//
+// *** System
+//
+#include <iostream>
+#include <vector>
+#include <map>
+#include <cmath>
+#include <cstdlib>
+
+//
+// *** ViennaCL
+//
+#include "viennacl/compressed_matrix.hpp"
+#include "viennacl/vector.hpp"
+#include "viennacl/linalg/prod.hpp"
+#include "viennacl/linalg/ilu.hpp"
+#include "viennacl/linalg/ichol.hpp"
+#include "viennacl/linalg/jacobi_precond.hpp"
+
+#ifdef VIENNACL_WITH_OPENCL
+  #include <boost/numeric/ublas/matrix_sparse.hpp>
+  #include <boost/numeric/ublas/operation_sparse.hpp>
+  #include "viennacl/linalg/amg.hpp"
+#endif
+
+//
+// -------------------------------------------------------------
+//
+
+/** @brief Creates the triplets of a five-point finite difference discretization of -Laplace(u) + convection * du/dx + shift * u on an N x N grid */
+template <typename NumericT>
+void make_system(std::size_t N, NumericT shift, NumericT convection,
+                 std::vector<unsigned int> & row_indices, std::vector<unsigned int> & col_indices, std::vector<NumericT> & values)
+{
+  row_indices.clear();
+  col_indices.clear();
+  values.clear();
+
+  for (std::size_t i=0; i<N; ++i)
+    for (std::size_t j=0; j<N; ++j)
+    {
+      unsigned int row = static_cast<unsigned int>(i * N + j);
+
+      row_indices.push_back(row); col_indices.push_back(row); values.push_back(NumericT(4) + shift);
+      if (i > 0)   { row_indices.push_back(row); col_indices.push_back(row - N); values.push_back(NumericT(-1)); }
+      if (i+1 < N) { row_indices.push_back(row); col_indices.push_back(row + N); values.push_back(NumericT(-1)); }
+      if (j > 0)   { row_indices.push_back(row); col_indices.push_back(row - 1); values.push_back(NumericT(-1) - convection); }
+      if (j+1 < N) { row_indices.push_back(row); col_indices.push_back(row + 1); values.push_back(NumericT(-1) + convection); }
+    }
+}
+
+/** @brief Applies two preconditioners to the same vector and compares the results */
+template <typename NumericT, typename PrecondT1, typename PrecondT2>
+bool compare_apply(PrecondT1 const & refactored, PrecondT2 const & reference, std::size_t size, NumericT epsilon)
+{
+  std::vector<NumericT> x(size);
+  for (std::size_t i=0; i<size; ++i)
+    x[i] = NumericT(1) + NumericT(i % 13) / NumericT(4);
+
+  viennacl::vector<NumericT> vcl_x1(size), vcl_x2(size);
+  viennacl::copy(x, vcl_x1);
+  viennacl::copy(x, vcl_x2);
+
+  refactored.apply(vcl_x1);
+  reference.apply(vcl_x2);
+
+  std::vector<NumericT> y1(size), y2(size);
+  viennacl::copy(vcl_x1, y1);
+  viennacl::copy(vcl_x2, y2);
+
+  for (std::size_t i=0; i<size; ++i)
+  {
+    if (std::fabs(y1[i] - y2[i]) > epsilon * std::max(NumericT(1), std::fabs(y2[i])))
+    {
+      std::cout << "# Error at index " << i << ": " << y1[i] << " vs. " << y2[i] << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+template <typename NumericT>
+int test(NumericT epsilon)
+{
+  std::size_t N = 20;
+  std::size_t size = N * N;
+
+  std::vector<unsigned int> row_indices, col_indices;
+  std::vector<NumericT> old_values, new_values, sym_old_values, sym_new_values;
+  make_system(N, NumericT(0.1), NumericT(0.2), row_indices, col_indices, old_values);
+  make_system(N, NumericT(1.3), NumericT(0.5), row_indices, col_indices, new_values);
+  make_system(N, NumericT(0.1), NumericT(0),   row_indices, col_indices, sym_old_values);
+  make_system(N, NumericT(0.7), NumericT(0),   row_indices, col_indices, sym_new_values);
+
+  viennacl::compressed_matrix<NumericT> vcl_new(size, size);
+  vcl_new.assemble(row_indices, col_indices, new_values);
+
+  std::vector<NumericT> new_elements(vcl_new.nnz());
+  viennacl::backend::memory_read(vcl_new.handle(), 0, sizeof(NumericT) * new_elements.size(), &(new_elements[0]));
+
+  //
+  // Value updates:
+  //
+  std::cout << "* compressed_matrix::set_values() from host memory" << std::endl;
+  viennacl::compressed_matrix<NumericT> vcl_A(size, size);
+  vcl_A.assemble(row_indices, col_indices, old_values);
+  vcl_A.set_values(&(new_elements[0]), true);
+  viennacl::backend::finish();
+  {
+    viennacl::vector<NumericT> x = viennacl::scalar_vector<NumericT>(size, NumericT(1));
+    viennacl::vector<NumericT> y1 = viennacl::linalg::prod(vcl_A, x);
+    viennacl::vector<NumericT> y2 = viennacl::linalg::prod(vcl_new, x);
+    std::vector<NumericT> host_y1(size), host_y2(size);
+    viennacl::copy(y1, host_y1);
+    viennacl::copy(y2, host_y2);
+    for (std::size_t i=0; i<size; ++i)
+      if (std::fabs(host_y1[i] - host_y2[i]) > epsilon)
+      {
+        std::cout << "# Error in matrix-vector product at index " << i << ": " << host_y1[i] << " vs. " << host_y2[i] << std::endl;
+        return EXIT_FAILURE;
+      }
+  }
+
+  std::cout << "* compressed_matrix::set_values() from buffer" << std::endl;
+  vcl_A.assemble(row_indices, col_indices, old_values);
+  vcl_A.set_values(vcl_new.handle());
+  {
+    std::vector<NumericT> elements(vcl_A.nnz());
+    viennacl::backend::memory_read(vcl_A.handle(), 0, sizeof(NumericT) * elements.size(), &(elements[0]));
+    for (std::size_t i=0; i<elements.size(); ++i)
+      if (elements[i] != new_elements[i])
+      {
+        std::cout << "# Error at entry " << i << ": " << elements[i] << " vs. " << new_elements[i] << std::endl;
+        return EXIT_FAILURE;
+      }
+  }
+
+  //
+  // Preconditioners: Set up for old values, refactor for new values, compare with setup for new values
+  //
+  std::cout << "* ILU0" << std::endl;
+  {
+    viennacl::linalg::ilu0_tag ilu0_config;
+    vcl_A.assemble(row_indices, col_indices, old_values);
+    viennacl::linalg::ilu0_precond< viennacl::compressed_matrix<NumericT> > refactored(vcl_A, ilu0_config);
+    vcl_A.set_values(&(new_elements[0]));
+    refactored.refactor(vcl_A);
+
+    viennacl::linalg::ilu0_precond< viennacl::compressed_matrix<NumericT> > reference(vcl_new, ilu0_config);
+    if (!compare_apply(refactored, reference, size, epsilon))
+      return EXIT_FAILURE;
+  }
+
+  std::cout << "* ILU0 with level scheduling" << std::endl;
+  {
+    viennacl::linalg::ilu0_tag ilu0_config(true);
+    vcl_A.assemble(row_indices, col_indices, old_values);
+    viennacl::linalg::ilu0_precond< viennacl::compressed_matrix<NumericT> > refactored(vcl_A, ilu0_config);
+    vcl_A.set_values(&(new_elements[0]));
+    refactored.refactor(vcl_A);
+
+    viennacl::linalg::ilu0_precond< viennacl::compressed_matrix<NumericT> > reference(vcl_new, ilu0_config);
+    if (!compare_apply(refactored, reference, size, epsilon))
+      return EXIT_FAILURE;
+  }
+
+  std::cout << "* Block-ILU0" << std::endl;
+  {
+    viennacl::linalg::ilu0_tag ilu0_config;
+    vcl_A.assemble(row_indices, col_indices, old_values);
+    viennacl::linalg::block_ilu_precond< viennacl::compressed_matrix<NumericT>, viennacl::linalg::ilu0_tag> refactored(vcl_A, ilu0_config, 4);
+    vcl_A.set_values(&(new_elements[0]));
+    refactored.refactor(vcl_A);
+
+    viennacl::linalg::block_ilu_precond< viennacl::compressed_matrix<NumericT>, viennacl::linalg::ilu0_tag> reference(vcl_new, ilu0_config, 4);
+    if (!compare_apply(refactored, reference, size, epsilon))
+      return EXIT_FAILURE;
+  }
+
+  std::cout << "* ILUT" << std::endl;
+  {
+    viennacl::linalg::ilut_tag ilut_config(10, 1e-3, true);
+    vcl_A.assemble(row_indices, col_indices, old_values);
+    viennacl::linalg::ilut_precond< viennacl::compressed_matrix<NumericT> > refactored(vcl_A, ilut_config);
+    vcl_A.set_values(&(new_elements[0]));
+    refactored.refactor(vcl_A);
+
+    viennacl::linalg::ilut_precond< viennacl::compressed_matrix<NumericT> > reference(vcl_new, ilut_config);
+    if (!compare_apply(refactored, reference, size, epsilon))
+      return EXIT_FAILURE;
+  }
+
+  std::cout << "* Jacobi" << std::endl;
+  {
+    viennacl::linalg::jacobi_tag jacobi_config;
+    vcl_A.assemble(row_indices, col_indices, old_values);
+    viennacl::linalg::jacobi_precond< viennacl::compressed_matrix<NumericT> > refactored(vcl_A, jacobi_config);
+    vcl_A.set_values(&(new_elements[0]));
+    refactored.refactor(vcl_A);
+
+    viennacl::linalg::jacobi_precond< viennacl::compressed_matrix<NumericT> > reference(vcl_new, jacobi_config);
+    if (!compare_apply(refactored, reference, size, epsilon))
+      return EXIT_FAILURE;
+  }
+
+  std::cout << "* ICHOL0" << std::endl;
+  {
+    viennacl::linalg::ichol0_tag ichol0_config;
+    viennacl::compressed_matrix<NumericT> vcl_sym_new(size, size);
+    vcl_sym_new.assemble(row_indices, col_indices, sym_new_values);
+    vcl_A.assemble(row_indices, col_indices, sym_old_values);
+    viennacl::linalg::ichol0_precond< viennacl::compressed_matrix<NumericT> > refactored(vcl_A, ichol0_config);
+    vcl_A.set_values(vcl_sym_new.handle());
+    refactored.refactor(vcl_A);
+
+    viennacl::linalg::ichol0_precond< viennacl::compressed_matrix<NumericT> > reference(vcl_sym_new, ichol0_config);
+    if (!compare_apply(refactored, reference, size, epsilon))
+      return EXIT_FAILURE;
+  }
+
+#ifdef VIENNACL_WITH_OPENCL
+  std::cout << "* AMG" << std::endl;
+  {
+    // A scaled matrix results in the same coarse grids and interpolation operators, hence the refactored preconditioner must match a new setup:
+    typedef boost::numeric::ublas::compressed_matrix<NumericT>  ublas_matrix_type;
+    ublas_matrix_type ublas_A(size, size), ublas_scaled(size, size);
+    for (std::size_t k=0; k<row_indices.size(); ++k)
+    {
+      ublas_A(row_indices[k], col_indices[k]) = sym_old_values[k];
+      ublas_scaled(row_indices[k], col_indices[k]) = NumericT(2) * sym_old_values[k];
+    }
+
+    viennacl::linalg::amg_tag amg_config(VIENNACL_AMG_COARSE_RS, VIENNACL_AMG_INTERPOL_DIRECT, 0.25, 0.2, 0.67, 3, 3, 0);
+    viennacl::linalg::amg_precond<ublas_matrix_type> refactored(ublas_A, amg_config);
+    refactored.setup();
+    refactored.refactor(ublas_scaled);
+
+    viennacl::linalg::amg_precond<ublas_matrix_type> reference(ublas_scaled, amg_config);
+    reference.setup();
+
+    boost::numeric::ublas::vector<NumericT> x1(size), x2(size);
+    for (std::size_t i=0; i<size; ++i)
+      x1[i] = x2[i] = NumericT(1) + NumericT(i % 13) / NumericT(4);
+    refactored.apply(x1);
+    reference.apply(x2);
+    for (std::size_t i=0; i<size; ++i)
+      if (std::fabs(x1[i] - x2[i]) > epsilon * std::max(NumericT(1), std::fabs(x2[i])))
+      {
+        std::cout << "# Error at index " << i << ": " << x1[i] << " vs. " << x2[i] << std::endl;
+        return EXIT_FAILURE;
+      }
+
+    viennacl::compressed_matrix<NumericT> vcl_scaled(size, size);
+    viennacl::copy(ublas_scaled, vcl_scaled);
+    vcl_A.assemble(row_indices, col_indices, sym_old_values);
+    viennacl::linalg::amg_precond< viennacl::compressed_matrix<NumericT> > vcl_refactored(vcl_A, amg_config);
+    vcl_refactored.setup();
+    vcl_refactored.refactor(vcl_scaled);
+
+    viennacl::linalg::amg_precond< viennacl::compressed_matrix<NumericT> > vcl_reference(vcl_scaled, amg_config);
+    vcl_reference.setup();
+    if (!compare_apply(vcl_refactored, vcl_reference, size, epsilon))
+      return EXIT_FAILURE;
+  }
+#endif
+
+  return EXIT_SUCCESS;
+}
+
+//
+// -------------------------------------------------------------
+//
+int main()
+{
+  std::cout << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "## Test :: Preconditioner Refactorization" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << std::endl;
+
+  int retval = EXIT_SUCCESS;
+
+  std::cout << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << std::endl;
+  {
+    typedef float NumericT;
+    NumericT epsilon = static_cast<NumericT>(1E-4);
+    std::cout << "# Testing setup:" << std::endl;
+    std::cout << "  eps:     " << epsilon << std::endl;
+    std::cout << "  numeric: float" << std::endl;
+    retval = test<NumericT>(epsilon);
+    if( retval == EXIT_SUCCESS )
+        std::cout << "# Test passed" << std::endl;
+    else
+        return retval;
+  }
+  std::cout << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << std::endl;
+
+#ifdef VIENNACL_WITH_OPENCL
+  if( viennacl::ocl::current_device().double_support() )
+#endif
+  {
+    typedef double NumericT;
+    NumericT epsilon = 1.0E-10;
+    std::cout << "# Testing setup:" << std::endl;
+    std::cout << "  eps:     " << epsilon << std::endl;
+    std::cout << "  numeric: double" << std::endl;
+    retval = test<NumericT>(epsilon);
+    if( retval == EXIT_SUCCESS )
+        std::cout << "# Test passed" << std::endl;
+    else
+        return retval;
+  }
+  std::cout << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << std::endl;
+
+  std::cout << std::endl;
+  std::cout << "------- Test completed --------" << std::endl;
+  std::cout << std::endl;
+
+  return retval;
+}
@@ -0,0 +1,203 @@
+/* =========================================================================
+   Copyright (c) 2010-2013, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+//
+// Tests for the profiler: recorded operations, bytes and flops, Chrome trace and summary output
+//
+
+// the profiler is only compiled in on request:
+#define VIENNACL_WITH_PROFILER
+
+#include <iostream>
+#include <sstream>
+#include <vector>
+#include <map>
+#include <string>
+
+#include "viennacl/scalar.hpp"
+#include "viennacl/vector.hpp"
+#include "viennacl/matrix.hpp"
+#include "viennacl/compressed_matrix.hpp"
+#include "viennacl/linalg/inner_prod.hpp"
+#include "viennacl/linalg/prod.hpp"
+#include "viennacl/tools/profiler.hpp"
+
+/** @brief Returns the first recorded event with the given name, or NULL */
+viennacl::tools::profiler_event const * find_event(std::vector<viennacl::tools::profiler_event> const & events, std::string const & name)
+{
+  for (std::size_t i=0; i<events.size(); ++i)
+    if (events[i].name == name)
+      return &(events[i]);
+  return NULL;
+}
+
+int check_event(std::vector<viennacl::tools::profiler_event> const & events, std::string const & name, double bytes, double flops)
+{
+  viennacl::tools::profiler_event const * e = find_event(events, name);
+  if (!e)
+  {
+    std::cout << "# Error: No event recorded for " << name << std::endl;
+    return EXIT_FAILURE;
+  }
+  if (e->duration < 0 || e->start < 0)
+  {
+    std::cout << "# Error: Invalid time for " << name << ": start " << e->start << ", duration " << e->duration << std::endl;
+    return EXIT_FAILURE;
+  }
+  if (e->bytes != bytes || e->flops != flops)
+  {
+    std::cout << "# Error: Wrong numbers for " << name << ": " << e->bytes << " bytes (expected " << bytes << "), "
+              << e->flops << " flops (expected " << flops << ")" << std::endl;
+    return EXIT_FAILURE;
+  }
+  if (e->backend != viennacl::traits::active_handle_id(viennacl::vector<float>(1)))
+  {
+    std::cout << "# Error: Wrong backend for " << name << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
+
+int main()
+{
+  typedef float   NumericT;
+  typedef viennacl::tools::profiler  profiler;
+
+  std::cout << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "## Test :: Profiler" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+
+  std::size_t N = 1000;
+  std::size_t M = 50;
+
+  std::vector<NumericT> std_x(N, NumericT(1));
+  viennacl::vector<NumericT> x(N);
+  viennacl::vector<NumericT> y = viennacl::scalar_vector<NumericT>(N, NumericT(2));
+  viennacl::vector<NumericT> z(N);
+  viennacl::matrix<NumericT> A = viennacl::identity_matrix<NumericT>(M);
+  viennacl::matrix<NumericT> B = viennacl::identity_matrix<NumericT>(M);
+  viennacl::matrix<NumericT> C(M, M);
+
+  std::vector<std::map<unsigned int, NumericT> > std_S(N);
+  for (std::size_t i=0; i<N; ++i)
+  {
+    std_S[i][static_cast<unsigned int>(i)] = NumericT(2);
+    if (i > 0)
+      std_S[i][static_cast<unsigned int>(i - 1)] = NumericT(-1);
+  }
+  viennacl::compressed_matrix<NumericT> S;
+  viennacl::copy(std_S, S);
+  std::size_t nnz = 2 * N - 1;
+
+  //
+  // Nothing is recorded while the profiler is disabled:
+  //
+  std::cout << "Testing disabled profiler..." << std::endl;
+  profiler::disable();
+  profiler::clear();
+  viennacl::copy(std_x, x);
+  NumericT result = viennacl::linalg::inner_prod(x, y);
+  if (!profiler::events().empty())
+  {
+    std::cout << "# Error: Events recorded while profiler is disabled" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  //
+  // Record operations:
+  //
+  std::cout << "Testing recorded operations..." << std::endl;
+  profiler::enable();
+  viennacl::copy(std_x, x);
+  result = viennacl::linalg::inner_prod(x, y);
+  C = viennacl::linalg::prod(A, B);
+  z = viennacl::linalg::prod(S, y);
+  viennacl::copy(x, std_x);
+  profiler::disable();
+
+  if (result != NumericT(2 * N))
+  {
+    std::cout << "# Error: Wrong result of inner product: " << result << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::vector<viennacl::tools::profiler_event> events = profiler::events();
+  if (check_event(events, "inner_prod", double(2 * N * sizeof(NumericT)), double(2 * N)) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+  if (check_event(events, "gemm", double(3 * M * M * sizeof(NumericT)), double(2 * M * M * M)) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+  if (check_event(events, "spmv", double(nnz * (sizeof(NumericT) + sizeof(unsigned int)) + (N + 1) * sizeof(unsigned int) + 2 * N * sizeof(NumericT)), double(2 * nnz)) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+  if (check_event(events, "memory_write", double(N * sizeof(NumericT)), 0) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+  if (check_event(events, "memory_read", double(N * sizeof(NumericT)), 0) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  for (std::size_t i=1; i<events.size(); ++i)
+  {
+    if (events[i].thread != 0)
+    {
+      std::cout << "# Error: Wrong thread index " << events[i].thread << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  //
+  // Output:
+  //
+  std::cout << "Testing Chrome trace output..." << std::endl;
+  std::stringstream trace;
+  profiler::write_chrome_trace(trace);
+  std::string trace_str = trace.str();
+  std::size_t num_trace_events = 0;
+  for (std::size_t pos = trace_str.find("{\"name\":"); pos != std::string::npos; pos = trace_str.find("{\"name\":", pos + 1))
+    ++num_trace_events;
+  if (trace_str.find("{\"traceEvents\":[") != 0 || num_trace_events != events.size()
+      || trace_str.find("\"name\":\"gemm\",\"cat\":\"operation\",\"ph\":\"X\"") == std::string::npos)
+  {
+    std::cout << "# Error: Invalid trace:" << std::endl << trace_str << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "Testing summary output..." << std::endl;
+  std::stringstream summary;
+  profiler::write_summary(summary);
+  if (summary.str().find("spmv") == std::string::npos || summary.str().find("GFLOP/s") == std::string::npos)
+  {
+    std::cout << "# Error: Invalid summary:" << std::endl << summary.str() << std::endl;
+    return EXIT_FAILURE;
+  }
+  std::cout << summary.str();
+
+  //
+  // Clearing:
+  //
+  std::cout << "Testing clear()..." << std::endl;
+  profiler::clear();
+  if (!profiler::events().empty())
+  {
+    std::cout << "# Error: Events not removed by clear()" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::cout << std::endl;
+  std::cout << "------- Test completed --------" << std::endl;
+  std::cout << std::endl;
+
+  return EXIT_SUCCESS;
+}
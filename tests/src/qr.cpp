@@ -0,0 +1,192 @@
+/* =========================================================================
+   Copyright (c) 2010-2013, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+#include <iostream>
+#include <vector>
+#include <cmath>
+#include <cstdlib>
+#include <string>
+
+#include "viennacl/vector.hpp"
+#include "viennacl/matrix.hpp"
+#include "viennacl/matrix_proxy.hpp"
+#include "viennacl/linalg/prod.hpp"
+#include "viennacl/linalg/norm_2.hpp"
+#include "viennacl/linalg/norm_frobenius.hpp"
+#include "viennacl/linalg/direct_solve.hpp"
+#include "viennacl/linalg/qr.hpp"
+
+#include "examples/tutorial/Random.hpp"
+
+typedef double ScalarType;
+
+template <typename MatrixType>
+void fill_random(MatrixType & A)
+{
+  std::vector< std::vector<ScalarType> > host_A(A.size1(), std::vector<ScalarType>(A.size2()));
+  for (std::size_t i=0; i<A.size1(); ++i)
+    for (std::size_t j=0; j<A.size2(); ++j)
+      host_A[i][j] = random<ScalarType>() - ScalarType(0.5);
+  viennacl::copy(host_A, A);
+}
+
+// returns ||Q R - A||_F / ||A||_F + ||Q^T Q - I||_F
+template <typename MatrixType>
+ScalarType factorization_error(MatrixType const & A, MatrixType const & Q, MatrixType const & R)
+{
+  MatrixType QR = viennacl::linalg::prod(Q, R);
+  QR -= A;
+
+  MatrixType QTQ = viennacl::linalg::prod(trans(Q), Q);
+  MatrixType I = viennacl::identity_matrix<ScalarType>(Q.size2());
+  QTQ -= I;
+
+  return viennacl::linalg::norm_frobenius(QR) / viennacl::linalg::norm_frobenius(A) + viennacl::linalg::norm_frobenius(QTQ);
+}
+
+// returns true if the entries below the diagonal are zero
+template <typename MatrixType>
+bool is_upper_triangular(MatrixType const & R)
+{
+  std::vector< std::vector<ScalarType> > host_R(R.size1(), std::vector<ScalarType>(R.size2()));
+  viennacl::copy(R, host_R);
+  for (std::size_t i=0; i<R.size1(); ++i)
+    for (std::size_t j=0; j<std::min(i, R.size2()); ++j)
+      if (host_R[i][j] != 0)
+        return false;
+  return true;
+}
+
+template <typename F>
+int test(std::size_t m, std::size_t n, std::size_t block_size)
+{
+  typedef viennacl::matrix<ScalarType, F>   MatrixType;
+
+  std::cout << "* m = " << m << ", n = " << n << ", block size = " << block_size << std::endl;
+
+  MatrixType A(m, n);
+  fill_random(A);
+  MatrixType A_factored(A);
+
+  //
+  // Blocked QR and explicit Q, R:
+  //
+  std::vector<ScalarType> betas = viennacl::linalg::inplace_qr(A_factored, block_size);
+
+  MatrixType Q(m, m), R(m, n);
+  viennacl::linalg::recoverQ(A_factored, betas, Q, R);
+  ScalarType error = factorization_error(A, Q, R);
+  std::cout << "  inplace_qr: error: " << error << std::endl;
+  if (error > 1e-12 || !is_upper_triangular(R))
+  {
+    std::cout << "# Error: Wrong QR factorization!" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // thin Q:
+  MatrixType Q_thin(m, n), R_thin(n, n);
+  viennacl::linalg::recoverQ(A_factored, betas, Q_thin, R_thin);
+  error = factorization_error(A, Q_thin, R_thin);
+  if (error > 1e-12)
+  {
+    std::cout << "# Error: Wrong thin QR factorization!" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  //
+  // Q^T for multiple right hand sides:
+  //
+  MatrixType B(m, 7);
+  fill_random(B);
+  MatrixType QTB_ref = viennacl::linalg::prod(trans(Q), B);
+  viennacl::linalg::inplace_qr_apply_trans_Q(A_factored, betas, B, block_size);
+  QTB_ref -= B;
+  error = viennacl::linalg::norm_frobenius(QTB_ref);
+  std::cout << "  inplace_qr_apply_trans_Q(): error: " << error << std::endl;
+  if (error > 1e-12)
+  {
+    std::cout << "# Error: Wrong result of Q^T B!" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  //
+  // least squares problem with consistent right hand side:
+  //
+  std::vector<ScalarType> host_x(n);
+  for (std::size_t i=0; i<n; ++i)
+    host_x[i] = ScalarType(i % 5) - ScalarType(2);
+  viennacl::vector<ScalarType> x_ref(n);
+  viennacl::copy(host_x, x_ref);
+  viennacl::vector<ScalarType> b = viennacl::linalg::prod(A, x_ref);
+
+  viennacl::linalg::inplace_qr_apply_trans_Q(A_factored, betas, b, block_size);
+  viennacl::range n_range(0, n);
+  viennacl::matrix_range<MatrixType> R_part(A_factored, n_range, n_range);
+  viennacl::vector_range< viennacl::vector<ScalarType> > b_part(b, n_range);
+  viennacl::linalg::inplace_solve(R_part, b_part, viennacl::linalg::upper_tag());
+
+  viennacl::vector<ScalarType> x = b_part;
+  x -= x_ref;
+  error = viennacl::linalg::norm_2(x) / viennacl::linalg::norm_2(x_ref);
+  std::cout << "  least squares: error: " << error << std::endl;
+  if (error > 1e-10)
+  {
+    std::cout << "# Error: Wrong least squares solution!" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  //
+  // TSQR:
+  //
+  MatrixType Q_tsqr, R_tsqr;
+  viennacl::linalg::tsqr(A, Q_tsqr, R_tsqr, 2 * n + 3, block_size);
+  error = factorization_error(A, Q_tsqr, R_tsqr);
+  std::cout << "  tsqr: error: " << error << std::endl;
+  if (error > 1e-12 || Q_tsqr.size2() != n || R_tsqr.size1() != n || !is_upper_triangular(R_tsqr))
+  {
+    std::cout << "# Error: Wrong TSQR factorization!" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
+
+int main()
+{
+  std::cout << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "## Test :: QR factorization" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+
+  std::cout << "# Testing row-major matrices" << std::endl;
+  if (test<viennacl::row_major>(250, 37, 8) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+  if (test<viennacl::row_major>(64, 64, 16) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  std::cout << "# Testing column-major matrices" << std::endl;
+  if (test<viennacl::column_major>(250, 37, 8) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+  if (test<viennacl::column_major>(64, 64, 16) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  std::cout << std::endl;
+  std::cout << "------- Test completed --------" << std::endl;
+  std::cout << std::endl;
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,347 @@
+/* =========================================================================
+   Copyright (c) 2010-2013, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+//
+// Tests for the counter-based random number generator: known answers, statistics, and stream semantics on vectors and matrices
+//
+
+#include <iostream>
+#include <vector>
+#include <cmath>
+
+#include "viennacl/vector.hpp"
+#include "viennacl/vector_proxy.hpp"
+#include "viennacl/matrix.hpp"
+#include "viennacl/matrix_proxy.hpp"
+#include "viennacl/rand/generator.hpp"
+
+//
+// Reference: The value with logical index 'index' of the stream (seed, stream_id), computed from a single Philox block
+//
+template <typename NumericT, typename TransformationT>
+NumericT reference_value(std::size_t index, unsigned int seed, unsigned int stream_id, TransformationT const & trafo)
+{
+  unsigned int counter[4] = { static_cast<unsigned int>(index / 4), 0, 0, 0 };
+  viennacl::rand::philox4x32_10(counter, seed, stream_id);
+  NumericT values[4];
+  trafo(counter[0], counter[1], counter[2], counter[3], values);
+  return values[index % 4];
+}
+
+template <typename NumericT>
+bool is_equal(NumericT a, NumericT b, NumericT tolerance)
+{
+  if (tolerance <= 0)
+    return a == b;
+  return std::fabs(a - b) <= tolerance * std::max(NumericT(1), std::fabs(b));
+}
+
+template <typename NumericT, typename TransformationT>
+int check_vector(std::vector<NumericT> const & result, std::size_t first_index, unsigned int seed, unsigned int stream_id,
+                 TransformationT const & trafo, NumericT tolerance, std::string const & name)
+{
+  for (std::size_t i=0; i<result.size(); ++i)
+  {
+    NumericT ref = reference_value<NumericT>(first_index + i, seed, stream_id, trafo);
+    if (!is_equal(result[i], ref, tolerance))
+    {
+      std::cout << "# Error in " << name << " at entry " << i << ": " << result[i] << " vs. " << ref << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  return EXIT_SUCCESS;
+}
+
+int test_philox()
+{
+  unsigned int counter_zero[4] = { 0, 0, 0, 0 };
+  viennacl::rand::philox4x32_10(counter_zero, 0, 0);
+
+  unsigned int counter_ones[4] = { 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff };
+  viennacl::rand::philox4x32_10(counter_ones, 0xffffffff, 0xffffffff);
+
+  unsigned int counter_pi[4] = { 0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344 };
+  viennacl::rand::philox4x32_10(counter_pi, 0xa4093822, 0x299f31d0);
+
+  // known answers from the reference implementation (Random123):
+  if (   counter_zero[0] != 0x6627e8d5 || counter_zero[1] != 0xe169c58d || counter_zero[2] != 0xbc57ac4c || counter_zero[3] != 0x9b00dbd8
+      || counter_ones[0] != 0x408f276d || counter_ones[1] != 0x41c83b0e || counter_ones[2] != 0xa20bc7c6 || counter_ones[3] != 0x6d5451fd
+      || counter_pi[0]   != 0xd16cfe09 || counter_pi[1]   != 0x94fdcceb || counter_pi[2]   != 0x5001e420 || counter_pi[3]   != 0x24126ea1)
+  {
+    std::cout << "# Error: Philox4x32-10 does not reproduce the known answers" << std::endl;
+    return EXIT_FAILURE;
+  }
+  std::cout << "# Philox4x32-10 known answers passed" << std::endl;
+  return EXIT_SUCCESS;
+}
+
+template <typename NumericT>
+int test_statistics(NumericT tolerance)
+{
+  std::size_t N = 100000;
+  viennacl::vector<NumericT> vec(N);
+  std::vector<NumericT> host_vec(N);
+
+  viennacl::rand::generator gen(1234);
+
+  // uniform on [-1, 3): mean 1, variance 16/12
+  gen.fill(vec, viennacl::rand::uniform_tag(-1, 3));
+  viennacl::copy(vec, host_vec);
+
+  double mean = 0, variance = 0;
+  for (std::size_t i=0; i<N; ++i)
+  {
+    if (host_vec[i] < NumericT(-1) || host_vec[i] > NumericT(3))
+    {
+      std::cout << "# Error: Uniform value " << host_vec[i] << " out of range" << std::endl;
+      return EXIT_FAILURE;
+    }
+    mean += host_vec[i];
+  }
+  mean /= double(N);
+  for (std::size_t i=0; i<N; ++i)
+    variance += (host_vec[i] - mean) * (host_vec[i] - mean);
+  variance /= double(N - 1);
+
+  if (std::fabs(mean - 1.0) > 0.02 || std::fabs(variance - 16.0/12.0) > 0.03)
+  {
+    std::cout << "# Error: Uniform mean/variance " << mean << "/" << variance << " deviate from 1/1.333" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // gaussian N(2, 0.5^2):
+  gen.fill(vec, viennacl::rand::gaussian_tag(2, 0.5));
+  viennacl::copy(vec, host_vec);
+
+  mean = 0; variance = 0;
+  for (std::size_t i=0; i<N; ++i)
+    mean += host_vec[i];
+  mean /= double(N);
+  for (std::size_t i=0; i<N; ++i)
+    variance += (host_vec[i] - mean) * (host_vec[i] - mean);
+  variance /= double(N - 1);
+
+  if (std::fabs(mean - 2.0) > 0.01 || std::fabs(variance - 0.25) > 0.01)
+  {
+    std::cout << "# Error: Gaussian mean/variance " << mean << "/" << variance << " deviate from 2/0.25" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  if (check_vector(host_vec, N, 1234, 0, viennacl::rand::detail::gaussian_transformation<NumericT>(2, NumericT(0.5)), tolerance, "gaussian vector") != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  std::cout << "# Statistics passed" << std::endl;
+  return EXIT_SUCCESS;
+}
+
+template <typename NumericT>
+int test_vector()
+{
+  viennacl::rand::uniform_tag tag(-2, 5);
+  viennacl::rand::detail::uniform_transformation<NumericT> trafo(NumericT(tag.a), NumericT(tag.b - tag.a));
+
+  // consecutive fills consume consecutive values of the stream:
+  std::size_t N1 = 1001, N2 = 10000;
+  viennacl::vector<NumericT> vec1(N1), vec2(N2);
+  std::vector<NumericT> host_vec1(N1), host_vec2(N2);
+
+  viennacl::rand::generator gen(7, 3);
+  gen.fill(vec1, tag);
+  gen.fill(vec2, tag);
+  if (gen.offset() != 1004 + N2)
+  {
+    std::cout << "# Error: Wrong offset after fills: " << gen.offset() << std::endl;
+    return EXIT_FAILURE;
+  }
+  viennacl::copy(vec1, host_vec1);
+  viennacl::copy(vec2, host_vec2);
+  if (check_vector(host_vec1, 0,    7, 3, trafo, NumericT(0), "first fill") != EXIT_SUCCESS
+   || check_vector(host_vec2, 1004, 7, 3, trafo, NumericT(0), "second fill") != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  // random access to the stream:
+  viennacl::rand::generator gen2(7, 3);
+  gen2.offset(1004);
+  viennacl::vector<NumericT> vec3(N2);
+  gen2.fill(vec3, tag);
+  std::vector<NumericT> host_vec3(N2);
+  viennacl::copy(vec3, host_vec3);
+  if (host_vec3 != host_vec2)
+  {
+    std::cout << "# Error: Fill at offset differs from consecutive fill" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // other streams differ:
+  viennacl::rand::generator gen3(7, 4);
+  gen3.fill(vec3, tag);
+  viennacl::copy(vec3, host_vec3);
+  std::size_t num_equal = 0;
+  for (std::size_t i=0; i<N2; ++i)
+    if (host_vec3[i] == host_vec2[i])
+      ++num_equal;
+  if (num_equal > N2 / 100)
+  {
+    std::cout << "# Error: Streams 3 and 4 are not independent" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // ranges and slices: only the referenced entries are written
+  viennacl::vector<NumericT> vec4(300);
+  std::vector<NumericT> host_vec4(300, NumericT(42));
+  viennacl::copy(host_vec4, vec4);
+
+  viennacl::range r(10, 110);
+  viennacl::slice s(120, 3, 50);
+  viennacl::vector_range<viennacl::vector<NumericT> > vec4_range(vec4, r);
+  viennacl::vector_slice<viennacl::vector<NumericT> > vec4_slice(vec4, s);
+
+  viennacl::rand::generator gen4(7, 3);
+  gen4.fill(vec4_range, tag);
+  gen4.fill(vec4_slice, tag);
+  viennacl::copy(vec4, host_vec4);
+
+  for (std::size_t i=0; i<300; ++i)
+  {
+    NumericT ref = NumericT(42);
+    if (i >= 10 && i < 110)
+      ref = reference_value<NumericT>(i - 10, 7, 3, trafo);
+    else if (i >= 120 && i < 270 && (i - 120) % 3 == 0)
+      ref = reference_value<NumericT>(100 + (i - 120) / 3, 7, 3, trafo);
+
+    if (host_vec4[i] != ref)
+    {
+      std::cout << "# Error in vector range/slice fill at entry " << i << ": " << host_vec4[i] << " vs. " << ref << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  std::cout << "# Vector fills passed" << std::endl;
+  return EXIT_SUCCESS;
+}
+
+template <typename NumericT, typename F, typename DistributionT, typename TransformationT>
+int test_matrix(DistributionT const & tag, TransformationT const & trafo, NumericT tolerance, std::string const & name)
+{
+  std::size_t M = 37, N = 53;
+
+  viennacl::matrix<NumericT, F> mat(M, N);
+  viennacl::rand::generator gen(11, 5);
+  gen.skip(8);
+  gen.fill(mat, tag);
+
+  std::vector<std::vector<NumericT> > host_mat(M, std::vector<NumericT>(N));
+  viennacl::copy(mat, host_mat);
+  for (std::size_t i=0; i<M; ++i)
+    for (std::size_t j=0; j<N; ++j)
+    {
+      NumericT ref = reference_value<NumericT>(8 + i * N + j, 11, 5, trafo);
+      if (!is_equal(host_mat[i][j], ref, tolerance))
+      {
+        std::cout << "# Error in " << name << " at entry (" << i << ", " << j << "): " << host_mat[i][j] << " vs. " << ref << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+
+  // submatrix: entries outside are not touched
+  std::vector<std::vector<NumericT> > host_zero(M, std::vector<NumericT>(N));
+  viennacl::copy(host_zero, mat);
+  viennacl::range r1(3, 20), r2(5, 40);
+  viennacl::matrix_range<viennacl::matrix<NumericT, F> > mat_range(mat, r1, r2);
+  viennacl::rand::generator gen2(11, 5);
+  gen2.fill(mat_range, tag);
+
+  viennacl::copy(mat, host_mat);
+  for (std::size_t i=0; i<M; ++i)
+    for (std::size_t j=0; j<N; ++j)
+    {
+      NumericT ref = 0;
+      if (i >= 3 && i < 20 && j >= 5 && j < 40)
+        ref = reference_value<NumericT>((i - 3) * 35 + (j - 5), 11, 5, trafo);
+      if (!is_equal(host_mat[i][j], ref, tolerance))
+      {
+        std::cout << "# Error in " << name << " (submatrix) at entry (" << i << ", " << j << "): " << host_mat[i][j] << " vs. " << ref << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+
+  std::cout << "# " << name << " passed" << std::endl;
+  return EXIT_SUCCESS;
+}
+
+template <typename NumericT>
+int test(NumericT tolerance)
+{
+  viennacl::rand::uniform_tag  utag(0, 10);
+  viennacl::rand::gaussian_tag gtag(-1, 3);
+  viennacl::rand::detail::uniform_transformation<NumericT>  utrafo(NumericT(utag.a), NumericT(utag.b - utag.a));
+  viennacl::rand::detail::gaussian_transformation<NumericT> gtrafo(NumericT(gtag.mu), NumericT(gtag.sigma));
+
+  if (test_statistics<NumericT>(tolerance) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+  if (test_vector<NumericT>() != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+  if (test_matrix<NumericT, viennacl::row_major>(utag, utrafo, NumericT(0), "uniform row-major matrix") != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+  if (test_matrix<NumericT, viennacl::column_major>(utag, utrafo, NumericT(0), "uniform column-major matrix") != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+  if (test_matrix<NumericT, viennacl::row_major>(gtag, gtrafo, tolerance, "gaussian row-major matrix") != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+  if (test_matrix<NumericT, viennacl::column_major>(gtag, gtrafo, tolerance, "gaussian column-major matrix") != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  // convenience functions:
+  viennacl::vector<NumericT> vec = viennacl::random_vector<NumericT>(100, utag, 99);
+  std::vector<NumericT> host_vec(100);
+  viennacl::copy(vec, host_vec);
+  if (check_vector(host_vec, 0, 99, 0, utrafo, NumericT(0), "random_vector()") != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  return EXIT_SUCCESS;
+}
+
+int main()
+{
+  std::cout << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "## Test :: Random numbers" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+
+  if (test_philox() != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  std::cout << "# Testing setup:" << std::endl;
+  std::cout << "  numeric: float" << std::endl;
+  if (test<float>(1e-4f) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+#ifdef VIENNACL_WITH_OPENCL
+  if( viennacl::ocl::current_device().double_support() )
+#endif
+  {
+    std::cout << "# Testing setup:" << std::endl;
+    std::cout << "  numeric: double" << std::endl;
+    if (test<double>(1e-10) != EXIT_SUCCESS)
+      return EXIT_FAILURE;
+  }
+
+  std::cout << std::endl;
+  std::cout << "------- Test completed --------" << std::endl;
+  std::cout << std::endl;
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,424 @@
+/* =========================================================================
+   Copyright (c) 2010-2013, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+//
+// *** System
+//
+#include <iostream>
+#include <vector>
+#include <string>
+#include <cmath>
+#include <cstdlib>
+#include <algorithm>
+
+//
+// *** ViennaCL
+//
+#include "viennacl/compressed_matrix.hpp"
+#include "viennacl/vector.hpp"
+#include "viennacl/linalg/prod.hpp"
+#include "viennacl/linalg/ilu.hpp"
+#include "viennacl/linalg/ichol.hpp"
+#include "viennacl/linalg/cg.hpp"
+#include "viennacl/linalg/norm_2.hpp"
+#include "viennacl/misc/bandwidth_reduction.hpp"
+#include "viennacl/misc/multicolor.hpp"
+
+//
+// -------------------------------------------------------------
+//
+
+/** @brief Creates the triplets of a 5-point stencil on an nx-by-ny grid with randomly numbered grid points. Rows with index >= nx*ny are isolated (diagonal only). */
+void make_grid(std::size_t nx, std::size_t ny, std::size_t isolated,
+               std::vector<unsigned int> & row_indices, std::vector<unsigned int> & col_indices, std::vector<double> & values)
+{
+  std::size_t n = nx * ny;
+  std::vector<unsigned int> labels(n);
+  for (std::size_t i=0; i<n; ++i)
+    labels[i] = static_cast<unsigned int>(i);
+  std::srand(42);
+  for (std::size_t k=n; k > 1; --k)
+    std::swap(labels[k-1], labels[static_cast<std::size_t>(std::rand()) % k]);
+
+  row_indices.clear();
+  col_indices.clear();
+  values.clear();
+  for (std::size_t x=0; x<nx; ++x)
+    for (std::size_t y=0; y<ny; ++y)
+    {
+      unsigned int i = labels[x * ny + y];
+      row_indices.push_back(i); col_indices.push_back(i); values.push_back(4.0);
+      if (x > 0)    { row_indices.push_back(i); col_indices.push_back(labels[(x-1) * ny + y]); values.push_back(-1.0 - double(i % 3) / 10.0); }
+      if (x+1 < nx) { row_indices.push_back(i); col_indices.push_back(labels[(x+1) * ny + y]); values.push_back(-1.0); }
+      if (y > 0)    { row_indices.push_back(i); col_indices.push_back(labels[x * ny + y - 1]); values.push_back(-1.0); }
+      if (y+1 < ny) { row_indices.push_back(i); col_indices.push_back(labels[x * ny + y + 1]); values.push_back(-1.0 + double(i % 5) / 10.0); }
+    }
+  for (std::size_t i=n; i<n+isolated; ++i)
+  {
+    row_indices.push_back(static_cast<unsigned int>(i)); col_indices.push_back(static_cast<unsigned int>(i)); values.push_back(2.0);
+  }
+}
+
+/** @brief Creates the triplets of the 5-point Laplace operator on an nx-by-ny grid with lexicographic numbering of the grid points */
+void make_laplace(std::size_t nx, std::size_t ny,
+                  std::vector<unsigned int> & row_indices, std::vector<unsigned int> & col_indices, std::vector<double> & values)
+{
+  row_indices.clear();
+  col_indices.clear();
+  values.clear();
+  for (std::size_t x=0; x<nx; ++x)
+    for (std::size_t y=0; y<ny; ++y)
+    {
+      unsigned int i = static_cast<unsigned int>(x * ny + y);
+      row_indices.push_back(i); col_indices.push_back(i); values.push_back(4.0);
+      if (x > 0)    { row_indices.push_back(i); col_indices.push_back(i - static_cast<unsigned int>(ny)); values.push_back(-1.0); }
+      if (x+1 < nx) { row_indices.push_back(i); col_indices.push_back(i + static_cast<unsigned int>(ny)); values.push_back(-1.0); }
+      if (y > 0)    { row_indices.push_back(i); col_indices.push_back(i - 1); values.push_back(-1.0); }
+      if (y+1 < ny) { row_indices.push_back(i); col_indices.push_back(i + 1); values.push_back(-1.0); }
+    }
+}
+
+/** @brief Returns true if r is a permutation of {0, ..., n-1} */
+bool is_permutation(std::vector<int> const & r, std::size_t n)
+{
+  if (r.size() != n)
+    return false;
+  std::vector<bool> found(n);
+  for (std::size_t i=0; i<r.size(); ++i)
+  {
+    if (r[i] < 0 || static_cast<std::size_t>(r[i]) >= n || found[static_cast<std::size_t>(r[i])])
+      return false;
+    found[static_cast<std::size_t>(r[i])] = true;
+  }
+  return true;
+}
+
+/** @brief Bandwidth of the sparsity pattern given by triplets after applying the permutation r (identity if r is empty) */
+std::size_t bandwidth(std::vector<unsigned int> const & row_indices, std::vector<unsigned int> const & col_indices, std::vector<int> const & r)
+{
+  std::vector<std::size_t> r_inverse(r.size());
+  for (std::size_t l=0; l<r.size(); ++l)
+    r_inverse[static_cast<std::size_t>(r[l])] = l;
+
+  std::size_t result = 0;
+  for (std::size_t k=0; k<row_indices.size(); ++k)
+  {
+    std::size_t i = r.size() ? r_inverse[row_indices[k]] : row_indices[k];
+    std::size_t j = r.size() ? r_inverse[col_indices[k]] : col_indices[k];
+    result = std::max(result, i > j ? i - j : j - i);
+  }
+  return result;
+}
+
+/** @brief Checks that y = A x is preserved by the symmetric permutation, i.e. P A P^T P x = P y */
+template <unsigned int AlignmentV>
+bool check_permuted_product(std::size_t n,
+                            std::vector<unsigned int> const & row_indices, std::vector<unsigned int> const & col_indices, std::vector<double> const & values,
+                            std::vector<int> const & r)
+{
+  viennacl::compressed_matrix<double, AlignmentV> A(n, n);
+  A.assemble(row_indices, col_indices, values);
+
+  std::vector<double> x(n);
+  for (std::size_t i=0; i<n; ++i)
+    x[i] = 1.0 + double(i % 11);
+  viennacl::vector<double> vcl_x(n), vcl_y(n), vcl_y_permuted(n);
+  viennacl::copy(x, vcl_x);
+  vcl_y = viennacl::linalg::prod(A, vcl_x);
+
+  viennacl::permute(A, r);
+  viennacl::permute(vcl_x, r);
+  vcl_y_permuted = viennacl::linalg::prod(A, vcl_x);
+  viennacl::inverse_permute(vcl_y_permuted, r);
+  viennacl::inverse_permute(vcl_x, r);
+
+  std::vector<double> y(n), y_permuted(n), x_back(n);
+  viennacl::copy(vcl_y, y);
+  viennacl::copy(vcl_y_permuted, y_permuted);
+  viennacl::copy(vcl_x, x_back);
+  for (std::size_t i=0; i<n; ++i)
+  {
+    if (std::fabs(y[i] - y_permuted[i]) > 1e-10 * std::max(1.0, std::fabs(y[i])))
+    {
+      std::cout << "# Error in permuted matrix-vector product at row " << i << ": " << y_permuted[i] << " vs. " << y[i] << std::endl;
+      return false;
+    }
+    if (x_back[i] != x[i])
+    {
+      std::cout << "# Error: inverse_permute() does not revert permute() at entry " << i << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+/** @brief Checks validity of the permutation, bandwidth reduction and the permutation helpers for a randomly numbered grid with isolated nodes */
+template <typename TagT>
+int test_ordering(std::string const & name, TagT const & tag, bool expect_bandwidth_reduction)
+{
+  std::size_t nx = 60, ny = 40, isolated = 7;
+  std::size_t n = nx * ny + isolated;
+  std::vector<unsigned int> row_indices, col_indices;
+  std::vector<double> values;
+  make_grid(nx, ny, isolated, row_indices, col_indices, values);
+
+  viennacl::compressed_matrix<double> A(n, n);
+  A.assemble(row_indices, col_indices, values);
+
+  std::cout << "* " << name << ": permutation" << std::endl;
+  std::vector<int> r = viennacl::reorder(A, tag);
+  if (!is_permutation(r, n))
+  {
+    std::cout << "# Error: Result is not a permutation" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::size_t old_bandwidth = bandwidth(row_indices, col_indices, std::vector<int>());
+  std::size_t new_bandwidth = bandwidth(row_indices, col_indices, r);
+  std::cout << "  bandwidth: " << old_bandwidth << " -> " << new_bandwidth << std::endl;
+  if (expect_bandwidth_reduction && new_bandwidth > 2 * ny)
+  {
+    std::cout << "# Error: Insufficient bandwidth reduction" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "* " << name << ": permuted matrix-vector product" << std::endl;
+  if (!check_permuted_product<1>(n, row_indices, col_indices, values, r))
+    return EXIT_FAILURE;
+
+  std::cout << "* " << name << ": permuted matrix-vector product with alignment" << std::endl;
+  if (!check_permuted_product<4>(n, row_indices, col_indices, values, r))
+    return EXIT_FAILURE;
+
+  std::cout << "* " << name << ": padded input" << std::endl;
+  viennacl::compressed_matrix<double, 4> A_aligned(n, n);
+  A_aligned.assemble(row_indices, col_indices, values);
+  if (viennacl::reorder(A_aligned, tag) != r)
+  {
+    std::cout << "# Error: Alignment padding changes the ordering" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
+
+/** @brief Checks that the top-level separator found by nested dissection is numbered last and decouples the two parts numbered before it */
+int test_nested_dissection_structure()
+{
+  std::size_t nx = 50, ny = 50;
+  std::size_t n = nx * ny;
+  std::vector<unsigned int> row_indices, col_indices;
+  std::vector<double> values;
+  make_grid(nx, ny, 0, row_indices, col_indices, values);
+
+  viennacl::compressed_matrix<double> A(n, n);
+  A.assemble(row_indices, col_indices, values);
+
+  std::cout << "* nested dissection: fill-reducing structure" << std::endl;
+  std::vector<int> r = viennacl::reorder(A, viennacl::nested_dissection_tag(16));
+  if (!is_permutation(r, n))
+  {
+    std::cout << "# Error: Result is not a permutation" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::vector<std::size_t> r_inverse(n);
+  for (std::size_t l=0; l<n; ++l)
+    r_inverse[static_cast<std::size_t>(r[l])] = l;
+
+  // The first part ends before n/2, the separator (a diagonal of the grid) occupies less than the last 2*nx labels:
+  std::size_t crossing = 0;
+  for (std::size_t k=0; k<row_indices.size(); ++k)
+  {
+    std::size_t i = r_inverse[row_indices[k]];
+    std::size_t j = r_inverse[col_indices[k]];
+    if (i > j)
+      std::swap(i, j);
+    if (i < n / 4 && j >= n / 2 && j < n - 2 * nx)
+      ++crossing;
+  }
+  if (crossing > 0)
+  {
+    std::cout << "# Error: " << crossing << " edges cross the top-level separator" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
+
+/** @brief Checks that a preconditioner with reordering is the preconditioner without reordering for the permuted system, for the initial setup and after refactor() */
+template <typename PrecondT, typename TagT>
+bool check_reordered_precond(std::string const & name, std::size_t n,
+                             std::vector<unsigned int> const & row_indices, std::vector<unsigned int> const & col_indices, std::vector<double> const & values,
+                             TagT const & tag_reordered, TagT const & tag_plain, std::vector<int> const & r)
+{
+  std::cout << "* " << name << std::endl;
+
+  viennacl::compressed_matrix<double> A(n, n);
+  A.assemble(row_indices, col_indices, values);
+  PrecondT precond_reordered(A, tag_reordered);
+
+  std::vector<double> x(n);
+  for (std::size_t i=0; i<n; ++i)
+    x[i] = 1.0 + double(i % 13) / 4.0;
+
+  for (std::size_t pass = 0; pass < 2; ++pass)
+  {
+    if (pass == 1) //new values with the same pattern
+    {
+      std::vector<double> new_values(values);
+      for (std::size_t k=0; k<new_values.size(); ++k)
+        new_values[k] *= (row_indices[k] == col_indices[k]) ? 3.0 : 1.0 + double(row_indices[k] + col_indices[k]) / double(2 * n);
+      A.assemble(row_indices, col_indices, new_values);
+      precond_reordered.refactor(A);
+    }
+
+    viennacl::compressed_matrix<double> A_permuted(n, n);
+    A_permuted = A;
+    viennacl::permute(A_permuted, r);
+    PrecondT precond_plain(A_permuted, tag_plain);
+
+    viennacl::vector<double> vcl_x1(n), vcl_x2(n);
+    viennacl::copy(x, vcl_x1);
+    viennacl::copy(x, vcl_x2);
+
+    precond_reordered.apply(vcl_x1);
+
+    viennacl::permute(vcl_x2, r);
+    precond_plain.apply(vcl_x2);
+    viennacl::inverse_permute(vcl_x2, r);
+
+    std::vector<double> x1(n), x2(n);
+    viennacl::copy(vcl_x1, x1);
+    viennacl::copy(vcl_x2, x2);
+    for (std::size_t i=0; i<n; ++i)
+      if (std::fabs(x1[i] - x2[i]) > 1e-10 * std::max(1.0, std::fabs(x2[i])))
+      {
+        std::cout << "# Error: Reordered preconditioner differs at entry " << i << ": " << x1[i] << " vs. " << x2[i] << (pass ? " (after refactor)" : "") << std::endl;
+        return false;
+      }
+  }
+  return true;
+}
+
+/** @brief Checks ILU0, ILUT, and ICHOL0 with multicolor and level set reordering */
+int test_preconditioners()
+{
+  typedef viennacl::compressed_matrix<double>   MatrixType;
+
+  std::size_t nx = 40, ny = 30;
+  std::size_t n = nx * ny;
+  std::vector<unsigned int> row_indices, col_indices;
+  std::vector<double> values;
+  make_laplace(nx, ny, row_indices, col_indices, values);
+
+  MatrixType A(n, n);
+  A.assemble(row_indices, col_indices, values);
+
+  std::vector<int> r_multicolor = viennacl::reorder(A, viennacl::multicolor_tag());
+  std::vector<int> r_level_set = viennacl::linalg::detail::level_set_ordering(A);
+  if (!is_permutation(r_multicolor, n) || !is_permutation(r_level_set, n))
+  {
+    std::cout << "# Error: Result is not a permutation" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  viennacl::linalg::ilu0_tag ilu0_plain, ilu0_multicolor(false, viennacl::linalg::ILU_REORDERING_MULTICOLOR), ilu0_level_set(false, viennacl::linalg::ILU_REORDERING_LEVEL_SET);
+  if (!check_reordered_precond< viennacl::linalg::ilu0_precond<MatrixType> >("ILU0, multicolor", n, row_indices, col_indices, values, ilu0_multicolor, ilu0_plain, r_multicolor))
+    return EXIT_FAILURE;
+  if (!check_reordered_precond< viennacl::linalg::ilu0_precond<MatrixType> >("ILU0, level set", n, row_indices, col_indices, values, ilu0_level_set, ilu0_plain, r_level_set))
+    return EXIT_FAILURE;
+
+  viennacl::linalg::ilu0_tag ilu0_ls_plain(true), ilu0_ls_multicolor(true, viennacl::linalg::ILU_REORDERING_MULTICOLOR);
+  if (!check_reordered_precond< viennacl::linalg::ilu0_precond<MatrixType> >("ILU0 with level scheduling, multicolor", n, row_indices, col_indices, values, ilu0_ls_multicolor, ilu0_ls_plain, r_multicolor))
+    return EXIT_FAILURE;
+
+  viennacl::linalg::ilut_tag ilut_plain, ilut_multicolor(20, 1e-4, false, viennacl::linalg::ILU_REORDERING_MULTICOLOR);
+  if (!check_reordered_precond< viennacl::linalg::ilut_precond<MatrixType> >("ILUT, multicolor", n, row_indices, col_indices, values, ilut_multicolor, ilut_plain, r_multicolor))
+    return EXIT_FAILURE;
+
+  viennacl::linalg::ichol0_tag ichol0_plain, ichol0_multicolor(viennacl::linalg::ILU_REORDERING_MULTICOLOR);
+  if (!check_reordered_precond< viennacl::linalg::ichol0_precond<MatrixType> >("ICHOL0, multicolor", n, row_indices, col_indices, values, ichol0_multicolor, ichol0_plain, r_multicolor))
+    return EXIT_FAILURE;
+
+  std::cout << "* ILU0 with level scheduling: number of levels" << std::endl;
+  viennacl::linalg::ilu0_precond<MatrixType> natural(A, ilu0_ls_plain);
+  viennacl::linalg::ilu0_precond<MatrixType> multicolor(A, ilu0_ls_multicolor);
+  std::cout << "  levels: " << natural.levels() << " -> " << multicolor.levels() << std::endl;
+  if (natural.levels() < nx || multicolor.levels() > 8)
+  {
+    std::cout << "# Error: Unexpected number of levels" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "* CG with multicolor ICHOL0" << std::endl;
+  viennacl::vector<double> b = viennacl::scalar_vector<double>(n, 1.0);
+  viennacl::linalg::cg_tag cg(1e-10, 300);
+  viennacl::linalg::ichol0_precond<MatrixType> ichol0(A, ichol0_multicolor);
+  viennacl::vector<double> x = viennacl::linalg::solve(A, b, cg, ichol0);
+  viennacl::vector<double> residual = viennacl::linalg::prod(A, x);
+  residual -= b;
+  std::cout << "  iterations: " << cg.iters() << std::endl;
+  if (viennacl::linalg::norm_2(residual) > 1e-8 * viennacl::linalg::norm_2(b))
+  {
+    std::cout << "# Error: CG did not converge" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
+
+//
+// -------------------------------------------------------------
+//
+int main()
+{
+  std::cout << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "## Test :: Reordering of Sparse Matrices" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << std::endl;
+
+#ifdef VIENNACL_WITH_OPENCL
+  if( !viennacl::ocl::current_device().double_support() )
+  {
+    std::cout << "# Double precision not supported, skipping test" << std::endl;
+    return EXIT_SUCCESS;
+  }
+#endif
+
+  if (test_ordering("reverse Cuthill-McKee", viennacl::reverse_cuthill_mckee_tag(), true) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+  if (test_ordering("Cuthill-McKee", viennacl::reverse_cuthill_mckee_tag(false), true) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+  if (test_ordering("nested dissection", viennacl::nested_dissection_tag(), false) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+  if (test_nested_dissection_structure() != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+  if (test_ordering("multicolor", viennacl::multicolor_tag(), false) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+  if (test_preconditioners() != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  std::cout << std::endl;
+  std::cout << "------- Test completed --------" << std::endl;
+  std::cout << std::endl;
+
+  return EXIT_SUCCESS;
+}
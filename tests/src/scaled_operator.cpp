@@ -0,0 +1,374 @@
+/* =========================================================================
+   Copyright (c) 2010-2013, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+//
+// *** System
+//
+#include <iostream>
+#include <vector>
+#include <cmath>
+#include <cstdlib>
+
+//
+// *** ViennaCL
+//
+#include "viennacl/compressed_matrix.hpp"
+#include "viennacl/vector.hpp"
+#include "viennacl/linalg/prod.hpp"
+#include "viennacl/linalg/norm_2.hpp"
+#include "viennacl/linalg/cg.hpp"
+#include "viennacl/linalg/bicgstab.hpp"
+#include "viennacl/linalg/jacobi_precond.hpp"
+#include "viennacl/linalg/row_scaling.hpp"
+#include "viennacl/linalg/scaled_operator.hpp"
+#include "viennacl/linalg/block_jacobi_precond.hpp"
+
+//
+// -------------------------------------------------------------
+//
+
+/** @brief Creates the triplets of W (-Laplace(u) + convection * du/dx) W on an N x N grid, where W is a badly scaled diagonal matrix */
+template <typename NumericT>
+void make_system(std::size_t N, NumericT convection,
+                 std::vector<unsigned int> & row_indices, std::vector<unsigned int> & col_indices, std::vector<NumericT> & values)
+{
+  row_indices.clear();
+  col_indices.clear();
+  values.clear();
+
+  std::vector<NumericT> w(N * N);
+  for (std::size_t i=0; i<w.size(); ++i)
+    w[i] = NumericT(1) + NumericT((i * 7) % 11);
+
+  for (std::size_t i=0; i<N; ++i)
+    for (std::size_t j=0; j<N; ++j)
+    {
+      unsigned int row = static_cast<unsigned int>(i * N + j);
+
+      row_indices.push_back(row); col_indices.push_back(row); values.push_back(NumericT(4.01) * w[row] * w[row]);
+      if (i > 0)   { row_indices.push_back(row); col_indices.push_back(row - N); values.push_back(NumericT(-1) * w[row] * w[row - N]); }
+      if (i+1 < N) { row_indices.push_back(row); col_indices.push_back(row + N); values.push_back(NumericT(-1) * w[row] * w[row + N]); }
+      if (j > 0)   { row_indices.push_back(row); col_indices.push_back(row - 1); values.push_back((NumericT(-1) - convection) * w[row] * w[row - 1]); }
+      if (j+1 < N) { row_indices.push_back(row); col_indices.push_back(row + 1); values.push_back((NumericT(-1) + convection) * w[row] * w[row + 1]); }
+    }
+}
+
+template <typename NumericT>
+bool check(viennacl::vector<NumericT> const & vcl_result, viennacl::vector<NumericT> const & vcl_reference, NumericT epsilon)
+{
+  std::vector<NumericT> result(vcl_result.size()), reference(vcl_reference.size());
+  viennacl::copy(vcl_result, result);
+  viennacl::copy(vcl_reference, reference);
+
+  for (std::size_t i=0; i<result.size(); ++i)
+  {
+    if (std::fabs(result[i] - reference[i]) > epsilon * std::max(NumericT(1), std::fabs(reference[i])))
+    {
+      std::cout << "# Error at index " << i << ": " << result[i] << " vs. " << reference[i] << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+/** @brief Checks the relative residual of the solution of a linear system */
+template <typename NumericT, typename MatrixT>
+bool check_residual(MatrixT const & A, viennacl::vector<NumericT> const & result, viennacl::vector<NumericT> const & rhs, NumericT tolerance)
+{
+  viennacl::vector<NumericT> residual = rhs;
+  residual -= viennacl::linalg::prod(A, result);
+  NumericT relative_residual = viennacl::linalg::norm_2(residual) / viennacl::linalg::norm_2(rhs);
+  if (relative_residual > tolerance)
+  {
+    std::cout << "# Error: Relative residual " << relative_residual << " exceeds " << tolerance << std::endl;
+    return false;
+  }
+  return true;
+}
+
+/** @brief Compares the fused product with a scaled operator against separate products and element-wise scalings */
+template <typename NumericT, typename MatrixT, typename TagT>
+bool test_fused_prod(MatrixT const & A, TagT const & tag, viennacl::linalg::diagonal_scaling_type type, NumericT epsilon)
+{
+  std::size_t size = A.size1();
+  viennacl::linalg::scaled_operator<MatrixT> op(A, tag, type);
+
+  std::vector<NumericT> host_x(size);
+  for (std::size_t i=0; i<size; ++i)
+    host_x[i] = NumericT(1) + NumericT(i % 13) / NumericT(4);
+  viennacl::vector<NumericT> x(size);
+  viennacl::copy(host_x, x);
+
+  // reference:
+  viennacl::vector<NumericT> z = x;
+  if (type == viennacl::linalg::DIAGONAL_SCALING_SYMMETRIC)
+    z = viennacl::linalg::element_prod(op.scaling(), x);
+  viennacl::vector<NumericT> reference = viennacl::linalg::prod(A, z);
+  reference = viennacl::linalg::element_prod(op.scaling(), reference);
+
+  viennacl::vector<NumericT> y = viennacl::linalg::prod(op, x);
+  if (!check(y, reference, epsilon))
+    return false;
+
+  // y += op * x, y -= op * x:
+  y += viennacl::linalg::prod(op, x);
+  y -= viennacl::linalg::prod(op, x);
+  if (!check(y, reference, epsilon))
+    return false;
+
+  // in-place product x = op * x:
+  x = viennacl::linalg::prod(op, x);
+  if (!check(x, reference, epsilon))
+    return false;
+
+  // scaling of right hand side and solution:
+  viennacl::vector<NumericT> b = z;
+  op.scale_rhs(b);
+  op.unscale_solution(b);
+  reference = viennacl::linalg::element_prod(op.scaling(), z);
+  if (type == viennacl::linalg::DIAGONAL_SCALING_SYMMETRIC)
+    reference = viennacl::linalg::element_prod(op.scaling(), reference);
+  return check(b, reference, epsilon);
+}
+
+template <typename NumericT>
+int test(NumericT epsilon)
+{
+  std::size_t N = 20;
+  std::size_t size = N * N;
+
+  std::vector<unsigned int> row_indices, col_indices;
+  std::vector<NumericT> sym_values, nonsym_values;
+  make_system(N, NumericT(0),   row_indices, col_indices, sym_values);
+  make_system(N, NumericT(0.3), row_indices, col_indices, nonsym_values);
+
+  viennacl::compressed_matrix<NumericT> A_sym(size, size);
+  A_sym.assemble(row_indices, col_indices, sym_values);
+  viennacl::compressed_matrix<NumericT> A(size, size);
+  A.assemble(row_indices, col_indices, nonsym_values);
+  viennacl::compressed_matrix<NumericT, 4> A4(size, size);
+  A4.assemble(row_indices, col_indices, nonsym_values);
+
+  //
+  // Fused products
+  //
+  std::cout << "* Fused product D^{-1} A with diagonal" << std::endl;
+  if (!test_fused_prod(A, viennacl::linalg::jacobi_tag(), viennacl::linalg::DIAGONAL_SCALING_LEFT, epsilon))
+    return EXIT_FAILURE;
+
+  std::cout << "* Fused product D^{-1/2} A D^{-1/2} with diagonal" << std::endl;
+  if (!test_fused_prod(A, viennacl::linalg::jacobi_tag(), viennacl::linalg::DIAGONAL_SCALING_SYMMETRIC, epsilon))
+    return EXIT_FAILURE;
+
+  std::cout << "* Fused product D^{-1} A with row norms" << std::endl;
+  for (unsigned int p=0; p<3; ++p)
+    if (!test_fused_prod(A, viennacl::linalg::row_scaling_tag(p), viennacl::linalg::DIAGONAL_SCALING_LEFT, epsilon))
+      return EXIT_FAILURE;
+
+  std::cout << "* Fused product D^{-1/2} A D^{-1/2} with row norms" << std::endl;
+  if (!test_fused_prod(A, viennacl::linalg::row_scaling_tag(1), viennacl::linalg::DIAGONAL_SCALING_SYMMETRIC, epsilon))
+    return EXIT_FAILURE;
+
+  std::cout << "* Fused products with alignment 4" << std::endl;
+  if (!test_fused_prod(A4, viennacl::linalg::jacobi_tag(), viennacl::linalg::DIAGONAL_SCALING_LEFT, epsilon))
+    return EXIT_FAILURE;
+  if (!test_fused_prod(A4, viennacl::linalg::jacobi_tag(), viennacl::linalg::DIAGONAL_SCALING_SYMMETRIC, epsilon))
+    return EXIT_FAILURE;
+
+  viennacl::vector<NumericT> x_exact = viennacl::scalar_vector<NumericT>(size, NumericT(1));
+
+  //
+  // Solvers
+  //
+  std::cout << "* CG with symmetrically scaled operator" << std::endl;
+  {
+    viennacl::vector<NumericT> rhs = viennacl::linalg::prod(A_sym, x_exact);
+
+    viennacl::linalg::cg_tag plain_tag(NumericT(1e-5), 2000);
+    viennacl::vector<NumericT> result = viennacl::linalg::solve(A_sym, rhs, plain_tag);
+
+    viennacl::linalg::cg_tag jacobi_cg_tag(NumericT(1e-5), 2000);
+    viennacl::linalg::jacobi_precond< viennacl::compressed_matrix<NumericT> > jacobi(A_sym, viennacl::linalg::jacobi_tag());
+    result = viennacl::linalg::solve(A_sym, rhs, jacobi_cg_tag, jacobi);
+
+    viennacl::linalg::cg_tag scaled_tag(NumericT(1e-5), 2000);
+    viennacl::linalg::scaled_operator< viennacl::compressed_matrix<NumericT> > op(A_sym, viennacl::linalg::jacobi_tag(), viennacl::linalg::DIAGONAL_SCALING_SYMMETRIC);
+    viennacl::vector<NumericT> scaled_rhs = rhs;
+    op.scale_rhs(scaled_rhs);
+    result = viennacl::linalg::solve(op, scaled_rhs, scaled_tag);
+    op.unscale_solution(result);
+
+    std::cout << "  Iterations: plain " << plain_tag.iters() << ", Jacobi " << jacobi_cg_tag.iters() << ", scaled " << scaled_tag.iters() << std::endl;
+    if (!check_residual(A_sym, result, rhs, NumericT(1e-3)))
+      return EXIT_FAILURE;
+    if (scaled_tag.iters() >= plain_tag.iters())
+    {
+      std::cout << "# Error: Scaling does not reduce the number of iterations" << std::endl;
+      return EXIT_FAILURE;
+    }
+    if (scaled_tag.iters() > jacobi_cg_tag.iters() + 2 || jacobi_cg_tag.iters() > scaled_tag.iters() + 2)
+    {
+      std::cout << "# Error: Iteration counts of Jacobi preconditioner and scaled operator differ" << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  std::cout << "* BiCGStab with left-scaled operator" << std::endl;
+  {
+    viennacl::vector<NumericT> rhs = viennacl::linalg::prod(A, x_exact);
+
+    viennacl::linalg::bicgstab_tag plain_tag(NumericT(1e-5), 2000);
+    viennacl::vector<NumericT> result = viennacl::linalg::solve(A, rhs, plain_tag);
+
+    viennacl::linalg::bicgstab_tag scaled_tag(NumericT(1e-5), 2000);
+    viennacl::linalg::scaled_operator< viennacl::compressed_matrix<NumericT> > op(A, viennacl::linalg::row_scaling_tag(), viennacl::linalg::DIAGONAL_SCALING_LEFT);
+    viennacl::vector<NumericT> scaled_rhs = rhs;
+    op.scale_rhs(scaled_rhs);
+    result = viennacl::linalg::solve(op, scaled_rhs, scaled_tag);
+    op.unscale_solution(result);
+
+    std::cout << "  Iterations: plain " << plain_tag.iters() << ", scaled " << scaled_tag.iters() << std::endl;
+    if (!check_residual(A, result, rhs, NumericT(1e-3)))
+      return EXIT_FAILURE;
+    if (scaled_tag.iters() >= plain_tag.iters())
+    {
+      std::cout << "# Error: Scaling does not reduce the number of iterations" << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  //
+  // Block-Jacobi
+  //
+  std::cout << "* Block-Jacobi on block-diagonal matrix" << std::endl;
+  {
+    std::size_t block_size = 3;  //does not divide the number of unknowns
+    std::vector<unsigned int> block_rows, block_cols;
+    std::vector<NumericT> block_values;
+    for (std::size_t k=0; k<row_indices.size(); ++k)
+      if (row_indices[k] / block_size == col_indices[k] / block_size)
+      {
+        block_rows.push_back(row_indices[k]);
+        block_cols.push_back(col_indices[k]);
+        block_values.push_back(nonsym_values[k]);
+      }
+    viennacl::compressed_matrix<NumericT> B(size, size);
+    B.assemble(block_rows, block_cols, block_values);
+
+    viennacl::linalg::block_jacobi_precond< viennacl::compressed_matrix<NumericT> > precond(B, viennacl::linalg::block_jacobi_tag(block_size));
+    viennacl::vector<NumericT> y = viennacl::linalg::prod(B, x_exact);
+    precond.apply(y);
+    if (!check(y, x_exact, NumericT(100) * epsilon))
+      return EXIT_FAILURE;
+
+    // refactor for new values with the same pattern:
+    for (std::size_t k=0; k<block_values.size(); ++k)
+      block_values[k] *= NumericT(2);
+    viennacl::compressed_matrix<NumericT> B2(size, size);
+    B2.assemble(block_rows, block_cols, block_values);
+    precond.refactor(B2);
+    y = viennacl::linalg::prod(B2, x_exact);
+    precond.apply(y);
+    if (!check(y, x_exact, NumericT(100) * epsilon))
+      return EXIT_FAILURE;
+  }
+
+  std::cout << "* BiCGStab with block-Jacobi" << std::endl;
+  {
+    viennacl::vector<NumericT> rhs = viennacl::linalg::prod(A, x_exact);
+
+    viennacl::linalg::bicgstab_tag plain_tag(NumericT(1e-5), 2000);
+    viennacl::vector<NumericT> result = viennacl::linalg::solve(A, rhs, plain_tag);
+
+    viennacl::linalg::bicgstab_tag block_tag(NumericT(1e-5), 2000);
+    viennacl::linalg::block_jacobi_precond< viennacl::compressed_matrix<NumericT> > precond(A, viennacl::linalg::block_jacobi_tag(N));
+    result = viennacl::linalg::solve(A, rhs, block_tag, precond);
+
+    std::cout << "  Iterations: plain " << plain_tag.iters() << ", block-Jacobi " << block_tag.iters() << std::endl;
+    if (!check_residual(A, result, rhs, NumericT(1e-3)))
+      return EXIT_FAILURE;
+    if (block_tag.iters() >= plain_tag.iters())
+    {
+      std::cout << "# Error: Block-Jacobi does not reduce the number of iterations" << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
+
+
+//
+// -------------------------------------------------------------
+//
+int main()
+{
+  std::cout << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "## Test :: Scaled Operators and Block-Jacobi Preconditioner" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << std::endl;
+
+  int retval = EXIT_SUCCESS;
+
+  std::cout << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << std::endl;
+  {
+    typedef float NumericT;
+    NumericT epsilon = static_cast<NumericT>(1E-4);
+    std::cout << "# Testing setup:" << std::endl;
+    std::cout << "  eps:     " << epsilon << std::endl;
+    std::cout << "  numeric: float" << std::endl;
+    retval = test<NumericT>(epsilon);
+    if( retval == EXIT_SUCCESS )
+        std::cout << "# Test passed" << std::endl;
+    else
+        return retval;
+  }
+  std::cout << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << std::endl;
+
+#ifdef VIENNACL_WITH_OPENCL
+  if( viennacl::ocl::current_device().double_support() )
+#endif
+  {
+    typedef double NumericT;
+    NumericT epsilon = 1.0E-10;
+    std::cout << "# Testing setup:" << std::endl;
+    std::cout << "  eps:     " << epsilon << std::endl;
+    std::cout << "  numeric: double" << std::endl;
+    retval = test<NumericT>(epsilon);
+    if( retval == EXIT_SUCCESS )
+        std::cout << "# Test passed" << std::endl;
+    else
+        return retval;
+  }
+  std::cout << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << std::endl;
+
+  std::cout << std::endl;
+  std::cout << "------- Test completed --------" << std::endl;
+  std::cout << std::endl;
+
+  return retval;
+}
+
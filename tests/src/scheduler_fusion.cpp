@@ -0,0 +1,297 @@
+/* =========================================================================
+   Copyright (c) 2010-2013, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+//
+// Tests the single-pass evaluation of element-wise statements and reductions by the scheduler on the host
+//
+
+#include <iostream>
+#include <vector>
+#include <cmath>
+#include <cstdlib>
+#include <algorithm>
+
+#include "viennacl/scalar.hpp"
+#include "viennacl/vector.hpp"
+#include "viennacl/vector_proxy.hpp"
+#include "viennacl/matrix.hpp"
+#include "viennacl/matrix_proxy.hpp"
+#include "viennacl/linalg/inner_prod.hpp"
+#include "viennacl/linalg/norm_1.hpp"
+#include "viennacl/linalg/norm_2.hpp"
+#include "viennacl/linalg/norm_inf.hpp"
+
+#include "viennacl/scheduler/execute.hpp"
+
+#include "Random.hpp"
+
+
+/** @brief Executes the statement and checks whether the fused path has been taken if expected */
+bool run(viennacl::scheduler::statement const & s, bool expect_fused)
+{
+  bool fused = viennacl::scheduler::detail::execute_fused(s, s.array()[s.root()]);
+  if (!fused)
+    viennacl::scheduler::execute(s);
+
+  // fusion is only available in main memory:
+  if (viennacl::context().memory_type() != viennacl::MAIN_MEMORY)
+    expect_fused = false;
+
+  if (fused != expect_fused)
+  {
+    std::cout << "# Error: Statement " << (fused ? "was" : "was not") << " fused!" << std::endl;
+    return false;
+  }
+  return true;
+}
+
+template <typename NumericT>
+bool check(std::vector<NumericT> const & ref, viennacl::vector_base<NumericT> const & vcl, NumericT epsilon)
+{
+  std::vector<NumericT> result(vcl.size());
+  viennacl::copy(vcl.begin(), vcl.end(), result.begin());
+  for (std::size_t i=0; i<ref.size(); ++i)
+  {
+    if (std::fabs(ref[i] - result[i]) > epsilon * std::max(NumericT(1), std::fabs(ref[i])))
+    {
+      std::cout << "# Error at index " << i << ": " << ref[i] << " vs. " << result[i] << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+template <typename NumericT>
+bool check(NumericT ref, NumericT result, NumericT epsilon)
+{
+  if (std::fabs(ref - result) > epsilon * std::max(NumericT(1), std::fabs(ref)))
+  {
+    std::cout << "# Error: " << ref << " vs. " << result << std::endl;
+    return false;
+  }
+  return true;
+}
+
+template <typename NumericT, typename F>
+bool check(std::vector<std::vector<NumericT> > const & ref, viennacl::matrix<NumericT, F> const & vcl, NumericT epsilon)
+{
+  std::vector<std::vector<NumericT> > result(vcl.size1(), std::vector<NumericT>(vcl.size2()));
+  viennacl::copy(vcl, result);
+  for (std::size_t i=0; i<ref.size(); ++i)
+    for (std::size_t j=0; j<ref[i].size(); ++j)
+      if (!check(ref[i][j], result[i][j], epsilon))
+        return false;
+  return true;
+}
+
+
+template <typename NumericT>
+int test_vectors(NumericT epsilon)
+{
+  std::size_t N = 10007;   // not a multiple of the chunk size
+  std::vector<NumericT> y(N), z(N), u(N), v(N), x(N), w(2*N);
+  for (std::size_t i=0; i<N; ++i)
+  {
+    y[i] = random<NumericT>();
+    z[i] = random<NumericT>();
+    u[i] = random<NumericT>();
+    v[i] = NumericT(1) + random<NumericT>();
+  }
+  for (std::size_t i=0; i<w.size(); ++i)
+    w[i] = random<NumericT>();
+
+  viennacl::vector<NumericT> vcl_x(N), vcl_y(N), vcl_z(N), vcl_u(N), vcl_v(N), vcl_w(2*N);
+  viennacl::copy(y, vcl_y);
+  viennacl::copy(z, vcl_z);
+  viennacl::copy(u, vcl_u);
+  viennacl::copy(v, vcl_v);
+  viennacl::copy(w, vcl_w);
+
+  NumericT a = NumericT(2.5);
+  NumericT b = NumericT(-0.75);
+  viennacl::scalar<NumericT> c = NumericT(3);
+
+  std::cout << "x = a*y + b*z - c*element_prod(u, v)... " << std::endl;
+  {
+    for (std::size_t i=0; i<N; ++i)
+      x[i] = a * y[i] + b * z[i] - NumericT(3) * u[i] * v[i];
+    viennacl::scheduler::statement s(vcl_x, viennacl::op_assign(), a * vcl_y + b * vcl_z - c * viennacl::linalg::element_prod(vcl_u, vcl_v));
+    if (!run(s, true) || !check(x, vcl_x, epsilon))
+      return EXIT_FAILURE;
+  }
+
+  std::cout << "x += element_exp(y) / c - element_div(z, v)... " << std::endl;
+  {
+    for (std::size_t i=0; i<N; ++i)
+      x[i] += std::exp(y[i]) / NumericT(3) - z[i] / v[i];
+    viennacl::scheduler::statement s(vcl_x, viennacl::op_inplace_add(), viennacl::linalg::element_exp(vcl_y) / c - viennacl::linalg::element_div(vcl_z, vcl_v));
+    if (!run(s, true) || !check(x, vcl_x, epsilon))
+      return EXIT_FAILURE;
+  }
+
+  std::cout << "x -= element_sqrt(element_fabs(x) + v)... " << std::endl;
+  {
+    for (std::size_t i=0; i<N; ++i)
+      x[i] -= std::sqrt(std::fabs(x[i]) + v[i]);
+    viennacl::scheduler::statement s(vcl_x, viennacl::op_inplace_sub(), viennacl::linalg::element_sqrt(viennacl::linalg::element_fabs(vcl_x) + vcl_v));
+    if (!run(s, true) || !check(x, vcl_x, epsilon))
+      return EXIT_FAILURE;
+  }
+
+  std::cout << "Ranges and slices... " << std::endl;
+  {
+    viennacl::range r(3, N + 3);
+    viennacl::slice sl(1, 2, N);
+    viennacl::vector_range<viennacl::vector<NumericT> > w_range(vcl_w, r);
+    viennacl::vector_slice<viennacl::vector<NumericT> > w_slice(vcl_w, sl);
+    for (std::size_t i=0; i<N; ++i)
+      x[i] = a * w[1 + 2*i] + y[i] * w[3 + i];
+    viennacl::scheduler::statement s(vcl_x, viennacl::op_assign(), a * w_slice + viennacl::linalg::element_prod(vcl_y, w_range));
+    if (!run(s, true) || !check(x, vcl_x, epsilon))
+      return EXIT_FAILURE;
+
+    // operands sharing the buffer of the result with a different access pattern are left to the default implementation:
+    viennacl::vector_slice<viennacl::vector<NumericT> > w_even(vcl_w, viennacl::slice(0, 2, N));
+    std::vector<NumericT> w_ref(w);
+    for (std::size_t i=0; i<N; ++i)
+      w_ref[1 + 2*i] = w[2*i] + y[i];
+    viennacl::scheduler::statement s2(w_slice, viennacl::op_assign(), w_even + vcl_y);
+    if (!run(s2, false) || !check(w_ref, vcl_w, epsilon))
+      return EXIT_FAILURE;
+    w = w_ref;
+  }
+
+  std::cout << "Reductions of expressions... " << std::endl;
+  {
+    viennacl::scalar<NumericT> result = 0;
+    NumericT ref_ip = 0, ref_1 = 0, ref_2 = 0, ref_inf = 0;
+    for (std::size_t i=0; i<N; ++i)
+    {
+      ref_ip  += (y[i] + z[i]) * (u[i] - a * v[i]);
+      ref_1   += std::fabs(y[i] - a * z[i]);
+      ref_2   += (y[i] - a * z[i]) * (y[i] - a * z[i]);
+      ref_inf  = std::max(ref_inf, std::fabs(y[i] - a * z[i]));
+    }
+    ref_2 = std::sqrt(ref_2);
+
+    viennacl::scheduler::statement s_ip(result, viennacl::op_assign(), viennacl::linalg::inner_prod(vcl_y + vcl_z, vcl_u - a * vcl_v));
+    if (!run(s_ip, true) || !check(ref_ip, NumericT(result), epsilon))
+      return EXIT_FAILURE;
+
+    viennacl::scheduler::statement s_1(result, viennacl::op_assign(), viennacl::linalg::norm_1(vcl_y - a * vcl_z));
+    if (!run(s_1, true) || !check(ref_1, NumericT(result), epsilon))
+      return EXIT_FAILURE;
+
+    viennacl::scheduler::statement s_2(result, viennacl::op_assign(), viennacl::linalg::norm_2(vcl_y - a * vcl_z));
+    if (!run(s_2, true) || !check(ref_2, NumericT(result), epsilon))
+      return EXIT_FAILURE;
+
+    viennacl::scheduler::statement s_inf(result, viennacl::op_assign(), viennacl::linalg::norm_inf(vcl_y - a * vcl_z));
+    if (!run(s_inf, true) || !check(ref_inf, NumericT(result), epsilon))
+      return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
+
+
+template <typename NumericT>
+int test_matrices(NumericT epsilon)
+{
+  std::size_t M = 67, N = 131;
+  std::vector<std::vector<NumericT> > A(M, std::vector<NumericT>(N)), B(M, std::vector<NumericT>(N)), C(M, std::vector<NumericT>(N));
+  std::vector<std::vector<NumericT> > big(M + 5, std::vector<NumericT>(N + 7));
+  for (std::size_t i=0; i<M; ++i)
+    for (std::size_t j=0; j<N; ++j)
+    {
+      B[i][j] = random<NumericT>();
+      C[i][j] = NumericT(1) + random<NumericT>();
+    }
+  for (std::size_t i=0; i<big.size(); ++i)
+    for (std::size_t j=0; j<big[i].size(); ++j)
+      big[i][j] = random<NumericT>();
+
+  viennacl::matrix<NumericT, viennacl::row_major>    vcl_A(M, N), vcl_B(M, N);
+  viennacl::matrix<NumericT, viennacl::column_major> vcl_C(M, N), vcl_big(M + 5, N + 7);
+  viennacl::copy(B, vcl_B);
+  viennacl::copy(C, vcl_C);
+  viennacl::copy(big, vcl_big);
+
+  NumericT a = NumericT(1.5);
+
+  std::cout << "A = a*C - element_div(B, element_exp(B)) (mixed layouts)... " << std::endl;
+  {
+    for (std::size_t i=0; i<M; ++i)
+      for (std::size_t j=0; j<N; ++j)
+        A[i][j] = a * C[i][j] - B[i][j] / std::exp(B[i][j]);
+    viennacl::scheduler::statement s(vcl_A, viennacl::op_assign(), a * vcl_C - viennacl::linalg::element_div(vcl_B, viennacl::linalg::element_exp(vcl_B)));
+    if (!run(s, true) || !check(A, vcl_A, epsilon))
+      return EXIT_FAILURE;
+  }
+
+  std::cout << "C += element_log(C) + B / a (mixed layouts)... " << std::endl;
+  {
+    for (std::size_t i=0; i<M; ++i)
+      for (std::size_t j=0; j<N; ++j)
+        C[i][j] += std::log(C[i][j]) + B[i][j] / a;
+    viennacl::scheduler::statement s(vcl_C, viennacl::op_inplace_add(), viennacl::linalg::element_log(vcl_C) + vcl_B / a);
+    if (!run(s, true) || !check(C, vcl_C, epsilon))
+      return EXIT_FAILURE;
+  }
+
+  std::cout << "Matrix ranges and slices... " << std::endl;
+  {
+    viennacl::matrix_range<viennacl::matrix<NumericT, viennacl::column_major> > big_range(vcl_big, viennacl::range(5, M + 5), viennacl::range(7, N + 7));
+    viennacl::matrix_slice<viennacl::matrix<NumericT, viennacl::column_major> > big_slice(vcl_big, viennacl::slice(0, 1, M), viennacl::slice(1, 1, N));
+    for (std::size_t i=0; i<M; ++i)
+      for (std::size_t j=0; j<N; ++j)
+        A[i][j] = big[i][j+1] * big[i+5][j+7] - B[i][j];
+    viennacl::scheduler::statement s(vcl_A, viennacl::op_assign(), viennacl::linalg::element_prod(big_slice, big_range) - vcl_B);
+    if (!run(s, true) || !check(A, vcl_A, epsilon))
+      return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
+
+
+int main()
+{
+  std::cout << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "## Test :: Fused Scheduler Statements" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+
+  std::cout << "# Testing setup: float" << std::endl;
+  if (test_vectors<float>(1e-4f) != EXIT_SUCCESS || test_matrices<float>(1e-4f) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+#ifdef VIENNACL_WITH_OPENCL
+  if (viennacl::ocl::current_device().double_support())
+#endif
+  {
+    std::cout << "# Testing setup: double" << std::endl;
+    if (test_vectors<double>(1e-12) != EXIT_SUCCESS || test_matrices<double>(1e-12) != EXIT_SUCCESS)
+      return EXIT_FAILURE;
+  }
+
+  std::cout << std::endl;
+  std::cout << "------- Test completed --------" << std::endl;
+  std::cout << std::endl;
+
+  return EXIT_SUCCESS;
+}
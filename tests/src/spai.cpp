@@ -0,0 +1,388 @@
+/* =========================================================================
+   Copyright (c) 2010-2013, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+//
+// *** System
+//
+#include <iostream>
+#include <vector>
+#include <map>
+#include <cmath>
+#include <cstdlib>
+#include <algorithm>
+
+//
+// *** Boost
+//
+#include <boost/numeric/ublas/matrix_sparse.hpp>
+
+//
+// *** ViennaCL
+//
+#include "viennacl/compressed_matrix.hpp"
+#include "viennacl/vector.hpp"
+#include "viennacl/linalg/prod.hpp"
+#include "viennacl/linalg/cg.hpp"
+#include "viennacl/linalg/bicgstab.hpp"
+#include "viennacl/linalg/spai.hpp"
+
+//
+// -------------------------------------------------------------
+//
+
+typedef std::vector<std::map<unsigned int, double> >   HostMatrixType;
+
+/** @brief Creates a convection-diffusion operator on an nx-by-ny grid (nonsymmetric unless convection == 0) */
+void make_grid_operator(std::size_t nx, std::size_t ny, double convection, HostMatrixType & A)
+{
+  A.clear();
+  A.resize(nx * ny);
+  for (std::size_t x=0; x<nx; ++x)
+    for (std::size_t y=0; y<ny; ++y)
+    {
+      unsigned int i = static_cast<unsigned int>(x * ny + y);
+      A[i][i] = 4.0;
+      if (x > 0)    A[i][i - ny] = -1.0 - convection;
+      if (x+1 < nx) A[i][i + ny] = -1.0 + convection;
+      if (y > 0)    A[i][i - 1]  = -1.0;
+      if (y+1 < ny) A[i][i + 1]  = -1.0;
+    }
+}
+
+HostMatrixType transposed(HostMatrixType const & A)
+{
+  HostMatrixType At(A.size());
+  for (std::size_t i=0; i<A.size(); ++i)
+    for (std::map<unsigned int, double>::const_iterator it = A[i].begin(); it != A[i].end(); ++it)
+      At[it->first][static_cast<unsigned int>(i)] = it->second;
+  return At;
+}
+
+/** @brief Reference solution of the SPAI least squares problem min || A(:, J) m - e_k || via the normal equations. A_cols holds the columns of A. */
+std::vector<double> reference_column(HostMatrixType const & A_cols, std::vector<unsigned int> const & J, unsigned int k)
+{
+  std::size_t n = J.size();
+  std::vector<double> N(n * n), m(n);
+  for (std::size_t i=0; i<n; ++i)
+  {
+    std::map<unsigned int, double> const & col_i = A_cols[J[i]];
+    std::map<unsigned int, double>::const_iterator it_k = col_i.find(k);
+    m[i] = (it_k != col_i.end()) ? it_k->second : 0;
+    for (std::size_t j=0; j<n; ++j)
+    {
+      std::map<unsigned int, double> const & col_j = A_cols[J[j]];
+      for (std::map<unsigned int, double>::const_iterator it = col_i.begin(); it != col_i.end(); ++it)
+      {
+        std::map<unsigned int, double>::const_iterator it2 = col_j.find(it->first);
+        if (it2 != col_j.end())
+          N[i * n + j] += it->second * it2->second;
+      }
+    }
+  }
+
+  // Gaussian elimination (N is symmetric positive definite):
+  for (std::size_t c=0; c<n; ++c)
+    for (std::size_t i=c+1; i<n; ++i)
+    {
+      double factor = N[i * n + c] / N[c * n + c];
+      for (std::size_t j=c; j<n; ++j)
+        N[i * n + j] -= factor * N[c * n + j];
+      m[i] -= factor * m[c];
+    }
+  for (std::size_t i=n; i-- > 0; )
+  {
+    for (std::size_t j=i+1; j<n; ++j)
+      m[i] -= N[i * n + j] * m[j];
+    m[i] /= N[i * n + i];
+  }
+  return m;
+}
+
+/** @brief Returns || A_cols M_cols[k] - e_k || */
+double column_residual(HostMatrixType const & A_cols, HostMatrixType const & M_cols, unsigned int k)
+{
+  std::map<unsigned int, double> r;
+  r[k] = -1.0;
+  for (std::map<unsigned int, double>::const_iterator it = M_cols[k].begin(); it != M_cols[k].end(); ++it)
+    for (std::map<unsigned int, double>::const_iterator it2 = A_cols[it->first].begin(); it2 != A_cols[it->first].end(); ++it2)
+      r[it2->first] += it2->second * it->second;
+
+  double norm = 0;
+  for (std::map<unsigned int, double>::const_iterator it = r.begin(); it != r.end(); ++it)
+    norm += it->second * it->second;
+  return std::sqrt(norm);
+}
+
+/** @brief Computes the SPAI for A in main memory and copies the result to M */
+template <unsigned int AlignmentV>
+void compute_host_spai(HostMatrixType const & host_A, viennacl::linalg::spai_tag const & tag, HostMatrixType & M)
+{
+  viennacl::context host_ctx(viennacl::MAIN_MEMORY);
+  viennacl::compressed_matrix<double, AlignmentV> A(host_A.size(), host_A.size(), host_ctx);
+  viennacl::compressed_matrix<double, AlignmentV> M_vcl(host_A.size(), host_A.size(), host_ctx);
+  viennacl::copy(host_A, A);
+
+  viennacl::linalg::detail::spai::compute_spai_host(A, M_vcl, tag);
+
+  M.clear();
+  M.resize(host_A.size());
+  viennacl::copy(M_vcl, M);
+}
+
+/** @brief Checks the static SPAI against the reference least squares solution on the pattern of A */
+template <unsigned int AlignmentV>
+int test_static_spai(HostMatrixType const & host_A, bool is_right)
+{
+  std::cout << "* static SPAI, " << (is_right ? "right" : "left") << " preconditioner, alignment " << AlignmentV << std::endl;
+
+  HostMatrixType M;
+  compute_host_spai<AlignmentV>(host_A, viennacl::linalg::spai_tag(1e-3, 5, 1e-2, true, is_right), M);
+
+  // For a left preconditioner M A ~ I, the rows of M are the columns of the approximate inverse of A^T:
+  HostMatrixType A_cols  = is_right ? transposed(host_A) : host_A;
+  HostMatrixType M_cols  = is_right ? transposed(M) : M;
+  HostMatrixType pattern = is_right ? transposed(host_A) : host_A;  // the pattern of M is the pattern of A
+
+  for (std::size_t k=0; k<host_A.size(); ++k)
+  {
+    std::vector<unsigned int> J;
+    for (std::map<unsigned int, double>::const_iterator it = pattern[k].begin(); it != pattern[k].end(); ++it)
+      J.push_back(it->first);
+    std::vector<double> m_ref = reference_column(A_cols, J, static_cast<unsigned int>(k));
+
+    if (M_cols[k].size() != J.size())
+    {
+      std::cout << "# Error: Wrong pattern in column " << k << ": " << M_cols[k].size() << " vs. " << J.size() << " entries" << std::endl;
+      return EXIT_FAILURE;
+    }
+    for (std::size_t i=0; i<J.size(); ++i)
+    {
+      double value = M_cols[k][J[i]];
+      if (std::fabs(value - m_ref[i]) > 1e-10 * std::max(1.0, std::fabs(m_ref[i])))
+      {
+        std::cout << "# Error: Entry " << J[i] << " of column " << k << " differs from reference: " << value << " vs. " << m_ref[i] << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
+
+/** @brief Checks that the dynamic pattern update reduces the residuals of the static SPAI */
+int test_dynamic_spai(HostMatrixType const & host_A, bool is_right)
+{
+  std::cout << "* dynamic SPAI, " << (is_right ? "right" : "left") << " preconditioner" << std::endl;
+
+  HostMatrixType M_static, M_dynamic;
+  compute_host_spai<1>(host_A, viennacl::linalg::spai_tag(1e-3, 5, 1e-2, true,  is_right), M_static);
+  compute_host_spai<1>(host_A, viennacl::linalg::spai_tag(1e-3, 5, 1e-2, false, is_right), M_dynamic);
+
+  HostMatrixType A_cols         = is_right ? transposed(host_A) : host_A;
+  HostMatrixType M_static_cols  = is_right ? transposed(M_static) : M_static;
+  HostMatrixType M_dynamic_cols = is_right ? transposed(M_dynamic) : M_dynamic;
+
+  double frobenius_static = 0, frobenius_dynamic = 0;
+  std::size_t nnz_static = 0, nnz_dynamic = 0;
+  for (std::size_t k=0; k<host_A.size(); ++k)
+  {
+    double res_static  = column_residual(A_cols, M_static_cols,  static_cast<unsigned int>(k));
+    double res_dynamic = column_residual(A_cols, M_dynamic_cols, static_cast<unsigned int>(k));
+    if (res_dynamic > res_static * (1.0 + 1e-10))
+    {
+      std::cout << "# Error: Dynamic pattern increases residual of column " << k << ": " << res_dynamic << " vs. " << res_static << std::endl;
+      return EXIT_FAILURE;
+    }
+    frobenius_static  += res_static * res_static;
+    frobenius_dynamic += res_dynamic * res_dynamic;
+    nnz_static  += M_static_cols[k].size();
+    nnz_dynamic += M_dynamic_cols[k].size();
+  }
+
+  std::cout << "  ||AM - I||_F: " << std::sqrt(frobenius_static) << " (" << nnz_static << " nonzeros) -> "
+                                  << std::sqrt(frobenius_dynamic) << " (" << nnz_dynamic << " nonzeros)" << std::endl;
+  if (nnz_dynamic <= nnz_static || frobenius_dynamic > 0.5 * frobenius_static)
+  {
+    std::cout << "# Error: Pattern update did not improve the approximate inverse" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
+
+/** @brief Checks that the preconditioners reduce the number of solver iterations for a system in main memory */
+int test_solvers()
+{
+  std::cout << "* preconditioned solvers" << std::endl;
+
+  viennacl::context host_ctx(viennacl::MAIN_MEMORY);
+  std::size_t nx = 40, ny = 40;
+  std::size_t n = nx * ny;
+
+  HostMatrixType host_A;
+  make_grid_operator(nx, ny, 0.5, host_A);
+  viennacl::compressed_matrix<double> A(n, n, host_ctx);
+  viennacl::copy(host_A, A);
+
+  viennacl::vector<double> rhs = viennacl::scalar_vector<double>(n, 1.0, host_ctx);
+
+  viennacl::linalg::bicgstab_tag bicgstab_tag(1e-8, 1000);
+  viennacl::vector<double> x = viennacl::linalg::solve(A, rhs, bicgstab_tag);
+  std::size_t iters_plain = bicgstab_tag.iters();
+
+  viennacl::linalg::spai_precond<viennacl::compressed_matrix<double> > spai(A, viennacl::linalg::spai_tag(1e-3, 3, 5e-2));
+  x = viennacl::linalg::solve(A, rhs, bicgstab_tag, spai);
+  std::size_t iters_spai = bicgstab_tag.iters();
+
+  viennacl::vector<double> residual = viennacl::linalg::prod(A, x);
+  residual -= rhs;
+  std::cout << "  BiCGStab iterations: " << iters_plain << " -> " << iters_spai << " with SPAI, relative residual " << viennacl::linalg::norm_2(residual) / viennacl::linalg::norm_2(rhs) << std::endl;
+  if (iters_spai >= iters_plain || viennacl::linalg::norm_2(residual) > 1e-6 * viennacl::linalg::norm_2(rhs))
+  {
+    std::cout << "# Error: SPAI-preconditioned BiCGStab failed" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  HostMatrixType host_B;
+  make_grid_operator(nx, ny, 0.0, host_B);
+  viennacl::compressed_matrix<double> B(n, n, host_ctx);
+  viennacl::copy(host_B, B);
+
+  viennacl::linalg::cg_tag cg_tag(1e-8, 1000);
+  x = viennacl::linalg::solve(B, rhs, cg_tag);
+  std::size_t iters_cg = cg_tag.iters();
+
+  viennacl::linalg::fspai_precond<viennacl::compressed_matrix<double> > fspai(B, viennacl::linalg::fspai_tag());
+  x = viennacl::linalg::solve(B, rhs, cg_tag, fspai);
+  std::size_t iters_fspai = cg_tag.iters();
+
+  residual = viennacl::linalg::prod(B, x);
+  residual -= rhs;
+  std::cout << "  CG iterations: " << iters_cg << " -> " << iters_fspai << " with FSPAI, relative residual " << viennacl::linalg::norm_2(residual) / viennacl::linalg::norm_2(rhs) << std::endl;
+  if (iters_fspai >= iters_cg || viennacl::linalg::norm_2(residual) > 1e-6 * viennacl::linalg::norm_2(rhs))
+  {
+    std::cout << "# Error: FSPAI-preconditioned CG failed" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
+
+/** @brief Checks the defining equations of FSPAI: (A L)(J_k, k) = 0 and L(k, k) (A L)(k, k) = 1. Also compares with the uBLAS-based setup. */
+int test_fspai(HostMatrixType const & host_A)
+{
+  std::cout << "* FSPAI" << std::endl;
+
+  std::size_t n = host_A.size();
+  viennacl::context host_ctx(viennacl::MAIN_MEMORY);
+  viennacl::compressed_matrix<double> A(n, n, host_ctx);
+  viennacl::compressed_matrix<double> L_vcl(n, n, host_ctx);
+  viennacl::compressed_matrix<double> L_trans_vcl(n, n, host_ctx);
+  viennacl::copy(host_A, A);
+  viennacl::linalg::detail::spai::compute_fspai_host(A, L_vcl, L_trans_vcl);
+
+  HostMatrixType L(n), L_trans(n);
+  viennacl::copy(L_vcl, L);
+  viennacl::copy(L_trans_vcl, L_trans);
+  if (transposed(L) != L_trans)
+  {
+    std::cout << "# Error: L_trans is not the transpose of L" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  HostMatrixType L_cols = transposed(L);
+  for (std::size_t k=0; k<n; ++k)
+  {
+    // (A L)(:, k):
+    std::map<unsigned int, double> AL_k;
+    for (std::map<unsigned int, double>::const_iterator it = L_cols[k].begin(); it != L_cols[k].end(); ++it)
+    {
+      if (it->first < k)
+      {
+        std::cout << "# Error: L is not lower triangular in column " << k << std::endl;
+        return EXIT_FAILURE;
+      }
+      for (std::map<unsigned int, double>::const_iterator it2 = host_A[it->first].begin(); it2 != host_A[it->first].end(); ++it2)
+        AL_k[it2->first] += it2->second * it->second;   // A is symmetric
+    }
+
+    for (std::map<unsigned int, double>::const_iterator it = L_cols[k].begin(); it != L_cols[k].end(); ++it)
+    {
+      double expected = (it->first == k) ? 1.0 / it->second : 0.0;
+      if (std::fabs(AL_k[it->first] - expected) > 1e-10)
+      {
+        std::cout << "# Error: FSPAI equation violated at (" << it->first << ", " << k << "): " << AL_k[it->first] << " vs. " << expected << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+
+  // uBLAS-based setup:
+  boost::numeric::ublas::compressed_matrix<double> ublas_A(n, n), ublas_L(n, n), ublas_L_trans(n, n);
+  viennacl::copy(A, ublas_A);
+  viennacl::linalg::detail::spai::computeFSPAI(ublas_A, ublas_A, ublas_L, ublas_L_trans, viennacl::linalg::fspai_tag());
+  for (std::size_t i=0; i<n; ++i)
+    for (std::map<unsigned int, double>::const_iterator it = L[i].begin(); it != L[i].end(); ++it)
+      if (std::fabs(ublas_L(i, it->first) - it->second) > 1e-10)
+      {
+        std::cout << "# Error: Host-based FSPAI differs from uBLAS-based FSPAI at (" << i << ", " << it->first << ")" << std::endl;
+        return EXIT_FAILURE;
+      }
+
+  return EXIT_SUCCESS;
+}
+
+
+int main()
+{
+  std::cout << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "## Test :: SPAI and FSPAI Preconditioners" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << std::endl;
+
+  HostMatrixType A;
+  make_grid_operator(15, 12, 0.3, A);
+
+  if (test_static_spai<1>(A, true) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+  if (test_static_spai<1>(A, false) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+  if (test_static_spai<4>(A, false) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  if (test_dynamic_spai(A, true) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+  if (test_dynamic_spai(A, false) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  HostMatrixType B;
+  make_grid_operator(15, 12, 0.0, B);
+  if (test_fspai(B) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  if (test_solvers() != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  std::cout << std::endl;
+  std::cout << "------- Test completed --------" << std::endl;
+  std::cout << std::endl;
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,255 @@
+/* =========================================================================
+   Copyright (c) 2010-2013, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+//
+// *** System
+//
+#include <iostream>
+#include <vector>
+#include <map>
+#include <cmath>
+#include <cstdlib>
+
+//
+// *** ViennaCL
+//
+#include "viennacl/compressed_matrix.hpp"
+#include "viennacl/vector.hpp"
+#include "viennacl/linalg/prod.hpp"
+#include "viennacl/tools/sparse_matrix_builder.hpp"
+
+//
+// -------------------------------------------------------------
+//
+typedef std::vector< std::map<unsigned int, double> >   stl_matrix_type;
+
+/** @brief Compares a compressed_matrix with a reference in std::vector<std::map<> > format by means of a matrix-vector product with a vector of ones */
+template <typename NumericT, unsigned int AlignmentV>
+bool check(stl_matrix_type const & reference, std::size_t cols, viennacl::compressed_matrix<NumericT, AlignmentV> const & vcl_A, NumericT epsilon)
+{
+  if (vcl_A.size1() != reference.size() || vcl_A.size2() != cols)
+  {
+    std::cout << "# Error: Size mismatch: " << vcl_A.size1() << "x" << vcl_A.size2() << " vs. " << reference.size() << "x" << cols << std::endl;
+    return false;
+  }
+
+  //entries:
+  std::vector< std::map<unsigned int, NumericT> > from_vcl(vcl_A.size1());
+  viennacl::tools::sparse_matrix_adapter<NumericT> adapted_from_vcl(from_vcl, vcl_A.size1(), vcl_A.size2());
+  viennacl::copy(vcl_A, adapted_from_vcl);
+  for (std::size_t i=0; i<reference.size(); ++i)
+  {
+    for (std::map<unsigned int, double>::const_iterator it = reference[i].begin(); it != reference[i].end(); ++it)
+    {
+      NumericT entry = from_vcl[i].count(it->first) ? from_vcl[i][it->first] : NumericT(0);
+      if (std::fabs(entry - it->second) > epsilon * std::max(1.0, std::fabs(it->second)))
+      {
+        std::cout << "# Error at entry (" << i << ", " << it->first << "): " << entry << " vs. " << it->second << std::endl;
+        return false;
+      }
+    }
+    for (typename std::map<unsigned int, NumericT>::const_iterator it = from_vcl[i].begin(); it != from_vcl[i].end(); ++it)
+      if (reference[i].count(it->first) == 0)
+      {
+        std::cout << "# Error: Additional entry (" << i << ", " << it->first << ")" << std::endl;
+        return false;
+      }
+  }
+
+  //matrix-vector product, which also covers alignment padding:
+  std::vector<NumericT> x(cols), y(reference.size());
+  for (std::size_t j=0; j<cols; ++j)
+    x[j] = NumericT(1) + NumericT(j % 7);
+  viennacl::vector<NumericT> vcl_x(cols), vcl_y(reference.size());
+  viennacl::copy(x, vcl_x);
+  vcl_y = viennacl::linalg::prod(vcl_A, vcl_x);
+  viennacl::copy(vcl_y, y);
+  for (std::size_t i=0; i<reference.size(); ++i)
+  {
+    double ref = 0;
+    for (std::map<unsigned int, double>::const_iterator it = reference[i].begin(); it != reference[i].end(); ++it)
+      ref += it->second * x[it->first];
+    if (std::fabs(y[i] - ref) > epsilon * std::max(1.0, std::fabs(ref)) * 10)
+    {
+      std::cout << "# Error in matrix-vector product at row " << i << ": " << y[i] << " vs. " << ref << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+/** @brief Creates triplets of a 1D finite element stiffness-like matrix with element contributions (duplicates), some empty rows, and random order */
+template <typename NumericT>
+void make_triplets(std::size_t rows, std::size_t cols,
+                   std::vector<unsigned int> & row_indices, std::vector<unsigned int> & col_indices, std::vector<NumericT> & values,
+                   stl_matrix_type & reference, int seed)
+{
+  std::srand(static_cast<unsigned int>(seed));
+  row_indices.clear();
+  col_indices.clear();
+  values.clear();
+  reference.clear();
+  reference.resize(rows);
+
+  for (std::size_t e=0; e+1<rows; ++e)
+  {
+    if (e % 10 == 3)   //leave some rows empty
+      continue;
+    std::size_t nodes[2] = { e, e + 1 };
+    for (std::size_t a=0; a<2; ++a)
+      for (std::size_t b=0; b<2; ++b)
+      {
+        std::size_t col = (nodes[b] * 3) % cols;
+        NumericT value = NumericT(1 + std::rand() % 100) / NumericT(10);
+        row_indices.push_back(static_cast<unsigned int>(nodes[a]));
+        col_indices.push_back(static_cast<unsigned int>(col));
+        values.push_back(value);
+        reference[nodes[a]][static_cast<unsigned int>(col)] += value;
+      }
+  }
+
+  //shuffle the triplets:
+  for (std::size_t k=row_indices.size(); k > 1; --k)
+  {
+    std::size_t other = static_cast<std::size_t>(std::rand()) % k;
+    std::swap(row_indices[k-1], row_indices[other]);
+    std::swap(col_indices[k-1], col_indices[other]);
+    std::swap(values[k-1], values[other]);
+  }
+}
+
+template <typename NumericT>
+int test(NumericT epsilon)
+{
+  std::size_t rows = 1000;
+  std::size_t cols = 800;
+
+  std::vector<unsigned int> row_indices, col_indices;
+  std::vector<NumericT> values;
+  stl_matrix_type reference;
+  make_triplets(rows, cols, row_indices, col_indices, values, reference, 42);
+
+  std::cout << "* Assembly via compressed_matrix::assemble()" << std::endl;
+  viennacl::compressed_matrix<NumericT> vcl_A(rows, cols);
+  vcl_A.assemble(row_indices, col_indices, values);
+  if (!check(reference, cols, vcl_A, epsilon))
+    return EXIT_FAILURE;
+
+  std::cout << "* Reassembly with new values" << std::endl;
+  viennacl::tools::sparse_matrix_builder builder(rows, cols, row_indices, col_indices);
+  builder.assemble(values, vcl_A);
+  std::vector<NumericT> new_values(values.size());
+  stl_matrix_type new_reference(rows);
+  for (std::size_t k=0; k<values.size(); ++k)
+  {
+    new_values[k] = NumericT(2) * values[k] - NumericT(k % 3);
+    new_reference[row_indices[k]][col_indices[k]] += new_values[k];
+  }
+  builder.update(new_values, vcl_A);
+  if (!check(new_reference, cols, vcl_A, epsilon))
+    return EXIT_FAILURE;
+
+  std::cout << "* Assembly with alignment" << std::endl;
+  viennacl::compressed_matrix<NumericT, 4> vcl_A_aligned(rows, cols);
+  vcl_A_aligned.assemble(row_indices, col_indices, values);
+  if (!check(reference, cols, vcl_A_aligned, epsilon))
+    return EXIT_FAILURE;
+
+  std::cout << "* Assembly without triplets" << std::endl;
+  viennacl::compressed_matrix<NumericT> vcl_empty(rows, cols);
+  vcl_empty.assemble(std::vector<unsigned int>(), std::vector<unsigned int>(), std::vector<NumericT>());
+  if (!check(stl_matrix_type(rows), cols, vcl_empty, epsilon))
+    return EXIT_FAILURE;
+
+  std::cout << "* Resize with preservation of entries" << std::endl;
+  vcl_A.assemble(row_indices, col_indices, values);
+  vcl_A.resize(rows / 2, cols / 3, true);
+  stl_matrix_type small_reference(rows / 2);
+  for (std::size_t i=0; i<rows / 2; ++i)
+    for (std::map<unsigned int, double>::const_iterator it = reference[i].begin(); it != reference[i].end(); ++it)
+      if (it->first < cols / 3)
+        small_reference[i][it->first] = it->second;
+  if (!check(small_reference, cols / 3, vcl_A, epsilon))
+    return EXIT_FAILURE;
+
+  vcl_A.resize(rows, cols, true);
+  small_reference.resize(rows);
+  if (!check(small_reference, cols, vcl_A, epsilon))
+    return EXIT_FAILURE;
+
+  return EXIT_SUCCESS;
+}
+
+//
+// -------------------------------------------------------------
+//
+int main()
+{
+  std::cout << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "## Test :: Sparse Matrix Assembly" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << std::endl;
+
+  int retval = EXIT_SUCCESS;
+
+  std::cout << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << std::endl;
+  {
+    typedef float NumericT;
+    NumericT epsilon = static_cast<NumericT>(1E-4);
+    std::cout << "# Testing setup:" << std::endl;
+    std::cout << "  eps:     " << epsilon << std::endl;
+    std::cout << "  numeric: float" << std::endl;
+    retval = test<NumericT>(epsilon);
+    if( retval == EXIT_SUCCESS )
+        std::cout << "# Test passed" << std::endl;
+    else
+        return retval;
+  }
+  std::cout << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << std::endl;
+
+#ifdef VIENNACL_WITH_OPENCL
+  if( viennacl::ocl::current_device().double_support() )
+#endif
+  {
+    typedef double NumericT;
+    NumericT epsilon = 1.0E-12;
+    std::cout << "# Testing setup:" << std::endl;
+    std::cout << "  eps:     " << epsilon << std::endl;
+    std::cout << "  numeric: double" << std::endl;
+    retval = test<NumericT>(epsilon);
+    if( retval == EXIT_SUCCESS )
+        std::cout << "# Test passed" << std::endl;
+    else
+        return retval;
+  }
+  std::cout << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << std::endl;
+
+  std::cout << std::endl;
+  std::cout << "------- Test completed --------" << std::endl;
+  std::cout << std::endl;
+
+  return retval;
+}
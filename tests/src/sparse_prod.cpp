@@ -0,0 +1,315 @@
+/* =========================================================================
+   Copyright (c) 2010-2013, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+//
+// *** System
+//
+#include <iostream>
+#include <vector>
+#include <map>
+#include <cmath>
+#include <cstdlib>
+
+//
+// *** ViennaCL
+//
+#include "viennacl/matrix.hpp"
+#include "viennacl/matrix_proxy.hpp"
+#include "viennacl/compressed_matrix.hpp"
+#include "viennacl/coordinate_matrix.hpp"
+#include "viennacl/ell_matrix.hpp"
+#include "viennacl/hyb_matrix.hpp"
+#include "viennacl/vector.hpp"
+#include "viennacl/vector_proxy.hpp"
+#include "viennacl/linalg/prod.hpp"
+#include "viennacl/tools/adapter.hpp"
+
+//
+// -------------------------------------------------------------
+//
+
+/** @brief Creates a matrix with irregular row lengths: empty rows, short rows, and a few long rows (which end up in the CSR part of hyb_matrix) */
+template <typename NumericT>
+void make_matrix(std::size_t size1, std::size_t size2, std::vector<std::map<unsigned int, NumericT> > & A)
+{
+  A.clear();
+  A.resize(size1);
+  for (std::size_t i=0; i<size1; ++i)
+  {
+    std::size_t row_length = (i % 7 == 3) ? 0 : 1 + (i * 13) % 5;
+    if (i % 97 == 5)
+      row_length = 60;
+
+    for (std::size_t k=0; k<row_length; ++k)
+    {
+      unsigned int j = static_cast<unsigned int>((i * 31 + k * 17 + k * k) % size2);
+      A[i][j] += NumericT(1) + NumericT((i + 3 * j) % 11) / NumericT(8);
+    }
+  }
+}
+
+template <typename NumericT>
+bool check(std::vector<NumericT> const & reference, viennacl::vector<NumericT> const & vcl_result, NumericT epsilon, std::string const & name)
+{
+  std::vector<NumericT> result(vcl_result.size());
+  viennacl::copy(vcl_result, result);
+
+  for (std::size_t i=0; i<result.size(); ++i)
+  {
+    if (std::fabs(result[i] - reference[i]) > epsilon * std::max(NumericT(1), std::fabs(reference[i])))
+    {
+      std::cout << "# Error in " << name << " at index " << i << ": " << result[i] << " vs. " << reference[i] << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+/** @brief Compares y = A * x, y = A * x with x and y being vector ranges, y += A * x, and y -= A * x against a reference */
+template <typename NumericT, typename MatrixT>
+bool test_prod(MatrixT const & vcl_A, std::vector<NumericT> const & x, std::vector<NumericT> const & reference, NumericT epsilon, std::string const & name)
+{
+  std::size_t size1 = reference.size();
+  std::size_t size2 = x.size();
+
+  viennacl::vector<NumericT> vcl_x(size2);
+  viennacl::copy(x, vcl_x);
+  viennacl::vector<NumericT> vcl_y(size1);
+
+  vcl_y = viennacl::linalg::prod(vcl_A, vcl_x);
+  if (!check(reference, vcl_y, epsilon, name))
+    return false;
+
+  vcl_y += viennacl::linalg::prod(vcl_A, vcl_x);
+  vcl_y -= viennacl::linalg::prod(vcl_A, vcl_x);
+  if (!check(reference, vcl_y, epsilon, name + " (inplace add/sub)"))
+    return false;
+
+  // ranges:
+  viennacl::vector<NumericT> vcl_x_large(size2 + 7);
+  viennacl::vector<NumericT> vcl_y_large = viennacl::scalar_vector<NumericT>(size1 + 5, NumericT(42));
+  viennacl::range r_x(3, 3 + size2);
+  viennacl::range r_y(2, 2 + size1);
+  viennacl::vector_range<viennacl::vector<NumericT> > vcl_x_range(vcl_x_large, r_x);
+  viennacl::vector_range<viennacl::vector<NumericT> > vcl_y_range(vcl_y_large, r_y);
+  vcl_x_range = vcl_x;
+  vcl_y_range = viennacl::linalg::prod(vcl_A, vcl_x_range);
+  vcl_y = vcl_y_range;
+  if (!check(reference, vcl_y, epsilon, name + " (ranges)"))
+    return false;
+
+  std::vector<NumericT> y_large(size1 + 5);
+  viennacl::copy(vcl_y_large, y_large);
+  if (y_large[0] != NumericT(42) || y_large[1] != NumericT(42) || y_large[size1 + 2] != NumericT(42))
+  {
+    std::cout << "# Error in " << name << ": Entries outside of range modified" << std::endl;
+    return false;
+  }
+
+  return true;
+}
+
+/** @brief Compares C = A * B for a block B of k columns against a reference. Also checks C = A * B for B and C being submatrices. */
+template <typename NumericT, typename F, typename MatrixT>
+bool test_prod_block(MatrixT const & vcl_A, std::vector<std::map<unsigned int, NumericT> > const & A, std::size_t size2, std::size_t k, NumericT epsilon, std::string const & name)
+{
+  std::size_t size1 = A.size();
+
+  std::vector<std::vector<NumericT> > B(size2, std::vector<NumericT>(k));
+  for (std::size_t i=0; i<size2; ++i)
+    for (std::size_t j=0; j<k; ++j)
+      B[i][j] = NumericT(1) + NumericT((i + 5 * j) % 13) / NumericT(4);
+
+  std::vector<std::vector<NumericT> > reference(size1, std::vector<NumericT>(k));
+  for (std::size_t i=0; i<size1; ++i)
+    for (typename std::map<unsigned int, NumericT>::const_iterator it = A[i].begin(); it != A[i].end(); ++it)
+      for (std::size_t j=0; j<k; ++j)
+        reference[i][j] += it->second * B[it->first][j];
+
+  viennacl::matrix<NumericT, F> vcl_B(size2, k);
+  viennacl::copy(B, vcl_B);
+  viennacl::matrix<NumericT, F> vcl_C(size1, k);
+
+  // submatrices:
+  viennacl::matrix<NumericT, F> vcl_B_large(size2 + 3, k + 4);
+  viennacl::matrix<NumericT, F> vcl_C_large(size1 + 2, k + 3);
+  viennacl::range r_B1(1, 1 + size2), r_B2(2, 2 + k);
+  viennacl::range r_C1(2, 2 + size1), r_C2(1, 1 + k);
+  viennacl::matrix_range<viennacl::matrix<NumericT, F> > vcl_B_range(vcl_B_large, r_B1, r_B2);
+  viennacl::matrix_range<viennacl::matrix<NumericT, F> > vcl_C_range(vcl_C_large, r_C1, r_C2);
+  vcl_B_range = vcl_B;
+
+  for (std::size_t pass = 0; pass < 2; ++pass)
+  {
+    if (pass == 0)
+      vcl_C = viennacl::linalg::prod(vcl_A, vcl_B);
+    else
+    {
+      vcl_C_range = viennacl::linalg::prod(vcl_A, vcl_B_range);
+      vcl_C = vcl_C_range;
+    }
+
+    std::vector<std::vector<NumericT> > C(size1, std::vector<NumericT>(k));
+    viennacl::copy(vcl_C, C);
+    for (std::size_t i=0; i<size1; ++i)
+      for (std::size_t j=0; j<k; ++j)
+        if (std::fabs(C[i][j] - reference[i][j]) > epsilon * std::max(NumericT(1), std::fabs(reference[i][j])))
+        {
+          std::cout << "# Error in " << name << " with " << k << " columns" << (pass > 0 ? " (submatrices)" : "")
+                    << " at (" << i << ", " << j << "): " << C[i][j] << " vs. " << reference[i][j] << std::endl;
+          return false;
+        }
+  }
+
+  return true;
+}
+
+template <typename NumericT>
+int test(NumericT epsilon)
+{
+  std::size_t sizes1[] = {1, 5, 63, 1000, 4321};
+  std::size_t sizes2[] = {1, 7, 64, 1000, 3000};
+
+  for (std::size_t s=0; s<sizeof(sizes1)/sizeof(std::size_t); ++s)
+  {
+    std::size_t size1 = sizes1[s];
+    std::size_t size2 = sizes2[s];
+    std::cout << "* Size " << size1 << " x " << size2 << std::endl;
+
+    std::vector<std::map<unsigned int, NumericT> > A;
+    make_matrix(size1, size2, A);
+
+    std::vector<NumericT> x(size2);
+    for (std::size_t i=0; i<size2; ++i)
+      x[i] = NumericT(1) + NumericT(i % 13) / NumericT(4);
+
+    std::vector<NumericT> reference(size1);
+    for (std::size_t i=0; i<size1; ++i)
+      for (typename std::map<unsigned int, NumericT>::const_iterator it = A[i].begin(); it != A[i].end(); ++it)
+        reference[i] += it->second * x[it->first];
+
+    viennacl::tools::const_sparse_matrix_adapter<NumericT> adapted_A(A, size1, size2);
+
+    viennacl::compressed_matrix<NumericT> vcl_compressed(size1, size2);
+    viennacl::copy(adapted_A, vcl_compressed);
+    if (!test_prod(vcl_compressed, x, reference, epsilon, "compressed_matrix"))
+      return EXIT_FAILURE;
+
+    viennacl::coordinate_matrix<NumericT> vcl_coordinate(size1, size2);
+    viennacl::copy(adapted_A, vcl_coordinate);
+    if (!test_prod(vcl_coordinate, x, reference, epsilon, "coordinate_matrix"))
+      return EXIT_FAILURE;
+
+    viennacl::ell_matrix<NumericT> vcl_ell;
+    viennacl::copy(adapted_A, vcl_ell);
+    if (!test_prod(vcl_ell, x, reference, epsilon, "ell_matrix"))
+      return EXIT_FAILURE;
+
+    viennacl::hyb_matrix<NumericT> vcl_hyb;
+    viennacl::copy(adapted_A, vcl_hyb);
+    if (!test_prod(vcl_hyb, x, reference, epsilon, "hyb_matrix"))
+      return EXIT_FAILURE;
+
+    viennacl::hyb_matrix<NumericT, 4> vcl_hyb4;
+    viennacl::copy(adapted_A, vcl_hyb4);
+    if (!test_prod(vcl_hyb4, x, reference, epsilon, "hyb_matrix, alignment 4"))
+      return EXIT_FAILURE;
+
+    //
+    // Products with blocks of vectors:
+    //
+    if (size1 > 1000)
+      continue;
+
+    std::size_t widths[] = {1, 2, 3, 4, 7, 8, 16, 31, 32, 33, 70};
+    for (std::size_t w=0; w<sizeof(widths)/sizeof(std::size_t); ++w)
+    {
+      if (!test_prod_block<NumericT, viennacl::row_major>(vcl_compressed, A, size2, widths[w], epsilon, "compressed_matrix, row_major"))
+        return EXIT_FAILURE;
+      if (!test_prod_block<NumericT, viennacl::column_major>(vcl_compressed, A, size2, widths[w], epsilon, "compressed_matrix, column_major"))
+        return EXIT_FAILURE;
+      if (!test_prod_block<NumericT, viennacl::row_major>(vcl_ell, A, size2, widths[w], epsilon, "ell_matrix, row_major"))
+        return EXIT_FAILURE;
+      if (!test_prod_block<NumericT, viennacl::column_major>(vcl_ell, A, size2, widths[w], epsilon, "ell_matrix, column_major"))
+        return EXIT_FAILURE;
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
+
+
+//
+// -------------------------------------------------------------
+//
+int main()
+{
+  std::cout << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "## Test :: Sparse Matrix-Vector Products" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << std::endl;
+
+  int retval = EXIT_SUCCESS;
+
+  std::cout << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << std::endl;
+  {
+    typedef float NumericT;
+    NumericT epsilon = static_cast<NumericT>(1E-4);
+    std::cout << "# Testing setup:" << std::endl;
+    std::cout << "  eps:     " << epsilon << std::endl;
+    std::cout << "  numeric: float" << std::endl;
+    retval = test<NumericT>(epsilon);
+    if( retval == EXIT_SUCCESS )
+        std::cout << "# Test passed" << std::endl;
+    else
+        return retval;
+  }
+  std::cout << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << std::endl;
+
+#ifdef VIENNACL_WITH_OPENCL
+  if( viennacl::ocl::current_device().double_support() )
+#endif
+  {
+    typedef double NumericT;
+    NumericT epsilon = 1.0E-10;
+    std::cout << "# Testing setup:" << std::endl;
+    std::cout << "  eps:     " << epsilon << std::endl;
+    std::cout << "  numeric: double" << std::endl;
+    retval = test<NumericT>(epsilon);
+    if( retval == EXIT_SUCCESS )
+        std::cout << "# Test passed" << std::endl;
+    else
+        return retval;
+  }
+  std::cout << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << std::endl;
+
+  std::cout << std::endl;
+  std::cout << "------- Test completed --------" << std::endl;
+  std::cout << std::endl;
+
+  return retval;
+}
+
@@ -0,0 +1,175 @@
+/* =========================================================================
+   Copyright (c) 2010-2013, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+#include <iostream>
+#include <vector>
+#include <cmath>
+#include <cstdlib>
+#include <string>
+
+#include "viennacl/matrix.hpp"
+#include "viennacl/matrix_proxy.hpp"
+#include "viennacl/linalg/prod.hpp"
+#include "viennacl/linalg/norm_frobenius.hpp"
+#include "viennacl/linalg/svd.hpp"
+
+#include "examples/tutorial/Random.hpp"
+
+typedef double ScalarType;
+
+template <typename MatrixType>
+void fill_random(MatrixType & A)
+{
+  std::vector< std::vector<ScalarType> > host_A(A.size1(), std::vector<ScalarType>(A.size2()));
+  for (std::size_t i=0; i<A.size1(); ++i)
+    for (std::size_t j=0; j<A.size2(); ++j)
+      host_A[i][j] = random<ScalarType>() - ScalarType(0.5);
+  viennacl::copy(host_A, A);
+}
+
+// returns ||Q^T Q - I||_F
+template <typename MatrixType>
+ScalarType orthogonality_error(MatrixType const & Q)
+{
+  MatrixType QTQ = viennacl::linalg::prod(trans(Q), Q);
+  MatrixType I = viennacl::identity_matrix<ScalarType>(Q.size2());
+  QTQ -= I;
+  return viennacl::linalg::norm_frobenius(QTQ);
+}
+
+template <typename F>
+int test_svd(std::size_t m, std::size_t n)
+{
+  typedef viennacl::matrix<ScalarType, F>   MatrixType;
+
+  MatrixType A(m, n), A_ref(m, n), QL(m, m), QR(n, n);
+  fill_random(A);
+  A_ref = A;
+
+  std::vector<ScalarType> sigma = viennacl::linalg::singular_values(A);
+
+  viennacl::linalg::svd(A, QL, QR);
+
+  MatrixType QL_Sigma = viennacl::linalg::prod(QL, A);
+  MatrixType A_recovered = viennacl::linalg::prod(QL_Sigma, trans(QR));
+  A_recovered -= A_ref;
+  ScalarType error = viennacl::linalg::norm_frobenius(A_recovered) / viennacl::linalg::norm_frobenius(A_ref);
+  ScalarType orth_error = orthogonality_error(QL) + orthogonality_error(QR);
+
+  // compare with singular values from dqds:
+  std::vector< std::vector<ScalarType> > host_Sigma(m, std::vector<ScalarType>(n));
+  viennacl::copy(A, host_Sigma);
+  std::vector<ScalarType> sigma_svd(sigma.size());
+  for (std::size_t i=0; i<sigma.size(); ++i)
+    sigma_svd[i] = host_Sigma[i][i];
+  std::sort(sigma_svd.begin(), sigma_svd.end(), std::greater<ScalarType>());
+  ScalarType sigma_error = 0;
+  for (std::size_t i=0; i<sigma.size(); ++i)
+    sigma_error = std::max(sigma_error, std::fabs(sigma[i] - sigma_svd[i]) / sigma[0]);
+
+  std::cout << "* svd() with " << m << " x " << n << ": reconstruction error: " << error
+            << ", orthogonality error: " << orth_error << ", singular values error: " << sigma_error << std::endl;
+
+  if (sigma.size() != std::min(m, n) || error > 1e-12 || orth_error > 1e-11 || sigma_error > 1e-12)
+  {
+    std::cout << "# Error: Wrong singular value decomposition!" << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
+
+template <typename F>
+int test_randomized_svd(std::size_t m, std::size_t n, std::size_t rank)
+{
+  typedef viennacl::matrix<ScalarType, F>   MatrixType;
+
+  // set up a matrix with prescribed, quickly decaying singular values:
+  std::size_t k = std::min(m, n);
+  MatrixType G(m, n), QL(m, m), QR(n, n);
+  fill_random(G);
+  viennacl::linalg::svd(G, QL, QR);
+
+  std::vector<ScalarType> sigma_ref(k);
+  std::vector< std::vector<ScalarType> > host_Sigma(m, std::vector<ScalarType>(n));
+  for (std::size_t i=0; i<k; ++i)
+  {
+    sigma_ref[i] = std::pow(ScalarType(0.5), static_cast<ScalarType>(i));
+    host_Sigma[i][i] = sigma_ref[i];
+  }
+  MatrixType Sigma(m, n);
+  viennacl::copy(host_Sigma, Sigma);
+  MatrixType QL_Sigma = viennacl::linalg::prod(QL, Sigma);
+  MatrixType A = viennacl::linalg::prod(QL_Sigma, trans(QR));
+
+  MatrixType U, V;
+  std::vector<ScalarType> sigma = viennacl::linalg::randomized_svd(A, U, V, viennacl::linalg::randomized_svd_tag(rank));
+
+  ScalarType sigma_error = 0;
+  for (std::size_t i=0; i<sigma.size(); ++i)
+    sigma_error = std::max(sigma_error, std::fabs(sigma[i] - sigma_ref[i]) / sigma_ref[i]);
+
+  // residual ||A V - U Sigma||:
+  MatrixType AV = viennacl::linalg::prod(A, V);
+  std::vector< std::vector<ScalarType> > host_Sigma_k(rank, std::vector<ScalarType>(rank));
+  for (std::size_t i=0; i<sigma.size(); ++i)
+    host_Sigma_k[i][i] = sigma[i];
+  MatrixType Sigma_k(rank, rank);
+  viennacl::copy(host_Sigma_k, Sigma_k);
+  AV -= viennacl::linalg::prod(U, Sigma_k);
+  ScalarType residual = viennacl::linalg::norm_frobenius(AV);
+  ScalarType orth_error = orthogonality_error(U) + orthogonality_error(V);
+
+  std::cout << "* randomized_svd() with " << m << " x " << n << ", rank " << rank << ": singular values error: " << sigma_error
+            << ", residual: " << residual << ", orthogonality error: " << orth_error << std::endl;
+
+  if (sigma.size() != rank || U.size2() != rank || V.size2() != rank || sigma_error > 1e-8 || residual > 1e-8 || orth_error > 1e-11)
+  {
+    std::cout << "# Error: Wrong truncated singular value decomposition!" << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
+
+int main()
+{
+  std::cout << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+  std::cout << "## Test :: Singular Value Decomposition" << std::endl;
+  std::cout << "----------------------------------------------" << std::endl;
+
+  std::cout << "# Testing row-major matrices" << std::endl;
+  if (test_svd<viennacl::row_major>(130, 70) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+  if (test_svd<viennacl::row_major>(45, 101) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+  if (test_randomized_svd<viennacl::row_major>(200, 90, 8) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  std::cout << "# Testing column-major matrices" << std::endl;
+  if (test_svd<viennacl::column_major>(130, 70) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+  if (test_svd<viennacl::column_major>(64, 64) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+  if (test_randomized_svd<viennacl::column_major>(80, 150, 10) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  std::cout << std::endl;
+  std::cout << "------- Test completed --------" << std::endl;
+  std::cout << std::endl;
+
+  return EXIT_SUCCESS;
+}
@@ -27,6 +27,7 @@
 #include <boost/numeric/ublas/io.hpp>
 #include <boost/numeric/ublas/vector.hpp>
 #include <boost/numeric/ublas/vector_proxy.hpp>
+#include <boost/numeric/ublas/matrix.hpp>
 
 //
 // *** ViennaCL
@@ -35,7 +36,9 @@
 #define VIENNACL_WITH_UBLAS 1
 #include "viennacl/vector.hpp"
 #include "viennacl/vector_proxy.hpp"
+#include "viennacl/matrix.hpp"
 #include "viennacl/linalg/inner_prod.hpp"
+#include "viennacl/linalg/prod.hpp"
 #include "viennacl/linalg/norm_1.hpp"
 #include "viennacl/linalg/norm_2.hpp"
 #include "viennacl/linalg/norm_inf.hpp"
@@ -322,12 +325,119 @@ int test(Epsilon const& epsilon,
     return EXIT_FAILURE;
   }
 
+  std::cout << "Testing inner_prod with twenty vectors..." << std::endl;
+  std::vector<viennacl::vector_base<NumericT> const *> vecs3(20);
+  ublas::vector<NumericT> ref_result3(20);
+  for (std::size_t j=0; j<vecs3.size(); ++j)
+  {
+    switch (j % 4)
+    {
+      case 0:  vecs3[j] = &vcl_v1; ref_result3(j) = ublas::inner_prod(ublas_v1, ublas_v1); break;
+      case 1:  vecs3[j] = &vcl_v2; ref_result3(j) = ublas::inner_prod(ublas_v1, ublas_v2); break;
+      case 2:  vecs3[j] = &vcl_v3; ref_result3(j) = ublas::inner_prod(ublas_v1, ublas_v3); break;
+      default: vecs3[j] = &vcl_v4; ref_result3(j) = ublas::inner_prod(ublas_v1, ublas_v4); break;
+    }
+  }
+  viennacl::vector_tuple<NumericT> tuple3(vecs3);
+  viennacl::vector<NumericT> result3(20);
+  result3 = viennacl::linalg::inner_prod(vcl_v1, tuple3);
+  if (check(ref_result3, result3, epsilon) != EXIT_SUCCESS)
+  {
+    std::cout << ref_result3 << std::endl;
+    std::cout << result3 << std::endl;
+    return EXIT_FAILURE;
+  }
+
+
+  std::cout << "Testing multi_axpy with four vectors..." << std::endl;
+  ublas::vector<NumericT> ublas_x(ublas_v1.size());
+  for (std::size_t i=0; i<ublas_x.size(); ++i)
+    ublas_x[i] = random<NumericT>();
+  viennacl::vector<NumericT> vcl_x(ublas_x.size());
+  viennacl::copy(ublas_x, vcl_x);
+
+  ublas::vector<NumericT> ublas_alpha(20);
+  for (std::size_t j=0; j<ublas_alpha.size(); ++j)
+    ublas_alpha[j] = NumericT(j + 1) / NumericT(20);
+  viennacl::vector<NumericT> vcl_alpha(20);
+  viennacl::copy(ublas_alpha, vcl_alpha);
+
+  ublas_x += ublas_alpha[0] * ublas_v1 + ublas_alpha[2] * ublas_v2 + ublas_alpha[4] * ublas_v3 + ublas_alpha[6] * ublas_v4;
+  viennacl::linalg::multi_axpy(vcl_x, viennacl::project(vcl_alpha, viennacl::slice(0, 2, 4)), viennacl::tie(vcl_v1, vcl_v2, vcl_v3, vcl_v4));
+  if (check(ublas_x, vcl_x, epsilon) != EXIT_SUCCESS)
+  {
+    std::cout << ublas_x << std::endl;
+    std::cout << vcl_x << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "Testing multi_axpy with twenty vectors..." << std::endl;
+  for (std::size_t j=0; j<vecs3.size(); ++j)
+  {
+    switch (j % 4)
+    {
+      case 0:  ublas_x += ublas_alpha[j] * ublas_v1; break;
+      case 1:  ublas_x += ublas_alpha[j] * ublas_v2; break;
+      case 2:  ublas_x += ublas_alpha[j] * ublas_v3; break;
+      default: ublas_x += ublas_alpha[j] * ublas_v4; break;
+    }
+  }
+  viennacl::linalg::multi_axpy(vcl_x, vcl_alpha, tuple3);
+  if (check(ublas_x, vcl_x, epsilon) != EXIT_SUCCESS)
+  {
+    std::cout << ublas_x << std::endl;
+    std::cout << vcl_x << std::endl;
+    return EXIT_FAILURE;
+  }
+
 
   // --------------------------------------------------------------------------
   return retval;
 }
 
 
+//
+// V^T w and V c for a set of vectors V stored as the columns (or rows) of a dense matrix
+//
+template< typename NumericT, typename F, typename Epsilon >
+int test_multi_vector_matrix(Epsilon const& epsilon, std::size_t size1, std::size_t size2)
+{
+  ublas::matrix<NumericT> ublas_V(size1, size2);
+  for (std::size_t i=0; i<size1; ++i)
+    for (std::size_t j=0; j<size2; ++j)
+      ublas_V(i,j) = NumericT(1.0) + random<NumericT>();
+
+  ublas::vector<NumericT> ublas_w(size1);
+  for (std::size_t i=0; i<size1; ++i)
+    ublas_w[i] = NumericT(1.0) + random<NumericT>();
+
+  ublas::vector<NumericT> ublas_c(size2);
+  for (std::size_t j=0; j<size2; ++j)
+    ublas_c[j] = NumericT(1.0) + random<NumericT>();
+
+  viennacl::matrix<NumericT, F> vcl_V(size1, size2);
+  viennacl::vector<NumericT> vcl_w(size1);
+  viennacl::vector<NumericT> vcl_c(size2);
+  viennacl::copy(ublas_V, vcl_V);
+  viennacl::copy(ublas_w, vcl_w);
+  viennacl::copy(ublas_c, vcl_c);
+
+  std::cout << "Testing V^T w for " << size1 << "x" << size2 << " matrix..." << std::endl;
+  ublas::vector<NumericT> ublas_result1 = ublas::prod(ublas::trans(ublas_V), ublas_w);
+  viennacl::vector<NumericT> vcl_result1 = viennacl::linalg::prod(viennacl::trans(vcl_V), vcl_w);
+  if (check(ublas_result1, vcl_result1, epsilon) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  std::cout << "Testing V c for " << size1 << "x" << size2 << " matrix..." << std::endl;
+  ublas::vector<NumericT> ublas_result2 = ublas::prod(ublas_V, ublas_c);
+  viennacl::vector<NumericT> vcl_result2 = viennacl::linalg::prod(vcl_V, vcl_c);
+  if (check(ublas_result2, vcl_result2, epsilon) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  return EXIT_SUCCESS;
+}
+
+
 template< typename NumericT, typename Epsilon >
 int test(Epsilon const& epsilon)
 {
@@ -516,6 +626,18 @@ int test(Epsilon const& epsilon)
   if (retval != EXIT_SUCCESS)
     return EXIT_FAILURE;
 
+  std::cout << " ** [tall-skinny matrix, column-major] **" << std::endl;
+  if (test_multi_vector_matrix<NumericT, viennacl::column_major>(epsilon, size, 20) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  std::cout << " ** [tall-skinny matrix, row-major] **" << std::endl;
+  if (test_multi_vector_matrix<NumericT, viennacl::row_major>(epsilon, size, 20) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
+  std::cout << " ** [square matrix, column-major] **" << std::endl;
+  if (test_multi_vector_matrix<NumericT, viennacl::column_major>(epsilon, 137, 131) != EXIT_SUCCESS)
+    return EXIT_FAILURE;
+
   return EXIT_SUCCESS;
 }
 
@@ -29,6 +29,7 @@
 #include "viennacl/context.hpp"
 #include "viennacl/traits/handle.hpp"
 #include "viennacl/backend/util.hpp"
+#include "viennacl/tools/profiler.hpp"
 
 #include "viennacl/backend/cpu_ram.hpp"
 
@@ -146,6 +147,8 @@ namespace viennacl
 
       if (bytes_to_copy > 0)
       {
+        viennacl::tools::profiler_scope profile("memory_copy", src_buffer.get_active_handle_id(), 2.0 * bytes_to_copy, 0, "transfer");
+
         switch(src_buffer.get_active_handle_id())
         {
           case MAIN_MEMORY:
@@ -224,6 +227,8 @@ namespace viennacl
     {
       if (bytes_to_write > 0)
       {
+        viennacl::tools::profiler_scope profile("memory_write", dst_buffer.get_active_handle_id(), bytes_to_write, 0, "transfer");
+
         switch(dst_buffer.get_active_handle_id())
         {
           case MAIN_MEMORY:
@@ -267,6 +272,8 @@ namespace viennacl
 
       if (bytes_to_read > 0)
       {
+        viennacl::tools::profiler_scope profile("memory_read", src_buffer.get_active_handle_id(), bytes_to_read, 0, "transfer");
+
         switch(src_buffer.get_active_handle_id())
         {
           case MAIN_MEMORY:
@@ -26,6 +26,7 @@
 #include <vector>
 #include "viennacl/ocl/handle.hpp"
 #include "viennacl/ocl/backend.hpp"
+#include "viennacl/ocl/event.hpp"
 
 namespace viennacl
 {
@@ -140,6 +141,84 @@ namespace viennacl
       }
 
 
+      /** @brief Asynchronously copies 'bytes_to_copy' bytes from 'src_buffer + src_offset' to 'dst_buffer + dst_offset' using the provided queue.
+       *
+       * The copy starts after the commands identified by 'dependencies' have completed. The returned event identifies the copy.
+       */
+      inline viennacl::ocl::event memory_copy(viennacl::ocl::handle<cl_mem> const & src_buffer,
+                                              viennacl::ocl::handle<cl_mem> & dst_buffer,
+                                              std::size_t src_offset,
+                                              std::size_t dst_offset,
+                                              std::size_t bytes_to_copy,
+                                              viennacl::ocl::command_queue const & queue,
+                                              std::vector<viennacl::ocl::event> const & dependencies)
+      {
+        assert( &src_buffer.context() == &dst_buffer.context() && bool("Transfer between memory buffers in different contexts not supported yet!"));
+
+        std::vector<cl_event> wait_list = viennacl::ocl::detail::event_wait_list(dependencies);
+        cl_event evt;
+        cl_int err = clEnqueueCopyBuffer(queue.handle().get(),
+                                         src_buffer.get(),
+                                         dst_buffer.get(),
+                                         src_offset,
+                                         dst_offset,
+                                         bytes_to_copy,
+                                         static_cast<cl_uint>(wait_list.size()), wait_list.size() > 0 ? &(wait_list[0]) : NULL, &evt);
+        VIENNACL_ERR_CHECK(err);
+        return viennacl::ocl::event(evt, src_buffer.context());
+      }
+
+      /** @brief Asynchronously writes data from main RAM identified by 'ptr' to the OpenCL buffer identified by 'dst_buffer' using the provided queue.
+       *
+       * The transfer starts after the commands identified by 'dependencies' have completed. The returned event identifies the transfer.
+       * The data pointed to by 'ptr' must not be modified before the transfer has completed.
+       */
+      inline viennacl::ocl::event memory_write(viennacl::ocl::handle<cl_mem> & dst_buffer,
+                                               std::size_t dst_offset,
+                                               std::size_t bytes_to_copy,
+                                               const void * ptr,
+                                               viennacl::ocl::command_queue const & queue,
+                                               std::vector<viennacl::ocl::event> const & dependencies)
+      {
+        std::vector<cl_event> wait_list = viennacl::ocl::detail::event_wait_list(dependencies);
+        cl_event evt;
+        cl_int err = clEnqueueWriteBuffer(queue.handle().get(),
+                                          dst_buffer.get(),
+                                          CL_FALSE,
+                                          dst_offset,
+                                          bytes_to_copy,
+                                          ptr,
+                                          static_cast<cl_uint>(wait_list.size()), wait_list.size() > 0 ? &(wait_list[0]) : NULL, &evt);
+        VIENNACL_ERR_CHECK(err);
+        return viennacl::ocl::event(evt, dst_buffer.context());
+      }
+
+      /** @brief Asynchronously reads data from an OpenCL buffer to main RAM using the provided queue.
+       *
+       * The transfer starts after the commands identified by 'dependencies' have completed. The returned event identifies the transfer.
+       * The data at 'ptr' must not be accessed before the transfer has completed.
+       */
+      inline viennacl::ocl::event memory_read(viennacl::ocl::handle<cl_mem> const & src_buffer,
+                                              std::size_t src_offset,
+                                              std::size_t bytes_to_copy,
+                                              void * ptr,
+                                              viennacl::ocl::command_queue const & queue,
+                                              std::vector<viennacl::ocl::event> const & dependencies)
+      {
+        std::vector<cl_event> wait_list = viennacl::ocl::detail::event_wait_list(dependencies);
+        cl_event evt;
+        cl_int err = clEnqueueReadBuffer(queue.handle().get(),
+                                         src_buffer.get(),
+                                         CL_FALSE,
+                                         src_offset,
+                                         bytes_to_copy,
+                                         ptr,
+                                         static_cast<cl_uint>(wait_list.size()), wait_list.size() > 0 ? &(wait_list[0]) : NULL, &evt);
+        VIENNACL_ERR_CHECK(err);
+        return viennacl::ocl::event(evt, src_buffer.context());
+      }
+
+
     }
   } //backend
 } //viennacl
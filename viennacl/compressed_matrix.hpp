@@ -32,6 +32,7 @@
 
 #include "viennacl/tools/tools.hpp"
 #include "viennacl/tools/entry_proxy.hpp"
+#include "viennacl/tools/sparse_matrix_builder.hpp"
 
 namespace viennacl
 {
@@ -182,13 +183,25 @@ namespace viennacl
     void copy(const Eigen::SparseMatrix<SCALARTYPE, flags> & eigen_matrix,
               compressed_matrix<SCALARTYPE, ALIGNMENT> & gpu_matrix)
     {
-      std::vector< std::map<unsigned int, SCALARTYPE> >  stl_matrix(eigen_matrix.rows());
-
-      for (int k=0; k < eigen_matrix.outerSize(); ++k)
-        for (typename Eigen::SparseMatrix<SCALARTYPE, flags>::InnerIterator it(eigen_matrix, k); it; ++it)
-          stl_matrix[it.row()][it.col()] = it.value();
+      if (eigen_matrix.rows() > 0 && eigen_matrix.cols() > 0)
+      {
+        std::vector<unsigned int> row_indices;
+        std::vector<unsigned int> col_indices;
+        std::vector<SCALARTYPE>   values;
+        row_indices.reserve(eigen_matrix.nonZeros());
+        col_indices.reserve(eigen_matrix.nonZeros());
+        values.reserve(eigen_matrix.nonZeros());
+
+        for (int k=0; k < eigen_matrix.outerSize(); ++k)
+          for (typename Eigen::SparseMatrix<SCALARTYPE, flags>::InnerIterator it(eigen_matrix, k); it; ++it)
+          {
+            row_indices.push_back(static_cast<unsigned int>(it.row()));
+            col_indices.push_back(static_cast<unsigned int>(it.col()));
+            values.push_back(it.value());
+          }
 
-      copy(tools::const_sparse_matrix_adapter<SCALARTYPE>(stl_matrix, eigen_matrix.rows(), eigen_matrix.cols()), gpu_matrix);
+        tools::sparse_matrix_builder(eigen_matrix.rows(), eigen_matrix.cols(), row_indices, col_indices, ALIGNMENT).assemble(values, gpu_matrix);
+      }
     }
 #endif
 
@@ -200,7 +213,15 @@ namespace viennacl
     {
       typedef mtl::compressed2D<SCALARTYPE>  MatrixType;
 
-      std::vector< std::map<unsigned int, SCALARTYPE> >  stl_matrix(cpu_matrix.num_rows());
+      if (cpu_matrix.num_rows() == 0 || cpu_matrix.num_cols() == 0)
+        return;
+
+      std::vector<unsigned int> row_indices;
+      std::vector<unsigned int> col_indices;
+      std::vector<SCALARTYPE>   values;
+      row_indices.reserve(cpu_matrix.nnz());
+      col_indices.reserve(cpu_matrix.nnz());
+      values.reserve(cpu_matrix.nnz());
 
       using mtl::traits::range_generator;
       using mtl::traits::range::min;
@@ -223,9 +244,13 @@ namespace viennacl
       // Now iterate over the matrix
       for (c_type cursor(my_range.begin(cpu_matrix)), cend(my_range.end(cpu_matrix)); cursor != cend; ++cursor)
         for (ic_type icursor(mtl::begin<mtl::tag::nz>(cursor)), icend(mtl::end<mtl::tag::nz>(cursor)); icursor != icend; ++icursor)
-          stl_matrix[row(*icursor)][col(*icursor)] = value(*icursor);
+        {
+          row_indices.push_back(static_cast<unsigned int>(row(*icursor)));
+          col_indices.push_back(static_cast<unsigned int>(col(*icursor)));
+          values.push_back(value(*icursor));
+        }
 
-      copy(tools::const_sparse_matrix_adapter<SCALARTYPE>(stl_matrix, cpu_matrix.num_rows(), cpu_matrix.num_cols()), gpu_matrix);
+      tools::sparse_matrix_builder(cpu_matrix.num_rows(), cpu_matrix.num_cols(), row_indices, col_indices, ALIGNMENT).assemble(values, gpu_matrix);
     }
 #endif
 
@@ -514,26 +539,83 @@ namespace viennacl
 
 #ifdef VIENNACL_WITH_OPENCL
         explicit compressed_matrix(cl_mem mem_row_buffer, cl_mem mem_col_buffer, cl_mem mem_elements,
-                                  std::size_t rows, std::size_t cols, std::size_t nonzeros) :
+                                  std::size_t rows, std::size_t cols, std::size_t nonzeros, viennacl::context ctx = viennacl::context()) :
           rows_(rows), cols_(cols), nonzeros_(nonzeros)
         {
             row_buffer_.switch_active_handle_id(viennacl::OPENCL_MEMORY);
             row_buffer_.opencl_handle() = mem_row_buffer;
             row_buffer_.opencl_handle().inc();             //prevents that the user-provided memory is deleted once the matrix object is destroyed.
+            row_buffer_.opencl_handle().context(ctx.opencl_context());
             row_buffer_.raw_size(sizeof(cl_uint) * (rows + 1));
 
             col_buffer_.switch_active_handle_id(viennacl::OPENCL_MEMORY);
             col_buffer_.opencl_handle() = mem_col_buffer;
             col_buffer_.opencl_handle().inc();             //prevents that the user-provided memory is deleted once the matrix object is destroyed.
+            col_buffer_.opencl_handle().context(ctx.opencl_context());
             col_buffer_.raw_size(sizeof(cl_uint) * nonzeros);
 
             elements_.switch_active_handle_id(viennacl::OPENCL_MEMORY);
             elements_.opencl_handle() = mem_elements;
             elements_.opencl_handle().inc();               //prevents that the user-provided memory is deleted once the matrix object is destroyed.
+            elements_.opencl_handle().context(ctx.opencl_context());
             elements_.raw_size(sizeof(SCALARTYPE) * nonzeros);
         }
 #endif
 
+        /** @brief Wraps existing CSR arrays in CUDA or host memory. The arrays are not copied and must remain valid while the matrix object is in use.
+        *
+        * @param mem_row_buffer   Row offsets (rows + 1 entries)
+        * @param mem_col_buffer   Column indices (nonzeros entries)
+        * @param mem_elements     Nonzero values (nonzeros entries)
+        * @param mem_type         Either CUDA_MEMORY or MAIN_MEMORY
+        * @param rows             Number of rows
+        * @param cols             Number of columns
+        * @param nonzeros         Number of nonzeros
+        */
+        explicit compressed_matrix(unsigned int * mem_row_buffer, unsigned int * mem_col_buffer, SCALARTYPE * mem_elements, viennacl::memory_types mem_type,
+                                   std::size_t rows, std::size_t cols, std::size_t nonzeros) :
+          rows_(rows), cols_(cols), nonzeros_(nonzeros)
+        {
+          if (mem_type == viennacl::CUDA_MEMORY)
+          {
+#ifdef VIENNACL_WITH_CUDA
+            row_buffer_.switch_active_handle_id(viennacl::CUDA_MEMORY);
+            row_buffer_.cuda_handle().reset(reinterpret_cast<char*>(mem_row_buffer));
+            row_buffer_.cuda_handle().inc();               //prevents that the user-provided memory is deleted once the matrix object is destroyed.
+
+            col_buffer_.switch_active_handle_id(viennacl::CUDA_MEMORY);
+            col_buffer_.cuda_handle().reset(reinterpret_cast<char*>(mem_col_buffer));
+            col_buffer_.cuda_handle().inc();
+
+            elements_.switch_active_handle_id(viennacl::CUDA_MEMORY);
+            elements_.cuda_handle().reset(reinterpret_cast<char*>(mem_elements));
+            elements_.cuda_handle().inc();
+#else
+            throw "CUDA not activated!";
+#endif
+          }
+          else if (mem_type == viennacl::MAIN_MEMORY)
+          {
+            row_buffer_.switch_active_handle_id(viennacl::MAIN_MEMORY);
+            row_buffer_.ram_handle().reset(reinterpret_cast<char*>(mem_row_buffer));
+            row_buffer_.ram_handle().inc();                //prevents that the user-provided memory is deleted once the matrix object is destroyed.
+
+            col_buffer_.switch_active_handle_id(viennacl::MAIN_MEMORY);
+            col_buffer_.ram_handle().reset(reinterpret_cast<char*>(mem_col_buffer));
+            col_buffer_.ram_handle().inc();
+
+            elements_.switch_active_handle_id(viennacl::MAIN_MEMORY);
+            elements_.ram_handle().reset(reinterpret_cast<char*>(mem_elements));
+            elements_.ram_handle().inc();
+          }
+          else
+            throw memory_exception("unsupported memory type for wrapping CSR arrays!");
+
+          row_buffer_.raw_size(sizeof(unsigned int) * (rows + 1));
+          col_buffer_.raw_size(sizeof(unsigned int) * nonzeros);
+          elements_.raw_size(sizeof(SCALARTYPE) * nonzeros);
+        }
+
 
         /** @brief Assignment a compressed matrix from possibly another memory domain. */
         compressed_matrix & operator=(compressed_matrix const & other)
@@ -613,7 +695,7 @@ namespace viennacl
         *
         * @param new_size1    New number of rows
         * @param new_size2    New number of columns
-        * @param preserve     If true, the old values are preserved. At present, old values are always discarded.
+        * @param preserve     If true, the old values inside the new bounds are preserved.
         */
         void resize(std::size_t new_size1, std::size_t new_size2, bool preserve = true)
         {
@@ -621,48 +703,74 @@ namespace viennacl
 
           if (new_size1 != rows_ || new_size2 != cols_)
           {
-            std::vector<std::map<unsigned int, SCALARTYPE> > stl_sparse_matrix;
-            if (rows_ > 0)
+            std::vector<unsigned int> row_indices;
+            std::vector<unsigned int> col_indices;
+            std::vector<SCALARTYPE>   values;
+
+            if (rows_ > 0 && preserve)
             {
-              if (preserve)
-              {
-                stl_sparse_matrix.resize(rows_);
-                viennacl::copy(*this, stl_sparse_matrix);
-              } else
-                stl_sparse_matrix[0][0] = 0;
-            } else {
-              stl_sparse_matrix.resize(new_size1);
-              stl_sparse_matrix[0][0] = 0;      //enforces nonzero array sizes if matrix was initially empty
+              viennacl::backend::typesafe_host_array<unsigned int> row_buffer(row_buffer_, rows_ + 1);
+              viennacl::backend::typesafe_host_array<unsigned int> col_buffer(col_buffer_, nonzeros_);
+              std::vector<SCALARTYPE> elements(nonzeros_);
+
+              viennacl::backend::memory_read(row_buffer_, 0, row_buffer.raw_size(), row_buffer.get());
+              viennacl::backend::memory_read(col_buffer_, 0, col_buffer.raw_size(), col_buffer.get());
+              viennacl::backend::memory_read(elements_,   0, sizeof(SCALARTYPE) * nonzeros_, &(elements[0]));
+
+              //keep the entries inside the new bounds. The CSR order is preserved, so the assembly below does not need to reorder anything:
+              for (std::size_t row = 0; row < std::min(rows_, new_size1); ++row)
+                for (std::size_t k = row_buffer[row]; k < row_buffer[row + 1]; ++k)
+                  if (col_buffer[k] < new_size2)
+                  {
+                    row_indices.push_back(static_cast<unsigned int>(row));
+                    col_indices.push_back(col_buffer[k]);
+                    values.push_back(elements[k]);
+                  }
             }
 
-            stl_sparse_matrix.resize(new_size1);
-
-            //discard entries with column index larger than new_size2
-            if (new_size2 < cols_ && rows_ > 0)
+            if (row_indices.size() == 0)   //enforces nonzero array sizes
             {
-              for (std::size_t i=0; i<stl_sparse_matrix.size(); ++i)
-              {
-                std::list<unsigned int> to_delete;
-                for (typename std::map<unsigned int, SCALARTYPE>::iterator it = stl_sparse_matrix[i].begin();
-                    it != stl_sparse_matrix[i].end();
-                    ++it)
-                {
-                  if (it->first >= new_size2)
-                    to_delete.push_back(it->first);
-                }
-
-                for (std::list<unsigned int>::iterator it = to_delete.begin(); it != to_delete.end(); ++it)
-                  stl_sparse_matrix[i].erase(*it);
-              }
+              row_indices.push_back(0);
+              col_indices.push_back(0);
+              values.push_back(0);
             }
 
-            viennacl::copy(stl_sparse_matrix, *this);
-
-            rows_ = new_size1;
-            cols_ = new_size2;
+            viennacl::tools::sparse_matrix_builder(new_size1, new_size2, row_indices, col_indices, ALIGNMENT).assemble(values, *this);
           }
         }
 
+        /** @brief Assembles the matrix from coordinate (COO) triplets (row_indices[k], col_indices[k], values[k]). Duplicates are summed up.
+        *
+        * The number of rows and columns must have been set before. Use viennacl::tools::sparse_matrix_builder directly for assembling the matrix repeatedly with the same sparsity pattern.
+        */
+        template <typename IndexT>
+        void assemble(std::vector<IndexT> const & row_indices,
+                      std::vector<IndexT> const & col_indices,
+                      std::vector<SCALARTYPE> const & values)
+        {
+          viennacl::tools::sparse_matrix_builder(rows_, cols_, row_indices, col_indices, ALIGNMENT).assemble(values, *this);
+        }
+
+        /** @brief Overwrites the nonzero entries while keeping the sparsity pattern. Only the value array is transferred.
+        *
+        * @param elements    Pointer to nnz() entries in host memory, given in the order of the column index array (including the padding entries due to ALIGNMENT)
+        * @param async       If true, the transfer may return before it is completed. 'elements' must then remain valid until viennacl::backend::finish() is called.
+        */
+        void set_values(const SCALARTYPE * elements, bool async = false)
+        {
+          viennacl::backend::memory_write(elements_, 0, sizeof(SCALARTYPE) * nonzeros_, elements, async);
+        }
+
+        /** @brief Overwrites the nonzero entries with the values stored in a buffer of the same memory domain (e.g. the result of a kernel). The sparsity pattern is kept.
+        *
+        * @param elements    Buffer holding at least offset + nnz() entries in the order of the column index array
+        * @param offset      Index of the first entry to be copied from 'elements'
+        */
+        void set_values(handle_type const & elements, std::size_t offset = 0)
+        {
+          viennacl::backend::memory_copy(elements, elements_, sizeof(SCALARTYPE) * offset, 0, sizeof(SCALARTYPE) * nonzeros_);
+        }
+
         /** @brief Returns a reference to the (i,j)-th entry of the sparse matrix. If (i,j) does not exist (zero), it is inserted (slow!) */
         entry_proxy<SCALARTYPE> operator()(std::size_t i, std::size_t j)
         {
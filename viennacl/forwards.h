@@ -611,6 +611,69 @@ namespace viennacl
 
     }
 
+    /** @brief Permutations of the unknowns applied by incomplete factorization preconditioners prior to the factorization */
+    enum ilu_reordering_type
+    {
+      ILU_REORDERING_NONE = 0,   //no reordering
+      ILU_REORDERING_MULTICOLOR, //rows of the same color of a graph coloring are independent
+      ILU_REORDERING_LEVEL_SET   //rows of the same level of the lower triangular part are contiguous
+    };
+
+    /** @brief Placement of the inverse diagonal D^{-1} of a scaled_operator relative to the system matrix A */
+    enum diagonal_scaling_type
+    {
+      DIAGONAL_SCALING_LEFT = 0, //D^{-1} A
+      DIAGONAL_SCALING_SYMMETRIC //D^{-1/2} A D^{-1/2}, preserves symmetry
+    };
+
+    template <typename MatrixType>
+    class scaled_operator;
+
+    /** @brief Describes a batch of equally sized dense matrices stored in a single buffer, see viennacl/linalg/batched.hpp
+    *
+    * Entry (i,j) of the b-th matrix of the batch is located at index start + b * batch_stride + i * stride1 + j * stride2 of the buffer.
+    * Thus, row-major matrices have stride2 == 1, column-major matrices have stride1 == 1, and a transposed view is obtained via trans().
+    */
+    class batch_layout
+    {
+      public:
+        /** @brief Densely packed row-major matrices, one after another */
+        batch_layout(vcl_size_t size1, vcl_size_t size2, vcl_size_t batch_count)
+          : size1_(size1), size2_(size2), batch_count_(batch_count), start_(0), stride1_(size2), stride2_(1), batch_stride_(size1 * size2) {}
+
+        batch_layout(vcl_size_t size1, vcl_size_t size2, vcl_size_t batch_count,
+                     vcl_size_t start, vcl_size_t stride1, vcl_size_t stride2, vcl_size_t batch_stride)
+          : size1_(size1), size2_(size2), batch_count_(batch_count), start_(start), stride1_(stride1), stride2_(stride2), batch_stride_(batch_stride) {}
+
+        vcl_size_t size1() const { return size1_; }
+        vcl_size_t size2() const { return size2_; }
+        vcl_size_t batch_count() const { return batch_count_; }
+        vcl_size_t start() const { return start_; }
+        vcl_size_t stride1() const { return stride1_; }
+        vcl_size_t stride2() const { return stride2_; }
+        vcl_size_t batch_stride() const { return batch_stride_; }
+
+        /** @brief Returns the layout of the transposed matrices in the same buffer */
+        batch_layout trans() const { return batch_layout(size2_, size1_, batch_count_, start_, stride2_, stride1_, batch_stride_); }
+
+        /** @brief Returns the number of buffer entries spanned by the batch */
+        vcl_size_t extent() const
+        {
+          if (batch_count_ == 0 || size1_ == 0 || size2_ == 0)
+            return start_;
+          return start_ + (batch_count_ - 1) * batch_stride_ + (size1_ - 1) * stride1_ + (size2_ - 1) * stride2_ + 1;
+        }
+
+      private:
+        vcl_size_t size1_;
+        vcl_size_t size2_;
+        vcl_size_t batch_count_;
+        vcl_size_t start_;
+        vcl_size_t stride1_;
+        vcl_size_t stride2_;
+        vcl_size_t batch_stride_;
+    };
+
 
     /** @brief A tag class representing a lower triangular matrix */
     struct lower_tag
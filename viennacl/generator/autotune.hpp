@@ -29,6 +29,8 @@
 #include <iomanip>
 #include <cmath>
 #include <iterator>
+#include <fstream>
+#include <string>
 
 #include "viennacl/ocl/kernel.hpp"
 #include "viennacl/ocl/infos.hpp"
@@ -199,6 +201,108 @@ namespace viennacl{
         std::cout << '\r' << "Autotuning..." << "[100.00%]" << std::endl;
       }
 
+      /** @brief Stores a profile in the tuned database, for problem sizes starting at 'min_size' on the given device. If 'database_file' is not empty, the profile is merged into this file. */
+      template<class ProfileT>
+      void store_profile(viennacl::ocl::device const & device, code_generator::forced_profile_key_type const & key, std::size_t min_size,
+                         ProfileT const & profile, std::string const & database_file = ""){
+        profiles::profile_base_ptr ptr(new ProfileT(profile));
+        viennacl::tools::scoped_lock lock(profiles::tuned_database_mutex());
+        if(!database_file.empty()){
+          //keep the entries of the file, which may stem from other devices or processes:
+          if(std::ifstream(database_file.c_str()))
+            profiles::load_database(database_file);
+          profiles::set_tuned_profile(device, key, min_size, ptr);
+          profiles::save_database(database_file);
+        }
+        else
+          profiles::set_tuned_profile(device, key, min_size, ptr);
+      }
+
+      /** @brief Autotuning of an operation for the current device, which stores the fastest profile in the tuned database.
+       *
+       *  The candidates are benchmarked in portions by step(), so the tuning can be interleaved with the work of an application (e.g. run in its idle phases).
+       *  Once all candidates are benchmarked, the fastest profile is used by the generator for problem sizes starting at 'min_size'
+       *  and, if a database file is given, written to this file.
+       *  Note that the operands of the statement are overwritten by the benchmark runs.
+       */
+      template<class ConfigType>
+      class background_tuner{
+        public:
+          typedef typename ConfigType::profile_type profile_type;
+
+          /** @brief The constructor
+           *
+           *  @param op              The statement to benchmark, representative for the problem sizes of the bucket
+           *  @param key             The type of the operation and the size of its scalartype
+           *  @param config          The tuning configuration, defining the candidate profiles
+           *  @param min_size        The lower bound of the size bucket (number of elements of the iteration space) the result is used for
+           *  @param n_runs          Number of runs per candidate
+           *  @param database_file   If not empty, the tuned profile is merged into this file when the tuning is complete
+           */
+          background_tuner(scheduler::statement const & op, code_generator::forced_profile_key_type const & key, tuning_config<ConfigType> const & config,
+                           std::size_t min_size, unsigned int n_runs, std::string const & database_file = "")
+            : op_(op), key_(key), config_(config), min_size_(min_size), n_runs_(n_runs), database_file_(database_file),
+              device_(viennacl::ocl::current_device()), best_time_(0), done_(false){
+            config_.reset();
+          }
+
+          /** @brief Benchmarks up to 'n_candidates' further candidates. Returns true if there are candidates left. */
+          bool step(unsigned int n_candidates = 1){
+            unsigned int n = 0;
+            while(!done_ && n < n_candidates && config_.has_next()){
+              config_.update();
+              profile_type profile = config_.get_current();
+              if(config_.is_invalid(device_) || profile.is_slow(device_))
+                continue;
+              double exec_time = benchmark_impl(op_, key_, profile, n_runs_);
+              if(best_.get()==NULL || exec_time < best_time_){
+                best_ = tools::shared_ptr<profile_type>(new profile_type(profile));
+                best_time_ = exec_time;
+              }
+              ++n;
+            }
+            if(!done_ && !config_.has_next()){
+              done_ = true;
+              store();
+            }
+            return !done_;
+          }
+
+          /** @brief Returns true if all candidates have been benchmarked */
+          bool done() const { return done_; }
+
+          /** @brief Returns the fastest profile so far, or NULL if no candidate has been benchmarked yet */
+          profile_type const * best() const { return best_.get(); }
+
+          /** @brief Returns the execution time of the fastest profile so far */
+          double best_time() const { return best_time_; }
+
+        private:
+          void store() const {
+            if(best_.get())
+              store_profile(device_, key_, min_size_, *best_, database_file_);
+          }
+
+          scheduler::statement op_;
+          code_generator::forced_profile_key_type key_;
+          tuning_config<ConfigType> config_;
+          std::size_t min_size_;
+          unsigned int n_runs_;
+          std::string database_file_;
+          viennacl::ocl::device device_;
+          tools::shared_ptr<profile_type> best_;
+          double best_time_;
+          bool done_;
+      };
+
+      /** @brief Autotunes an operation for the current device in one go and stores the fastest profile in the tuned database (and in 'database_file', if not empty). See background_tuner. */
+      template<class ConfigType>
+      void tune_and_store(scheduler::statement const & op, code_generator::forced_profile_key_type const & key, tuning_config<ConfigType> const & config,
+                          std::size_t min_size, unsigned int n_runs, std::string const & database_file = ""){
+        background_tuner<ConfigType> tuner(op, key, config, min_size, n_runs, database_file);
+        while(tuner.step(16)) { }
+      }
+
     }
 
   }
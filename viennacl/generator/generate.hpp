@@ -34,6 +34,7 @@
 #include "viennacl/generator/statement_representation_functor.hpp"
 #include "viennacl/generator/set_arguments_functor.hpp"
 #include "viennacl/generator/map_functor.hpp"
+#include "viennacl/generator/statement_dependencies.hpp"
 
 #include "viennacl/tools/tools.hpp"
 
@@ -55,6 +56,15 @@ namespace viennacl{
         typedef std::vector<representation_node_type> statements_type;
         typedef std::map<forced_profile_key_type, tools::shared_ptr<profile_base> > forced_profiles_type;
 
+        /** @brief The profile selected for a kernel on a device. Tuned profiles are tagged with the database revision and the size bucket they were taken from. */
+        struct selected_profile{
+          selected_profile() : tuned(false), min_size(0), revision(0) { }
+          tools::shared_ptr<profile_base> profile;
+          bool tuned;
+          std::size_t min_size;
+          unsigned int revision;
+        };
+
         /** @brief Check for the data access flow of a node.
         *
         * Row-major + Trans and Col-Major + NoTrans are equal in this regard. This prevents too much code duplication in the kernel templates.
@@ -207,12 +217,51 @@ namespace viennacl{
           }
         }
 
-        /** @brief Gets the profile associated with a device and an expression descriptor */
-        profile_base const & get_profile(viennacl::ocl::device const & device, expression_descriptor const & descriptor) const {
-          forced_profiles_type::const_iterator it = forced_profiles_.find(std::make_pair(descriptor.type, descriptor.scalartype_size));
-          if(it != forced_profiles_.end())
-            return *it->second;
-          return *profiles::get(device,descriptor);
+        /** @brief Checks whether a statement can be appended to the last kernel */
+        static bool can_fuse(expression_descriptor const & kernel_descriptor, detail::statement_dependencies const & kernel_dependencies,
+                             expression_descriptor const & descriptor, detail::statement_dependencies const & dependencies){
+          if(kernel_descriptor.scalartype_size != descriptor.scalartype_size || kernel_dependencies.conflicts_with(dependencies))
+            return false;
+
+          //same type of operation on the same iteration space:
+          return kernel_descriptor == descriptor && kernel_dependencies.loop_size() == dependencies.loop_size();
+        }
+
+        /** @brief Returns the number of elements of the iteration space of a kernel, used for selecting a tuned profile */
+        std::size_t problem_size(statements_type::const_iterator it) const {
+          std::pair<std::size_t, std::size_t> const & loop_size = dependencies_[std::distance(statements_.begin(), it)].loop_size();
+          return loop_size.first*loop_size.second;
+        }
+
+        /** @brief Selects the profiles of all kernels on all devices of the context.
+        *
+        *   The selection is kept until the next statement is added, so the program name, the source code and the kernel arguments stay consistent
+        *   and the profiles stay alive even if the tuned database is modified concurrently.
+        */
+        std::vector<selected_profile> const & selected_profiles() const {
+          if(selected_profiles_.empty()){
+            selected_profiles_.resize(ctx_.devices().size()*statements_.size());
+            std::vector<selected_profile>::iterator sit = selected_profiles_.begin();
+            for(std::vector<viennacl::ocl::device>::const_iterator dit = ctx_.devices().begin() ; dit != ctx_.devices().end() ; ++dit){
+              for(statements_type::const_iterator it = statements_.begin() ; it != statements_.end() ; ++it, ++sit){
+                forced_profiles_type::const_iterator fit = forced_profiles_.find(std::make_pair(it->first.type, it->first.scalartype_size));
+                if(fit != forced_profiles_.end())
+                  sit->profile = fit->second;
+                else{
+                  sit->profile = profiles::get_tuned(*dit, it->first, problem_size(it), &sit->min_size, &sit->revision);
+                  sit->tuned = (sit->profile.get() != NULL);
+                  if(!sit->tuned)
+                    sit->profile = profiles::get_builtin(*dit, it->first);
+                }
+              }
+            }
+          }
+          return selected_profiles_;
+        }
+
+        /** @brief Gets the profile selected for a kernel on a device of the context */
+        selected_profile const & get_profile(std::size_t device_index, statements_type::const_iterator it) const {
+          return selected_profiles()[device_index*statements_.size() + std::distance(statements_.begin(), it)];
         }
 
       public:
@@ -226,9 +275,14 @@ namespace viennacl{
         template<class T>
         void force_profile(forced_profile_key_type key, T const & t){
           forced_profiles_.insert(std::pair<forced_profile_key_type, tools::shared_ptr<profile_base> >(key, tools::shared_ptr<profile_base>(new T(t))));
+          selected_profiles_.clear();
         }
 
         /** @brief Add a statement and the root node to the expression list
+        *
+        *   The statement is executed in the same kernel as the previously added statements if it has the same type and iteration space
+        *   (e.g. a chain of element-wise vector operations), and if it does not access data written by these statements at a different index (or vice versa).
+        *
         *   @return Whether or not the operation could be handled by the generator
         */
         bool add(scheduler::statement const & statement, scheduler::statement_node const & root_node) {
@@ -236,13 +290,16 @@ namespace viennacl{
           fill_descriptor(statement, root_node, descriptor);
           if(descriptor.type_family==INVALID_EXPRESSION_FAMILY)
             return false;
-          if(statements_.empty())
+          detail::statement_dependencies dependencies(statement, root_node);
+          if(!statements_.empty() && can_fuse(statements_.back().first, dependencies_.back(), descriptor, dependencies)){
+            statements_.back().second.push_back(std::make_pair(statement, root_node));
+            dependencies_.back().merge(dependencies);
+          }
+          else{
             statements_.push_back(std::make_pair(descriptor,profile_base::statements_type(1,std::make_pair(statement, root_node))));
-          else
-            if(statements_.back().first == descriptor)
-              statements_.back().second.push_back(std::make_pair(statement, root_node));
-            else
-              statements_.push_back(std::make_pair(descriptor,profile_base::statements_type(1,std::make_pair(statement, root_node))));
+            dependencies_.push_back(dependencies);
+          }
+          selected_profiles_.clear();
           return true;
         }
 
@@ -251,19 +308,48 @@ namespace viennacl{
           unsigned int kernel_id = 0;
           std::vector<viennacl::ocl::device>::const_iterator found = std::find(ctx_.devices().begin(),ctx_.devices().end(),ctx_.current_device());
           for(statements_type::const_iterator it = statements_.begin() ; it != statements_.end() ; ++it)
-            set_expression_arguments(get_profile(ctx_.current_device(), it->first), std::distance(ctx_.devices().begin(), found), it->second, kernel_id, p, kernels);
+            set_expression_arguments(*get_profile(std::distance(ctx_.devices().begin(), found), it).profile, std::distance(ctx_.devices().begin(), found), it->second, kernel_id, p, kernels);
         }
 
-        /** @brief Creates an identifier string for the set of expressions in the object */
-        void make_program_name(char * program_name) const {
+        /** @brief Creates an identifier string for the set of expressions in the object
+        *
+        *   The identifier only depends on the structure of the statements, on the aliasing of their operands, on the partitioning into kernels
+        *   and on the tuned profiles selected for the devices of the context (if any).
+        *   It is used as the program name, so programs are only compiled once per signature and context.
+        */
+        std::string make_program_name() const {
+          std::size_t max_length = 1;
+          for(statements_type::const_iterator it = statements_.begin() ; it != statements_.end() ; ++it){
+            max_length += 2;
+            for(profile_base::statements_type::const_iterator iit = it->second.begin() ; iit != it->second.end() ; ++iit)
+              max_length += 64*iit->first.array().size();
+          }
+
+          std::vector<char> program_name(max_length);
+          char * ptr = &program_name[0];
           unsigned int current_arg = 0;
-          void* memory[64] = {NULL};
+          std::vector<void *> memory;
           for(statements_type::const_iterator it = statements_.begin() ; it != statements_.end() ; ++it){
+            *ptr++ = 'k';
+            *ptr++ = static_cast<char>('a' + it->first.type);
             for(profile_base::statements_type::const_iterator iit = it->second.begin() ; iit != it->second.end() ; ++iit){
-              detail::traverse(iit->first, iit->second, detail::statement_representation_functor(memory, current_arg, program_name));
+              detail::traverse(iit->first, iit->second, detail::statement_representation_functor(memory, current_arg, ptr));
+            }
+          }
+          std::string name(&program_name[0], ptr);
+
+          //Kernels using a tuned profile depend on the database revision and on the size bucket:
+          for(statements_type::const_iterator it = statements_.begin() ; it != statements_.end() ; ++it){
+            for(std::size_t device_index = 0 ; device_index < ctx_.devices().size() ; ++device_index){
+              selected_profile const & selected = get_profile(device_index, it);
+              if(selected.tuned){
+                std::ostringstream oss;
+                oss << "_t" << selected.revision << "_" << std::distance(statements_.begin(), it) << "_" << device_index << "_" << selected.min_size;
+                name += oss.str();
+              }
             }
           }
-          *program_name='\0';
+          return name;
         }
 
         /** @brief Creates the OpenCL program string from the set of expressions in the object */
@@ -279,9 +365,9 @@ namespace viennacl{
           stream << std::endl;
 
           std::size_t device_offset =0;
-          for(std::vector<viennacl::ocl::device>::const_iterator it = ctx_.devices().begin() ; it != ctx_.devices().end() ; ++it)
+          for(std::size_t device_index = 0 ; device_index < ctx_.devices().size() ; ++device_index)
             for(statements_type::const_iterator iit = statements_.begin() ; iit != statements_.end() ; ++iit)
-              get_profile(*it,iit->first)(stream,device_offset++,iit->second);
+              (*get_profile(device_index, iit).profile)(stream,device_offset++,iit->second);
 
           return stream.str();
         }
@@ -294,9 +380,9 @@ namespace viennacl{
           //Creates OpenCL string with #ifdef and attributes
           utils::kernel_generation_stream stream;
           std::size_t device_offset =0;
-          for(std::vector<viennacl::ocl::device>::const_iterator it = ctx_.devices().begin() ; it != ctx_.devices().end() ; ++it)
+          for(std::size_t device_index = 0 ; device_index < ctx_.devices().size() ; ++device_index)
             for(statements_type::const_iterator iit = statements_.begin() ; iit != statements_.end() ; ++iit)
-              get_profile(*it,iit->first)(stream,device_offset++,iit->second);
+              (*get_profile(device_index, iit).profile)(stream,device_offset++,iit->second);
           std::string res = stream.str();
 
           viennacl::tools::find_and_replace(res,"__attribute__","//__attribute__");
@@ -340,8 +426,10 @@ namespace viennacl{
 
       private:
         statements_type statements_;
+        std::vector<detail::statement_dependencies> dependencies_;
         viennacl::ocl::context const & ctx_;
         forced_profiles_type forced_profiles_;
+        mutable std::vector<selected_profile> selected_profiles_;
     };
 
     /** @brief Creates the program associated with a generator object and fills the kernels. Checks the context for the program and possibly (re)compile it.
@@ -351,8 +439,7 @@ namespace viennacl{
     *   @param force_recompilation if true, the program will be recompiled
     */
     inline viennacl::ocl::program & get_configured_program(viennacl::generator::code_generator const & generator, std::list<viennacl::ocl::kernel*> & kernels, bool force_recompilation = false){
-      char* program_name = (char*)malloc(256*sizeof(char));
-      generator.make_program_name(program_name);
+      std::string program_name = generator.make_program_name();
       if(force_recompilation)
         viennacl::ocl::current_context().delete_program(program_name);
       if(!viennacl::ocl::current_context().has_program(program_name)){
@@ -103,7 +103,7 @@ namespace viennacl{
         }
 
         static std::string csv_format() {
-          return "Vec,LSize1,CacheWidth,LSize2,mS,kS,nS,NumGroups";
+          return "Vec,LSize1,CacheWidth,LSize2,mS,kS,nS,UseLhsShared,UseRhsShared";
         }
 
         std::string csv_representation() const{
@@ -25,12 +25,19 @@
 */
 
 #include <map>
+#include <vector>
+#include <string>
+#include <fstream>
+#include <sstream>
+#include <iostream>
+#include <cstdlib>
 
 #include "viennacl/ocl/device.hpp"
 
 #include "viennacl/generator/forwards.h"
 
 #include "viennacl/tools/shared_ptr.hpp"
+#include "viennacl/tools/mutex.hpp"
 
 #include "viennacl/generator/profile_base.hpp"
 #include "viennacl/generator/saxpy.hpp"
@@ -266,16 +273,343 @@ namespace viennacl{
       }
       static database_type database = init_database();
 
+      /*---------------------------*/
+      /*     Tuned profiles        */
+      /*---------------------------*/
+
+      /** @brief Tuned profiles of an operation, indexed by the smallest problem size (number of elements of the iteration space) they are used for */
+      typedef std::map<std::size_t, profile_base_ptr> size_bucket_map;
+
+      struct tuned_expression_map : public map_wrapper<expression_key_type, size_bucket_map>{ };
+      struct tuned_device_name_map : public map_wrapper<device_name_type, tuned_expression_map>{ };
+      struct tuned_device_type_map : public map_wrapper<device_type, tuned_device_name_map>{ };
+      struct tuned_database_type : public map_wrapper<vendor_id_type, tuned_device_type_map>{ };
+
+      inline bool load_database(std::string const & filename, std::string * error_message = NULL);
+
+      namespace detail{
+
+        template <bool dummy = false>  //never use parameter other than default (introduced for linkage issues only)
+        struct tuned_database_lock
+        {
+          static viennacl::tools::mutex mutex_;
+        };
+
+        template <bool dummy>
+        viennacl::tools::mutex tuned_database_lock<dummy>::mutex_;
+
+        inline tuned_database_type & tuned_database_impl(){
+          static tuned_database_type db;
+          return db;
+        }
+
+        inline unsigned int & tuned_database_revision_impl(){
+          static unsigned int revision = 0;
+          return revision;
+        }
+
+        /** @brief One line of a database file */
+        struct tuned_entry{
+            vendor_id_type vendor_id;
+            device_type dev_type;
+            device_name_type device_name;
+            expression_key_type key;
+            std::size_t min_size;
+            profile_base_ptr profile;
+        };
+
+        inline const char * expression_type_to_id(expression_type type){
+          switch(type){
+            case VECTOR_SAXPY_TYPE : return "vector_saxpy";
+            case MATRIX_SAXPY_TYPE : return "matrix_saxpy";
+            case SCALAR_REDUCE_TYPE : return "scalar_reduce";
+            case VECTOR_REDUCE_Nx_TYPE : return "vector_reduce_Nx";
+            case VECTOR_REDUCE_Tx_TYPE : return "vector_reduce_Tx";
+            case MATRIX_PRODUCT_NN_TYPE : return "matrix_product_NN";
+            case MATRIX_PRODUCT_TN_TYPE : return "matrix_product_TN";
+            case MATRIX_PRODUCT_NT_TYPE : return "matrix_product_NT";
+            case MATRIX_PRODUCT_TT_TYPE : return "matrix_product_TT";
+            default : return "invalid";
+          }
+        }
+
+        inline expression_type expression_type_from_id(std::string const & id){
+          for(int t = 0 ; t < INVALID_EXPRESSION_TYPE ; ++t)
+            if(id == expression_type_to_id(expression_type(t)))
+              return expression_type(t);
+          return INVALID_EXPRESSION_TYPE;
+        }
+
+        inline std::string device_type_to_id(device_type type){
+          switch(type){
+            case CL_DEVICE_TYPE_CPU : return "CPU";
+            case CL_DEVICE_TYPE_GPU : return "GPU";
+            case CL_DEVICE_TYPE_ACCELERATOR : return "ACCELERATOR";
+            default :{
+              std::ostringstream oss;
+              oss << type;
+              return oss.str();
+            }
+          }
+        }
+
+        inline std::string trim(std::string const & str){
+          std::string::size_type first = str.find_first_not_of(" \t\r\n");
+          if(first==std::string::npos)
+            return "";
+          return str.substr(first, str.find_last_not_of(" \t\r\n") - first + 1);
+        }
+
+        inline std::vector<std::string> split(std::string const & str, char separator){
+          std::vector<std::string> res;
+          std::string::size_type begin = 0, end;
+          while((end = str.find(separator, begin)) != std::string::npos){
+            res.push_back(trim(str.substr(begin, end - begin)));
+            begin = end + 1;
+          }
+          res.push_back(trim(str.substr(begin)));
+          return res;
+        }
+
+        template<class T>
+        bool parse_unsigned(std::string const & str, T & value){
+          if(str.empty() || str.find_first_not_of("0123456789") != std::string::npos)
+            return false;
+          std::istringstream iss(str);
+          iss >> value;
+          return !iss.fail();
+        }
+
+        inline bool device_type_from_id(std::string const & id, device_type & type){
+          if(id=="CPU")              type = CL_DEVICE_TYPE_CPU;
+          else if(id=="GPU")         type = CL_DEVICE_TYPE_GPU;
+          else if(id=="ACCELERATOR") type = CL_DEVICE_TYPE_ACCELERATOR;
+          else                       return parse_unsigned(id, type);
+          return true;
+        }
+
+        /** @brief Creates a profile from its parameters, given in the order of the csv_format() of the profile. Returns an empty pointer if the number of parameters does not match. */
+        inline profile_base_ptr make_profile(expression_type type, std::vector<unsigned int> const & p){
+          switch(type){
+            case VECTOR_SAXPY_TYPE :
+              if(p.size()==4) return profile_base_ptr(new vector_saxpy(p[0], p[1], p[2], p[3]));
+              break;
+            case MATRIX_SAXPY_TYPE :
+              if(p.size()==6) return profile_base_ptr(new matrix_saxpy(p[0], p[1], p[2], p[3], p[4], p[5]));
+              break;
+            case SCALAR_REDUCE_TYPE :
+              if(p.size()==4) return profile_base_ptr(new scalar_reduction(p[0], p[1], p[2], p[3]));
+              break;
+            case VECTOR_REDUCE_Nx_TYPE :
+            case VECTOR_REDUCE_Tx_TYPE :
+              if(p.size()==4) return profile_base_ptr(new vector_reduction(p[0], p[1], p[2], p[3]));
+              break;
+            case MATRIX_PRODUCT_NN_TYPE :
+            case MATRIX_PRODUCT_TN_TYPE :
+            case MATRIX_PRODUCT_NT_TYPE :
+            case MATRIX_PRODUCT_TT_TYPE :
+              if(p.size()==9) return profile_base_ptr(new matrix_product(p[0], p[1], p[2], p[3], p[4], p[5], p[6], p[7]!=0, p[8]!=0));
+              break;
+            default :
+              break;
+          }
+          return profile_base_ptr();
+        }
+
+        /** @brief Parses a line of a database file. Returns false if the line is malformed. */
+        inline bool parse_tuned_entry(std::string const & line, tuned_entry & entry){
+          std::vector<std::string> fields = split(line, ';');
+          if(fields.size()!=7)
+            return false;
+
+          expression_type type = expression_type_from_id(fields[3]);
+          if(!parse_unsigned(fields[0], entry.vendor_id) || !device_type_from_id(fields[1], entry.dev_type) || type==INVALID_EXPRESSION_TYPE
+             || !parse_unsigned(fields[4], entry.key.second) || !parse_unsigned(fields[5], entry.min_size))
+            return false;
+          entry.device_name = fields[2];
+          entry.key.first = type;
+
+          std::vector<std::string> param_strings = split(fields[6], ',');
+          std::vector<unsigned int> params(param_strings.size());
+          for(std::size_t i = 0 ; i < param_strings.size() ; ++i)
+            if(!parse_unsigned(param_strings[i], params[i]))
+              return false;
+          entry.profile = make_profile(type, params);
+          return entry.profile.get() != NULL;
+        }
+
+      }
+
+      /** @brief Returns the mutex guarding the tuned database. It must be held when accessing the database returned by tuned_database() directly. */
+      inline viennacl::tools::mutex & tuned_database_mutex(){
+        return detail::tuned_database_lock<>::mutex_;
+      }
+
+      /** @brief Returns the database of tuned profiles, which take precedence over the built-in defaults.
+      *
+      *  When accessed for the first time, the file given by the environment variable VIENNACL_GENERATOR_DATABASE (if set) is loaded.
+      *  A file which cannot be read is ignored, use load_database() to obtain the reason.
+      */
+      inline tuned_database_type & tuned_database(){
+        viennacl::tools::scoped_lock lock(tuned_database_mutex());
+        static bool initialized = false;
+        if(!initialized){
+          initialized = true;
+          if(char const * filename = std::getenv("VIENNACL_GENERATOR_DATABASE"))
+            load_database(filename);
+        }
+        return detail::tuned_database_impl();
+      }
+
+      /** @brief Returns a counter which is incremented whenever the tuned database changes. Generated programs are tagged with it. */
+      inline unsigned int tuned_database_revision(){
+        viennacl::tools::scoped_lock lock(tuned_database_mutex());
+        return detail::tuned_database_revision_impl();
+      }
+
+      /** @brief Stores a tuned profile. It is used for problem sizes starting at 'min_size', up to the next larger 'min_size' stored for the same operation and device. */
+      inline void set_tuned_profile(vendor_id_type vendor_id, device_type dev_type, device_name_type const & device_name,
+                                    expression_key_type const & key, std::size_t min_size, profile_base_ptr const & profile){
+        viennacl::tools::scoped_lock lock(tuned_database_mutex());
+        tuned_database()[vendor_id][dev_type][device_name][key][min_size] = profile;
+        ++detail::tuned_database_revision_impl();
+      }
+
+      /** @brief Stores a tuned profile for a device */
+      inline void set_tuned_profile(viennacl::ocl::device const & device, expression_key_type const & key, std::size_t min_size, profile_base_ptr const & profile){
+        set_tuned_profile(device.vendor_id(), device.type(), device.name(), key, min_size, profile);
+      }
+
+      /** @brief Removes all tuned profiles. The built-in defaults are used again afterwards. */
+      inline void clear_tuned_profiles(){
+        viennacl::tools::scoped_lock lock(tuned_database_mutex());
+        tuned_database().map.clear();
+        ++detail::tuned_database_revision_impl();
+      }
+
+      /** @brief Returns the tuned profile for a device, an operation and a problem size, or an empty pointer if there is no valid one.
+      *
+      *  The returned profile stays valid if the database is modified or cleared afterwards.
+      *
+      *  @param min_size   If not NULL, set to the lower bound of the size bucket of the returned profile
+      *  @param revision   If not NULL, set to the revision of the database the profile was taken from
+      */
+      inline profile_base_ptr get_tuned(viennacl::ocl::device const & device, expression_descriptor const & descriptor, std::size_t problem_size,
+                                        std::size_t * min_size = NULL, unsigned int * revision = NULL){
+        viennacl::tools::scoped_lock lock(tuned_database_mutex());
+        tuned_database_type & db = tuned_database();
+        tuned_database_type::map_type::iterator vendor_it = db.map.find(device.vendor_id());
+        if(vendor_it==db.map.end())
+          return profile_base_ptr();
+        tuned_device_type_map::map_type::iterator type_it = vendor_it->second.map.find(device.type());
+        if(type_it==vendor_it->second.map.end())
+          return profile_base_ptr();
+        tuned_device_name_map::map_type::iterator name_it = type_it->second.map.find(device.name());
+        if(name_it==type_it->second.map.end())
+          return profile_base_ptr();
+        tuned_expression_map::map_type::iterator expression_it = name_it->second.map.find(descriptor.make_key());
+        if(expression_it==name_it->second.map.end())
+          return profile_base_ptr();
+
+        //The bucket with the largest lower bound not exceeding the problem size:
+        size_bucket_map::iterator bucket_it = expression_it->second.upper_bound(problem_size);
+        if(bucket_it==expression_it->second.begin())
+          return profile_base_ptr();
+        --bucket_it;
+        if(bucket_it->second.get()==NULL || bucket_it->second->is_invalid(device, descriptor.scalartype_size))
+          return profile_base_ptr();
+        if(min_size)
+          *min_size = bucket_it->first;
+        if(revision)
+          *revision = detail::tuned_database_revision_impl();
+        return bucket_it->second;
+      }
+
+      /** @brief Loads tuned profiles from a file and merges them into the tuned database, replacing entries with the same key.
+      *
+      *  Each line which is neither empty nor starts with '#' holds one profile:
+      *
+      *    vendor_id;device_type;device_name;operation;scalartype_size;min_size;parameters
+      *
+      *  e.g. "4318;GPU;GeForce GTX 470;vector_saxpy;4;65536;1,256,128,1". The comma-separated parameters are given in the order of the csv_format() of the profile.
+      *
+      *  @param error_message  If not NULL, set to a description of the problem if the file cannot be read or is malformed
+      *  @return false if the file cannot be read or is malformed. The database is left unchanged in this case.
+      */
+      inline bool load_database(std::string const & filename, std::string * error_message){
+        std::ifstream file(filename.c_str());
+        if(!file){
+          if(error_message)
+            *error_message = "Cannot open file " + filename;
+          return false;
+        }
+
+        std::vector<detail::tuned_entry> entries;
+        std::string line;
+        std::size_t linenum = 0;
+        while(std::getline(file, line)){
+          ++linenum;
+          line = detail::trim(line);
+          if(line.empty() || line[0]=='#')
+            continue;
+          detail::tuned_entry entry;
+          if(!detail::parse_tuned_entry(line, entry)){
+            if(error_message){
+              std::ostringstream oss;
+              oss << "Malformed entry in file " << filename << " at line " << linenum;
+              *error_message = oss.str();
+            }
+            return false;
+          }
+          entries.push_back(entry);
+        }
+
+        //all entries are merged at once, so that other threads see either none or all of them:
+        viennacl::tools::scoped_lock lock(tuned_database_mutex());
+        for(std::vector<detail::tuned_entry>::const_iterator it = entries.begin() ; it != entries.end() ; ++it)
+          set_tuned_profile(it->vendor_id, it->dev_type, it->device_name, it->key, it->min_size, it->profile);
+        return true;
+      }
+
+      /** @brief Writes all tuned profiles to a file in the format read by load_database()
+      *
+      *  @param error_message  If not NULL, set to a description of the problem if the file cannot be written
+      *  @return false if the file could not be written
+      */
+      inline bool save_database(std::string const & filename, std::string * error_message = NULL){
+        std::ofstream file(filename.c_str());
+        if(!file){
+          if(error_message)
+            *error_message = "Cannot write file " + filename;
+          return false;
+        }
+
+        file << "# ViennaCL generator database" << std::endl;
+        file << "# vendor_id;device_type;device_name;operation;scalartype_size;min_size;parameters" << std::endl;
+        viennacl::tools::scoped_lock lock(tuned_database_mutex());
+        tuned_database_type const & db = tuned_database();
+        for(tuned_database_type::map_type::const_iterator vendor_it = db.map.begin() ; vendor_it != db.map.end() ; ++vendor_it)
+          for(tuned_device_type_map::map_type::const_iterator type_it = vendor_it->second.map.begin() ; type_it != vendor_it->second.map.end() ; ++type_it)
+            for(tuned_device_name_map::map_type::const_iterator name_it = type_it->second.map.begin() ; name_it != type_it->second.map.end() ; ++name_it)
+              for(tuned_expression_map::map_type::const_iterator expression_it = name_it->second.map.begin() ; expression_it != name_it->second.map.end() ; ++expression_it)
+                for(size_bucket_map::const_iterator bucket_it = expression_it->second.begin() ; bucket_it != expression_it->second.end() ; ++bucket_it)
+                  if(bucket_it->second.get())
+                    file << vendor_it->first << ";" << detail::device_type_to_id(type_it->first) << ";" << name_it->first
+                         << ";" << detail::expression_type_to_id(expression_it->first.first) << ";" << expression_it->first.second
+                         << ";" << bucket_it->first << ";" << bucket_it->second->csv_representation() << std::endl;
+        return file.good();
+      }
+
       /** @brief If the fallback is too harsh, use a very conservative profile */
-      static profile_base * handle_failure(viennacl::ocl::device const & device, expression_descriptor const & descriptor, tools::shared_ptr<profile_base> const & profile){
+      static profile_base_ptr handle_failure(viennacl::ocl::device const & device, expression_descriptor const & descriptor, profile_base_ptr const & profile){
         //Returns default if the profile is invalid
         if(profile->is_invalid(device, descriptor.scalartype_size))
-          return database.map.at(unknown_id).map.at(device.type()).map.at(UNKNOWN).map.at("").map.at(descriptor.make_key()).get();
-        return profile.get();
+          return database.map.at(unknown_id).map.at(device.type()).map.at(UNKNOWN).map.at("").map.at(descriptor.make_key());
+        return profile;
       }
 
-      /** @brief Get the profile for a device and a descriptor */
-      static profile_base * get(viennacl::ocl::device const & device, expression_descriptor const & descriptor){
+      /** @brief Get the profile for a device and a descriptor from the built-in database */
+      static profile_base_ptr get_builtin(viennacl::ocl::device const & device, expression_descriptor const & descriptor){
         device_type dev_type = device.type();
         vendor_id_type vendor_id = device.vendor_id();
         device_architecture_family device_architecture = device.architecture_family();
@@ -321,6 +655,19 @@ namespace viennacl{
         return handle_failure(device, descriptor, database.map.at(vendor_id).map.at(dev_type).map.at(device_architecture).map.at(device_name).map.at(expression_key));
       }
 
+      /** @brief Get the profile for a device and a descriptor
+      *
+      *  Tuned profiles for the problem size are preferred over the built-in database.
+      *
+      *  @param problem_size   The number of elements of the iteration space of the operation
+      */
+      static profile_base_ptr get(viennacl::ocl::device const & device, expression_descriptor const & descriptor, std::size_t problem_size = 0){
+        profile_base_ptr tuned = get_tuned(device, descriptor, problem_size);
+        if(tuned.get())
+          return tuned;
+        return get_builtin(device, descriptor);
+      }
+
     }
 
   }
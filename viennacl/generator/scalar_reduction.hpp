@@ -45,28 +45,22 @@ namespace viennacl{
       private:
         typedef std::vector<std::pair<const char *, viennacl::ocl::handle<cl_mem> > > temporaries_type;
 
-        static void fill_scalartypes(statements_type statements, std::vector<const char *> & res){
-          res.reserve(statements.size());
+        static void fill_scalartypes(std::vector<detail::mapped_scalar_reduction*> const & exprs, std::vector<const char *> & res){
+          res.reserve(exprs.size());
+          for(std::vector<detail::mapped_scalar_reduction*>::const_iterator it = exprs.begin() ; it != exprs.end() ; ++it)
+            res.push_back((*it)->scalartype().c_str());
+        }
+
+        /** @brief Returns the number of inner products computed by the statements */
+        static std::size_t num_reductions(statements_type const & statements){
+          std::size_t res = 0;
           for(statements_type::const_iterator it = statements.begin() ; it != statements.end() ; ++it){
-            if (it->second.lhs.type_family == scheduler::SCALAR_TYPE_FAMILY)
-            {
-              switch(it->second.lhs.numeric_type){
-                case scheduler::FLOAT_TYPE:
-                  res.push_back("float");
-                  break;
-                case scheduler::DOUBLE_TYPE:
-                  res.push_back("double");
-                  break;
-                default:
-                  res.push_back("");
-                  break;
-              }
-            }
-            else
-            {
-              res.push_back("");
-            }
+            scheduler::statement::container_type const & array = it->first.array();
+            for(scheduler::statement::container_type::const_iterator iit = array.begin() ; iit != array.end() ; ++iit)
+              if(iit->op.type==scheduler::OPERATION_BINARY_INNER_PROD_TYPE)
+                ++res;
           }
+          return res;
         }
 
       public:
@@ -76,20 +70,19 @@ namespace viennacl{
         }
 
         void init_temporaries(statements_type const & statements) const {
-          if(temporaries_.empty()){
-            //set temporary buffer argument
+          //the temporaries are shared by all kernels using this profile, hence they are only extended if needed:
+          if(temporaries_.size() < num_reductions(statements)){
             for(statements_type::const_iterator it = statements.begin() ; it != statements.end() ; ++it){
               scheduler::statement::container_type const & array = it->first.array();
               std::size_t size_of_scalartype;
               const char * scalartype_name;
-              if (array[0].lhs.type_family != scheduler::SCALAR_TYPE_FAMILY) throw "not implemented";
-              switch(array[0].lhs.numeric_type){
+              switch(it->second.lhs.numeric_type){
                 case scheduler::FLOAT_TYPE: scalartype_name = "float"; size_of_scalartype = sizeof(float); break;
                 case scheduler::DOUBLE_TYPE: scalartype_name = "double"; size_of_scalartype = sizeof(double); break;
                 default: throw "not implemented";
               }
               for(scheduler::statement::container_type::const_iterator iit = array.begin() ; iit != array.end() ; ++iit){
-                if(iit->op.type==scheduler::OPERATION_BINARY_INNER_PROD_TYPE){
+                if(iit->op.type==scheduler::OPERATION_BINARY_INNER_PROD_TYPE && temporaries_.size() < num_reductions(statements)){
                   temporaries_.push_back(std::make_pair(scalartype_name, viennacl::ocl::current_context().create_memory(CL_MEM_READ_WRITE, num_groups_*size_of_scalartype)));
                 }
               }
@@ -176,16 +169,16 @@ namespace viennacl{
 
           //set arguments
           set_size_argument(statements.front().first, statements.front().second, n_arg, k);
-          for(temporaries_type::iterator it = temporaries_.begin() ; it != temporaries_.end() ; ++it){
-            k.arg(n_arg++, it->second);
+          for(std::size_t i = 0 ; i < num_reductions(statements) ; ++i){
+            k.arg(n_arg++, temporaries_[i].second);
           }
         }
 
         void kernel_arguments(statements_type  const & statements, std::string & arguments_string) const{
           init_temporaries(statements);
           arguments_string += detail::generate_value_kernel_argument("unsigned int", "N");
-          for(temporaries_type::iterator it = temporaries_.begin() ; it != temporaries_.end() ; ++it){
-            arguments_string += detail::generate_pointer_kernel_argument("__global", it->first, "temp" + utils::to_string(std::distance(temporaries_.begin(), it)));
+          for(std::size_t i = 0 ; i < num_reductions(statements) ; ++i){
+            arguments_string += detail::generate_pointer_kernel_argument("__global", temporaries_[i].first, "temp" + utils::to_string(i));
           }
         }
 
@@ -242,7 +235,6 @@ namespace viennacl{
             }
           }
 
-
           stream.dec_tab();
           stream << "}" << std::endl;
           //Declare and fill local memory
@@ -319,9 +311,9 @@ namespace viennacl{
           }
 
           std::size_t i = 0;
-          for(statements_type::const_iterator it = statements.begin() ; it != statements.end() ; ++it){
+          for(statements_type::const_iterator it = statements.begin() ; it != statements.end() ; ++it, ++i){
             std::string str;
-            detail::traverse(it->first, it->second, detail::expression_generation_traversal(std::make_pair("0", "0"), -1, str, mapping[i++]), false);
+            detail::traverse(it->first, it->second, detail::expression_generation_traversal(std::make_pair("0", "0"), -1, str, mapping[i]), false);
             stream << str << ";" << std::endl;
           }
 
@@ -337,7 +329,7 @@ namespace viennacl{
                 exprs.push_back(p);
 
           std::vector<const char *> scalartypes;
-          fill_scalartypes(statements, scalartypes);
+          fill_scalartypes(exprs, scalartypes);
 
           if(kernel_id==0){
             core_0(stream,exprs,scalartypes,statements,mapping);
@@ -0,0 +1,205 @@
+#ifndef VIENNACL_GENERATOR_STATEMENT_DEPENDENCIES_HPP
+#define VIENNACL_GENERATOR_STATEMENT_DEPENDENCIES_HPP
+
+/* =========================================================================
+   Copyright (c) 2010-2013, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+
+/** @file viennacl/generator/statement_dependencies.hpp
+    @brief Analysis of the memory accesses of statements, used for deciding which statements can share a kernel
+*/
+
+#include <vector>
+#include <utility>
+
+#include "viennacl/forwards.h"
+#include "viennacl/scheduler/forwards.h"
+#include "viennacl/generator/forwards.h"
+#include "viennacl/generator/utils.hpp"
+
+namespace viennacl{
+
+  namespace generator{
+
+    namespace detail{
+
+      /** @brief Access of a statement to an operand in device memory */
+      struct memory_access{
+          memory_access(cl_mem h = NULL, void const * obj = NULL, bool ew = true) : handle(h), object(obj), elementwise(ew){ }
+
+          cl_mem handle;         //the OpenCL buffer
+          void const * object;   //the vector/matrix/scalar object. Proxies of the same buffer refer to different objects
+          bool elementwise;      //true if the operand is only accessed at the current index of the kernel loop
+      };
+
+      /** @brief Functor returning the memory access associated with an operand */
+      class memory_access_functor{
+        public:
+          typedef memory_access result_type;
+
+          memory_access_functor(bool elementwise) : elementwise_(elementwise){ }
+
+          /** @brief Host scalars are passed by value */
+          template<class ScalarType>
+          result_type operator()(ScalarType const & /*scal*/) const { return memory_access(); }
+
+          /** @brief Device scalars are broadcast to all work items */
+          template<class ScalarType>
+          result_type operator()(scalar<ScalarType> const & scal) const { return memory_access(scal.handle().opencl_handle().get(), &scal, false); }
+
+          template<class ScalarType>
+          result_type operator()(vector_base<ScalarType> const & vec) const { return memory_access(vec.handle().opencl_handle().get(), &vec, elementwise_); }
+
+          template<class ScalarType>
+          result_type operator()(implicit_vector_base<ScalarType> const & /*vec*/) const { return memory_access(); }
+
+          template<class ScalarType, class Layout>
+          result_type operator()(matrix_base<ScalarType, Layout> const & mat) const { return memory_access(mat.handle().opencl_handle().get(), &mat, elementwise_); }
+
+          template<class ScalarType>
+          result_type operator()(implicit_matrix_base<ScalarType> const & /*mat*/) const { return memory_access(); }
+
+        private:
+          bool elementwise_;
+      };
+
+      /** @brief Summary of the memory accesses and of the iteration space of a statement (or of a group of statements sharing a kernel)
+      *
+      *  Two statements can only be fused into one kernel if every operand written by one of them is accessed
+      *  by the other one at the same index of the kernel loop and through the same object.
+      */
+      class statement_dependencies{
+        private:
+          static bool overlap(memory_access const & a, memory_access const & b){
+            if(a.handle==NULL || a.handle!=b.handle)
+              return false;
+            return !a.elementwise || !b.elementwise || a.object!=b.object;
+          }
+
+          static bool overlap(std::vector<memory_access> const & a, std::vector<memory_access> const & b){
+            for(std::vector<memory_access>::const_iterator it = a.begin() ; it != a.end() ; ++it)
+              for(std::vector<memory_access>::const_iterator iit = b.begin() ; iit != b.end() ; ++iit)
+                if(overlap(*it, *iit))
+                  return true;
+            return false;
+          }
+
+          /** @brief Returns the first leaf of the given type family below an operand */
+          static scheduler::lhs_rhs_element const * first_leaf(scheduler::statement const & statement, scheduler::lhs_rhs_element const & element, scheduler::statement_node_type_family family){
+            if(element.type_family==family)
+              return &element;
+            if(element.type_family!=scheduler::COMPOSITE_OPERATION_FAMILY)
+              return NULL;
+            scheduler::statement_node const & node = statement.array()[element.node_index];
+            if(scheduler::lhs_rhs_element const * res = first_leaf(statement, node.lhs, family))
+              return res;
+            if(node.op.type_family==scheduler::OPERATION_BINARY_TYPE_FAMILY)
+              return first_leaf(statement, node.rhs, family);
+            return NULL;
+          }
+
+          void add_read(scheduler::lhs_rhs_element const & element, bool elementwise){
+            if(element.type_family!=scheduler::COMPOSITE_OPERATION_FAMILY)
+              reads_.push_back(utils::call_on_element(element, memory_access_functor(elementwise)));
+          }
+
+          void collect(scheduler::statement const & statement, scheduler::statement_node const & node, bool elementwise){
+            bool operands_elementwise = elementwise;
+            switch(node.op.type){
+              case scheduler::OPERATION_BINARY_INNER_PROD_TYPE:
+                //the operands of an inner product are accessed at the index of the kernel loop:
+                if(scheduler::lhs_rhs_element const * vec = first_leaf(statement, node.lhs, scheduler::VECTOR_TYPE_FAMILY))
+                  if(loop_size_.first==0)
+                    loop_size_ = std::make_pair(utils::call_on_vector(*vec, utils::internal_size_fun()), std::size_t(1));
+                operands_elementwise = true;
+                break;
+              case scheduler::OPERATION_BINARY_MAT_VEC_PROD_TYPE:
+                if(scheduler::lhs_rhs_element const * mat = first_leaf(statement, node.lhs, scheduler::MATRIX_TYPE_FAMILY))
+                  if(mat->subtype!=scheduler::IMPLICIT_MATRIX_TYPE)
+                    loop_size_ = std::make_pair(utils::call_on_matrix(*mat, utils::internal_size1_fun()), utils::call_on_matrix(*mat, utils::internal_size2_fun()));
+                operands_elementwise = false;
+                break;
+              case scheduler::OPERATION_BINARY_MAT_MAT_PROD_TYPE:
+              case scheduler::OPERATION_UNARY_TRANS_TYPE:
+                operands_elementwise = false;
+                break;
+              default:
+                break;
+            }
+
+            if(node.lhs.type_family==scheduler::COMPOSITE_OPERATION_FAMILY)
+              collect(statement, statement.array()[node.lhs.node_index], operands_elementwise);
+            else
+              add_read(node.lhs, operands_elementwise);
+
+            if(node.op.type_family==scheduler::OPERATION_BINARY_TYPE_FAMILY){
+              if(node.rhs.type_family==scheduler::COMPOSITE_OPERATION_FAMILY)
+                collect(statement, statement.array()[node.rhs.node_index], operands_elementwise);
+              else
+                add_read(node.rhs, operands_elementwise);
+            }
+          }
+
+        public:
+          /** @brief Analyzes the statement with root node 'root_node' */
+          statement_dependencies(scheduler::statement const & statement, scheduler::statement_node const & root_node) : loop_size_(0, 1){
+            scheduler::lhs_rhs_element const & lhs = root_node.lhs;
+
+            //the result:
+            bool elementwise = (lhs.type_family!=scheduler::SCALAR_TYPE_FAMILY);
+            writes_.push_back(utils::call_on_element(lhs, memory_access_functor(elementwise)));
+            if(root_node.op.type!=scheduler::OPERATION_BINARY_ASSIGN_TYPE)
+              reads_.push_back(writes_.back());
+
+            if(lhs.type_family==scheduler::VECTOR_TYPE_FAMILY)
+              loop_size_ = std::make_pair(utils::call_on_vector(lhs, utils::internal_size_fun()), std::size_t(1));
+            else if(lhs.type_family==scheduler::MATRIX_TYPE_FAMILY)
+              loop_size_ = std::make_pair(utils::call_on_matrix(lhs, utils::internal_size1_fun()), utils::call_on_matrix(lhs, utils::internal_size2_fun()));
+
+            //the operands:
+            if(root_node.rhs.type_family==scheduler::COMPOSITE_OPERATION_FAMILY)
+              collect(statement, statement.array()[root_node.rhs.node_index], elementwise);
+            else
+              add_read(root_node.rhs, elementwise);
+          }
+
+          /** @brief Adds the accesses of a statement executed after the ones summarized by this object in the same kernel. The iteration space is not altered. */
+          void merge(statement_dependencies const & later){
+            reads_.insert(reads_.end(), later.reads_.begin(), later.reads_.end());
+            writes_.insert(writes_.end(), later.writes_.begin(), later.writes_.end());
+          }
+
+          /** @brief Returns true if the statement 'later' cannot be executed in the same kernel, because it accesses data written by this statement at a different index (or vice versa) */
+          bool conflicts_with(statement_dependencies const & later) const{
+            return overlap(later.reads_, writes_) || overlap(later.writes_, reads_) || overlap(later.writes_, writes_);
+          }
+
+          /** @brief The iteration space: the internal size of the result for element-wise operations, the internal size of the vectors for inner products, the internal sizes of the matrix for matrix-vector products */
+          std::pair<std::size_t, std::size_t> const & loop_size() const { return loop_size_; }
+
+        private:
+          std::vector<memory_access> reads_;
+          std::vector<memory_access> writes_;
+          std::pair<std::size_t, std::size_t> loop_size_;
+      };
+
+    }
+
+  }
+
+}
+#endif
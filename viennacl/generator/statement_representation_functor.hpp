@@ -24,6 +24,7 @@
 */
 
 #include <set>
+#include <vector>
 #include <cstring>
 
 #include "viennacl/forwards.h"
@@ -48,14 +49,10 @@ namespace viennacl{
         private:
           unsigned int get_id(void * handle) const{
             unsigned int i = 0;
-            for( ; i < 64 ; ++i){
-              void* current = memory_[i];
-              if(current==NULL)
-                break;
-              if(current==handle)
+            for( ; i < memory_.size() ; ++i)
+              if(memory_[i]==handle)
                 return i;
-            }
-            memory_[i] = handle;
+            memory_.push_back(handle);
             return i;
           }
 
@@ -73,7 +70,7 @@ namespace viennacl{
         public:
           typedef void result_type;
 
-          statement_representation_functor(void* (&memory)[64], unsigned int & current_arg, char *& ptr) : memory_(memory), current_arg_(current_arg), ptr_(ptr){ }
+          statement_representation_functor(std::vector<void *> & memory, unsigned int & current_arg, char *& ptr) : memory_(memory), current_arg_(current_arg), ptr_(ptr){ }
 
           template<class ScalarType>
           result_type operator()(ScalarType const & /*scal*/) const {
@@ -155,7 +152,7 @@ namespace viennacl{
           }
 
         private:
-          void* (&memory_)[64];
+          std::vector<void *> & memory_;
           unsigned int & current_arg_;
           char *& ptr_;
       };
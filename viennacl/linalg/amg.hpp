@@ -134,6 +134,19 @@ namespace viennacl
       tag.set_coarselevels(i);
     }
 
+    /** @brief Recomputes the coarse grid operators for a new operator on the finest level. The interpolation operators from amg_setup() are reused.
+    *
+    * @param A      Operator matrices on all levels. A[0] holds the new operator.
+    * @param P      Prolongation/Interpolation operators on all levels
+    * @param tag    AMG preconditioner tag
+    */
+    template <typename InternalType1>
+    void amg_refactor(InternalType1 & A, InternalType1 & P, amg_tag const & tag)
+    {
+      for (unsigned int i=0; i<tag.get_coarselevels(); ++i)
+        detail::amg::amg_galerkin_prod(A[i], P[i], A[i+1]);
+    }
+
     /** @brief Initialize AMG preconditioner
     *
     * @param mat    System matrix
@@ -394,6 +407,24 @@ namespace viennacl
         done_init_apply = false;
       }
 
+      /** @brief Updates the preconditioner for new values of the system matrix, reusing the coarse grids and the interpolation operators of the last call to setup().
+      *
+      * Only the coarse grid operators are recomputed. This is well suited for moderate changes of the values, e.g. from one time step to the next.
+      * Call setup() again if the convergence deteriorates.
+      *
+      * @param mat  System matrix of the same size as the one passed to the constructor
+      */
+      void refactor(MatrixType const & mat)
+      {
+        A_setup[0] = SparseMatrixType(mat);
+        amg_refactor(A_setup,P_setup,tag_);
+
+        for (unsigned int i=0; i<tag_.get_coarselevels()+1; ++i)
+          A[i] = A_setup[i];
+
+        done_init_apply = false;
+      }
+
       /** @brief Prepare data structures for preconditioning:
        *  Build data structures for precondition phase.
        *  Do LU factorization on coarsest level.
@@ -629,6 +660,27 @@ namespace viennacl
         done_init_apply = false;
       }
 
+      /** @brief Updates the preconditioner for new values of the system matrix, reusing the coarse grids and the interpolation operators of the last call to setup().
+      *
+      * Only the coarse grid operators are recomputed and transferred. This is well suited for moderate changes of the values, e.g. from one time step to the next.
+      * Call setup() again if the convergence deteriorates.
+      *
+      * @param mat  System matrix of the same size as the one passed to the constructor
+      */
+      void refactor(compressed_matrix<ScalarType, MAT_ALIGNMENT> const & mat)
+      {
+        std::vector<std::map<unsigned int, ScalarType> > mat2(mat.size1());
+        viennacl::copy(mat, mat2);
+
+        A_setup[0] = SparseMatrixType(mat2);
+        amg_refactor(A_setup,P_setup,tag_);
+
+        for (unsigned int i=0; i<tag_.get_coarselevels()+1; ++i)
+          viennacl::copy(*(A_setup[i].get_internal_pointer()),A[i]);
+
+        done_init_apply = false;
+      }
+
       /** @brief Prepare data structures for preconditioning:
        *  Build data structures for precondition phase.
        *  Do LU factorization on coarsest level.
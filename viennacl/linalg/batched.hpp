@@ -0,0 +1,237 @@
+#ifndef VIENNACL_LINALG_BATCHED_HPP_
+#define VIENNACL_LINALG_BATCHED_HPP_
+
+/* =========================================================================
+   Copyright (c) 2010-2013, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/linalg/batched.hpp
+    @brief Matrix-matrix products, triangular solves and LU factorizations for batches of many small dense matrices.
+
+    All matrices of a batch reside in a single vector, their placement is described by a batch_layout.
+    A single call processes the whole batch, thus the dispatch overhead of viennacl::linalg::prod() and friends is paid once per batch rather than once per matrix.
+*/
+
+#include <cassert>
+#include "viennacl/forwards.h"
+#include "viennacl/vector.hpp"
+#include "viennacl/traits/size.hpp"
+#include "viennacl/traits/stride.hpp"
+#include "viennacl/traits/handle.hpp"
+#include "viennacl/linalg/host_based/batched_operations.hpp"
+
+#ifdef VIENNACL_WITH_OPENCL
+  #include "viennacl/linalg/opencl/batched_operations.hpp"
+#endif
+
+#ifdef VIENNACL_WITH_CUDA
+  #include "viennacl/linalg/cuda/batched_operations.hpp"
+#endif
+
+namespace viennacl
+{
+  namespace linalg
+  {
+    namespace detail
+    {
+      inline bool batched_is_lower(viennacl::linalg::lower_tag)      { return true; }
+      inline bool batched_is_lower(viennacl::linalg::unit_lower_tag) { return true; }
+      inline bool batched_is_lower(viennacl::linalg::upper_tag)      { return false; }
+      inline bool batched_is_lower(viennacl::linalg::unit_upper_tag) { return false; }
+
+      inline bool batched_is_unit(viennacl::linalg::lower_tag)      { return false; }
+      inline bool batched_is_unit(viennacl::linalg::unit_lower_tag) { return true; }
+      inline bool batched_is_unit(viennacl::linalg::upper_tag)      { return false; }
+      inline bool batched_is_unit(viennacl::linalg::unit_upper_tag) { return true; }
+
+      template <typename NumericT>
+      bool batch_fits(vector_base<NumericT> const & vec, batch_layout const & layout)
+      {
+        return viennacl::traits::stride(vec) == 1 && layout.extent() <= viennacl::traits::size(vec);
+      }
+    }
+
+    /** @brief Computes C_b = alpha * A_b * B_b + beta * C_b for all matrices b = 0, ..., batch_count - 1 of the batch.
+    *
+    * Transposed factors are obtained by passing layout.trans(). C is not read if beta is zero.
+    *
+    * @param alpha      Scaling factor for the product
+    * @param A          Vector holding the first factors
+    * @param layout_A   Layout of the first factors within A (size m x k)
+    * @param B          Vector holding the second factors
+    * @param layout_B   Layout of the second factors within B (size k x n)
+    * @param beta       Scaling factor for the previous content of C
+    * @param C          Vector holding the results, must not overlap with A or B
+    * @param layout_C   Layout of the results within C (size m x n)
+    */
+    template <typename NumericT>
+    void batched_prod(NumericT alpha,
+                      vector_base<NumericT> const & A, batch_layout const & layout_A,
+                      vector_base<NumericT> const & B, batch_layout const & layout_B,
+                      NumericT beta,
+                      vector_base<NumericT> & C, batch_layout const & layout_C)
+    {
+      assert( (layout_A.size1() == layout_C.size1()) && (layout_A.size2() == layout_B.size1()) && (layout_B.size2() == layout_C.size2()) && bool("Size mismatch in batched_prod()"));
+      assert( (layout_A.batch_count() == layout_C.batch_count()) && (layout_B.batch_count() == layout_C.batch_count()) && bool("Batch count mismatch in batched_prod()"));
+      assert( detail::batch_fits(A, layout_A) && detail::batch_fits(B, layout_B) && detail::batch_fits(C, layout_C) && bool("Batch exceeds vector in batched_prod()"));
+
+      switch (viennacl::traits::handle(C).get_active_handle_id())
+      {
+        case viennacl::MAIN_MEMORY:
+          viennacl::linalg::host_based::batched_prod(alpha, A, layout_A, B, layout_B, beta, C, layout_C);
+          break;
+#ifdef VIENNACL_WITH_OPENCL
+        case viennacl::OPENCL_MEMORY:
+          viennacl::linalg::opencl::batched_prod(alpha, A, layout_A, B, layout_B, beta, C, layout_C);
+          break;
+#endif
+#ifdef VIENNACL_WITH_CUDA
+        case viennacl::CUDA_MEMORY:
+          viennacl::linalg::cuda::batched_prod(alpha, A, layout_A, B, layout_B, beta, C, layout_C);
+          break;
+#endif
+        case viennacl::MEMORY_NOT_INITIALIZED:
+          throw memory_exception("not initialised!");
+        default:
+          throw memory_exception("not implemented");
+      }
+    }
+
+    /** @brief Solves A_b X_b = B_b for all matrices of the batch, where A_b is triangular. The solutions overwrite B.
+    *
+    * @param A          Vector holding the triangular matrices
+    * @param layout_A   Layout of the triangular matrices within A (size m x m)
+    * @param B          Vector holding the right hand sides
+    * @param layout_B   Layout of the right hand sides within B (size m x n)
+    * @param tag        One of lower_tag, unit_lower_tag, upper_tag, unit_upper_tag
+    */
+    template <typename NumericT, typename SolverTag>
+    void batched_inplace_solve(vector_base<NumericT> const & A, batch_layout const & layout_A,
+                               vector_base<NumericT> & B, batch_layout const & layout_B,
+                               SolverTag tag)
+    {
+      assert( (layout_A.size1() == layout_A.size2()) && (layout_A.size2() == layout_B.size1()) && bool("Size mismatch in batched_inplace_solve()"));
+      assert( (layout_A.batch_count() == layout_B.batch_count()) && bool("Batch count mismatch in batched_inplace_solve()"));
+      assert( detail::batch_fits(A, layout_A) && detail::batch_fits(B, layout_B) && bool("Batch exceeds vector in batched_inplace_solve()"));
+
+      bool lower = detail::batched_is_lower(tag);
+      bool unit  = detail::batched_is_unit(tag);
+
+      switch (viennacl::traits::handle(B).get_active_handle_id())
+      {
+        case viennacl::MAIN_MEMORY:
+          viennacl::linalg::host_based::batched_inplace_solve(A, layout_A, B, layout_B, lower, unit);
+          break;
+#ifdef VIENNACL_WITH_OPENCL
+        case viennacl::OPENCL_MEMORY:
+          viennacl::linalg::opencl::batched_inplace_solve(A, layout_A, B, layout_B, lower, unit);
+          break;
+#endif
+#ifdef VIENNACL_WITH_CUDA
+        case viennacl::CUDA_MEMORY:
+          viennacl::linalg::cuda::batched_inplace_solve(A, layout_A, B, layout_B, lower, unit);
+          break;
+#endif
+        case viennacl::MEMORY_NOT_INITIALIZED:
+          throw memory_exception("not initialised!");
+        default:
+          throw memory_exception("not implemented");
+      }
+    }
+
+    /** @brief LU factorization with partial pivoting of all (n x n) matrices of the batch in place.
+    *
+    * The pivots of the b-th matrix are stored in entries b*n, ..., b*n + n - 1 of 'pivots', using the same 0-based convention as viennacl::linalg::lu_factorize():
+    * row i has been swapped with row pivots[b*n + i]. A zero pivot does not abort the factorization, it shows up as a zero on the diagonal of U instead.
+    *
+    * @param A          Vector holding the matrices, overwritten by the LU factors (unit lower triangular L below the diagonal)
+    * @param layout_A   Layout of the matrices within A (size n x n)
+    * @param pivots     Vector of at least batch_count * n entries receiving the pivots
+    */
+    template <typename NumericT>
+    void batched_lu_factorize(vector_base<NumericT> & A, batch_layout const & layout_A,
+                              vector_base<unsigned int> & pivots)
+    {
+      assert( (layout_A.size1() == layout_A.size2()) && bool("Batched LU factorization requires square matrices"));
+      assert( detail::batch_fits(A, layout_A) && bool("Batch exceeds vector in batched_lu_factorize()"));
+      assert( (viennacl::traits::stride(pivots) == 1) && (viennacl::traits::size(pivots) >= layout_A.batch_count() * layout_A.size1()) && bool("Pivot vector too small in batched_lu_factorize()"));
+
+      switch (viennacl::traits::handle(A).get_active_handle_id())
+      {
+        case viennacl::MAIN_MEMORY:
+          viennacl::linalg::host_based::batched_lu_factorize(A, layout_A, pivots);
+          break;
+#ifdef VIENNACL_WITH_OPENCL
+        case viennacl::OPENCL_MEMORY:
+          viennacl::linalg::opencl::batched_lu_factorize(A, layout_A, pivots);
+          break;
+#endif
+#ifdef VIENNACL_WITH_CUDA
+        case viennacl::CUDA_MEMORY:
+          viennacl::linalg::cuda::batched_lu_factorize(A, layout_A, pivots);
+          break;
+#endif
+        case viennacl::MEMORY_NOT_INITIALIZED:
+          throw memory_exception("not initialised!");
+        default:
+          throw memory_exception("not implemented");
+      }
+    }
+
+    /** @brief Solves A_b X_b = B_b for all matrices of the batch, where A_b is given by the LU factors and pivots computed by batched_lu_factorize(). The solutions overwrite B.
+    *
+    * @param LU          Vector holding the LU factors
+    * @param layout_LU   Layout of the LU factors within LU (size n x n)
+    * @param pivots      The pivots computed by batched_lu_factorize()
+    * @param B           Vector holding the right hand sides
+    * @param layout_B    Layout of the right hand sides within B (size n x num_rhs)
+    */
+    template <typename NumericT>
+    void batched_lu_substitute(vector_base<NumericT> const & LU, batch_layout const & layout_LU,
+                               vector_base<unsigned int> const & pivots,
+                               vector_base<NumericT> & B, batch_layout const & layout_B)
+    {
+      assert( (layout_LU.size1() == layout_LU.size2()) && (layout_LU.size2() == layout_B.size1()) && bool("Size mismatch in batched_lu_substitute()"));
+      assert( (layout_LU.batch_count() == layout_B.batch_count()) && bool("Batch count mismatch in batched_lu_substitute()"));
+      assert( detail::batch_fits(LU, layout_LU) && detail::batch_fits(B, layout_B) && bool("Batch exceeds vector in batched_lu_substitute()"));
+      assert( (viennacl::traits::stride(pivots) == 1) && (viennacl::traits::size(pivots) >= layout_LU.batch_count() * layout_LU.size1()) && bool("Pivot vector too small in batched_lu_substitute()"));
+
+      switch (viennacl::traits::handle(B).get_active_handle_id())
+      {
+        case viennacl::MAIN_MEMORY:
+          viennacl::linalg::host_based::batched_lu_substitute(LU, layout_LU, pivots, B, layout_B);
+          break;
+#ifdef VIENNACL_WITH_OPENCL
+        case viennacl::OPENCL_MEMORY:
+          viennacl::linalg::opencl::batched_lu_substitute(LU, layout_LU, pivots, B, layout_B);
+          break;
+#endif
+#ifdef VIENNACL_WITH_CUDA
+        case viennacl::CUDA_MEMORY:
+          viennacl::linalg::cuda::batched_lu_substitute(LU, layout_LU, pivots, B, layout_B);
+          break;
+#endif
+        case viennacl::MEMORY_NOT_INITIALIZED:
+          throw memory_exception("not initialised!");
+        default:
+          throw memory_exception("not implemented");
+      }
+    }
+
+  }
+}
+
+#endif
@@ -50,7 +50,7 @@ namespace viennacl
         * @param max_iters_before_restart   The maximum number of iterations before BiCGStab is reinitialized (to avoid accumulation of round-off errors)
         */
         bicgstab_tag(double tol = 1e-8, std::size_t max_iters = 400, std::size_t max_iters_before_restart = 200)
-          : tol_(tol), iterations_(max_iters), iterations_before_restart_(max_iters_before_restart) {};
+          : tol_(tol), iterations_(max_iters), iterations_before_restart_(max_iters_before_restart), iters_taken_(0), last_error_(0) {};
 
         /** @brief Returns the relative tolerance */
         double tolerance() const { return tol_; }
@@ -113,7 +113,11 @@ namespace viennacl
       CPU_ScalarType residual_norm = norm_rhs_host;
 
       if (norm_rhs_host == 0) //solution is zero if RHS norm is zero
+      {
+        tag.iters(0);
+        tag.error(0);
         return result;
+      }
 
       bool restart_flag = true;
       std::size_t last_restart = 0;
@@ -209,7 +213,11 @@ namespace viennacl
       CPU_ScalarType residual_norm = norm_rhs_host;
 
       if (norm_rhs_host == 0) //solution is zero if RHS norm is zero
+      {
+        tag.iters(0);
+        tag.error(0);
         return result;
+      }
 
       bool restart_flag = true;
       std::size_t last_restart = 0;
@@ -50,7 +50,7 @@ namespace viennacl
         * @param tol              Relative tolerance for the residual (solver quits if ||r|| < tol * ||r_initial||)
         * @param max_iterations   The maximum number of iterations
         */
-        cg_tag(double tol = 1e-8, unsigned int max_iterations = 300) : tol_(tol), iterations_(max_iterations) {};
+        cg_tag(double tol = 1e-8, unsigned int max_iterations = 300) : tol_(tol), iterations_(max_iterations), iters_taken_(0), last_error_(0) {};
 
         /** @brief Returns the relative tolerance */
         double tolerance() const { return tol_; }
@@ -108,7 +108,11 @@ namespace viennacl
 
       //std::cout << "Starting CG solver iterations... " << std::endl;
       if (norm_rhs == 0) //solution is zero if RHS norm is zero
+      {
+        tag.iters(0);
+        tag.error(0);
         return result;
+      }
 
       for (unsigned int i = 0; i < tag.max_iterations(); ++i)
       {
@@ -176,7 +180,11 @@ namespace viennacl
       CPU_ScalarType new_ipp_rr_over_norm_rhs;
 
       if (norm_rhs_squared == 0) //solution is zero if RHS norm is zero
+      {
+        tag.iters(0);
+        tag.error(0);
         return result;
+      }
 
       for (unsigned int i = 0; i < tag.max_iterations(); ++i)
       {
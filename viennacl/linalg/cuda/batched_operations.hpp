@@ -0,0 +1,239 @@
+#ifndef VIENNACL_LINALG_CUDA_BATCHED_OPERATIONS_HPP_
+#define VIENNACL_LINALG_CUDA_BATCHED_OPERATIONS_HPP_
+
+/* =========================================================================
+   Copyright (c) 2010-2013, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/linalg/cuda/batched_operations.hpp
+    @brief Implementations of batched dense operations on many small matrices using CUDA.
+*/
+
+#include "viennacl/forwards.h"
+#include "viennacl/traits/start.hpp"
+#include "viennacl/traits/handle.hpp"
+#include "viennacl/linalg/cuda/common.hpp"
+
+namespace viennacl
+{
+  namespace linalg
+  {
+    namespace cuda
+    {
+
+      /** @brief CUDA kernel for C = alpha * A * B + beta * C, one thread per entry of C. Consecutive threads cover consecutive matrices, so a block processes many small matrices. */
+      template <typename T>
+      __global__ void batched_gemm_kernel(T alpha,
+                                          const T * A, unsigned int A_start, unsigned int A_stride1, unsigned int A_stride2, unsigned int A_batch_stride,
+                                          const T * B, unsigned int B_start, unsigned int B_stride1, unsigned int B_stride2, unsigned int B_batch_stride,
+                                          T beta,
+                                          T * C, unsigned int C_start, unsigned int C_stride1, unsigned int C_stride2, unsigned int C_batch_stride,
+                                          unsigned int size1, unsigned int size2, unsigned int size_k, unsigned int batch_count)
+      {
+        unsigned int entries = size1 * size2;
+        for (unsigned int idx = blockIdx.x * blockDim.x + threadIdx.x; idx < batch_count * entries; idx += gridDim.x * blockDim.x)
+        {
+          unsigned int b   = idx / entries;
+          unsigned int row = (idx % entries) / size2;
+          unsigned int col = idx % size2;
+          const T * A_row = A + A_start + b * A_batch_stride + row * A_stride1;
+          const T * B_col = B + B_start + b * B_batch_stride + col * B_stride2;
+          T sum = 0;
+          for (unsigned int k = 0; k < size_k; ++k)
+            sum += A_row[k * A_stride2] * B_col[k * B_stride1];
+          unsigned int index_C = C_start + b * C_batch_stride + row * C_stride1 + col * C_stride2;
+          C[index_C] = (beta != 0) ? alpha * sum + beta * C[index_C] : alpha * sum;
+        }
+      }
+
+      /** @brief CUDA kernel for A X = B with triangular A, one thread per column of B */
+      template <typename T>
+      __global__ void batched_trsm_kernel(const T * A, unsigned int A_start, unsigned int A_stride1, unsigned int A_stride2, unsigned int A_batch_stride,
+                                          T * B, unsigned int B_start, unsigned int B_stride1, unsigned int B_stride2, unsigned int B_batch_stride,
+                                          unsigned int size1, unsigned int size2, unsigned int batch_count,
+                                          unsigned int lower, unsigned int unit_diagonal)
+      {
+        for (unsigned int idx = blockIdx.x * blockDim.x + threadIdx.x; idx < batch_count * size2; idx += gridDim.x * blockDim.x)
+        {
+          unsigned int b   = idx / size2;
+          unsigned int col = idx % size2;
+          const T * A_b = A + A_start + b * A_batch_stride;
+          T * B_col = B + B_start + b * B_batch_stride + col * B_stride2;
+          for (unsigned int ii = 0; ii < size1; ++ii)
+          {
+            unsigned int i = lower ? ii : size1 - ii - 1;
+            unsigned int p_begin = lower ? 0 : i + 1;
+            unsigned int p_end   = lower ? i : size1;
+            T sum = B_col[i * B_stride1];
+            for (unsigned int p = p_begin; p < p_end; ++p)
+              sum -= A_b[i * A_stride1 + p * A_stride2] * B_col[p * B_stride1];
+            if (!unit_diagonal)
+              sum /= A_b[i * A_stride1 + i * A_stride2];
+            B_col[i * B_stride1] = sum;
+          }
+        }
+      }
+
+      /** @brief CUDA kernel for the LU factorization with partial pivoting, one thread per matrix */
+      template <typename T>
+      __global__ void batched_getrf_kernel(T * A, unsigned int A_start, unsigned int A_stride1, unsigned int A_stride2, unsigned int A_batch_stride,
+                                           unsigned int * pivots, unsigned int pivots_start,
+                                           unsigned int size, unsigned int batch_count)
+      {
+        for (unsigned int b = blockIdx.x * blockDim.x + threadIdx.x; b < batch_count; b += gridDim.x * blockDim.x)
+        {
+          T * A_b = A + A_start + b * A_batch_stride;
+          unsigned int * pivots_b = pivots + pivots_start + b * size;
+          for (unsigned int j = 0; j < size; ++j)
+          {
+            unsigned int pivot_row = j;
+            T pivot_abs = fabs(A_b[j * A_stride1 + j * A_stride2]);
+            for (unsigned int i = j + 1; i < size; ++i)
+            {
+              T val_abs = fabs(A_b[i * A_stride1 + j * A_stride2]);
+              if (val_abs > pivot_abs) { pivot_abs = val_abs; pivot_row = i; }
+            }
+            pivots_b[j] = pivot_row;
+            if (pivot_row != j)
+              for (unsigned int c = 0; c < size; ++c)
+              {
+                T tmp = A_b[j * A_stride1 + c * A_stride2];
+                A_b[j * A_stride1 + c * A_stride2] = A_b[pivot_row * A_stride1 + c * A_stride2];
+                A_b[pivot_row * A_stride1 + c * A_stride2] = tmp;
+              }
+            T diag = A_b[j * A_stride1 + j * A_stride2];
+            if (diag == 0)
+              continue;
+            for (unsigned int i = j + 1; i < size; ++i)
+            {
+              T factor = A_b[i * A_stride1 + j * A_stride2] / diag;
+              A_b[i * A_stride1 + j * A_stride2] = factor;
+              for (unsigned int c = j + 1; c < size; ++c)
+                A_b[i * A_stride1 + c * A_stride2] -= factor * A_b[j * A_stride1 + c * A_stride2];
+            }
+          }
+        }
+      }
+
+      /** @brief CUDA kernel for A X = B with A given by its LU factors and pivots, one thread per column of B */
+      template <typename T>
+      __global__ void batched_getrs_kernel(const T * LU, unsigned int LU_start, unsigned int LU_stride1, unsigned int LU_stride2, unsigned int LU_batch_stride,
+                                           const unsigned int * pivots, unsigned int pivots_start,
+                                           T * B, unsigned int B_start, unsigned int B_stride1, unsigned int B_stride2, unsigned int B_batch_stride,
+                                           unsigned int size, unsigned int num_rhs, unsigned int batch_count)
+      {
+        for (unsigned int idx = blockIdx.x * blockDim.x + threadIdx.x; idx < batch_count * num_rhs; idx += gridDim.x * blockDim.x)
+        {
+          unsigned int b   = idx / num_rhs;
+          unsigned int col = idx % num_rhs;
+          const T * LU_b = LU + LU_start + b * LU_batch_stride;
+          const unsigned int * pivots_b = pivots + pivots_start + b * size;
+          T * B_col = B + B_start + b * B_batch_stride + col * B_stride2;
+          for (unsigned int i = 0; i < size; ++i)
+            if (pivots_b[i] != i)
+            {
+              T tmp = B_col[i * B_stride1];
+              B_col[i * B_stride1] = B_col[pivots_b[i] * B_stride1];
+              B_col[pivots_b[i] * B_stride1] = tmp;
+            }
+          for (unsigned int i = 0; i < size; ++i)
+          {
+            T sum = B_col[i * B_stride1];
+            for (unsigned int p = 0; p < i; ++p)
+              sum -= LU_b[i * LU_stride1 + p * LU_stride2] * B_col[p * B_stride1];
+            B_col[i * B_stride1] = sum;
+          }
+          for (unsigned int ii = 0; ii < size; ++ii)
+          {
+            unsigned int i = size - ii - 1;
+            T sum = B_col[i * B_stride1];
+            for (unsigned int p = i + 1; p < size; ++p)
+              sum -= LU_b[i * LU_stride1 + p * LU_stride2] * B_col[p * B_stride1];
+            B_col[i * B_stride1] = sum / LU_b[i * LU_stride1 + i * LU_stride2];
+          }
+        }
+      }
+
+
+      /** @brief Computes C_b = alpha * A_b * B_b + beta * C_b for all matrices of the batch. See viennacl::linalg::host_based::batched_prod() for details. */
+      template <typename NumericT>
+      void batched_prod(NumericT alpha,
+                        vector_base<NumericT> const & A, batch_layout const & layout_A,
+                        vector_base<NumericT> const & B, batch_layout const & layout_B,
+                        NumericT beta,
+                        vector_base<NumericT> & C, batch_layout const & layout_C)
+      {
+        batched_gemm_kernel<<<128, 128>>>(alpha,
+                                          detail::cuda_arg<NumericT>(A), static_cast<unsigned int>(viennacl::traits::start(A) + layout_A.start()),
+                                          static_cast<unsigned int>(layout_A.stride1()), static_cast<unsigned int>(layout_A.stride2()), static_cast<unsigned int>(layout_A.batch_stride()),
+                                          detail::cuda_arg<NumericT>(B), static_cast<unsigned int>(viennacl::traits::start(B) + layout_B.start()),
+                                          static_cast<unsigned int>(layout_B.stride1()), static_cast<unsigned int>(layout_B.stride2()), static_cast<unsigned int>(layout_B.batch_stride()),
+                                          beta,
+                                          detail::cuda_arg<NumericT>(C), static_cast<unsigned int>(viennacl::traits::start(C) + layout_C.start()),
+                                          static_cast<unsigned int>(layout_C.stride1()), static_cast<unsigned int>(layout_C.stride2()), static_cast<unsigned int>(layout_C.batch_stride()),
+                                          static_cast<unsigned int>(layout_C.size1()), static_cast<unsigned int>(layout_C.size2()), static_cast<unsigned int>(layout_A.size2()),
+                                          static_cast<unsigned int>(layout_C.batch_count()));
+        VIENNACL_CUDA_LAST_ERROR_CHECK("batched_gemm_kernel");
+      }
+
+      /** @brief Solves A_b X_b = B_b in place of B_b for all matrices of the batch, where A_b is triangular. See viennacl::linalg::host_based::batched_inplace_solve() for details. */
+      template <typename NumericT>
+      void batched_inplace_solve(vector_base<NumericT> const & A, batch_layout const & layout_A,
+                                 vector_base<NumericT> & B, batch_layout const & layout_B,
+                                 bool lower, bool unit_diagonal)
+      {
+        batched_trsm_kernel<<<128, 128>>>(detail::cuda_arg<NumericT>(A), static_cast<unsigned int>(viennacl::traits::start(A) + layout_A.start()),
+                                          static_cast<unsigned int>(layout_A.stride1()), static_cast<unsigned int>(layout_A.stride2()), static_cast<unsigned int>(layout_A.batch_stride()),
+                                          detail::cuda_arg<NumericT>(B), static_cast<unsigned int>(viennacl::traits::start(B) + layout_B.start()),
+                                          static_cast<unsigned int>(layout_B.stride1()), static_cast<unsigned int>(layout_B.stride2()), static_cast<unsigned int>(layout_B.batch_stride()),
+                                          static_cast<unsigned int>(layout_B.size1()), static_cast<unsigned int>(layout_B.size2()), static_cast<unsigned int>(layout_B.batch_count()),
+                                          static_cast<unsigned int>(lower ? 1 : 0), static_cast<unsigned int>(unit_diagonal ? 1 : 0));
+        VIENNACL_CUDA_LAST_ERROR_CHECK("batched_trsm_kernel");
+      }
+
+      /** @brief LU factorization with partial pivoting of all matrices of the batch in place. See viennacl::linalg::host_based::batched_lu_factorize() for details. */
+      template <typename NumericT>
+      void batched_lu_factorize(vector_base<NumericT> & A, batch_layout const & layout_A,
+                                vector_base<unsigned int> & pivots)
+      {
+        batched_getrf_kernel<<<128, 128>>>(detail::cuda_arg<NumericT>(A), static_cast<unsigned int>(viennacl::traits::start(A) + layout_A.start()),
+                                           static_cast<unsigned int>(layout_A.stride1()), static_cast<unsigned int>(layout_A.stride2()), static_cast<unsigned int>(layout_A.batch_stride()),
+                                           detail::cuda_arg<unsigned int>(pivots), static_cast<unsigned int>(viennacl::traits::start(pivots)),
+                                           static_cast<unsigned int>(layout_A.size1()), static_cast<unsigned int>(layout_A.batch_count()));
+        VIENNACL_CUDA_LAST_ERROR_CHECK("batched_getrf_kernel");
+      }
+
+      /** @brief Solves A_b X_b = B_b in place of B_b for all matrices of the batch, where A_b is given by its LU factors. See viennacl::linalg::host_based::batched_lu_substitute() for details. */
+      template <typename NumericT>
+      void batched_lu_substitute(vector_base<NumericT> const & LU, batch_layout const & layout_LU,
+                                 vector_base<unsigned int> const & pivots,
+                                 vector_base<NumericT> & B, batch_layout const & layout_B)
+      {
+        batched_getrs_kernel<<<128, 128>>>(detail::cuda_arg<NumericT>(LU), static_cast<unsigned int>(viennacl::traits::start(LU) + layout_LU.start()),
+                                           static_cast<unsigned int>(layout_LU.stride1()), static_cast<unsigned int>(layout_LU.stride2()), static_cast<unsigned int>(layout_LU.batch_stride()),
+                                           detail::cuda_arg<unsigned int>(pivots), static_cast<unsigned int>(viennacl::traits::start(pivots)),
+                                           detail::cuda_arg<NumericT>(B), static_cast<unsigned int>(viennacl::traits::start(B) + layout_B.start()),
+                                           static_cast<unsigned int>(layout_B.stride1()), static_cast<unsigned int>(layout_B.stride2()), static_cast<unsigned int>(layout_B.batch_stride()),
+                                           static_cast<unsigned int>(layout_LU.size1()), static_cast<unsigned int>(layout_B.size2()), static_cast<unsigned int>(layout_B.batch_count()));
+        VIENNACL_CUDA_LAST_ERROR_CHECK("batched_getrs_kernel");
+      }
+
+    } // namespace cuda
+  } //namespace linalg
+} //namespace viennacl
+
+
+#endif
@@ -0,0 +1,85 @@
+#ifndef VIENNACL_LINALG_CUDA_NMF_OPERATIONS_HPP_
+#define VIENNACL_LINALG_CUDA_NMF_OPERATIONS_HPP_
+
+/* =========================================================================
+   Copyright (c) 2010-2013, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/linalg/cuda/nmf_operations.hpp
+    @brief Implementations of the multiplicative updates of the nonnegative matrix factorization using CUDA.
+*/
+
+#include "viennacl/forwards.h"
+#include "viennacl/matrix.hpp"
+#include "viennacl/linalg/prod.hpp"
+#include "viennacl/traits/size.hpp"
+#include "viennacl/traits/handle.hpp"
+#include "viennacl/linalg/cuda/common.hpp"
+
+namespace viennacl
+{
+  namespace linalg
+  {
+    namespace cuda
+    {
+
+      /** @brief CUDA kernel for the fused element-wise update matrix1 <- matrix1 * matrix2 / matrix3 */
+      template <typename T>
+      __global__ void el_wise_mul_div(T * matrix1,
+                                      T const * matrix2,
+                                      T const * matrix3,
+                                      unsigned int size)
+      {
+        for (unsigned int i = blockIdx.x * blockDim.x + threadIdx.x; i < size; i += gridDim.x * blockDim.x)
+        {
+          T val = matrix1[i] * matrix2[i];
+          T divisor = matrix3[i];
+          matrix1[i] = (divisor > (T)0.00001) ? (val / divisor) : T(0);
+        }
+      }
+
+      /** @brief Multiplicative Lee-Seung update of a factor: X_ij <- X_ij * N_ij / (X * S)_ij
+      *
+      * The denominator is computed by a dense matrix-matrix product, the multiplication and the division are fused into a single kernel.
+      * X and N must not be proxy objects, since the kernel runs over the full (padded) buffers.
+      *
+      * @param X    The factor to be updated (size m x k)
+      * @param N    The numerator (size m x k)
+      * @param S    The symmetric Gram matrix of the other factor (size k x k)
+      */
+      template <typename NumericT, typename F>
+      void nmf_update_factor(matrix_base<NumericT, F> & X,
+                             matrix_base<NumericT, F> const & N,
+                             matrix_base<NumericT, F> const & S)
+      {
+        assert( (X.internal_size1() == N.internal_size1() && X.internal_size2() == N.internal_size2()) && bool("Layout mismatch of factor and numerator in NMF update"));
+
+        viennacl::matrix<NumericT, F> D(X.size1(), X.size2(), viennacl::traits::context(X));
+        D = viennacl::linalg::prod(X, S);
+
+        el_wise_mul_div<<<128, 128>>>(detail::cuda_arg<NumericT>(X),
+                                      detail::cuda_arg<NumericT>(N),
+                                      detail::cuda_arg<NumericT>(D),
+                                      static_cast<unsigned int>(X.internal_size1() * X.internal_size2()));
+        VIENNACL_CUDA_LAST_ERROR_CHECK("el_wise_mul_div");
+      }
+
+    } // namespace cuda
+  } //namespace linalg
+} //namespace viennacl
+
+
+#endif
@@ -0,0 +1,226 @@
+#ifndef VIENNACL_LINALG_CUDA_RANDOM_OPERATIONS_HPP_
+#define VIENNACL_LINALG_CUDA_RANDOM_OPERATIONS_HPP_
+
+/* =========================================================================
+   Copyright (c) 2010-2013, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/linalg/cuda/random_operations.hpp
+    @brief Fills vectors and matrices with random numbers from the Philox4x32-10 generator using CUDA.
+*/
+
+#include "viennacl/forwards.h"
+#include "viennacl/traits/size.hpp"
+#include "viennacl/traits/start.hpp"
+#include "viennacl/traits/stride.hpp"
+#include "viennacl/traits/handle.hpp"
+#include "viennacl/rand/utils.hpp"
+#include "viennacl/rand/uniform.hpp"
+#include "viennacl/rand/gaussian.hpp"
+#include "viennacl/linalg/cuda/common.hpp"
+
+namespace viennacl
+{
+  namespace linalg
+  {
+    namespace cuda
+    {
+      namespace detail
+      {
+        /** @brief Philox4x32-10 for the block counter (lo, hi, 0, 0), where the 64-bit counter is first_block + block */
+        __device__ uint4 philox_block(unsigned int block, unsigned int first_block_lo, unsigned int first_block_hi,
+                                      unsigned int seed, unsigned int stream_id)
+        {
+          uint4 c;
+          c.x = first_block_lo + block;
+          c.y = first_block_hi + ((c.x < first_block_lo) ? 1 : 0);
+          c.z = 0;
+          c.w = 0;
+          for (unsigned int i = 0; i < 10; ++i)
+          {
+            unsigned int hi0 = __umulhi(0xD2511F53u, c.x);
+            unsigned int lo0 = 0xD2511F53u * c.x;
+            unsigned int hi1 = __umulhi(0xCD9E8D57u, c.z);
+            unsigned int lo1 = 0xCD9E8D57u * c.z;
+            c = make_uint4(hi1 ^ c.y ^ seed, lo1, hi0 ^ c.w ^ stream_id, lo0);
+            seed      += 0x9E3779B9u;
+            stream_id += 0xBB67AE85u;
+          }
+          return c;
+        }
+
+        __device__ float  random_unit_uniform(unsigned int w, float)  { return float(w >> 8) * (1.0f / 16777216.0f); }
+        __device__ double random_unit_uniform(unsigned int w, double) { return double(w) * (1.0 / 4294967296.0); }
+
+        // explicitly rounded operations (no FMA contraction), so that uniform values agree with the host backend:
+        __device__ float  random_uniform_value(unsigned int w, float p0, float p1)    { return __fadd_rn(p0, __fmul_rn(p1, random_unit_uniform(w, float()))); }
+        __device__ double random_uniform_value(unsigned int w, double p0, double p1) { return __dadd_rn(p0, __dmul_rn(p1, random_unit_uniform(w, double()))); }
+
+        /** @brief Uniform distribution: p0 = a, p1 = b - a */
+        template <typename T>
+        __device__ void random_block(uint4 w, T p0, T p1, T * values, viennacl::rand::uniform_tag)
+        {
+          values[0] = random_uniform_value(w.x, p0, p1);
+          values[1] = random_uniform_value(w.y, p0, p1);
+          values[2] = random_uniform_value(w.z, p0, p1);
+          values[3] = random_uniform_value(w.w, p0, p1);
+        }
+
+        /** @brief Normal distribution using the Box-Muller transformation of the word pairs (x,y) and (z,w): p0 = mu, p1 = sigma */
+        template <typename T>
+        __device__ void random_block(uint4 w, T p0, T p1, T * values, viennacl::rand::gaussian_tag)
+        {
+          T two_pi = T(6.283185307179586476925286766559);
+          T r  = sqrt(T(-2) * log(T(1) - random_unit_uniform(w.x, T())));
+          T u2 = random_unit_uniform(w.y, T());
+          values[0] = p0 + p1 * r * cos(two_pi * u2);
+          values[1] = p0 + p1 * r * sin(two_pi * u2);
+          r  = sqrt(T(-2) * log(T(1) - random_unit_uniform(w.z, T())));
+          u2 = random_unit_uniform(w.w, T());
+          values[2] = p0 + p1 * r * cos(two_pi * u2);
+          values[3] = p0 + p1 * r * sin(two_pi * u2);
+        }
+
+        template <typename T, typename DistributionT>
+        __global__ void random_vector_kernel(T * vec,
+                                             unsigned int start,
+                                             unsigned int inc,
+                                             unsigned int size,
+                                             unsigned int seed,
+                                             unsigned int stream_id,
+                                             unsigned int first_block_lo,
+                                             unsigned int first_block_hi,
+                                             T p0, T p1,
+                                             DistributionT tag)
+        {
+          T values[4];
+          for (unsigned int block = blockIdx.x * blockDim.x + threadIdx.x; block < (size + 3) / 4; block += gridDim.x * blockDim.x)
+          {
+            random_block(philox_block(block, first_block_lo, first_block_hi, seed, stream_id), p0, p1, values, tag);
+            for (unsigned int j = 0; j < 4; ++j)
+              if (4 * block + j < size)
+                vec[start + (4 * block + j) * inc] = values[j];
+          }
+        }
+
+        template <typename T, typename DistributionT>
+        __global__ void random_matrix_kernel(T * A,
+                                             unsigned int A_start1, unsigned int A_start2,
+                                             unsigned int A_inc1,   unsigned int A_inc2,
+                                             unsigned int A_size1,  unsigned int A_size2,
+                                             unsigned int A_internal_size1,  unsigned int A_internal_size2,
+                                             bool row_major,
+                                             unsigned int seed,
+                                             unsigned int stream_id,
+                                             unsigned int first_block_lo,
+                                             unsigned int first_block_hi,
+                                             T p0, T p1,
+                                             DistributionT tag)
+        {
+          T values[4];
+          unsigned int size = A_size1 * A_size2;
+          for (unsigned int block = blockIdx.x * blockDim.x + threadIdx.x; block < (size + 3) / 4; block += gridDim.x * blockDim.x)
+          {
+            random_block(philox_block(block, first_block_lo, first_block_hi, seed, stream_id), p0, p1, values, tag);
+            for (unsigned int j = 0; j < 4; ++j)
+            {
+              unsigned int index = 4 * block + j;
+              if (index < size)
+              {
+                unsigned int row = index / A_size2;
+                unsigned int col = index % A_size2;
+                if (row_major)
+                  A[(row * A_inc1 + A_start1) * A_internal_size2 + col * A_inc2 + A_start2] = values[j];
+                else
+                  A[row * A_inc1 + A_start1 + (col * A_inc2 + A_start2) * A_internal_size1] = values[j];
+              }
+            }
+          }
+        }
+
+        template <typename NumericT, typename DistributionT>
+        void random_fill(vector_base<NumericT> & vec, DistributionT const & tag,
+                         unsigned int seed, unsigned int stream_id, std::size_t first_block,
+                         NumericT p0, NumericT p1)
+        {
+          random_vector_kernel<<<128, 128>>>(detail::cuda_arg<NumericT>(vec),
+                                             static_cast<unsigned int>(viennacl::traits::start(vec)),
+                                             static_cast<unsigned int>(viennacl::traits::stride(vec)),
+                                             static_cast<unsigned int>(viennacl::traits::size(vec)),
+                                             seed, stream_id,
+                                             viennacl::rand::detail::block_lo(first_block),
+                                             viennacl::rand::detail::block_hi(first_block),
+                                             p0, p1, tag);
+          VIENNACL_CUDA_LAST_ERROR_CHECK("random_vector_kernel");
+        }
+
+        template <typename NumericT, typename F, typename DistributionT>
+        void random_fill(matrix_base<NumericT, F> & mat, DistributionT const & tag,
+                         unsigned int seed, unsigned int stream_id, std::size_t first_block,
+                         NumericT p0, NumericT p1)
+        {
+          random_matrix_kernel<<<128, 128>>>(detail::cuda_arg<NumericT>(mat),
+                                             static_cast<unsigned int>(viennacl::traits::start1(mat)),         static_cast<unsigned int>(viennacl::traits::start2(mat)),
+                                             static_cast<unsigned int>(viennacl::traits::stride1(mat)),        static_cast<unsigned int>(viennacl::traits::stride2(mat)),
+                                             static_cast<unsigned int>(viennacl::traits::size1(mat)),          static_cast<unsigned int>(viennacl::traits::size2(mat)),
+                                             static_cast<unsigned int>(viennacl::traits::internal_size1(mat)), static_cast<unsigned int>(viennacl::traits::internal_size2(mat)),
+                                             bool(viennacl::is_row_major<F>::value),
+                                             seed, stream_id,
+                                             viennacl::rand::detail::block_lo(first_block),
+                                             viennacl::rand::detail::block_hi(first_block),
+                                             p0, p1, tag);
+          VIENNACL_CUDA_LAST_ERROR_CHECK("random_matrix_kernel");
+        }
+      }
+
+      /** @brief Fills a vector with uniformly distributed random numbers. See viennacl::linalg::host_based::random_fill() for the parameters. */
+      template <typename NumericT>
+      void random_fill(vector_base<NumericT> & vec, viennacl::rand::uniform_tag const & tag,
+                       unsigned int seed, unsigned int stream_id, std::size_t first_block)
+      {
+        detail::random_fill(vec, tag, seed, stream_id, first_block, NumericT(tag.a), NumericT(tag.b - tag.a));
+      }
+
+      /** @brief Fills a vector with normally distributed random numbers. */
+      template <typename NumericT>
+      void random_fill(vector_base<NumericT> & vec, viennacl::rand::gaussian_tag const & tag,
+                       unsigned int seed, unsigned int stream_id, std::size_t first_block)
+      {
+        detail::random_fill(vec, tag, seed, stream_id, first_block, NumericT(tag.mu), NumericT(tag.sigma));
+      }
+
+      /** @brief Fills a matrix with uniformly distributed random numbers. Entry (i,j) obtains the value with logical index i * size2 + j. */
+      template <typename NumericT, typename F>
+      void random_fill(matrix_base<NumericT, F> & mat, viennacl::rand::uniform_tag const & tag,
+                       unsigned int seed, unsigned int stream_id, std::size_t first_block)
+      {
+        detail::random_fill(mat, tag, seed, stream_id, first_block, NumericT(tag.a), NumericT(tag.b - tag.a));
+      }
+
+      /** @brief Fills a matrix with normally distributed random numbers. Entry (i,j) obtains the value with logical index i * size2 + j. */
+      template <typename NumericT, typename F>
+      void random_fill(matrix_base<NumericT, F> & mat, viennacl::rand::gaussian_tag const & tag,
+                       unsigned int seed, unsigned int stream_id, std::size_t first_block)
+      {
+        detail::random_fill(mat, tag, seed, stream_id, first_block, NumericT(tag.mu), NumericT(tag.sigma));
+      }
+
+    } // namespace cuda
+  } //namespace linalg
+} //namespace viennacl
+
+
+#endif
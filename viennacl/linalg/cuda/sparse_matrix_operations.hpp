@@ -172,6 +172,69 @@ namespace viennacl
         VIENNACL_CUDA_LAST_ERROR_CHECK("compressed_matrix_vec_mul_kernel");
       }
 
+      template <typename T>
+      __global__ void compressed_matrix_vec_mul_scaled_kernel(
+                const unsigned int * row_indices,
+                const unsigned int * column_indices,
+                const T * elements,
+                const T * scaling,
+                unsigned int symmetric,
+                const T * x,
+                unsigned int start_x,
+                unsigned int inc_x,
+                T * result,
+                unsigned int start_result,
+                unsigned int inc_result,
+                unsigned int size_result)
+      {
+        for (unsigned int row  = blockDim.x * blockIdx.x + threadIdx.x;
+                          row  < size_result;
+                          row += gridDim.x * blockDim.x)
+        {
+          T dot_prod = (T)0;
+          unsigned int row_end = row_indices[row+1];
+          if (symmetric)
+            for (unsigned int i = row_indices[row]; i < row_end; ++i)
+              dot_prod += elements[i] * scaling[column_indices[i]] * x[column_indices[i] * inc_x + start_x];
+          else
+            for (unsigned int i = row_indices[row]; i < row_end; ++i)
+              dot_prod += elements[i] * x[column_indices[i] * inc_x + start_x];
+          result[row * inc_result + start_result] = scaling[row] * dot_prod;
+        }
+      }
+
+
+      /** @brief Carries out matrix-vector multiplication with a diagonally scaled compressed_matrix in a single kernel
+      *
+      * Implementation of the convenience expression result = prod(op, vec), where op represents either D^{-1} A or D^{-1/2} A D^{-1/2}.
+      *
+      * @param op     The scaled operator
+      * @param vec    The vector
+      * @param result The result vector
+      */
+      template<class ScalarType, unsigned int ALIGNMENT>
+      void prod_impl(const viennacl::linalg::scaled_operator<viennacl::compressed_matrix<ScalarType, ALIGNMENT> > & op,
+                     const viennacl::vector_base<ScalarType> & vec,
+                           viennacl::vector_base<ScalarType> & result)
+      {
+        viennacl::compressed_matrix<ScalarType, ALIGNMENT> const & mat = op.matrix();
+
+        compressed_matrix_vec_mul_scaled_kernel<<<128, 128>>>(detail::cuda_arg<unsigned int>(mat.handle1().cuda_handle()),
+                                                              detail::cuda_arg<unsigned int>(mat.handle2().cuda_handle()),
+                                                              detail::cuda_arg<ScalarType>(mat.handle().cuda_handle()),
+                                                              detail::cuda_arg<ScalarType>(op.scaling()),
+                                                              static_cast<unsigned int>(op.type() == viennacl::linalg::DIAGONAL_SCALING_SYMMETRIC ? 1 : 0),
+                                                              detail::cuda_arg<ScalarType>(vec),
+                                                              static_cast<unsigned int>(vec.start()),
+                                                              static_cast<unsigned int>(vec.stride()),
+                                                              detail::cuda_arg<ScalarType>(result),
+                                                              static_cast<unsigned int>(result.start()),
+                                                              static_cast<unsigned int>(result.stride()),
+                                                              static_cast<unsigned int>(result.size())
+                                                             );
+        VIENNACL_CUDA_LAST_ERROR_CHECK("compressed_matrix_vec_mul_scaled_kernel");
+      }
+
       template <typename T>
       __global__ void compressed_matrix_d_mat_mul_kernel(
                 const unsigned int * sp_mat_row_indices,
@@ -0,0 +1,668 @@
+#ifndef VIENNACL_LINALG_DETAIL_BIDIAG_SVD_HPP
+#define VIENNACL_LINALG_DETAIL_BIDIAG_SVD_HPP
+
+/* =========================================================================
+   Copyright (c) 2010-2013, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/linalg/detail/bidiag_svd.hpp
+    @brief Bidiagonalization and singular value decomposition of dense matrices on the host.
+
+    The reduction to bidiagonal form is blocked as in LAPACK's dgebrd/dlabrd: Each panel only updates the rows and columns it needs,
+    the rest of the matrix is updated with two matrix-matrix products. Singular values of the bidiagonal matrix are computed with
+    the dqds algorithm (Fernando and Parlett), singular vectors with the implicit-shift bidiagonal QR iteration (Golub and Kahan).
+*/
+
+#include <cmath>
+#include <vector>
+#include <limits>
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+
+#include "viennacl/matrix.hpp"
+#include "viennacl/linalg/host_based/common.hpp"
+#include "viennacl/linalg/host_based/matrix_operations.hpp"
+#include "viennacl/linalg/detail/symmetric_eig.hpp"
+
+namespace viennacl
+{
+  namespace linalg
+  {
+    namespace detail
+    {
+
+      /** @brief Block size (number of columns per panel) of the bidiagonalization */
+      inline std::size_t bidiag_block_size() { return 32; }
+
+      /** @brief Computes y += alpha * A x or y += alpha * A^T x for a row-major matrix A with leading dimension lda */
+      template <typename NumericT>
+      void bidiag_gemv(bool transposed, std::size_t rows, std::size_t cols, NumericT alpha,
+                       NumericT const * A, std::size_t lda,
+                       NumericT const * x, std::size_t inc_x,
+                       NumericT * y, std::size_t inc_y)
+      {
+        if (rows == 0 || cols == 0)
+          return;
+
+        if (!transposed)
+        {
+#ifdef VIENNACL_WITH_OPENMP
+          #pragma omp parallel for if (rows * cols > 20000)
+#endif
+          for (long i = 0; i < static_cast<long>(rows); ++i)
+          {
+            NumericT const * A_row = A + static_cast<std::size_t>(i) * lda;
+            NumericT temp = 0;
+            for (std::size_t j = 0; j < cols; ++j)
+              temp += A_row[j] * x[j * inc_x];
+            y[static_cast<std::size_t>(i) * inc_y] += alpha * temp;
+          }
+        }
+        else
+        {
+          // columns are processed in chunks, so that the rows of A are accessed contiguously:
+          std::size_t const chunk_size = 128;
+          long num_chunks = static_cast<long>((cols + chunk_size - 1) / chunk_size);
+#ifdef VIENNACL_WITH_OPENMP
+          #pragma omp parallel for if (rows * cols > 20000)
+#endif
+          for (long chunk = 0; chunk < num_chunks; ++chunk)
+          {
+            std::size_t col_begin = static_cast<std::size_t>(chunk) * chunk_size;
+            std::size_t col_end   = std::min(col_begin + chunk_size, cols);
+            NumericT temp[chunk_size];
+            for (std::size_t j = col_begin; j < col_end; ++j)
+              temp[j - col_begin] = 0;
+            for (std::size_t i = 0; i < rows; ++i)
+            {
+              NumericT x_i = x[i * inc_x];
+              NumericT const * A_row = A + i * lda;
+              for (std::size_t j = col_begin; j < col_end; ++j)
+                temp[j - col_begin] += A_row[j] * x_i;
+            }
+            for (std::size_t j = col_begin; j < col_end; ++j)
+              y[j * inc_y] += alpha * temp[j - col_begin];
+          }
+        }
+      }
+
+      /** @brief Generates an elementary reflector H = I - tau v v^T with v(0) = 1 such that H (alpha, x)^T = (beta, 0)^T.
+      *
+      * @param alpha   The first entry of the vector to be reflected
+      * @param x       The remaining entries, overwritten with v(1), v(2), ...
+      * @param size    Number of entries in x
+      * @param inc     Stride of x
+      * @param tau     The coefficient of the reflector (output)
+      * @return        The entry beta
+      */
+      template <typename NumericT>
+      NumericT bidiag_householder(NumericT alpha, NumericT * x, std::size_t size, std::size_t inc, NumericT & tau)
+      {
+        NumericT x_norm = 0;
+        for (std::size_t i = 0; i < size; ++i)
+          x_norm = symmetric_eig_hypot(x_norm, x[i * inc]);
+
+        if (x_norm <= 0)
+        {
+          tau = 0;
+          return alpha;
+        }
+
+        NumericT beta = symmetric_eig_hypot(alpha, x_norm);
+        if (alpha > 0)
+          beta = -beta;
+        tau = (beta - alpha) / beta;
+        NumericT scale = NumericT(1) / (alpha - beta);
+        for (std::size_t i = 0; i < size; ++i)
+          x[i * inc] *= scale;
+        return beta;
+      }
+
+      /** @brief Applies the reflector I - tau v v^T with v(0) = 1 to the rows of a row-major matrix B with B_cols columns. The rows of B start at B_row0. */
+      template <typename NumericT>
+      void bidiag_apply_reflector(NumericT const * v, std::size_t inc, std::size_t size, NumericT tau,
+                                  NumericT * B_row0, std::size_t B_cols)
+      {
+        if (tau == 0)
+          return;
+
+#ifdef VIENNACL_WITH_OPENMP
+        #pragma omp parallel for if (size * B_cols > 20000)
+#endif
+        for (long j = 0; j < static_cast<long>(B_cols); ++j)
+        {
+          NumericT temp = B_row0[j];
+          for (std::size_t i = 1; i < size; ++i)
+            temp += v[i * inc] * B_row0[i * B_cols + static_cast<std::size_t>(j)];
+          temp *= tau;
+          B_row0[j] -= temp;
+          for (std::size_t i = 1; i < size; ++i)
+            B_row0[i * B_cols + static_cast<std::size_t>(j)] -= temp * v[i * inc];
+        }
+      }
+
+      /** @brief Reduces the first nb rows and columns of the M x N matrix starting at 'a' (leading dimension lda) to bidiagonal form.
+      *
+      * Returns the matrices X and Y (row-major with nb columns) needed for the update A = A - V Y^T - X U^T of the remaining matrix,
+      * where V and U hold the left and right Householder vectors of the panel. The unit entries of the Householder vectors are stored explicitly on return.
+      */
+      template <typename NumericT>
+      void bidiag_panel(NumericT * a, std::size_t lda, std::size_t M, std::size_t N, std::size_t nb,
+                        NumericT * d, NumericT * e, NumericT * tauq, NumericT * taup,
+                        std::vector<NumericT> & X, std::vector<NumericT> & Y)
+      {
+        std::fill(X.begin(), X.begin() + M * nb, NumericT(0));
+        std::fill(Y.begin(), Y.begin() + N * nb, NumericT(0));
+        std::vector<NumericT> temp(nb + 1);
+
+        NumericT * x = &(X[0]);
+        NumericT * y = &(Y[0]);
+
+        for (std::size_t i = 0; i < nb; ++i)
+        {
+          // update column i: A(i:M, i) -= A(i:M, 0:i) Y(i, 0:i)^T + X(i:M, 0:i) A(0:i, i)
+          bidiag_gemv(false, M-i, i, NumericT(-1), a + i*lda, lda, y + i*nb, 1, a + i*lda + i, lda);
+          bidiag_gemv(false, M-i, i, NumericT(-1), x + i*nb,  nb,  a + i,    lda, a + i*lda + i, lda);
+
+          // reflector H(i) annihilating A(i+1:M, i):
+          d[i] = bidiag_householder(a[i*lda + i], a + (i+1)*lda + i, M-i-1, lda, tauq[i]);
+          a[i*lda + i] = 1;
+
+          if (i + 1 < N)
+          {
+            NumericT const * v = a + i*lda + i;
+            NumericT * y_col = y + (i+1)*nb + i;
+
+            // Y(i+1:N, i) = tauq * (A(i:M, i+1:N)^T v - Y(i+1:N, 0:i) A(i:M, 0:i)^T v - A(0:i, i+1:N)^T X(i:M, 0:i)^T v)
+            bidiag_gemv(true, M-i, N-i-1, NumericT(1), a + i*lda + i+1, lda, v, lda, y_col, nb);
+
+            std::fill(temp.begin(), temp.end(), NumericT(0));
+            bidiag_gemv(true, M-i, i, NumericT(1), a + i*lda, lda, v, lda, &(temp[0]), 1);
+            bidiag_gemv(false, N-i-1, i, NumericT(-1), y + (i+1)*nb, nb, &(temp[0]), 1, y_col, nb);
+
+            std::fill(temp.begin(), temp.end(), NumericT(0));
+            bidiag_gemv(true, M-i, i, NumericT(1), x + i*nb, nb, v, lda, &(temp[0]), 1);
+            bidiag_gemv(true, i, N-i-1, NumericT(-1), a + i+1, lda, &(temp[0]), 1, y_col, nb);
+
+            for (std::size_t j = 0; j < N-i-1; ++j)
+              y_col[j*nb] *= tauq[i];
+
+            // update row i: A(i, i+1:N) -= Y(i+1:N, 0:i+1) A(i, 0:i+1)^T + A(0:i, i+1:N)^T X(i, 0:i)^T
+            NumericT * u = a + i*lda + i+1;
+            bidiag_gemv(false, N-i-1, i+1, NumericT(-1), y + (i+1)*nb, nb, a + i*lda, 1, u, 1);
+            bidiag_gemv(true, i, N-i-1, NumericT(-1), a + i+1, lda, x + i*nb, 1, u, 1);
+
+            // reflector G(i) annihilating A(i, i+2:N):
+            e[i] = bidiag_householder(u[0], u + 1, N-i-2, 1, taup[i]);
+            u[0] = 1;
+
+            // X(i+1:M, i) = taup * (A(i+1:M, i+1:N) u - A(i+1:M, 0:i+1) Y(i+1:N, 0:i+1)^T u - X(i+1:M, 0:i) A(0:i, i+1:N) u)
+            NumericT * x_col = x + (i+1)*nb + i;
+            bidiag_gemv(false, M-i-1, N-i-1, NumericT(1), a + (i+1)*lda + i+1, lda, u, 1, x_col, nb);
+
+            std::fill(temp.begin(), temp.end(), NumericT(0));
+            bidiag_gemv(true, N-i-1, i+1, NumericT(1), y + (i+1)*nb, nb, u, 1, &(temp[0]), 1);
+            bidiag_gemv(false, M-i-1, i+1, NumericT(-1), a + (i+1)*lda, lda, &(temp[0]), 1, x_col, nb);
+
+            std::fill(temp.begin(), temp.end(), NumericT(0));
+            bidiag_gemv(false, i, N-i-1, NumericT(1), a + i+1, lda, u, 1, &(temp[0]), 1);
+            bidiag_gemv(false, M-i-1, i, NumericT(-1), x + (i+1)*nb, nb, &(temp[0]), 1, x_col, nb);
+
+            for (std::size_t j = 0; j < M-i-1; ++j)
+              x_col[j*nb] *= taup[i];
+          }
+          else
+            taup[i] = 0;
+        }
+      }
+
+      /** @brief Blocked reduction of a dense matrix with at least as many rows as columns to upper bidiagonal form, A = Q_L B Q_R^T.
+      *
+      * On return, the i-th left Householder vector is stored below the diagonal in column i of A (with implicit unit entry on the diagonal),
+      * the i-th right Householder vector is stored right of the superdiagonal in row i of A (with implicit unit entry on the superdiagonal).
+      *
+      * @param A      The matrix in row-major layout with m rows and n columns, m >= n
+      * @param m      Number of rows
+      * @param n      Number of columns
+      * @param d      The diagonal of B (output, n entries)
+      * @param e      The superdiagonal of B (output, n entries with e[n-1] = 0)
+      * @param tauq   Coefficients of the left Householder reflectors (output, n entries)
+      * @param taup   Coefficients of the right Householder reflectors (output, n entries)
+      */
+      template <typename NumericT>
+      void bidiag_reduce(std::vector<NumericT> & A, std::size_t m, std::size_t n,
+                         std::vector<NumericT> & d, std::vector<NumericT> & e,
+                         std::vector<NumericT> & tauq, std::vector<NumericT> & taup)
+      {
+        typedef viennacl::linalg::host_based::detail::matrix_array_wrapper<NumericT, viennacl::row_major_tag, false>   WrapperType;
+        typedef viennacl::linalg::host_based::detail::matrix_array_wrapper<NumericT, viennacl::row_major_tag, true>    WrapperTransType;
+
+        d.resize(n);
+        e.resize(n);
+        tauq.resize(n);
+        taup.resize(n);
+        if (n == 0)
+          return;
+        e[n-1] = 0;
+
+        std::size_t block_size = bidiag_block_size();
+        std::vector<NumericT> X(m * block_size), Y(n * block_size);
+
+        for (std::size_t s = 0; s < n; s += block_size)
+        {
+          std::size_t nb = std::min(block_size, n - s);
+          std::size_t M = m - s;
+          std::size_t N = n - s;
+
+          bidiag_panel(&(A[s*n + s]), n, M, N, nb, &(d[s]), &(e[s]), &(tauq[s]), &(taup[s]), X, Y);
+
+          if (nb < N)
+          {
+            // A(s+nb:m, s+nb:n) -= A(s+nb:m, s:s+nb) Y(nb:N, 0:nb)^T + X(nb:M, 0:nb) A(s:s+nb, s+nb:n)
+            WrapperType      A_21(&(A[0]), s+nb, s,    1, 1, m, n);
+            WrapperType      A_12(&(A[0]), s,    s+nb, 1, 1, m, n);
+            WrapperType      A_22(&(A[0]), s+nb, s+nb, 1, 1, m, n);
+            WrapperTransType Y_2(&(Y[0]),  nb,   0,    1, 1, N, nb);
+            WrapperType      X_2(&(X[0]),  nb,   0,    1, 1, M, nb);
+
+            viennacl::linalg::host_based::detail::prod(A_21, Y_2, A_22, M - nb, N - nb, nb, NumericT(-1), NumericT(1));
+            viennacl::linalg::host_based::detail::prod(X_2, A_12, A_22, M - nb, N - nb, nb, NumericT(-1), NumericT(1));
+          }
+
+          // the unit entries of the Householder vectors are implicit:
+          for (std::size_t i = s; i < s + nb; ++i)
+          {
+            A[i*n + i] = d[i];
+            if (i + 1 < n)
+              A[i*n + i+1] = e[i];
+          }
+        }
+      }
+
+      /** @brief Rotates the rows j and k of a row-major matrix with n columns: (row_j, row_k) <- (cs row_j + sn row_k, -sn row_j + cs row_k) */
+      template <typename NumericT>
+      void bidiag_rotate_rows(std::vector<NumericT> * V, std::size_t n, std::size_t j, std::size_t k, NumericT cs, NumericT sn)
+      {
+        if (!V)
+          return;
+
+        NumericT * row_j = &((*V)[j*n]);
+        NumericT * row_k = &((*V)[k*n]);
+        for (std::size_t i = 0; i < n; ++i)
+        {
+          NumericT t = cs * row_j[i] + sn * row_k[i];
+          row_k[i] = -sn * row_j[i] + cs * row_k[i];
+          row_j[i] = t;
+        }
+      }
+
+      /** @brief Implicit-shift QR iteration for the singular value decomposition of an upper bidiagonal matrix B = U diag(d) V^T.
+      *
+      * The procedure follows the one of LINPACK's dsvdc. Singular values are returned in descending order.
+      *
+      * @param d    Diagonal of B, overwritten with the singular values
+      * @param e    Superdiagonal of B with e[n-1] = 0, destroyed on return
+      * @param Ut   If not NULL, n x n row-major matrix with the left singular vectors of B in its rows
+      * @param Vt   If not NULL, n x n row-major matrix with the right singular vectors of B in its rows
+      */
+      template <typename NumericT>
+      void bidiag_qr(std::vector<NumericT> & d, std::vector<NumericT> & e,
+                     std::vector<NumericT> * Ut, std::vector<NumericT> * Vt)
+      {
+        long n = static_cast<long>(d.size());
+        if (Ut)
+        {
+          Ut->assign(static_cast<std::size_t>(n*n), NumericT(0));
+          for (long i = 0; i < n; ++i)
+            (*Ut)[static_cast<std::size_t>(i*n + i)] = 1;
+        }
+        if (Vt)
+        {
+          Vt->assign(static_cast<std::size_t>(n*n), NumericT(0));
+          for (long i = 0; i < n; ++i)
+            (*Vt)[static_cast<std::size_t>(i*n + i)] = 1;
+        }
+
+        NumericT eps  = std::numeric_limits<NumericT>::epsilon();
+        NumericT tiny = std::numeric_limits<NumericT>::min() / eps;
+        std::size_t nn = static_cast<std::size_t>(n);
+
+        long p = n;
+        std::size_t iter = 0;
+        std::size_t max_iter = 75 * nn + 30;
+        while (p > 0)
+        {
+          long k, kase;
+
+          // check for negligible superdiagonal entries:
+          for (k = p-2; k >= 0; --k)
+          {
+            if (std::fabs(e[k]) <= tiny + eps * (std::fabs(d[k]) + std::fabs(d[k+1])))
+            {
+              e[k] = 0;
+              break;
+            }
+          }
+
+          if (k == p-2)
+            kase = 4;  // d[p-1] converged
+          else
+          {
+            long ks;
+            for (ks = p-1; ks > k; --ks)
+            {
+              NumericT t = (ks != p ? std::fabs(e[ks]) : NumericT(0)) + (ks != k+1 ? std::fabs(e[ks-1]) : NumericT(0));
+              if (std::fabs(d[ks]) <= tiny + eps * t)
+              {
+                d[ks] = 0;
+                break;
+              }
+            }
+            if (ks == k)
+              kase = 3;          // QR step
+            else if (ks == p-1)
+              kase = 1;          // d[p-1] is negligible
+            else
+            {
+              kase = 2;          // d[ks] is negligible, split
+              k = ks;
+            }
+          }
+          ++k;
+
+          if (kase == 1)
+          {
+            NumericT f = e[p-2];
+            e[p-2] = 0;
+            for (long j = p-2; j >= k; --j)
+            {
+              NumericT t = symmetric_eig_hypot(d[j], f);
+              NumericT cs = d[j] / t;
+              NumericT sn = f / t;
+              d[j] = t;
+              if (j != k)
+              {
+                f = -sn * e[j-1];
+                e[j-1] = cs * e[j-1];
+              }
+              bidiag_rotate_rows(Vt, nn, static_cast<std::size_t>(j), static_cast<std::size_t>(p-1), cs, sn);
+            }
+          }
+          else if (kase == 2)
+          {
+            NumericT f = e[k-1];
+            e[k-1] = 0;
+            for (long j = k; j < p; ++j)
+            {
+              NumericT t = symmetric_eig_hypot(d[j], f);
+              NumericT cs = d[j] / t;
+              NumericT sn = f / t;
+              d[j] = t;
+              f = -sn * e[j];
+              e[j] = cs * e[j];
+              bidiag_rotate_rows(Ut, nn, static_cast<std::size_t>(j), static_cast<std::size_t>(k-1), cs, sn);
+            }
+          }
+          else if (kase == 3)
+          {
+            if (++iter > max_iter)
+              throw std::runtime_error("Bidiagonal QR iteration did not converge");
+
+            // shift from the trailing 2x2 block:
+            NumericT scale = std::max(std::max(std::max(std::max(std::fabs(d[p-1]), std::fabs(d[p-2])), std::fabs(e[p-2])), std::fabs(d[k])), std::fabs(e[k]));
+            NumericT sp   = d[p-1] / scale;
+            NumericT spm1 = d[p-2] / scale;
+            NumericT epm1 = e[p-2] / scale;
+            NumericT sk   = d[k] / scale;
+            NumericT ek   = e[k] / scale;
+            NumericT b = ((spm1 + sp) * (spm1 - sp) + epm1 * epm1) / NumericT(2);
+            NumericT c = (sp * epm1) * (sp * epm1);
+            NumericT shift = 0;
+            if (b != 0 || c != 0)
+            {
+              shift = std::sqrt(b * b + c);
+              if (b < 0)
+                shift = -shift;
+              shift = c / (b + shift);
+            }
+            NumericT f = (sk + sp) * (sk - sp) + shift;
+            NumericT g = sk * ek;
+
+            // chase the bulge:
+            for (long j = k; j < p-1; ++j)
+            {
+              NumericT t = symmetric_eig_hypot(f, g);
+              NumericT cs = f / t;
+              NumericT sn = g / t;
+              if (j != k)
+                e[j-1] = t;
+              f = cs * d[j] + sn * e[j];
+              e[j] = cs * e[j] - sn * d[j];
+              g = sn * d[j+1];
+              d[j+1] = cs * d[j+1];
+              bidiag_rotate_rows(Vt, nn, static_cast<std::size_t>(j), static_cast<std::size_t>(j+1), cs, sn);
+
+              t = symmetric_eig_hypot(f, g);
+              cs = f / t;
+              sn = g / t;
+              d[j] = t;
+              f = cs * e[j] + sn * d[j+1];
+              d[j+1] = -sn * e[j] + cs * d[j+1];
+              g = sn * e[j+1];
+              e[j+1] = cs * e[j+1];
+              bidiag_rotate_rows(Ut, nn, static_cast<std::size_t>(j), static_cast<std::size_t>(j+1), cs, sn);
+            }
+            e[p-2] = f;
+          }
+          else // kase == 4
+          {
+            // make singular value non-negative:
+            if (d[k] <= 0)
+            {
+              d[k] = (d[k] < 0) ? -d[k] : NumericT(0);
+              if (Vt)
+                for (std::size_t i = 0; i < nn; ++i)
+                  (*Vt)[static_cast<std::size_t>(k)*nn + i] = -(*Vt)[static_cast<std::size_t>(k)*nn + i];
+            }
+
+            // sort in descending order:
+            while (k < n-1 && d[k] < d[k+1])
+            {
+              std::swap(d[k], d[k+1]);
+              if (Ut)
+                std::swap_ranges(Ut->begin() + k*n, Ut->begin() + (k+1)*n, Ut->begin() + (k+1)*n);
+              if (Vt)
+                std::swap_ranges(Vt->begin() + k*n, Vt->begin() + (k+1)*n, Vt->begin() + (k+1)*n);
+              ++k;
+            }
+            --p;
+          }
+        }
+      }
+
+      /** @brief Computes the singular values of an upper bidiagonal matrix with the dqds algorithm.
+      *
+      * Uses the squared entries of the bidiagonal matrix (qd array), so all singular values are obtained to high relative accuracy.
+      * If the matrix has zero entries on the diagonal or the iteration does not converge, false is returned and d is left unchanged.
+      *
+      * @param d    Diagonal of B, overwritten with the singular values in descending order
+      * @param e    Superdiagonal of B (n-1 entries are used)
+      */
+      template <typename NumericT>
+      bool bidiag_dqds(std::vector<NumericT> & d, std::vector<NumericT> const & e)
+      {
+        std::size_t n = d.size();
+        if (n == 0)
+          return true;
+
+        std::vector<NumericT> q(n), qe(n), q_new(n), qe_new(n);
+        for (std::size_t i = 0; i < n; ++i)
+        {
+          if (d[i] == 0)
+            return false;
+          q[i]  = d[i] * d[i];
+          qe[i] = (i + 1 < n) ? e[i] * e[i] : NumericT(0);
+        }
+
+        NumericT eps = std::numeric_limits<NumericT>::epsilon();
+        NumericT tol2 = NumericT(100) * eps * NumericT(100) * eps;
+
+        std::vector<NumericT> eigenvalues(n);
+        NumericT sigma = 0;     // accumulated shift
+        NumericT tau = 0;       // shift for the next transform
+        std::size_t end = n;
+        std::size_t max_iter = 30 * n + 30;
+        std::size_t iter = 0;
+
+        while (end > 0)
+        {
+          // deflation at the bottom of the array:
+          if (end == 1)
+          {
+            eigenvalues[0] = q[0] + sigma;
+            break;
+          }
+          if (qe[end-2] <= tol2 * (sigma + q[end-1]))
+          {
+            eigenvalues[end-1] = q[end-1] + sigma;
+            --end;
+            tau = 0;
+            continue;
+          }
+          if (end == 2 || qe[end-3] <= tol2 * (sigma + q[end-2]))
+          {
+            // eigenvalues of the trailing 2x2 block:
+            NumericT trace = q[end-2] + qe[end-2] + q[end-1];
+            NumericT det   = q[end-2] * q[end-1];
+            NumericT disc  = std::sqrt(std::max(NumericT(0), (trace - NumericT(2) * std::sqrt(det)) * (trace + NumericT(2) * std::sqrt(det))));
+            NumericT lambda_1 = (trace + disc) / NumericT(2);
+            eigenvalues[end-2] = lambda_1 + sigma;
+            eigenvalues[end-1] = det / lambda_1 + sigma;
+            end -= 2;
+            tau = 0;
+            continue;
+          }
+
+          if (++iter > max_iter)
+            return false;
+
+          // dqds transform with shift tau; if positivity is lost, the shift is reduced:
+          NumericT d_min = 0;
+          bool success = false;
+          for (std::size_t attempt = 0; attempt < 4 && !success; ++attempt)
+          {
+            if (attempt == 3)
+              tau = 0;
+
+            NumericT d_i = q[0] - tau;
+            d_min = d_i;
+            success = (d_i > 0 || (tau == 0 && d_i >= 0));
+            for (std::size_t i = 0; i + 1 < end && success; ++i)
+            {
+              q_new[i] = d_i + qe[i];
+              if (q_new[i] <= 0)
+              {
+                success = false;
+                break;
+              }
+              NumericT t = q[i+1] / q_new[i];
+              qe_new[i] = qe[i] * t;
+              d_i = d_i * t - tau;
+              d_min = std::min(d_min, d_i);
+              if (d_i < 0)
+                success = false;
+            }
+            q_new[end-1] = d_i;
+            if (success && tau == 0 && d_i <= 0)
+              return false;   // numerically singular, leave it to the QR iteration
+
+            if (!success)
+              tau *= NumericT(0.25);
+          }
+          if (!success)
+            return false;
+
+          std::copy(q_new.begin(), q_new.begin() + end, q.begin());
+          std::copy(qe_new.begin(), qe_new.begin() + end - 1, qe.begin());
+          sigma += tau;
+
+          // next shift: d_min is an upper bound for the smallest eigenvalue of the new array
+          tau = NumericT(0.99) * d_min;
+        }
+
+        for (std::size_t i = 0; i < n; ++i)
+          d[i] = std::sqrt(std::max(NumericT(0), eigenvalues[i]));
+        std::sort(d.begin(), d.end(), std::greater<NumericT>());
+        return true;
+      }
+
+      /** @brief Computes the singular value decomposition A = U diag(sigma) V^T of a dense matrix on the host.
+      *
+      * @param A      The matrix in row-major layout with m rows and n columns, m >= n. Destroyed on return.
+      * @param m      Number of rows
+      * @param n      Number of columns
+      * @param sigma  The singular values in descending order (output)
+      * @param U      If not NULL, the left singular vectors as columns of a row-major m x n matrix (output)
+      * @param V      If not NULL, the right singular vectors as columns of a row-major n x n matrix (output)
+      */
+      template <typename NumericT>
+      void bidiag_svd(std::vector<NumericT> & A, std::size_t m, std::size_t n, std::vector<NumericT> & sigma,
+                      std::vector<NumericT> * U, std::vector<NumericT> * V)
+      {
+        std::vector<NumericT> e, tauq, taup;
+        bidiag_reduce(A, m, n, sigma, e, tauq, taup);
+        if (n == 0)
+          return;
+
+        if (!U && !V)
+        {
+          if (!bidiag_dqds(sigma, e))
+            bidiag_qr(sigma, e, static_cast<std::vector<NumericT> *>(NULL), static_cast<std::vector<NumericT> *>(NULL));
+          return;
+        }
+
+        std::vector<NumericT> Ut, Vt;
+        bidiag_qr(sigma, e, U ? &Ut : NULL, V ? &Vt : NULL);
+
+        if (U)
+        {
+          // U = Q_L [U_B; 0]
+          U->assign(m * n, NumericT(0));
+          for (std::size_t i = 0; i < n; ++i)
+            for (std::size_t j = 0; j < n; ++j)
+              (*U)[i*n + j] = Ut[j*n + i];
+          for (std::size_t k = n; k-- > 0; )
+            bidiag_apply_reflector(&(A[k*n + k]), n, m - k, tauq[k], &((*U)[k*n]), n);
+        }
+
+        if (V)
+        {
+          // V = Q_R V_B, where the first row and column of Q_R are the first unit vector
+          V->resize(n * n);
+          for (std::size_t i = 0; i < n; ++i)
+            for (std::size_t j = 0; j < n; ++j)
+              (*V)[i*n + j] = Vt[j*n + i];
+          for (std::size_t k = (n > 1) ? n - 1 : 0; k-- > 0; )
+            bidiag_apply_reflector(&(A[k*n + k+1]), 1, n - k - 1, taup[k], &((*V)[(k+1)*n]), n);
+        }
+      }
+
+    } //namespace detail
+  } //namespace linalg
+} //namespace viennacl
+
+#endif
@@ -0,0 +1,262 @@
+#ifndef VIENNACL_LINALG_DETAIL_BLOCK_EIG_COMMON_HPP
+#define VIENNACL_LINALG_DETAIL_BLOCK_EIG_COMMON_HPP
+
+/* =========================================================================
+   Copyright (c) 2010-2013, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/linalg/detail/block_eig_common.hpp
+    @brief Helper routines shared by the block eigensolvers (LOBPCG, block Krylov-Schur).
+
+    Blocks of vectors are stored as column-major dense matrices in the memory domain of the system matrix.
+    Only small projected matrices (Gram matrices, Rayleigh quotients, coefficient matrices) are transferred to the host.
+*/
+
+#include <cmath>
+#include <vector>
+#include <limits>
+#include <algorithm>
+#include "viennacl/vector.hpp"
+#include "viennacl/matrix.hpp"
+#include "viennacl/matrix_proxy.hpp"
+#include "viennacl/meta/predicate.hpp"
+#include "viennacl/meta/enable_if.hpp"
+#include "viennacl/linalg/prod.hpp"
+#include "viennacl/linalg/sparse_matrix_operations.hpp"
+#include "viennacl/linalg/detail/symmetric_eig.hpp"
+#include <boost/random.hpp>
+#include <boost/random/mersenne_twister.hpp>
+
+namespace viennacl
+{
+  namespace linalg
+  {
+    namespace detail
+    {
+
+      /** @brief Copies a (small) dense matrix to a row-major buffer on the host */
+      template <typename NumericT, typename F>
+      void block_to_host(viennacl::matrix<NumericT, F> const & A, std::vector<NumericT> & host_A)
+      {
+        std::vector< std::vector<NumericT> > tmp(A.size1(), std::vector<NumericT>(A.size2()));
+        viennacl::copy(A, tmp);
+
+        host_A.resize(A.size1() * A.size2());
+        for (std::size_t i=0; i<A.size1(); ++i)
+          for (std::size_t j=0; j<A.size2(); ++j)
+            host_A[i*A.size2() + j] = tmp[i][j];
+      }
+
+      /** @brief Copies a (small) row-major buffer on the host with the given dimensions to a dense matrix */
+      template <typename NumericT, typename F>
+      void block_from_host(std::vector<NumericT> const & host_A, std::size_t rows, std::size_t cols, viennacl::matrix<NumericT, F> & A)
+      {
+        std::vector< std::vector<NumericT> > tmp(rows, std::vector<NumericT>(cols));
+        for (std::size_t i=0; i<rows; ++i)
+          for (std::size_t j=0; j<cols; ++j)
+            tmp[i][j] = host_A[i*cols + j];
+
+        A.resize(rows, cols, false);
+        viennacl::copy(tmp, A);
+      }
+
+      /** @brief Computes AX = A * X for a sparse system matrix A and a block of vectors X (sparse matrix times dense matrix) */
+      template <typename MatrixT, typename NumericT>
+      typename viennacl::enable_if< viennacl::is_any_sparse_matrix<MatrixT>::value >::type
+      block_matrix_apply(MatrixT const & A, viennacl::matrix_base<NumericT, viennacl::column_major> const & X, viennacl::matrix_base<NumericT, viennacl::column_major> & AX)
+      {
+        viennacl::linalg::prod_impl(A, X, AX);
+      }
+
+      /** @brief Computes AX = A * X for a dense system matrix A and a block of vectors X */
+      template <typename NumericT, typename F>
+      void block_matrix_apply(viennacl::matrix_base<NumericT, F> const & A, viennacl::matrix_base<NumericT, viennacl::column_major> const & X, viennacl::matrix_base<NumericT, viennacl::column_major> & AX)
+      {
+        viennacl::linalg::prod_impl(A, X, AX, NumericT(1), NumericT(0));
+      }
+
+      /** @brief Copies a column-major block of vectors to a user-provided dense matrix of the same layout */
+      template <typename NumericT>
+      void block_assign(viennacl::matrix_base<NumericT, viennacl::column_major> const & X, viennacl::matrix<NumericT, viennacl::column_major> & Y)
+      {
+        Y.resize(X.size1(), X.size2(), false);
+        Y = X;
+      }
+
+      /** @brief Copies a column-major block of vectors to a user-provided dense matrix of different layout */
+      template <typename NumericT, typename F>
+      void block_assign(viennacl::matrix_base<NumericT, viennacl::column_major> const & X, viennacl::matrix<NumericT, F> & Y)
+      {
+        viennacl::matrix<NumericT, viennacl::column_major> I = viennacl::identity_matrix<NumericT>(X.size2(), viennacl::traits::context(X));
+        Y.resize(X.size1(), X.size2(), false);
+        viennacl::linalg::prod_impl(X, I, Y, NumericT(1), NumericT(0));
+      }
+
+      /** @brief Initializes a column-major block of vectors from a user-provided dense matrix of the same size */
+      template <typename NumericT, typename F>
+      void block_init(viennacl::matrix<NumericT, F> const & Y, viennacl::matrix_base<NumericT, viennacl::column_major> & X)
+      {
+        viennacl::matrix<NumericT, viennacl::column_major> I = viennacl::identity_matrix<NumericT>(X.size2(), viennacl::traits::context(X));
+        viennacl::linalg::prod_impl(Y, I, X, NumericT(1), NumericT(0));
+      }
+
+      /** @brief Returns the Gram matrix B^T C of two blocks of vectors as a row-major buffer on the host */
+      template <typename NumericT, typename F>
+      std::vector<NumericT> block_gram(viennacl::matrix_base<NumericT, F> const & B, viennacl::matrix_base<NumericT, F> const & C)
+      {
+        viennacl::matrix<NumericT, F> G(B.size2(), C.size2(), viennacl::traits::context(B));
+        viennacl::linalg::prod_impl(trans(B), C, G, NumericT(1), NumericT(0));
+
+        std::vector<NumericT> host_G;
+        block_to_host(G, host_G);
+        return host_G;
+      }
+
+      /** @brief Computes X = B * C, where C is a row-major matrix on the host */
+      template <typename NumericT, typename F1, typename F2>
+      void block_times_host(viennacl::matrix_base<NumericT, F1> const & B,
+                            std::vector<NumericT> const & C, std::size_t rows_C, std::size_t cols_C,
+                            viennacl::matrix_base<NumericT, F2> & X)
+      {
+        viennacl::matrix<NumericT, F1> vcl_C(rows_C, cols_C, viennacl::traits::context(B));
+        block_from_host(C, rows_C, cols_C, vcl_C);
+        viennacl::linalg::prod_impl(B, vcl_C, X, NumericT(1), NumericT(0));
+      }
+
+      /** @brief Computes a basis transformation Z with Z^T G Z = I for a symmetric positive semidefinite Gram matrix G (SVQB by Stathopoulos and Wu).
+      *
+      * Directions belonging to tiny eigenvalues of the (diagonally scaled) Gram matrix are dropped, so rank-deficient blocks are handled gracefully.
+      *
+      * @param G     The Gram matrix (row-major, n x n)
+      * @param n     Number of rows and columns of G
+      * @param Z     The transformation (row-major, n x num_columns)
+      * @return      The number of columns of Z
+      */
+      template <typename NumericT>
+      std::size_t block_svqb(std::vector<NumericT> const & G, std::size_t n, std::vector<NumericT> & Z)
+      {
+        std::vector<NumericT> scaling(n);
+        for (std::size_t i=0; i<n; ++i)
+          scaling[i] = (G[i*n+i] > 0) ? NumericT(1) / std::sqrt(G[i*n+i]) : NumericT(0);
+
+        std::vector<NumericT> V(n*n);
+        for (std::size_t i=0; i<n; ++i)
+          for (std::size_t j=0; j<n; ++j)
+            V[i*n+j] = scaling[i] * G[i*n+j] * scaling[j];
+
+        std::vector<NumericT> D;
+        symmetric_eig(V, n, D);
+
+        NumericT threshold = std::sqrt(std::numeric_limits<NumericT>::epsilon()) * std::max<NumericT>(D[n-1], 0);
+        std::vector<std::size_t> kept;
+        for (std::size_t j=n; j-- > 0; )
+          if (D[j] > threshold)
+            kept.push_back(j);
+
+        Z.resize(n * kept.size());
+        for (std::size_t i=0; i<n; ++i)
+          for (std::size_t j=0; j<kept.size(); ++j)
+            Z[i*kept.size() + j] = scaling[i] * V[i*n + kept[j]] / std::sqrt(D[kept[j]]);
+
+        return kept.size();
+      }
+
+      /** @brief Fills a block of vectors with normally distributed random numbers */
+      template <typename NumericT, typename F>
+      void block_random(viennacl::matrix_base<NumericT, F> & X, unsigned int seed = 0)
+      {
+        boost::mt11213b mt(seed);
+        boost::normal_distribution<NumericT> N(0, 1);
+        boost::variate_generator<boost::mt11213b&, boost::normal_distribution<NumericT> >  get_N(mt, N);
+
+        std::vector<NumericT> host_X(X.size1() * X.size2());
+        for (std::size_t i=0; i<host_X.size(); ++i)
+          host_X[i] = get_N();
+
+        viennacl::matrix<NumericT, F> tmp(X.size1(), X.size2(), viennacl::traits::context(X));
+        block_from_host(host_X, X.size1(), X.size2(), tmp);
+        X = tmp;
+      }
+
+      /** @brief Orthonormalizes a column-major block of vectors in place (SVQB).
+      *
+      * Directions dropped by block_svqb() because of (numerical) rank deficiency are replaced by random vectors orthogonal to the remaining ones until the block has full rank.
+      *
+      * @param X     The block of vectors
+      * @param tmp   A scratch matrix with at least as many rows and columns as X
+      * @param seed  Seed for the first set of random vectors, incremented for each further attempt
+      */
+      template <typename NumericT>
+      void block_orthonormalize(viennacl::matrix<NumericT, viennacl::column_major> & X, viennacl::matrix<NumericT, viennacl::column_major> & tmp, unsigned int seed)
+      {
+        typedef viennacl::matrix_range< viennacl::matrix<NumericT, viennacl::column_major> >    BlockRangeType;
+
+        std::size_t k = X.size2();
+        viennacl::range all_rows(0, X.size1());
+        std::vector<NumericT> Z;
+        for (;; ++seed)
+        {
+          std::size_t num_cols = block_svqb(block_gram(X, X), k, Z);
+          BlockRangeType Q(X, all_rows, viennacl::range(0, num_cols));
+          if (num_cols > 0)
+          {
+            BlockRangeType tmp_Q(tmp, all_rows, viennacl::range(0, num_cols));
+            block_times_host(X, Z, k, num_cols, tmp_Q);
+            Q = tmp_Q;
+          }
+          if (num_cols == k)
+            return;
+
+          // replace the dropped directions by random vectors and remove their components in the span of Q:
+          BlockRangeType R(X, all_rows, viennacl::range(num_cols, k));
+          block_random(R, seed);
+          if (num_cols > 0)
+          {
+            BlockRangeType tmp_R(tmp, all_rows, viennacl::range(0, k - num_cols));
+            block_times_host(Q, block_gram(Q, R), num_cols, k - num_cols, tmp_R);
+            R -= tmp_R;
+          }
+        }
+      }
+
+      /** @brief Applies a preconditioner to each column of a column-major block of vectors */
+      template <typename NumericT, typename PreconditionerT>
+      void block_precond_apply(PreconditionerT const & precond, viennacl::matrix_base<NumericT, viennacl::column_major> & X)
+      {
+        viennacl::vector<NumericT> tmp(X.size1(), viennacl::traits::context(X));
+        for (std::size_t j=0; j<X.size2(); ++j)
+        {
+          viennacl::vector_base<NumericT> x_j(X.handle(), X.size1(), X.start1() + (X.start2() + j * X.stride2()) * X.internal_size1(), X.stride1());
+          tmp = x_j;
+          precond.apply(tmp);
+          x_j = tmp;
+        }
+      }
+
+      /** @brief Returns the indices of the wanted eigenvalues of an ascending list of length n, wanted eigenvalues first */
+      inline std::vector<std::size_t> block_eig_wanted(std::size_t n, std::size_t num_wanted, bool largest)
+      {
+        std::vector<std::size_t> indices;
+        for (std::size_t i=0; i<std::min(n, num_wanted); ++i)
+          indices.push_back(largest ? n - i - 1 : i);
+        return indices;
+      }
+
+    } //namespace detail
+  } //namespace linalg
+} //namespace viennacl
+
+#endif
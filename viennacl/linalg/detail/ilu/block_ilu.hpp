@@ -190,7 +190,38 @@ namespace viennacl
           }
         }
 
+        /** @brief Recomputes the factorizations of the diagonal blocks for new values of a system matrix with the same sparsity pattern.
+          *
+          * With ILU0 the blocks are factored in place. With ILUT the blocks are set up from scratch, since their sparsity pattern depends on the values.
+          */
+        void refactor(MatrixType const & A)
+        {
+          refactor_dispatch(A, tag_);
+        }
+
       private:
+        void refactor_dispatch(MatrixType const & A, viennacl::linalg::ilu0_tag)
+        {
+          viennacl::context host_context(viennacl::MAIN_MEMORY);
+          viennacl::compressed_matrix<ScalarType> mat(host_context);
+
+          viennacl::copy(A, mat);
+
+#ifdef VIENNACL_WITH_OPENMP
+          #pragma omp parallel for
+#endif
+          for (std::size_t i=0; i<block_indices_.size(); ++i)
+          {
+            detail::extract_block_matrix(mat, LU_blocks[i], block_indices_[i].first, block_indices_[i].second);
+            viennacl::linalg::precondition(LU_blocks[i], tag_);
+          }
+        }
+
+        void refactor_dispatch(MatrixType const & A, viennacl::linalg::ilut_tag)
+        {
+          init(A);
+        }
+
         void init(MatrixType const & A)
         {
           viennacl::context host_context(viennacl::MAIN_MEMORY);
@@ -319,6 +350,16 @@ namespace viennacl
           //apply_cpu(vec);
         }
 
+        /** @brief Recomputes the factorizations of the diagonal blocks for new values of a system matrix with the same sparsity pattern (e.g. after compressed_matrix::set_values()).
+          *
+          * With ILU0 the blocks are factored in place and only the values of the triangular factors are transferred to the device.
+          * With ILUT the preconditioner is set up from scratch, since the sparsity pattern of the factors depends on the values.
+          */
+        void refactor(MatrixType const & A)
+        {
+          refactor_dispatch(A, tag_);
+        }
+
         // CPU fallback:
         /*void apply_cpu(vector<ScalarType> & vec) const
         {
@@ -411,15 +452,39 @@ namespace viennacl
 
           viennacl::backend::memory_create(gpu_block_indices, block_indices_uint.raw_size(), viennacl::traits::context(A), block_indices_uint.get());
 
-          blocks_to_device(mat.size1());
+          blocks_to_device(mat.size1(), false);
 
         }
 
-        // Copy computed preconditioned blocks to OpenCL device
-        void blocks_to_device(std::size_t matrix_size)
+        void refactor_dispatch(MatrixType const & A, viennacl::linalg::ilu0_tag)
         {
-          std::vector< std::map<unsigned int, ScalarType> > L_transposed(matrix_size);
-          std::vector< std::map<unsigned int, ScalarType> > U_transposed(matrix_size);
+          viennacl::context host_context(viennacl::MAIN_MEMORY);
+          MatrixType mat(host_context);
+
+          mat = A;
+
+#ifdef VIENNACL_WITH_OPENMP
+          #pragma omp parallel for
+#endif
+          for (std::size_t i=0; i<block_indices_.size(); ++i)
+          {
+            detail::extract_block_matrix(mat, LU_blocks[i], block_indices_[i].first, block_indices_[i].second);
+            viennacl::linalg::precondition(LU_blocks[i], tag_);
+          }
+
+          blocks_to_device(mat.size1(), true);
+        }
+
+        void refactor_dispatch(MatrixType const & A, viennacl::linalg::ilut_tag)
+        {
+          init(A);
+        }
+
+        // Copy computed preconditioned blocks to OpenCL device. If 'reuse_pattern' is true, the factors have the same pattern as in the previous call and only their values are transferred.
+        void blocks_to_device(std::size_t matrix_size, bool reuse_pattern)
+        {
+          std::vector<unsigned int> L_row_indices, L_col_indices, U_row_indices, U_col_indices;
+          std::vector<ScalarType> L_values, U_values;
           std::vector<ScalarType> entries_D(matrix_size);
 
           //
@@ -446,11 +511,25 @@ namespace viennacl
                 unsigned int col = col_buffer[buf_index];
 
                 if (row > col) //entry for L
-                  L_transposed[col + block_start][row + block_start] = elements[buf_index];
+                {
+                  if (!reuse_pattern)
+                  {
+                    L_row_indices.push_back(static_cast<unsigned int>(col + block_start));
+                    L_col_indices.push_back(static_cast<unsigned int>(row + block_start));
+                  }
+                  L_values.push_back(elements[buf_index]);
+                }
                 else if (row == col)
                   entries_D[row + block_start] = elements[buf_index];
                 else //entry for U
-                  U_transposed[col + block_start][row + block_start] = elements[buf_index];
+                {
+                  if (!reuse_pattern)
+                  {
+                    U_row_indices.push_back(static_cast<unsigned int>(col + block_start));
+                    U_col_indices.push_back(static_cast<unsigned int>(row + block_start));
+                  }
+                  U_values.push_back(elements[buf_index]);
+                }
               }
             }
           }
@@ -458,10 +537,18 @@ namespace viennacl
           //
           // Move data to GPU:
           //
-          tools::const_sparse_matrix_adapter<ScalarType, unsigned int> adapted_L_transposed(L_transposed, matrix_size, matrix_size);
-          tools::const_sparse_matrix_adapter<ScalarType, unsigned int> adapted_U_transposed(U_transposed, matrix_size, matrix_size);
-          viennacl::copy(adapted_L_transposed, gpu_L_trans);
-          viennacl::copy(adapted_U_transposed, gpu_U_trans);
+          if (!reuse_pattern)
+          {
+            L_builder_ = tools::sparse_matrix_builder(matrix_size, matrix_size, L_row_indices, L_col_indices);
+            U_builder_ = tools::sparse_matrix_builder(matrix_size, matrix_size, U_row_indices, U_col_indices);
+            L_builder_.assemble(L_values, gpu_L_trans);
+            U_builder_.assemble(U_values, gpu_U_trans);
+          }
+          else
+          {
+            L_builder_.update(L_values, gpu_L_trans);
+            U_builder_.update(U_values, gpu_U_trans);
+          }
           viennacl::copy(entries_D, gpu_D);
         }
 
@@ -491,6 +578,8 @@ namespace viennacl
         viennacl::compressed_matrix<ScalarType> gpu_L_trans;
         viennacl::compressed_matrix<ScalarType> gpu_U_trans;
         viennacl::vector<ScalarType> gpu_D;
+        tools::sparse_matrix_builder L_builder_;
+        tools::sparse_matrix_builder U_builder_;
 
         std::vector< MatrixType > LU_blocks;
     };
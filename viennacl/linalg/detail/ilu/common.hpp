@@ -34,6 +34,10 @@
 
 #include "viennacl/linalg/host_based/common.hpp"
 #include "viennacl/linalg/misc_operations.hpp"
+#include "viennacl/linalg/sparse_matrix_operations.hpp"
+#include "viennacl/tools/sparse_matrix_builder.hpp"
+#include "viennacl/misc/multicolor.hpp"
+#include "viennacl/misc/permutation.hpp"
 
 namespace viennacl
 {
@@ -55,7 +59,8 @@ namespace viennacl
                                        std::list< viennacl::backend::mem_handle > & col_buffers,
                                        std::list< viennacl::backend::mem_handle > & element_buffers,
                                        std::list< std::size_t > & row_elimination_num_list,
-                                       bool setup_U)
+                                       bool setup_U,
+                                       std::vector<std::pair<unsigned int, unsigned int> > * element_sources = NULL)
       {
         ScalarType   const * diagonal_buf = viennacl::linalg::host_based::detail::extract_raw_pointer<ScalarType>(diagonal_LU.handle());
         ScalarType   const * elements   = viennacl::linalg::host_based::detail::extract_raw_pointer<ScalarType>(LU.handle());
@@ -160,6 +165,8 @@ namespace viennacl
                   {
                     elim_col_buffer.set(nnz_index, col);
                     elim_elements_buffer[nnz_index] = setup_U ? elements[i] / diagonal_buf[it->first] : elements[i];
+                    if (element_sources)
+                      element_sources->push_back(std::make_pair(static_cast<unsigned int>(row), static_cast<unsigned int>(i)));
                     ++nnz_index;
                   }
                 }
@@ -194,9 +201,10 @@ namespace viennacl
                                 std::list< viennacl::backend::mem_handle > & row_buffers,
                                 std::list< viennacl::backend::mem_handle > & col_buffers,
                                 std::list< viennacl::backend::mem_handle > & element_buffers,
-                                std::list< std::size_t > & row_elimination_num_list)
+                                std::list< std::size_t > & row_elimination_num_list,
+                                std::vector<std::pair<unsigned int, unsigned int> > * element_sources = NULL)
       {
-        level_scheduling_setup_impl(LU, diagonal_LU, row_index_arrays, row_buffers, col_buffers, element_buffers, row_elimination_num_list, false);
+        level_scheduling_setup_impl(LU, diagonal_LU, row_index_arrays, row_buffers, col_buffers, element_buffers, row_elimination_num_list, false, element_sources);
       }
 
 
@@ -211,9 +219,50 @@ namespace viennacl
                                 std::list< viennacl::backend::mem_handle > & row_buffers,
                                 std::list< viennacl::backend::mem_handle > & col_buffers,
                                 std::list< viennacl::backend::mem_handle > & element_buffers,
-                                std::list< std::size_t > & row_elimination_num_list)
+                                std::list< std::size_t > & row_elimination_num_list,
+                                std::vector<std::pair<unsigned int, unsigned int> > * element_sources = NULL)
       {
-        level_scheduling_setup_impl(LU, diagonal_LU, row_index_arrays, row_buffers, col_buffers, element_buffers, row_elimination_num_list, true);
+        level_scheduling_setup_impl(LU, diagonal_LU, row_index_arrays, row_buffers, col_buffers, element_buffers, row_elimination_num_list, true, element_sources);
+      }
+
+
+      /** @brief Refills the element buffers of a level schedule from a factorization LU with the same sparsity pattern. The schedule itself is reused.
+      *
+      * @param LU               The new factorization (in main memory)
+      * @param diagonal_LU      The diagonal of LU. Only used for U.
+      * @param element_buffers  The element buffers set up by level_scheduling_setup_L() or level_scheduling_setup_U()
+      * @param element_sources  Pairs (row, index in the CSR arrays of LU) of each entry in the element buffers, as returned by the setup routine
+      * @param setup_U          Whether the schedule is for U (entries are scaled by the diagonal)
+      */
+      template <typename ScalarType, unsigned int ALIGNMENT>
+      void level_scheduling_update_impl(viennacl::compressed_matrix<ScalarType, ALIGNMENT> const & LU,
+                                        vector<ScalarType> const & diagonal_LU,
+                                        std::list< viennacl::backend::mem_handle > & element_buffers,
+                                        std::vector<std::pair<unsigned int, unsigned int> > const & element_sources,
+                                        bool setup_U)
+      {
+        ScalarType const * diagonal_buf = viennacl::linalg::host_based::detail::extract_raw_pointer<ScalarType>(diagonal_LU.handle());
+        ScalarType const * elements     = viennacl::linalg::host_based::detail::extract_raw_pointer<ScalarType>(LU.handle());
+
+        std::size_t offset = 0;
+        std::vector<ScalarType> elim_elements_buffer;
+        for (typename std::list< viennacl::backend::mem_handle >::iterator it  = element_buffers.begin();
+                                                                           it != element_buffers.end();
+                                                                         ++it)
+        {
+          std::size_t num_entries = it->raw_size() / sizeof(ScalarType);
+          assert( (offset + num_entries <= element_sources.size()) && bool("Level schedule does not match the pattern of LU!"));
+
+          elim_elements_buffer.resize(num_entries);
+          for (std::size_t i=0; i<num_entries; ++i)
+          {
+            std::pair<unsigned int, unsigned int> const & source = element_sources[offset + i];
+            elim_elements_buffer[i] = setup_U ? elements[source.second] / diagonal_buf[source.first] : elements[source.second];
+          }
+
+          viennacl::backend::memory_write(*it, 0, sizeof(ScalarType) * num_entries, &(elim_elements_buffer[0]));
+          offset += num_entries;
+        }
       }
 
 
@@ -249,6 +298,201 @@ namespace viennacl
 
 
 
+      //
+      // Reordering of the unknowns prior to the factorization:
+      //
+
+      /** @brief Computes an ordering of the rows by the levels of the lower triangular part of A, i.e. by the elimination steps of level scheduling. The original order is kept within each level. */
+      template <typename ScalarType, unsigned int ALIGNMENT>
+      std::vector<int> level_set_ordering(viennacl::compressed_matrix<ScalarType, ALIGNMENT> const & A)
+      {
+        std::size_t n = A.size1();
+        viennacl::backend::typesafe_host_array<unsigned int> row_buffer(A.handle1(), n + 1);
+        viennacl::backend::typesafe_host_array<unsigned int> col_buffer(A.handle2(), A.nnz());
+        viennacl::backend::memory_read(A.handle1(), 0, row_buffer.raw_size(), row_buffer.get());
+        viennacl::backend::memory_read(A.handle2(), 0, col_buffer.raw_size(), col_buffer.get());
+
+        std::vector<std::size_t> level(n);
+        std::size_t num_levels = 0;
+        for (std::size_t i=0; i<n; ++i)
+        {
+          for (std::size_t k = row_buffer[i]; k < row_buffer[i+1]; ++k)
+          {
+            std::size_t j = col_buffer[k];
+            if (ALIGNMENT > 1 && j == 0 && k > row_buffer[i])  //alignment padding
+              continue;
+            if (j < i)
+              level[i] = std::max(level[i], level[j] + 1);
+          }
+          num_levels = std::max(num_levels, level[i] + 1);
+        }
+
+        std::vector<std::size_t> level_offsets(num_levels + 1);
+        for (std::size_t i=0; i<n; ++i)
+          ++level_offsets[level[i] + 1];
+        for (std::size_t l=0; l<num_levels; ++l)
+          level_offsets[l+1] += level_offsets[l];
+
+        std::vector<int> r(n);
+        for (std::size_t i=0; i<n; ++i)
+          r[level_offsets[level[i]]++] = static_cast<int>(i);
+        return r;
+      }
+
+
+      /** @brief Symmetric permutation P A P^T of the system matrix for incomplete factorizations, cf. ilu_reordering_type.
+      *
+      * The factorization is computed for the permuted matrix. Vectors passed to apply() of the preconditioner are permuted before and permuted back after the triangular solves.
+      * For vectors outside of main memory this is carried out by sparse matrix-vector products with P and P^T, so no data is transferred to the host.
+      * The permutations use buffers local to each call, hence apply() of a preconditioner may be called from several threads concurrently.
+      */
+      template <typename ScalarType>
+      class ilu_reordering
+      {
+        public:
+          ilu_reordering() : type_(viennacl::linalg::ILU_REORDERING_NONE) {}
+
+          /** @brief Returns true if a permutation other than the identity is used */
+          bool active() const { return type_ != viennacl::linalg::ILU_REORDERING_NONE; }
+
+          /** @brief The permutation vector r. r[l] = i means that row i of the system matrix is row l of the factors. */
+          std::vector<int> const & permutation() const { return r_; }
+
+          /** @brief Computes the permutation for the sparsity pattern of A and writes P A P^T to 'result'. Does nothing if no reordering is selected.
+          *
+          * @param A        The system matrix. May reside in any memory domain.
+          * @param type     The reordering type
+          * @param result   The permuted matrix
+          * @param ctx      The context of the vectors passed to permute() and inverse_permute()
+          */
+          template <unsigned int ALIGNMENT>
+          void init(viennacl::compressed_matrix<ScalarType, ALIGNMENT> const & A, viennacl::linalg::ilu_reordering_type type,
+                    viennacl::compressed_matrix<ScalarType> & result, viennacl::context ctx)
+          {
+            type_ = type;
+            if (!active())
+              return;
+
+            switch (type_)
+            {
+              case viennacl::linalg::ILU_REORDERING_MULTICOLOR:
+                r_ = viennacl::reorder(A, viennacl::multicolor_tag());
+                break;
+              case viennacl::linalg::ILU_REORDERING_LEVEL_SET:
+                r_ = level_set_ordering(A);
+                break;
+              default:
+                assert(bool("Unknown reordering type!"));
+            }
+
+            std::size_t n = A.size1();
+            std::vector<unsigned int> row_indices;
+            std::vector<unsigned int> col_indices;
+            viennacl::detail::permuted_pattern(A, r_, row_indices, col_indices, sources_);
+            builder_ = viennacl::tools::sparse_matrix_builder(n, n, row_indices, col_indices);
+
+            std::vector<ScalarType> values;
+            viennacl::detail::permuted_values(A, sources_, values);
+            builder_.assemble(values, result);
+
+            // permutation matrices for vectors outside of main memory: (P x)[l] = x[r[l]]
+            if (ctx.memory_type() == viennacl::MAIN_MEMORY)
+              return;
+
+            std::vector<unsigned int> perm_rows(n), perm_cols(n);
+            std::vector<ScalarType> ones(n, ScalarType(1));
+            for (std::size_t l=0; l<n; ++l)
+            {
+              perm_rows[l] = static_cast<unsigned int>(l);
+              perm_cols[l] = static_cast<unsigned int>(r_[l]);
+            }
+            viennacl::switch_memory_context(P_, ctx);
+            viennacl::switch_memory_context(PT_, ctx);
+            viennacl::tools::sparse_matrix_builder(n, n, perm_rows, perm_cols).assemble(ones, P_);
+            viennacl::tools::sparse_matrix_builder(n, n, perm_cols, perm_rows).assemble(ones, PT_);
+          }
+
+          /** @brief Writes P A P^T to 'result' for new values of a system matrix with the sparsity pattern passed to init(). Only the values of 'result' are transferred. */
+          template <unsigned int ALIGNMENT>
+          void update(viennacl::compressed_matrix<ScalarType, ALIGNMENT> const & A, viennacl::compressed_matrix<ScalarType> & result) const
+          {
+            std::vector<ScalarType> values;
+            viennacl::detail::permuted_values(A, sources_, values);
+            builder_.update(values, result);
+          }
+
+          /** @brief Computes vec <- P vec */
+          void permute(viennacl::vector<ScalarType> & vec) const
+          {
+            if (viennacl::traits::context(vec).memory_type() == viennacl::MAIN_MEMORY)
+            {
+              ScalarType * data = viennacl::linalg::host_based::detail::extract_raw_pointer<ScalarType>(vec.handle());
+              permute_host(data);
+            }
+            else
+            {
+              viennacl::vector<ScalarType> temp(vec.size(), viennacl::traits::context(vec));
+              viennacl::linalg::prod_impl(P_, vec, temp);
+              vec = temp;
+            }
+          }
+
+          /** @brief Computes vec <- P^T vec */
+          void inverse_permute(viennacl::vector<ScalarType> & vec) const
+          {
+            if (viennacl::traits::context(vec).memory_type() == viennacl::MAIN_MEMORY)
+            {
+              ScalarType * data = viennacl::linalg::host_based::detail::extract_raw_pointer<ScalarType>(vec.handle());
+              inverse_permute_host(data);
+            }
+            else
+            {
+              viennacl::vector<ScalarType> temp(vec.size(), viennacl::traits::context(vec));
+              viennacl::linalg::prod_impl(PT_, vec, temp);
+              vec = temp;
+            }
+          }
+
+          /** @brief Computes vec <- P vec for a host vector type providing operator[] (e.g. from uBLAS) */
+          template <typename VectorType>
+          void permute(VectorType & vec) const { permute_host(vec); }
+
+          /** @brief Computes vec <- P^T vec for a host vector type providing operator[] (e.g. from uBLAS) */
+          template <typename VectorType>
+          void inverse_permute(VectorType & vec) const { inverse_permute_host(vec); }
+
+        private:
+          template <typename VectorType>
+          void permute_host(VectorType & vec) const
+          {
+            std::vector<ScalarType> buffer(r_.size());
+            for (std::size_t l=0; l<r_.size(); ++l)
+              buffer[l] = vec[static_cast<std::size_t>(r_[l])];
+            for (std::size_t l=0; l<r_.size(); ++l)
+              vec[l] = buffer[l];
+          }
+
+          template <typename VectorType>
+          void inverse_permute_host(VectorType & vec) const
+          {
+            std::vector<ScalarType> buffer(r_.size());
+            for (std::size_t l=0; l<r_.size(); ++l)
+              buffer[static_cast<std::size_t>(r_[l])] = vec[l];
+            for (std::size_t l=0; l<r_.size(); ++l)
+              vec[l] = buffer[l];
+          }
+
+          viennacl::linalg::ilu_reordering_type type_;
+          std::vector<int> r_;
+          std::vector<unsigned int> sources_;
+          viennacl::tools::sparse_matrix_builder builder_;
+
+          viennacl::compressed_matrix<ScalarType> P_;
+          viennacl::compressed_matrix<ScalarType> PT_;
+      };
+
+
+
 
     } // namespace detail
   } // namespace linalg
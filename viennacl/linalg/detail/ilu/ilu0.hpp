@@ -59,13 +59,23 @@ namespace viennacl
     class ilu0_tag
     {
       public:
-        ilu0_tag(bool with_level_scheduling = false) : use_level_scheduling_(with_level_scheduling) {}
+        /** @brief The constructor.
+        *
+        * @param with_level_scheduling  Flag for enabling level scheduling on GPUs.
+        * @param reordering             Permutation of the unknowns applied prior to the factorization. A multicolor reordering reduces the number of levels in level scheduling to the number of colors.
+        */
+        ilu0_tag(bool with_level_scheduling = false,
+                 ilu_reordering_type reordering = ILU_REORDERING_NONE) : use_level_scheduling_(with_level_scheduling), reordering_(reordering) {}
 
         bool use_level_scheduling() const { return use_level_scheduling_; }
         void use_level_scheduling(bool b) { use_level_scheduling_ = b; }
 
+        ilu_reordering_type reordering() const { return reordering_; }
+        void reordering(ilu_reordering_type r) { reordering_ = r; }
+
       private:
         bool use_level_scheduling_;
+        ilu_reordering_type reordering_;
     };
 
 
@@ -127,7 +137,7 @@ namespace viennacl
             {
               if (col_buffer[buf_index_akj] == j)
               {
-                a_kk = elements[buf_index_akj];
+                a_kj = elements[buf_index_akj];
                 break;
               }
             }
@@ -164,10 +174,19 @@ namespace viennacl
           unsigned int const * col_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(LU.handle2());
           ScalarType   const * elements   = viennacl::linalg::host_based::detail::extract_raw_pointer<ScalarType>(LU.handle());
 
+          if (reordering_.active())
+            reordering_.permute(vec);
+
           viennacl::linalg::host_based::detail::csr_inplace_solve<ScalarType>(row_buffer, col_buffer, elements, vec, LU.size2(), unit_lower_tag());
           viennacl::linalg::host_based::detail::csr_inplace_solve<ScalarType>(row_buffer, col_buffer, elements, vec, LU.size2(), upper_tag());
+
+          if (reordering_.active())
+            reordering_.inverse_permute(vec);
         }
 
+        /** @brief Recomputes the factorization for new values of the system matrix. ILU0 does not require a symbolic setup, thus this is the same as the initialization. */
+        void refactor(MatrixType const & mat) { init(mat); }
+
       private:
         void init(MatrixType const & mat)
         {
@@ -175,12 +194,14 @@ namespace viennacl
           viennacl::switch_memory_context(LU, host_context);
 
           viennacl::copy(mat, LU);
+          reordering_.init(LU, tag_.reordering(), LU, host_context);
           viennacl::linalg::precondition(LU, tag_);
         }
 
         ilu0_tag const & tag_;
 
         viennacl::compressed_matrix<ScalarType> LU;
+        detail::ilu_reordering<ScalarType> reordering_;
     };
 
 
@@ -204,6 +225,9 @@ namespace viennacl
 
         void apply(vector<ScalarType> & vec) const
         {
+          if (reordering_.active())
+            reordering_.permute(vec);
+
           viennacl::context host_context(viennacl::MAIN_MEMORY);
           if (vec.handle().get_active_handle_id() != viennacl::MAIN_MEMORY)
           {
@@ -262,16 +286,50 @@ namespace viennacl
               viennacl::linalg::inplace_solve(LU, vec, upper_tag());
             }
           }
+
+          if (reordering_.active())
+            reordering_.inverse_permute(vec);
         }
 
         vcl_size_t levels() const { return multifrontal_L_row_index_arrays_.size(); }
 
+        /** @brief Recomputes the factorization for new values of a system matrix with the same sparsity pattern (e.g. after compressed_matrix::set_values()).
+          *
+          * Only the values of the matrix are transferred. The level schedules are reused, only the entries of their element buffers are updated.
+          */
+        void refactor(MatrixType const & mat)
+        {
+          if (reordering_.active())
+            reordering_.update(mat, LU);
+          else
+          {
+            assert( (mat.size1() == LU.size1()) && (mat.nnz() == LU.nnz()) && bool("Sparsity pattern differs from the one used for setting up the preconditioner!") );
+            viennacl::backend::memory_read(mat.handle(), 0, sizeof(ScalarType) * LU.nnz(), viennacl::linalg::host_based::detail::extract_raw_pointer<ScalarType>(LU.handle()));
+          }
+          viennacl::linalg::precondition(LU, tag_);
+
+          if (!tag_.use_level_scheduling())
+            return;
+
+          viennacl::context host_context(viennacl::MAIN_MEMORY);
+          viennacl::switch_memory_context(multifrontal_U_diagonal_, host_context);
+          host_based::detail::row_info(LU, multifrontal_U_diagonal_, viennacl::linalg::detail::SPARSE_ROW_DIAGONAL);
+
+          detail::level_scheduling_update_impl(LU, multifrontal_U_diagonal_, multifrontal_L_element_buffers_, multifrontal_L_element_sources_, false);
+          detail::level_scheduling_update_impl(LU, multifrontal_U_diagonal_, multifrontal_U_element_buffers_, multifrontal_U_element_sources_, true);
+
+          viennacl::switch_memory_context(multifrontal_U_diagonal_, viennacl::traits::context(mat));
+        }
+
       private:
         void init(MatrixType const & mat)
         {
           viennacl::context host_context(viennacl::MAIN_MEMORY);
           viennacl::switch_memory_context(LU, host_context);
-          LU = mat;
+          if (tag_.reordering() != ILU_REORDERING_NONE)
+            reordering_.init(mat, tag_.reordering(), LU, viennacl::traits::context(mat));
+          else
+            LU = mat;
           viennacl::linalg::precondition(LU, tag_);
 
           if (!tag_.use_level_scheduling())
@@ -288,7 +346,8 @@ namespace viennacl
                                            multifrontal_L_row_buffers_,
                                            multifrontal_L_col_buffers_,
                                            multifrontal_L_element_buffers_,
-                                           multifrontal_L_row_elimination_num_list_);
+                                           multifrontal_L_row_elimination_num_list_,
+                                           &multifrontal_L_element_sources_);
 
 
           detail::level_scheduling_setup_U(LU,
@@ -297,7 +356,8 @@ namespace viennacl
                                            multifrontal_U_row_buffers_,
                                            multifrontal_U_col_buffers_,
                                            multifrontal_U_element_buffers_,
-                                           multifrontal_U_row_elimination_num_list_);
+                                           multifrontal_U_row_elimination_num_list_,
+                                           &multifrontal_U_element_sources_);
 
           //
           // Bring to device if necessary:
@@ -353,12 +413,14 @@ namespace viennacl
 
         ilu0_tag const & tag_;
         viennacl::compressed_matrix<ScalarType> LU;
+        detail::ilu_reordering<ScalarType> reordering_;
 
         std::list< viennacl::backend::mem_handle > multifrontal_L_row_index_arrays_;
         std::list< viennacl::backend::mem_handle > multifrontal_L_row_buffers_;
         std::list< viennacl::backend::mem_handle > multifrontal_L_col_buffers_;
         std::list< viennacl::backend::mem_handle > multifrontal_L_element_buffers_;
         std::list< std::size_t > multifrontal_L_row_elimination_num_list_;
+        std::vector<std::pair<unsigned int, unsigned int> > multifrontal_L_element_sources_;
 
         viennacl::vector<ScalarType> multifrontal_U_diagonal_;
         std::list< viennacl::backend::mem_handle > multifrontal_U_row_index_arrays_;
@@ -366,6 +428,7 @@ namespace viennacl
         std::list< viennacl::backend::mem_handle > multifrontal_U_col_buffers_;
         std::list< viennacl::backend::mem_handle > multifrontal_U_element_buffers_;
         std::list< std::size_t > multifrontal_U_row_elimination_num_list_;
+        std::vector<std::pair<unsigned int, unsigned int> > multifrontal_U_element_sources_;
 
     };
 
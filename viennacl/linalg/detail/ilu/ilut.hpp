@@ -50,10 +50,12 @@ namespace viennacl
         * @param entries_per_row        Number of nonzero entries per row in L and U. Note that L and U are stored in a single matrix, thus there are 2*entries_per_row in total.
         * @param drop_tolerance         The drop tolerance for ILUT
         * @param with_level_scheduling  Flag for enabling level scheduling on GPUs.
+        * @param reordering             Permutation of the unknowns applied prior to the factorization, cf. ilu_reordering_type.
         */
         ilut_tag(unsigned int entries_per_row = 20,
                  double drop_tolerance = 1e-4,
-                 bool with_level_scheduling = false) : entries_per_row_(entries_per_row), drop_tolerance_(drop_tolerance), use_level_scheduling_(with_level_scheduling) {};
+                 bool with_level_scheduling = false,
+                 ilu_reordering_type reordering = ILU_REORDERING_NONE) : entries_per_row_(entries_per_row), drop_tolerance_(drop_tolerance), use_level_scheduling_(with_level_scheduling), reordering_(reordering) {};
 
         void set_drop_tolerance(double tol)
         {
@@ -73,10 +75,14 @@ namespace viennacl
         bool use_level_scheduling() const { return use_level_scheduling_; }
         void use_level_scheduling(bool b) { use_level_scheduling_ = b; }
 
+        ilu_reordering_type reordering() const { return reordering_; }
+        void reordering(ilu_reordering_type r) { reordering_ = r; }
+
       private:
         unsigned int entries_per_row_;
         double drop_tolerance_;
         bool use_level_scheduling_;
+        ilu_reordering_type reordering_;
     };
 
 
@@ -267,10 +273,19 @@ namespace viennacl
           unsigned int const * col_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(LU.handle2());
           ScalarType   const * elements   = viennacl::linalg::host_based::detail::extract_raw_pointer<ScalarType>(LU.handle());
 
+          if (reordering_.active())
+            reordering_.permute(vec);
+
           viennacl::linalg::host_based::detail::csr_inplace_solve<ScalarType>(row_buffer, col_buffer, elements, vec, LU.size2(), unit_lower_tag());
           viennacl::linalg::host_based::detail::csr_inplace_solve<ScalarType>(row_buffer, col_buffer, elements, vec, LU.size2(), upper_tag());
+
+          if (reordering_.active())
+            reordering_.inverse_permute(vec);
         }
 
+        /** @brief Recomputes the factorization for new values of the system matrix. The sparsity pattern of ILUT depends on the values, thus this is the same as the initialization. */
+        void refactor(MatrixType const & mat) { init(mat); }
+
       private:
         void init(MatrixType const & mat)
         {
@@ -279,6 +294,7 @@ namespace viennacl
           viennacl::switch_memory_context(temp, host_context);
 
           viennacl::copy(mat, temp);
+          reordering_.init(temp, tag_.reordering(), temp, host_context);
 
           std::vector< std::map<unsigned int, ScalarType> > LU_temp(mat.size1());
 
@@ -290,6 +306,7 @@ namespace viennacl
 
         ilut_tag const & tag_;
         viennacl::compressed_matrix<ScalarType> LU;
+        detail::ilu_reordering<ScalarType> reordering_;
     };
 
 
@@ -313,6 +330,9 @@ namespace viennacl
 
         void apply(vector<ScalarType> & vec) const
         {
+          if (reordering_.active())
+            reordering_.permute(vec);
+
           if (vec.handle().get_active_handle_id() != viennacl::MAIN_MEMORY)
           {
             if (tag_.use_level_scheduling())
@@ -349,6 +369,30 @@ namespace viennacl
             viennacl::linalg::inplace_solve(LU, vec, unit_lower_tag());
             viennacl::linalg::inplace_solve(LU, vec, upper_tag());
           }
+
+          if (reordering_.active())
+            reordering_.inverse_permute(vec);
+        }
+
+        /** @brief Recomputes the factorization for new values of the system matrix.
+          *
+          * The sparsity pattern of ILUT depends on the values, hence the factorization and the level schedules are set up from scratch.
+          */
+        void refactor(MatrixType const & mat)
+        {
+          multifrontal_L_row_index_arrays_.clear();
+          multifrontal_L_row_buffers_.clear();
+          multifrontal_L_col_buffers_.clear();
+          multifrontal_L_element_buffers_.clear();
+          multifrontal_L_row_elimination_num_list_.clear();
+
+          multifrontal_U_row_index_arrays_.clear();
+          multifrontal_U_row_buffers_.clear();
+          multifrontal_U_col_buffers_.clear();
+          multifrontal_U_element_buffers_.clear();
+          multifrontal_U_row_elimination_num_list_.clear();
+
+          init(mat);
         }
 
       private:
@@ -359,7 +403,16 @@ namespace viennacl
 
           std::vector< std::map<unsigned int, ScalarType> > LU_temp(mat.size1());
 
-          if (viennacl::traits::context(mat).memory_type() == viennacl::MAIN_MEMORY)
+          if (tag_.reordering() != ILU_REORDERING_NONE)
+          {
+            viennacl::compressed_matrix<ScalarType> cpu_mat(mat.size1(), mat.size2());
+            viennacl::switch_memory_context(cpu_mat, host_context);
+
+            reordering_.init(mat, tag_.reordering(), cpu_mat, viennacl::traits::context(mat));
+
+            viennacl::linalg::precondition(cpu_mat, LU_temp, tag_);
+          }
+          else if (viennacl::traits::context(mat).memory_type() == viennacl::MAIN_MEMORY)
           {
             viennacl::linalg::precondition(mat, LU_temp, tag_);
           }
@@ -459,6 +512,7 @@ namespace viennacl
 
         ilut_tag const & tag_;
         viennacl::compressed_matrix<ScalarType> LU;
+        detail::ilu_reordering<ScalarType> reordering_;
 
         std::list< viennacl::backend::mem_handle > multifrontal_L_row_index_arrays_;
         std::list< viennacl::backend::mem_handle > multifrontal_L_row_buffers_;
@@ -156,10 +156,7 @@ namespace viennacl
                                                       ++col_it)
               {
                 if (col_it.index1() > col_it.index2()) //Matrix is symmetric, thus only work on lower triangular part
-                {
                   J[col_it.index2()].push_back(col_it.index1());
-                  J[col_it.index1()].push_back(col_it.index2());
-                }
                 else
                   break; //go to next row
               }
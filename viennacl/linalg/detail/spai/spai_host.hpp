@@ -0,0 +1,591 @@
+#ifndef VIENNACL_LINALG_DETAIL_SPAI_SPAI_HOST_HPP
+#define VIENNACL_LINALG_DETAIL_SPAI_SPAI_HOST_HPP
+
+/* =========================================================================
+   Copyright (c) 2010-2013, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/linalg/detail/spai/spai_host.hpp
+    @brief Host-based setup of the SPAI and FSPAI preconditioners working directly on the CSR arrays of a compressed_matrix.
+
+    The small dense problems of the individual columns are independent of each other and processed in parallel if OpenMP is enabled.
+    Neither uBLAS nor OpenCL is required.
+*/
+
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <cmath>
+#include <cassert>
+
+#include "viennacl/forwards.h"
+#include "viennacl/compressed_matrix.hpp"
+#include "viennacl/backend/memory.hpp"
+#include "viennacl/tools/sparse_matrix_builder.hpp"
+
+namespace viennacl
+{
+  namespace linalg
+  {
+    namespace detail
+    {
+      namespace spai
+      {
+
+        /** @brief Column-wise copy of a compressed_matrix in main memory (i.e. CSC format). Alignment padding is removed and row indices are sorted within each column. */
+        template <typename ScalarType>
+        class host_sparse_columns
+        {
+          public:
+            /** @brief Extracts the columns of A (transposed == false) or the columns of A^T, i.e. the rows of A (transposed == true). A may reside in any memory domain. */
+            template <unsigned int ALIGNMENT>
+            host_sparse_columns(viennacl::compressed_matrix<ScalarType, ALIGNMENT> const & A, bool transposed)
+            {
+              std::size_t num_columns = transposed ? A.size1() : A.size2();
+              col_begin_.assign(num_columns + 1, 0);
+              norms_.assign(num_columns, 0);
+              if (A.nnz() == 0)
+                return;
+
+              viennacl::backend::typesafe_host_array<unsigned int> row_buffer(A.handle1(), A.size1() + 1);
+              viennacl::backend::typesafe_host_array<unsigned int> col_buffer(A.handle2(), A.nnz());
+              std::vector<ScalarType> elements(A.nnz());
+              viennacl::backend::memory_read(A.handle1(), 0, row_buffer.raw_size(), row_buffer.get());
+              viennacl::backend::memory_read(A.handle2(), 0, col_buffer.raw_size(), col_buffer.get());
+              viennacl::backend::memory_read(A.handle(),  0, sizeof(ScalarType) * elements.size(), &(elements[0]));
+
+              // count entries per column:
+              for (std::size_t i=0; i<A.size1(); ++i)
+                for (std::size_t k = row_buffer[i]; k < row_buffer[i+1]; ++k)
+                {
+                  std::size_t j = col_buffer[k];
+                  if (ALIGNMENT > 1 && j == 0 && k > row_buffer[i])  //alignment padding (column indices are sorted)
+                    continue;
+                  ++col_begin_[(transposed ? i : j) + 1];
+                }
+              for (std::size_t j=0; j<num_columns; ++j)
+                col_begin_[j+1] += col_begin_[j];
+
+              // scatter entries:
+              row_indices_.resize(col_begin_[num_columns]);
+              elements_.resize(col_begin_[num_columns]);
+              std::vector<unsigned int> next(col_begin_.begin(), col_begin_.end() - 1);
+              for (std::size_t i=0; i<A.size1(); ++i)
+                for (std::size_t k = row_buffer[i]; k < row_buffer[i+1]; ++k)
+                {
+                  std::size_t j = col_buffer[k];
+                  if (ALIGNMENT > 1 && j == 0 && k > row_buffer[i])
+                    continue;
+                  unsigned int index = next[transposed ? i : j]++;
+                  row_indices_[index] = static_cast<unsigned int>(transposed ? j : i);
+                  elements_[index] = elements[k];
+                  norms_[transposed ? i : j] += elements[k] * elements[k];
+                }
+            }
+
+            /** @brief Returns the number of columns */
+            std::size_t size() const { return norms_.size(); }
+
+            /** @brief Returns the index of the first entry of column j */
+            unsigned int begin(std::size_t j) const { return col_begin_[j]; }
+            /** @brief Returns the index past the last entry of column j */
+            unsigned int end(std::size_t j) const { return col_begin_[j+1]; }
+
+            /** @brief Returns the row index of the entry with the given index */
+            unsigned int row(std::size_t index) const { return row_indices_[index]; }
+            /** @brief Returns the value of the entry with the given index */
+            ScalarType value(std::size_t index) const { return elements_[index]; }
+
+            /** @brief Returns the squared Euclidean norm of column j */
+            ScalarType norm_2_squared(std::size_t j) const { return norms_[j]; }
+
+          private:
+            std::vector<unsigned int> col_begin_;
+            std::vector<unsigned int> row_indices_;
+            std::vector<ScalarType>   elements_;
+            std::vector<ScalarType>   norms_;
+        };
+
+
+        /** @brief Per-thread buffers for the setup of a single column of the SPAI preconditioner. All buffers are reused for all columns processed by a thread. */
+        template <typename ScalarType>
+        struct host_spai_workspace
+        {
+          explicit host_spai_workspace(std::size_t n) : row_position(n, -1), in_J(n, false), num_reflectors(0) {}
+
+          std::vector<unsigned int> I;             //row indices of the least squares problem
+          std::vector<unsigned int> J;             //column indices of the least squares problem, i.e. the pattern of the current column of M
+          std::vector<long>         row_position;  //index of a row in I, or -1
+          std::vector<bool>         in_J;
+
+          std::vector<ScalarType>   QR;            //Householder QR factorization of A(I, J), stored column-major with leading dimension I.size()
+          std::vector<ScalarType>   betas;         //Householder coefficients
+          std::size_t               num_reflectors;
+
+          std::vector<ScalarType>   y;             //Q^T e_k
+          std::vector<ScalarType>   m;             //solution of the least squares problem
+          std::vector<ScalarType>   residual;      //A(I, J) m - e_k(I)
+          std::vector<std::pair<unsigned int, ScalarType> > candidates;
+        };
+
+
+        /** @brief Computes the Householder reflector annihilating the entries below the diagonal in column j of the m x n column-major matrix QR.
+        *
+        * The essential part of the Householder vector is stored below the diagonal, the diagonal entry is replaced by the respective entry of R.
+        */
+        template <typename ScalarType>
+        ScalarType host_householder_vector(ScalarType * QR, std::size_t m, std::size_t j)
+        {
+          ScalarType * x = QR + j * m;
+          ScalarType sigma = 0;
+          for (std::size_t i=j+1; i<m; ++i)
+            sigma += x[i] * x[i];
+
+          if (sigma == 0)
+            return 0;
+
+          ScalarType alpha = x[j];
+          ScalarType mu = std::sqrt(alpha * alpha + sigma);
+          ScalarType v0 = (alpha <= 0) ? alpha - mu : -sigma / (alpha + mu);
+          for (std::size_t i=j+1; i<m; ++i)
+            x[i] /= v0;
+          x[j] = mu;
+          return ScalarType(2) * v0 * v0 / (sigma + v0 * v0);
+        }
+
+        /** @brief Applies the j-th Householder reflector stored in the m x n column-major matrix QR to the vector y of length m. */
+        template <typename ScalarType>
+        void host_householder_apply(ScalarType const * QR, std::size_t m, std::size_t j, ScalarType beta, ScalarType * y)
+        {
+          if (beta == 0)
+            return;
+
+          ScalarType const * v = QR + j * m;
+          ScalarType s = y[j];
+          for (std::size_t i=j+1; i<m; ++i)
+            s += v[i] * y[i];
+          s *= beta;
+          y[j] -= s;
+          for (std::size_t i=j+1; i<m; ++i)
+            y[i] -= s * v[i];
+        }
+
+
+        /** @brief Adds all rows touched by the columns J[j_begin], J[j_begin+1], ... to the row index set I */
+        template <typename ScalarType>
+        void host_spai_add_rows(host_sparse_columns<ScalarType> const & A_cols, std::size_t j_begin, host_spai_workspace<ScalarType> & ws)
+        {
+          for (std::size_t j=j_begin; j<ws.J.size(); ++j)
+            for (unsigned int k = A_cols.begin(ws.J[j]); k < A_cols.end(ws.J[j]); ++k)
+            {
+              unsigned int row = A_cols.row(k);
+              if (ws.row_position[row] < 0)
+              {
+                ws.row_position[row] = static_cast<long>(ws.I.size());
+                ws.I.push_back(row);
+              }
+            }
+        }
+
+        /** @brief Updates the QR factorization of A(I, J) after the index sets I and J have grown from old_rows and old_cols entries to their current size.
+        *
+        * The new rows of the old columns are zero, hence the old reflectors remain valid. Only the new columns need to be transformed and factored, cf. Kallischko dissertation p.32.
+        */
+        template <typename ScalarType>
+        void host_spai_qr_update(host_sparse_columns<ScalarType> const & A_cols, std::size_t old_rows, std::size_t old_cols, host_spai_workspace<ScalarType> & ws)
+        {
+          std::size_t m = ws.I.size();
+          std::size_t n = ws.J.size();
+          ws.QR.resize(m * n);
+
+          // move the old columns to the new leading dimension (back to front, so no entry is overwritten before it is read):
+          if (m > old_rows)
+          {
+            for (std::size_t j = old_cols; j-- > 0; )
+            {
+              for (std::size_t i = old_rows; i < m; ++i)
+                ws.QR[j * m + i] = 0;
+              for (std::size_t i = old_rows; i-- > 0; )
+                ws.QR[j * m + i] = ws.QR[j * old_rows + i];
+            }
+          }
+
+          // set up the new columns A(I, J_new):
+          for (std::size_t j = old_cols; j < n; ++j)
+          {
+            ScalarType * column = &(ws.QR[j * m]);
+            std::fill(column, column + m, ScalarType(0));
+            for (unsigned int k = A_cols.begin(ws.J[j]); k < A_cols.end(ws.J[j]); ++k)
+              column[ws.row_position[A_cols.row(k)]] = A_cols.value(k);
+
+            for (std::size_t r = 0; r < ws.num_reflectors; ++r)
+              host_householder_apply(&(ws.QR[0]), m, r, ws.betas[r], column);
+          }
+
+          // compute the missing reflectors (if the previous block had fewer rows than columns, the trailing old columns are factored here as well):
+          std::size_t num_reflectors = std::min(m, n);
+          ws.betas.resize(num_reflectors);
+          for (std::size_t r = ws.num_reflectors; r < num_reflectors; ++r)
+          {
+            ws.betas[r] = host_householder_vector(&(ws.QR[0]), m, r);
+            for (std::size_t j = r + 1; j < n; ++j)
+              host_householder_apply(&(ws.QR[0]), m, r, ws.betas[r], &(ws.QR[j * m]));
+          }
+          ws.num_reflectors = num_reflectors;
+        }
+
+        /** @brief Solves the least squares problem min || A(I, J) m - e_k(I) || using the QR factorization and computes the residual. Returns the residual norm || A(:, J) m - e_k ||. */
+        template <typename ScalarType>
+        ScalarType host_spai_solve(host_sparse_columns<ScalarType> const & A_cols, unsigned int k, host_spai_workspace<ScalarType> & ws)
+        {
+          std::size_t m = ws.I.size();
+          std::size_t n = ws.J.size();
+          long k_position = ws.row_position[k];
+
+          ws.y.assign(m, ScalarType(0));
+          if (k_position >= 0)
+            ws.y[static_cast<std::size_t>(k_position)] = ScalarType(1);
+          for (std::size_t r = 0; r < ws.num_reflectors; ++r)
+            host_householder_apply(&(ws.QR[0]), m, r, ws.betas[r], &(ws.y[0]));
+
+          // back substitution with R. Rank-deficient columns (e.g. empty columns of A) obtain a zero coefficient:
+          ws.m.resize(n);
+          for (std::size_t j = n; j-- > 0; )
+          {
+            if (j >= m || ws.QR[j * m + j] == 0)
+            {
+              ws.m[j] = 0;
+              continue;
+            }
+            ScalarType s = ws.y[j];
+            for (std::size_t c = j + 1; c < n; ++c)
+              s -= ws.QR[c * m + j] * ws.m[c];
+            ws.m[j] = s / ws.QR[j * m + j];
+          }
+
+          // residual A(I, J) m - e_k(I). If k is not in I, the residual additionally holds -1 in row k:
+          ws.residual.assign(m, ScalarType(0));
+          for (std::size_t j = 0; j < n; ++j)
+            for (unsigned int p = A_cols.begin(ws.J[j]); p < A_cols.end(ws.J[j]); ++p)
+              ws.residual[static_cast<std::size_t>(ws.row_position[A_cols.row(p)])] += A_cols.value(p) * ws.m[j];
+
+          ScalarType norm = (k_position >= 0) ? 0 : 1;
+          if (k_position >= 0)
+            ws.residual[static_cast<std::size_t>(k_position)] -= ScalarType(1);
+          for (std::size_t i = 0; i < m; ++i)
+            norm += ws.residual[i] * ws.residual[i];
+          return std::sqrt(norm);
+        }
+
+        /** @brief Orders candidate indices by decreasing score. Ties are broken by the index, so the result does not depend on the order of the candidates. */
+        template <typename PairT>
+        struct host_spai_candidate_compare
+        {
+          bool operator()(PairT const & a, PairT const & b) const
+          {
+            return a.second > b.second || (a.second == b.second && a.first < b.first);
+          }
+        };
+
+        /** @brief Score of column l for the augmentation of the pattern: (r^T A(:,l))^2 / ||A(:,l)||^2, cf. Grote and Huckle */
+        template <typename ScalarType>
+        ScalarType host_spai_score(host_sparse_columns<ScalarType> const & A_cols, unsigned int k, unsigned int l, host_spai_workspace<ScalarType> const & ws)
+        {
+          ScalarType norm2 = A_cols.norm_2_squared(l);
+          if (norm2 <= 0)
+            return 0;
+
+          ScalarType inner_prod = 0;
+          for (unsigned int p = A_cols.begin(l); p < A_cols.end(l); ++p)
+          {
+            unsigned int row = A_cols.row(p);
+            if (ws.row_position[row] >= 0)
+              inner_prod += A_cols.value(p) * ws.residual[static_cast<std::size_t>(ws.row_position[row])];
+            else if (row == k)
+              inner_prod -= A_cols.value(p);
+          }
+          return inner_prod * inner_prod / norm2;
+        }
+
+        /** @brief Appends at most J.size() new column indices with the largest scores to J. Only rows with residual entries larger than the residual threshold are considered. Returns the number of new indices. */
+        template <typename ScalarType>
+        std::size_t host_spai_augment(host_sparse_columns<ScalarType> const & A_cols, unsigned int k, ScalarType residual_threshold, host_spai_workspace<ScalarType> & ws)
+        {
+          typedef std::pair<unsigned int, ScalarType>   PairType;
+
+          ws.candidates.clear();
+          for (std::size_t i = 0; i < ws.I.size(); ++i)
+          {
+            unsigned int l = ws.I[i];
+            if (!ws.in_J[l] && std::fabs(ws.residual[i]) > residual_threshold)
+              ws.candidates.push_back(PairType(l, host_spai_score(A_cols, k, l, ws)));
+          }
+          if (ws.row_position[k] < 0 && !ws.in_J[k] && ScalarType(1) > residual_threshold)
+            ws.candidates.push_back(PairType(k, host_spai_score(A_cols, k, k, ws)));
+
+          std::size_t num_new = std::min(ws.J.size(), ws.candidates.size());
+          std::partial_sort(ws.candidates.begin(), ws.candidates.begin() + static_cast<long>(num_new), ws.candidates.end(), host_spai_candidate_compare<PairType>());
+          for (std::size_t i = 0; i < num_new; ++i)
+          {
+            ws.J.push_back(ws.candidates[i].first);
+            ws.in_J[ws.candidates[i].first] = true;
+          }
+          return num_new;
+        }
+
+        /** @brief Computes column k of the sparse approximate inverse, i.e. min || A m_k - e_k || with A given column-wise. The pattern J and the values m are left in the workspace. */
+        template <typename ScalarType, typename SPAITagType>
+        void host_spai_column(host_sparse_columns<ScalarType> const & A_cols, unsigned int k, SPAITagType const & tag, host_spai_workspace<ScalarType> & ws)
+        {
+          // reset the workspace from the previous column:
+          for (std::size_t i = 0; i < ws.I.size(); ++i)
+            ws.row_position[ws.I[i]] = -1;
+          for (std::size_t j = 0; j < ws.J.size(); ++j)
+            ws.in_J[ws.J[j]] = false;
+          ws.I.clear();
+          ws.J.clear();
+          ws.num_reflectors = 0;
+
+          // initial pattern: pattern of column k of A
+          for (unsigned int p = A_cols.begin(k); p < A_cols.end(k); ++p)
+          {
+            ws.J.push_back(A_cols.row(p));
+            ws.in_J[A_cols.row(p)] = true;
+          }
+          host_spai_add_rows(A_cols, 0, ws);
+          host_spai_qr_update(A_cols, 0, 0, ws);
+          ScalarType residual_norm = host_spai_solve(A_cols, k, ws);
+
+          if (tag.getIsStatic())
+            return;
+
+          for (std::size_t iter = 1; iter < tag.getIterationLimit() && residual_norm > tag.getResidualNormThreshold(); ++iter)
+          {
+            std::size_t old_rows = ws.I.size();
+            std::size_t old_cols = ws.J.size();
+            if (host_spai_augment(A_cols, k, static_cast<ScalarType>(tag.getResidualThreshold()), ws) == 0)
+              break;
+            host_spai_add_rows(A_cols, old_cols, ws);
+            host_spai_qr_update(A_cols, old_rows, old_cols, ws);
+            residual_norm = host_spai_solve(A_cols, k, ws);
+          }
+        }
+
+
+        /** @brief Assembles the compressed_matrix M from the columns (transposed == false) or rows (transposed == true) given by index and value arrays. */
+        template <typename ScalarType, unsigned int ALIGNMENT>
+        void host_spai_assemble(std::vector<std::vector<unsigned int> > const & indices,
+                                std::vector<std::vector<ScalarType> > const & values,
+                                bool transposed,
+                                viennacl::compressed_matrix<ScalarType, ALIGNMENT> & M)
+        {
+          std::size_t n = indices.size();
+          std::size_t nnz = 0;
+          for (std::size_t k = 0; k < n; ++k)
+            nnz += indices[k].size();
+
+          std::vector<unsigned int> row_indices; row_indices.reserve(nnz);
+          std::vector<unsigned int> col_indices; col_indices.reserve(nnz);
+          std::vector<ScalarType>   entries;     entries.reserve(nnz);
+          for (std::size_t k = 0; k < n; ++k)
+            for (std::size_t i = 0; i < indices[k].size(); ++i)
+            {
+              row_indices.push_back(transposed ? static_cast<unsigned int>(k) : indices[k][i]);
+              col_indices.push_back(transposed ? indices[k][i] : static_cast<unsigned int>(k));
+              entries.push_back(values[k][i]);
+            }
+
+          if (nnz == 0)
+            M.resize(n, n, false);
+          else
+            viennacl::tools::sparse_matrix_builder(n, n, row_indices, col_indices, ALIGNMENT).assemble(entries, M);
+        }
+
+
+        /** @brief Host-based construction of the SPAI preconditioner M for a compressed_matrix.
+        *
+        * Each column (right preconditioner) or row (left preconditioner) of M is obtained from a small least squares problem, which is solved by a Householder QR factorization in per-thread buffers.
+        * The pattern is augmented dynamically as proposed by Grote and Huckle unless a static SPAI is requested.
+        * Columns are distributed dynamically over the threads, since the cost per column varies strongly with the pattern.
+        *
+        * @param A     The square system matrix. May reside in any memory domain.
+        * @param M     The preconditioner. Keeps its memory domain.
+        * @param tag   The SPAI configuration
+        */
+        template <typename ScalarType, unsigned int ALIGNMENT, typename SPAITagType>
+        void compute_spai_host(viennacl::compressed_matrix<ScalarType, ALIGNMENT> const & A,
+                               viennacl::compressed_matrix<ScalarType, ALIGNMENT> & M,
+                               SPAITagType const & tag)
+        {
+          assert( (A.size1() == A.size2()) && bool("SPAI requires a square matrix!") );
+
+          // The rows of a left preconditioner are the columns of the approximate inverse of A^T:
+          host_sparse_columns<ScalarType> A_cols(A, !tag.getIsRight());
+
+          std::size_t n = A.size1();
+          std::vector<std::vector<unsigned int> > M_indices(n);
+          std::vector<std::vector<ScalarType> >   M_values(n);
+
+          long size = static_cast<long>(n);
+#ifdef VIENNACL_WITH_OPENMP
+          #pragma omp parallel
+#endif
+          {
+            host_spai_workspace<ScalarType> ws(n);
+
+#ifdef VIENNACL_WITH_OPENMP
+            #pragma omp for schedule(dynamic, 16)
+#endif
+            for (long k = 0; k < size; ++k)
+            {
+              host_spai_column(A_cols, static_cast<unsigned int>(k), tag, ws);
+              M_indices[static_cast<std::size_t>(k)] = ws.J;
+              M_values[static_cast<std::size_t>(k)]  = ws.m;
+            }
+          }
+
+          host_spai_assemble(M_indices, M_values, !tag.getIsRight(), M);
+        }
+
+
+
+        /** @brief Host-based construction of the FSPAI preconditioner L L^T for a symmetric positive definite compressed_matrix, cf. Huckle.
+        *
+        * Column k of the lower triangular factor L has the pattern of the lower triangular part of column k of A.
+        * Only the lower triangular part of A is accessed. The small symmetric blocks A(J_k, J_k) are Cholesky-factored in per-thread buffers.
+        *
+        * @param A         The symmetric positive definite system matrix. May reside in any memory domain.
+        * @param L         The lower triangular factor. Keeps its memory domain.
+        * @param L_trans   The transpose of L. Keeps its memory domain.
+        */
+        template <typename ScalarType, unsigned int ALIGNMENT>
+        void compute_fspai_host(viennacl::compressed_matrix<ScalarType, ALIGNMENT> const & A,
+                                viennacl::compressed_matrix<ScalarType, ALIGNMENT> & L,
+                                viennacl::compressed_matrix<ScalarType, ALIGNMENT> & L_trans)
+        {
+          assert( (A.size1() == A.size2()) && bool("FSPAI requires a square matrix!") );
+
+          host_sparse_columns<ScalarType> A_cols(A, false);
+
+          std::size_t n = A.size1();
+          std::vector<std::vector<unsigned int> > L_indices(n);
+          std::vector<std::vector<ScalarType> >   L_values(n);
+
+          long size = static_cast<long>(n);
+#ifdef VIENNACL_WITH_OPENMP
+          #pragma omp parallel
+#endif
+          {
+            std::vector<long>         position(n, -1);
+            std::vector<unsigned int> J;
+            std::vector<ScalarType>   block;   //A(J, J), lower triangular part, column-major
+            std::vector<ScalarType>   a;       //A(J, k)
+            std::vector<ScalarType>   y;
+
+#ifdef VIENNACL_WITH_OPENMP
+            #pragma omp for schedule(dynamic, 16)
+#endif
+            for (long k2 = 0; k2 < size; ++k2)
+            {
+              std::size_t k = static_cast<std::size_t>(k2);
+
+              // pattern J_k = { i > k : A(i, k) != 0 }:
+              ScalarType a_kk = 0;
+              J.clear();
+              a.clear();
+              for (unsigned int p = A_cols.begin(k); p < A_cols.end(k); ++p)
+              {
+                unsigned int row = A_cols.row(p);
+                if (row == k)
+                  a_kk = A_cols.value(p);
+                else if (row > k)
+                {
+                  position[row] = static_cast<long>(J.size());
+                  J.push_back(row);
+                  a.push_back(A_cols.value(p));
+                }
+              }
+
+              std::size_t nJ = J.size();
+              block.assign(nJ * nJ, ScalarType(0));
+              for (std::size_t j = 0; j < nJ; ++j)
+                for (unsigned int p = A_cols.begin(J[j]); p < A_cols.end(J[j]); ++p)
+                {
+                  unsigned int row = A_cols.row(p);
+                  if (row >= J[j] && position[row] >= 0)
+                    block[j * nJ + static_cast<std::size_t>(position[row])] = A_cols.value(p);
+                }
+
+              // Cholesky factorization of A(J, J) in place:
+              for (std::size_t c = 0; c < nJ; ++c)
+              {
+                assert( (block[c * nJ + c] > 0) && bool("FSPAI: Matrix is not positive definite!") );
+                block[c * nJ + c] = std::sqrt(block[c * nJ + c]);
+                for (std::size_t i = c + 1; i < nJ; ++i)
+                {
+                  block[c * nJ + i] /= block[c * nJ + c];
+                  for (std::size_t j = c + 1; j <= i; ++j)
+                    block[j * nJ + i] -= block[c * nJ + i] * block[c * nJ + j];
+                }
+              }
+
+              // solve A(J, J) y = A(J, k):
+              y = a;
+              for (std::size_t i = 0; i < nJ; ++i)
+              {
+                for (std::size_t j = 0; j < i; ++j)
+                  y[i] -= block[j * nJ + i] * y[j];
+                y[i] /= block[i * nJ + i];
+              }
+              for (std::size_t i = nJ; i-- > 0; )
+              {
+                for (std::size_t j = i + 1; j < nJ; ++j)
+                  y[i] -= block[i * nJ + j] * y[j];
+                y[i] /= block[i * nJ + i];
+              }
+
+              // column k of L:
+              ScalarType L_kk = a_kk;
+              for (std::size_t i = 0; i < nJ; ++i)
+                L_kk -= a[i] * y[i];
+              assert( (L_kk > 0) && bool("FSPAI: Matrix is not positive definite!") );
+              L_kk = ScalarType(1) / std::sqrt(L_kk);
+
+              std::vector<unsigned int> & indices = L_indices[k];
+              std::vector<ScalarType>   & values  = L_values[k];
+              indices.resize(nJ + 1);
+              values.resize(nJ + 1);
+              indices[0] = static_cast<unsigned int>(k);
+              values[0]  = L_kk;
+              for (std::size_t i = 0; i < nJ; ++i)
+              {
+                indices[i+1] = J[i];
+                values[i+1]  = -L_kk * y[i];
+                position[J[i]] = -1;
+              }
+            }
+          }
+
+          host_spai_assemble(L_indices, L_values, false, L);
+          host_spai_assemble(L_indices, L_values, true,  L_trans);
+        }
+
+      }
+    }
+  }
+}
+
+#endif
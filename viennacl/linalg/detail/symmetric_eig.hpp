@@ -0,0 +1,295 @@
+#ifndef VIENNACL_LINALG_DETAIL_SYMMETRIC_EIG_HPP
+#define VIENNACL_LINALG_DETAIL_SYMMETRIC_EIG_HPP
+
+/* =========================================================================
+   Copyright (c) 2010-2013, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/linalg/detail/symmetric_eig.hpp
+    @brief Eigenvalue decomposition of small dense symmetric matrices on the host.
+
+    Used for the projected (Rayleigh-Ritz) problems of the iterative eigensolvers, which are small enough to be solved on the CPU.
+    The implementation follows the EISPACK procedures tred2 and tql2 (Bowdler, Martin, Reinsch, and Wilkinson).
+*/
+
+#include <cmath>
+#include <vector>
+#include <limits>
+#include <algorithm>
+
+namespace viennacl
+{
+  namespace linalg
+  {
+    namespace detail
+    {
+
+      /** @brief Returns sqrt(a^2 + b^2) without destructive underflow or overflow */
+      template <typename NumericT>
+      NumericT symmetric_eig_hypot(NumericT a, NumericT b)
+      {
+        NumericT abs_a = std::fabs(a);
+        NumericT abs_b = std::fabs(b);
+        if (abs_a > abs_b)
+          return abs_a * std::sqrt(NumericT(1) + (abs_b / abs_a) * (abs_b / abs_a));
+        if (abs_b > 0)
+          return abs_b * std::sqrt(NumericT(1) + (abs_a / abs_b) * (abs_a / abs_b));
+        return 0;
+      }
+
+      /** @brief Householder reduction of a symmetric matrix to tridiagonal form. V is overwritten with the accumulated transformations.
+      *
+      * @param V    The symmetric matrix, row-major with n rows and columns
+      * @param n    Number of rows and columns
+      * @param d    Diagonal of the tridiagonal matrix (output)
+      * @param e    Off-diagonal of the tridiagonal matrix in e[1], ..., e[n-1] (output)
+      */
+      template <typename NumericT>
+      void symmetric_eig_tred2(std::vector<NumericT> & V, std::size_t n, std::vector<NumericT> & d, std::vector<NumericT> & e)
+      {
+        for (std::size_t j = 0; j < n; ++j)
+          d[j] = V[(n-1)*n + j];
+
+        for (std::size_t i = n-1; i > 0; --i)
+        {
+          NumericT scale = 0;
+          NumericT h = 0;
+          for (std::size_t k = 0; k < i; ++k)
+            scale += std::fabs(d[k]);
+
+          if (scale <= 0)
+          {
+            e[i] = d[i-1];
+            for (std::size_t j = 0; j < i; ++j)
+            {
+              d[j] = V[(i-1)*n + j];
+              V[i*n + j] = 0;
+              V[j*n + i] = 0;
+            }
+          }
+          else
+          {
+            for (std::size_t k = 0; k < i; ++k)
+            {
+              d[k] /= scale;
+              h += d[k] * d[k];
+            }
+            NumericT f = d[i-1];
+            NumericT g = std::sqrt(h);
+            if (f > 0)
+              g = -g;
+            e[i] = scale * g;
+            h = h - f * g;
+            d[i-1] = f - g;
+            for (std::size_t j = 0; j < i; ++j)
+              e[j] = 0;
+
+            for (std::size_t j = 0; j < i; ++j)
+            {
+              f = d[j];
+              V[j*n + i] = f;
+              g = e[j] + V[j*n + j] * f;
+              for (std::size_t k = j+1; k < i; ++k)
+              {
+                g    += V[k*n + j] * d[k];
+                e[k] += V[k*n + j] * f;
+              }
+              e[j] = g;
+            }
+
+            f = 0;
+            for (std::size_t j = 0; j < i; ++j)
+            {
+              e[j] /= h;
+              f += e[j] * d[j];
+            }
+            NumericT hh = f / (h + h);
+            for (std::size_t j = 0; j < i; ++j)
+              e[j] -= hh * d[j];
+            for (std::size_t j = 0; j < i; ++j)
+            {
+              f = d[j];
+              g = e[j];
+              for (std::size_t k = j; k < i; ++k)
+                V[k*n + j] -= (f * e[k] + g * d[k]);
+              d[j] = V[(i-1)*n + j];
+              V[i*n + j] = 0;
+            }
+          }
+          d[i] = h;
+        }
+
+        // accumulate transformations:
+        for (std::size_t i = 0; i + 1 < n; ++i)
+        {
+          V[(n-1)*n + i] = V[i*n + i];
+          V[i*n + i] = 1;
+          NumericT h = d[i+1];
+          if (h != 0)
+          {
+            for (std::size_t k = 0; k <= i; ++k)
+              d[k] = V[k*n + i+1] / h;
+            for (std::size_t j = 0; j <= i; ++j)
+            {
+              NumericT g = 0;
+              for (std::size_t k = 0; k <= i; ++k)
+                g += V[k*n + i+1] * V[k*n + j];
+              for (std::size_t k = 0; k <= i; ++k)
+                V[k*n + j] -= g * d[k];
+            }
+          }
+          for (std::size_t k = 0; k <= i; ++k)
+            V[k*n + i+1] = 0;
+        }
+        for (std::size_t j = 0; j < n; ++j)
+        {
+          d[j] = V[(n-1)*n + j];
+          V[(n-1)*n + j] = 0;
+        }
+        V[(n-1)*n + n-1] = 1;
+        e[0] = 0;
+      }
+
+      /** @brief Symmetric tridiagonal QL algorithm with implicit shifts. Eigenvectors are accumulated in V. */
+      template <typename NumericT>
+      void symmetric_eig_tql2(std::vector<NumericT> & V, std::size_t n, std::vector<NumericT> & d, std::vector<NumericT> & e)
+      {
+        for (std::size_t i = 1; i < n; ++i)
+          e[i-1] = e[i];
+        e[n-1] = 0;
+
+        NumericT f = 0;
+        NumericT tst1 = 0;
+        NumericT eps = std::numeric_limits<NumericT>::epsilon();
+
+        for (std::size_t l = 0; l < n; ++l)
+        {
+          // find small subdiagonal element:
+          tst1 = std::max<NumericT>(tst1, std::fabs(d[l]) + std::fabs(e[l]));
+          std::size_t m = l;
+          while (m < n - 1)
+          {
+            if (std::fabs(e[m]) <= eps * tst1)
+              break;
+            ++m;
+          }
+
+          // if m == l, d[l] is an eigenvalue, otherwise iterate:
+          if (m > l)
+          {
+            std::size_t iter = 0;
+            do
+            {
+              ++iter;
+
+              // compute implicit shift:
+              NumericT g = d[l];
+              NumericT p = (d[l+1] - g) / (2 * e[l]);
+              NumericT r = symmetric_eig_hypot<NumericT>(p, 1);
+              if (p < 0)
+                r = -r;
+              d[l]   = e[l] / (p + r);
+              d[l+1] = e[l] * (p + r);
+              NumericT dl1 = d[l+1];
+              NumericT h = g - d[l];
+              for (std::size_t i = l+2; i < n; ++i)
+                d[i] -= h;
+              f += h;
+
+              // implicit QL transformation:
+              p = d[m];
+              NumericT c  = 1;
+              NumericT c2 = c;
+              NumericT c3 = c;
+              NumericT el1 = e[l+1];
+              NumericT s  = 0;
+              NumericT s2 = 0;
+              for (std::size_t i = m; i-- > l; )
+              {
+                c3 = c2;
+                c2 = c;
+                s2 = s;
+                g = c * e[i];
+                h = c * p;
+                r = symmetric_eig_hypot(p, e[i]);
+                e[i+1] = s * r;
+                s = e[i] / r;
+                c = p / r;
+                p = c * d[i] - s * g;
+                d[i+1] = h + s * (c * g + s * d[i]);
+
+                for (std::size_t k = 0; k < n; ++k)
+                {
+                  h = V[k*n + i+1];
+                  V[k*n + i+1] = s * V[k*n + i] + c * h;
+                  V[k*n + i]   = c * V[k*n + i] - s * h;
+                }
+              }
+              p = -s * s2 * c3 * el1 * e[l] / dl1;
+              e[l] = s * p;
+              d[l] = c * p;
+            } while (std::fabs(e[l]) > eps * tst1 && iter < 30 * n);
+          }
+          d[l] += f;
+          e[l] = 0;
+        }
+
+        // sort eigenvalues and eigenvectors in ascending order:
+        for (std::size_t i = 0; i + 1 < n; ++i)
+        {
+          std::size_t k = i;
+          NumericT p = d[i];
+          for (std::size_t j = i+1; j < n; ++j)
+          {
+            if (d[j] < p)
+            {
+              k = j;
+              p = d[j];
+            }
+          }
+          if (k != i)
+          {
+            d[k] = d[i];
+            d[i] = p;
+            for (std::size_t j = 0; j < n; ++j)
+              std::swap(V[j*n + i], V[j*n + k]);
+          }
+        }
+      }
+
+      /** @brief Computes all eigenvalues and eigenvectors of a small dense symmetric matrix on the host.
+      *
+      * @param A            The symmetric matrix (row-major, n rows and columns). Overwritten with the eigenvectors, which are stored column-wise.
+      * @param n            Number of rows and columns of A
+      * @param eigenvalues  The eigenvalues in ascending order
+      */
+      template <typename NumericT>
+      void symmetric_eig(std::vector<NumericT> & A, std::size_t n, std::vector<NumericT> & eigenvalues)
+      {
+        eigenvalues.resize(n);
+        if (n == 0)
+          return;
+
+        std::vector<NumericT> e(n);
+        symmetric_eig_tred2(A, n, eigenvalues, e);
+        symmetric_eig_tql2(A, n, eigenvalues, e);
+      }
+
+    } //namespace detail
+  } //namespace linalg
+} //namespace viennacl
+
+#endif
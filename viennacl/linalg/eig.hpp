@@ -23,7 +23,9 @@
 */
 
 #include "viennacl/linalg/bisect.hpp"
+#include "viennacl/linalg/krylov_schur.hpp"
 #include "viennacl/linalg/lanczos.hpp"
+#include "viennacl/linalg/lobpcg.hpp"
 #include "viennacl/linalg/power_iter.hpp"
 
 #endif
@@ -0,0 +1,544 @@
+#ifndef VIENNACL_LINALG_HOST_BASED_BATCHED_OPERATIONS_HPP_
+#define VIENNACL_LINALG_HOST_BASED_BATCHED_OPERATIONS_HPP_
+
+/* =========================================================================
+   Copyright (c) 2010-2013, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/linalg/host_based/batched_operations.hpp
+    @brief Implementations of batched dense operations on many small matrices on the CPU using a single thread or OpenMP.
+*/
+
+#include <cmath>
+#include <algorithm>
+
+#include "viennacl/forwards.h"
+#include "viennacl/traits/start.hpp"
+#include "viennacl/linalg/host_based/common.hpp"
+
+namespace viennacl
+{
+  namespace linalg
+  {
+    namespace host_based
+    {
+      namespace detail
+      {
+        //
+        // Kernels for a single batch entry. Matrices up to 64x64 are copied to a zero-padded tile on the stack,
+        // so that the innermost loops run over the compile-time tile width N and can be unrolled and vectorized by the compiler.
+        //
+
+        /** @brief C = alpha * A * B + beta * C for a single batch entry with n, k <= N. Rows of B are held in a tile of width N. */
+        template <unsigned int N, typename NumericT>
+        void batched_gemm_tile(NumericT alpha,
+                               NumericT const * A, vcl_size_t A_stride1, vcl_size_t A_stride2,
+                               NumericT const * B, vcl_size_t B_stride1, vcl_size_t B_stride2,
+                               NumericT beta,
+                               NumericT * C, vcl_size_t C_stride1, vcl_size_t C_stride2,
+                               vcl_size_t m, vcl_size_t n, vcl_size_t k)
+        {
+          NumericT B_tile[N * N];
+          NumericT C_row[N];
+
+          for (vcl_size_t p=0; p<k; ++p)
+            for (unsigned int j=0; j<N; ++j)
+              B_tile[p*N + j] = (j < n) ? B[p * B_stride1 + j * B_stride2] : NumericT(0);
+
+          for (vcl_size_t i=0; i<m; ++i)
+          {
+            for (unsigned int j=0; j<N; ++j)
+              C_row[j] = 0;
+
+            for (vcl_size_t p=0; p<k; ++p)
+            {
+              NumericT a = A[i * A_stride1 + p * A_stride2];
+              for (unsigned int j=0; j<N; ++j)
+                C_row[j] += a * B_tile[p*N + j];
+            }
+
+            for (vcl_size_t j=0; j<n; ++j)
+            {
+              NumericT & c = C[i * C_stride1 + j * C_stride2];
+              c = (beta != 0) ? alpha * C_row[j] + beta * c : alpha * C_row[j];   //C is not read for beta == 0, so it may be uninitialized
+            }
+          }
+        }
+
+        /** @brief C = alpha * A * B + beta * C for a single batch entry of arbitrary size */
+        template <typename NumericT>
+        void batched_gemm_generic(NumericT alpha,
+                                  NumericT const * A, vcl_size_t A_stride1, vcl_size_t A_stride2,
+                                  NumericT const * B, vcl_size_t B_stride1, vcl_size_t B_stride2,
+                                  NumericT beta,
+                                  NumericT * C, vcl_size_t C_stride1, vcl_size_t C_stride2,
+                                  vcl_size_t m, vcl_size_t n, vcl_size_t k)
+        {
+          for (vcl_size_t i=0; i<m; ++i)
+            for (vcl_size_t j=0; j<n; ++j)
+            {
+              NumericT sum = 0;
+              for (vcl_size_t p=0; p<k; ++p)
+                sum += A[i * A_stride1 + p * A_stride2] * B[p * B_stride1 + j * B_stride2];
+              NumericT & c = C[i * C_stride1 + j * C_stride2];
+              c = (beta != 0) ? alpha * sum + beta * c : alpha * sum;
+            }
+        }
+
+        template <typename NumericT>
+        void batched_gemm_entry(NumericT alpha,
+                                NumericT const * A, vcl_size_t A_stride1, vcl_size_t A_stride2,
+                                NumericT const * B, vcl_size_t B_stride1, vcl_size_t B_stride2,
+                                NumericT beta,
+                                NumericT * C, vcl_size_t C_stride1, vcl_size_t C_stride2,
+                                vcl_size_t m, vcl_size_t n, vcl_size_t k)
+        {
+          vcl_size_t tile_size = std::max(n, k);
+          if (tile_size <= 8)
+            batched_gemm_tile<8>(alpha, A, A_stride1, A_stride2, B, B_stride1, B_stride2, beta, C, C_stride1, C_stride2, m, n, k);
+          else if (tile_size <= 16)
+            batched_gemm_tile<16>(alpha, A, A_stride1, A_stride2, B, B_stride1, B_stride2, beta, C, C_stride1, C_stride2, m, n, k);
+          else if (tile_size <= 32)
+            batched_gemm_tile<32>(alpha, A, A_stride1, A_stride2, B, B_stride1, B_stride2, beta, C, C_stride1, C_stride2, m, n, k);
+          else if (tile_size <= 64)
+            batched_gemm_tile<64>(alpha, A, A_stride1, A_stride2, B, B_stride1, B_stride2, beta, C, C_stride1, C_stride2, m, n, k);
+          else
+            batched_gemm_generic(alpha, A, A_stride1, A_stride2, B, B_stride1, B_stride2, beta, C, C_stride1, C_stride2, m, n, k);
+        }
+
+
+        /** @brief Forward or backward substitution A X = B for all columns of a tile of width N holding the rows of B */
+        template <unsigned int N, typename NumericT>
+        void batched_trsm_in_tile(NumericT const * A, vcl_size_t A_stride1, vcl_size_t A_stride2,
+                                  NumericT * B_tile, vcl_size_t m, bool lower, bool unit_diagonal)
+        {
+          for (vcl_size_t ii=0; ii<m; ++ii)
+          {
+            vcl_size_t i = lower ? ii : m - ii - 1;
+            NumericT * row_i = B_tile + i*N;
+
+            vcl_size_t p_begin = lower ? 0 : i + 1;
+            vcl_size_t p_end   = lower ? i : m;
+            for (vcl_size_t p=p_begin; p<p_end; ++p)
+            {
+              NumericT a = A[i * A_stride1 + p * A_stride2];
+              for (unsigned int j=0; j<N; ++j)
+                row_i[j] -= a * B_tile[p*N + j];
+            }
+
+            if (!unit_diagonal)
+            {
+              NumericT diag = A[i * A_stride1 + i * A_stride2];
+              for (unsigned int j=0; j<N; ++j)
+                row_i[j] /= diag;
+            }
+          }
+        }
+
+        /** @brief Forward or backward substitution A X = B for all columns of B in place, arbitrary sizes */
+        template <typename NumericT>
+        void batched_trsm_generic(NumericT const * A, vcl_size_t A_stride1, vcl_size_t A_stride2,
+                                  NumericT * B, vcl_size_t B_stride1, vcl_size_t B_stride2,
+                                  vcl_size_t m, vcl_size_t n, bool lower, bool unit_diagonal)
+        {
+          for (vcl_size_t ii=0; ii<m; ++ii)
+          {
+            vcl_size_t i = lower ? ii : m - ii - 1;
+
+            vcl_size_t p_begin = lower ? 0 : i + 1;
+            vcl_size_t p_end   = lower ? i : m;
+            for (vcl_size_t p=p_begin; p<p_end; ++p)
+            {
+              NumericT a = A[i * A_stride1 + p * A_stride2];
+              for (vcl_size_t j=0; j<n; ++j)
+                B[i * B_stride1 + j * B_stride2] -= a * B[p * B_stride1 + j * B_stride2];
+            }
+
+            if (!unit_diagonal)
+            {
+              NumericT diag = A[i * A_stride1 + i * A_stride2];
+              for (vcl_size_t j=0; j<n; ++j)
+                B[i * B_stride1 + j * B_stride2] /= diag;
+            }
+          }
+        }
+
+        template <unsigned int N, typename NumericT>
+        void batched_trsm_tile(NumericT const * A, vcl_size_t A_stride1, vcl_size_t A_stride2,
+                               NumericT * B, vcl_size_t B_stride1, vcl_size_t B_stride2,
+                               vcl_size_t m, vcl_size_t n, bool lower, bool unit_diagonal)
+        {
+          NumericT B_tile[N * N];
+          for (vcl_size_t i=0; i<m; ++i)
+            for (unsigned int j=0; j<N; ++j)
+              B_tile[i*N + j] = (j < n) ? B[i * B_stride1 + j * B_stride2] : NumericT(0);
+
+          batched_trsm_in_tile<N>(A, A_stride1, A_stride2, B_tile, m, lower, unit_diagonal);
+
+          for (vcl_size_t i=0; i<m; ++i)
+            for (vcl_size_t j=0; j<n; ++j)
+              B[i * B_stride1 + j * B_stride2] = B_tile[i*N + j];
+        }
+
+        template <typename NumericT>
+        void batched_trsm_entry(NumericT const * A, vcl_size_t A_stride1, vcl_size_t A_stride2,
+                                NumericT * B, vcl_size_t B_stride1, vcl_size_t B_stride2,
+                                vcl_size_t m, vcl_size_t n, bool lower, bool unit_diagonal)
+        {
+          vcl_size_t tile_size = std::max(m, n);
+          if (tile_size <= 8)
+            batched_trsm_tile<8>(A, A_stride1, A_stride2, B, B_stride1, B_stride2, m, n, lower, unit_diagonal);
+          else if (tile_size <= 16)
+            batched_trsm_tile<16>(A, A_stride1, A_stride2, B, B_stride1, B_stride2, m, n, lower, unit_diagonal);
+          else if (tile_size <= 32)
+            batched_trsm_tile<32>(A, A_stride1, A_stride2, B, B_stride1, B_stride2, m, n, lower, unit_diagonal);
+          else if (tile_size <= 64)
+            batched_trsm_tile<64>(A, A_stride1, A_stride2, B, B_stride1, B_stride2, m, n, lower, unit_diagonal);
+          else
+            batched_trsm_generic(A, A_stride1, A_stride2, B, B_stride1, B_stride2, m, n, lower, unit_diagonal);
+        }
+
+
+        /** @brief LU factorization with partial pivoting of a single batch entry. Row i is swapped with row pivots[i] (0-based), exactly as in viennacl::linalg::lu_factorize().
+        *
+        * A zero pivot leaves the respective column uneliminated, so the factorization always completes. The zero then shows up on the diagonal of U.
+        */
+        template <unsigned int N, typename NumericT>
+        void batched_lu_tile(NumericT * A, vcl_size_t A_stride1, vcl_size_t A_stride2, vcl_size_t n, unsigned int * pivots)
+        {
+          NumericT A_tile[N * N];
+          for (vcl_size_t i=0; i<n; ++i)
+            for (unsigned int j=0; j<N; ++j)
+              A_tile[i*N + j] = (j < n) ? A[i * A_stride1 + j * A_stride2] : NumericT(0);
+
+          for (vcl_size_t j=0; j<n; ++j)
+          {
+            vcl_size_t pivot_row = j;
+            for (vcl_size_t i=j+1; i<n; ++i)
+              if (std::fabs(A_tile[i*N + j]) > std::fabs(A_tile[pivot_row*N + j]))
+                pivot_row = i;
+            pivots[j] = static_cast<unsigned int>(pivot_row);
+
+            if (pivot_row != j)
+              for (unsigned int c=0; c<N; ++c)
+                std::swap(A_tile[j*N + c], A_tile[pivot_row*N + c]);
+
+            NumericT diag = A_tile[j*N + j];
+            if (diag == NumericT(0))
+              continue;
+
+            for (vcl_size_t i=j+1; i<n; ++i)
+            {
+              NumericT factor = A_tile[i*N + j] / diag;
+              A_tile[i*N + j] = factor;
+              for (unsigned int c=static_cast<unsigned int>(j+1); c<N; ++c)
+                A_tile[i*N + c] -= factor * A_tile[j*N + c];
+            }
+          }
+
+          for (vcl_size_t i=0; i<n; ++i)
+            for (vcl_size_t j=0; j<n; ++j)
+              A[i * A_stride1 + j * A_stride2] = A_tile[i*N + j];
+        }
+
+        template <typename NumericT>
+        void batched_lu_generic(NumericT * A, vcl_size_t A_stride1, vcl_size_t A_stride2, vcl_size_t n, unsigned int * pivots)
+        {
+          for (vcl_size_t j=0; j<n; ++j)
+          {
+            vcl_size_t pivot_row = j;
+            for (vcl_size_t i=j+1; i<n; ++i)
+              if (std::fabs(A[i * A_stride1 + j * A_stride2]) > std::fabs(A[pivot_row * A_stride1 + j * A_stride2]))
+                pivot_row = i;
+            pivots[j] = static_cast<unsigned int>(pivot_row);
+
+            if (pivot_row != j)
+              for (vcl_size_t c=0; c<n; ++c)
+                std::swap(A[j * A_stride1 + c * A_stride2], A[pivot_row * A_stride1 + c * A_stride2]);
+
+            NumericT diag = A[j * A_stride1 + j * A_stride2];
+            if (diag == NumericT(0))
+              continue;
+
+            for (vcl_size_t i=j+1; i<n; ++i)
+            {
+              NumericT factor = A[i * A_stride1 + j * A_stride2] / diag;
+              A[i * A_stride1 + j * A_stride2] = factor;
+              for (vcl_size_t c=j+1; c<n; ++c)
+                A[i * A_stride1 + c * A_stride2] -= factor * A[j * A_stride1 + c * A_stride2];
+            }
+          }
+        }
+
+        template <typename NumericT>
+        void batched_lu_entry(NumericT * A, vcl_size_t A_stride1, vcl_size_t A_stride2, vcl_size_t n, unsigned int * pivots)
+        {
+          if (n <= 8)
+            batched_lu_tile<8>(A, A_stride1, A_stride2, n, pivots);
+          else if (n <= 16)
+            batched_lu_tile<16>(A, A_stride1, A_stride2, n, pivots);
+          else if (n <= 32)
+            batched_lu_tile<32>(A, A_stride1, A_stride2, n, pivots);
+          else if (n <= 64)
+            batched_lu_tile<64>(A, A_stride1, A_stride2, n, pivots);
+          else
+            batched_lu_generic(A, A_stride1, A_stride2, n, pivots);
+        }
+
+
+        /** @brief Solves A X = B for a single batch entry, where A is given by its LU factors and pivots as computed by batched_lu_entry() */
+        template <unsigned int N, typename NumericT>
+        void batched_lu_substitute_tile(NumericT const * LU, vcl_size_t LU_stride1, vcl_size_t LU_stride2, unsigned int const * pivots,
+                                        NumericT * B, vcl_size_t B_stride1, vcl_size_t B_stride2,
+                                        vcl_size_t n, vcl_size_t num_rhs)
+        {
+          NumericT B_tile[N * N];
+          for (vcl_size_t i=0; i<n; ++i)
+            for (unsigned int j=0; j<N; ++j)
+              B_tile[i*N + j] = (j < num_rhs) ? B[i * B_stride1 + j * B_stride2] : NumericT(0);
+
+          for (vcl_size_t i=0; i<n; ++i)
+            if (pivots[i] != i)
+              for (unsigned int j=0; j<N; ++j)
+                std::swap(B_tile[i*N + j], B_tile[pivots[i]*N + j]);
+
+          batched_trsm_in_tile<N>(LU, LU_stride1, LU_stride2, B_tile, n, true,  true);
+          batched_trsm_in_tile<N>(LU, LU_stride1, LU_stride2, B_tile, n, false, false);
+
+          for (vcl_size_t i=0; i<n; ++i)
+            for (vcl_size_t j=0; j<num_rhs; ++j)
+              B[i * B_stride1 + j * B_stride2] = B_tile[i*N + j];
+        }
+
+        template <typename NumericT>
+        void batched_lu_substitute_generic(NumericT const * LU, vcl_size_t LU_stride1, vcl_size_t LU_stride2, unsigned int const * pivots,
+                                           NumericT * B, vcl_size_t B_stride1, vcl_size_t B_stride2,
+                                           vcl_size_t n, vcl_size_t num_rhs)
+        {
+          for (vcl_size_t i=0; i<n; ++i)
+            if (pivots[i] != i)
+              for (vcl_size_t j=0; j<num_rhs; ++j)
+                std::swap(B[i * B_stride1 + j * B_stride2], B[pivots[i] * B_stride1 + j * B_stride2]);
+
+          batched_trsm_generic(LU, LU_stride1, LU_stride2, B, B_stride1, B_stride2, n, num_rhs, true,  true);
+          batched_trsm_generic(LU, LU_stride1, LU_stride2, B, B_stride1, B_stride2, n, num_rhs, false, false);
+        }
+
+        template <typename NumericT>
+        void batched_lu_substitute_entry(NumericT const * LU, vcl_size_t LU_stride1, vcl_size_t LU_stride2, unsigned int const * pivots,
+                                         NumericT * B, vcl_size_t B_stride1, vcl_size_t B_stride2,
+                                         vcl_size_t n, vcl_size_t num_rhs)
+        {
+          vcl_size_t tile_size = std::max(n, num_rhs);
+          if (tile_size <= 8)
+            batched_lu_substitute_tile<8>(LU, LU_stride1, LU_stride2, pivots, B, B_stride1, B_stride2, n, num_rhs);
+          else if (tile_size <= 16)
+            batched_lu_substitute_tile<16>(LU, LU_stride1, LU_stride2, pivots, B, B_stride1, B_stride2, n, num_rhs);
+          else if (tile_size <= 32)
+            batched_lu_substitute_tile<32>(LU, LU_stride1, LU_stride2, pivots, B, B_stride1, B_stride2, n, num_rhs);
+          else if (tile_size <= 64)
+            batched_lu_substitute_tile<64>(LU, LU_stride1, LU_stride2, pivots, B, B_stride1, B_stride2, n, num_rhs);
+          else
+            batched_lu_substitute_generic(LU, LU_stride1, LU_stride2, pivots, B, B_stride1, B_stride2, n, num_rhs);
+        }
+
+      } // namespace detail
+
+
+      //
+      // Strided batches: all matrices reside in one buffer, see viennacl::linalg::batch_layout
+      //
+
+      /** @brief Computes C_b = alpha * A_b * B_b + beta * C_b for all matrices of the batch. Each batch entry is processed by a single thread.
+      *
+      * @param alpha      Scaling factor for the product
+      * @param A          Buffer holding the first factors
+      * @param layout_A   Layout of the first factors within A (size m x k)
+      * @param B          Buffer holding the second factors
+      * @param layout_B   Layout of the second factors within B (size k x n)
+      * @param beta       Scaling factor for the previous content of C. C is not read if beta is zero.
+      * @param C          Buffer holding the results
+      * @param layout_C   Layout of the results within C (size m x n)
+      */
+      template <typename NumericT>
+      void batched_prod(NumericT alpha,
+                        vector_base<NumericT> const & A, batch_layout const & layout_A,
+                        vector_base<NumericT> const & B, batch_layout const & layout_B,
+                        NumericT beta,
+                        vector_base<NumericT> & C, batch_layout const & layout_C)
+      {
+        NumericT const * data_A = detail::extract_raw_pointer<NumericT>(A) + viennacl::traits::start(A) + layout_A.start();
+        NumericT const * data_B = detail::extract_raw_pointer<NumericT>(B) + viennacl::traits::start(B) + layout_B.start();
+        NumericT       * data_C = detail::extract_raw_pointer<NumericT>(C) + viennacl::traits::start(C) + layout_C.start();
+
+        long batch_count = static_cast<long>(layout_C.batch_count());
+#ifdef VIENNACL_WITH_OPENMP
+        #pragma omp parallel for
+#endif
+        for (long b = 0; b < batch_count; ++b)
+          detail::batched_gemm_entry(alpha,
+                                     data_A + static_cast<vcl_size_t>(b) * layout_A.batch_stride(), layout_A.stride1(), layout_A.stride2(),
+                                     data_B + static_cast<vcl_size_t>(b) * layout_B.batch_stride(), layout_B.stride1(), layout_B.stride2(),
+                                     beta,
+                                     data_C + static_cast<vcl_size_t>(b) * layout_C.batch_stride(), layout_C.stride1(), layout_C.stride2(),
+                                     layout_C.size1(), layout_C.size2(), layout_A.size2());
+      }
+
+      /** @brief Solves A_b X_b = B_b in place of B_b for all matrices of the batch, where A_b is triangular.
+      *
+      * @param A               Buffer holding the triangular matrices
+      * @param layout_A        Layout of the triangular matrices within A (size m x m)
+      * @param B               Buffer holding the right hand sides, overwritten by the solutions
+      * @param layout_B        Layout of the right hand sides within B (size m x n)
+      * @param lower           Whether A_b is lower (true) or upper (false) triangular
+      * @param unit_diagonal   Whether the diagonal of A_b is assumed to consist of ones
+      */
+      template <typename NumericT>
+      void batched_inplace_solve(vector_base<NumericT> const & A, batch_layout const & layout_A,
+                                 vector_base<NumericT> & B, batch_layout const & layout_B,
+                                 bool lower, bool unit_diagonal)
+      {
+        NumericT const * data_A = detail::extract_raw_pointer<NumericT>(A) + viennacl::traits::start(A) + layout_A.start();
+        NumericT       * data_B = detail::extract_raw_pointer<NumericT>(B) + viennacl::traits::start(B) + layout_B.start();
+
+        long batch_count = static_cast<long>(layout_B.batch_count());
+#ifdef VIENNACL_WITH_OPENMP
+        #pragma omp parallel for
+#endif
+        for (long b = 0; b < batch_count; ++b)
+          detail::batched_trsm_entry(data_A + static_cast<vcl_size_t>(b) * layout_A.batch_stride(), layout_A.stride1(), layout_A.stride2(),
+                                     data_B + static_cast<vcl_size_t>(b) * layout_B.batch_stride(), layout_B.stride1(), layout_B.stride2(),
+                                     layout_B.size1(), layout_B.size2(), lower, unit_diagonal);
+      }
+
+      /** @brief LU factorization with partial pivoting of all matrices of the batch in place. The n pivots of the b-th matrix are written to pivots[b*n], ..., pivots[b*n + n - 1]. */
+      template <typename NumericT>
+      void batched_lu_factorize(vector_base<NumericT> & A, batch_layout const & layout_A,
+                                vector_base<unsigned int> & pivots)
+      {
+        NumericT     * data_A      = detail::extract_raw_pointer<NumericT>(A) + viennacl::traits::start(A) + layout_A.start();
+        unsigned int * data_pivots = detail::extract_raw_pointer<unsigned int>(pivots) + viennacl::traits::start(pivots);
+
+        vcl_size_t n = layout_A.size1();
+        long batch_count = static_cast<long>(layout_A.batch_count());
+#ifdef VIENNACL_WITH_OPENMP
+        #pragma omp parallel for
+#endif
+        for (long b = 0; b < batch_count; ++b)
+          detail::batched_lu_entry(data_A + static_cast<vcl_size_t>(b) * layout_A.batch_stride(), layout_A.stride1(), layout_A.stride2(),
+                                   n, data_pivots + static_cast<vcl_size_t>(b) * n);
+      }
+
+      /** @brief Solves A_b X_b = B_b in place of B_b for all matrices of the batch, where A_b is given by the LU factors and pivots computed by batched_lu_factorize() */
+      template <typename NumericT>
+      void batched_lu_substitute(vector_base<NumericT> const & LU, batch_layout const & layout_LU,
+                                 vector_base<unsigned int> const & pivots,
+                                 vector_base<NumericT> & B, batch_layout const & layout_B)
+      {
+        NumericT     const * data_LU     = detail::extract_raw_pointer<NumericT>(LU) + viennacl::traits::start(LU) + layout_LU.start();
+        unsigned int const * data_pivots = detail::extract_raw_pointer<unsigned int>(pivots) + viennacl::traits::start(pivots);
+        NumericT           * data_B      = detail::extract_raw_pointer<NumericT>(B) + viennacl::traits::start(B) + layout_B.start();
+
+        vcl_size_t n = layout_LU.size1();
+        long batch_count = static_cast<long>(layout_B.batch_count());
+#ifdef VIENNACL_WITH_OPENMP
+        #pragma omp parallel for
+#endif
+        for (long b = 0; b < batch_count; ++b)
+          detail::batched_lu_substitute_entry(data_LU + static_cast<vcl_size_t>(b) * layout_LU.batch_stride(), layout_LU.stride1(), layout_LU.stride2(),
+                                              data_pivots + static_cast<vcl_size_t>(b) * n,
+                                              data_B + static_cast<vcl_size_t>(b) * layout_B.batch_stride(), layout_B.stride1(), layout_B.stride2(),
+                                              n, layout_B.size2());
+      }
+
+
+      //
+      // Pointer-array batches: the b-th matrix starts at ptr[b] + layout.start(), the batch stride of the layout is ignored.
+      //
+
+      /** @brief Computes C[b] = alpha * A[b] * B[b] + beta * C[b] for an array of matrices in host memory */
+      template <typename NumericT>
+      void batched_prod(NumericT alpha,
+                        NumericT const * const * A, batch_layout const & layout_A,
+                        NumericT const * const * B, batch_layout const & layout_B,
+                        NumericT beta,
+                        NumericT * const * C, batch_layout const & layout_C)
+      {
+        long batch_count = static_cast<long>(layout_C.batch_count());
+#ifdef VIENNACL_WITH_OPENMP
+        #pragma omp parallel for
+#endif
+        for (long b = 0; b < batch_count; ++b)
+          detail::batched_gemm_entry(alpha,
+                                     A[b] + layout_A.start(), layout_A.stride1(), layout_A.stride2(),
+                                     B[b] + layout_B.start(), layout_B.stride1(), layout_B.stride2(),
+                                     beta,
+                                     C[b] + layout_C.start(), layout_C.stride1(), layout_C.stride2(),
+                                     layout_C.size1(), layout_C.size2(), layout_A.size2());
+      }
+
+      /** @brief Solves A[b] X = B[b] in place of B[b] for an array of triangular matrices in host memory */
+      template <typename NumericT>
+      void batched_inplace_solve(NumericT const * const * A, batch_layout const & layout_A,
+                                 NumericT * const * B, batch_layout const & layout_B,
+                                 bool lower, bool unit_diagonal)
+      {
+        long batch_count = static_cast<long>(layout_B.batch_count());
+#ifdef VIENNACL_WITH_OPENMP
+        #pragma omp parallel for
+#endif
+        for (long b = 0; b < batch_count; ++b)
+          detail::batched_trsm_entry(A[b] + layout_A.start(), layout_A.stride1(), layout_A.stride2(),
+                                     B[b] + layout_B.start(), layout_B.stride1(), layout_B.stride2(),
+                                     layout_B.size1(), layout_B.size2(), lower, unit_diagonal);
+      }
+
+      /** @brief LU factorization with partial pivoting of an array of matrices in host memory. The pivots of A[b] are written to pivots[b]. */
+      template <typename NumericT>
+      void batched_lu_factorize(NumericT * const * A, batch_layout const & layout_A,
+                                unsigned int * const * pivots)
+      {
+        long batch_count = static_cast<long>(layout_A.batch_count());
+#ifdef VIENNACL_WITH_OPENMP
+        #pragma omp parallel for
+#endif
+        for (long b = 0; b < batch_count; ++b)
+          detail::batched_lu_entry(A[b] + layout_A.start(), layout_A.stride1(), layout_A.stride2(), layout_A.size1(), pivots[b]);
+      }
+
+      /** @brief Solves A[b] X = B[b] in place of B[b] for an array of LU-factored matrices in host memory */
+      template <typename NumericT>
+      void batched_lu_substitute(NumericT const * const * LU, batch_layout const & layout_LU,
+                                 unsigned int const * const * pivots,
+                                 NumericT * const * B, batch_layout const & layout_B)
+      {
+        long batch_count = static_cast<long>(layout_B.batch_count());
+#ifdef VIENNACL_WITH_OPENMP
+        #pragma omp parallel for
+#endif
+        for (long b = 0; b < batch_count; ++b)
+          detail::batched_lu_substitute_entry(LU[b] + layout_LU.start(), layout_LU.stride1(), layout_LU.stride2(),
+                                              pivots[b],
+                                              B[b] + layout_B.start(), layout_B.stride1(), layout_B.stride2(),
+                                              layout_LU.size1(), layout_B.size2());
+      }
+
+    } // namespace host_based
+  } //namespace linalg
+} //namespace viennacl
+
+
+#endif
@@ -149,6 +149,26 @@ namespace viennacl
             std::size_t internal_size1_, internal_size2_;
         };
 
+        /** @brief Shifts the indices of a matrix wrapper, so that sub-blocks can be passed to the kernels operating on wrappers */
+        template <typename WrapperT>
+        class matrix_offset_wrapper
+        {
+          public:
+            typedef typename WrapperT::value_type   value_type;
+
+            matrix_offset_wrapper(WrapperT const & A, std::size_t offset1, std::size_t offset2)
+             : A_(A), offset1_(offset1), offset2_(offset2) {}
+
+            value_type & operator()(std::size_t i, std::size_t j)
+            {
+              return A_(i + offset1_, j + offset2_);
+            }
+
+          private:
+            WrapperT A_;
+            std::size_t offset1_, offset2_;
+        };
+
       }
 
     } //namespace host_based
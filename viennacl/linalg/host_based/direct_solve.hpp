@@ -26,6 +26,7 @@
 #include "viennacl/matrix.hpp"
 
 #include "viennacl/linalg/host_based/common.hpp"
+#include "viennacl/linalg/host_based/matrix_operations.hpp"
 
 namespace viennacl
 {
@@ -36,31 +37,60 @@ namespace viennacl
 
       namespace detail
       {
+        /** @brief Block size used for the blocked triangular solvers with multiple right hand sides */
+        inline std::size_t inplace_solve_block_size() { return 64; }
+
         //
         // Upper solve:
         //
         template <typename MatrixType1, typename MatrixType2>
-        void upper_inplace_solve_matrix(MatrixType1 & A, MatrixType2 & B, std::size_t A_size, std::size_t B_size, bool unit_diagonal)
+        void upper_inplace_solve_matrix_unblocked(MatrixType1 & A, MatrixType2 & B, std::size_t A_size, std::size_t B_size, bool unit_diagonal)
         {
           typedef typename MatrixType2::value_type   value_type;
 
-          for (std::size_t i = 0; i < A_size; ++i)
+#ifdef VIENNACL_WITH_OPENMP
+          #pragma omp parallel for if (B_size > 16)
+#endif
+          for (long k = 0; k < static_cast<long>(B_size); ++k)
           {
-            std::size_t current_row = A_size - i - 1;
-
-            for (std::size_t j = current_row + 1; j < A_size; ++j)
+            for (std::size_t i = 0; i < A_size; ++i)
             {
-              value_type A_element = A(current_row, j);
-              for (std::size_t k=0; k < B_size; ++k)
-                B(current_row, k) -= A_element * B(j, k);
+              std::size_t current_row = A_size - i - 1;
+
+              value_type temp = B(current_row, k);
+              for (std::size_t j = current_row + 1; j < A_size; ++j)
+                temp -= A(current_row, j) * B(j, k);
+
+              if (!unit_diagonal)
+                temp /= A(current_row, current_row);
+              B(current_row, k) = temp;
             }
+          }
+        }
 
-            if (!unit_diagonal)
+        /** @brief Blocked upper triangular solve: Diagonal blocks are solved directly, the remaining rows are updated with matrix-matrix products */
+        template <typename MatrixType1, typename MatrixType2>
+        void upper_inplace_solve_matrix(MatrixType1 & A, MatrixType2 & B, std::size_t A_size, std::size_t B_size, bool unit_diagonal)
+        {
+          typedef typename MatrixType2::value_type   value_type;
+
+          std::size_t block_size = inplace_solve_block_size();
+          std::size_t block_end = A_size;
+          while (block_end > 0)
+          {
+            std::size_t block_start = (block_end > block_size) ? block_end - block_size : 0;
+
+            matrix_offset_wrapper<MatrixType1> A_11(A, block_start, block_start);
+            matrix_offset_wrapper<MatrixType2> B_1(B, block_start, 0);
+            upper_inplace_solve_matrix_unblocked(A_11, B_1, block_end - block_start, B_size, unit_diagonal);
+
+            if (block_start > 0) // B_0 -= A_01 * B_1
             {
-              value_type A_diag = A(current_row, current_row);
-              for (std::size_t k=0; k < B_size; ++k)
-                B(current_row, k) /= A_diag;
+              matrix_offset_wrapper<MatrixType1> A_01(A, 0, block_start);
+              prod(A_01, B_1, B, block_start, B_size, block_end - block_start, value_type(-1), value_type(1));
             }
+
+            block_end = block_start;
           }
         }
 
@@ -80,24 +110,48 @@ namespace viennacl
         // Lower solve:
         //
         template <typename MatrixType1, typename MatrixType2>
-        void lower_inplace_solve_matrix(MatrixType1 & A, MatrixType2 & B, std::size_t A_size, std::size_t B_size, bool unit_diagonal)
+        void lower_inplace_solve_matrix_unblocked(MatrixType1 & A, MatrixType2 & B, std::size_t A_size, std::size_t B_size, bool unit_diagonal)
         {
           typedef typename MatrixType2::value_type   value_type;
 
-          for (std::size_t i = 0; i < A_size; ++i)
+#ifdef VIENNACL_WITH_OPENMP
+          #pragma omp parallel for if (B_size > 16)
+#endif
+          for (long k = 0; k < static_cast<long>(B_size); ++k)
           {
-            for (std::size_t j = 0; j < i; ++j)
+            for (std::size_t i = 0; i < A_size; ++i)
             {
-              value_type A_element = A(i, j);
-              for (std::size_t k=0; k < B_size; ++k)
-                B(i, k) -= A_element * B(j, k);
+              value_type temp = B(i, k);
+              for (std::size_t j = 0; j < i; ++j)
+                temp -= A(i, j) * B(j, k);
+
+              if (!unit_diagonal)
+                temp /= A(i, i);
+              B(i, k) = temp;
             }
+          }
+        }
 
-            if (!unit_diagonal)
+        /** @brief Blocked lower triangular solve: Diagonal blocks are solved directly, the remaining rows are updated with matrix-matrix products */
+        template <typename MatrixType1, typename MatrixType2>
+        void lower_inplace_solve_matrix(MatrixType1 & A, MatrixType2 & B, std::size_t A_size, std::size_t B_size, bool unit_diagonal)
+        {
+          typedef typename MatrixType2::value_type   value_type;
+
+          std::size_t block_size = inplace_solve_block_size();
+          for (std::size_t block_start = 0; block_start < A_size; block_start += block_size)
+          {
+            std::size_t block_end = std::min(block_start + block_size, A_size);
+
+            matrix_offset_wrapper<MatrixType1> A_11(A, block_start, block_start);
+            matrix_offset_wrapper<MatrixType2> B_1(B, block_start, 0);
+            lower_inplace_solve_matrix_unblocked(A_11, B_1, block_end - block_start, B_size, unit_diagonal);
+
+            if (block_end < A_size) // B_2 -= A_21 * B_1
             {
-              value_type A_diag = A(i, i);
-              for (std::size_t k=0; k < B_size; ++k)
-                B(i, k) /= A_diag;
+              matrix_offset_wrapper<MatrixType1> A_21(A, block_end, block_start);
+              matrix_offset_wrapper<MatrixType2> B_2(B, block_end, 0);
+              prod(A_21, B_1, B_2, A_size - block_end, B_size, block_end - block_start, value_type(-1), value_type(1));
             }
           }
         }
@@ -0,0 +1,244 @@
+#ifndef VIENNACL_LINALG_HOST_BASED_LU_HPP_
+#define VIENNACL_LINALG_HOST_BASED_LU_HPP_
+
+/* =========================================================================
+   Copyright (c) 2010-2013, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/linalg/host_based/lu.hpp
+    @brief Implementation of the blocked LU factorization with partial pivoting using a plain single-threaded or OpenMP-enabled execution on CPU.
+*/
+
+#include <vector>
+#include <cmath>
+#include <algorithm>
+
+#include "viennacl/vector.hpp"
+#include "viennacl/matrix.hpp"
+#include "viennacl/linalg/host_based/common.hpp"
+#include "viennacl/linalg/host_based/matrix_operations.hpp"
+#include "viennacl/linalg/host_based/direct_solve.hpp"
+
+namespace viennacl
+{
+  namespace linalg
+  {
+    namespace host_based
+    {
+      namespace detail
+      {
+        /** @brief Block size (number of columns of a panel) used for the blocked LU factorization */
+        inline std::size_t lu_block_size() { return 64; }
+
+        /** @brief Applies the row interchanges pivots[first], ..., pivots[last-1] to the columns [col_begin, col_end) of A */
+        template <typename MatrixType>
+        void lu_swap_rows(MatrixType & A, std::vector<std::size_t> const & pivots,
+                          std::size_t first, std::size_t last,
+                          std::size_t col_begin, std::size_t col_end)
+        {
+          typedef typename MatrixType::value_type   value_type;
+
+#ifdef VIENNACL_WITH_OPENMP
+          #pragma omp parallel for if (col_end - col_begin > 256)
+#endif
+          for (long j = static_cast<long>(col_begin); j < static_cast<long>(col_end); ++j)
+          {
+            for (std::size_t i = first; i < last; ++i)
+            {
+              if (pivots[i] != i)
+              {
+                value_type temp = A(i, j);
+                A(i, j) = A(pivots[i], j);
+                A(pivots[i], j) = temp;
+              }
+            }
+          }
+        }
+
+        /** @brief Recursive LU factorization with partial pivoting of the panel A(offset:size1, offset:offset+num_cols)
+        *
+        * Row interchanges are only applied within the panel. The columns are split in halves, the left half is factorized recursively,
+        * the right half is updated with a triangular solve and a matrix-matrix product, and then factorized recursively.
+        */
+        template <typename MatrixType>
+        void lu_factorize_panel(MatrixType & A, std::size_t size1, std::size_t offset, std::size_t num_cols, std::vector<std::size_t> & pivots)
+        {
+          typedef typename MatrixType::value_type   value_type;
+
+          if (num_cols == 1)
+          {
+            std::size_t pivot_row = offset;
+            value_type pivot_value = std::fabs(A(offset, offset));
+            for (std::size_t i = offset + 1; i < size1; ++i)
+            {
+              if (std::fabs(A(i, offset)) > pivot_value)
+              {
+                pivot_row = i;
+                pivot_value = std::fabs(A(i, offset));
+              }
+            }
+
+            pivots[offset] = pivot_row;
+            if (pivot_row != offset)
+              std::swap(A(offset, offset), A(pivot_row, offset));
+
+            value_type a_kk = A(offset, offset);
+            if (a_kk != 0)  // singular matrix: leave column as is, the triangular solves will break down
+              for (std::size_t i = offset + 1; i < size1; ++i)
+                A(i, offset) /= a_kk;
+            return;
+          }
+
+          std::size_t n1 = num_cols / 2;
+          std::size_t n2 = num_cols - n1;
+
+          // [ A_11 ]
+          // [ A_21 ] = P_1 L_1 U_11
+          lu_factorize_panel(A, size1, offset, n1, pivots);
+
+          // apply pivots to [A_12; A_22]:
+          lu_swap_rows(A, pivots, offset, offset + n1, offset + n1, offset + num_cols);
+
+          // A_12 = L_11^{-1} A_12
+          matrix_offset_wrapper<MatrixType> A_11(A, offset, offset);
+          matrix_offset_wrapper<MatrixType> A_12(A, offset, offset + n1);
+          lower_inplace_solve_matrix(A_11, A_12, n1, n2, true);
+
+          // A_22 -= A_21 A_12
+          matrix_offset_wrapper<MatrixType> A_21(A, offset + n1, offset);
+          matrix_offset_wrapper<MatrixType> A_22(A, offset + n1, offset + n1);
+          prod(A_21, A_12, A_22, size1 - offset - n1, n2, n1, value_type(-1), value_type(1));
+
+          // A_22 = P_2 L_2 U_22
+          lu_factorize_panel(A, size1, offset + n1, n2, pivots);
+
+          // apply pivots to A_21:
+          lu_swap_rows(A, pivots, offset + n1, offset + num_cols, offset, offset + n1);
+        }
+
+        /** @brief Blocked right-looking LU factorization with partial pivoting of a square matrix */
+        template <typename MatrixType>
+        void lu_factorize(MatrixType & A, std::size_t size, std::vector<std::size_t> & pivots)
+        {
+          typedef typename MatrixType::value_type   value_type;
+
+          pivots.resize(size);
+          std::size_t block_size = lu_block_size();
+
+          for (std::size_t block_start = 0; block_start < size; block_start += block_size)
+          {
+            std::size_t block_end = std::min(block_start + block_size, size);
+
+            // factorize panel:
+            lu_factorize_panel(A, size, block_start, block_end - block_start, pivots);
+
+            // apply row interchanges to the left and to the right of the panel:
+            lu_swap_rows(A, pivots, block_start, block_end, 0, block_start);
+            lu_swap_rows(A, pivots, block_start, block_end, block_end, size);
+
+            if (block_end < size)
+            {
+              // U_12 = L_11^{-1} A_12
+              matrix_offset_wrapper<MatrixType> L_11(A, block_start, block_start);
+              matrix_offset_wrapper<MatrixType> A_12(A, block_start, block_end);
+              lower_inplace_solve_matrix(L_11, A_12, block_end - block_start, size - block_end, true);
+
+              // trailing update A_22 -= L_21 U_12
+              matrix_offset_wrapper<MatrixType> L_21(A, block_end, block_start);
+              matrix_offset_wrapper<MatrixType> A_22(A, block_end, block_end);
+              prod(L_21, A_12, A_22, size - block_end, size - block_end, block_end - block_start, value_type(-1), value_type(1));
+            }
+          }
+        }
+      }
+
+      /** @brief LU factorization with partial pivoting of a dense matrix in main memory, P A = L U.
+      *
+      * @param A        The system matrix, where the LU matrices are directly written to. The implicit unit diagonal of L is not written.
+      * @param pivots   Row interchanges: row i was interchanged with row pivots[i] in the i-th step
+      */
+      template <typename NumericT, typename F>
+      void lu_factorize(matrix_base<NumericT, F> & A, std::vector<std::size_t> & pivots)
+      {
+        typedef NumericT        value_type;
+
+        value_type * data_A = detail::extract_raw_pointer<value_type>(A);
+
+        std::size_t A_start1 = viennacl::traits::start1(A);
+        std::size_t A_start2 = viennacl::traits::start2(A);
+        std::size_t A_inc1   = viennacl::traits::stride1(A);
+        std::size_t A_inc2   = viennacl::traits::stride2(A);
+        std::size_t A_size1  = viennacl::traits::size1(A);
+        std::size_t A_internal_size1  = viennacl::traits::internal_size1(A);
+        std::size_t A_internal_size2  = viennacl::traits::internal_size2(A);
+
+        detail::matrix_array_wrapper<value_type, typename F::orientation_category, false>   wrapper_A(data_A, A_start1, A_start2, A_inc1, A_inc2, A_internal_size1, A_internal_size2);
+
+        detail::lu_factorize(wrapper_A, A_size1, pivots);
+      }
+
+      /** @brief Applies the row interchanges of an LU factorization with partial pivoting to a matrix of right hand sides
+      *
+      * @param B        The matrix of right hand sides
+      * @param pivots   Row interchanges as returned by lu_factorize()
+      */
+      template <typename NumericT, typename F>
+      void lu_swap_rows(matrix_base<NumericT, F> & B, std::vector<std::size_t> const & pivots)
+      {
+        typedef NumericT        value_type;
+
+        value_type * data_B = detail::extract_raw_pointer<value_type>(B);
+
+        std::size_t B_start1 = viennacl::traits::start1(B);
+        std::size_t B_start2 = viennacl::traits::start2(B);
+        std::size_t B_inc1   = viennacl::traits::stride1(B);
+        std::size_t B_inc2   = viennacl::traits::stride2(B);
+        std::size_t B_size2  = viennacl::traits::size2(B);
+        std::size_t B_internal_size1  = viennacl::traits::internal_size1(B);
+        std::size_t B_internal_size2  = viennacl::traits::internal_size2(B);
+
+        detail::matrix_array_wrapper<value_type, typename F::orientation_category, false>   wrapper_B(data_B, B_start1, B_start2, B_inc1, B_inc2, B_internal_size1, B_internal_size2);
+
+        detail::lu_swap_rows(wrapper_B, pivots, 0, pivots.size(), 0, B_size2);
+      }
+
+      /** @brief Applies the row interchanges of an LU factorization with partial pivoting to a right hand side vector
+      *
+      * @param vec      The right hand side vector
+      * @param pivots   Row interchanges as returned by lu_factorize()
+      */
+      template <typename NumericT>
+      void lu_swap_rows(vector_base<NumericT> & vec, std::vector<std::size_t> const & pivots)
+      {
+        typedef NumericT        value_type;
+
+        value_type * data_v = detail::extract_raw_pointer<value_type>(vec);
+
+        std::size_t start1 = viennacl::traits::start(vec);
+        std::size_t inc1   = viennacl::traits::stride(vec);
+
+        detail::vector_array_wrapper<value_type> wrapper_v(data_v, start1, inc1);
+
+        for (std::size_t i = 0; i < pivots.size(); ++i)
+          if (pivots[i] != i)
+            std::swap(wrapper_v(i), wrapper_v(pivots[i]));
+      }
+
+    }
+  }
+}
+
+#endif
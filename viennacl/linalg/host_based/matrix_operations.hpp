@@ -22,6 +22,9 @@
     @brief Implementations of dense matrix related operations, including matrix-vector products, using a plain single-threaded or OpenMP-enabled execution on CPU.
 */
 
+#include <vector>
+#include <algorithm>
+
 #include "viennacl/forwards.h"
 #include "viennacl/scalar.hpp"
 #include "viennacl/vector.hpp"
@@ -775,17 +778,13 @@ namespace viennacl
         }
         else
         {
-          {
-            value_type temp = data_x[start1];
-            for (std::size_t row = 0; row < A_size1; ++row)
-              data_result[row * inc2 + start2] = data_A[viennacl::column_major::mem_index(row * A_inc1 + A_start1, A_start2, A_internal_size1, A_internal_size2)] * temp;
-          }
-          for (std::size_t col = 1; col < A_size2; ++col)  //run through matrix sequentially
-          {
-            value_type temp = data_x[col * inc1 + start1];
-            for (std::size_t row = 0; row < A_size1; ++row)
-              data_result[row * inc2 + start2] += data_A[viennacl::column_major::mem_index(row * A_inc1 + A_start1, col * A_inc2 + A_start2, A_internal_size1, A_internal_size2)] * temp;
-          }
+          // result = sum_j x_j * A(:, j), computed in a single pass over result:
+          detail::strided_vector_set<value_type> columns(data_A + viennacl::column_major::mem_index(A_start1, A_start2, A_internal_size1, A_internal_size2),
+                                                         A_inc2 * A_internal_size1, A_inc1);
+          detail::multi_axpy(data_result + start2, inc2,
+                             data_x + start1, inc1,
+                             columns, A_size2,
+                             A_size1, true);
         }
       }
 
@@ -828,20 +827,19 @@ namespace viennacl
 
         if (detail::is_row_major(typename F::orientation_category()))
         {
-          {
-            value_type temp = data_x[start1];
-            for (std::size_t row = 0; row < A_size2; ++row)
-              data_result[row * inc2 + start2] = data_A[viennacl::row_major::mem_index(A_start1, row * A_inc2 + A_start2, A_internal_size1, A_internal_size2)] * temp;
-          }
-
-          for (std::size_t col = 1; col < A_size1; ++col)  //run through matrix sequentially
-          {
-            value_type temp = data_x[col * inc1 + start1];
-            for (std::size_t row = 0; row < A_size2; ++row)
-            {
-              data_result[row * inc2 + start2] += data_A[viennacl::row_major::mem_index(col * A_inc1 + A_start1, row * A_inc2 + A_start2, A_internal_size1, A_internal_size2)] * temp;
-            }
-          }
+          // result = sum_i x_i * A(i, :), computed in a single pass over result:
+          detail::strided_vector_set<value_type> rows(data_A + viennacl::row_major::mem_index(A_start1, A_start2, A_internal_size1, A_internal_size2),
+                                                      A_inc1 * A_internal_size2, A_inc2);
+          detail::multi_axpy(data_result + start2, inc2,
+                             data_x + start1, inc1,
+                             rows, A_size1,
+                             A_size2, true);
+        }
+        else if (A_size1 >= 4 * A_size2) // tall matrix, e.g. a set of vectors V: compute V^T x with one pass over x per 16 columns
+        {
+          detail::strided_vector_set<value_type> columns(data_A + viennacl::column_major::mem_index(A_start1, A_start2, A_internal_size1, A_internal_size2),
+                                                         A_inc2 * A_internal_size1, A_inc1);
+          detail::multi_inner_prod(data_x + start1, inc1, columns, A_size2, A_size1, data_result + start2, inc2);
         }
         else
         {
@@ -867,9 +865,9 @@ namespace viennacl
       namespace detail
       {
         template <typename A, typename B, typename C, typename NumericT>
-        void prod(A & a, B & b, C & c,
-                  std::size_t C_size1, std::size_t C_size2, std::size_t A_size2,
-                  NumericT alpha, NumericT beta)
+        void prod_unblocked(A & a, B & b, C & c,
+                            std::size_t C_size1, std::size_t C_size2, std::size_t A_size2,
+                            NumericT alpha, NumericT beta)
         {
           for (std::size_t i=0; i<C_size1; ++i)
           {
@@ -887,6 +885,83 @@ namespace viennacl
           }
         }
 
+        /** @brief Cache-blocked matrix-matrix product C = alpha * A * B + beta * C
+        *
+        * Tiles of A and B are packed into contiguous buffers, so that the innermost loop runs over unit-stride memory irrespective of the layout and transposition of the operands.
+        * Tiles of C are independent and distributed among the OpenMP threads.
+        */
+        template <typename A, typename B, typename C, typename NumericT>
+        void prod(A & a, B & b, C & c,
+                  std::size_t C_size1, std::size_t C_size2, std::size_t A_size2,
+                  NumericT alpha, NumericT beta)
+        {
+          std::size_t const block_size_1 = 64;
+          std::size_t const block_size_2 = 64;
+          std::size_t const block_size_k = 256;
+
+          // tall and skinny products (e.g. with the factors in NMF) still benefit from packing, so only tiny products are computed directly:
+          if (C_size1 * C_size2 * A_size2 < 16 * 16 * 16 || A_size2 < 4)
+          {
+            prod_unblocked(a, b, c, C_size1, C_size2, A_size2, alpha, beta);
+            return;
+          }
+
+          long num_blocks_1 = static_cast<long>((C_size1 - 1) / block_size_1 + 1);
+          long num_blocks_2 = static_cast<long>((C_size2 - 1) / block_size_2 + 1);
+
+#ifdef VIENNACL_WITH_OPENMP
+          #pragma omp parallel for
+#endif
+          for (long block_id = 0; block_id < num_blocks_1 * num_blocks_2; ++block_id)
+          {
+            std::vector<NumericT> buffer_A(block_size_1 * block_size_k);
+            std::vector<NumericT> buffer_B(block_size_k * block_size_2);
+            std::vector<NumericT> buffer_C(block_size_1 * block_size_2);
+
+            std::size_t row_start = static_cast<std::size_t>(block_id / num_blocks_2) * block_size_1;
+            std::size_t col_start = static_cast<std::size_t>(block_id % num_blocks_2) * block_size_2;
+            std::size_t rows = std::min(block_size_1, C_size1 - row_start);
+            std::size_t cols = std::min(block_size_2, C_size2 - col_start);
+
+            for (std::size_t k_start = 0; k_start < A_size2; k_start += block_size_k)
+            {
+              std::size_t k_size = std::min(block_size_k, A_size2 - k_start);
+
+              // pack tiles (row-major):
+              for (std::size_t i=0; i<rows; ++i)
+                for (std::size_t k=0; k<k_size; ++k)
+                  buffer_A[i*k_size + k] = a(row_start + i, k_start + k);
+              for (std::size_t k=0; k<k_size; ++k)
+                for (std::size_t j=0; j<cols; ++j)
+                  buffer_B[k*cols + j] = b(k_start + k, col_start + j);
+
+              // multiply tiles:
+              for (std::size_t i=0; i<rows; ++i)
+              {
+                NumericT       * C_row = &(buffer_C[i*cols]);
+                NumericT const * A_row = &(buffer_A[i*k_size]);
+                for (std::size_t k=0; k<k_size; ++k)
+                {
+                  NumericT a_ik = A_row[k];
+                  NumericT const * B_row = &(buffer_B[k*cols]);
+                  for (std::size_t j=0; j<cols; ++j)
+                    C_row[j] += a_ik * B_row[j];
+                }
+              }
+            }
+
+            // write back:
+            for (std::size_t i=0; i<rows; ++i)
+              for (std::size_t j=0; j<cols; ++j)
+              {
+                NumericT temp = alpha * buffer_C[i*cols + j];
+                if (beta != 0)
+                  temp += beta * c(row_start + i, col_start + j);
+                c(row_start + i, col_start + j) = temp;
+              }
+          }
+        }
+
       }
 
       /** @brief Carries out matrix-matrix multiplication
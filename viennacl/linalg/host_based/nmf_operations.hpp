@@ -0,0 +1,111 @@
+#ifndef VIENNACL_LINALG_HOST_BASED_NMF_OPERATIONS_HPP_
+#define VIENNACL_LINALG_HOST_BASED_NMF_OPERATIONS_HPP_
+
+/* =========================================================================
+   Copyright (c) 2010-2013, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/linalg/host_based/nmf_operations.hpp
+    @brief Implementations of the multiplicative updates of the nonnegative matrix factorization on the CPU using a single thread or OpenMP.
+*/
+
+#include <vector>
+#include <algorithm>
+
+#include "viennacl/forwards.h"
+#include "viennacl/traits/size.hpp"
+#include "viennacl/traits/start.hpp"
+#include "viennacl/traits/stride.hpp"
+#include "viennacl/linalg/host_based/common.hpp"
+
+namespace viennacl
+{
+  namespace linalg
+  {
+    namespace host_based
+    {
+
+      /** @brief Multiplicative Lee-Seung update of a factor: X_ij <- X_ij * N_ij / (X * S)_ij
+      *
+      * The denominator X * S is computed row by row and consumed immediately, so no temporary of the size of X is needed.
+      * Since S is only k x k, each row of the product only depends on the same row of X, which allows for an in-place update.
+      *
+      * @param X    The factor to be updated (size m x k)
+      * @param N    The numerator (size m x k)
+      * @param S    The symmetric Gram matrix of the other factor (size k x k)
+      */
+      template <typename NumericT, typename F>
+      void nmf_update_factor(matrix_base<NumericT, F> & X,
+                             matrix_base<NumericT, F> const & N,
+                             matrix_base<NumericT, F> const & S)
+      {
+        typedef NumericT        value_type;
+
+        value_type       * data_X = detail::extract_raw_pointer<value_type>(X);
+        value_type const * data_N = detail::extract_raw_pointer<value_type>(N);
+        value_type const * data_S = detail::extract_raw_pointer<value_type>(S);
+
+        detail::matrix_array_wrapper<value_type,       typename F::orientation_category, false>
+          wrapper_X(data_X, viennacl::traits::start1(X), viennacl::traits::start2(X),
+                            viennacl::traits::stride1(X), viennacl::traits::stride2(X),
+                            viennacl::traits::internal_size1(X), viennacl::traits::internal_size2(X));
+        detail::matrix_array_wrapper<value_type const, typename F::orientation_category, false>
+          wrapper_N(data_N, viennacl::traits::start1(N), viennacl::traits::start2(N),
+                            viennacl::traits::stride1(N), viennacl::traits::stride2(N),
+                            viennacl::traits::internal_size1(N), viennacl::traits::internal_size2(N));
+        detail::matrix_array_wrapper<value_type const, typename F::orientation_category, false>
+          wrapper_S(data_S, viennacl::traits::start1(S), viennacl::traits::start2(S),
+                            viennacl::traits::stride1(S), viennacl::traits::stride2(S),
+                            viennacl::traits::internal_size1(S), viennacl::traits::internal_size2(S));
+
+        long size1 = static_cast<long>(viennacl::traits::size1(X));
+        long k     = static_cast<long>(viennacl::traits::size2(X));
+
+#ifdef VIENNACL_WITH_OPENMP
+        #pragma omp parallel
+#endif
+        {
+          std::vector<value_type> denominator(static_cast<std::size_t>(k));
+
+#ifdef VIENNACL_WITH_OPENMP
+          #pragma omp for
+#endif
+          for (long row = 0; row < size1; ++row)
+          {
+            // denominator = X(row, :) * S as a linear combination of the rows of S:
+            std::fill(denominator.begin(), denominator.end(), value_type(0));
+            for (long l = 0; l < k; ++l)
+            {
+              value_type x_l = wrapper_X(row, l);
+              for (long col = 0; col < k; ++col)
+                denominator[static_cast<std::size_t>(col)] += x_l * wrapper_S(l, col);
+            }
+
+            for (long col = 0; col < k; ++col)
+            {
+              value_type divisor = denominator[static_cast<std::size_t>(col)];
+              wrapper_X(row, col) = (divisor > value_type(0.00001)) ? (wrapper_X(row, col) * wrapper_N(row, col) / divisor) : value_type(0);
+            }
+          }
+        }
+      }
+
+    } // namespace host_based
+  } //namespace linalg
+} //namespace viennacl
+
+
+#endif
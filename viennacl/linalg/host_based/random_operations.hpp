@@ -0,0 +1,207 @@
+#ifndef VIENNACL_LINALG_HOST_BASED_RANDOM_OPERATIONS_HPP_
+#define VIENNACL_LINALG_HOST_BASED_RANDOM_OPERATIONS_HPP_
+
+/* =========================================================================
+   Copyright (c) 2010-2013, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/linalg/host_based/random_operations.hpp
+    @brief Fills vectors and matrices with random numbers from the Philox4x32-10 generator on the CPU using a single thread or OpenMP.
+*/
+
+#include <algorithm>
+
+#include "viennacl/forwards.h"
+#include "viennacl/traits/size.hpp"
+#include "viennacl/traits/start.hpp"
+#include "viennacl/traits/stride.hpp"
+#include "viennacl/linalg/host_based/common.hpp"
+#include "viennacl/rand/utils.hpp"
+#include "viennacl/rand/uniform.hpp"
+#include "viennacl/rand/gaussian.hpp"
+
+namespace viennacl
+{
+  namespace linalg
+  {
+    namespace host_based
+    {
+      namespace detail
+      {
+        /** @brief Writes the random values with logical indices first_index, ..., first_index + count - 1 to ptr[0], ptr[stride], ..., ptr[(count - 1) * stride]
+        *
+        * Counters are processed in batches in structure-of-arrays form, so that the Philox rounds are vectorized by the compiler.
+        */
+        template <typename NumericT, typename TransformationT>
+        void random_fill_strided(NumericT * ptr, std::size_t stride,
+                                 std::size_t first_index, std::size_t count,
+                                 unsigned int seed, unsigned int stream_id, std::size_t first_block,
+                                 TransformationT const & transformation)
+        {
+          static const std::size_t batch_size = 64;
+          unsigned int c0[batch_size];
+          unsigned int c1[batch_size];
+          unsigned int c2[batch_size];
+          unsigned int c3[batch_size];
+          NumericT values[4];
+
+          std::size_t end = first_index + count;
+          std::size_t index = first_index;
+          while (index < end)
+          {
+            std::size_t block = index / 4;
+            std::size_t num_blocks = std::min<std::size_t>(batch_size, (end - 1) / 4 - block + 1);
+
+            for (std::size_t i = 0; i < num_blocks; ++i)
+            {
+              c0[i] = viennacl::rand::detail::block_lo(first_block + block + i);
+              c1[i] = viennacl::rand::detail::block_hi(first_block + block + i);
+              c2[i] = 0;
+              c3[i] = 0;
+            }
+
+            viennacl::rand::detail::philox4x32_10(c0, c1, c2, c3, num_blocks, seed, stream_id);
+
+            for (std::size_t i = 0; i < num_blocks; ++i)
+            {
+              transformation(c0[i], c1[i], c2[i], c3[i], values);
+
+              std::size_t block_begin = 4 * (block + i);
+              if (block_begin >= index && block_begin + 4 <= end)
+              {
+                NumericT * block_ptr = ptr + (block_begin - first_index) * stride;
+                block_ptr[0]          = values[0];
+                block_ptr[stride]     = values[1];
+                block_ptr[2 * stride] = values[2];
+                block_ptr[3 * stride] = values[3];
+              }
+              else // first or last block of the range
+              {
+                std::size_t block_end = std::min(block_begin + 4, end);
+                for (std::size_t j = std::max(index, block_begin); j < block_end; ++j)
+                  ptr[(j - first_index) * stride] = values[j - block_begin];
+              }
+            }
+
+            index = 4 * (block + num_blocks);
+          }
+        }
+
+        template <typename NumericT, typename TransformationT>
+        void random_fill(vector_base<NumericT> & vec,
+                         unsigned int seed, unsigned int stream_id, std::size_t first_block,
+                         TransformationT const & transformation)
+        {
+          NumericT * data = detail::extract_raw_pointer<NumericT>(vec) + viennacl::traits::start(vec);
+          std::size_t inc  = viennacl::traits::stride(vec);
+          std::size_t size = viennacl::traits::size(vec);
+
+          static const std::size_t chunk_size = 4096; // multiple of four, so no Philox block is shared by two threads
+          long num_chunks = static_cast<long>((size + chunk_size - 1) / chunk_size);
+
+#ifdef VIENNACL_WITH_OPENMP
+          #pragma omp parallel for if (size > chunk_size)
+#endif
+          for (long chunk = 0; chunk < num_chunks; ++chunk)
+          {
+            std::size_t first = static_cast<std::size_t>(chunk) * chunk_size;
+            random_fill_strided(data + first * inc, inc, first, std::min(chunk_size, size - first),
+                                seed, stream_id, first_block, transformation);
+          }
+        }
+
+        template <typename NumericT, typename F, typename TransformationT>
+        void random_fill(matrix_base<NumericT, F> & mat,
+                         unsigned int seed, unsigned int stream_id, std::size_t first_block,
+                         TransformationT const & transformation)
+        {
+          NumericT * data = detail::extract_raw_pointer<NumericT>(mat);
+
+          std::size_t A_size1 = viennacl::traits::size1(mat);
+          std::size_t A_size2 = viennacl::traits::size2(mat);
+
+          detail::matrix_array_wrapper<NumericT, typename F::orientation_category, false>
+            wrapper_A(data, viennacl::traits::start1(mat), viennacl::traits::start2(mat),
+                            viennacl::traits::stride1(mat), viennacl::traits::stride2(mat),
+                            viennacl::traits::internal_size1(mat), viennacl::traits::internal_size2(mat));
+
+          // distance of two consecutive entries of a row in memory:
+          std::size_t row_stride = detail::is_row_major(typename F::orientation_category())
+                                   ? viennacl::traits::stride2(mat)
+                                   : viennacl::traits::stride2(mat) * viennacl::traits::internal_size1(mat);
+
+          if (A_size2 == 0)
+            return;
+
+#ifdef VIENNACL_WITH_OPENMP
+          #pragma omp parallel for if (A_size1 * A_size2 > 4096)
+#endif
+          for (long row = 0; row < static_cast<long>(A_size1); ++row)
+            random_fill_strided(&wrapper_A(static_cast<std::size_t>(row), 0), row_stride,
+                                static_cast<std::size_t>(row) * A_size2, A_size2,
+                                seed, stream_id, first_block, transformation);
+        }
+      }
+
+      /** @brief Fills a vector with uniformly distributed random numbers.
+      *
+      * @param vec          The vector to be filled
+      * @param tag          The interval [a, b) of the distribution
+      * @param seed         First key word of the generator
+      * @param stream_id    Second key word of the generator, selects one of 2^32 independent streams for a given seed
+      * @param first_block  Counter of the Philox block providing the first four values
+      */
+      template <typename NumericT>
+      void random_fill(vector_base<NumericT> & vec, viennacl::rand::uniform_tag const & tag,
+                       unsigned int seed, unsigned int stream_id, std::size_t first_block)
+      {
+        detail::random_fill(vec, seed, stream_id, first_block,
+                            viennacl::rand::detail::uniform_transformation<NumericT>(NumericT(tag.a), NumericT(tag.b - tag.a)));
+      }
+
+      /** @brief Fills a vector with normally distributed random numbers. See the uniform overload for the parameters. */
+      template <typename NumericT>
+      void random_fill(vector_base<NumericT> & vec, viennacl::rand::gaussian_tag const & tag,
+                       unsigned int seed, unsigned int stream_id, std::size_t first_block)
+      {
+        detail::random_fill(vec, seed, stream_id, first_block,
+                            viennacl::rand::detail::gaussian_transformation<NumericT>(NumericT(tag.mu), NumericT(tag.sigma)));
+      }
+
+      /** @brief Fills a matrix with uniformly distributed random numbers. Entry (i,j) obtains the value with logical index i * size2 + j. */
+      template <typename NumericT, typename F>
+      void random_fill(matrix_base<NumericT, F> & mat, viennacl::rand::uniform_tag const & tag,
+                       unsigned int seed, unsigned int stream_id, std::size_t first_block)
+      {
+        detail::random_fill(mat, seed, stream_id, first_block,
+                            viennacl::rand::detail::uniform_transformation<NumericT>(NumericT(tag.a), NumericT(tag.b - tag.a)));
+      }
+
+      /** @brief Fills a matrix with normally distributed random numbers. Entry (i,j) obtains the value with logical index i * size2 + j. */
+      template <typename NumericT, typename F>
+      void random_fill(matrix_base<NumericT, F> & mat, viennacl::rand::gaussian_tag const & tag,
+                       unsigned int seed, unsigned int stream_id, std::size_t first_block)
+      {
+        detail::random_fill(mat, seed, stream_id, first_block,
+                            viennacl::rand::detail::gaussian_transformation<NumericT>(NumericT(tag.mu), NumericT(tag.sigma)));
+      }
+
+    } // namespace host_based
+  } //namespace linalg
+} //namespace viennacl
+
+
+#endif
@@ -31,6 +31,15 @@
 #include "viennacl/linalg/host_based/common.hpp"
 #include "viennacl/linalg/host_based/vector_operations.hpp"
 
+#ifdef VIENNACL_WITH_OPENMP
+#include <omp.h>
+#endif
+
+// Number of consecutive rows of the ELL part of a hyb_matrix processed together in the host-based matrix-vector product:
+#ifndef VIENNACL_HOST_HYB_ROW_BLOCK_SIZE
+  #define VIENNACL_HOST_HYB_ROW_BLOCK_SIZE  16
+#endif
+
 namespace viennacl
 {
   namespace linalg
@@ -129,6 +138,211 @@ namespace viennacl
 
       }
 
+      /** @brief Carries out matrix-vector multiplication with a diagonally scaled compressed_matrix in a single pass
+      *
+      * Implementation of the convenience expression result = prod(op, vec), where op represents either D^{-1} A or D^{-1/2} A D^{-1/2}.
+      *
+      * @param op     The scaled operator
+      * @param vec    The vector
+      * @param result The result vector
+      */
+      template<class ScalarType, unsigned int ALIGNMENT>
+      void prod_impl(const viennacl::linalg::scaled_operator<viennacl::compressed_matrix<ScalarType, ALIGNMENT> > & op,
+                     const viennacl::vector_base<ScalarType> & vec,
+                           viennacl::vector_base<ScalarType> & result)
+      {
+        viennacl::compressed_matrix<ScalarType, ALIGNMENT> const & mat = op.matrix();
+
+        ScalarType         * result_buf = detail::extract_raw_pointer<ScalarType>(result.handle());
+        ScalarType   const * vec_buf    = detail::extract_raw_pointer<ScalarType>(vec.handle());
+        ScalarType   const * scaling    = detail::extract_raw_pointer<ScalarType>(op.scaling().handle());
+        ScalarType   const * elements   = detail::extract_raw_pointer<ScalarType>(mat.handle());
+        unsigned int const * row_buffer = detail::extract_raw_pointer<unsigned int>(mat.handle1());
+        unsigned int const * col_buffer = detail::extract_raw_pointer<unsigned int>(mat.handle2());
+
+        bool symmetric = (op.type() == viennacl::linalg::DIAGONAL_SCALING_SYMMETRIC);
+
+#ifdef VIENNACL_WITH_OPENMP
+        #pragma omp parallel for
+#endif
+        for (std::size_t row = 0; row < mat.size1(); ++row)
+        {
+          ScalarType dot_prod = 0;
+          std::size_t row_end = row_buffer[row+1];
+          if (symmetric)
+          {
+            for (std::size_t i = row_buffer[row]; i < row_end; ++i)
+              dot_prod += elements[i] * scaling[col_buffer[i]] * vec_buf[col_buffer[i] * vec.stride() + vec.start()];
+          }
+          else
+          {
+            for (std::size_t i = row_buffer[row]; i < row_end; ++i)
+              dot_prod += elements[i] * vec_buf[col_buffer[i] * vec.stride() + vec.start()];
+          }
+          result_buf[row * result.stride() + result.start()] = scaling[row] * dot_prod;
+        }
+
+      }
+
+      namespace detail
+      {
+        /** @brief Computes C = A * B for a CSR matrix A and a block of K columns of B and C stored row-major with unit stride. A is read only once and the K products per nonzero are vectorized.
+        *
+        * @param B         Pointer to the first entry of the block in B
+        * @param B_pitch   Distance between two rows of B
+        * @param C         Pointer to the first entry of the block in C
+        * @param C_pitch   Distance between two rows of C
+        */
+        template <unsigned int K, typename ScalarType, typename NumericT>
+        void csr_prod_narrow(unsigned int const * row_buffer, unsigned int const * col_buffer, ScalarType const * elements, std::size_t size1,
+                             NumericT const * B, std::size_t B_pitch,
+                             NumericT       * C, std::size_t C_pitch)
+        {
+          long rows = static_cast<long>(size1);
+#ifdef VIENNACL_WITH_OPENMP
+          #pragma omp parallel for
+#endif
+          for (long row = 0; row < rows; ++row)
+          {
+            NumericT sums[K];
+            for (unsigned int j = 0; j < K; ++j)
+              sums[j] = 0;
+
+            std::size_t row_end = row_buffer[row+1];
+            for (std::size_t k = row_buffer[row]; k < row_end; ++k)
+            {
+              NumericT value = static_cast<NumericT>(elements[k]);
+              NumericT const * B_row = B + col_buffer[k] * B_pitch;
+              for (unsigned int j = 0; j < K; ++j)
+                sums[j] += value * B_row[j];
+            }
+
+            NumericT * C_row = C + static_cast<std::size_t>(row) * C_pitch;
+            for (unsigned int j = 0; j < K; ++j)
+              C_row[j] = sums[j];
+          }
+        }
+
+        /** @brief Computes C = A * B for an ELL matrix A and a block of K columns of B and C stored row-major with unit stride. A is read only once and the K products per nonzero are vectorized.
+        *
+        * Padding entries of A (zero with column index zero) are skipped like in the other ELL kernels, so non-finite values in the first row of B do not propagate.
+        */
+        template <unsigned int K, typename ScalarType, typename NumericT>
+        void ell_prod_narrow(ScalarType const * elements, unsigned int const * coords, std::size_t size1, std::size_t internal_size1, std::size_t maxnnz,
+                             NumericT const * B, std::size_t B_pitch,
+                             NumericT       * C, std::size_t C_pitch)
+        {
+          long rows = static_cast<long>(size1);
+#ifdef VIENNACL_WITH_OPENMP
+          #pragma omp parallel for
+#endif
+          for (long row = 0; row < rows; ++row)
+          {
+            NumericT sums[K];
+            for (unsigned int j = 0; j < K; ++j)
+              sums[j] = 0;
+
+            for (std::size_t item_id = 0; item_id < maxnnz; ++item_id)
+            {
+              std::size_t offset = static_cast<std::size_t>(row) + item_id * internal_size1;
+              NumericT value = static_cast<NumericT>(elements[offset]);
+              if (value == 0)
+                continue;
+              NumericT const * B_row = B + coords[offset] * B_pitch;
+              for (unsigned int j = 0; j < K; ++j)
+                sums[j] += value * B_row[j];
+            }
+
+            NumericT * C_row = C + static_cast<std::size_t>(row) * C_pitch;
+            for (unsigned int j = 0; j < K; ++j)
+              C_row[j] = sums[j];
+          }
+        }
+
+        /** @brief Functor calling csr_prod_narrow() for a given block width */
+        template <typename ScalarType, typename NumericT>
+        struct csr_prod_narrow_functor
+        {
+          csr_prod_narrow_functor(unsigned int const * row_buffer, unsigned int const * col_buffer, ScalarType const * elements, std::size_t size1)
+            : row_buffer_(row_buffer), col_buffer_(col_buffer), elements_(elements), size1_(size1) {}
+
+          template <unsigned int K>
+          void apply(NumericT const * B, std::size_t B_pitch, NumericT * C, std::size_t C_pitch) const
+          {
+            csr_prod_narrow<K>(row_buffer_, col_buffer_, elements_, size1_, B, B_pitch, C, C_pitch);
+          }
+
+          unsigned int const * row_buffer_;
+          unsigned int const * col_buffer_;
+          ScalarType   const * elements_;
+          std::size_t size1_;
+        };
+
+        /** @brief Functor calling ell_prod_narrow() for a given block width */
+        template <typename ScalarType, typename NumericT>
+        struct ell_prod_narrow_functor
+        {
+          ell_prod_narrow_functor(ScalarType const * elements, unsigned int const * coords, std::size_t size1, std::size_t internal_size1, std::size_t maxnnz)
+            : elements_(elements), coords_(coords), size1_(size1), internal_size1_(internal_size1), maxnnz_(maxnnz) {}
+
+          template <unsigned int K>
+          void apply(NumericT const * B, std::size_t B_pitch, NumericT * C, std::size_t C_pitch) const
+          {
+            ell_prod_narrow<K>(elements_, coords_, size1_, internal_size1_, maxnnz_, B, B_pitch, C, C_pitch);
+          }
+
+          ScalarType   const * elements_;
+          unsigned int const * coords_;
+          std::size_t size1_, internal_size1_, maxnnz_;
+        };
+
+        /** @brief Returns true if the product of a sparse matrix with d_mat can be computed by the kernels for narrow row-major blocks */
+        template <typename NumericT, typename F>
+        bool use_prod_narrow(viennacl::matrix_base<NumericT, F> const & d_mat, viennacl::matrix_base<NumericT, F> const & result)
+        {
+          return detail::is_row_major(typename F::orientation_category())
+                 && viennacl::traits::stride2(d_mat) == 1 && viennacl::traits::stride2(result) == 1
+                 && d_mat.size2() > 0;
+        }
+
+        /** @brief Computes the product of a sparse matrix with a row-major block of k columns. The columns are processed in panels of 32, the remaining columns by a kernel with the exact width.
+        *
+        * @param functor   Functor providing the sparse matrix kernel for a given width, cf. csr_prod_narrow_functor
+        * @param d_mat     The dense matrix, row-major with unit stride along rows
+        * @param result    The result matrix, row-major with unit stride along rows
+        */
+        template <typename FunctorT, typename NumericT, typename F>
+        void prod_narrow(FunctorT const & functor, viennacl::matrix_base<NumericT, F> const & d_mat, viennacl::matrix_base<NumericT, F> & result)
+        {
+          NumericT const * B = detail::extract_raw_pointer<NumericT>(d_mat)
+                               + viennacl::traits::start1(d_mat) * viennacl::traits::internal_size2(d_mat) + viennacl::traits::start2(d_mat);
+          NumericT       * C = detail::extract_raw_pointer<NumericT>(result)
+                               + viennacl::traits::start1(result) * viennacl::traits::internal_size2(result) + viennacl::traits::start2(result);
+          std::size_t B_pitch = viennacl::traits::stride1(d_mat)  * viennacl::traits::internal_size2(d_mat);
+          std::size_t C_pitch = viennacl::traits::stride1(result) * viennacl::traits::internal_size2(result);
+
+          std::size_t k = d_mat.size2();
+          std::size_t j = 0;
+          for (; j + 32 <= k; j += 32)
+            functor.template apply<32>(B + j, B_pitch, C + j, C_pitch);
+
+#define VIENNACL_HOST_PROD_NARROW_CASE(WIDTH) case WIDTH: functor.template apply<WIDTH>(B + j, B_pitch, C + j, C_pitch); break;
+          switch (k - j)
+          {
+            VIENNACL_HOST_PROD_NARROW_CASE(1)  VIENNACL_HOST_PROD_NARROW_CASE(2)  VIENNACL_HOST_PROD_NARROW_CASE(3)  VIENNACL_HOST_PROD_NARROW_CASE(4)
+            VIENNACL_HOST_PROD_NARROW_CASE(5)  VIENNACL_HOST_PROD_NARROW_CASE(6)  VIENNACL_HOST_PROD_NARROW_CASE(7)  VIENNACL_HOST_PROD_NARROW_CASE(8)
+            VIENNACL_HOST_PROD_NARROW_CASE(9)  VIENNACL_HOST_PROD_NARROW_CASE(10) VIENNACL_HOST_PROD_NARROW_CASE(11) VIENNACL_HOST_PROD_NARROW_CASE(12)
+            VIENNACL_HOST_PROD_NARROW_CASE(13) VIENNACL_HOST_PROD_NARROW_CASE(14) VIENNACL_HOST_PROD_NARROW_CASE(15) VIENNACL_HOST_PROD_NARROW_CASE(16)
+            VIENNACL_HOST_PROD_NARROW_CASE(17) VIENNACL_HOST_PROD_NARROW_CASE(18) VIENNACL_HOST_PROD_NARROW_CASE(19) VIENNACL_HOST_PROD_NARROW_CASE(20)
+            VIENNACL_HOST_PROD_NARROW_CASE(21) VIENNACL_HOST_PROD_NARROW_CASE(22) VIENNACL_HOST_PROD_NARROW_CASE(23) VIENNACL_HOST_PROD_NARROW_CASE(24)
+            VIENNACL_HOST_PROD_NARROW_CASE(25) VIENNACL_HOST_PROD_NARROW_CASE(26) VIENNACL_HOST_PROD_NARROW_CASE(27) VIENNACL_HOST_PROD_NARROW_CASE(28)
+            VIENNACL_HOST_PROD_NARROW_CASE(29) VIENNACL_HOST_PROD_NARROW_CASE(30) VIENNACL_HOST_PROD_NARROW_CASE(31)
+            default: break;
+          }
+#undef VIENNACL_HOST_PROD_NARROW_CASE
+        }
+      }
+
       /** @brief Carries out sparse_matrix-matrix multiplication first matrix being compressed
       *
       * Implementation of the convenience expression result = prod(sp_mat, d_mat);
@@ -146,6 +360,12 @@ namespace viennacl
         unsigned int const * sp_mat_row_buffer = detail::extract_raw_pointer<unsigned int>(sp_mat.handle1());
         unsigned int const * sp_mat_col_buffer = detail::extract_raw_pointer<unsigned int>(sp_mat.handle2());
 
+        if (detail::use_prod_narrow(d_mat, result))
+        {
+          detail::prod_narrow(detail::csr_prod_narrow_functor<ScalarType, NumericT>(sp_mat_row_buffer, sp_mat_col_buffer, sp_mat_elements, sp_mat.size1()), d_mat, result);
+          return;
+        }
+
         NumericT const * d_mat_data = detail::extract_raw_pointer<NumericT>(d_mat);
         NumericT       * result_data = detail::extract_raw_pointer<NumericT>(result);
 
@@ -965,12 +1185,67 @@ namespace viennacl
         ScalarType   const * elements     = detail::extract_raw_pointer<ScalarType>(mat.handle());
         unsigned int const * coord_buffer = detail::extract_raw_pointer<unsigned int>(mat.handle12());
 
-        for (std::size_t i = 0; i< result.size(); ++i)
-          result_buf[i * result.stride() + result.start()] = 0;
+        std::size_t vec_start     = vec.start();
+        std::size_t vec_stride    = vec.stride();
+        std::size_t result_start  = result.start();
+        std::size_t result_stride = result.stride();
+
+        long result_size = static_cast<long>(result.size());
+#ifdef VIENNACL_WITH_OPENMP
+        #pragma omp parallel for
+#endif
+        for (long i = 0; i < result_size; ++i)
+          result_buf[static_cast<std::size_t>(i) * result_stride + result_start] = 0;
+
+        //
+        // Segmented reduction: The nonzeros (sorted by rows) are split into chunks of equal size. Rows entirely inside a chunk are written directly,
+        // while the partial sums of the first and the last row of each chunk may be shared with the neighboring chunks and are added afterwards.
+        //
+        std::size_t nnz = mat.nnz();
+        if (nnz == 0)
+          return;
+
+        long num_chunks = 1;
+#ifdef VIENNACL_WITH_OPENMP
+        num_chunks = std::max<long>(1, std::min<long>(omp_get_max_threads(), static_cast<long>(nnz)));
+#endif
+        std::vector<unsigned int> carry_row(2 * num_chunks);
+        std::vector<ScalarType>   carry_value(2 * num_chunks);   //zero if there is no carry
+
+#ifdef VIENNACL_WITH_OPENMP
+        #pragma omp parallel for
+#endif
+        for (long chunk = 0; chunk < num_chunks; ++chunk)
+        {
+          std::size_t k   = (nnz * static_cast<std::size_t>(chunk))     / static_cast<std::size_t>(num_chunks);
+          std::size_t end = (nnz * static_cast<std::size_t>(chunk + 1)) / static_cast<std::size_t>(num_chunks);
+          bool first_run = true;
 
-        for (std::size_t i = 0; i < mat.nnz(); ++i)
-          result_buf[coord_buffer[2*i] * result.stride() + result.start()]
-            += elements[i] * vec_buf[coord_buffer[2*i+1] * vec.stride() + vec.start()];
+          while (k < end)
+          {
+            unsigned int row = coord_buffer[2*k];
+            ScalarType sum = 0;
+            for (; k < end && coord_buffer[2*k] == row; ++k)
+              sum += elements[k] * vec_buf[coord_buffer[2*k+1] * vec_stride + vec_start];
+
+            if (first_run)
+            {
+              carry_row[2*chunk]   = row;
+              carry_value[2*chunk] = sum;
+              first_run = false;
+            }
+            else if (k == end)
+            {
+              carry_row[2*chunk+1]   = row;
+              carry_value[2*chunk+1] = sum;
+            }
+            else
+              result_buf[row * result_stride + result_start] = sum;
+          }
+        }
+
+        for (std::size_t i=0; i<carry_row.size(); ++i)
+          result_buf[carry_row[i] * result_stride + result_start] += carry_value[i];
       }
 
       /** @brief Carries out Compressed Matrix(COO)-Dense Matrix multiplication
@@ -1194,6 +1469,12 @@ namespace viennacl
         ScalarType   const * sp_mat_elements     = detail::extract_raw_pointer<ScalarType>(sp_mat.handle());
         unsigned int const * sp_mat_coords       = detail::extract_raw_pointer<unsigned int>(sp_mat.handle2());
 
+        if (detail::use_prod_narrow(d_mat, result))
+        {
+          detail::prod_narrow(detail::ell_prod_narrow_functor<ScalarType, NumericT>(sp_mat_elements, sp_mat_coords, sp_mat.size1(), sp_mat.internal_size1(), sp_mat.maxnnz()), d_mat, result);
+          return;
+        }
+
         NumericT const * d_mat_data = detail::extract_raw_pointer<NumericT>(d_mat);
         NumericT       * result_data = detail::extract_raw_pointer<NumericT>(result);
 
@@ -1227,9 +1508,9 @@ namespace viennacl
 #ifdef VIENNACL_WITH_OPENMP
         #pragma omp parallel for
 #endif
-          for(unsigned int item_id = 0; item_id < sp_mat.maxnnz(); ++item_id) {
+          for(std::size_t row = 0; row < sp_mat.size1(); ++row) {  // parallel over rows, so that no two threads update the same row
 
-            for(std::size_t row = 0; row < sp_mat.size1(); ++row) {
+            for(unsigned int item_id = 0; item_id < sp_mat.maxnnz(); ++item_id) {
 
               std::size_t offset = row + item_id * sp_mat.internal_size1();
               NumericT sp_mat_val = static_cast<NumericT>(sp_mat_elements[offset]);
@@ -1355,9 +1636,9 @@ namespace viennacl
 #ifdef VIENNACL_WITH_OPENMP
         #pragma omp parallel for
 #endif
-          for(unsigned int item_id = 0; item_id < sp_mat.maxnnz(); ++item_id) {
+          for(std::size_t row = 0; row < sp_mat.size1(); ++row) {  // parallel over rows, so that no two threads update the same row
 
-            for(std::size_t row = 0; row < sp_mat.size1(); ++row) {
+            for(unsigned int item_id = 0; item_id < sp_mat.maxnnz(); ++item_id) {
 
               std::size_t offset = row + item_id * sp_mat.internal_size1();
               NumericT sp_mat_val = static_cast<NumericT>(sp_mat_elements[offset]);
@@ -1400,38 +1681,55 @@ namespace viennacl
         unsigned int const * csr_row_buffer = detail::extract_raw_pointer<unsigned int>(mat.handle3());
         unsigned int const * csr_col_buffer = detail::extract_raw_pointer<unsigned int>(mat.handle4());
 
+        std::size_t vec_start     = vec.start();
+        std::size_t vec_stride    = vec.stride();
+        std::size_t result_start  = result.start();
+        std::size_t result_stride = result.stride();
+        std::size_t ell_nnz       = mat.internal_ellnnz();
+        std::size_t ell_size1     = mat.internal_size1();
 
-        for(std::size_t row = 0; row < mat.size1(); ++row)
+        // Rows are processed in blocks, so that the innermost loop runs over consecutive ELL entries.
+        // Padding entries of the ELL part (zero with column index zero) are skipped, so non-finite entries of vec do not propagate.
+        std::size_t const block_size = VIENNACL_HOST_HYB_ROW_BLOCK_SIZE;
+        long num_blocks = static_cast<long>((mat.size1() + block_size - 1) / block_size);
+
+#ifdef VIENNACL_WITH_OPENMP
+        #pragma omp parallel for
+#endif
+        for (long block = 0; block < num_blocks; ++block)
         {
-          ScalarType sum = 0;
+          std::size_t row_begin = static_cast<std::size_t>(block) * block_size;
+          std::size_t row_end   = std::min(row_begin + block_size, static_cast<std::size_t>(mat.size1()));
+          std::size_t rows      = row_end - row_begin;
+
+          ScalarType sums[VIENNACL_HOST_HYB_ROW_BLOCK_SIZE];
+          for (std::size_t r = 0; r < rows; ++r)
+            sums[r] = 0;
 
           //
           // Part 1: Process ELL part
           //
-          for(unsigned int item_id = 0; item_id < mat.internal_ellnnz(); ++item_id)
+          for (std::size_t item_id = 0; item_id < ell_nnz; ++item_id)
           {
-            std::size_t offset = row + item_id * mat.internal_size1();
-            ScalarType val = elements[offset];
-
-            if(val != 0)
-            {
-              unsigned int col = coords[offset];
-              sum += (vec_buf[col * vec.stride() + vec.start()] * val);
-            }
+            ScalarType   const * ell_elements = elements + item_id * ell_size1 + row_begin;
+            unsigned int const * ell_coords   = coords   + item_id * ell_size1 + row_begin;
+            for (std::size_t r = 0; r < rows; ++r)
+              if (ell_elements[r] != 0)
+                sums[r] += ell_elements[r] * vec_buf[ell_coords[r] * vec_stride + vec_start];
           }
 
           //
-          // Part 2: Process HYB part
+          // Part 2: Process CSR part
           //
-          std::size_t col_begin = csr_row_buffer[row];
-          std::size_t col_end   = csr_row_buffer[row + 1];
-
-          for(unsigned int item_id = col_begin; item_id < col_end; item_id++)
+          for (std::size_t r = 0; r < rows; ++r)
           {
-              sum += (vec_buf[csr_col_buffer[item_id] * vec.stride() + vec.start()] * csr_elements[item_id]);
-          }
+            std::size_t row = row_begin + r;
+            ScalarType sum = sums[r];
+            for (std::size_t item_id = csr_row_buffer[row]; item_id < csr_row_buffer[row + 1]; ++item_id)
+              sum += vec_buf[csr_col_buffer[item_id] * vec_stride + vec_start] * csr_elements[item_id];
 
-          result_buf[row * result.stride() + result.start()] = sum;
+            result_buf[row * result_stride + result_start] = sum;
+          }
         }
 
       }
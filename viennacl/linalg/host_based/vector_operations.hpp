@@ -23,6 +23,8 @@
 */
 
 #include <cmath>
+#include <vector>
+#include <algorithm>
 #include "viennacl/forwards.h"
 #include "viennacl/scalar.hpp"
 #include "viennacl/tools/tools.hpp"
@@ -397,6 +399,177 @@ namespace viennacl
         result = temp;  //Note: Assignment to result might be expensive, thus 'temp' is used for accumulation
       }
 
+      namespace detail
+      {
+        /** @brief Number of consecutive entries processed by the multi-vector kernels before moving on to the next chunk. The chunk of the common vector stays in cache while all other vectors are traversed. */
+        inline std::size_t multi_vector_chunk_size() { return 2048; }
+
+        /** @brief A set of vectors given by the pointers to their first entries and their strides, e.g. the vectors of a vector_tuple */
+        template <typename NumericT>
+        class vector_pointer_set
+        {
+          public:
+            vector_pointer_set(NumericT const * const * data, std::size_t const * inc) : data_(data), inc_(inc) {}
+
+            NumericT const * data(std::size_t j) const { return data_[j]; }
+            std::size_t inc(std::size_t j) const { return inc_[j]; }
+
+          private:
+            NumericT const * const * data_;
+            std::size_t const * inc_;
+        };
+
+        /** @brief A set of equally spaced vectors with a common stride, e.g. the rows or columns of a dense matrix. The pointers are computed on the fly, so no buffer of pointers is required. */
+        template <typename NumericT>
+        class strided_vector_set
+        {
+          public:
+            strided_vector_set(NumericT const * data, std::size_t offset, std::size_t inc) : data_(data), offset_(offset), inc_(inc) {}
+
+            NumericT const * data(std::size_t j) const { return data_ + j * offset_; }
+            std::size_t inc(std::size_t /*j*/) const { return inc_; }
+
+          private:
+            NumericT const * data_;
+            std::size_t offset_;
+            std::size_t inc_;
+        };
+
+        /** @brief Computes the k inner products result[j] = <x, y_j>.
+        *
+        * The entries are split into at most 64 blocks of consecutive chunks, which are processed in parallel.
+        * The partial sums of the blocks are kept on the stack for up to 16 vectors y_j at a time, so up to 16 inner products are computed in a single pass over x.
+        * The partial sums are added up in the order of the blocks, so the result does not depend on the number of threads.
+        * The results are written after x has been read.
+        *
+        * @param x           Pointer to the first entry of x
+        * @param inc_x       Stride of x
+        * @param y           The vectors y_0, ..., y_{k-1} (vector_pointer_set or strided_vector_set)
+        * @param k           Number of vectors y_j
+        * @param size        Number of entries in each vector
+        * @param result      Pointer to the first of the k results
+        * @param inc_result  Stride of the results
+        */
+        template <typename NumericT, typename VectorSetT>
+        void multi_inner_prod(NumericT const * x, std::size_t inc_x,
+                              VectorSetT const & y, std::size_t k,
+                              std::size_t size, NumericT * result, std::size_t inc_result)
+        {
+          static const std::size_t max_blocks  = 64;
+          static const std::size_t max_vectors = 16;
+          NumericT block_results[max_blocks * max_vectors];
+
+          std::size_t chunk_size       = multi_vector_chunk_size();
+          std::size_t num_chunks       = (size + chunk_size - 1) / chunk_size;
+          std::size_t chunks_per_block = (num_chunks + max_blocks - 1) / max_blocks;
+          std::size_t block_size       = chunks_per_block * chunk_size;
+          long num_blocks = (num_chunks > 0) ? static_cast<long>((num_chunks + chunks_per_block - 1) / chunks_per_block) : 0;
+
+          for (std::size_t j_begin = 0; j_begin < k; j_begin += max_vectors)
+          {
+            std::size_t num_vectors = std::min(max_vectors, k - j_begin);
+
+#ifdef VIENNACL_WITH_OPENMP
+            #pragma omp parallel for if (size * num_vectors > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
+#endif
+            for (long block = 0; block < num_blocks; ++block)
+            {
+              NumericT * block_result = block_results + static_cast<std::size_t>(block) * max_vectors;
+              for (std::size_t j = 0; j < num_vectors; ++j)
+                block_result[j] = 0;
+
+              std::size_t block_begin = static_cast<std::size_t>(block) * block_size;
+              std::size_t block_end   = std::min(block_begin + block_size, size);
+              for (std::size_t row_begin = block_begin; row_begin < block_end; row_begin += chunk_size)
+              {
+                std::size_t row_end = std::min(row_begin + chunk_size, block_end);
+                for (std::size_t j = 0; j < num_vectors; ++j)
+                {
+                  NumericT const * y_j = y.data(j_begin + j);
+                  std::size_t inc_y_j = y.inc(j_begin + j);
+                  NumericT temp = 0;
+                  for (std::size_t i = row_begin; i < row_end; ++i)
+                    temp += x[i * inc_x] * y_j[i * inc_y_j];
+                  block_result[j] += temp;
+                }
+              }
+            }
+
+            for (std::size_t j = 0; j < num_vectors; ++j)
+            {
+              NumericT sum = 0;
+              for (long block = 0; block < num_blocks; ++block)
+                sum += block_results[static_cast<std::size_t>(block) * max_vectors + j];
+              result[(j_begin + j) * inc_result] = sum;
+            }
+          }
+        }
+
+        /** @brief Computes x <- beta * x + sum_j alpha_j y_j in a single pass over x, where beta is either zero or one.
+        *
+        * @param x          Pointer to the first entry of x
+        * @param inc_x      Stride of x
+        * @param alpha      Array with the k coefficients alpha_j
+        * @param inc_alpha  Stride of the coefficients
+        * @param y          The vectors y_0, ..., y_{k-1} (vector_pointer_set or strided_vector_set)
+        * @param k          Number of vectors y_j
+        * @param size       Number of entries in each vector
+        * @param overwrite  If true, beta is zero, i.e. the old entries of x are ignored
+        */
+        template <typename NumericT, typename VectorSetT>
+        void multi_axpy(NumericT * x, std::size_t inc_x,
+                        NumericT const * alpha, std::size_t inc_alpha,
+                        VectorSetT const & y, std::size_t k,
+                        std::size_t size, bool overwrite)
+        {
+          std::size_t chunk_size = multi_vector_chunk_size();
+          long num_chunks = static_cast<long>((size + chunk_size - 1) / chunk_size);
+
+#ifdef VIENNACL_WITH_OPENMP
+          #pragma omp parallel for if (size * (k+1) > VIENNACL_OPENMP_VECTOR_MIN_SIZE)
+#endif
+          for (long chunk = 0; chunk < num_chunks; ++chunk)
+          {
+            std::size_t row_begin = static_cast<std::size_t>(chunk) * chunk_size;
+            std::size_t row_end   = std::min(row_begin + chunk_size, size);
+
+            if (overwrite)
+              for (std::size_t i = row_begin; i < row_end; ++i)
+                x[i * inc_x] = 0;
+
+            for (std::size_t j = 0; j < k; ++j)
+            {
+              NumericT const * y_j = y.data(j);
+              std::size_t inc_y_j = y.inc(j);
+              NumericT alpha_j = alpha[j * inc_alpha];
+              for (std::size_t i = row_begin; i < row_end; ++i)
+                x[i * inc_x] += alpha_j * y_j[i * inc_y_j];
+            }
+          }
+        }
+
+        /** @brief Extracts the pointers to the first entries and the strides of the vectors in a tuple */
+        template <typename T>
+        void extract_tuple_pointers(vector_tuple<T> const & vec_tuple,
+                                    std::vector<T const *> & data,
+                                    std::vector<std::size_t> & strides)
+        {
+          data.resize(vec_tuple.const_size());
+          strides.resize(vec_tuple.const_size());
+          for (std::size_t j=0; j<vec_tuple.const_size(); ++j)
+          {
+            data[j]    = detail::extract_raw_pointer<T>(vec_tuple.const_at(j)) + viennacl::traits::start(vec_tuple.const_at(j));
+            strides[j] = viennacl::traits::stride(vec_tuple.const_at(j));
+          }
+        }
+      }
+
+      /** @brief Computes the inner products <x, y_0>, <x, y_1>, ... with all vectors of a tuple, up to 16 of them per pass over x
+      *
+      * @param x          The common vector
+      * @param vec_tuple  The vectors y_j
+      * @param result     The vector receiving the inner products
+      */
       template <typename T>
       void inner_prod_impl(vector_base<T> const & x,
                            vector_tuple<T> const & vec_tuple,
@@ -404,34 +577,43 @@ namespace viennacl
       {
         typedef T        value_type;
 
-        value_type const * data_x = detail::extract_raw_pointer<value_type>(x);
+        value_type const * data_x = detail::extract_raw_pointer<value_type>(x) + viennacl::traits::start(x);
+        value_type       * data_result = detail::extract_raw_pointer<value_type>(result) + viennacl::traits::start(result);
+        std::size_t inc_result = viennacl::traits::stride(result);
 
-        std::size_t start_x = viennacl::traits::start(x);
-        std::size_t inc_x   = viennacl::traits::stride(x);
-        std::size_t size_x  = viennacl::traits::size(x);
+        std::vector<value_type const *> data_y;
+        std::vector<std::size_t> stride_y;
+        detail::extract_tuple_pointers(vec_tuple, data_y, stride_y);
 
-        std::vector<value_type> temp(vec_tuple.const_size());
-        std::vector<value_type const *> data_y(vec_tuple.const_size());
-        std::vector<std::size_t> start_y(vec_tuple.const_size());
-        std::vector<std::size_t> stride_y(vec_tuple.const_size());
+        if (data_y.size() > 0)
+          detail::multi_inner_prod(data_x, viennacl::traits::stride(x), detail::vector_pointer_set<value_type>(&(data_y[0]), &(stride_y[0])), data_y.size(), viennacl::traits::size(x),
+                                   data_result, inc_result);
+      }
 
-        for (std::size_t j=0; j<vec_tuple.const_size(); ++j)
-        {
-          data_y[j] = detail::extract_raw_pointer<value_type>(vec_tuple.const_at(j));
-          start_y[j] = viennacl::traits::start(vec_tuple.const_at(j));
-          stride_y[j] = viennacl::traits::stride(vec_tuple.const_at(j));
-        }
+      /** @brief Computes x += alpha_0 * y_0 + alpha_1 * y_1 + ... for all vectors of a tuple in a single pass over x
+      *
+      * @param x          The vector to be updated
+      * @param alpha      The coefficients alpha_j
+      * @param vec_tuple  The vectors y_j
+      */
+      template <typename T>
+      void multi_axpy(vector_base<T> & x,
+                      vector_base<T> const & alpha,
+                      vector_tuple<T> const & vec_tuple)
+      {
+        typedef T        value_type;
 
-        // Note: No OpenMP here because it cannot perform a reduction on temp-array. Savings in memory bandwidth are expected to still justify this approach...
-        for (std::size_t i = 0; i < size_x; ++i)
-        {
-          value_type entry_x = data_x[i*inc_x+start_x];
-          for (std::size_t j=0; j < vec_tuple.const_size(); ++j)
-            temp[j] += entry_x * data_y[j][i*stride_y[j]+start_y[j]];
-        }
+        value_type       * data_x     = detail::extract_raw_pointer<value_type>(x) + viennacl::traits::start(x);
+        value_type const * data_alpha = detail::extract_raw_pointer<value_type>(alpha) + viennacl::traits::start(alpha);
+
+        std::vector<value_type const *> data_y;
+        std::vector<std::size_t> stride_y;
+        detail::extract_tuple_pointers(vec_tuple, data_y, stride_y);
 
-        for (std::size_t j=0; j < vec_tuple.const_size(); ++j)
-          result[j] = temp[j];  //Note: Assignment to result might be expensive, thus 'temp' is used for accumulation
+        if (data_y.size() > 0)
+          detail::multi_axpy(data_x, viennacl::traits::stride(x),
+                             data_alpha, viennacl::traits::stride(alpha),
+                             detail::vector_pointer_set<value_type>(&(data_y[0]), &(stride_y[0])), data_y.size(), viennacl::traits::size(x), false);
       }
 
 
@@ -28,6 +28,7 @@
 #include "viennacl/forwards.h"
 #include "viennacl/tools/tools.hpp"
 #include "viennacl/compressed_matrix.hpp"
+#include "viennacl/linalg/detail/ilu/common.hpp"
 
 #include "viennacl/linalg/host_based/common.hpp"
 
@@ -40,7 +41,21 @@ namespace viennacl
 
     /** @brief A tag for incomplete Cholesky factorization with static pattern (ILU0)
     */
-    class ichol0_tag {};
+    class ichol0_tag
+    {
+      public:
+        /** @brief The constructor.
+        *
+        * @param reordering   Permutation of the unknowns applied prior to the factorization, cf. ilu_reordering_type.
+        */
+        ichol0_tag(ilu_reordering_type reordering = ILU_REORDERING_NONE) : reordering_(reordering) {}
+
+        ilu_reordering_type reordering() const { return reordering_; }
+        void reordering(ilu_reordering_type r) { reordering_ = r; }
+
+      private:
+        ilu_reordering_type reordering_;
+    };
 
 
     /** @brief Implementation of a ILU-preconditioner with static pattern. Optimized version for CSR matrices.
@@ -144,11 +159,20 @@ namespace viennacl
           unsigned int const * col_buffer = viennacl::linalg::host_based::detail::extract_raw_pointer<unsigned int>(LLT.handle2());
           ScalarType   const * elements   = viennacl::linalg::host_based::detail::extract_raw_pointer<ScalarType>(LLT.handle());
 
+          if (reordering_.active())
+            reordering_.permute(vec);
+
           // Note: L is stored in a column-oriented fashion, i.e. transposed w.r.t. the row-oriented layout. Thus, the factorization A = L L^T holds L in the upper triangular part of A.
           viennacl::linalg::host_based::detail::csr_trans_inplace_solve<ScalarType>(row_buffer, col_buffer, elements, vec, LLT.size2(), lower_tag());
           viennacl::linalg::host_based::detail::csr_inplace_solve<ScalarType>(row_buffer, col_buffer, elements, vec, LLT.size2(), upper_tag());
+
+          if (reordering_.active())
+            reordering_.inverse_permute(vec);
         }
 
+        /** @brief Recomputes the factorization for new values of the system matrix. ICHOL0 does not require a symbolic setup, thus this is the same as the initialization. */
+        void refactor(MatrixType const & mat) { init(mat); }
+
       private:
         void init(MatrixType const & mat)
         {
@@ -156,11 +180,13 @@ namespace viennacl
           viennacl::switch_memory_context(LLT, host_ctx);
 
           viennacl::copy(mat, LLT);
+          reordering_.init(LLT, tag_.reordering(), LLT, host_ctx);
           viennacl::linalg::precondition(LLT, tag_);
         }
 
         ichol0_tag const & tag_;
         viennacl::compressed_matrix<ScalarType> LLT;
+        viennacl::linalg::detail::ilu_reordering<ScalarType> reordering_;
     };
 
 
@@ -184,6 +210,9 @@ namespace viennacl
 
         void apply(vector<ScalarType> & vec) const
         {
+          if (reordering_.active())
+            reordering_.permute(vec);
+
           if (viennacl::traits::context(vec).memory_type() != viennacl::MAIN_MEMORY)
           {
             viennacl::context host_ctx(viennacl::MAIN_MEMORY);
@@ -200,6 +229,22 @@ namespace viennacl
             viennacl::linalg::inplace_solve(trans(LLT), vec, lower_tag());
             viennacl::linalg::inplace_solve(      LLT , vec, upper_tag());
           }
+
+          if (reordering_.active())
+            reordering_.inverse_permute(vec);
+        }
+
+        /** @brief Recomputes the factorization for new values of a system matrix with the same sparsity pattern (e.g. after compressed_matrix::set_values()). Only the values of the matrix are transferred. */
+        void refactor(MatrixType const & mat)
+        {
+          if (reordering_.active())
+            reordering_.update(mat, LLT);
+          else
+          {
+            assert( (mat.size1() == LLT.size1()) && (mat.nnz() == LLT.nnz()) && bool("Sparsity pattern differs from the one used for setting up the preconditioner!") );
+            viennacl::backend::memory_read(mat.handle(), 0, sizeof(ScalarType) * LLT.nnz(), viennacl::linalg::host_based::detail::extract_raw_pointer<ScalarType>(LLT.handle()));
+          }
+          viennacl::linalg::precondition(LLT, tag_);
         }
 
       private:
@@ -207,13 +252,17 @@ namespace viennacl
         {
           viennacl::context host_ctx(viennacl::MAIN_MEMORY);
           viennacl::switch_memory_context(LLT, host_ctx);
-          LLT = mat;
+          if (tag_.reordering() != ILU_REORDERING_NONE)
+            reordering_.init(mat, tag_.reordering(), LLT, viennacl::traits::context(mat));
+          else
+            LLT = mat;
 
           viennacl::linalg::precondition(LLT, tag_);
         }
 
         ichol0_tag const & tag_;
         viennacl::compressed_matrix<ScalarType> LLT;
+        viennacl::linalg::detail::ilu_reordering<ScalarType> reordering_;
     };
 
   }
@@ -57,6 +57,7 @@ namespace viennacl
           init(mat);
         }
 
+        /** @brief Extracts the diagonal of the system matrix, e.g. after its values have changed */
         void init(MatrixType const & mat)
         {
           diag_A.resize(viennacl::traits::size1(mat));  //resize without preserving values
@@ -81,6 +82,9 @@ namespace viennacl
           }
         }
 
+        /** @brief Updates the preconditioner for new values of the system matrix. Same as init(), provided for a uniform interface with the ILU-type preconditioners. */
+        void refactor(MatrixType const & mat) { init(mat); }
+
 
         /** @brief Apply to res = b - Ax, i.e. jacobi applied vec (right hand side),  */
         template <typename VectorType>
@@ -112,11 +116,15 @@ namespace viennacl
         }
 
 
+        /** @brief Extracts the diagonal of the system matrix, e.g. after its values have changed */
         void init(MatrixType const & mat)
         {
           detail::row_info(mat, diag_A, detail::SPARSE_ROW_DIAGONAL);
         }
 
+        /** @brief Updates the preconditioner for new values of the system matrix. Same as init(), provided for a uniform interface with the ILU-type preconditioners. */
+        void refactor(MatrixType const & mat) { init(mat); }
+
 
         template <unsigned int ALIGNMENT>
         void apply(viennacl::vector<ScalarType, ALIGNMENT> & vec) const
@@ -0,0 +1,393 @@
+#ifndef VIENNACL_LINALG_KRYLOV_SCHUR_HPP_
+#define VIENNACL_LINALG_KRYLOV_SCHUR_HPP_
+
+/* =========================================================================
+   Copyright (c) 2010-2013, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/linalg/krylov_schur.hpp
+*   @brief Implementation of the block Krylov-Schur method for symmetric eigenvalue problems.
+*
+*   The Krylov space is extended by blocks of vectors, so the system matrix is applied to dense matrices (sparse matrix times dense matrix) rather than to individual vectors.
+*/
+
+#include <cmath>
+#include <vector>
+#include <limits>
+#include <algorithm>
+#include "viennacl/forwards.h"
+#include "viennacl/matrix.hpp"
+#include "viennacl/matrix_proxy.hpp"
+#include "viennacl/linalg/prod.hpp"
+#include "viennacl/linalg/detail/symmetric_eig.hpp"
+#include "viennacl/linalg/detail/block_eig_common.hpp"
+
+namespace viennacl
+{
+  namespace linalg
+  {
+
+    /** @brief A tag for the block Krylov-Schur eigensolver. Used for supplying solver parameters and for dispatching the eig() function
+    */
+    class krylov_schur_tag
+    {
+      public:
+
+        enum
+        {
+          smallest_eigenvalues = 0,
+          largest_eigenvalues
+        };
+
+        /** @brief The constructor
+        *
+        * @param numeig       Number of eigenvalues
+        * @param block_size   Number of vectors by which the Krylov space is extended in each step
+        * @param krylov       Maximum size of the Krylov space (rounded up to a multiple of the block size)
+        * @param tol          Relative tolerance for the residuals ||A x - lambda x|| / |lambda|
+        * @param restarts     Maximum number of restarts
+        * @param which        Either smallest_eigenvalues or largest_eigenvalues
+        */
+        krylov_schur_tag(std::size_t numeig = 10, std::size_t block_size = 4, std::size_t krylov = 100,
+                         double tol = 1e-6, std::size_t restarts = 100, int which = largest_eigenvalues)
+          : num_eigenvalues_(numeig), block_size_(block_size), krylov_size_(krylov), tolerance_(tol), max_restarts_(restarts), which_(which),
+            restarts_taken_(0), last_error_(0) {}
+
+        /** @brief Sets the number of eigenvalues */
+        void num_eigenvalues(std::size_t numeig) { num_eigenvalues_ = numeig; }
+        /** @brief Returns the number of eigenvalues */
+        std::size_t num_eigenvalues() const { return num_eigenvalues_; }
+
+        /** @brief Sets the block size */
+        void block_size(std::size_t bs) { block_size_ = bs; }
+        /** @brief Returns the block size */
+        std::size_t block_size() const { return block_size_; }
+
+        /** @brief Sets the maximum size of the Krylov space */
+        void krylov_size(std::size_t max) { krylov_size_ = max; }
+        /** @brief Returns the maximum size of the Krylov space */
+        std::size_t krylov_size() const { return krylov_size_; }
+
+        /** @brief Sets the relative residual tolerance */
+        void tolerance(double tol) { tolerance_ = tol; }
+        /** @brief Returns the relative residual tolerance */
+        double tolerance() const { return tolerance_; }
+
+        /** @brief Sets the maximum number of restarts */
+        void max_restarts(std::size_t restarts) { max_restarts_ = restarts; }
+        /** @brief Returns the maximum number of restarts */
+        std::size_t max_restarts() const { return max_restarts_; }
+
+        /** @brief Sets which end of the spectrum is computed */
+        void which(int w) { which_ = w; }
+        /** @brief Returns which end of the spectrum is computed */
+        int which() const { return which_; }
+
+        /** @brief Returns the number of restarts taken by the solver */
+        std::size_t restarts() const { return restarts_taken_; }
+        /** @brief Sets the number of restarts taken by the solver */
+        void restarts(std::size_t i) const { restarts_taken_ = i; }
+
+        /** @brief Returns the largest relative residual of the eigenpairs at the end of the solver run */
+        double error() const { return last_error_; }
+        /** @brief Sets the largest relative residual of the eigenpairs at the end of the solver run */
+        void error(double e) const { last_error_ = e; }
+
+      private:
+        std::size_t num_eigenvalues_;
+        std::size_t block_size_;
+        std::size_t krylov_size_;
+        double tolerance_;
+        std::size_t max_restarts_;
+        int which_;
+
+        //return values from solver
+        mutable std::size_t restarts_taken_;
+        mutable double last_error_;
+    };
+
+
+    namespace detail
+    {
+      /** @brief Orthonormalizes the block V(:, first:first+b) against V(:, 0:first) and within itself.
+      *
+      * Uses two classical block Gram-Schmidt passes (two GEMMs each) followed by SVQB. Directions lost due to rank deficiency are replaced by random vectors.
+      *
+      * @param V       The basis, one vector per column
+      * @param first   Index of the first column of the block
+      * @param b       Number of columns of the block
+      * @param coeffs  Projection coefficients V(:, 0:first)^T * block, row-major first x b (output)
+      * @param R       Coefficients of the block in the new orthonormal basis, row-major b x b (output)
+      */
+      template <typename NumericT>
+      void krylov_schur_orthonormalize(viennacl::matrix<NumericT, viennacl::column_major> & V,
+                                       std::size_t first, std::size_t b,
+                                       std::vector<NumericT> & coeffs,
+                                       std::vector<NumericT> & R)
+      {
+        typedef viennacl::matrix<NumericT, viennacl::column_major>   BlockType;
+        typedef viennacl::matrix_range<BlockType>                    BlockRangeType;
+
+        std::size_t n = V.size1();
+        viennacl::range all_rows(0, n);
+        BlockRangeType W(V, all_rows, viennacl::range(first, first + b));
+        BlockType W_new(n, b, viennacl::traits::context(V));
+
+        coeffs.assign(first * b, NumericT(0));
+        R.assign(b * b, NumericT(0));
+        for (std::size_t i=0; i<b; ++i)
+          R[i*b + i] = NumericT(1);
+
+        for (std::size_t pass = 0; pass < 2; ++pass)
+        {
+          //
+          // Block Gram-Schmidt against the previous basis vectors:
+          //
+          if (first > 0)
+          {
+            BlockRangeType V_prev(V, all_rows, viennacl::range(0, first));
+            std::vector<NumericT> C = block_gram(V_prev, W);
+            block_times_host(V_prev, C, first, b, W_new);
+            W -= W_new;
+
+            // accumulate: W_orig = V_prev * coeffs + W * R
+            for (std::size_t i=0; i<first; ++i)
+              for (std::size_t j=0; j<b; ++j)
+                for (std::size_t l=0; l<b; ++l)
+                  coeffs[i*b + j] += C[i*b + l] * R[l*b + j];
+          }
+
+          //
+          // Orthonormalize within the block using SVQB: W = W_new * R_pass, W_new = W * Z
+          //
+          std::vector<NumericT> G = block_gram(W, W);
+          std::vector<NumericT> Z;
+          std::size_t num_cols = block_svqb(G, b, Z);
+
+          std::vector<NumericT> Z_full(b * b);
+          for (std::size_t i=0; i<b; ++i)
+            for (std::size_t j=0; j<num_cols; ++j)
+              Z_full[i*b + j] = Z[i*num_cols + j];
+          block_times_host(W, Z_full, b, b, W_new);
+
+          // R_pass = W_new^T W (exact for the retained directions, zero for the dropped ones):
+          std::vector<NumericT> R_pass(b * b);
+          for (std::size_t i=0; i<num_cols; ++i)
+            for (std::size_t j=0; j<b; ++j)
+            {
+              NumericT value = 0;
+              for (std::size_t l=0; l<b; ++l)
+                value += Z[l*num_cols + i] * G[l*b + j];
+              R_pass[i*b + j] = value;
+            }
+
+          std::vector<NumericT> R_old(R);
+          for (std::size_t i=0; i<b; ++i)
+            for (std::size_t j=0; j<b; ++j)
+            {
+              NumericT value = 0;
+              for (std::size_t l=0; l<b; ++l)
+                value += R_pass[i*b + l] * R_old[l*b + j];
+              R[i*b + j] = value;
+            }
+
+          if (num_cols < b) // rank deficiency: fill up with random vectors, which are orthogonalized in the next pass
+          {
+            BlockRangeType W_dropped(W_new, all_rows, viennacl::range(num_cols, b));
+            block_random(W_dropped, static_cast<unsigned int>(first + pass + 1));
+          }
+          W = W_new;
+        }
+      }
+    }
+
+
+    /** @brief Computes eigenvalues and eigenvectors at one end of the spectrum of a symmetric matrix using the block Krylov-Schur method (Stewart)
+    *
+    * The Krylov basis is kept as one column-major dense matrix in the memory domain of the system matrix and extended by blocks of vectors.
+    * For symmetric matrices the Schur form of the projected matrix is diagonal, hence the restart is a thick restart keeping the wanted Ritz vectors.
+    *
+    * @param A               The symmetric system matrix (sparse or dense)
+    * @param eigenvectors_A  Dense matrix in which the eigenvectors are stored column-wise in the same order as the eigenvalues
+    * @param tag             Solver configuration tag
+    * @return                The eigenvalues, largest (resp. smallest) first
+    */
+    template <typename MatrixT, typename DenseMatrixT>
+    std::vector< typename viennacl::result_of::cpu_value_type<typename MatrixT::value_type>::type >
+    eig(MatrixT const & A, DenseMatrixT & eigenvectors_A, krylov_schur_tag const & tag)
+    {
+      typedef typename viennacl::result_of::value_type<MatrixT>::type           ScalarType;
+      typedef typename viennacl::result_of::cpu_value_type<ScalarType>::type    NumericT;
+      typedef viennacl::matrix<NumericT, viennacl::column_major>                BlockType;
+      typedef viennacl::matrix_range<BlockType>                                 BlockRangeType;
+
+      std::size_t n = A.size1();
+      std::size_t b = std::max<std::size_t>(1, std::min(tag.block_size(), n));
+      std::size_t nev = std::min(tag.num_eigenvalues(), n);
+      bool largest = (tag.which() == krylov_schur_tag::largest_eigenvalues);
+
+      // basis size m: multiple of the block size, room for the wanted eigenvectors plus two blocks, but not exceeding n:
+      std::size_t m = std::max(tag.krylov_size(), nev + 2 * b);
+      m = ((m + b - 1) / b) * b;
+      while (m > b && m + b > n)
+        m -= b;
+
+      // number of Ritz vectors kept at restart, such that (m - num_kept) is a multiple of b:
+      std::size_t num_kept = std::min(m - b, nev + (m - nev) / 2);
+      num_kept = m - b * ((m - num_kept + b - 1) / b);
+
+      viennacl::context ctx = viennacl::traits::context(A);
+      viennacl::range all_rows(0, n);
+
+      // m basis vectors plus one block for the residual block:
+      BlockType V(n, m + b, ctx);
+      std::vector<NumericT> H(m * m);
+      std::vector<NumericT> R_residual(b * b);
+      std::vector<NumericT> coeffs, R, Y, theta;
+
+      BlockRangeType V_start(V, all_rows, viennacl::range(0, b));
+      detail::block_random(V_start);
+      detail::krylov_schur_orthonormalize(V, 0, b, coeffs, R);
+
+      std::vector<NumericT> eigenvalues;
+      std::size_t k = 0;
+      for (std::size_t restart = 0; ; ++restart)
+      {
+        //
+        // Block Lanczos/Arnoldi extension from k to m basis vectors:
+        //
+        for (std::size_t j = k; j < m; j += b)
+        {
+          BlockRangeType V_j   (V, all_rows, viennacl::range(j, j + b));
+          BlockRangeType V_next(V, all_rows, viennacl::range(j + b, j + 2 * b));
+          detail::block_matrix_apply(A, V_j, V_next);
+
+          detail::krylov_schur_orthonormalize(V, j + b, b, coeffs, R);
+
+          for (std::size_t i=0; i<j+b; ++i)
+            for (std::size_t l=0; l<b; ++l)
+            {
+              H[i*m + j+l] = coeffs[i*b + l];
+              H[(j+l)*m + i] = coeffs[i*b + l];
+            }
+
+          if (j + b < m)
+          {
+            for (std::size_t i=0; i<b; ++i)
+              for (std::size_t l=0; l<b; ++l)
+              {
+                H[(j+b+i)*m + j+l] = R[i*b + l];
+                H[(j+l)*m + j+b+i] = R[i*b + l];
+              }
+          }
+          else
+            R_residual = R;
+        }
+
+        //
+        // Rayleigh-Ritz (Schur decomposition of the symmetric projected matrix) on the host:
+        //
+        Y = H;
+        for (std::size_t i=0; i<m; ++i)
+          for (std::size_t j=0; j<i; ++j)
+            Y[i*m + j] = Y[j*m + i] = NumericT(0.5) * (H[i*m + j] + H[j*m + i]);
+        detail::symmetric_eig(Y, m, theta);
+
+        // residual of Ritz pair (theta_i, V y_i) is || R_residual * y_i(m-b:m) ||:
+        std::vector<NumericT> residuals(m);
+        for (std::size_t i=0; i<m; ++i)
+        {
+          NumericT norm_sq = 0;
+          for (std::size_t r=0; r<b; ++r)
+          {
+            NumericT value = 0;
+            for (std::size_t l=0; l<b; ++l)
+              value += R_residual[r*b + l] * Y[(m-b+l)*m + i];
+            norm_sq += value * value;
+          }
+          residuals[i] = std::sqrt(norm_sq);
+        }
+
+        std::vector<std::size_t> wanted = detail::block_eig_wanted(m, nev, largest);
+        NumericT max_residual = 0;
+        for (std::size_t i=0; i<wanted.size(); ++i)
+        {
+          NumericT scale = std::max<NumericT>(std::fabs(theta[wanted[i]]), std::numeric_limits<NumericT>::epsilon());
+          max_residual = std::max<NumericT>(max_residual, residuals[wanted[i]] / scale);
+        }
+        tag.restarts(restart);
+        tag.error(max_residual);
+
+        if (max_residual <= tag.tolerance() || restart >= tag.max_restarts())
+        {
+          std::vector<NumericT> Y_wanted(m * wanted.size());
+          for (std::size_t i=0; i<m; ++i)
+            for (std::size_t j=0; j<wanted.size(); ++j)
+              Y_wanted[i*wanted.size() + j] = Y[i*m + wanted[j]];
+
+          BlockType X(n, wanted.size(), ctx);
+          BlockRangeType V_m(V, all_rows, viennacl::range(0, m));
+          detail::block_times_host(V_m, Y_wanted, m, wanted.size(), X);
+          detail::block_assign(X, eigenvectors_A);
+
+          for (std::size_t i=0; i<wanted.size(); ++i)
+            eigenvalues.push_back(theta[wanted[i]]);
+          return eigenvalues;
+        }
+
+        //
+        // Restart: keep the num_kept wanted Ritz vectors, move the residual block behind them:
+        //
+        std::vector<std::size_t> kept = detail::block_eig_wanted(m, num_kept, largest);
+        std::vector<NumericT> Y_kept(m * num_kept);
+        for (std::size_t i=0; i<m; ++i)
+          for (std::size_t j=0; j<num_kept; ++j)
+            Y_kept[i*num_kept + j] = Y[i*m + kept[j]];
+
+        BlockType V_kept(n, num_kept, ctx);
+        BlockRangeType V_m(V, all_rows, viennacl::range(0, m));
+        detail::block_times_host(V_m, Y_kept, m, num_kept, V_kept);
+
+        BlockType V_residual(n, b, ctx);
+        V_residual = BlockRangeType(V, all_rows, viennacl::range(m, m + b));
+
+        BlockRangeType V_head(V, all_rows, viennacl::range(0, num_kept));
+        BlockRangeType V_tail(V, all_rows, viennacl::range(num_kept, num_kept + b));
+        V_head = V_kept;
+        V_tail = V_residual;
+
+        // new projected matrix: diagonal of kept Ritz values, coupled to the residual block
+        std::fill(H.begin(), H.end(), NumericT(0));
+        for (std::size_t i=0; i<num_kept; ++i)
+        {
+          H[i*m + i] = theta[kept[i]];
+          for (std::size_t r=0; r<b; ++r)
+          {
+            NumericT value = 0;
+            for (std::size_t l=0; l<b; ++l)
+              value += R_residual[r*b + l] * Y[(m-b+l)*m + kept[i]];
+            H[(num_kept+r)*m + i] = value;
+            H[i*m + num_kept+r] = value;
+          }
+        }
+        k = num_kept;
+      }
+    }
+
+  }
+}
+
+#endif
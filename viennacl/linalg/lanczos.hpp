@@ -26,23 +26,24 @@
 
 #include <cmath>
 #include <vector>
+#include <limits>
+#include <algorithm>
 #include "viennacl/vector.hpp"
+#include "viennacl/matrix.hpp"
+#include "viennacl/matrix_proxy.hpp"
 #include "viennacl/compressed_matrix.hpp"
 #include "viennacl/linalg/prod.hpp"
 #include "viennacl/linalg/inner_prod.hpp"
 #include "viennacl/linalg/norm_2.hpp"
-#include "viennacl/io/matrix_market.hpp"
 #include "viennacl/linalg/bisect.hpp"
+#include "viennacl/linalg/detail/symmetric_eig.hpp"
 #include <boost/random.hpp>
 #include <boost/random/mersenne_twister.hpp>
+
+#ifdef VIENNACL_WITH_UBLAS
 #include <boost/numeric/ublas/matrix.hpp>
-#include <boost/numeric/ublas/matrix_proxy.hpp>
-#include <boost/numeric/ublas/matrix_expression.hpp>
 #include <boost/numeric/ublas/matrix_sparse.hpp>
-#include <boost/numeric/ublas/vector.hpp>
-#include <boost/numeric/ublas/operation.hpp>
-#include <boost/numeric/ublas/vector_expression.hpp>
-#include <boost/numeric/ublas/io.hpp>
+#endif
 
 namespace viennacl
 {
@@ -59,21 +60,26 @@ namespace viennacl
         {
           partial_reorthogonalization = 0,
           full_reorthogonalization,
-          no_reorthogonalization
+          no_reorthogonalization,
+          thick_restart
         };
 
         /** @brief The constructor
         *
         * @param factor                 Exponent of epsilon - tolerance for batches of Reorthogonalization
         * @param numeig                 Number of eigenvalues to be returned
-        * @param met                    Method for Lanczos-Algorithm: 0 for partial Reorthogonalization, 1 for full Reorthogonalization and 2 for Lanczos without Reorthogonalization
+        * @param met                    Method for Lanczos-Algorithm: 0 for partial Reorthogonalization, 1 for full Reorthogonalization, 2 for Lanczos without Reorthogonalization and 3 for thick-restart Lanczos
         * @param krylov                 Maximum krylov-space size
+        * @param restarts               Maximum number of restarts (thick-restart Lanczos only)
+        * @param tol                    Relative tolerance for the residuals of the Ritz pairs (thick-restart Lanczos only)
         */
 
         lanczos_tag(double factor = 0.75,
                     std::size_t numeig = 10,
                     int met = 0,
-                    std::size_t krylov = 100) : factor_(factor), num_eigenvalues_(numeig), method_(met), krylov_size_(krylov) {};
+                    std::size_t krylov = 100,
+                    std::size_t restarts = 20,
+                    double tol = 1e-6) : factor_(factor), num_eigenvalues_(numeig), method_(met), krylov_size_(krylov), max_restarts_(restarts), tolerance_(tol) {};
 
         /** @brief Sets the number of eigenvalues */
         void num_eigenvalues(int numeig){ num_eigenvalues_ = numeig; }
@@ -99,127 +105,220 @@ namespace viennacl
         /** @brief Returns the reorthogonalization method */
         int method() const { return method_; }
 
+        /** @brief Sets the maximum number of restarts of the thick-restart Lanczos method */
+        void max_restarts(std::size_t restarts) { max_restarts_ = restarts; }
+
+        /** @brief Returns the maximum number of restarts of the thick-restart Lanczos method */
+        std::size_t max_restarts() const { return max_restarts_; }
+
+        /** @brief Sets the relative residual tolerance for the Ritz pairs of the thick-restart Lanczos method */
+        void tolerance(double tol) { tolerance_ = tol; }
+
+        /** @brief Returns the relative residual tolerance for the Ritz pairs of the thick-restart Lanczos method */
+        double tolerance() const { return tolerance_; }
 
       private:
         double factor_;
         std::size_t num_eigenvalues_;
         int method_; // see enum defined above for possible values
         std::size_t krylov_size_;
-
+        std::size_t max_restarts_;
+        double tolerance_;
     };
 
 
     namespace detail
     {
-      /**
-      *   @brief Implementation of the Lanczos PRO algorithm
+      /** @brief Orthogonalizes r against the columns first, ..., last-1 of the Lanczos basis Q using two matrix-vector products (classical Gram-Schmidt)
       *
-      *   @param A            The system matrix
-      *   @param r            Random start vector
-      *   @param size         Size of krylov-space
-      *   @param tag          Lanczos_tag with several options for the algorithm
-      *   @return             Returns the eigenvalues (number of eigenvalues equals size of krylov-space)
+      * @param Q      The Lanczos basis, one basis vector per column
+      * @param first  Index of the first basis vector
+      * @param last   Index past the last basis vector
+      * @param r      The vector to be orthogonalized
+      * @return       The projection coefficients Q(:, first:last)^T r on the host
       */
+      template <typename NumericT>
+      std::vector<NumericT> lanczos_orthogonalize(viennacl::matrix<NumericT, viennacl::column_major> & Q,
+                                                  std::size_t first, std::size_t last,
+                                                  viennacl::vector_base<NumericT> & r)
+      {
+        typedef viennacl::matrix<NumericT, viennacl::column_major>   BasisType;
+
+        std::vector<NumericT> coeffs(last - first);
+        if (last <= first)
+          return coeffs;
 
-      template< typename MatrixT, typename VectorT >
-      std::vector<
-              typename viennacl::result_of::cpu_value_type<typename MatrixT::value_type>::type
-              >
-      lanczosPRO (MatrixT const& A, VectorT & r, int size, lanczos_tag const & tag)
+        viennacl::matrix_range<BasisType> Q_block(Q, viennacl::range(0, Q.size1()), viennacl::range(first, last));
+        viennacl::vector<NumericT> vcl_coeffs = viennacl::linalg::prod(trans(Q_block), r);
+        r -= viennacl::linalg::prod(Q_block, vcl_coeffs);
+
+        viennacl::copy(vcl_coeffs, coeffs);
+        return coeffs;
+      }
+
+      /** @brief Computes Ritz vectors X = Q(:, 0:m) * Y(:, columns) from the eigenvectors Y of the projected matrix as a single matrix-matrix product
+      *
+      * @param Q        The Lanczos basis, one basis vector per column
+      * @param m        Number of basis vectors (and dimension of the projected matrix)
+      * @param Y        Eigenvectors of the projected matrix, row-major m x m matrix on the host
+      * @param columns  Indices of the eigenvectors in Y which are used for the Ritz vectors
+      * @param X        The resulting Ritz vectors, one per column
+      */
+      template <typename NumericT, typename DenseMatrixT>
+      void lanczos_ritz_vectors(viennacl::matrix<NumericT, viennacl::column_major> & Q,
+                                std::size_t m,
+                                std::vector<NumericT> const & Y,
+                                std::vector<std::size_t> const & columns,
+                                DenseMatrixT & X)
       {
+        typedef viennacl::matrix<NumericT, viennacl::column_major>   BasisType;
 
-        typedef typename viennacl::result_of::value_type<MatrixT>::type        ScalarType;
-        typedef typename viennacl::result_of::cpu_value_type<ScalarType>::type    CPU_ScalarType;
+        std::vector< std::vector<NumericT> > Y_selected(m, std::vector<NumericT>(columns.size()));
+        for (std::size_t i=0; i<m; ++i)
+          for (std::size_t j=0; j<columns.size(); ++j)
+            Y_selected[i][j] = Y[i*m + columns[j]];
 
+        viennacl::matrix<NumericT, viennacl::column_major> vcl_Y(m, columns.size(), viennacl::traits::context(Q));
+        viennacl::copy(Y_selected, vcl_Y);
 
-        // generation of some random numbers, used for lanczos PRO algorithm
-        boost::mt11213b mt;
-        boost::normal_distribution<CPU_ScalarType> N(0, 1);
-        boost::bernoulli_distribution<CPU_ScalarType> B(0.5);
-        boost::triangle_distribution<CPU_ScalarType> T(-1, 0, 1);
+        viennacl::matrix_range<BasisType> Q_m(Q, viennacl::range(0, Q.size1()), viennacl::range(0, m));
+        X.resize(Q.size1(), columns.size(), false);
+        viennacl::linalg::prod_impl(Q_m, vcl_Y, X, NumericT(1), NumericT(0));
+      }
 
-        boost::variate_generator<boost::mt11213b&, boost::normal_distribution<CPU_ScalarType> >     get_N(mt, N);
-        boost::variate_generator<boost::mt11213b&, boost::bernoulli_distribution<CPU_ScalarType> >  get_B(mt, B);
-        boost::variate_generator<boost::mt11213b&, boost::triangle_distribution<CPU_ScalarType> >   get_T(mt, T);
+      /** @brief Computes the eigenvalues of the Lanczos tridiagonal matrix and, if requested, the Ritz vectors for the largest eigenvalues
+      *
+      * @param Q                     The Lanczos basis, one basis vector per column
+      * @param alphas                Diagonal of the tridiagonal matrix
+      * @param betas                 Off-diagonal of the tridiagonal matrix, where betas[0] is ignored
+      * @param num_eigenvalues       Number of Ritz vectors to compute
+      * @param eigenvectors_A        The Ritz vectors for the largest eigenvalues in descending order
+      * @param compute_eigenvectors  If false, only the eigenvalues are computed (using bisection)
+      * @return                      All eigenvalues of the tridiagonal matrix in ascending order
+      */
+      template <typename NumericT, typename DenseMatrixT>
+      std::vector<NumericT> lanczos_eigenpairs(viennacl::matrix<NumericT, viennacl::column_major> & Q,
+                                               std::vector<NumericT> const & alphas,
+                                               std::vector<NumericT> const & betas,
+                                               std::size_t num_eigenvalues,
+                                               DenseMatrixT & eigenvectors_A,
+                                               bool compute_eigenvectors)
+      {
+        if (!compute_eigenvectors)
+          return bisect(alphas, betas);
+
+        std::size_t size = alphas.size();
+        std::vector<NumericT> T(size * size);
+        for (std::size_t i=0; i<size; ++i)
+        {
+          T[i*size + i] = alphas[i];
+          if (i > 0)
+          {
+            T[i*size + i-1] = betas[i];
+            T[(i-1)*size + i] = betas[i];
+          }
+        }
+
+        std::vector<NumericT> theta;
+        symmetric_eig(T, size, theta);
+
+        std::vector<std::size_t> columns;
+        for (std::size_t i=0; i<std::min(num_eigenvalues, size); ++i)
+          columns.push_back(size - i - 1);
+        lanczos_ritz_vectors(Q, size, T, columns, eigenvectors_A);
+
+        return theta;
+      }
+
+
+      /**
+      *   @brief Implementation of the Lanczos PRO algorithm
+      *
+      *   @param A                     The system matrix
+      *   @param r                     Random start vector
+      *   @param eigenvectors_A        Dense matrix holding the eigenvectors of A (one eigenvector per column)
+      *   @param size                  Size of krylov-space
+      *   @param tag                   Lanczos_tag with several options for the algorithm
+      *   @param compute_eigenvectors  Boolean flag. If true, eigenvectors are computed. Otherwise the routine returns after calculating eigenvalues.
+      *   @return                      Returns the eigenvalues (number of eigenvalues equals size of krylov-space)
+      */
 
+      template< typename MatrixT, typename DenseMatrixT, typename NumericT>
+      std::vector<NumericT>
+      lanczosPRO (MatrixT const& A, viennacl::vector_base<NumericT> & r, DenseMatrixT & eigenvectors_A, std::size_t size, lanczos_tag const & tag, bool compute_eigenvectors)
+      {
+        // generation of some random numbers, used for lanczos PRO algorithm
+        boost::mt11213b mt;
+        boost::normal_distribution<NumericT> N(0, 1);
+        boost::variate_generator<boost::mt11213b&, boost::normal_distribution<NumericT> >     get_N(mt, N);
 
         long i, j, k, index, retry, reorths;
         std::vector<long> l_bound(size/2), u_bound(size/2);
         bool second_step;
-        CPU_ScalarType squ_eps, eta, temp, eps, retry_th;
+        NumericT squ_eps, eta, temp, eps, retry_th;
         long n = r.size();
-        std::vector< std::vector<CPU_ScalarType> > w(2, std::vector<CPU_ScalarType>(size));
-        CPU_ScalarType cpu_beta;
-
-        boost::numeric::ublas::vector<CPU_ScalarType> s(n);
+        std::vector< std::vector<NumericT> > w(2, std::vector<NumericT>(size));
+        NumericT beta;
+        NumericT alpha;
+        std::vector<NumericT> alphas, betas;
 
-        VectorT t(n);
-        CPU_ScalarType inner_rt;
-        ScalarType vcl_beta;
-        ScalarType vcl_alpha;
-        std::vector<CPU_ScalarType> alphas, betas;
-        boost::numeric::ublas::matrix<CPU_ScalarType> Q(n, size);
+        // The Lanczos basis lives in the memory domain of r, hence no transfers are required for reorthogonalization:
+        viennacl::matrix<NumericT, viennacl::column_major> Q(n, size, viennacl::traits::context(r));
 
         second_step = false;
-        eps = std::numeric_limits<CPU_ScalarType>::epsilon();
+        eps = std::numeric_limits<NumericT>::epsilon();
         squ_eps = std::sqrt(eps);
         retry_th = 1e-2;
         eta = std::exp(std::log(eps) * tag.factor());
         reorths = 0;
         retry = 0;
 
-        vcl_beta = viennacl::linalg::norm_2(r);
+        beta = viennacl::linalg::norm_2(r);
 
-        r /= vcl_beta;
+        r /= beta;
 
-        detail::copy_vec_to_vec(r,s);
-        boost::numeric::ublas::column(Q, 0) = s;
+        viennacl::vector_base<NumericT> q_0(Q.handle(), n, 0, 1);
+        q_0 = r;
 
-        VectorT u = viennacl::linalg::prod(A, r);
-        vcl_alpha = viennacl::linalg::inner_prod(u, r);
-        alphas.push_back(vcl_alpha);
+        viennacl::vector<NumericT> u = viennacl::linalg::prod(A, r);
+        alpha = viennacl::linalg::inner_prod(u, r);
+        alphas.push_back(alpha);
         w[0][0] = 1;
-        betas.push_back(vcl_beta);
+        betas.push_back(beta);
 
         long batches = 0;
-        for(i = 1;i < size; i++)
+        for(i = 1;i < static_cast<long>(size); i++)
         {
-          r = u - vcl_alpha * r;
-          vcl_beta = viennacl::linalg::norm_2(r);
+          r = u - alpha * r;
+          beta = viennacl::linalg::norm_2(r);
 
-          betas.push_back(vcl_beta);
-          r = r / vcl_beta;
+          betas.push_back(beta);
+          r = r / beta;
 
           index = i % 2;
           w[index][i] = 1;
           k = (i + 1) % 2;
-          w[index][0] = (betas[1] * w[k][1] + (alphas[0] - vcl_alpha) * w[k][0] - betas[i - 1] * w[index][0]) / vcl_beta + eps * 0.3 * get_N() * (betas[1] + vcl_beta);
+          w[index][0] = (betas[1] * w[k][1] + (alphas[0] - alpha) * w[k][0] - betas[i - 1] * w[index][0]) / beta + eps * 0.3 * get_N() * (betas[1] + beta);
 
           for(j = 1;j < i - 1;j++)
           {
-                  w[index][j] = (betas[j + 1] * w[k][j + 1] + (alphas[j] - vcl_alpha) * w[k][j] + betas[j] * w[k][j - 1] - betas[i - 1] * w[index][j]) / vcl_beta + eps * 0.3 * get_N() * (betas[j + 1] + vcl_beta);
+                  w[index][j] = (betas[j + 1] * w[k][j + 1] + (alphas[j] - alpha) * w[k][j] + betas[j] * w[k][j - 1] - betas[i - 1] * w[index][j]) / beta + eps * 0.3 * get_N() * (betas[j + 1] + beta);
           }
-          w[index][i - 1] = 0.6 * eps * n * get_N() * betas[1] / vcl_beta;
+          w[index][i - 1] = 0.6 * eps * n * get_N() * betas[1] / beta;
 
           if(second_step)
           {
+            // reorthogonalize against the same batches as in the previous step:
             for(j = 0;j < batches;j++)
             {
-              l_bound[j]++;
-              u_bound[j]--;
-
-              for(k = l_bound[j];k < u_bound[j];k++)
-              {
-                detail::copy_vec_to_vec(boost::numeric::ublas::column(Q, k), t);
-                inner_rt = viennacl::linalg::inner_prod(r,t);
-                r = r - inner_rt * t;
+              lanczos_orthogonalize(Q, l_bound[j], u_bound[j] + 1, r);
+              for(k = l_bound[j];k <= u_bound[j];k++)
                 w[index][k] = 1.5 * eps * get_N();
-                reorths++;
-              }
+              reorths += u_bound[j] - l_bound[j] + 1;
             }
             temp = viennacl::linalg::norm_2(r);
             r = r / temp;
-            vcl_beta = vcl_beta * temp;
+            beta = beta * temp;
             second_step = false;
           }
           batches = 0;
@@ -228,34 +327,23 @@ namespace viennacl
           {
             if(std::fabs(w[index][j]) >= squ_eps)
             {
-              detail::copy_vec_to_vec(boost::numeric::ublas::column(Q, j), t);
-              inner_rt = viennacl::linalg::inner_prod(r,t);
-              r = r - inner_rt * t;
-              w[index][j] = 1.5 * eps * get_N();
+              // determine the batch of basis vectors around j to reorthogonalize against:
               k = j - 1;
-              reorths++;
               while(k >= 0 && std::fabs(w[index][k]) > eta)
-              {
-                detail::copy_vec_to_vec(boost::numeric::ublas::column(Q, k), t);
-                inner_rt = viennacl::linalg::inner_prod(r,t);
-                r = r - inner_rt * t;
-                w[index][k] = 1.5 * eps * get_N();
                 k--;
-                reorths++;
-              }
               l_bound[batches] = k + 1;
-              k = j + 1;
 
+              k = j + 1;
               while(k < i && std::fabs(w[index][k]) > eta)
-              {
-                detail::copy_vec_to_vec(boost::numeric::ublas::column(Q, k), t);
-                inner_rt = viennacl::linalg::inner_prod(r,t);
-                r = r - inner_rt * t;
-                w[index][k] = 1.5 * eps * get_N();
                 k++;
-                reorths++;
-              }
               u_bound[batches] = k - 1;
+
+              // reorthogonalize the whole batch at once:
+              lanczos_orthogonalize(Q, l_bound[batches], u_bound[batches] + 1, r);
+              for(long m = l_bound[batches]; m <= u_bound[batches]; m++)
+                w[index][m] = 1.5 * eps * get_N();
+              reorths += u_bound[batches] - l_bound[batches] + 1;
+
               batches++;
               j = k;
             }
@@ -265,165 +353,339 @@ namespace viennacl
           {
             temp = viennacl::linalg::norm_2(r);
             r = r / temp;
-            vcl_beta = vcl_beta * temp;
+            beta = beta * temp;
             second_step = true;
 
             while(temp < retry_th)
             {
-              for(j = 0;j < i;j++)
-              {
-                detail::copy_vec_to_vec(boost::numeric::ublas::column(Q, k), t);
-                inner_rt = viennacl::linalg::inner_prod(r,t);
-                r = r - inner_rt * t;
-                reorths++;
-              }
+              lanczos_orthogonalize(Q, 0, i, r);
+              reorths += i;
               retry++;
               temp = viennacl::linalg::norm_2(r);
               r = r / temp;
-              vcl_beta = vcl_beta * temp;
+              beta = beta * temp;
             }
           }
+          betas[i] = beta;
 
-          detail::copy_vec_to_vec(r,s);
-          boost::numeric::ublas::column(Q, i) = s;
+          viennacl::vector_base<NumericT> q_i(Q.handle(), n, i * Q.internal_size1(), 1);
+          viennacl::vector_base<NumericT> q_prev(Q.handle(), n, (i - 1) * Q.internal_size1(), 1);
+          q_i = r;
 
-          cpu_beta = vcl_beta;
-          s = - cpu_beta * boost::numeric::ublas::column(Q, i - 1);
-          detail::copy_vec_to_vec(s, u);
-          u += viennacl::linalg::prod(A, r);
-          vcl_alpha = viennacl::linalg::inner_prod(u, r);
-          alphas.push_back(vcl_alpha);
+          u = viennacl::linalg::prod(A, r);
+          u -= beta * q_prev;
+          alpha = viennacl::linalg::inner_prod(u, r);
+          alphas.push_back(alpha);
         }
 
-        return bisect(alphas, betas);
-
+        return lanczos_eigenpairs(Q, alphas, betas, tag.num_eigenvalues(), eigenvectors_A, compute_eigenvectors);
       }
 
 
       /**
       *   @brief Implementation of the lanczos algorithm without reorthogonalization
       *
-      *   @param A            The system matrix
-      *   @param r            Random start vector
-      *   @param size         Size of krylov-space
-      *   @return             Returns the eigenvalues (number of eigenvalues equals size of krylov-space)
+      *   @param A                     The system matrix
+      *   @param r                     Random start vector
+      *   @param eigenvectors_A        Dense matrix holding the eigenvectors of A (one eigenvector per column)
+      *   @param size                  Size of krylov-space
+      *   @param tag                   Lanczos_tag with several options for the algorithm
+      *   @param compute_eigenvectors  Boolean flag. If true, eigenvectors are computed. Otherwise the routine returns after calculating eigenvalues.
+      *   @return                      Returns the eigenvalues (number of eigenvalues equals size of krylov-space)
       */
-      template< typename MatrixT, typename VectorT >
-      std::vector<
-              typename viennacl::result_of::cpu_value_type<typename MatrixT::value_type>::type
-              >
-      lanczos (MatrixT const& A, VectorT & r, int size, lanczos_tag)
+      template< typename MatrixT, typename DenseMatrixT, typename NumericT>
+      std::vector<NumericT>
+      lanczos (MatrixT const& A, viennacl::vector_base<NumericT> & r, DenseMatrixT & eigenvectors_A, std::size_t size, lanczos_tag const & tag, bool compute_eigenvectors)
       {
+        NumericT beta;
+        NumericT alpha;
+        std::vector<NumericT> alphas, betas;
+        NumericT norm;
+        std::size_t n = r.size();
+        viennacl::vector<NumericT> u(n, viennacl::traits::context(r));
+        viennacl::matrix<NumericT, viennacl::column_major> Q(n, size, viennacl::traits::context(r));
 
-        typedef typename viennacl::result_of::value_type<MatrixT>::type        ScalarType;
-        typedef typename viennacl::result_of::cpu_value_type<ScalarType>::type    CPU_ScalarType;
-
-        long i;
-        ScalarType vcl_beta;
-        ScalarType vcl_alpha;
-        std::vector<CPU_ScalarType> alphas, betas;
-        CPU_ScalarType norm;
-        long n = r.size();
-        VectorT u(n), t(n);
-        boost::numeric::ublas::vector<CPU_ScalarType> s(r.size()), u_zero(n), q(n);
-        boost::numeric::ublas::matrix<CPU_ScalarType> Q(n, size);
-
-        u_zero = boost::numeric::ublas::zero_vector<CPU_ScalarType>(n);
-        detail::copy_vec_to_vec(u_zero, u);
         norm = norm_2(r);
 
-        for(i = 0;i < size; i++)
+        for(std::size_t i = 0;i < size; i++)
         {
           r /= norm;
-          vcl_beta = norm;
+          beta = norm;
 
-          detail::copy_vec_to_vec(r,s);
-          boost::numeric::ublas::column(Q, i) = s;
+          viennacl::vector_base<NumericT> q_i(Q.handle(), n, i * Q.internal_size1(), 1);
+          q_i = r;
 
           u += prod(A, r);
-          vcl_alpha = inner_prod(u, r);
-          r = u - vcl_alpha * r;
+          alpha = inner_prod(u, r);
+          r = u - alpha * r;
           norm = norm_2(r);
 
-          q = boost::numeric::ublas::column(Q, i);
-          detail::copy_vec_to_vec(q, t);
-
-          u = - norm * t;
-          alphas.push_back(vcl_alpha);
-          betas.push_back(vcl_beta);
-          s.clear();
+          u = - norm * q_i;
+          alphas.push_back(alpha);
+          betas.push_back(beta);
         }
 
-        return bisect(alphas, betas);
+        return lanczos_eigenpairs(Q, alphas, betas, tag.num_eigenvalues(), eigenvectors_A, compute_eigenvectors);
       }
 
       /**
       *   @brief Implementation of the Lanczos FRO algorithm
       *
-      *   @param A            The system matrix
-      *   @param r            Random start vector
-      *   @param size         Size of krylov-space
-      *   @return             Returns the eigenvalues (number of eigenvalues equals size of krylov-space)
+      *   @param A                     The system matrix
+      *   @param r                     Random start vector
+      *   @param eigenvectors_A        Dense matrix holding the eigenvectors of A (one eigenvector per column)
+      *   @param size                  Size of krylov-space
+      *   @param tag                   Lanczos_tag with several options for the algorithm
+      *   @param compute_eigenvectors  Boolean flag. If true, eigenvectors are computed. Otherwise the routine returns after calculating eigenvalues.
+      *   @return                      Returns the eigenvalues (number of eigenvalues equals size of krylov-space)
       */
-      template< typename MatrixT, typename VectorT >
-      std::vector<
-              typename viennacl::result_of::cpu_value_type<typename MatrixT::value_type>::type
-              >
-      lanczosFRO (MatrixT const& A, VectorT & r, int size, lanczos_tag)
+      template< typename MatrixT, typename DenseMatrixT, typename NumericT>
+      std::vector<NumericT>
+      lanczosFRO (MatrixT const& A, viennacl::vector_base<NumericT> & r, DenseMatrixT & eigenvectors_A, std::size_t size, lanczos_tag const & tag, bool compute_eigenvectors)
       {
-
-        typedef typename viennacl::result_of::value_type<MatrixT>::type        ScalarType;
-        typedef typename viennacl::result_of::cpu_value_type<ScalarType>::type    CPU_ScalarType;
-
-          CPU_ScalarType temp;
-          CPU_ScalarType norm;
-          ScalarType vcl_beta;
-          ScalarType vcl_alpha;
-          std::vector<CPU_ScalarType> alphas, betas;
-          long n = r.size();
-          VectorT u(n), t(n);
-          ScalarType inner_rt;
-          boost::numeric::ublas::vector<CPU_ScalarType> u_zero(n), s(r.size()), q(n);
-          boost::numeric::ublas::matrix<CPU_ScalarType> Q(n, size);
+          NumericT temp;
+          NumericT norm;
+          NumericT beta;
+          NumericT alpha;
+          std::vector<NumericT> alphas, betas;
+          std::size_t n = r.size();
+          viennacl::vector<NumericT> u(n, viennacl::traits::context(r));
+          viennacl::matrix<NumericT, viennacl::column_major> Q(n, size, viennacl::traits::context(r));
 
           long reorths = 0;
           norm = norm_2(r);
 
 
-          for(long i = 0; i < size; i++)
+          for(std::size_t i = 0; i < size; i++)
           {
             r /= norm;
 
-            for(long j = 0; j < i; j++)
-            {
-              q = boost::numeric::ublas::column(Q, j);
-              detail::copy_vec_to_vec(q, t);
-              inner_rt = viennacl::linalg::inner_prod(r,t);
-              r = r - inner_rt * t;
-              reorths++;
-            }
+            lanczos_orthogonalize(Q, 0, i, r);
+            reorths += i;
+
             temp = viennacl::linalg::norm_2(r);
             r = r / temp;
-            vcl_beta = temp * norm;
-            detail::copy_vec_to_vec(r,s);
-            boost::numeric::ublas::column(Q, i) = s;
+            beta = temp * norm;
+
+            viennacl::vector_base<NumericT> q_i(Q.handle(), n, i * Q.internal_size1(), 1);
+            q_i = r;
 
             u += viennacl::linalg::prod(A, r);
-            vcl_alpha = viennacl::linalg::inner_prod(u, r);
-            r = u - vcl_alpha * r;
+            alpha = viennacl::linalg::inner_prod(u, r);
+            r = u - alpha * r;
             norm = viennacl::linalg::norm_2(r);
-            q = boost::numeric::ublas::column(Q, i);
-            detail::copy_vec_to_vec(q, t);
-            u = - norm * t;
-            alphas.push_back(vcl_alpha);
-            betas.push_back(vcl_beta);
+            u = - norm * q_i;
+            alphas.push_back(alpha);
+            betas.push_back(beta);
           }
 
-          return bisect(alphas, betas);
+          return lanczos_eigenpairs(Q, alphas, betas, tag.num_eigenvalues(), eigenvectors_A, compute_eigenvectors);
+      }
+
+      /**
+      *   @brief Implementation of the thick-restart Lanczos algorithm (Wu and Simon)
+      *
+      *   The basis is orthogonalized using two blocked Gram-Schmidt passes, each consisting of one transposed and one regular matrix-vector product.
+      *   At each restart the Ritz vectors for the largest Ritz values are kept, so that the Krylov space never exceeds krylov_size() vectors.
+      *
+      *   @param A                     The system matrix
+      *   @param r                     Random start vector
+      *   @param eigenvectors_A        Dense matrix holding the eigenvectors of A (one eigenvector per column)
+      *   @param size                  Size of krylov-space
+      *   @param tag                   Lanczos_tag with several options for the algorithm
+      *   @param compute_eigenvectors  Boolean flag. If true, eigenvectors are computed. Otherwise the routine returns after calculating eigenvalues.
+      *   @return                      Returns the Ritz values of the last restart cycle in ascending order
+      */
+      template< typename MatrixT, typename DenseMatrixT, typename NumericT>
+      std::vector<NumericT>
+      lanczosTRL (MatrixT const& A, viennacl::vector_base<NumericT> & r, DenseMatrixT & eigenvectors_A, std::size_t size, lanczos_tag const & tag, bool compute_eigenvectors)
+      {
+        typedef viennacl::matrix<NumericT, viennacl::column_major>   BasisType;
+
+        std::size_t n = r.size();
+        std::size_t m = size;
+        std::size_t nev = std::min(tag.num_eigenvalues(), m);
+        std::size_t num_kept = std::min(m - 1, nev + (m - nev) / 2);
+        NumericT eps = std::numeric_limits<NumericT>::epsilon();
+
+        // one additional column holds the residual vector of the current cycle:
+        BasisType Q(n, m + 1, viennacl::traits::context(r));
+        viennacl::vector<NumericT> w(n, viennacl::traits::context(r));
+
+        std::vector<NumericT> T(m * m);
+        std::vector<NumericT> Y;
+        std::vector<NumericT> theta;
+
+        r /= viennacl::linalg::norm_2(r);
+        viennacl::vector_base<NumericT> q_0(Q.handle(), n, 0, 1);
+        q_0 = r;
+
+        std::size_t k = 0;         // number of Ritz vectors kept from the previous cycle
+        NumericT beta = 0;
+        NumericT norm_estimate = 0;
+        for (std::size_t restart = 0; ; ++restart)
+        {
+          std::size_t m_active = m;
+
+          for (std::size_t j = k; j < m; ++j)
+          {
+            viennacl::vector_base<NumericT> q_j(Q.handle(), n, j * Q.internal_size1(), 1);
+            w = viennacl::linalg::prod(A, q_j);
+
+            std::vector<NumericT> h  = lanczos_orthogonalize(Q, 0, j + 1, w);
+            std::vector<NumericT> h2 = lanczos_orthogonalize(Q, 0, j + 1, w);
+
+            T[j*m + j] = h[j] + h2[j];
+            beta = viennacl::linalg::norm_2(w);
+            norm_estimate = std::max<NumericT>(norm_estimate, std::fabs(T[j*m + j]) + beta);
+
+            if (beta <= eps * norm_estimate) // invariant subspace found
+            {
+              m_active = j + 1;
+              beta = 0;
+              break;
+            }
+
+            viennacl::vector_base<NumericT> q_next(Q.handle(), n, (j + 1) * Q.internal_size1(), 1);
+            q_next = w / beta;
+
+            if (j + 1 < m)
+            {
+              T[(j+1)*m + j] = beta;
+              T[j*m + j+1] = beta;
+            }
+          }
+
+          // Rayleigh-Ritz step on the host:
+          Y.resize(m_active * m_active);
+          for (std::size_t i=0; i<m_active; ++i)
+            for (std::size_t j=0; j<m_active; ++j)
+              Y[i*m_active + j] = T[i*m + j];
+          symmetric_eig(Y, m_active, theta);
+
+          std::size_t nev_active = std::min(nev, m_active);
+          NumericT theta_max = std::max(std::fabs(theta[0]), std::fabs(theta[m_active - 1]));
+          bool converged = true;
+          for (std::size_t i = m_active - nev_active; i < m_active; ++i)
+            if (std::fabs(beta * Y[(m_active-1)*m_active + i]) > tag.tolerance() * theta_max)
+              converged = false;
+
+          if (converged || m_active < m || restart >= tag.max_restarts())
+          {
+            if (compute_eigenvectors)
+            {
+              std::vector<std::size_t> columns;
+              for (std::size_t i=0; i<nev_active; ++i)
+                columns.push_back(m_active - i - 1);
+              lanczos_ritz_vectors(Q, m_active, Y, columns, eigenvectors_A);
+            }
+            return theta;
+          }
+
+          //
+          // Thick restart: Keep the Ritz vectors for the largest Ritz values and continue with the residual vector
+          //
+          std::vector<std::size_t> columns;
+          for (std::size_t i=0; i<num_kept; ++i)
+            columns.push_back(m - i - 1);
+
+          BasisType kept_vectors(n, num_kept, viennacl::traits::context(r));
+          lanczos_ritz_vectors(Q, m, Y, columns, kept_vectors);
+
+          viennacl::matrix_range<BasisType> Q_kept(Q, viennacl::range(0, n), viennacl::range(0, num_kept));
+          Q_kept = kept_vectors;
+
+          viennacl::vector_base<NumericT> q_residual(Q.handle(), n, m * Q.internal_size1(), 1);
+          viennacl::vector_base<NumericT> q_k(Q.handle(), n, num_kept * Q.internal_size1(), 1);
+          q_k = q_residual;
+
+          // the projected matrix is now an arrowhead matrix:
+          std::fill(T.begin(), T.end(), NumericT(0));
+          for (std::size_t i=0; i<num_kept; ++i)
+          {
+            T[i*m + i] = theta[columns[i]];
+            T[i*m + num_kept] = beta * Y[(m-1)*m + columns[i]];
+            T[num_kept*m + i] = T[i*m + num_kept];
+          }
+          k = num_kept;
+        }
+      }
+
+      /** @brief Runs the Lanczos method selected in the tag. Returns all Ritz values in ascending order. */
+      template< typename MatrixT, typename DenseMatrixT >
+      std::vector< typename viennacl::result_of::cpu_value_type<typename MatrixT::value_type>::type >
+      eig(MatrixT const & matrix, DenseMatrixT & eigenvectors_A, lanczos_tag const & tag, bool compute_eigenvectors)
+      {
+        typedef typename viennacl::result_of::value_type<MatrixT>::type           ScalarType;
+        typedef typename viennacl::result_of::cpu_value_type<ScalarType>::type    CPU_ScalarType;
+
+        boost::mt11213b mt;
+        boost::bernoulli_distribution<CPU_ScalarType> B(0.5);
+        boost::triangle_distribution<CPU_ScalarType> T(-1, 0, 1);
+
+        boost::variate_generator<boost::mt11213b&, boost::bernoulli_distribution<CPU_ScalarType> >  get_B(mt, B);
+        boost::variate_generator<boost::mt11213b&, boost::triangle_distribution<CPU_ScalarType> >   get_T(mt, T);
+
+        std::vector<CPU_ScalarType> eigenvalues;
+        std::size_t matrix_size = matrix.size1();
+        viennacl::vector<CPU_ScalarType> r(matrix_size, viennacl::traits::context(matrix));
+        std::vector<CPU_ScalarType> s(matrix_size);
+
+        for(std::size_t i=0; i<s.size(); ++i)
+          s[i] = 3.0 * get_B() + get_T() - 1.5;
+
+        viennacl::copy(s, r);
+
+        std::size_t size_krylov = (matrix_size < tag.krylov_size()) ? matrix_size
+                                                                    : tag.krylov_size();
+
+        switch(tag.method())
+        {
+          case lanczos_tag::partial_reorthogonalization:
+            eigenvalues = detail::lanczosPRO(matrix, r, eigenvectors_A, size_krylov, tag, compute_eigenvectors);
+            break;
+          case lanczos_tag::full_reorthogonalization:
+            eigenvalues = detail::lanczosFRO(matrix, r, eigenvectors_A, size_krylov, tag, compute_eigenvectors);
+            break;
+          case lanczos_tag::no_reorthogonalization:
+            eigenvalues = detail::lanczos(matrix, r, eigenvectors_A, size_krylov, tag, compute_eigenvectors);
+            break;
+          case lanczos_tag::thick_restart:
+            eigenvalues = detail::lanczosTRL(matrix, r, eigenvectors_A, size_krylov, tag, compute_eigenvectors);
+            break;
+        }
+
+        return eigenvalues;
       }
 
     } // end namespace detail
 
+    /**
+    *   @brief Implementation of the calculation of eigenvalues and eigenvectors using lanczos
+    *
+    *   The Lanczos basis is kept in a dense matrix in the memory domain of the system matrix, hence there is no host-device traffic apart from scalars.
+    *
+    *   @param matrix          The system matrix
+    *   @param eigenvectors_A  A dense matrix (e.g. viennacl::matrix) in which the eigenvectors are stored column-wise in the same order as the eigenvalues.
+    *   @param tag             Tag with several options for the lanczos algorithm
+    *   @return                Returns the n largest eigenvalues in descending order (n defined in the lanczos_tag)
+    */
+    template< typename MatrixT, typename DenseMatrixT >
+    std::vector< typename viennacl::result_of::cpu_value_type<typename MatrixT::value_type>::type >
+    eig(MatrixT const & matrix, DenseMatrixT & eigenvectors_A, lanczos_tag const & tag)
+    {
+      typedef typename viennacl::result_of::value_type<MatrixT>::type           ScalarType;
+      typedef typename viennacl::result_of::cpu_value_type<ScalarType>::type    CPU_ScalarType;
+
+      std::vector<CPU_ScalarType> eigenvalues = detail::eig(matrix, eigenvectors_A, tag, true);
+
+      std::vector<CPU_ScalarType> largest_eigenvalues;
+      for(std::size_t i = 1; i<=std::min(tag.num_eigenvalues(), eigenvalues.size()); i++)
+        largest_eigenvalues.push_back(eigenvalues[eigenvalues.size()-i]);
+
+      return largest_eigenvalues;
+    }
+
     /**
     *   @brief Implementation of the calculation of eigenvalues using lanczos
     *
@@ -437,54 +699,82 @@ namespace viennacl
     {
       typedef typename viennacl::result_of::value_type<MatrixT>::type           ScalarType;
       typedef typename viennacl::result_of::cpu_value_type<ScalarType>::type    CPU_ScalarType;
-      typedef typename viennacl::result_of::vector_for_matrix<MatrixT>::type    VectorT;
-
-      boost::mt11213b mt;
-      boost::normal_distribution<CPU_ScalarType> N(0, 1);
-      boost::bernoulli_distribution<CPU_ScalarType> B(0.5);
-      boost::triangle_distribution<CPU_ScalarType> T(-1, 0, 1);
-
-      boost::variate_generator<boost::mt11213b&, boost::normal_distribution<CPU_ScalarType> >     get_N(mt, N);
-      boost::variate_generator<boost::mt11213b&, boost::bernoulli_distribution<CPU_ScalarType> >  get_B(mt, B);
-      boost::variate_generator<boost::mt11213b&, boost::triangle_distribution<CPU_ScalarType> >   get_T(mt, T);
-
-      std::vector<CPU_ScalarType> eigenvalues;
-      std::size_t matrix_size = matrix.size1();
-      VectorT r(matrix_size);
-      std::vector<CPU_ScalarType> s(matrix_size);
-
-      for(std::size_t i=0; i<s.size(); ++i)
-        s[i] = 3.0 * get_B() + get_T() - 1.5;
 
-      detail::copy_vec_to_vec(s,r);
+      viennacl::matrix<CPU_ScalarType, viennacl::column_major> eigenvectors_A;
+      std::vector<CPU_ScalarType> eigenvalues = detail::eig(matrix, eigenvectors_A, tag, false);
 
-      std::size_t size_krylov = (matrix_size < tag.krylov_size()) ? matrix_size
-                                                                  : tag.krylov_size();
+      std::vector<CPU_ScalarType> largest_eigenvalues;
+      for(std::size_t i = 1; i<=std::min(tag.num_eigenvalues(), eigenvalues.size()); i++)
+        largest_eigenvalues.push_back(eigenvalues[eigenvalues.size()-i]);
 
-      switch(tag.method())
-      {
-        case lanczos_tag::partial_reorthogonalization:
-          eigenvalues = detail::lanczosPRO(matrix, r, size_krylov, tag);
-          break;
-        case lanczos_tag::full_reorthogonalization:
-          eigenvalues = detail::lanczosFRO(matrix, r, size_krylov, tag);
-          break;
-        case lanczos_tag::no_reorthogonalization:
-          eigenvalues = detail::lanczos(matrix, r, size_krylov, tag);
-          break;
-      }
+      return largest_eigenvalues;
+    }
 
-      std::vector<CPU_ScalarType> largest_eigenvalues;
+#ifdef VIENNACL_WITH_UBLAS
+    //
+    // Convenience overloads for uBLAS system matrices: The matrix is copied to a viennacl::compressed_matrix once, the iteration then runs on the compute backend.
+    //
 
-      for(std::size_t i = 1; i<=tag.num_eigenvalues(); i++)
-        largest_eigenvalues.push_back(eigenvalues[size_krylov-i]);
+    /** @brief Computes eigenvalues and eigenvectors of a uBLAS sparse matrix in compressed format. See eig(MatrixT const &, DenseMatrixT &, lanczos_tag const &) */
+    template< typename T, typename F, std::size_t IB, typename IA, typename TA, typename DenseMatrixT >
+    std::vector<T>
+    eig(boost::numeric::ublas::compressed_matrix<T, F, IB, IA, TA> const & matrix, DenseMatrixT & eigenvectors_A, lanczos_tag const & tag)
+    {
+      viennacl::compressed_matrix<T> vcl_matrix(matrix.size1(), matrix.size2());
+      viennacl::copy(matrix, vcl_matrix);
+      return eig(vcl_matrix, eigenvectors_A, tag);
+    }
 
+    /** @brief Computes eigenvalues of a uBLAS sparse matrix in compressed format. See eig(MatrixT const &, lanczos_tag const &) */
+    template< typename T, typename F, std::size_t IB, typename IA, typename TA >
+    std::vector<T>
+    eig(boost::numeric::ublas::compressed_matrix<T, F, IB, IA, TA> const & matrix, lanczos_tag const & tag)
+    {
+      viennacl::compressed_matrix<T> vcl_matrix(matrix.size1(), matrix.size2());
+      viennacl::copy(matrix, vcl_matrix);
+      return eig(vcl_matrix, tag);
+    }
 
-      return largest_eigenvalues;
+    /** @brief Computes eigenvalues and eigenvectors of a uBLAS sparse matrix in coordinate format. See eig(MatrixT const &, DenseMatrixT &, lanczos_tag const &) */
+    template< typename T, typename F, std::size_t IB, typename IA, typename TA, typename DenseMatrixT >
+    std::vector<T>
+    eig(boost::numeric::ublas::coordinate_matrix<T, F, IB, IA, TA> const & matrix, DenseMatrixT & eigenvectors_A, lanczos_tag const & tag)
+    {
+      viennacl::compressed_matrix<T> vcl_matrix(matrix.size1(), matrix.size2());
+      viennacl::copy(matrix, vcl_matrix);
+      return eig(vcl_matrix, eigenvectors_A, tag);
     }
 
+    /** @brief Computes eigenvalues of a uBLAS sparse matrix in coordinate format. See eig(MatrixT const &, lanczos_tag const &) */
+    template< typename T, typename F, std::size_t IB, typename IA, typename TA >
+    std::vector<T>
+    eig(boost::numeric::ublas::coordinate_matrix<T, F, IB, IA, TA> const & matrix, lanczos_tag const & tag)
+    {
+      viennacl::compressed_matrix<T> vcl_matrix(matrix.size1(), matrix.size2());
+      viennacl::copy(matrix, vcl_matrix);
+      return eig(vcl_matrix, tag);
+    }
 
+    /** @brief Computes eigenvalues and eigenvectors of a dense uBLAS matrix. See eig(MatrixT const &, DenseMatrixT &, lanczos_tag const &) */
+    template< typename T, typename F, typename A, typename DenseMatrixT >
+    std::vector<T>
+    eig(boost::numeric::ublas::matrix<T, F, A> const & matrix, DenseMatrixT & eigenvectors_A, lanczos_tag const & tag)
+    {
+      viennacl::compressed_matrix<T> vcl_matrix(matrix.size1(), matrix.size2());
+      viennacl::copy(matrix, vcl_matrix);
+      return eig(vcl_matrix, eigenvectors_A, tag);
+    }
 
+    /** @brief Computes eigenvalues of a dense uBLAS matrix. See eig(MatrixT const &, lanczos_tag const &) */
+    template< typename T, typename F, typename A >
+    std::vector<T>
+    eig(boost::numeric::ublas::matrix<T, F, A> const & matrix, lanczos_tag const & tag)
+    {
+      viennacl::compressed_matrix<T> vcl_matrix(matrix.size1(), matrix.size2());
+      viennacl::copy(matrix, vcl_matrix);
+      return eig(vcl_matrix, tag);
+    }
+#endif
 
   } // end namespace linalg
 } // end namespace viennacl
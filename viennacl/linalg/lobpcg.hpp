@@ -0,0 +1,292 @@
+#ifndef VIENNACL_LINALG_LOBPCG_HPP_
+#define VIENNACL_LINALG_LOBPCG_HPP_
+
+/* =========================================================================
+   Copyright (c) 2010-2013, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/linalg/lobpcg.hpp
+*   @brief Implementation of the locally optimal block preconditioned conjugate gradient (LOBPCG) method for symmetric eigenvalue problems.
+*
+*   The whole block of approximate eigenvectors is iterated at once, so the system matrix is applied to dense matrices (sparse matrix times dense matrix) rather than to individual vectors.
+*/
+
+#include <cmath>
+#include <vector>
+#include <limits>
+#include <algorithm>
+#include "viennacl/forwards.h"
+#include "viennacl/matrix.hpp"
+#include "viennacl/matrix_proxy.hpp"
+#include "viennacl/linalg/prod.hpp"
+#include "viennacl/linalg/detail/symmetric_eig.hpp"
+#include "viennacl/linalg/detail/block_eig_common.hpp"
+
+namespace viennacl
+{
+  namespace linalg
+  {
+
+    /** @brief A tag for the LOBPCG eigensolver. Used for supplying solver parameters and for dispatching the eig() function
+    */
+    class lobpcg_tag
+    {
+      public:
+
+        enum
+        {
+          smallest_eigenvalues = 0,
+          largest_eigenvalues
+        };
+
+        /** @brief The constructor
+        *
+        * @param numeig       Number of eigenvalues (and block size)
+        * @param tol          Relative tolerance for the residuals ||A x - lambda x|| / |lambda|
+        * @param max_iters    The maximum number of iterations
+        * @param which        Either smallest_eigenvalues or largest_eigenvalues
+        */
+        lobpcg_tag(std::size_t numeig = 10, double tol = 1e-6, std::size_t max_iters = 500, int which = smallest_eigenvalues)
+          : num_eigenvalues_(numeig), tolerance_(tol), max_iterations_(max_iters), which_(which), initial_guess_(false), iters_taken_(0), last_error_(0) {}
+
+        /** @brief Sets the number of eigenvalues */
+        void num_eigenvalues(std::size_t numeig) { num_eigenvalues_ = numeig; }
+        /** @brief Returns the number of eigenvalues */
+        std::size_t num_eigenvalues() const { return num_eigenvalues_; }
+
+        /** @brief Sets the relative residual tolerance */
+        void tolerance(double tol) { tolerance_ = tol; }
+        /** @brief Returns the relative residual tolerance */
+        double tolerance() const { return tolerance_; }
+
+        /** @brief Sets the maximum number of iterations */
+        void max_iterations(std::size_t max_iters) { max_iterations_ = max_iters; }
+        /** @brief Returns the maximum number of iterations */
+        std::size_t max_iterations() const { return max_iterations_; }
+
+        /** @brief Sets which end of the spectrum is computed */
+        void which(int w) { which_ = w; }
+        /** @brief Returns which end of the spectrum is computed */
+        int which() const { return which_; }
+
+        /** @brief Sets whether the eigenvector matrix passed to eig() holds the starting block (if of size n x num_eigenvalues). Otherwise a random block is used. */
+        void initial_guess(bool b) { initial_guess_ = b; }
+        /** @brief Returns whether the eigenvector matrix passed to eig() holds the starting block */
+        bool initial_guess() const { return initial_guess_; }
+
+        /** @brief Return the number of iterations taken by the solver */
+        std::size_t iters() const { return iters_taken_; }
+        /** @brief Set the number of iterations taken by the solver */
+        void iters(std::size_t i) const { iters_taken_ = i; }
+
+        /** @brief Returns the largest relative residual of the eigenpairs at the end of the solver run */
+        double error() const { return last_error_; }
+        /** @brief Sets the largest relative residual of the eigenpairs at the end of the solver run */
+        void error(double e) const { last_error_ = e; }
+
+      private:
+        std::size_t num_eigenvalues_;
+        double tolerance_;
+        std::size_t max_iterations_;
+        int which_;
+        bool initial_guess_;
+
+        //return values from solver
+        mutable std::size_t iters_taken_;
+        mutable double last_error_;
+    };
+
+
+    /** @brief Computes eigenvalues and eigenvectors at one end of the spectrum of a symmetric matrix using LOBPCG (Knyazev)
+    *
+    * The search space [X, W, P] of current eigenvector approximations X, preconditioned residuals W and search directions P is
+    * kept as one column-major dense matrix in the memory domain of the system matrix. Only Gram matrices of size 3k x 3k are processed on the host.
+    * Directions lost to rank deficiency of the starting block or to a collapse of the search space are replaced by random vectors, so that k eigenpairs are always returned.
+    *
+    * @param A               The symmetric system matrix (sparse or dense)
+    * @param eigenvectors_A  Dense matrix in which the eigenvectors are stored column-wise in the same order as the eigenvalues. Holds the starting block on entry if requested by the tag.
+    * @param tag             Solver configuration tag
+    * @param precond         A preconditioner approximating the inverse of A (e.g. jacobi_precond, ilu0_precond, amg_precon). Precondition with A^{-1}-approximations only for smallest_eigenvalues.
+    * @return                The eigenvalues, smallest (resp. largest) first
+    */
+    template <typename MatrixT, typename DenseMatrixT, typename PreconditionerT>
+    std::vector< typename viennacl::result_of::cpu_value_type<typename MatrixT::value_type>::type >
+    eig(MatrixT const & A, DenseMatrixT & eigenvectors_A, lobpcg_tag const & tag, PreconditionerT const & precond)
+    {
+      typedef typename viennacl::result_of::value_type<MatrixT>::type           ScalarType;
+      typedef typename viennacl::result_of::cpu_value_type<ScalarType>::type    NumericT;
+      typedef viennacl::matrix<NumericT, viennacl::column_major>                BlockType;
+      typedef viennacl::matrix_range<BlockType>                                 BlockRangeType;
+
+      std::size_t n = A.size1();
+      std::size_t k = std::min(tag.num_eigenvalues(), n);
+      bool largest = (tag.which() == lobpcg_tag::largest_eigenvalues);
+      viennacl::context ctx = viennacl::traits::context(A);
+
+      // search space S = [X, W, P] and its image A*S:
+      BlockType S(n, 3 * k, ctx);
+      BlockType AS(n, 3 * k, ctx);
+      BlockType X_new(n, k, ctx), AX_new(n, k, ctx), P_new(n, k, ctx), AP_new(n, k, ctx);
+
+      viennacl::range all_rows(0, n);
+      BlockRangeType X (S,  all_rows, viennacl::range(0,   k));
+      BlockRangeType W (S,  all_rows, viennacl::range(k, 2*k));
+      BlockRangeType P (S,  all_rows, viennacl::range(2*k, 3*k));
+      BlockRangeType AX(AS, all_rows, viennacl::range(0,   k));
+      BlockRangeType AW(AS, all_rows, viennacl::range(k, 2*k));
+      BlockRangeType AP(AS, all_rows, viennacl::range(2*k, 3*k));
+
+      //
+      // Initial Rayleigh-Ritz step on the (orthonormalized) user-provided or a random block:
+      //
+      if (tag.initial_guess() && eigenvectors_A.size1() == n && eigenvectors_A.size2() == k)
+        detail::block_init(eigenvectors_A, X_new);
+      else
+        detail::block_random(X_new);
+      detail::block_orthonormalize(X_new, AX_new, 1);
+      X = X_new;
+      detail::block_matrix_apply(A, X, AX);
+
+      std::vector<NumericT> Z;
+      std::size_t num_cols = detail::block_svqb(detail::block_gram(X, X), k, Z);
+
+      std::vector<NumericT> H = detail::block_gram(X, AX);
+      std::vector<NumericT> H_reduced;
+      std::vector<NumericT> theta;
+      std::vector<NumericT> eigenvalues(k);
+
+      std::size_t active_cols = k;   // number of active columns in S: k for [X], 2k for [X, W], 3k for [X, W, P]
+      for (std::size_t iter = 0; ; ++iter)
+      {
+        //
+        // Rayleigh-Ritz on the active part of the search space: Z^T H Z y = theta y with Z^T G Z = I
+        //
+        std::vector<NumericT> HZ(active_cols * num_cols);
+        for (std::size_t l=0; l<active_cols; ++l)
+          for (std::size_t m=0; m<active_cols; ++m)
+          {
+            NumericT h_lm = NumericT(0.5) * (H[l*active_cols + m] + H[m*active_cols + l]);
+            for (std::size_t j=0; j<num_cols; ++j)
+              HZ[l*num_cols + j] += h_lm * Z[m*num_cols + j];
+          }
+
+        H_reduced.assign(num_cols * num_cols, NumericT(0));
+        for (std::size_t l=0; l<active_cols; ++l)
+          for (std::size_t i=0; i<num_cols; ++i)
+            for (std::size_t j=0; j<num_cols; ++j)
+              H_reduced[i*num_cols + j] += Z[l*num_cols + i] * HZ[l*num_cols + j];
+        detail::symmetric_eig(H_reduced, num_cols, theta);
+
+        std::vector<std::size_t> wanted = detail::block_eig_wanted(num_cols, k, largest);
+        std::vector<NumericT> C(active_cols * k);        // coefficients of the new Ritz vectors with respect to S
+        for (std::size_t i=0; i<active_cols; ++i)
+          for (std::size_t j=0; j<wanted.size(); ++j)
+          {
+            NumericT value = 0;
+            for (std::size_t l=0; l<num_cols; ++l)
+              value += Z[i*num_cols + l] * H_reduced[l*num_cols + wanted[j]];
+            C[i*k + j] = value;
+          }
+        for (std::size_t j=0; j<wanted.size(); ++j)
+          eigenvalues[j] = theta[wanted[j]];
+
+        //
+        // Update X, A*X and (if available) the search directions P, A*P:
+        //
+        BlockRangeType S_active (S,  all_rows, viennacl::range(0, active_cols));
+        BlockRangeType AS_active(AS, all_rows, viennacl::range(0, active_cols));
+        detail::block_times_host(S_active,  C, active_cols, k, X_new);
+        detail::block_times_host(AS_active, C, active_cols, k, AX_new);
+        if (active_cols > k)
+        {
+          std::vector<NumericT> C_WP(C.begin() + k * k, C.end());
+          BlockRangeType S_WP (S,  all_rows, viennacl::range(k, active_cols));
+          BlockRangeType AS_WP(AS, all_rows, viennacl::range(k, active_cols));
+          detail::block_times_host(S_WP,  C_WP, active_cols - k, k, P_new);
+          detail::block_times_host(AS_WP, C_WP, active_cols - k, k, AP_new);
+          P  = P_new;
+          AP = AP_new;
+        }
+        X  = X_new;
+        AX = AX_new;
+
+        //
+        // Residuals W = A X - X diag(theta) and convergence check:
+        //
+        std::vector<NumericT> Theta(k * k);
+        for (std::size_t j=0; j<k; ++j)
+          Theta[j*k + j] = eigenvalues[j];
+        detail::block_times_host(X, Theta, k, k, X_new);
+        W = AX - X_new;
+
+        std::vector<NumericT> R = detail::block_gram(W, W);
+        NumericT max_residual = 0;
+        for (std::size_t j=0; j<k; ++j)
+        {
+          NumericT scale = std::max<NumericT>(std::fabs(eigenvalues[j]), std::numeric_limits<NumericT>::epsilon());
+          max_residual = std::max<NumericT>(max_residual, std::sqrt(std::fabs(R[j*k + j])) / scale);
+        }
+        tag.iters(iter);
+        tag.error(max_residual);
+
+        if (max_residual <= tag.tolerance() || iter >= tag.max_iterations())
+          break;
+
+        //
+        // Preconditioned residuals and new search space:
+        //
+        detail::block_precond_apply(precond, W);
+        detail::block_matrix_apply(A, W, AW);
+
+        active_cols = (iter == 0) ? 2 * k : 3 * k;
+        BlockRangeType S_next(S, all_rows, viennacl::range(0, active_cols));
+        num_cols = detail::block_svqb(detail::block_gram(S_next, S_next), active_cols, Z);
+        if (num_cols < k)
+        {
+          // search space collapsed (X itself lost rank): restart from X with the lost directions refilled
+          X_new = X;
+          detail::block_orthonormalize(X_new, AX_new, static_cast<unsigned int>(iter) + 2);
+          X = X_new;
+          detail::block_matrix_apply(A, X, AX);
+          active_cols = k;
+          num_cols = detail::block_svqb(detail::block_gram(X, X), k, Z);
+        }
+        H = detail::block_gram(BlockRangeType(S,  all_rows, viennacl::range(0, active_cols)),
+                               BlockRangeType(AS, all_rows, viennacl::range(0, active_cols)));
+      }
+
+      detail::block_assign(X, eigenvectors_A);
+      return eigenvalues;
+    }
+
+    /** @brief Computes eigenvalues and eigenvectors at one end of the spectrum of a symmetric matrix using LOBPCG without preconditioner
+    *
+    * @param A               The symmetric system matrix (sparse or dense)
+    * @param eigenvectors_A  Dense matrix in which the eigenvectors are stored column-wise in the same order as the eigenvalues
+    * @param tag             Solver configuration tag
+    * @return                The eigenvalues, smallest (resp. largest) first
+    */
+    template <typename MatrixT, typename DenseMatrixT>
+    std::vector< typename viennacl::result_of::cpu_value_type<typename MatrixT::value_type>::type >
+    eig(MatrixT const & A, DenseMatrixT & eigenvectors_A, lobpcg_tag const & tag)
+    {
+      return viennacl::linalg::eig(A, eigenvectors_A, tag, viennacl::linalg::no_precond());
+    }
+
+  }
+}
+
+#endif
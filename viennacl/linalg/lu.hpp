@@ -22,11 +22,14 @@
     @brief Implementations of LU factorization for row-major and column-major dense matrices.
 */
 
+#include <vector>
+
 #include "viennacl/matrix.hpp"
 #include "viennacl/matrix_proxy.hpp"
 
 #include "viennacl/linalg/prod.hpp"
 #include "viennacl/linalg/direct_solve.hpp"
+#include "viennacl/linalg/host_based/lu.hpp"
 
 namespace viennacl
 {
@@ -186,6 +189,64 @@ namespace viennacl
     }
 
 
+    /** @brief LU factorization with partial (row) pivoting of a dense matrix, P A = L U.
+    *
+    * Uses a blocked right-looking algorithm with recursive panel factorization, where the bulk of the work is carried out in matrix-matrix products.
+    * The factorization is always computed in main memory. Matrices in other memory domains are transferred to main memory and back.
+    *
+    * @param A        The system matrix, where the LU matrices are directly written to. The implicit unit diagonal of L is not written.
+    * @param pivots   Row interchanges: row i was interchanged with row pivots[i] in the i-th step (LAPACK convention)
+    */
+    template<typename SCALARTYPE, typename F, unsigned int ALIGNMENT>
+    void lu_factorize(matrix<SCALARTYPE, F, ALIGNMENT> & A, std::vector<std::size_t> & pivots)
+    {
+      assert(A.size1() == A.size2() && bool("Matrix must be square"));
+
+      switch (viennacl::traits::handle(A).get_active_handle_id())
+      {
+        case viennacl::MAIN_MEMORY:
+          viennacl::linalg::host_based::lu_factorize(A, pivots);
+          break;
+        case viennacl::MEMORY_NOT_INITIALIZED:
+          throw memory_exception("not initialised!");
+        default:
+        {
+          matrix<SCALARTYPE, F, ALIGNMENT> host_A(A);
+          viennacl::backend::switch_memory_context<SCALARTYPE>(host_A.handle(), viennacl::context(viennacl::MAIN_MEMORY));
+          viennacl::linalg::host_based::lu_factorize(host_A, pivots);
+          viennacl::backend::switch_memory_context<SCALARTYPE>(host_A.handle(), viennacl::traits::context(A));
+          A = host_A;
+        }
+      }
+    }
+
+    namespace detail
+    {
+      /** @brief Applies the row interchanges of an LU factorization with partial pivoting to the right hand side(s). Always carried out in main memory. */
+      template <typename RHSType>
+      void lu_swap_rows(RHSType & B, std::vector<std::size_t> const & pivots)
+      {
+        typedef typename viennacl::result_of::cpu_value_type<typename RHSType::value_type>::type   CPUScalarType;
+
+        switch (viennacl::traits::handle(B).get_active_handle_id())
+        {
+          case viennacl::MAIN_MEMORY:
+            viennacl::linalg::host_based::lu_swap_rows(B, pivots);
+            break;
+          case viennacl::MEMORY_NOT_INITIALIZED:
+            throw memory_exception("not initialised!");
+          default:
+          {
+            RHSType host_B(B);
+            viennacl::backend::switch_memory_context<CPUScalarType>(host_B.handle(), viennacl::context(viennacl::MAIN_MEMORY));
+            viennacl::linalg::host_based::lu_swap_rows(host_B, pivots);
+            viennacl::backend::switch_memory_context<CPUScalarType>(host_B.handle(), viennacl::traits::context(B));
+            B = host_B;
+          }
+        }
+      }
+    }
+
     //
     // Convenience layer:
     //
@@ -219,6 +280,43 @@ namespace viennacl
       inplace_solve(A, vec, upper_tag());
     }
 
+    /** @brief LU substitution for the system P^T LU = rhs obtained from lu_factorize() with partial pivoting.
+    *
+    * @param A        The LU factors as computed by lu_factorize(A, pivots)
+    * @param pivots   The row interchanges as computed by lu_factorize(A, pivots)
+    * @param B        The matrix of load vectors, where the solution is directly written to
+    */
+    template<typename SCALARTYPE, typename F1, typename F2, unsigned int ALIGNMENT_A, unsigned int ALIGNMENT_B>
+    void lu_substitute(matrix<SCALARTYPE, F1, ALIGNMENT_A> const & A,
+                       std::vector<std::size_t> const & pivots,
+                       matrix<SCALARTYPE, F2, ALIGNMENT_B> & B)
+    {
+      assert(A.size1() == A.size2() && bool("Matrix must be square"));
+      assert(A.size1() == B.size1() && bool("Matrix must be square"));
+      assert(A.size1() == pivots.size() && bool("Number of pivots does not match matrix size"));
+      detail::lu_swap_rows(B, pivots);
+      inplace_solve(A, B, unit_lower_tag());
+      inplace_solve(A, B, upper_tag());
+    }
+
+    /** @brief LU substitution for the system P^T LU = rhs obtained from lu_factorize() with partial pivoting.
+    *
+    * @param A        The LU factors as computed by lu_factorize(A, pivots)
+    * @param pivots   The row interchanges as computed by lu_factorize(A, pivots)
+    * @param vec      The load vector, where the solution is directly written to
+    */
+    template<typename SCALARTYPE, typename F, unsigned int ALIGNMENT, unsigned int VEC_ALIGNMENT>
+    void lu_substitute(matrix<SCALARTYPE, F, ALIGNMENT> const & A,
+                       std::vector<std::size_t> const & pivots,
+                       vector<SCALARTYPE, VEC_ALIGNMENT> & vec)
+    {
+      assert(A.size1() == A.size2() && bool("Matrix must be square"));
+      assert(A.size1() == pivots.size() && bool("Number of pivots does not match matrix size"));
+      detail::lu_swap_rows(vec, pivots);
+      inplace_solve(A, vec, unit_lower_tag());
+      inplace_solve(A, vec, upper_tag());
+    }
+
   }
 }
 
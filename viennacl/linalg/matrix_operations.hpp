@@ -35,6 +35,7 @@
 #include "viennacl/traits/handle.hpp"
 #include "viennacl/traits/stride.hpp"
 #include "viennacl/vector.hpp"
+#include "viennacl/tools/profiler.hpp"
 #include "viennacl/linalg/host_based/matrix_operations.hpp"
 
 #ifdef VIENNACL_WITH_OPENCL
@@ -49,6 +50,15 @@ namespace viennacl
 {
   namespace linalg
   {
+    namespace detail
+    {
+      /** @brief Returns the minimum number of bytes moved by C = alpha * op(A) * op(B) + beta * C with C of size m x n and op(A) of size m x k, as recorded by the profiler */
+      template <typename NumericT>
+      double gemm_bytes(std::size_t m, std::size_t n, std::size_t k, bool read_C)
+      {
+        return sizeof(NumericT) * (double(m) * k + double(k) * n + (read_C ? 2.0 : 1.0) * m * n);
+      }
+    }
 
     template <typename NumericT, typename F,
               typename ScalarType1>
@@ -354,6 +364,10 @@ namespace viennacl
       assert( (viennacl::traits::size1(mat) == viennacl::traits::size(result)) && bool("Size check failed at v1 = prod(A, v2): size1(A) != size(v1)"));
       assert( (viennacl::traits::size2(mat) == viennacl::traits::size(vec))    && bool("Size check failed at v1 = prod(A, v2): size2(A) != size(v2)"));
 
+      viennacl::tools::profiler_scope profile("gemv", viennacl::traits::active_handle_id(mat),
+                                              sizeof(NumericT) * (double(viennacl::traits::size1(mat)) * viennacl::traits::size2(mat) + viennacl::traits::size1(mat) + viennacl::traits::size2(mat)),
+                                              2.0 * viennacl::traits::size1(mat) * viennacl::traits::size2(mat));
+
       switch (viennacl::traits::handle(mat).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
@@ -395,6 +409,10 @@ namespace viennacl
       assert( (viennacl::traits::size1(mat_trans.lhs()) == viennacl::traits::size(vec))    && bool("Size check failed at v1 = trans(A) * v2: size1(A) != size(v2)"));
       assert( (viennacl::traits::size2(mat_trans.lhs()) == viennacl::traits::size(result)) && bool("Size check failed at v1 = trans(A) * v2: size2(A) != size(v1)"));
 
+      viennacl::tools::profiler_scope profile("gemv", viennacl::traits::active_handle_id(mat_trans.lhs()),
+                                              sizeof(NumericT) * (double(viennacl::traits::size1(mat_trans.lhs())) * viennacl::traits::size2(mat_trans.lhs()) + viennacl::traits::size1(mat_trans.lhs()) + viennacl::traits::size2(mat_trans.lhs())),
+                                              2.0 * viennacl::traits::size1(mat_trans.lhs()) * viennacl::traits::size2(mat_trans.lhs()));
+
       switch (viennacl::traits::handle(mat_trans.lhs()).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
@@ -439,6 +457,10 @@ namespace viennacl
       assert( (viennacl::traits::size2(B) == viennacl::traits::size2(C)) && bool("Size check failed at C = prod(A, B): size2(B) != size2(C)"));
 
 
+      viennacl::tools::profiler_scope profile("gemm", viennacl::traits::active_handle_id(A),
+                                              detail::gemm_bytes<NumericT>(viennacl::traits::size1(C), viennacl::traits::size2(C), viennacl::traits::size2(A), beta != 0),
+                                              2.0 * viennacl::traits::size1(C) * viennacl::traits::size2(C) * viennacl::traits::size2(A));
+
       switch (viennacl::traits::handle(A).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
@@ -481,6 +503,10 @@ namespace viennacl
       assert(viennacl::traits::size1(A.lhs()) == viennacl::traits::size1(B) && bool("Size check failed at C = prod(trans(A), B): size1(A) != size1(B)"));
       assert(viennacl::traits::size2(B)       == viennacl::traits::size2(C) && bool("Size check failed at C = prod(trans(A), B): size2(B) != size2(C)"));
 
+      viennacl::tools::profiler_scope profile("gemm", viennacl::traits::active_handle_id(A.lhs()),
+                                              detail::gemm_bytes<NumericT>(viennacl::traits::size1(C), viennacl::traits::size2(C), viennacl::traits::size1(A.lhs()), beta != 0),
+                                              2.0 * viennacl::traits::size1(C) * viennacl::traits::size2(C) * viennacl::traits::size1(A.lhs()));
+
       switch (viennacl::traits::handle(A.lhs()).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
@@ -522,6 +548,10 @@ namespace viennacl
       assert(viennacl::traits::size2(A)       == viennacl::traits::size2(B.lhs()) && bool("Size check failed at C = prod(A, trans(B)): size2(A) != size2(B)"));
       assert(viennacl::traits::size1(B.lhs()) == viennacl::traits::size2(C)       && bool("Size check failed at C = prod(A, trans(B)): size1(B) != size2(C)"));
 
+      viennacl::tools::profiler_scope profile("gemm", viennacl::traits::active_handle_id(A),
+                                              detail::gemm_bytes<NumericT>(viennacl::traits::size1(C), viennacl::traits::size2(C), viennacl::traits::size2(A), beta != 0),
+                                              2.0 * viennacl::traits::size1(C) * viennacl::traits::size2(C) * viennacl::traits::size2(A));
+
       switch (viennacl::traits::handle(A).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
@@ -562,6 +592,10 @@ namespace viennacl
       assert(viennacl::traits::size1(A.lhs()) == viennacl::traits::size2(B.lhs()) && bool("Size check failed at C = prod(trans(A), trans(B)): size1(A) != size2(B)"));
       assert(viennacl::traits::size1(B.lhs()) == viennacl::traits::size2(C)       && bool("Size check failed at C = prod(trans(A), trans(B)): size1(B) != size2(C)"));
 
+      viennacl::tools::profiler_scope profile("gemm", viennacl::traits::active_handle_id(A.lhs()),
+                                              detail::gemm_bytes<NumericT>(viennacl::traits::size1(C), viennacl::traits::size2(C), viennacl::traits::size1(A.lhs()), beta != 0),
+                                              2.0 * viennacl::traits::size1(C) * viennacl::traits::size2(C) * viennacl::traits::size1(A.lhs()));
+
       switch (viennacl::traits::handle(A.lhs()).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
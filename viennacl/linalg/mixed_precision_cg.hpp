@@ -137,10 +137,8 @@ namespace viennacl
       if (norm_rhs_squared == 0) //solution is zero if RHS norm is zero
         return result;
 
-      static bool first = true;
-
       viennacl::ocl::context & ctx = const_cast<viennacl::ocl::context &>(viennacl::traits::opencl_handle(matrix).context());
-      if (first)
+      if (!ctx.has_program("double_float_conversion_program"))
       {
         ctx.add_program(double_float_conversion_program, "double_float_conversion_program");
       }
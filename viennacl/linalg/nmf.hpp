@@ -25,12 +25,26 @@
 */
 
 
+#include <cmath>
+#include <vector>
+#include <algorithm>
+#include <limits>
+
 #include "viennacl/vector.hpp"
 #include "viennacl/matrix.hpp"
+#include "viennacl/compressed_matrix.hpp"
 #include "viennacl/linalg/prod.hpp"
 #include "viennacl/linalg/norm_2.hpp"
 #include "viennacl/linalg/norm_frobenius.hpp"
-#include "viennacl/linalg/opencl/kernels/nmf.hpp"
+#include "viennacl/linalg/host_based/nmf_operations.hpp"
+
+#ifdef VIENNACL_WITH_OPENCL
+  #include "viennacl/linalg/opencl/nmf_operations.hpp"
+#endif
+
+#ifdef VIENNACL_WITH_CUDA
+  #include "viennacl/linalg/cuda/nmf_operations.hpp"
+#endif
 
 namespace viennacl
 {
@@ -78,10 +92,16 @@ namespace viennacl
         void check_after_steps(std::size_t c) { if (c > 0) check_after_steps_ = c; }
 
 
-        template <typename ScalarType>
-        friend void nmf(viennacl::matrix<ScalarType> const & V,
-                        viennacl::matrix<ScalarType> & W,
-                        viennacl::matrix<ScalarType> & H,
+        template <typename ScalarType, typename F>
+        friend void nmf(viennacl::matrix_base<ScalarType, F> const & V,
+                        viennacl::matrix_base<ScalarType, F> & W,
+                        viennacl::matrix_base<ScalarType, F> & H,
+                        nmf_config const & conf);
+
+        template <typename ScalarType, unsigned int ALIGNMENT, typename F>
+        friend void nmf(viennacl::compressed_matrix<ScalarType, ALIGNMENT> const & V,
+                        viennacl::matrix_base<ScalarType, F> & W,
+                        viennacl::matrix_base<ScalarType, F> & H,
                         nmf_config const & conf);
 
       private:
@@ -93,101 +113,280 @@ namespace viennacl
     };
 
 
-    /** @brief The nonnegative matrix factorization (approximation) algorithm as suggested by Lee and Seung. Factorizes a matrix V with nonnegative entries into matrices W and H such that ||V - W*H|| is minimized.
-     *
-     * @param V     Input matrix
-     * @param W     First factor
-     * @param H     Second factor
-     * @param conf  A configuration object holding tolerances and the like
-     */
-    template <typename ScalarType>
-    void nmf(viennacl::matrix<ScalarType> const & V,
-             viennacl::matrix<ScalarType> & W,
-             viennacl::matrix<ScalarType> & H,
-             nmf_config const & conf)
-    {
-      viennacl::ocl::context & ctx = const_cast<viennacl::ocl::context &>(viennacl::traits::opencl_handle(V).context());
 
-      const std::string NMF_MUL_DIV_KERNEL = "el_wise_mul_div";
 
-      viennacl::linalg::opencl::kernels::nmf<ScalarType>::init(ctx);
+    namespace detail
+    {
+      /** @brief Dispatcher for the fused multiplicative update X_ij <- X_ij * N_ij / (X * S)_ij, see e.g. viennacl::linalg::host_based::nmf_update_factor() */
+      template <typename NumericT, typename F>
+      void nmf_update_factor(viennacl::matrix_base<NumericT, F> & X,
+                             viennacl::matrix_base<NumericT, F> const & N,
+                             viennacl::matrix_base<NumericT, F> const & S)
+      {
+        switch (viennacl::traits::handle(X).get_active_handle_id())
+        {
+          case viennacl::MAIN_MEMORY:
+            viennacl::linalg::host_based::nmf_update_factor(X, N, S);
+            break;
+#ifdef VIENNACL_WITH_OPENCL
+          case viennacl::OPENCL_MEMORY:
+            viennacl::linalg::opencl::nmf_update_factor(X, N, S);
+            break;
+#endif
+#ifdef VIENNACL_WITH_CUDA
+          case viennacl::CUDA_MEMORY:
+            viennacl::linalg::cuda::nmf_update_factor(X, N, S);
+            break;
+#endif
+          case viennacl::MEMORY_NOT_INITIALIZED:
+            throw memory_exception("not initialised!");
+          default:
+            throw memory_exception("not implemented");
+        }
+      }
 
-      assert(V.size1() == W.size1() && V.size2() == H.size2() && bool("Dimensions of W and H don't allow for V = W * H"));
-      assert(W.size2() == H.size1() && bool("Dimensions of W and H don't match, prod(W, H) impossible"));
+      /** @brief Returns sum_ij A_ij * B_ij for two small (k x k) matrices of identical layout. Accumulation is carried out on the host in double precision. */
+      template <typename NumericT, typename F>
+      double nmf_small_inner_prod(viennacl::matrix_base<NumericT, F> const & A,
+                                  viennacl::matrix_base<NumericT, F> const & B)
+      {
+        assert(A.internal_size() == B.internal_size() && bool("Layout mismatch in NMF residual computation"));
+
+        std::vector<NumericT> host_A(A.internal_size());
+        std::vector<NumericT> host_B(B.internal_size());
+        viennacl::backend::memory_read(A.handle(), 0, sizeof(NumericT) * host_A.size(), &(host_A[0]));
+        viennacl::backend::memory_read(B.handle(), 0, sizeof(NumericT) * host_B.size(), &(host_B[0]));
+
+        // padding entries are zero, so they do not contribute:
+        double result = 0;
+        for (std::size_t i=0; i<host_A.size(); ++i)
+          result += static_cast<double>(host_A[i]) * static_cast<double>(host_B[i]);
+        return result;
+      }
 
-      std::size_t k = W.size2();
-      conf.iters_ = 0;
+      /** @brief Returns the trace of a small (k x k) matrix. */
+      template <typename NumericT, typename F>
+      double nmf_small_trace(viennacl::matrix_base<NumericT, F> const & A)
+      {
+        std::vector<NumericT> host_A(A.internal_size());
+        viennacl::backend::memory_read(A.handle(), 0, sizeof(NumericT) * host_A.size(), &(host_A[0]));
 
-      viennacl::matrix<ScalarType> wn(V.size1(), k);
-      viennacl::matrix<ScalarType> wd(V.size1(), k);
-      viennacl::matrix<ScalarType> wtmp(V.size1(), V.size2());
+        double result = 0;
+        for (std::size_t i=0; i<A.size1(); ++i)
+          result += host_A[F::mem_index(i, i, A.internal_size1(), A.internal_size2())];
+        return result;
+      }
 
-      viennacl::matrix<ScalarType> hn(k, V.size2());
-      viennacl::matrix<ScalarType> hd(k, V.size2());
-      viennacl::matrix<ScalarType> htmp(k, k);
+      /** @brief Returns the squared Frobenius norm of a dense matrix */
+      template <typename NumericT, typename F>
+      double nmf_squared_norm(viennacl::matrix_base<NumericT, F> const & V)
+      {
+        NumericT norm_V = 0;
+        viennacl::linalg::norm_frobenius_cpu(V, norm_V);
+        return static_cast<double>(norm_V) * static_cast<double>(norm_V);
+      }
 
-      viennacl::matrix<ScalarType> appr(V.size1(), V.size2());
-      viennacl::vector<ScalarType> diff(V.size1() * V.size2());
+      /** @brief Returns the squared Frobenius norm of a sparse matrix, computed as the squared 2-norm of its array of nonzeros */
+      template <typename NumericT, unsigned int ALIGNMENT>
+      double nmf_squared_norm(viennacl::compressed_matrix<NumericT, ALIGNMENT> const & V)
+      {
+        if (V.nnz() == 0)
+          return 0;
+
+        // V is only read
+        viennacl::backend::mem_handle & elements = const_cast<viennacl::backend::mem_handle &>(V.handle());
+        viennacl::vector_base<NumericT> nonzeros(elements, V.nnz(), 0, 1);
+        NumericT norm_V = 0;
+        viennacl::linalg::norm_2_cpu(nonzeros, norm_V);
+        return static_cast<double>(norm_V) * static_cast<double>(norm_V);
+      }
 
-      ScalarType last_diff = 0;
-      ScalarType diff_init = 0;
-      bool stagnation_flag = false;
+      /** @brief Sets up the transpose of a sparse matrix. The CSR arrays are transposed on the host, Vt must be created in the same memory domain as V. */
+      template <typename NumericT, unsigned int ALIGNMENT>
+      void nmf_transpose(viennacl::compressed_matrix<NumericT, ALIGNMENT> const & V,
+                         viennacl::compressed_matrix<NumericT, ALIGNMENT> & Vt)
+      {
+        std::size_t rows = V.size1();
+        std::size_t cols = V.size2();
+        std::size_t nnz  = V.nnz();
+        if (nnz == 0)
+          return;
+
+        viennacl::backend::typesafe_host_array<unsigned int> row_buffer(V.handle1(), rows + 1);
+        viennacl::backend::typesafe_host_array<unsigned int> col_buffer(V.handle2(), nnz);
+        std::vector<NumericT> elements(nnz);
+
+        viennacl::backend::memory_read(V.handle1(), 0, row_buffer.raw_size(), row_buffer.get());
+        viennacl::backend::memory_read(V.handle2(), 0, col_buffer.raw_size(), col_buffer.get());
+        viennacl::backend::memory_read(V.handle(),  0, sizeof(NumericT) * nnz, &(elements[0]));
+
+        // count entries per column of V, i.e. per row of V^T:
+        std::vector<std::size_t> row_jumper_t(cols + 1);
+        for (std::size_t i=0; i<row_buffer[rows]; ++i)
+          ++row_jumper_t[col_buffer[i] + 1];
+        for (std::size_t i=0; i<cols; ++i)
+          row_jumper_t[i+1] += row_jumper_t[i];
+
+        // scatter entries (rows of V are traversed in increasing order, so column indices of V^T end up sorted):
+        std::size_t nnz_t = row_jumper_t[cols];
+        viennacl::backend::typesafe_host_array<unsigned int> row_buffer_t(Vt.handle1(), cols + 1);
+        viennacl::backend::typesafe_host_array<unsigned int> col_buffer_t(Vt.handle2(), nnz_t);
+        std::vector<NumericT> elements_t(nnz_t);
+
+        std::vector<std::size_t> position(row_jumper_t.begin(), row_jumper_t.end() - 1);
+        for (std::size_t row=0; row<rows; ++row)
+        {
+          for (std::size_t i=row_buffer[row]; i<row_buffer[row+1]; ++i)
+          {
+            std::size_t index = position[col_buffer[i]]++;
+            col_buffer_t.set(index, row);
+            elements_t[index] = elements[i];
+          }
+        }
+        for (std::size_t i=0; i<=cols; ++i)
+          row_buffer_t.set(i, row_jumper_t[i]);
 
+        Vt.set(row_buffer_t.get(), col_buffer_t.get(), &(elements_t[0]), cols, rows, nnz_t);
+      }
 
-      for (std::size_t i = 0; i < conf.max_iterations(); i++)
+      /** @brief Implementation of the multiplicative update rules of Lee and Seung.
+      *
+      * Instead of H, its transpose Ht is iterated, so that both factors are updated by the same fused kernel:
+      *   Ht <- Ht .* (V^T W) ./ (Ht (W^T W)),     W <- W .* (V Ht) ./ (W (Ht^T Ht))
+      * The residual is obtained from the k x k Gram matrices via
+      *   ||V - W H||^2 = ||V||^2 - 2 tr(W^T (V H^T)) + tr((W^T W)(H H^T)),
+      * hence the product W * H is never formed.
+      *
+      * @param V       Input matrix
+      * @param Vt      Transpose of the input matrix (an expression for dense V)
+      * @param W       First factor
+      * @param H       Second factor
+      * @param conf    A configuration object holding tolerances and the like
+      * @return        The number of iterations carried out
+      */
+      template <typename MatrixType, typename TransposedMatrixType, typename NumericT, typename F>
+      std::size_t nmf_impl(MatrixType const & V,
+                           TransposedMatrixType const & Vt,
+                           viennacl::matrix_base<NumericT, F> & W,
+                           viennacl::matrix_base<NumericT, F> & H,
+                           nmf_config const & conf)
       {
-        conf.iters_ = i + 1;
-        {
-          hn   = viennacl::linalg::prod(trans(W), V);
-          htmp = viennacl::linalg::prod(trans(W), W);
-          hd   = viennacl::linalg::prod(htmp, H);
+        assert(V.size1() == W.size1() && V.size2() == H.size2() && bool("Dimensions of W and H don't allow for V = W * H"));
+        assert(W.size2() == H.size1() && bool("Dimensions of W and H don't match, prod(W, H) impossible"));
 
-          viennacl::ocl::kernel & mul_div_kernel = ctx.get_kernel(viennacl::linalg::opencl::kernels::nmf<ScalarType>::program_name(), NMF_MUL_DIV_KERNEL);
-          viennacl::ocl::enqueue(mul_div_kernel(H, hn, hd, cl_uint(H.internal_size1() * H.internal_size2())));
-        }
-        {
-          wn   = viennacl::linalg::prod(V, trans(H));
-          wtmp = viennacl::linalg::prod(W, H);
-          wd   = viennacl::linalg::prod(wtmp, trans(H));
+        std::size_t k = W.size2();
+        std::size_t iters = 0;
+        viennacl::context ctx = viennacl::traits::context(W);
 
-          viennacl::ocl::kernel & mul_div_kernel = ctx.get_kernel(viennacl::linalg::opencl::kernels::nmf<ScalarType>::program_name(), NMF_MUL_DIV_KERNEL);
+        viennacl::matrix<NumericT, F> Ht(H.size2(), k, ctx);
+        Ht = trans(H);
 
-          viennacl::ocl::enqueue(mul_div_kernel(W, wn, wd, cl_uint(W.internal_size1() * W.internal_size2())));
-        }
+        viennacl::matrix<NumericT, F> wn(V.size1(), k, ctx);   // V H^T
+        viennacl::matrix<NumericT, F> hn(V.size2(), k, ctx);   // V^T W
+        viennacl::matrix<NumericT, F> WtW(k, k, ctx);
+        viennacl::matrix<NumericT, F> HHt(k, k, ctx);
+        viennacl::matrix<NumericT, F> Wt_wn(k, k, ctx);
 
-        if (i % conf.check_after_steps() == 0)  //check for convergence
-        {
-          appr = viennacl::linalg::prod(W, H);
+        double norm_V_squared = nmf_squared_norm(V);
 
-          appr -= V;
-          ScalarType diff_val = viennacl::linalg::norm_frobenius(appr);
+        double last_diff = 0;
+        double diff_init = 0;
+        bool stagnation_flag = false;
 
-          if (i == 0)
-            diff_init = diff_val;
+        WtW = viennacl::linalg::prod(trans(W), W);
 
-          std::cout << diff_val / diff_init << std::endl;
+        for (std::size_t i = 0; i < conf.max_iterations(); i++)
+        {
+          iters = i + 1;
 
-          // Approximation check
-          if (diff_val / diff_init < conf.tolerance())
-            break;
+          hn  = viennacl::linalg::prod(Vt, W);
+          nmf_update_factor(Ht, hn, WtW);
+
+          wn  = viennacl::linalg::prod(V, Ht);
+          HHt = viennacl::linalg::prod(trans(Ht), Ht);
+          nmf_update_factor(W, wn, HHt);
+
+          WtW = viennacl::linalg::prod(trans(W), W);
 
-          // Stagnation check
-          if (std::fabs(diff_val - last_diff) / (diff_val * conf.check_after_steps()) < conf.stagnation_tolerance()) //avoid situations where convergence stagnates
+          if (i % conf.check_after_steps() == 0)  //check for convergence
           {
-            if (stagnation_flag)       // iteration stagnates (two iterates with no notable progress)
+            Wt_wn = viennacl::linalg::prod(trans(W), wn);
+
+            double cross_term = 2.0 * nmf_small_trace(Wt_wn);
+            double gram_term  = nmf_small_inner_prod(WtW, HHt);
+            double diff_squared = norm_V_squared - cross_term + gram_term;
+            double diff_val = std::sqrt(std::max(diff_squared, 0.0));
+
+            // the terms are computed in working precision, so the cancellation limits the resolvable residual.
+            // Rounding errors accumulate along the inner products of length size1 and size2:
+            double noise_level = std::sqrt(static_cast<double>(V.size1() + V.size2())) * std::numeric_limits<NumericT>::epsilon()
+                                 * (norm_V_squared + std::fabs(cross_term) + gram_term);
+
+            if (i == 0)
+              diff_init = diff_val;
+
+            // Approximation check
+            if (diff_val <= conf.tolerance() * diff_init || diff_squared <= noise_level)
               break;
-            else                       // record stagnation in this iteration
-              stagnation_flag = true;
-          }
-          else                         // good progress in this iteration, so unset stagnation flag
-            stagnation_flag = false;
 
-          // prepare for next iterate:
-          last_diff = diff_val;
+            // Stagnation check
+            if (std::fabs(diff_val - last_diff) < conf.stagnation_tolerance() * diff_val * conf.check_after_steps()) //avoid situations where convergence stagnates
+            {
+              if (stagnation_flag)       // iteration stagnates (two iterates with no notable progress)
+                break;
+              else                       // record stagnation in this iteration
+                stagnation_flag = true;
+            }
+            else                         // good progress in this iteration, so unset stagnation flag
+              stagnation_flag = false;
+
+            // prepare for next iterate:
+            last_diff = diff_val;
+          }
         }
+
+        H = trans(Ht);
+
+        return iters;
       }
+    }
+
 
+    /** @brief The nonnegative matrix factorization (approximation) algorithm as suggested by Lee and Seung. Factorizes a matrix V with nonnegative entries into matrices W and H such that ||V - W*H|| is minimized.
+     *
+     * @param V     Input matrix
+     * @param W     First factor
+     * @param H     Second factor
+     * @param conf  A configuration object holding tolerances and the like
+     */
+    template <typename ScalarType, typename F>
+    void nmf(viennacl::matrix_base<ScalarType, F> const & V,
+             viennacl::matrix_base<ScalarType, F> & W,
+             viennacl::matrix_base<ScalarType, F> & H,
+             nmf_config const & conf)
+    {
+      conf.iters_ = detail::nmf_impl(V, trans(V), W, H, conf);
+    }
+
+    /** @brief The nonnegative matrix factorization (approximation) algorithm as suggested by Lee and Seung for a sparse matrix V.
+     *
+     * The transpose of V is set up once, so that each iteration only requires sparse-matrix times dense-matrix products.
+     *
+     * @param V     Input matrix (sparse)
+     * @param W     First factor
+     * @param H     Second factor
+     * @param conf  A configuration object holding tolerances and the like
+     */
+    template <typename ScalarType, unsigned int ALIGNMENT, typename F>
+    void nmf(viennacl::compressed_matrix<ScalarType, ALIGNMENT> const & V,
+             viennacl::matrix_base<ScalarType, F> & W,
+             viennacl::matrix_base<ScalarType, F> & H,
+             nmf_config const & conf)
+    {
+      viennacl::compressed_matrix<ScalarType, ALIGNMENT> Vt(viennacl::traits::context(V));
+      detail::nmf_transpose(V, Vt);
 
+      conf.iters_ = detail::nmf_impl(V, Vt, W, H, conf);
     }
   }
 }
@@ -0,0 +1,120 @@
+#ifndef VIENNACL_LINALG_OPENCL_BATCHED_OPERATIONS_HPP_
+#define VIENNACL_LINALG_OPENCL_BATCHED_OPERATIONS_HPP_
+
+/* =========================================================================
+   Copyright (c) 2010-2013, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/linalg/opencl/batched_operations.hpp
+    @brief Implementations of batched dense operations on many small matrices using OpenCL.
+*/
+
+#include "viennacl/forwards.h"
+#include "viennacl/ocl/device.hpp"
+#include "viennacl/ocl/handle.hpp"
+#include "viennacl/ocl/kernel.hpp"
+#include "viennacl/traits/start.hpp"
+#include "viennacl/traits/handle.hpp"
+#include "viennacl/linalg/opencl/kernels/batched.hpp"
+
+namespace viennacl
+{
+  namespace linalg
+  {
+    namespace opencl
+    {
+
+      /** @brief Computes C_b = alpha * A_b * B_b + beta * C_b for all matrices of the batch. See viennacl::linalg::host_based::batched_prod() for details. */
+      template <typename NumericT>
+      void batched_prod(NumericT alpha,
+                        vector_base<NumericT> const & A, batch_layout const & layout_A,
+                        vector_base<NumericT> const & B, batch_layout const & layout_B,
+                        NumericT beta,
+                        vector_base<NumericT> & C, batch_layout const & layout_C)
+      {
+        viennacl::ocl::context & ctx = const_cast<viennacl::ocl::context &>(viennacl::traits::opencl_handle(C).context());
+        viennacl::linalg::opencl::kernels::batched<NumericT>::init(ctx);
+
+        viennacl::ocl::kernel & k = ctx.get_kernel(viennacl::linalg::opencl::kernels::batched<NumericT>::program_name(), "gemm");
+        viennacl::ocl::enqueue(k(alpha,
+                                 viennacl::traits::opencl_handle(A), cl_uint(viennacl::traits::start(A) + layout_A.start()),
+                                 cl_uint(layout_A.stride1()), cl_uint(layout_A.stride2()), cl_uint(layout_A.batch_stride()),
+                                 viennacl::traits::opencl_handle(B), cl_uint(viennacl::traits::start(B) + layout_B.start()),
+                                 cl_uint(layout_B.stride1()), cl_uint(layout_B.stride2()), cl_uint(layout_B.batch_stride()),
+                                 beta,
+                                 viennacl::traits::opencl_handle(C), cl_uint(viennacl::traits::start(C) + layout_C.start()),
+                                 cl_uint(layout_C.stride1()), cl_uint(layout_C.stride2()), cl_uint(layout_C.batch_stride()),
+                                 cl_uint(layout_C.size1()), cl_uint(layout_C.size2()), cl_uint(layout_A.size2()),
+                                 cl_uint(layout_C.batch_count())));
+      }
+
+      /** @brief Solves A_b X_b = B_b in place of B_b for all matrices of the batch, where A_b is triangular. See viennacl::linalg::host_based::batched_inplace_solve() for details. */
+      template <typename NumericT>
+      void batched_inplace_solve(vector_base<NumericT> const & A, batch_layout const & layout_A,
+                                 vector_base<NumericT> & B, batch_layout const & layout_B,
+                                 bool lower, bool unit_diagonal)
+      {
+        viennacl::ocl::context & ctx = const_cast<viennacl::ocl::context &>(viennacl::traits::opencl_handle(B).context());
+        viennacl::linalg::opencl::kernels::batched<NumericT>::init(ctx);
+
+        viennacl::ocl::kernel & k = ctx.get_kernel(viennacl::linalg::opencl::kernels::batched<NumericT>::program_name(), "trsm");
+        viennacl::ocl::enqueue(k(viennacl::traits::opencl_handle(A), cl_uint(viennacl::traits::start(A) + layout_A.start()),
+                                 cl_uint(layout_A.stride1()), cl_uint(layout_A.stride2()), cl_uint(layout_A.batch_stride()),
+                                 viennacl::traits::opencl_handle(B), cl_uint(viennacl::traits::start(B) + layout_B.start()),
+                                 cl_uint(layout_B.stride1()), cl_uint(layout_B.stride2()), cl_uint(layout_B.batch_stride()),
+                                 cl_uint(layout_B.size1()), cl_uint(layout_B.size2()), cl_uint(layout_B.batch_count()),
+                                 cl_uint(lower ? 1 : 0), cl_uint(unit_diagonal ? 1 : 0)));
+      }
+
+      /** @brief LU factorization with partial pivoting of all matrices of the batch in place. See viennacl::linalg::host_based::batched_lu_factorize() for details. */
+      template <typename NumericT>
+      void batched_lu_factorize(vector_base<NumericT> & A, batch_layout const & layout_A,
+                                vector_base<unsigned int> & pivots)
+      {
+        viennacl::ocl::context & ctx = const_cast<viennacl::ocl::context &>(viennacl::traits::opencl_handle(A).context());
+        viennacl::linalg::opencl::kernels::batched<NumericT>::init(ctx);
+
+        viennacl::ocl::kernel & k = ctx.get_kernel(viennacl::linalg::opencl::kernels::batched<NumericT>::program_name(), "getrf");
+        viennacl::ocl::enqueue(k(viennacl::traits::opencl_handle(A), cl_uint(viennacl::traits::start(A) + layout_A.start()),
+                                 cl_uint(layout_A.stride1()), cl_uint(layout_A.stride2()), cl_uint(layout_A.batch_stride()),
+                                 viennacl::traits::opencl_handle(pivots), cl_uint(viennacl::traits::start(pivots)),
+                                 cl_uint(layout_A.size1()), cl_uint(layout_A.batch_count())));
+      }
+
+      /** @brief Solves A_b X_b = B_b in place of B_b for all matrices of the batch, where A_b is given by its LU factors. See viennacl::linalg::host_based::batched_lu_substitute() for details. */
+      template <typename NumericT>
+      void batched_lu_substitute(vector_base<NumericT> const & LU, batch_layout const & layout_LU,
+                                 vector_base<unsigned int> const & pivots,
+                                 vector_base<NumericT> & B, batch_layout const & layout_B)
+      {
+        viennacl::ocl::context & ctx = const_cast<viennacl::ocl::context &>(viennacl::traits::opencl_handle(B).context());
+        viennacl::linalg::opencl::kernels::batched<NumericT>::init(ctx);
+
+        viennacl::ocl::kernel & k = ctx.get_kernel(viennacl::linalg::opencl::kernels::batched<NumericT>::program_name(), "getrs");
+        viennacl::ocl::enqueue(k(viennacl::traits::opencl_handle(LU), cl_uint(viennacl::traits::start(LU) + layout_LU.start()),
+                                 cl_uint(layout_LU.stride1()), cl_uint(layout_LU.stride2()), cl_uint(layout_LU.batch_stride()),
+                                 viennacl::traits::opencl_handle(pivots), cl_uint(viennacl::traits::start(pivots)),
+                                 viennacl::traits::opencl_handle(B), cl_uint(viennacl::traits::start(B) + layout_B.start()),
+                                 cl_uint(layout_B.stride1()), cl_uint(layout_B.stride2()), cl_uint(layout_B.batch_stride()),
+                                 cl_uint(layout_LU.size1()), cl_uint(layout_B.size2()), cl_uint(layout_B.batch_count())));
+      }
+
+    } // namespace opencl
+  } //namespace linalg
+} //namespace viennacl
+
+
+#endif
@@ -0,0 +1,236 @@
+#ifndef VIENNACL_LINALG_OPENCL_KERNELS_BATCHED_HPP
+#define VIENNACL_LINALG_OPENCL_KERNELS_BATCHED_HPP
+
+#include "viennacl/tools/tools.hpp"
+#include "viennacl/ocl/kernel.hpp"
+#include "viennacl/ocl/platform.hpp"
+#include "viennacl/ocl/utils.hpp"
+
+/** @file viennacl/linalg/opencl/kernels/batched.hpp
+ *  @brief OpenCL kernel file for batched operations on many small dense matrices */
+namespace viennacl
+{
+  namespace linalg
+  {
+    namespace opencl
+    {
+      namespace kernels
+      {
+
+        template <typename StringType>
+        void generate_batched_layout_args(StringType & source, std::string const & numeric_string, std::string const & name, bool is_const)
+        {
+          source.append("          __global "); if (is_const) source.append("const "); source.append(numeric_string); source.append(" * "); source.append(name); source.append(", \n");
+          source.append("          unsigned int "); source.append(name); source.append("_start, \n");
+          source.append("          unsigned int "); source.append(name); source.append("_stride1, \n");
+          source.append("          unsigned int "); source.append(name); source.append("_stride2, \n");
+          source.append("          unsigned int "); source.append(name); source.append("_batch_stride, \n");
+        }
+
+        // C = alpha * A * B + beta * C, one work item per entry of C. Consecutive work items cover consecutive matrices, so a work group processes many small matrices.
+        template <typename StringType>
+        void generate_batched_gemm(StringType & source, std::string const & numeric_string)
+        {
+          source.append("__kernel void gemm( \n");
+          source.append("          "); source.append(numeric_string); source.append(" alpha, \n");
+          generate_batched_layout_args(source, numeric_string, "A", true);
+          generate_batched_layout_args(source, numeric_string, "B", true);
+          source.append("          "); source.append(numeric_string); source.append(" beta, \n");
+          generate_batched_layout_args(source, numeric_string, "C", false);
+          source.append("          unsigned int size1, \n");
+          source.append("          unsigned int size2, \n");
+          source.append("          unsigned int size_k, \n");
+          source.append("          unsigned int batch_count) \n");
+          source.append("{ \n");
+          source.append("  unsigned int entries = size1 * size2; \n");
+          source.append("  for (unsigned int idx = get_global_id(0); idx < batch_count * entries; idx += get_global_size(0)) \n");
+          source.append("  { \n");
+          source.append("    unsigned int b   = idx / entries; \n");
+          source.append("    unsigned int row = (idx % entries) / size2; \n");
+          source.append("    unsigned int col = idx % size2; \n");
+          source.append("    __global const "); source.append(numeric_string); source.append(" * A_row = A + A_start + b * A_batch_stride + row * A_stride1; \n");
+          source.append("    __global const "); source.append(numeric_string); source.append(" * B_col = B + B_start + b * B_batch_stride + col * B_stride2; \n");
+          source.append("    "); source.append(numeric_string); source.append(" sum = 0; \n");
+          source.append("    for (unsigned int k = 0; k < size_k; ++k) \n");
+          source.append("      sum += A_row[k * A_stride2] * B_col[k * B_stride1]; \n");
+          source.append("    unsigned int index_C = C_start + b * C_batch_stride + row * C_stride1 + col * C_stride2; \n");
+          source.append("    C[index_C] = (beta != 0) ? alpha * sum + beta * C[index_C] : alpha * sum; \n");
+          source.append("  } \n");
+          source.append("} \n");
+        }
+
+        // A X = B for triangular A, one work item per column of B
+        template <typename StringType>
+        void generate_batched_trsm(StringType & source, std::string const & numeric_string)
+        {
+          source.append("__kernel void trsm( \n");
+          generate_batched_layout_args(source, numeric_string, "A", true);
+          generate_batched_layout_args(source, numeric_string, "B", false);
+          source.append("          unsigned int size1, \n");
+          source.append("          unsigned int size2, \n");
+          source.append("          unsigned int batch_count, \n");
+          source.append("          unsigned int lower, \n");
+          source.append("          unsigned int unit_diagonal) \n");
+          source.append("{ \n");
+          source.append("  for (unsigned int idx = get_global_id(0); idx < batch_count * size2; idx += get_global_size(0)) \n");
+          source.append("  { \n");
+          source.append("    unsigned int b   = idx / size2; \n");
+          source.append("    unsigned int col = idx % size2; \n");
+          source.append("    __global const "); source.append(numeric_string); source.append(" * A_b = A + A_start + b * A_batch_stride; \n");
+          source.append("    __global "); source.append(numeric_string); source.append(" * B_col = B + B_start + b * B_batch_stride + col * B_stride2; \n");
+          source.append("    for (unsigned int ii = 0; ii < size1; ++ii) \n");
+          source.append("    { \n");
+          source.append("      unsigned int i = lower ? ii : size1 - ii - 1; \n");
+          source.append("      unsigned int p_begin = lower ? 0 : i + 1; \n");
+          source.append("      unsigned int p_end   = lower ? i : size1; \n");
+          source.append("      "); source.append(numeric_string); source.append(" sum = B_col[i * B_stride1]; \n");
+          source.append("      for (unsigned int p = p_begin; p < p_end; ++p) \n");
+          source.append("        sum -= A_b[i * A_stride1 + p * A_stride2] * B_col[p * B_stride1]; \n");
+          source.append("      if (!unit_diagonal) \n");
+          source.append("        sum /= A_b[i * A_stride1 + i * A_stride2]; \n");
+          source.append("      B_col[i * B_stride1] = sum; \n");
+          source.append("    } \n");
+          source.append("  } \n");
+          source.append("} \n");
+        }
+
+        // LU factorization with partial pivoting, one work item per matrix
+        template <typename StringType>
+        void generate_batched_getrf(StringType & source, std::string const & numeric_string)
+        {
+          source.append("__kernel void getrf( \n");
+          generate_batched_layout_args(source, numeric_string, "A", false);
+          source.append("          __global unsigned int * pivots, \n");
+          source.append("          unsigned int pivots_start, \n");
+          source.append("          unsigned int size, \n");
+          source.append("          unsigned int batch_count) \n");
+          source.append("{ \n");
+          source.append("  for (unsigned int b = get_global_id(0); b < batch_count; b += get_global_size(0)) \n");
+          source.append("  { \n");
+          source.append("    __global "); source.append(numeric_string); source.append(" * A_b = A + A_start + b * A_batch_stride; \n");
+          source.append("    __global unsigned int * pivots_b = pivots + pivots_start + b * size; \n");
+          source.append("    for (unsigned int j = 0; j < size; ++j) \n");
+          source.append("    { \n");
+          source.append("      unsigned int pivot_row = j; \n");
+          source.append("      "); source.append(numeric_string); source.append(" pivot_abs = fabs(A_b[j * A_stride1 + j * A_stride2]); \n");
+          source.append("      for (unsigned int i = j + 1; i < size; ++i) \n");
+          source.append("      { \n");
+          source.append("        "); source.append(numeric_string); source.append(" val_abs = fabs(A_b[i * A_stride1 + j * A_stride2]); \n");
+          source.append("        if (val_abs > pivot_abs) { pivot_abs = val_abs; pivot_row = i; } \n");
+          source.append("      } \n");
+          source.append("      pivots_b[j] = pivot_row; \n");
+          source.append("      if (pivot_row != j) \n");
+          source.append("        for (unsigned int c = 0; c < size; ++c) \n");
+          source.append("        { \n");
+          source.append("          "); source.append(numeric_string); source.append(" tmp = A_b[j * A_stride1 + c * A_stride2]; \n");
+          source.append("          A_b[j * A_stride1 + c * A_stride2] = A_b[pivot_row * A_stride1 + c * A_stride2]; \n");
+          source.append("          A_b[pivot_row * A_stride1 + c * A_stride2] = tmp; \n");
+          source.append("        } \n");
+          source.append("      "); source.append(numeric_string); source.append(" diag = A_b[j * A_stride1 + j * A_stride2]; \n");
+          source.append("      if (diag == 0) \n");
+          source.append("        continue; \n");
+          source.append("      for (unsigned int i = j + 1; i < size; ++i) \n");
+          source.append("      { \n");
+          source.append("        "); source.append(numeric_string); source.append(" factor = A_b[i * A_stride1 + j * A_stride2] / diag; \n");
+          source.append("        A_b[i * A_stride1 + j * A_stride2] = factor; \n");
+          source.append("        for (unsigned int c = j + 1; c < size; ++c) \n");
+          source.append("          A_b[i * A_stride1 + c * A_stride2] -= factor * A_b[j * A_stride1 + c * A_stride2]; \n");
+          source.append("      } \n");
+          source.append("    } \n");
+          source.append("  } \n");
+          source.append("} \n");
+        }
+
+        // A X = B with A given by its LU factors and pivots, one work item per column of B
+        template <typename StringType>
+        void generate_batched_getrs(StringType & source, std::string const & numeric_string)
+        {
+          source.append("__kernel void getrs( \n");
+          generate_batched_layout_args(source, numeric_string, "LU", true);
+          source.append("          __global const unsigned int * pivots, \n");
+          source.append("          unsigned int pivots_start, \n");
+          generate_batched_layout_args(source, numeric_string, "B", false);
+          source.append("          unsigned int size, \n");
+          source.append("          unsigned int num_rhs, \n");
+          source.append("          unsigned int batch_count) \n");
+          source.append("{ \n");
+          source.append("  for (unsigned int idx = get_global_id(0); idx < batch_count * num_rhs; idx += get_global_size(0)) \n");
+          source.append("  { \n");
+          source.append("    unsigned int b   = idx / num_rhs; \n");
+          source.append("    unsigned int col = idx % num_rhs; \n");
+          source.append("    __global const "); source.append(numeric_string); source.append(" * LU_b = LU + LU_start + b * LU_batch_stride; \n");
+          source.append("    __global const unsigned int * pivots_b = pivots + pivots_start + b * size; \n");
+          source.append("    __global "); source.append(numeric_string); source.append(" * B_col = B + B_start + b * B_batch_stride + col * B_stride2; \n");
+          source.append("    for (unsigned int i = 0; i < size; ++i) \n");
+          source.append("      if (pivots_b[i] != i) \n");
+          source.append("      { \n");
+          source.append("        "); source.append(numeric_string); source.append(" tmp = B_col[i * B_stride1]; \n");
+          source.append("        B_col[i * B_stride1] = B_col[pivots_b[i] * B_stride1]; \n");
+          source.append("        B_col[pivots_b[i] * B_stride1] = tmp; \n");
+          source.append("      } \n");
+          source.append("    for (unsigned int i = 0; i < size; ++i) \n");
+          source.append("    { \n");
+          source.append("      "); source.append(numeric_string); source.append(" sum = B_col[i * B_stride1]; \n");
+          source.append("      for (unsigned int p = 0; p < i; ++p) \n");
+          source.append("        sum -= LU_b[i * LU_stride1 + p * LU_stride2] * B_col[p * B_stride1]; \n");
+          source.append("      B_col[i * B_stride1] = sum; \n");
+          source.append("    } \n");
+          source.append("    for (unsigned int ii = 0; ii < size; ++ii) \n");
+          source.append("    { \n");
+          source.append("      unsigned int i = size - ii - 1; \n");
+          source.append("      "); source.append(numeric_string); source.append(" sum = B_col[i * B_stride1]; \n");
+          source.append("      for (unsigned int p = i + 1; p < size; ++p) \n");
+          source.append("        sum -= LU_b[i * LU_stride1 + p * LU_stride2] * B_col[p * B_stride1]; \n");
+          source.append("      B_col[i * B_stride1] = sum / LU_b[i * LU_stride1 + i * LU_stride2]; \n");
+          source.append("    } \n");
+          source.append("  } \n");
+          source.append("} \n");
+        }
+
+        // main kernel class
+        template <class NumericT>
+        struct batched
+        {
+          static std::string program_name()
+          {
+            return viennacl::ocl::type_to_string<NumericT>::apply() + "_batched";
+          }
+
+          static void init(viennacl::ocl::context & ctx)
+          {
+            viennacl::ocl::DOUBLE_PRECISION_CHECKER<NumericT>::apply(ctx);
+            std::string numeric_string = viennacl::ocl::type_to_string<NumericT>::apply();
+
+            viennacl::ocl::context::program_init_flag & init_flag = ctx.program_init(program_name());
+            viennacl::tools::scoped_lock init_lock(init_flag.mutex);
+            if (!init_flag.done)
+            {
+              std::string source;
+              source.reserve(16384);
+
+              viennacl::ocl::append_double_precision_pragma<NumericT>(ctx, source);
+
+              // only generate for floating points (forces error for integers)
+              if (numeric_string == "float" || numeric_string == "double")
+              {
+                generate_batched_gemm(source, numeric_string);
+                generate_batched_trsm(source, numeric_string);
+                generate_batched_getrf(source, numeric_string);
+                generate_batched_getrs(source, numeric_string);
+              }
+
+              std::string prog_name = program_name();
+              #ifdef VIENNACL_BUILD_INFO
+              std::cout << "Creating program " << prog_name << std::endl;
+              #endif
+              ctx.add_program(source, prog_name);
+              init_flag.done = true;
+            } //if
+          } //init
+        };
+
+      }  // namespace kernels
+    }  // namespace opencl
+  }  // namespace linalg
+}  // namespace viennacl
+#endif
@@ -943,6 +943,37 @@ namespace viennacl
 
         }
 
+        template <typename StringType>
+        void generate_compressed_matrix_vec_mul_scaled(StringType & source, std::string const & numeric_string)
+        {
+
+          source.append("__kernel void vec_mul_scaled( \n");
+          source.append("          __global const unsigned int * row_indices, \n");
+          source.append("          __global const unsigned int * column_indices, \n");
+          source.append("          __global const "); source.append(numeric_string); source.append(" * elements, \n");
+          source.append("          __global const "); source.append(numeric_string); source.append(" * scaling, \n");
+          source.append("          unsigned int symmetric, \n");
+          source.append("          __global const "); source.append(numeric_string); source.append(" * x, \n");
+          source.append("          uint4 layout_x, \n");
+          source.append("          __global "); source.append(numeric_string); source.append(" * result, \n");
+          source.append("          uint4 layout_result) \n");
+          source.append("{ \n");
+          source.append("  for (unsigned int row = get_global_id(0); row < layout_result.z; row += get_global_size(0)) \n");
+          source.append("  { \n");
+          source.append("    "); source.append(numeric_string); source.append(" dot_prod = 0; \n");
+          source.append("    unsigned int row_end = row_indices[row+1]; \n");
+          source.append("    if (symmetric) \n");
+          source.append("      for (unsigned int i = row_indices[row]; i < row_end; ++i) \n");
+          source.append("        dot_prod += elements[i] * scaling[column_indices[i]] * x[column_indices[i] * layout_x.y + layout_x.x]; \n");
+          source.append("    else \n");
+          source.append("      for (unsigned int i = row_indices[row]; i < row_end; ++i) \n");
+          source.append("        dot_prod += elements[i] * x[column_indices[i] * layout_x.y + layout_x.x]; \n");
+          source.append("    result[row * layout_result.y + layout_result.x] = scaling[row] * dot_prod; \n");
+          source.append("  } \n");
+          source.append("} \n");
+
+        }
+
         template <typename StringType>
         void generate_compressed_matrix_vec_mul4(StringType & source, std::string const & numeric_string)
         {
@@ -1073,8 +1104,9 @@ namespace viennacl
             viennacl::ocl::DOUBLE_PRECISION_CHECKER<NumericT>::apply(ctx);
             std::string numeric_string = viennacl::ocl::type_to_string<NumericT>::apply();
 
-            static std::map<cl_context, bool> init_done;
-            if (!init_done[ctx.handle().get()])
+            viennacl::ocl::context::program_init_flag & init_flag = ctx.program_init(program_name());
+            viennacl::tools::scoped_lock init_lock(init_flag.mutex);
+            if (!init_flag.done)
             {
               std::string source;
               source.reserve(1024);
@@ -1102,6 +1134,7 @@ namespace viennacl
               generate_compressed_matrix_vec_mul(source, numeric_string);
               generate_compressed_matrix_vec_mul4(source, numeric_string);
               generate_compressed_matrix_vec_mul8(source, numeric_string);
+              generate_compressed_matrix_vec_mul_scaled(source, numeric_string);
               generate_compressed_matrix_vec_mul_cpu(source, numeric_string);
 
               std::string prog_name = program_name();
@@ -1109,7 +1142,7 @@ namespace viennacl
               std::cout << "Creating program " << prog_name << std::endl;
               #endif
               ctx.add_program(source, prog_name);
-              init_done[ctx.handle().get()] = true;
+              init_flag.done = true;
             } //if
           } //init
         };
@@ -233,8 +233,9 @@ namespace viennacl
             viennacl::ocl::DOUBLE_PRECISION_CHECKER<NumericT>::apply(ctx);
             std::string numeric_string = viennacl::ocl::type_to_string<NumericT>::apply();
 
-            static std::map<cl_context, bool> init_done;
-            if (!init_done[ctx.handle().get()])
+            viennacl::ocl::context::program_init_flag & init_flag = ctx.program_init(program_name());
+            viennacl::tools::scoped_lock init_lock(init_flag.mutex);
+            if (!init_flag.done)
             {
               std::string source;
               source.reserve(1024);
@@ -248,7 +249,7 @@ namespace viennacl
               std::cout << "Creating program " << prog_name << std::endl;
               #endif
               ctx.add_program(source, prog_name);
-              init_done[ctx.handle().get()] = true;
+              init_flag.done = true;
             } //if
           } //init
         };
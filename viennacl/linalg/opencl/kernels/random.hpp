@@ -0,0 +1,204 @@
+#ifndef VIENNACL_LINALG_OPENCL_KERNELS_RANDOM_HPP
+#define VIENNACL_LINALG_OPENCL_KERNELS_RANDOM_HPP
+
+#include "viennacl/tools/tools.hpp"
+#include "viennacl/ocl/kernel.hpp"
+#include "viennacl/ocl/platform.hpp"
+#include "viennacl/ocl/utils.hpp"
+
+/** @file viennacl/linalg/opencl/kernels/random.hpp
+ *  @brief OpenCL kernel file for filling vectors and matrices with random numbers from the Philox4x32-10 generator. See viennacl/rand/utils.hpp for the mapping of counters to values. */
+namespace viennacl
+{
+  namespace linalg
+  {
+    namespace opencl
+    {
+      namespace kernels
+      {
+
+        template <typename StringType>
+        void generate_random_philox(StringType & source)
+        {
+          source.append("uint4 philox4x32_10(uint4 c, uint2 key) \n");
+          source.append("{ \n");
+          source.append("  for (uint i = 0; i < 10; ++i) \n");
+          source.append("  { \n");
+          source.append("    uint hi0 = mul_hi(0xD2511F53u, c.x); \n");
+          source.append("    uint lo0 = 0xD2511F53u * c.x; \n");
+          source.append("    uint hi1 = mul_hi(0xCD9E8D57u, c.z); \n");
+          source.append("    uint lo1 = 0xCD9E8D57u * c.z; \n");
+          source.append("    c = (uint4)(hi1 ^ c.y ^ key.x, lo1, hi0 ^ c.w ^ key.y, lo0); \n");
+          source.append("    key.x += 0x9E3779B9u; \n");
+          source.append("    key.y += 0xBB67AE85u; \n");
+          source.append("  } \n");
+          source.append("  return c; \n");
+          source.append("} \n");
+
+          // the 64-bit block counter is passed as two 32-bit words:
+          source.append("uint4 philox_block(uint block, uint first_block_lo, uint first_block_hi, uint seed, uint stream_id) \n");
+          source.append("{ \n");
+          source.append("  uint lo = first_block_lo + block; \n");
+          source.append("  uint hi = first_block_hi + ((lo < first_block_lo) ? 1 : 0); \n");
+          source.append("  return philox4x32_10((uint4)(lo, hi, 0, 0), (uint2)(seed, stream_id)); \n");
+          source.append("} \n");
+        }
+
+        template <typename StringType>
+        void generate_random_transformations(StringType & source, std::string const & numeric_string)
+        {
+          source.append(numeric_string); source.append(" random_unit_uniform(uint w) \n");
+          source.append("{ \n");
+          if (numeric_string == "float")
+            source.append("  return (float)(w >> 8) * (1.0f / 16777216.0f); \n");
+          else
+            source.append("  return (double)(w) * (1.0 / 4294967296.0); \n");
+          source.append("} \n");
+
+          // uniform: p0 = a, p1 = b - a
+          source.append("void random_uniform_block(uint4 w, "); source.append(numeric_string); source.append(" p0, ");
+                                                               source.append(numeric_string); source.append(" p1, ");
+                                                               source.append(numeric_string); source.append(" * values) \n");
+          source.append("{ \n");
+          source.append("  values[0] = p0 + p1 * random_unit_uniform(w.x); \n");
+          source.append("  values[1] = p0 + p1 * random_unit_uniform(w.y); \n");
+          source.append("  values[2] = p0 + p1 * random_unit_uniform(w.z); \n");
+          source.append("  values[3] = p0 + p1 * random_unit_uniform(w.w); \n");
+          source.append("} \n");
+
+          // gaussian (Box-Muller on the word pairs (x,y) and (z,w)): p0 = mu, p1 = sigma
+          source.append("void random_gaussian_block(uint4 w, "); source.append(numeric_string); source.append(" p0, ");
+                                                                source.append(numeric_string); source.append(" p1, ");
+                                                                source.append(numeric_string); source.append(" * values) \n");
+          source.append("{ \n");
+          source.append("  "); source.append(numeric_string); source.append(" two_pi = 6.283185307179586476925286766559"); source.append(numeric_string == "float" ? "f; \n" : "; \n");
+          source.append("  "); source.append(numeric_string); source.append(" r  = sqrt(-2 * log(1 - random_unit_uniform(w.x))); \n");
+          source.append("  "); source.append(numeric_string); source.append(" u2 = random_unit_uniform(w.y); \n");
+          source.append("  values[0] = p0 + p1 * r * cos(two_pi * u2); \n");
+          source.append("  values[1] = p0 + p1 * r * sin(two_pi * u2); \n");
+          source.append("  r  = sqrt(-2 * log(1 - random_unit_uniform(w.z))); \n");
+          source.append("  u2 = random_unit_uniform(w.w); \n");
+          source.append("  values[2] = p0 + p1 * r * cos(two_pi * u2); \n");
+          source.append("  values[3] = p0 + p1 * r * sin(two_pi * u2); \n");
+          source.append("} \n");
+        }
+
+        template <typename StringType>
+        void generate_random_vector(StringType & source, std::string const & numeric_string, std::string const & distribution)
+        {
+          source.append("__kernel void random_"); source.append(distribution); source.append("_vector( \n");
+          source.append("          __global "); source.append(numeric_string); source.append(" * vec, \n");
+          source.append("          unsigned int start, \n");
+          source.append("          unsigned int inc, \n");
+          source.append("          unsigned int size, \n");
+          source.append("          unsigned int seed, \n");
+          source.append("          unsigned int stream_id, \n");
+          source.append("          unsigned int first_block_lo, \n");
+          source.append("          unsigned int first_block_hi, \n");
+          source.append("          "); source.append(numeric_string); source.append(" p0, \n");
+          source.append("          "); source.append(numeric_string); source.append(" p1) \n");
+          source.append("{ \n");
+          source.append("  "); source.append(numeric_string); source.append(" values[4]; \n");
+          source.append("  for (unsigned int block = get_global_id(0); block < (size + 3) / 4; block += get_global_size(0)) \n");
+          source.append("  { \n");
+          source.append("    random_"); source.append(distribution); source.append("_block(philox_block(block, first_block_lo, first_block_hi, seed, stream_id), p0, p1, values); \n");
+          source.append("    for (unsigned int j = 0; j < 4; ++j) \n");
+          source.append("      if (4 * block + j < size) \n");
+          source.append("        vec[start + (4 * block + j) * inc] = values[j]; \n");
+          source.append("  } \n");
+          source.append("} \n");
+        }
+
+        template <typename StringType>
+        void generate_random_matrix(StringType & source, std::string const & numeric_string, std::string const & distribution, bool row_major)
+        {
+          source.append("__kernel void random_"); source.append(distribution); source.append(row_major ? "_matrix_row( \n" : "_matrix_col( \n");
+          source.append("          __global "); source.append(numeric_string); source.append(" * A, \n");
+          source.append("          unsigned int A_start1, unsigned int A_start2, \n");
+          source.append("          unsigned int A_inc1,   unsigned int A_inc2, \n");
+          source.append("          unsigned int A_size1,  unsigned int A_size2, \n");
+          source.append("          unsigned int A_internal_size1,  unsigned int A_internal_size2, \n");
+          source.append("          unsigned int seed, \n");
+          source.append("          unsigned int stream_id, \n");
+          source.append("          unsigned int first_block_lo, \n");
+          source.append("          unsigned int first_block_hi, \n");
+          source.append("          "); source.append(numeric_string); source.append(" p0, \n");
+          source.append("          "); source.append(numeric_string); source.append(" p1) \n");
+          source.append("{ \n");
+          source.append("  "); source.append(numeric_string); source.append(" values[4]; \n");
+          source.append("  unsigned int size = A_size1 * A_size2; \n");
+          source.append("  for (unsigned int block = get_global_id(0); block < (size + 3) / 4; block += get_global_size(0)) \n");
+          source.append("  { \n");
+          source.append("    random_"); source.append(distribution); source.append("_block(philox_block(block, first_block_lo, first_block_hi, seed, stream_id), p0, p1, values); \n");
+          source.append("    for (unsigned int j = 0; j < 4; ++j) \n");
+          source.append("    { \n");
+          source.append("      unsigned int index = 4 * block + j; \n");
+          source.append("      if (index < size) \n");
+          source.append("      { \n");
+          source.append("        unsigned int row = index / A_size2; \n");
+          source.append("        unsigned int col = index % A_size2; \n");
+          if (row_major)
+            source.append("        A[(row * A_inc1 + A_start1) * A_internal_size2 + col * A_inc2 + A_start2] = values[j]; \n");
+          else
+            source.append("        A[row * A_inc1 + A_start1 + (col * A_inc2 + A_start2) * A_internal_size1] = values[j]; \n");
+          source.append("      } \n");
+          source.append("    } \n");
+          source.append("  } \n");
+          source.append("} \n");
+        }
+
+        // main kernel class
+        template <class NumericT>
+        struct random
+        {
+          static std::string program_name()
+          {
+            return viennacl::ocl::type_to_string<NumericT>::apply() + "_random";
+          }
+
+          static void init(viennacl::ocl::context & ctx)
+          {
+            viennacl::ocl::DOUBLE_PRECISION_CHECKER<NumericT>::apply(ctx);
+            std::string numeric_string = viennacl::ocl::type_to_string<NumericT>::apply();
+
+            viennacl::ocl::context::program_init_flag & init_flag = ctx.program_init(program_name());
+            viennacl::tools::scoped_lock init_lock(init_flag.mutex);
+            if (!init_flag.done)
+            {
+              std::string source;
+              source.reserve(8192);
+
+              viennacl::ocl::append_double_precision_pragma<NumericT>(ctx, source);
+
+              // no fused multiply-adds, so that uniform values agree with the host backend:
+              source.append("#pragma OPENCL FP_CONTRACT OFF \n");
+
+              // only generate for floating points (forces error for integers)
+              if (numeric_string == "float" || numeric_string == "double")
+              {
+                generate_random_philox(source);
+                generate_random_transformations(source, numeric_string);
+
+                generate_random_vector(source, numeric_string, "uniform");
+                generate_random_vector(source, numeric_string, "gaussian");
+                generate_random_matrix(source, numeric_string, "uniform", true);
+                generate_random_matrix(source, numeric_string, "uniform", false);
+                generate_random_matrix(source, numeric_string, "gaussian", true);
+                generate_random_matrix(source, numeric_string, "gaussian", false);
+              }
+
+              std::string prog_name = program_name();
+              #ifdef VIENNACL_BUILD_INFO
+              std::cout << "Creating program " << prog_name << std::endl;
+              #endif
+              ctx.add_program(source, prog_name);
+              init_flag.done = true;
+            } //if
+          } //init
+        };
+
+      }  // namespace kernels
+    }  // namespace opencl
+  }  // namespace linalg
+}  // namespace viennacl
+#endif
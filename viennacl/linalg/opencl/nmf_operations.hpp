@@ -0,0 +1,76 @@
+#ifndef VIENNACL_LINALG_OPENCL_NMF_OPERATIONS_HPP_
+#define VIENNACL_LINALG_OPENCL_NMF_OPERATIONS_HPP_
+
+/* =========================================================================
+   Copyright (c) 2010-2013, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/linalg/opencl/nmf_operations.hpp
+    @brief Implementations of the multiplicative updates of the nonnegative matrix factorization using OpenCL.
+*/
+
+#include "viennacl/forwards.h"
+#include "viennacl/ocl/device.hpp"
+#include "viennacl/ocl/handle.hpp"
+#include "viennacl/ocl/kernel.hpp"
+#include "viennacl/matrix.hpp"
+#include "viennacl/linalg/prod.hpp"
+#include "viennacl/traits/size.hpp"
+#include "viennacl/traits/handle.hpp"
+#include "viennacl/linalg/opencl/kernels/nmf.hpp"
+
+namespace viennacl
+{
+  namespace linalg
+  {
+    namespace opencl
+    {
+
+      /** @brief Multiplicative Lee-Seung update of a factor: X_ij <- X_ij * N_ij / (X * S)_ij
+      *
+      * The denominator is computed by a dense matrix-matrix product, the multiplication and the division are fused into a single kernel.
+      * X and N must not be proxy objects, since the kernel runs over the full (padded) buffers.
+      *
+      * @param X    The factor to be updated (size m x k)
+      * @param N    The numerator (size m x k)
+      * @param S    The symmetric Gram matrix of the other factor (size k x k)
+      */
+      template <typename NumericT, typename F>
+      void nmf_update_factor(matrix_base<NumericT, F> & X,
+                             matrix_base<NumericT, F> const & N,
+                             matrix_base<NumericT, F> const & S)
+      {
+        viennacl::ocl::context & ctx = const_cast<viennacl::ocl::context &>(viennacl::traits::opencl_handle(X).context());
+        viennacl::linalg::opencl::kernels::nmf<NumericT>::init(ctx);
+
+        assert( (X.internal_size1() == N.internal_size1() && X.internal_size2() == N.internal_size2()) && bool("Layout mismatch of factor and numerator in NMF update"));
+
+        viennacl::matrix<NumericT, F> D(X.size1(), X.size2(), viennacl::traits::context(X));
+        D = viennacl::linalg::prod(X, S);
+
+        viennacl::ocl::kernel & k = ctx.get_kernel(viennacl::linalg::opencl::kernels::nmf<NumericT>::program_name(), "el_wise_mul_div");
+        viennacl::ocl::enqueue(k(viennacl::traits::opencl_handle(X),
+                                 viennacl::traits::opencl_handle(N),
+                                 viennacl::traits::opencl_handle(D),
+                                 cl_uint(X.internal_size1() * X.internal_size2())));
+      }
+
+    } // namespace opencl
+  } //namespace linalg
+} //namespace viennacl
+
+
+#endif
@@ -0,0 +1,124 @@
+#ifndef VIENNACL_LINALG_OPENCL_RANDOM_OPERATIONS_HPP_
+#define VIENNACL_LINALG_OPENCL_RANDOM_OPERATIONS_HPP_
+
+/* =========================================================================
+   Copyright (c) 2010-2013, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/linalg/opencl/random_operations.hpp
+    @brief Fills vectors and matrices with random numbers from the Philox4x32-10 generator using OpenCL.
+*/
+
+#include "viennacl/forwards.h"
+#include "viennacl/ocl/device.hpp"
+#include "viennacl/ocl/handle.hpp"
+#include "viennacl/ocl/kernel.hpp"
+#include "viennacl/traits/size.hpp"
+#include "viennacl/traits/start.hpp"
+#include "viennacl/traits/stride.hpp"
+#include "viennacl/traits/handle.hpp"
+#include "viennacl/rand/utils.hpp"
+#include "viennacl/rand/uniform.hpp"
+#include "viennacl/rand/gaussian.hpp"
+#include "viennacl/linalg/opencl/kernels/random.hpp"
+
+namespace viennacl
+{
+  namespace linalg
+  {
+    namespace opencl
+    {
+      namespace detail
+      {
+        template <typename NumericT>
+        void random_fill(vector_base<NumericT> & vec, std::string const & kernel_name,
+                         unsigned int seed, unsigned int stream_id, std::size_t first_block,
+                         NumericT p0, NumericT p1)
+        {
+          viennacl::ocl::context & ctx = const_cast<viennacl::ocl::context &>(viennacl::traits::opencl_handle(vec).context());
+          viennacl::linalg::opencl::kernels::random<NumericT>::init(ctx);
+
+          viennacl::ocl::kernel & k = ctx.get_kernel(viennacl::linalg::opencl::kernels::random<NumericT>::program_name(), kernel_name);
+          viennacl::ocl::enqueue(k(viennacl::traits::opencl_handle(vec),
+                                   cl_uint(viennacl::traits::start(vec)),
+                                   cl_uint(viennacl::traits::stride(vec)),
+                                   cl_uint(viennacl::traits::size(vec)),
+                                   cl_uint(seed), cl_uint(stream_id),
+                                   cl_uint(viennacl::rand::detail::block_lo(first_block)),
+                                   cl_uint(viennacl::rand::detail::block_hi(first_block)),
+                                   p0, p1));
+        }
+
+        template <typename NumericT, typename F>
+        void random_fill(matrix_base<NumericT, F> & mat, std::string const & kernel_name,
+                         unsigned int seed, unsigned int stream_id, std::size_t first_block,
+                         NumericT p0, NumericT p1)
+        {
+          viennacl::ocl::context & ctx = const_cast<viennacl::ocl::context &>(viennacl::traits::opencl_handle(mat).context());
+          viennacl::linalg::opencl::kernels::random<NumericT>::init(ctx);
+
+          std::string layout = viennacl::is_row_major<F>::value ? "_row" : "_col";
+          viennacl::ocl::kernel & k = ctx.get_kernel(viennacl::linalg::opencl::kernels::random<NumericT>::program_name(), kernel_name + layout);
+          viennacl::ocl::enqueue(k(viennacl::traits::opencl_handle(mat),
+                                   cl_uint(viennacl::traits::start1(mat)),         cl_uint(viennacl::traits::start2(mat)),
+                                   cl_uint(viennacl::traits::stride1(mat)),        cl_uint(viennacl::traits::stride2(mat)),
+                                   cl_uint(viennacl::traits::size1(mat)),          cl_uint(viennacl::traits::size2(mat)),
+                                   cl_uint(viennacl::traits::internal_size1(mat)), cl_uint(viennacl::traits::internal_size2(mat)),
+                                   cl_uint(seed), cl_uint(stream_id),
+                                   cl_uint(viennacl::rand::detail::block_lo(first_block)),
+                                   cl_uint(viennacl::rand::detail::block_hi(first_block)),
+                                   p0, p1));
+        }
+      }
+
+      /** @brief Fills a vector with uniformly distributed random numbers. See viennacl::linalg::host_based::random_fill() for the parameters. */
+      template <typename NumericT>
+      void random_fill(vector_base<NumericT> & vec, viennacl::rand::uniform_tag const & tag,
+                       unsigned int seed, unsigned int stream_id, std::size_t first_block)
+      {
+        detail::random_fill(vec, "random_uniform_vector", seed, stream_id, first_block, NumericT(tag.a), NumericT(tag.b - tag.a));
+      }
+
+      /** @brief Fills a vector with normally distributed random numbers. */
+      template <typename NumericT>
+      void random_fill(vector_base<NumericT> & vec, viennacl::rand::gaussian_tag const & tag,
+                       unsigned int seed, unsigned int stream_id, std::size_t first_block)
+      {
+        detail::random_fill(vec, "random_gaussian_vector", seed, stream_id, first_block, NumericT(tag.mu), NumericT(tag.sigma));
+      }
+
+      /** @brief Fills a matrix with uniformly distributed random numbers. Entry (i,j) obtains the value with logical index i * size2 + j. */
+      template <typename NumericT, typename F>
+      void random_fill(matrix_base<NumericT, F> & mat, viennacl::rand::uniform_tag const & tag,
+                       unsigned int seed, unsigned int stream_id, std::size_t first_block)
+      {
+        detail::random_fill(mat, "random_uniform_matrix", seed, stream_id, first_block, NumericT(tag.a), NumericT(tag.b - tag.a));
+      }
+
+      /** @brief Fills a matrix with normally distributed random numbers. Entry (i,j) obtains the value with logical index i * size2 + j. */
+      template <typename NumericT, typename F>
+      void random_fill(matrix_base<NumericT, F> & mat, viennacl::rand::gaussian_tag const & tag,
+                       unsigned int seed, unsigned int stream_id, std::size_t first_block)
+      {
+        detail::random_fill(mat, "random_gaussian_matrix", seed, stream_id, first_block, NumericT(tag.mu), NumericT(tag.sigma));
+      }
+
+    } // namespace opencl
+  } //namespace linalg
+} //namespace viennacl
+
+
+#endif
@@ -109,6 +109,46 @@ namespace viennacl
       }
 
 
+      /** @brief Carries out matrix-vector multiplication with a diagonally scaled compressed_matrix in a single kernel
+      *
+      * Implementation of the convenience expression result = prod(op, vec), where op represents either D^{-1} A or D^{-1/2} A D^{-1/2}.
+      *
+      * @param op     The scaled operator
+      * @param vec    The vector
+      * @param result The result vector
+      */
+      template<class TYPE, unsigned int ALIGNMENT>
+      void prod_impl(const viennacl::linalg::scaled_operator<viennacl::compressed_matrix<TYPE, ALIGNMENT> > & op,
+                     const viennacl::vector_base<TYPE> & vec,
+                           viennacl::vector_base<TYPE> & result)
+      {
+        viennacl::compressed_matrix<TYPE, ALIGNMENT> const & mat = op.matrix();
+
+        viennacl::ocl::context & ctx = const_cast<viennacl::ocl::context &>(viennacl::traits::opencl_handle(mat).context());
+        viennacl::linalg::opencl::kernels::compressed_matrix<TYPE>::init(ctx);
+        viennacl::ocl::kernel & k = ctx.get_kernel(viennacl::linalg::opencl::kernels::compressed_matrix<TYPE>::program_name(), "vec_mul_scaled");
+
+        viennacl::ocl::packed_cl_uint layout_vec;
+        layout_vec.start  = cl_uint(viennacl::traits::start(vec));
+        layout_vec.stride = cl_uint(viennacl::traits::stride(vec));
+        layout_vec.size   = cl_uint(viennacl::traits::size(vec));
+        layout_vec.internal_size   = cl_uint(viennacl::traits::internal_size(vec));
+
+        viennacl::ocl::packed_cl_uint layout_result;
+        layout_result.start  = cl_uint(viennacl::traits::start(result));
+        layout_result.stride = cl_uint(viennacl::traits::stride(result));
+        layout_result.size   = cl_uint(viennacl::traits::size(result));
+        layout_result.internal_size   = cl_uint(viennacl::traits::internal_size(result));
+
+        viennacl::ocl::enqueue(k(mat.handle1().opencl_handle(), mat.handle2().opencl_handle(), mat.handle().opencl_handle(),
+                                op.scaling().handle().opencl_handle(),
+                                cl_uint(op.type() == viennacl::linalg::DIAGONAL_SCALING_SYMMETRIC ? 1 : 0),
+                                vec, layout_vec,
+                                result, layout_result
+                                ));
+      }
+
+
       /** @brief Carries out sparse_matrix-matrix multiplication first matrix being compressed
       *
       * Implementation of the convenience expression result = prod(sp_mat, d_mat);
@@ -28,6 +28,7 @@
 #include <string>
 #include <algorithm>
 #include <vector>
+#include <cassert>
 #include <math.h>
 #include <cmath>
 #include "boost/numeric/ublas/vector.hpp"
@@ -554,6 +555,227 @@ namespace viennacl
 
 
 
+
+      //
+      // Blocked QR factorization using the compact WY representation I - Y T Y^T of a block of Householder reflectors
+      //
+
+      /** @brief Householder QR factorization of a panel stored in a host buffer. Uses the same storage scheme as inplace_qr(): R in the upper triangle, reflectors below the diagonal.
+      *
+      * @param panel          The panel entries. Entry (i,k) is located at F::mem_index(i, k, internal_rows, internal_cols)
+      * @param rows           Number of rows of the panel
+      * @param cols           Number of columns of the panel
+      * @param internal_rows  Number of rows of the buffer (including padding)
+      * @param internal_cols  Number of columns of the buffer (including padding)
+      * @param betas          Array to which the coefficients of the Householder reflectors are written
+      */
+      template <typename F, typename ScalarType>
+      void inplace_qr_panel_host(std::vector<ScalarType> & panel, std::size_t rows, std::size_t cols,
+                                 std::size_t internal_rows, std::size_t internal_cols, ScalarType * betas)
+      {
+        for (std::size_t k = 0; k < std::min(rows, cols); ++k)
+        {
+          ScalarType A_kk = panel[F::mem_index(k, k, internal_rows, internal_cols)];
+          ScalarType sigma = 0;
+          for (std::size_t i = k+1; i < rows; ++i)
+          {
+            ScalarType A_ik = panel[F::mem_index(i, k, internal_rows, internal_cols)];
+            sigma += A_ik * A_ik;
+          }
+
+          betas[k] = 0;
+          if (sigma == 0)
+            continue;
+
+          ScalarType mu = std::sqrt(sigma + A_kk*A_kk);
+          ScalarType v1 = (A_kk <= 0) ? (A_kk - mu) : (-sigma / (A_kk + mu));
+          ScalarType beta = static_cast<ScalarType>(2.0) * v1 * v1 / (sigma + v1 * v1);
+          betas[k] = beta;
+
+          for (std::size_t i = k+1; i < rows; ++i)
+            panel[F::mem_index(i, k, internal_rows, internal_cols)] /= v1;
+          panel[F::mem_index(k, k, internal_rows, internal_cols)] = mu;
+
+          //apply reflector to remaining columns of the panel:
+          for (std::size_t l = k+1; l < cols; ++l)
+          {
+            ScalarType v_in_col = panel[F::mem_index(k, l, internal_rows, internal_cols)];
+            for (std::size_t i = k+1; i < rows; ++i)
+              v_in_col += panel[F::mem_index(i, k, internal_rows, internal_cols)] * panel[F::mem_index(i, l, internal_rows, internal_cols)];
+
+            v_in_col *= beta;
+            panel[F::mem_index(k, l, internal_rows, internal_cols)] -= v_in_col;
+            for (std::size_t i = k+1; i < rows; ++i)
+              panel[F::mem_index(i, l, internal_rows, internal_cols)] -= v_in_col * panel[F::mem_index(i, k, internal_rows, internal_cols)];
+          }
+        }
+      }
+
+      /** @brief Computes Q B on the host, where Q is given by the Householder reflectors of a panel factorized with inplace_qr_panel_host() and B is a row-major buffer with the same number of rows */
+      template <typename F, typename ScalarType>
+      void inplace_qr_panel_host_apply_Q(std::vector<ScalarType> const & panel, std::size_t rows, std::size_t cols,
+                                         std::size_t internal_rows, std::size_t internal_cols, ScalarType const * betas,
+                                         std::vector<ScalarType> & B, std::size_t B_cols)
+      {
+        for (std::size_t k = std::min(rows, cols); k-- > 0; )
+        {
+          if (betas[k] == 0)
+            continue;
+
+          for (std::size_t l = 0; l < B_cols; ++l)
+          {
+            ScalarType v_in_col = B[k * B_cols + l];
+            for (std::size_t i = k+1; i < rows; ++i)
+              v_in_col += panel[F::mem_index(i, k, internal_rows, internal_cols)] * B[i * B_cols + l];
+
+            v_in_col *= betas[k];
+            B[k * B_cols + l] -= v_in_col;
+            for (std::size_t i = k+1; i < rows; ++i)
+              B[i * B_cols + l] -= v_in_col * panel[F::mem_index(i, k, internal_rows, internal_cols)];
+          }
+        }
+      }
+
+      /** @brief Sets up the compact WY representation H_j H_{j+1} ... H_{j+k-1} = I - Y T Y^T for k Householder reflectors stored in A starting at column j.
+      *
+      * @param A       The matrix holding the Householder reflectors below the diagonal
+      * @param betas   The coefficients of all Householder reflectors
+      * @param j       Index of the first reflector
+      * @param k       Number of reflectors
+      * @param Y       Matrix to which the reflectors (rows j to A.size1()) with unit diagonal are written
+      * @param T       Upper triangular k x k matrix
+      */
+      template <typename T, typename F, unsigned int ALIGNMENT, typename VectorType>
+      void inplace_qr_block_reflector(viennacl::matrix<T, F, ALIGNMENT> const & A, VectorType const & betas,
+                                      std::size_t j, std::size_t k,
+                                      viennacl::matrix<T, F, ALIGNMENT> & Y, viennacl::matrix<T, F, ALIGNMENT> & T_matrix)
+      {
+        typedef viennacl::matrix<T, F, ALIGNMENT>   MatrixType;
+
+        Y.resize(A.size1() - j, k, false);
+        Y = viennacl::project(const_cast<MatrixType &>(A), viennacl::range(j, A.size1()), viennacl::range(j, j+k));  // A is only read
+
+        // unit diagonal and zeros above (only k x k entries are transferred):
+        std::vector< std::vector<T> > Y_top(k, std::vector<T>(k));
+        MatrixType vcl_Y_top(k, k, viennacl::traits::context(A));
+        vcl_Y_top = viennacl::project(Y, viennacl::range(0, k), viennacl::range(0, k));
+        viennacl::copy(vcl_Y_top, Y_top);
+        for (std::size_t i = 0; i < k; ++i)
+        {
+          Y_top[i][i] = 1;
+          for (std::size_t l = i+1; l < k; ++l)
+            Y_top[i][l] = 0;
+        }
+        viennacl::copy(Y_top, vcl_Y_top);
+        viennacl::project(Y, viennacl::range(0, k), viennacl::range(0, k)) = vcl_Y_top;
+
+        // T from the Gram matrix Y^T Y:
+        MatrixType vcl_G(k, k, viennacl::traits::context(A));
+        vcl_G = viennacl::linalg::prod(trans(Y), Y);
+        std::vector< std::vector<T> > G(k, std::vector<T>(k));
+        viennacl::copy(vcl_G, G);
+
+        std::vector< std::vector<T> > host_T(k, std::vector<T>(k));
+        for (std::size_t i = 0; i < k; ++i)
+        {
+          T beta = betas[j+i];
+          host_T[i][i] = beta;
+          for (std::size_t r = 0; r < i; ++r)   // T(0:i, i) = -beta_i T(0:i, 0:i) Y(:, 0:i)^T y_i
+          {
+            T temp = 0;
+            for (std::size_t l = r; l < i; ++l)
+              temp += host_T[r][l] * G[l][i];
+            host_T[r][i] = -beta * temp;
+          }
+        }
+
+        T_matrix.resize(k, k, false);
+        viennacl::copy(host_T, T_matrix);
+      }
+
+      /** @brief Applies a block reflector I - Y T Y^T (or its transpose) to the rows j to B.size1() of B using matrix-matrix products */
+      template <typename T, typename F, unsigned int ALIGNMENT, typename MatrixRangeType>
+      void inplace_qr_apply_block_reflector(viennacl::matrix<T, F, ALIGNMENT> const & Y, viennacl::matrix<T, F, ALIGNMENT> const & T_matrix,
+                                            MatrixRangeType & B, bool transposed)
+      {
+        typedef viennacl::matrix<T, F, ALIGNMENT>   MatrixType;
+
+        MatrixType W = viennacl::linalg::prod(trans(Y), B);
+        MatrixType TW(W.size1(), W.size2(), viennacl::traits::context(Y));
+        if (transposed)
+          TW = viennacl::linalg::prod(trans(T_matrix), W);
+        else
+          TW = viennacl::linalg::prod(T_matrix, W);
+        B -= viennacl::linalg::prod(Y, TW);
+      }
+
+      /** @brief Applies a block reflector I - Y T Y^T (or its transpose) to the entries j to b.size() of a vector b */
+      template <typename T, typename F, unsigned int ALIGNMENT, typename VectorRangeType>
+      void inplace_qr_apply_block_reflector_vector(viennacl::matrix<T, F, ALIGNMENT> const & Y, viennacl::matrix<T, F, ALIGNMENT> const & T_matrix,
+                                                   VectorRangeType & b, bool transposed)
+      {
+        viennacl::vector<T> w = viennacl::linalg::prod(trans(Y), b);
+        viennacl::vector<T> Tw(w.size(), viennacl::traits::context(Y));
+        if (transposed)
+          Tw = viennacl::linalg::prod(trans(T_matrix), w);
+        else
+          Tw = viennacl::linalg::prod(T_matrix, w);
+        b -= viennacl::linalg::prod(Y, Tw);
+      }
+
+      /** @brief Blocked Householder QR factorization of a ViennaCL matrix using the compact WY representation.
+      *
+      * Panels are factorized on the host, while the trailing updates are carried out using three matrix-matrix products per panel in the memory domain of A.
+      *
+      * @param A            A dense ViennaCL matrix to be factored
+      * @param block_size   The block size (panel width) to be used
+      */
+      template<typename T, typename F, unsigned int ALIGNMENT>
+      std::vector<T> inplace_qr_compact_wy(viennacl::matrix<T, F, ALIGNMENT> & A, std::size_t block_size = 16)
+      {
+        typedef viennacl::matrix<T, F, ALIGNMENT>   MatrixType;
+
+        std::size_t m = A.size1();
+        std::size_t n = A.size2();
+        std::vector<T> betas(n);
+
+        MatrixType panel(m, block_size, viennacl::traits::context(A));
+        MatrixType Y(m, block_size, viennacl::traits::context(A));
+        MatrixType T_matrix(block_size, block_size, viennacl::traits::context(A));
+        std::vector<T> host_panel;
+
+        for (std::size_t j = 0; j < std::min(m, n); j += block_size)
+        {
+          std::size_t effective_block_size = std::min(std::min(m, n), j+block_size) - j;
+
+          //
+          // Panel factorization on the host:
+          //
+          panel.resize(m - j, effective_block_size, false);
+          panel = viennacl::project(A, viennacl::range(j, m), viennacl::range(j, j+effective_block_size));
+
+          host_panel.resize(panel.internal_size());
+          viennacl::backend::memory_read(panel.handle(), 0, sizeof(T) * panel.internal_size(), &(host_panel[0]));
+          inplace_qr_panel_host<F>(host_panel, m - j, effective_block_size, panel.internal_size1(), panel.internal_size2(), &(betas[j]));
+          viennacl::backend::memory_write(panel.handle(), 0, sizeof(T) * panel.internal_size(), &(host_panel[0]));
+
+          viennacl::project(A, viennacl::range(j, m), viennacl::range(j, j+effective_block_size)) = panel;
+
+          //
+          // Trailing update A_2 = (I - Y T Y^T)^T A_2:
+          //
+          if (n > j + effective_block_size)
+          {
+            inplace_qr_block_reflector(A, betas, j, effective_block_size, Y, T_matrix);
+
+            viennacl::matrix_range<MatrixType> A_2(A, viennacl::range(j, m), viennacl::range(j+effective_block_size, n));
+            inplace_qr_apply_block_reflector(Y, T_matrix, A_2, true);
+          }
+        }
+
+        return betas;
+      }
+
     } //namespace detail
 
 
@@ -624,21 +846,127 @@ namespace viennacl
       }
     }
 
+    /** @brief Computes Q^T b for a ViennaCL vector b, where Q is an implicit orthogonal matrix defined via its Householder reflectors stored in A.
+     *
+     *  Blocks of reflectors are applied in compact WY form, i.e. using matrix-vector products with all reflectors of a block at once.
+     *
+     *  @param A           A matrix holding the Householder reflectors in the lower triangular part. Typically obtained from calling inplace_qr() on the original matrix
+     *  @param betas       The scalars beta_i for each Householder reflector (I - beta_i v_i v_i^T)
+     *  @param b           The vector b to which the result Q^T b is directly written to
+     *  @param block_size  Number of reflectors applied at once
+     */
     template <typename T, typename F, unsigned int ALIGNMENT, typename VectorType1, unsigned int A2>
-    void inplace_qr_apply_trans_Q(viennacl::matrix<T, F, ALIGNMENT> const & A, VectorType1 const & betas, viennacl::vector<T, A2> & b)
+    void inplace_qr_apply_trans_Q(viennacl::matrix<T, F, ALIGNMENT> const & A, VectorType1 const & betas, viennacl::vector<T, A2> & b, std::size_t block_size = 16)
     {
-      boost::numeric::ublas::matrix<T> ublas_A(A.size1(), A.size2());
-      viennacl::copy(A, ublas_A);
+      viennacl::matrix<T, F, ALIGNMENT> Y(A.size1(), block_size, viennacl::traits::context(A));
+      viennacl::matrix<T, F, ALIGNMENT> T_matrix(block_size, block_size, viennacl::traits::context(A));
 
-      std::vector<T> stl_b(b.size());
-      viennacl::copy(b, stl_b);
+      std::size_t num_reflectors = std::min(A.size1(), A.size2());
+      for (std::size_t j = 0; j < num_reflectors; j += block_size)
+      {
+        std::size_t effective_block_size = std::min(num_reflectors, j+block_size) - j;
+        detail::inplace_qr_block_reflector(A, betas, j, effective_block_size, Y, T_matrix);
 
-      inplace_qr_apply_trans_Q(ublas_A, betas, stl_b);
+        viennacl::vector_range< viennacl::vector<T, A2> > b_j(b, viennacl::range(j, A.size1()));
+        detail::inplace_qr_apply_block_reflector_vector(Y, T_matrix, b_j, true);
+      }
+    }
 
-      viennacl::copy(stl_b, b);
+    /** @brief Computes Q^T B for a ViennaCL matrix B holding multiple right hand sides, where Q is an implicit orthogonal matrix defined via its Householder reflectors stored in A.
+     *
+     *  @param A           A matrix holding the Householder reflectors in the lower triangular part. Typically obtained from calling inplace_qr() on the original matrix
+     *  @param betas       The scalars beta_i for each Householder reflector (I - beta_i v_i v_i^T)
+     *  @param B           The matrix B to which the result Q^T B is directly written to
+     *  @param block_size  Number of reflectors applied at once
+     */
+    template <typename T, typename F, unsigned int ALIGNMENT, typename VectorType1>
+    void inplace_qr_apply_trans_Q(viennacl::matrix<T, F, ALIGNMENT> const & A, VectorType1 const & betas, viennacl::matrix<T, F, ALIGNMENT> & B, std::size_t block_size = 16)
+    {
+      viennacl::matrix<T, F, ALIGNMENT> Y(A.size1(), block_size, viennacl::traits::context(A));
+      viennacl::matrix<T, F, ALIGNMENT> T_matrix(block_size, block_size, viennacl::traits::context(A));
+
+      std::size_t num_reflectors = std::min(A.size1(), A.size2());
+      for (std::size_t j = 0; j < num_reflectors; j += block_size)
+      {
+        std::size_t effective_block_size = std::min(num_reflectors, j+block_size) - j;
+        detail::inplace_qr_block_reflector(A, betas, j, effective_block_size, Y, T_matrix);
+
+        viennacl::matrix_range< viennacl::matrix<T, F, ALIGNMENT> > B_j(B, viennacl::range(j, B.size1()), viennacl::range(0, B.size2()));
+        detail::inplace_qr_apply_block_reflector(Y, T_matrix, B_j, true);
+      }
+    }
+
+    /** @brief Computes Q B for a ViennaCL matrix B, where Q is an implicit orthogonal matrix defined via its Householder reflectors stored in A.
+     *
+     *  @param A           A matrix holding the Householder reflectors in the lower triangular part. Typically obtained from calling inplace_qr() on the original matrix
+     *  @param betas       The scalars beta_i for each Householder reflector (I - beta_i v_i v_i^T)
+     *  @param B           The matrix B to which the result Q B is directly written to
+     *  @param block_size  Number of reflectors applied at once
+     */
+    template <typename T, typename F, unsigned int ALIGNMENT, typename VectorType1>
+    void inplace_qr_apply_Q(viennacl::matrix<T, F, ALIGNMENT> const & A, VectorType1 const & betas, viennacl::matrix<T, F, ALIGNMENT> & B, std::size_t block_size = 16)
+    {
+      viennacl::matrix<T, F, ALIGNMENT> Y(A.size1(), block_size, viennacl::traits::context(A));
+      viennacl::matrix<T, F, ALIGNMENT> T_matrix(block_size, block_size, viennacl::traits::context(A));
+
+      std::size_t num_reflectors = std::min(A.size1(), A.size2());
+      std::size_t num_blocks = (num_reflectors + block_size - 1) / block_size;
+      for (std::size_t block_id = num_blocks; block_id-- > 0; )
+      {
+        std::size_t j = block_id * block_size;
+        std::size_t effective_block_size = std::min(num_reflectors, j+block_size) - j;
+        detail::inplace_qr_block_reflector(A, betas, j, effective_block_size, Y, T_matrix);
+
+        viennacl::matrix_range< viennacl::matrix<T, F, ALIGNMENT> > B_j(B, viennacl::range(j, B.size1()), viennacl::range(0, B.size2()));
+        detail::inplace_qr_apply_block_reflector(Y, T_matrix, B_j, false);
+      }
+    }
+
+    /** @brief Generates Q and R explicitly from an inplace QR factorization of a ViennaCL matrix. Q is obtained by applying the blocks of reflectors to the identity matrix.
+    *
+    * @param A      The inplace QR-factored matrix
+    * @param betas  The coefficients of the Householder reflectors as returned by inplace_qr()
+    * @param Q      The orthogonal matrix. Only the first Q.size2() columns are computed, hence Q may also be set up with A.size2() columns for a thin QR factorization
+    * @param R      The upper triangular matrix
+    */
+    template <typename T, typename F, unsigned int ALIGNMENT, typename VectorType>
+    void recoverQ(viennacl::matrix<T, F, ALIGNMENT> const & A, VectorType const & betas, viennacl::matrix<T, F, ALIGNMENT> & Q, viennacl::matrix<T, F, ALIGNMENT> & R)
+    {
+      //
+      // Recover R from upper-triangular part of A:
+      //
+      std::size_t R_rows = std::min(R.size1(), A.size1());
+      std::vector< std::vector<T> > host_R(R.size1(), std::vector<T>(R.size2()));
+      if (R_rows > 0)
+      {
+        viennacl::matrix<T, F, ALIGNMENT> A_top(R_rows, R.size2(), viennacl::traits::context(A));
+        A_top = viennacl::project(const_cast<viennacl::matrix<T, F, ALIGNMENT> &>(A), viennacl::range(0, R_rows), viennacl::range(0, R.size2()));  // A is only read
+        std::vector< std::vector<T> > host_A_top(R_rows, std::vector<T>(R.size2()));
+        viennacl::copy(A_top, host_A_top);
+        for (std::size_t i=0; i<R_rows; ++i)
+          for (std::size_t j=i; j<R.size2(); ++j)
+            host_R[i][j] = host_A_top[i][j];
+      }
+      viennacl::copy(host_R, R);
+
+      //
+      // Recover Q by applying all the Householder reflectors to the identity matrix:
+      //
+      std::size_t Q_diag = std::min(Q.size1(), Q.size2());
+      Q.clear();
+      if (Q_diag > 0)
+      {
+        viennacl::matrix<T, F, ALIGNMENT> I = viennacl::identity_matrix<T>(Q_diag, viennacl::traits::context(Q));
+        viennacl::project(Q, viennacl::range(0, Q_diag), viennacl::range(0, Q_diag)) = I;
+      }
+
+      inplace_qr_apply_Q(A, betas, Q);
     }
 
     /** @brief Overload of inplace-QR factorization of a ViennaCL matrix A
+     *
+     * Uses a blocked Householder QR factorization with the compact WY representation of blocks of reflectors:
+     * Panels are factorized on the host, the trailing updates are carried out with matrix-matrix products in the memory domain of A.
      *
      * @param A            A dense ViennaCL matrix to be factored
      * @param block_size   The block size to be used.
@@ -646,7 +974,108 @@ namespace viennacl
     template<typename T, typename F, unsigned int ALIGNMENT>
     std::vector<T> inplace_qr(viennacl::matrix<T, F, ALIGNMENT> & A, std::size_t block_size = 16)
     {
-      return detail::inplace_qr_hybrid(A, block_size);
+      return detail::inplace_qr_compact_wy(A, block_size);
+    }
+
+    /** @brief Computes the thin QR factorization A = Q R of a tall and skinny matrix using TSQR (communication-avoiding QR).
+     *
+     * The rows of A are split into chunks, each of which is factorized independently with the blocked Householder QR. The stacked triangular
+     * factors of all chunks are factorized on the host, and the orthogonal factors of the chunks are combined by matrix-matrix products.
+     * Compared to inplace_qr(), the panel factorizations only operate on chunks, which considerably reduces the amount of data transferred and touched per panel.
+     *
+     * @param A            The matrix to be factored. Must have at least as many rows as columns
+     * @param Q            Matrix with orthonormal columns of the same size as A (output)
+     * @param R            Upper triangular square matrix with A.size2() rows and columns (output)
+     * @param chunk_size   Number of rows per chunk. Zero selects a default of max(4 * A.size2(), 1024) rows
+     * @param block_size   The block size used for the factorization of each chunk
+     */
+    template<typename T, typename F, unsigned int ALIGNMENT>
+    void tsqr(viennacl::matrix<T, F, ALIGNMENT> const & A, viennacl::matrix<T, F, ALIGNMENT> & Q, viennacl::matrix<T, F, ALIGNMENT> & R,
+              std::size_t chunk_size = 0, std::size_t block_size = 16)
+    {
+      typedef viennacl::matrix<T, F, ALIGNMENT>   MatrixType;
+
+      std::size_t m = A.size1();
+      std::size_t n = A.size2();
+      assert(m >= n && bool("TSQR requires at least as many rows as columns"));
+
+      if (chunk_size == 0)
+        chunk_size = std::max<std::size_t>(4 * n, 1024);
+      chunk_size = std::max(chunk_size, n);
+
+      // chunk boundaries (the last chunk absorbs a remainder with less than chunk_size rows):
+      std::vector<std::size_t> chunk_start;
+      for (std::size_t i = 0; i + chunk_size <= m || chunk_start.size() == 0; i += chunk_size)
+        chunk_start.push_back(i);
+      chunk_start.push_back(m);
+      std::size_t num_chunks = chunk_start.size() - 1;
+
+      Q.resize(m, n, false);
+      R.resize(n, n, false);
+
+      //
+      // Step 1: Factorize chunks, keep their reflectors in Q and stack their triangular factors on the host:
+      //
+      std::vector< std::vector<T> > chunk_betas(num_chunks);
+      std::vector<T> stacked_R(num_chunks * n * n);   // row-major
+      for (std::size_t c = 0; c < num_chunks; ++c)
+      {
+        viennacl::range chunk_rows(chunk_start[c], chunk_start[c+1]);
+        MatrixType A_chunk(chunk_rows.size(), n, viennacl::traits::context(A));
+        A_chunk = viennacl::project(const_cast<MatrixType &>(A), chunk_rows, viennacl::range(0, n));  // A is only read
+
+        chunk_betas[c] = detail::inplace_qr_compact_wy(A_chunk, block_size);
+        viennacl::project(Q, chunk_rows, viennacl::range(0, n)) = A_chunk;
+
+        MatrixType R_chunk(n, n, viennacl::traits::context(A));
+        R_chunk = viennacl::project(A_chunk, viennacl::range(0, n), viennacl::range(0, n));
+        std::vector< std::vector<T> > host_R_chunk(n, std::vector<T>(n));
+        viennacl::copy(R_chunk, host_R_chunk);
+        for (std::size_t i = 0; i < n; ++i)
+          for (std::size_t j = i; j < n; ++j)
+            stacked_R[(c * n + i) * n + j] = host_R_chunk[i][j];
+      }
+
+      //
+      // Step 2: QR factorization of the stacked triangular factors on the host, and explicit formation of its orthogonal factor:
+      //
+      std::vector<T> stacked_betas(n);
+      detail::inplace_qr_panel_host<viennacl::row_major>(stacked_R, num_chunks * n, n, num_chunks * n, n, &(stacked_betas[0]));
+
+      std::vector< std::vector<T> > host_R(n, std::vector<T>(n));
+      for (std::size_t i = 0; i < n; ++i)
+        for (std::size_t j = i; j < n; ++j)
+          host_R[i][j] = stacked_R[i * n + j];
+      viennacl::copy(host_R, R);
+
+      std::vector<T> stacked_Q(num_chunks * n * n);
+      for (std::size_t i = 0; i < n; ++i)
+        stacked_Q[i * n + i] = 1;
+      detail::inplace_qr_panel_host_apply_Q<viennacl::row_major>(stacked_R, num_chunks * n, n, num_chunks * n, n, &(stacked_betas[0]), stacked_Q, n);
+
+      //
+      // Step 3: Q_chunk = Q_local [Q_stacked_chunk; 0]
+      //
+      for (std::size_t c = 0; c < num_chunks; ++c)
+      {
+        viennacl::range chunk_rows(chunk_start[c], chunk_start[c+1]);
+        MatrixType factors(chunk_rows.size(), n, viennacl::traits::context(A));
+        factors = viennacl::project(Q, chunk_rows, viennacl::range(0, n));
+
+        std::vector< std::vector<T> > host_Q_top(n, std::vector<T>(n));
+        for (std::size_t i = 0; i < n; ++i)
+          for (std::size_t j = 0; j < n; ++j)
+            host_Q_top[i][j] = stacked_Q[(c * n + i) * n + j];
+
+        MatrixType Q_top(n, n, viennacl::traits::context(A));
+        viennacl::copy(host_Q_top, Q_top);
+
+        MatrixType Q_chunk(chunk_rows.size(), n, viennacl::traits::context(A));  // zero-initialized
+        viennacl::project(Q_chunk, viennacl::range(0, n), viennacl::range(0, n)) = Q_top;
+        inplace_qr_apply_Q(factors, chunk_betas[c], Q_chunk, block_size);
+
+        viennacl::project(Q, chunk_rows, viennacl::range(0, n)) = Q_chunk;
+      }
     }
 
     /** @brief Overload of inplace-QR factorization for a general Boost.uBLAS compatible matrix A
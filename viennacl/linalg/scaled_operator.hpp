@@ -0,0 +1,198 @@
+#ifndef VIENNACL_LINALG_SCALED_OPERATOR_HPP_
+#define VIENNACL_LINALG_SCALED_OPERATOR_HPP_
+
+/* =========================================================================
+   Copyright (c) 2010-2013, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/linalg/scaled_operator.hpp
+    @brief A diagonally scaled system matrix D^{-1} A or D^{-1/2} A D^{-1/2}, whose products with vectors are computed in a single fused kernel.
+*/
+
+#include <cassert>
+#include "viennacl/forwards.h"
+#include "viennacl/vector.hpp"
+#include "viennacl/compressed_matrix.hpp"
+#include "viennacl/linalg/sparse_matrix_operations.hpp"
+#include "viennacl/linalg/jacobi_precond.hpp"
+#include "viennacl/linalg/row_scaling.hpp"
+
+namespace viennacl
+{
+  namespace linalg
+  {
+
+    /** @brief Represents the system matrix A scaled by the inverse of a diagonal matrix D, which holds either the diagonal of A (jacobi_tag) or its row norms (row_scaling_tag).
+    *
+    * A scaled_operator can be passed to the iterative solvers in place of the system matrix. Unlike jacobi_precond and row_scaling, which apply D^{-1} in a separate
+    * pass over the vector after each matrix-vector product, the scaling is applied within the sparse matrix-vector product, saving one pass over a vector per iteration.
+    * The right hand side has to be scaled via scale_rhs() prior to the solver call, and the solution obtained for DIAGONAL_SCALING_SYMMETRIC has to be transformed back via unscale_solution().
+    * DIAGONAL_SCALING_SYMMETRIC requires positive entries in D and preserves symmetry, thus it is the appropriate choice for the CG solver.
+    *
+    * Currently, only compressed_matrix is supported as underlying matrix type. The matrix is referenced, not copied, and must remain valid while the operator is in use.
+    */
+    template <typename MatrixType>
+    class scaled_operator
+    {
+        typedef typename viennacl::result_of::cpu_value_type<typename MatrixType::value_type>::type  ScalarType;
+
+      public:
+        typedef typename MatrixType::value_type      value_type;
+        typedef typename MatrixType::size_type       size_type;
+
+        /** @brief Scales the system matrix by its diagonal
+        *
+        * @param mat    The system matrix
+        * @param type   Whether D^{-1} A or D^{-1/2} A D^{-1/2} is represented
+        */
+        scaled_operator(MatrixType const & mat, jacobi_tag const &, diagonal_scaling_type type = DIAGONAL_SCALING_LEFT)
+          : mat_(&mat), type_(type), info_(detail::SPARSE_ROW_DIAGONAL), scaling_(mat.size1(), viennacl::traits::context(mat))
+        {
+          init();
+        }
+
+        /** @brief Scales the system matrix by its row norms
+        *
+        * @param mat    The system matrix
+        * @param tag    A row scaling tag holding the desired norm
+        * @param type   Whether D^{-1} A or D^{-1/2} A D^{-1/2} is represented
+        */
+        scaled_operator(MatrixType const & mat, row_scaling_tag const & tag, diagonal_scaling_type type = DIAGONAL_SCALING_LEFT)
+          : mat_(&mat), type_(type), info_(detail::SPARSE_ROW_NORM_2), scaling_(mat.size1(), viennacl::traits::context(mat))
+        {
+          switch (tag.norm())
+          {
+            case 0: info_ = detail::SPARSE_ROW_NORM_INF; break;
+            case 1: info_ = detail::SPARSE_ROW_NORM_1;   break;
+            case 2: info_ = detail::SPARSE_ROW_NORM_2;   break;
+            default:
+              throw "Unknown norm!";
+          }
+          init();
+        }
+
+        /** @brief Recomputes the scaling for new values of the system matrix (e.g. after compressed_matrix::set_values()) */
+        void refactor(MatrixType const & mat)
+        {
+          mat_ = &mat;
+          scaling_.resize(mat.size1(), false);
+          init();
+        }
+
+        size_type size1() const { return mat_->size1(); }
+        size_type size2() const { return mat_->size2(); }
+        size_type nnz() const { return mat_->nnz(); }
+
+        /** @brief Returns the memory handle of the nonzeros of the underlying matrix. Used for determining the memory domain. */
+        viennacl::backend::mem_handle const & handle() const { return mat_->handle(); }
+
+        /** @brief Returns the unscaled system matrix */
+        MatrixType const & matrix() const { return *mat_; }
+
+        /** @brief Returns the entries of D^{-1} (DIAGONAL_SCALING_LEFT) or D^{-1/2} (DIAGONAL_SCALING_SYMMETRIC) */
+        viennacl::vector<ScalarType> const & scaling() const { return scaling_; }
+
+        diagonal_scaling_type type() const { return type_; }
+
+        /** @brief Transforms the right hand side b of A x = b to the right hand side of the scaled system */
+        template <typename VectorType>
+        void scale_rhs(VectorType & b) const
+        {
+          assert(viennacl::traits::size(b) == viennacl::traits::size(scaling_) && bool("Size mismatch"));
+          b = viennacl::linalg::element_prod(b, scaling_);
+        }
+
+        /** @brief Transforms the solution of the scaled system to the solution x of A x = b. No-op for DIAGONAL_SCALING_LEFT. */
+        template <typename VectorType>
+        void unscale_solution(VectorType & x) const
+        {
+          assert(viennacl::traits::size(x) == viennacl::traits::size(scaling_) && bool("Size mismatch"));
+          if (type_ == DIAGONAL_SCALING_SYMMETRIC)
+            x = viennacl::linalg::element_prod(x, scaling_);
+        }
+
+      private:
+        void init()
+        {
+          assert( (type_ == DIAGONAL_SCALING_LEFT || mat_->size1() == mat_->size2()) && bool("Symmetric scaling requires a square matrix!"));
+
+          detail::row_info(*mat_, scaling_, info_);
+
+          viennacl::vector<ScalarType> ones = viennacl::scalar_vector<ScalarType>(scaling_.size(), ScalarType(1), viennacl::traits::context(scaling_));
+          scaling_ = viennacl::linalg::element_div(ones, scaling_);
+          if (type_ == DIAGONAL_SCALING_SYMMETRIC)
+            scaling_ = viennacl::linalg::element_sqrt(scaling_);
+        }
+
+        MatrixType const * mat_;
+        diagonal_scaling_type type_;
+        detail::row_info_types info_;
+        viennacl::vector<ScalarType> scaling_;
+    };
+
+
+    //
+    // Specify available operations:
+    //
+
+    namespace detail
+    {
+      // x = op * y
+      template <typename M, typename T>
+      struct op_executor<vector_base<T>, op_assign, vector_expression<const scaled_operator<M>, const vector_base<T>, op_prod> >
+      {
+          static void apply(vector_base<T> & lhs, vector_expression<const scaled_operator<M>, const vector_base<T>, op_prod> const & rhs)
+          {
+            // check for the special case x = op * x
+            if (viennacl::traits::handle(lhs) == viennacl::traits::handle(rhs.rhs()))
+            {
+              viennacl::vector<T> temp(rhs.lhs().size1(), viennacl::traits::context(rhs));
+              viennacl::linalg::prod_impl(rhs.lhs(), rhs.rhs(), temp);
+              lhs = temp;
+            }
+            else
+              viennacl::linalg::prod_impl(rhs.lhs(), rhs.rhs(), lhs);
+          }
+      };
+
+      template <typename M, typename T>
+      struct op_executor<vector_base<T>, op_inplace_add, vector_expression<const scaled_operator<M>, const vector_base<T>, op_prod> >
+      {
+          static void apply(vector_base<T> & lhs, vector_expression<const scaled_operator<M>, const vector_base<T>, op_prod> const & rhs)
+          {
+            viennacl::vector<T> temp(rhs.lhs().size1(), viennacl::traits::context(rhs));
+            viennacl::linalg::prod_impl(rhs.lhs(), rhs.rhs(), temp);
+            lhs += temp;
+          }
+      };
+
+      template <typename M, typename T>
+      struct op_executor<vector_base<T>, op_inplace_sub, vector_expression<const scaled_operator<M>, const vector_base<T>, op_prod> >
+      {
+          static void apply(vector_base<T> & lhs, vector_expression<const scaled_operator<M>, const vector_base<T>, op_prod> const & rhs)
+          {
+            viennacl::vector<T> temp(rhs.lhs().size1(), viennacl::traits::context(rhs));
+            viennacl::linalg::prod_impl(rhs.lhs(), rhs.rhs(), temp);
+            lhs -= temp;
+          }
+      };
+
+    } // namespace detail
+
+  }
+}
+
+#endif
@@ -38,13 +38,17 @@
 #include "viennacl/linalg/detail/spai/spai_tag.hpp"
 #include "viennacl/linalg/qr.hpp"
 #include "viennacl/linalg/prod.hpp"
-#include "viennacl/linalg/detail/spai/spai-dynamic.hpp"
-#include "viennacl/linalg/detail/spai/spai-static.hpp"
 #include "viennacl/linalg/detail/spai/sparse_vector.hpp"
-#include "viennacl/linalg/detail/spai/block_matrix.hpp"
-#include "viennacl/linalg/detail/spai/block_vector.hpp"
 #include "viennacl/linalg/detail/spai/fspai.hpp"
-#include "viennacl/linalg/detail/spai/spai.hpp"
+#include "viennacl/linalg/detail/spai/spai_host.hpp"
+
+#ifdef VIENNACL_WITH_OPENCL
+  #include "viennacl/linalg/detail/spai/spai-dynamic.hpp"
+  #include "viennacl/linalg/detail/spai/spai-static.hpp"
+  #include "viennacl/linalg/detail/spai/block_matrix.hpp"
+  #include "viennacl/linalg/detail/spai/block_vector.hpp"
+  #include "viennacl/linalg/detail/spai/spai.hpp"
+#endif
 
 //boost includes
 #include "boost/numeric/ublas/vector.hpp"
@@ -70,6 +74,10 @@ namespace viennacl
          * @param Matrix matrix that is used for computations
          * @param Vector vector that is used for computations
          */
+        template <typename MatrixType>
+        class spai_precond;
+
+#ifdef VIENNACL_WITH_OPENCL
         //UBLAS version
         template <typename MatrixType>
         class spai_precond
@@ -114,6 +122,7 @@ namespace viennacl
             // result of SPAI
             MatrixType spai_m_;
         };
+#endif
 
         //VIENNACL version
         template <typename ScalarType, unsigned int MAT_ALIGNMENT>
@@ -127,33 +136,41 @@ namespace viennacl
             typedef boost::numeric::ublas::vector<ScalarType> UBLASVectorType;
         public:
 
-            /** @brief Constructor
+            /** @brief Constructor. The setup runs on the host unless A resides in OpenCL memory.
              * @param A matrix whose approximate inverse is calculated. Must be quadratic.
              * @param tag spai tag
              */
             spai_precond(const MatrixType& A,
                          const spai_tag& tag): tag_(tag), spai_m_(viennacl::traits::context(A))
             {
-                viennacl::ocl::context & ctx = const_cast<viennacl::ocl::context &>(viennacl::traits::opencl_handle(A).context());
-                viennacl::linalg::opencl::kernels::spai<ScalarType>::init(ctx);
-
-                MatrixType At(A.size1(), A.size2(), viennacl::context(ctx));
-                UBLASSparseMatrixType ubls_A, ubls_spai_m;
-                UBLASSparseMatrixType ubls_At;
-                viennacl::copy(A, ubls_A);;
-                if(!tag_.getIsRight()){
-                    viennacl::linalg::detail::spai::sparse_transpose(ubls_A, ubls_At);
+#ifdef VIENNACL_WITH_OPENCL
+                if (viennacl::traits::context(A).memory_type() == viennacl::OPENCL_MEMORY)
+                {
+                  viennacl::ocl::context & ctx = const_cast<viennacl::ocl::context &>(viennacl::traits::opencl_handle(A).context());
+                  viennacl::linalg::opencl::kernels::spai<ScalarType>::init(ctx);
+
+                  MatrixType At(A.size1(), A.size2(), viennacl::context(ctx));
+                  UBLASSparseMatrixType ubls_A, ubls_spai_m;
+                  UBLASSparseMatrixType ubls_At;
+                  viennacl::copy(A, ubls_A);;
+                  if(!tag_.getIsRight()){
+                      viennacl::linalg::detail::spai::sparse_transpose(ubls_A, ubls_At);
+                  }
+                  else{
+                      ubls_At = ubls_A;
+                  }
+                  //current pattern is A
+                  //pA = ubls_At;
+                  //execute SPAI with ublas matrix types
+                  viennacl::linalg::detail::spai::initPreconditioner(ubls_At, ubls_spai_m);
+                  viennacl::copy(ubls_At, At);
+                  viennacl::linalg::detail::spai::computeSPAI(At, ubls_At, ubls_spai_m, spai_m_, tag_);
+                  //viennacl::copy(ubls_spai_m, spai_m_);
                 }
-                else{
-                    ubls_At = ubls_A;
-                }
-                //current pattern is A
-                //pA = ubls_At;
-                //execute SPAI with ublas matrix types
-                viennacl::linalg::detail::spai::initPreconditioner(ubls_At, ubls_spai_m);
-                viennacl::copy(ubls_At, At);
-                viennacl::linalg::detail::spai::computeSPAI(At, ubls_At, ubls_spai_m, spai_m_, tag_);
-                //viennacl::copy(ubls_spai_m, spai_m_);
+                else
+#endif
+                  viennacl::linalg::detail::spai::compute_spai_host(A, spai_m_, tag_);
+
                 tmp_.resize(A.size1(), viennacl::traits::context(A), false);
             }
             /** @brief Application of current preconditioner, multiplication on the right-hand side vector
@@ -230,9 +247,6 @@ namespace viennacl
         {
             typedef viennacl::compressed_matrix<ScalarType, MAT_ALIGNMENT>   MatrixType;
             typedef viennacl::vector<ScalarType> VectorType;
-            typedef viennacl::matrix<ScalarType> VCLDenseMatrixType;
-            typedef boost::numeric::ublas::compressed_matrix<ScalarType> UBLASSparseMatrixType;
-            typedef boost::numeric::ublas::vector<ScalarType> UBLASVectorType;
         public:
 
             /** @brief Constructor
@@ -242,22 +256,8 @@ namespace viennacl
             fspai_precond(const MatrixType & A,
                           const fspai_tag & tag) : tag_(tag), L(viennacl::traits::context(A)), L_trans(viennacl::traits::context(A)), temp_apply_vec_(A.size1(), viennacl::traits::context(A))
             {
-                //UBLASSparseMatrixType ubls_A;
-                UBLASSparseMatrixType ublas_A(A.size1(), A.size2());
-                UBLASSparseMatrixType pA(A.size1(), A.size2());
-                UBLASSparseMatrixType ublas_L(A.size1(), A.size2());
-                UBLASSparseMatrixType ublas_L_trans(A.size1(), A.size2());
-                viennacl::copy(A, ublas_A);
-                //viennacl::copy(ubls_A, vcl_A);
-                //vcl_At = viennacl::linalg::prod(vcl_A, vcl_A);
-                //vcl_pA = viennacl::linalg::prod(vcl_A, vcl_At);
-                //viennacl::copy(vcl_pA, pA);
-                pA = ublas_A;
-                //execute SPAI with ublas matrix types
-                viennacl::linalg::detail::spai::computeFSPAI(ublas_A, pA, ublas_L, ublas_L_trans, tag_);
-                //copy back to GPU
-                viennacl::copy(ublas_L, L);
-                viennacl::copy(ublas_L_trans, L_trans);
+                //setup on the host, the factors are written directly to the memory domain of A
+                viennacl::linalg::detail::spai::compute_fspai_host(A, L, L_trans);
             }
 
 
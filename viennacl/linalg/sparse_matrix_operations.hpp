@@ -27,6 +27,7 @@
 #include "viennacl/vector.hpp"
 #include "viennacl/matrix.hpp"
 #include "viennacl/tools/tools.hpp"
+#include "viennacl/tools/profiler.hpp"
 #include "viennacl/linalg/host_based/sparse_matrix_operations.hpp"
 
 #ifdef VIENNACL_WITH_OPENCL
@@ -73,6 +74,60 @@ namespace viennacl
         }
       }
 
+      //
+      // Bytes moved by the sparse matrix-vector product, as recorded by the profiler (excluding the vectors):
+      //
+      template <typename ScalarType, unsigned int ALIGNMENT>
+      double spmv_matrix_bytes(viennacl::compressed_matrix<ScalarType, ALIGNMENT> const & mat)
+      {
+        return double(mat.nnz()) * (sizeof(ScalarType) + sizeof(unsigned int)) + (mat.size1() + 1.0) * sizeof(unsigned int);
+      }
+
+      template <typename ScalarType>
+      double spmv_matrix_bytes(viennacl::compressed_compressed_matrix<ScalarType> const & mat)
+      {
+        return double(mat.nnz()) * (sizeof(ScalarType) + sizeof(unsigned int)) + (2.0 * mat.nnz1() + 1.0) * sizeof(unsigned int);
+      }
+
+      template <typename ScalarType, unsigned int ALIGNMENT>
+      double spmv_matrix_bytes(viennacl::coordinate_matrix<ScalarType, ALIGNMENT> const & mat)
+      {
+        return double(mat.nnz()) * (sizeof(ScalarType) + 2 * sizeof(unsigned int));
+      }
+
+      template <typename ScalarType, unsigned int ALIGNMENT>
+      double spmv_matrix_bytes(viennacl::ell_matrix<ScalarType, ALIGNMENT> const & mat)
+      {
+        return double(mat.nnz()) * (sizeof(ScalarType) + sizeof(unsigned int));
+      }
+
+      template <typename ScalarType, unsigned int ALIGNMENT>
+      double spmv_matrix_bytes(viennacl::hyb_matrix<ScalarType, ALIGNMENT> const & mat)
+      {
+        return (double(mat.size1()) * mat.ell_nnz() + mat.csr_nnz()) * (sizeof(ScalarType) + sizeof(unsigned int)) + (mat.size1() + 1.0) * sizeof(unsigned int);
+      }
+
+      template <typename MatrixType>
+      double spmv_matrix_bytes(viennacl::linalg::scaled_operator<MatrixType> const & mat)
+      {
+        return spmv_matrix_bytes(mat.matrix()) + double(mat.size1()) * sizeof(typename viennacl::result_of::cpu_value_type<typename MatrixType::value_type>::type);
+      }
+
+      //
+      // Number of nonzeros processed by the sparse matrix-vector product (including explicit zeros of padded formats):
+      //
+      template <typename SparseMatrixType>
+      double spmv_nonzeros(SparseMatrixType const & mat)
+      {
+        return double(mat.nnz());
+      }
+
+      template <typename ScalarType, unsigned int ALIGNMENT>
+      double spmv_nonzeros(viennacl::hyb_matrix<ScalarType, ALIGNMENT> const & mat)
+      {
+        return double(mat.size1()) * mat.ell_nnz() + mat.csr_nnz();
+      }
+
     }
 
 
@@ -96,6 +151,10 @@ namespace viennacl
       assert( (mat.size1() == result.size()) && bool("Size check failed for compressed matrix-vector product: size1(mat) != size(result)"));
       assert( (mat.size2() == vec.size())    && bool("Size check failed for compressed matrix-vector product: size2(mat) != size(x)"));
 
+      viennacl::tools::profiler_scope profile("spmv", viennacl::traits::active_handle_id(mat),
+                                              detail::spmv_matrix_bytes(mat) + (double(mat.size1()) + mat.size2()) * sizeof(ScalarType),
+                                              2.0 * detail::spmv_nonzeros(mat));
+
       switch (viennacl::traits::handle(mat).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
@@ -21,7 +21,7 @@
 /** @file viennacl/linalg/svd.hpp
     @brief Provides singular value decomposition using a block-based approach.  Experimental.
 
-    Contributed by Volodymyr Kysenko.
+    The OpenCL kernels for the SVD were contributed by Volodymyr Kysenko.
 */
 
 
@@ -31,18 +31,67 @@
 
 
 #include <cmath>
+#include <vector>
+#include <algorithm>
 
 #include "viennacl/matrix.hpp"
-#include "viennacl/linalg/opencl/kernels/svd.hpp"
-#include "viennacl/linalg/qr-method-common.hpp"
+#include "viennacl/matrix_proxy.hpp"
+#include "viennacl/linalg/prod.hpp"
+#include "viennacl/linalg/qr.hpp"
+#include "viennacl/rand/generator.hpp"
+#include "viennacl/linalg/detail/bidiag_svd.hpp"
+
+#ifdef VIENNACL_WITH_OPENCL
+  #include "viennacl/linalg/opencl/kernels/svd.hpp"
+  #include "viennacl/linalg/qr-method-common.hpp"
+#endif
 
 namespace viennacl
 {
   namespace linalg
   {
 
+    /** @brief A tag for the randomized computation of a truncated singular value decomposition (Halko, Martinsson, Tropp).
+    *
+    * The range of A is sampled with a random block of rank() + oversampling() vectors, which is improved by power_iterations() steps of subspace iteration.
+    */
+    class randomized_svd_tag
+    {
+      public:
+        /** @brief The constructor
+        *
+        * @param rank               Number of singular triplets to be computed
+        * @param oversampling       Number of additional sample vectors
+        * @param power_iterations   Number of subspace iterations with A A^T. Improves the accuracy for slowly decaying singular values
+        * @param seed               Seed for the random sample vectors
+        */
+        randomized_svd_tag(std::size_t rank,
+                           std::size_t oversampling = 10,
+                           std::size_t power_iterations = 2,
+                           unsigned int seed = 42) : rank_(rank), oversampling_(oversampling), power_iterations_(power_iterations), seed_(seed) {}
+
+        /** @brief Returns the number of singular triplets to be computed */
+        std::size_t rank() const { return rank_; }
+
+        /** @brief Returns the number of additional sample vectors */
+        std::size_t oversampling() const { return oversampling_; }
+
+        /** @brief Returns the number of subspace iterations */
+        std::size_t power_iterations() const { return power_iterations_; }
+
+        /** @brief Returns the seed for the random sample vectors */
+        unsigned int seed() const { return seed_; }
+
+      private:
+        std::size_t rank_;
+        std::size_t oversampling_;
+        std::size_t power_iterations_;
+        unsigned int seed_;
+    };
+
     namespace detail
     {
+#ifdef VIENNACL_WITH_OPENCL
 
       template<typename MatrixType, typename VectorType>
       void givens_prev(MatrixType & matrix,
@@ -477,54 +526,310 @@ namespace viennacl
         }
       }
 
+
+      /** @brief Computes the SVD of a row-major matrix on an OpenCL device with the SVD kernels. Returns false if A does not reside in OpenCL memory. */
+      template <typename SCALARTYPE, unsigned int ALIGNMENT>
+      bool svd_opencl(viennacl::matrix<SCALARTYPE, row_major, ALIGNMENT> & A,
+                      viennacl::matrix<SCALARTYPE, row_major, ALIGNMENT> & QL,
+                      viennacl::matrix<SCALARTYPE, row_major, ALIGNMENT> & QR)
+      {
+        if (A.handle().get_active_handle_id() != viennacl::OPENCL_MEMORY)
+          return false;
+
+        viennacl::ocl::context & ctx = const_cast<viennacl::ocl::context &>(viennacl::traits::opencl_handle(A).context());
+        viennacl::linalg::opencl::kernels::svd<SCALARTYPE>::init(ctx);
+
+        std::size_t row_num = A.size1();
+        std::size_t col_num = A.size2();
+
+        std::size_t to = std::min(row_num, col_num);
+
+        // first stage
+        detail::bidiag(A, QL, QR);
+
+        // second stage
+        boost::numeric::ublas::vector<SCALARTYPE> dh(to, 0);
+        boost::numeric::ublas::vector<SCALARTYPE> sh(to + 1, 0);
+
+        detail::bidiag_pack(A, dh, sh);
+
+        detail::svd_qr_shift( QL, QR, dh, sh);
+
+        // Write resulting diagonal matrix with singular values to A:
+        boost::numeric::ublas::matrix<SCALARTYPE> h_Sigma(row_num, col_num);
+        h_Sigma.clear();
+
+        for (std::size_t i = 0; i < to; i++)
+          h_Sigma(i, i) = dh[i];
+
+        copy(h_Sigma, A);
+        return true;
+      }
+
+      /** @brief The OpenCL kernels for the SVD are only available for row-major matrices */
+      template <typename SCALARTYPE, unsigned int ALIGNMENT>
+      bool svd_opencl(viennacl::matrix<SCALARTYPE, column_major, ALIGNMENT> &,
+                      viennacl::matrix<SCALARTYPE, column_major, ALIGNMENT> &,
+                      viennacl::matrix<SCALARTYPE, column_major, ALIGNMENT> &)
+      {
+        return false;
+      }
+#endif
+
+      //
+      // Backend-independent SVD: The matrix is reduced to bidiagonal form on the host, the orthogonal factors are formed in the memory domain of the result
+      //
+
+      /** @brief Reads a dense ViennaCL matrix into a row-major host buffer. If 'transposed' is true, the buffer holds the transpose of A. */
+      template <typename SCALARTYPE, typename F, unsigned int ALIGNMENT>
+      void svd_read_matrix(viennacl::matrix<SCALARTYPE, F, ALIGNMENT> const & A, std::vector<SCALARTYPE> & host_A, bool transposed)
+      {
+        host_A.resize(A.size1() * A.size2());
+        if (host_A.size() == 0)
+          return;
+
+        std::vector<SCALARTYPE> buffer(A.internal_size());
+        viennacl::backend::memory_read(A.handle(), 0, sizeof(SCALARTYPE) * buffer.size(), &(buffer[0]));
+        for (std::size_t i = 0; i < A.size1(); ++i)
+          for (std::size_t j = 0; j < A.size2(); ++j)
+          {
+            SCALARTYPE value = buffer[F::mem_index(i, j, A.internal_size1(), A.internal_size2())];
+            if (transposed)
+              host_A[j * A.size1() + i] = value;
+            else
+              host_A[i * A.size2() + j] = value;
+          }
+      }
+
+      /** @brief Writes a row-major host buffer with A.size1() rows and A.size2() columns to a dense ViennaCL matrix */
+      template <typename SCALARTYPE, typename F, unsigned int ALIGNMENT>
+      void svd_write_matrix(std::vector<SCALARTYPE> const & host_A, viennacl::matrix<SCALARTYPE, F, ALIGNMENT> & A)
+      {
+        if (A.internal_size() == 0)
+          return;
+
+        std::vector<SCALARTYPE> buffer(A.internal_size());
+        for (std::size_t i = 0; i < A.size1(); ++i)
+          for (std::size_t j = 0; j < A.size2(); ++j)
+            buffer[F::mem_index(i, j, A.internal_size1(), A.internal_size2())] = host_A[i * A.size2() + j];
+        viennacl::backend::memory_write(A.handle(), 0, sizeof(SCALARTYPE) * buffer.size(), &(buffer[0]));
+      }
+
+      /** @brief Sets up Q = Q_L diag(U_B, I) from the left Householder reflectors of a bidiagonalized rows x cols matrix and the left singular vectors U_B of the bidiagonal matrix */
+      template <typename SCALARTYPE, typename F, unsigned int ALIGNMENT>
+      void svd_form_left(std::vector<SCALARTYPE> const & host_A, std::size_t rows, std::size_t cols,
+                         std::vector<SCALARTYPE> const & tauq, std::vector<SCALARTYPE> const & Ut,
+                         viennacl::matrix<SCALARTYPE, F, ALIGNMENT> & Q)
+      {
+        if (Q.size1() != rows || Q.size2() != rows)
+          Q.resize(rows, rows, false);
+
+        std::vector<SCALARTYPE> host_Q(rows * rows);
+        for (std::size_t i = 0; i < cols; ++i)
+          for (std::size_t j = 0; j < cols; ++j)
+            host_Q[i * rows + j] = Ut[j * cols + i];
+        for (std::size_t i = cols; i < rows; ++i)
+          host_Q[i * rows + i] = 1;
+        svd_write_matrix(host_Q, Q);
+
+        // the reflectors below the diagonal are applied blockwise using matrix-matrix products:
+        viennacl::matrix<SCALARTYPE, F, ALIGNMENT> reflectors(rows, cols, viennacl::traits::context(Q));
+        svd_write_matrix(host_A, reflectors);
+        viennacl::linalg::inplace_qr_apply_Q(reflectors, tauq, Q);
+      }
+
+      /** @brief Sets up Q = Q_R V_B from the right Householder reflectors of a bidiagonalized matrix with n columns and the right singular vectors V_B of the bidiagonal matrix */
+      template <typename SCALARTYPE, typename F, unsigned int ALIGNMENT>
+      void svd_form_right(std::vector<SCALARTYPE> const & host_A, std::size_t n,
+                          std::vector<SCALARTYPE> const & taup, std::vector<SCALARTYPE> const & Vt,
+                          viennacl::matrix<SCALARTYPE, F, ALIGNMENT> & Q)
+      {
+        typedef viennacl::matrix<SCALARTYPE, F, ALIGNMENT>   MatrixType;
+
+        if (Q.size1() != n || Q.size2() != n)
+          Q.resize(n, n, false);
+
+        std::vector<SCALARTYPE> host_Q(n * n);
+        for (std::size_t i = 0; i < n; ++i)
+          for (std::size_t j = 0; j < n; ++j)
+            host_Q[i * n + j] = Vt[j * n + i];
+        svd_write_matrix(host_Q, Q);
+
+        if (n < 3)  // no nontrivial right reflectors
+          return;
+
+        // the right reflectors act on the rows 1, ..., n-1. Store them column-wise as for a QR factorization:
+        std::vector<SCALARTYPE> host_W((n-1) * (n-1));
+        for (std::size_t r = 0; r < n-1; ++r)
+          for (std::size_t c = 0; c < r; ++c)
+            host_W[r * (n-1) + c] = host_A[c * n + r + 1];
+        MatrixType W(n-1, n-1, viennacl::traits::context(Q));
+        svd_write_matrix(host_W, W);
+
+        MatrixType Q_lower(n-1, n, viennacl::traits::context(Q));
+        Q_lower = viennacl::project(Q, viennacl::range(1, n), viennacl::range(0, n));
+        viennacl::linalg::inplace_qr_apply_Q(W, taup, Q_lower);
+        viennacl::project(Q, viennacl::range(1, n), viennacl::range(0, n)) = Q_lower;
+      }
+
+      /** @brief Backend-independent SVD A = QL Sigma QR^T of a dense matrix. */
+      template <typename SCALARTYPE, typename F, unsigned int ALIGNMENT>
+      void svd_generic(viennacl::matrix<SCALARTYPE, F, ALIGNMENT> & A,
+                       viennacl::matrix<SCALARTYPE, F, ALIGNMENT> & QL,
+                       viennacl::matrix<SCALARTYPE, F, ALIGNMENT> & QR)
+      {
+        std::size_t m = A.size1();
+        std::size_t n = A.size2();
+
+        // a wide matrix is transposed, so that the bidiagonalization always works on a matrix with at least as many rows as columns:
+        bool transposed = (m < n);
+        std::size_t rows = transposed ? n : m;
+        std::size_t cols = transposed ? m : n;
+
+        std::vector<SCALARTYPE> host_A;
+        svd_read_matrix(A, host_A, transposed);
+
+        std::vector<SCALARTYPE> d, e, tauq, taup;
+        detail::bidiag_reduce(host_A, rows, cols, d, e, tauq, taup);
+
+        std::vector<SCALARTYPE> Ut, Vt;
+        detail::bidiag_qr(d, e, &Ut, &Vt);
+
+        // A^T = U Sigma V^T implies A = V Sigma U^T:
+        svd_form_left(host_A, rows, cols, tauq, Ut, transposed ? QR : QL);
+        svd_form_right(host_A, cols, taup, Vt, transposed ? QL : QR);
+
+        std::vector<SCALARTYPE> host_Sigma(m * n);
+        for (std::size_t i = 0; i < cols; ++i)
+          host_Sigma[i * n + i] = d[i];
+        svd_write_matrix(host_Sigma, A);
+      }
+
     } // namespace detail
 
 
-    /** @brief Computes the singular value decomposition of a matrix A. Experimental in 1.3.x
+    /** @brief Computes the singular value decomposition A = QL Sigma QR^T of a dense matrix.
+     *
+     * Row-major matrices in OpenCL memory are processed with the OpenCL SVD kernels. Otherwise, the matrix is reduced to bidiagonal form on the host
+     * (blocked Householder reduction), the bidiagonal matrix is diagonalized by implicit-shift QR iterations, and the orthogonal factors are formed
+     * by applying blocks of Householder reflectors with matrix-matrix products in the memory domain of QL and QR.
+     * In the latter case, the singular values are sorted in descending order.
      *
      * @param A     The input matrix. Will be overwritten with a diagonal matrix containing the singular values on return
      * @param QL    The left orthogonal matrix
      * @param QR    The right orthogonal matrix
      */
-    template <typename SCALARTYPE, unsigned int ALIGNMENT>
-    void svd(viennacl::matrix<SCALARTYPE, row_major, ALIGNMENT> & A,
-              viennacl::matrix<SCALARTYPE, row_major, ALIGNMENT> & QL,
-              viennacl::matrix<SCALARTYPE, row_major, ALIGNMENT> & QR)
+    template <typename SCALARTYPE, typename F, unsigned int ALIGNMENT>
+    void svd(viennacl::matrix<SCALARTYPE, F, ALIGNMENT> & A,
+             viennacl::matrix<SCALARTYPE, F, ALIGNMENT> & QL,
+             viennacl::matrix<SCALARTYPE, F, ALIGNMENT> & QR)
     {
-      viennacl::ocl::context & ctx = const_cast<viennacl::ocl::context &>(viennacl::traits::opencl_handle(A).context());
-      viennacl::linalg::opencl::kernels::svd<SCALARTYPE>::init(ctx);
-
-      std::size_t row_num = A.size1();
-      std::size_t col_num = A.size2();
-
-      std::size_t to = std::min(row_num, col_num);
-
-
-      //viennacl::vector<SCALARTYPE, ALIGNMENT> d(to);
-      //viennacl::vector<SCALARTYPE, ALIGNMENT> s(to + 1);
-
-      // first stage
-      detail::bidiag(A, QL, QR);
-
-      // second stage
-      //std::vector<SCALARTYPE> dh(to, 0);
-      //std::vector<SCALARTYPE> sh(to + 1, 0);
-      boost::numeric::ublas::vector<SCALARTYPE> dh(to, 0);
-      boost::numeric::ublas::vector<SCALARTYPE> sh(to + 1, 0);
+#ifdef VIENNACL_WITH_OPENCL
+      if (detail::svd_opencl(A, QL, QR))
+        return;
+#endif
+      detail::svd_generic(A, QL, QR);
+    }
 
-      detail::bidiag_pack(A, dh, sh);
+    /** @brief Computes the singular values of a dense matrix in descending order.
+     *
+     * The matrix is reduced to bidiagonal form on the host, the singular values of the bidiagonal matrix are computed with the dqds algorithm.
+     *
+     * @param A     The matrix. Not modified.
+     */
+    template <typename SCALARTYPE, typename F, unsigned int ALIGNMENT>
+    std::vector<SCALARTYPE> singular_values(viennacl::matrix<SCALARTYPE, F, ALIGNMENT> const & A)
+    {
+      bool transposed = (A.size1() < A.size2());
+      std::vector<SCALARTYPE> host_A, sigma;
+      detail::svd_read_matrix(A, host_A, transposed);
+      detail::bidiag_svd(host_A, std::max(A.size1(), A.size2()), std::min(A.size1(), A.size2()), sigma,
+                         static_cast<std::vector<SCALARTYPE> *>(NULL), static_cast<std::vector<SCALARTYPE> *>(NULL));
+      return sigma;
+    }
 
-      detail::svd_qr_shift( QL, QR, dh, sh);
+    /** @brief Computes a truncated singular value decomposition A ~ U diag(sigma) V^T with a randomized range finder.
+     *
+     * Only matrix-matrix products with A and A^T, thin QR factorizations of tall and skinny matrices (TSQR), and the SVD of a small square matrix on the host are required.
+     *
+     * @param A     The matrix. Not modified.
+     * @param U     The left singular vectors (output, A.size1() rows and tag.rank() columns)
+     * @param V     The right singular vectors (output, A.size2() rows and tag.rank() columns)
+     * @param tag   Rank, oversampling, and number of power iterations
+     * @return      The tag.rank() largest singular values in descending order
+     */
+    template <typename SCALARTYPE, typename F, unsigned int ALIGNMENT>
+    std::vector<SCALARTYPE> randomized_svd(viennacl::matrix<SCALARTYPE, F, ALIGNMENT> const & A,
+                                           viennacl::matrix<SCALARTYPE, F, ALIGNMENT> & U,
+                                           viennacl::matrix<SCALARTYPE, F, ALIGNMENT> & V,
+                                           randomized_svd_tag const & tag)
+    {
+      typedef viennacl::matrix<SCALARTYPE, F, ALIGNMENT>   MatrixType;
+
+      std::size_t m = A.size1();
+      std::size_t n = A.size2();
+      std::size_t k = std::min(tag.rank(), std::min(m, n));
+      std::size_t l = std::min(k + tag.oversampling(), std::min(m, n));
+      if (k == 0)
+        return std::vector<SCALARTYPE>();
+
+      //
+      // Sample the range of A: Y = A Omega with random Omega
+      //
+      MatrixType Omega(n, l, viennacl::traits::context(A));
+      viennacl::rand::generator(tag.seed()).fill(Omega, viennacl::rand::uniform_tag(-1, 1));
+
+      MatrixType Y(m, l, viennacl::traits::context(A));
+      MatrixType Q(m, l, viennacl::traits::context(A));
+      MatrixType Z(n, l, viennacl::traits::context(A));
+      MatrixType Q_Z(n, l, viennacl::traits::context(A));
+      MatrixType R(l, l, viennacl::traits::context(A));
+
+      Y = viennacl::linalg::prod(A, Omega);
+      viennacl::linalg::tsqr(Y, Q, R);
+
+      // subspace iteration, re-orthogonalized after each product:
+      for (std::size_t i = 0; i < tag.power_iterations(); ++i)
+      {
+        Z = viennacl::linalg::prod(trans(A), Q);
+        viennacl::linalg::tsqr(Z, Q_Z, R);
+        Y = viennacl::linalg::prod(A, Q_Z);
+        viennacl::linalg::tsqr(Y, Q, R);
+      }
 
-      // Write resulting diagonal matrix with singular values to A:
-      boost::numeric::ublas::matrix<SCALARTYPE> h_Sigma(row_num, col_num);
-      h_Sigma.clear();
+      //
+      // Project: B = Q^T A = R_B^T Q_B^T, where B^T = Q_B R_B
+      //
+      Z = viennacl::linalg::prod(trans(A), Q);
+      viennacl::linalg::tsqr(Z, Q_Z, R);
 
-      for (std::size_t i = 0; i < to; i++)
-        h_Sigma(i, i) = dh[i];
+      // SVD of the small matrix R_B^T = U_s Sigma V_s^T on the host:
+      std::vector<SCALARTYPE> host_B, sigma, host_U_s, host_V_s;
+      detail::svd_read_matrix(R, host_B, true);
+      detail::bidiag_svd(host_B, l, l, sigma, &host_U_s, &host_V_s);
 
-      copy(h_Sigma, A);
+      std::vector<SCALARTYPE> host_U_k(l * k), host_V_k(l * k);
+      for (std::size_t i = 0; i < l; ++i)
+        for (std::size_t j = 0; j < k; ++j)
+        {
+          host_U_k[i * k + j] = host_U_s[i * l + j];
+          host_V_k[i * k + j] = host_V_s[i * l + j];
+        }
+      MatrixType U_k(l, k, viennacl::traits::context(A));
+      MatrixType V_k(l, k, viennacl::traits::context(A));
+      detail::svd_write_matrix(host_U_k, U_k);
+      detail::svd_write_matrix(host_V_k, V_k);
+
+      // A ~ Q U_s Sigma (Q_B V_s)^T:
+      U.resize(m, k, false);
+      V.resize(n, k, false);
+      U = viennacl::linalg::prod(Q, U_k);
+      V = viennacl::linalg::prod(Q_Z, V_k);
+
+      sigma.resize(k);
+      return sigma;
     }
+
   }
 }
 #endif
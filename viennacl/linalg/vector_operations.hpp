@@ -22,6 +22,7 @@
     @brief Implementations of vector operations.
 */
 
+#include <vector>
 #include "viennacl/forwards.h"
 #include "viennacl/scalar.hpp"
 #include "viennacl/tools/tools.hpp"
@@ -31,6 +32,7 @@
 #include "viennacl/traits/start.hpp"
 #include "viennacl/traits/handle.hpp"
 #include "viennacl/traits/stride.hpp"
+#include "viennacl/tools/profiler.hpp"
 #include "viennacl/linalg/host_based/vector_operations.hpp"
 
 #ifdef VIENNACL_WITH_OPENCL
@@ -351,6 +353,9 @@ namespace viennacl
     {
       assert( vec1.size() == vec2.size() && bool("Size mismatch") );
 
+      viennacl::tools::profiler_scope profile("inner_prod", viennacl::traits::active_handle_id(vec1),
+                                              2.0 * sizeof(T) * vec1.size(), 2.0 * vec1.size());
+
       switch (viennacl::traits::handle(vec1).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
@@ -423,6 +428,9 @@ namespace viennacl
     {
       assert( vec1.size() == vec2.size() && bool("Size mismatch") );
 
+      viennacl::tools::profiler_scope profile("inner_prod", viennacl::traits::active_handle_id(vec1),
+                                              2.0 * sizeof(T) * vec1.size(), 2.0 * vec1.size());
+
       switch (viennacl::traits::handle(vec1).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
@@ -495,6 +503,9 @@ namespace viennacl
       assert( x.size() == y_tuple.const_at(0).size() && bool("Size mismatch") );
       assert( result.size() == y_tuple.const_size() && bool("Number of elements does not match result size") );
 
+      viennacl::tools::profiler_scope profile("inner_prod", viennacl::traits::active_handle_id(x),
+                                              (y_tuple.const_size() + 1.0) * sizeof(T) * x.size(), 2.0 * y_tuple.const_size() * x.size());
+
       switch (viennacl::traits::handle(x).get_active_handle_id())
       {
         case viennacl::MAIN_MEMORY:
@@ -518,6 +529,56 @@ namespace viennacl
     }
 
 
+    /** @brief Computes x += alpha_1 * y1 + alpha_2 * y2 + ... + alpha_N * y_N
+     *
+     * The host backend updates x with all vectors in a single pass. On the other backends the update is carried out vector by vector, for which the coefficients are transferred to the host.
+     *
+     * @param x       The vector to be updated
+     * @param alpha   The coefficients alpha_1, ..., alpha_N. Needs to match the number of elements in y_tuple
+     * @param y_tuple A collection of vectors, all of the same size as x
+     */
+    template <typename T>
+    void multi_axpy(vector_base<T> & x,
+                    vector_base<T> const & alpha,
+                    vector_tuple<T> const & y_tuple)
+    {
+      assert( x.size() == y_tuple.const_at(0).size() && bool("Size mismatch") );
+      assert( alpha.size() == y_tuple.const_size() && bool("Number of coefficients does not match number of vectors") );
+
+      viennacl::tools::profiler_scope profile("multi_axpy", viennacl::traits::active_handle_id(x),
+                                              (y_tuple.const_size() + 2.0) * sizeof(T) * x.size(), 2.0 * y_tuple.const_size() * x.size());
+
+      switch (viennacl::traits::handle(x).get_active_handle_id())
+      {
+        case viennacl::MAIN_MEMORY:
+          viennacl::linalg::host_based::multi_axpy(x, alpha, y_tuple);
+          break;
+#if defined(VIENNACL_WITH_OPENCL) || defined(VIENNACL_WITH_CUDA)
+  #ifdef VIENNACL_WITH_OPENCL
+        case viennacl::OPENCL_MEMORY:
+  #endif
+  #ifdef VIENNACL_WITH_CUDA
+        case viennacl::CUDA_MEMORY:
+  #endif
+        {
+          std::size_t inc_alpha = viennacl::traits::stride(alpha);
+          std::vector<T> temp((alpha.size() - 1) * inc_alpha + 1);
+          viennacl::backend::memory_read(viennacl::traits::handle(alpha), sizeof(T) * viennacl::traits::start(alpha), sizeof(T) * temp.size(), &(temp[0]));
+          for (std::size_t j=0; j<y_tuple.const_size(); ++j)
+            viennacl::linalg::avbv(x,
+                                   x,                   T(1),                1, false, false,
+                                   y_tuple.const_at(j), temp[j * inc_alpha], 1, false, false);
+          break;
+        }
+#endif
+        case viennacl::MEMORY_NOT_INITIALIZED:
+          throw memory_exception("not initialised!");
+        default:
+          throw memory_exception("not implemented");
+      }
+    }
+
+
     /** @brief Computes the l^1-norm of a vector - dispatcher interface
     *
     * @param vec The vector
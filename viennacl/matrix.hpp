@@ -31,7 +31,6 @@
 #include "viennacl/tools/matrix_size_deducer.hpp"
 #include "viennacl/meta/result_of.hpp"
 #include "viennacl/meta/enable_if.hpp"
-//#include "viennacl/rand/utils.hpp"
 #include "viennacl/traits/handle.hpp"
 
 namespace viennacl
@@ -142,12 +141,6 @@ namespace viennacl
 
 
 
-//#ifdef VIENNACL_WITH_OPENCL
-//  template<class SCALARTYPE, class DISTRIBUTION>
-//  rand::random_matrix_t<SCALARTYPE, DISTRIBUTION> random_matrix(unsigned int size1, unsigned int size2, DISTRIBUTION const & distribution){
-//      return rand::random_matrix_t<SCALARTYPE,DISTRIBUTION>(size1,size2,distribution);
-//  }
-//#endif
 
   template <typename LHS, typename RHS, typename OP>
   class matrix_expression
@@ -362,16 +355,6 @@ namespace viennacl
         return *this;
       }
 
-      /** @brief Creates the matrix from the supplied random matrix. */
-      /*template<class DISTRIBUTION>
-      matrix(rand::random_matrix_t<SCALARTYPE, DISTRIBUTION> const & m) : rows_(m.size1), columns_(m.size2)
-      {
-        if (internal_size() > 0)
-        {
-          viennacl::backend::memory_create(elements_, sizeof(SCALARTYPE)*internal_size());
-          rand::buffer_dumper<SCALARTYPE, DISTRIBUTION>::dump(elements_,m.distribution,0,internal_size());
-        }
-      }*/
 
 
 
@@ -362,6 +362,12 @@ namespace viennacl
       enum { value = true };
     };
 
+    template <typename MatrixType>
+    struct is_any_sparse_matrix<viennacl::linalg::scaled_operator<MatrixType> >
+    {
+      enum { value = true };
+    };
+
     template <typename T>
     struct is_any_sparse_matrix<const T>
     {
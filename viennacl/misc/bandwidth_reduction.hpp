@@ -20,11 +20,14 @@
 
 
 /** @file viennacl/misc/bandwidth_reduction.hpp
-    @brief Convenience include for bandwidth reduction algorithms such as Cuthill-McKee or Gibbs-Poole-Stockmeyer.  Experimental.
+    @brief Convenience include for bandwidth reduction algorithms such as Cuthill-McKee or Gibbs-Poole-Stockmeyer, as well as for the reordering of compressed_matrix by reverse Cuthill-McKee and nested dissection.
 */
 
 #include "viennacl/misc/cuthill_mckee.hpp"
 #include "viennacl/misc/gibbs_poole_stockmeyer.hpp"
+#include "viennacl/misc/reverse_cuthill_mckee.hpp"
+#include "viennacl/misc/nested_dissection.hpp"
+#include "viennacl/misc/permutation.hpp"
 
 
 namespace viennacl
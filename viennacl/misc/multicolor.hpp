@@ -0,0 +1,182 @@
+#ifndef VIENNACL_MISC_MULTICOLOR_HPP
+#define VIENNACL_MISC_MULTICOLOR_HPP
+
+/* =========================================================================
+   Copyright (c) 2010-2013, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+
+/** @file viennacl/misc/multicolor.hpp
+*    @brief Multicolor reordering of a compressed_matrix based on a parallel graph coloring.
+*
+*   Rows of the same color are not coupled, hence they can be processed in parallel by Gauss-Seidel-type sweeps and triangular solves.
+*/
+
+#include <vector>
+
+#include "viennacl/forwards.h"
+#include "viennacl/compressed_matrix.hpp"
+#include "viennacl/misc/reverse_cuthill_mckee.hpp"
+
+namespace viennacl
+{
+
+  namespace detail
+  {
+
+    /** @brief Pseudo-random priority of node i for the Jones-Plassmann coloring. Ties are broken by the node index. */
+    inline unsigned int multicolor_priority(unsigned int i)
+    {
+      unsigned int h = i * 2654435761u;
+      h ^= h >> 16;
+      h *= 0x45d9f3bu;
+      h ^= h >> 16;
+      return h;
+    }
+
+    /** @brief Returns true if node i has precedence over node j in the Jones-Plassmann coloring */
+    inline bool multicolor_precedes(unsigned int i, unsigned int j)
+    {
+      unsigned int p_i = multicolor_priority(i);
+      unsigned int p_j = multicolor_priority(j);
+      return p_i > p_j || (p_i == p_j && i < j);
+    }
+
+    /** @brief Colors the graph such that no two adjacent nodes share a color (Jones and Plassmann).
+    *
+    * In each round, all uncolored nodes with higher priority than all of their uncolored neighbors form an independent set and obtain the smallest color not used by their neighbors.
+    * The rounds are processed in parallel if OpenMP is enabled. The result does not depend on the number of threads.
+    *
+    * @param graph    The adjacency structure
+    * @param colors   On output, the color of each node
+    * @return The number of colors
+    */
+    inline unsigned int multicolor_coloring(csr_graph const & graph, std::vector<unsigned int> & colors)
+    {
+      std::size_t n = graph.size();
+      unsigned int const uncolored = static_cast<unsigned int>(-1);
+      colors.assign(n, uncolored);
+
+      std::vector<unsigned int> worklist(n);
+      for (std::size_t i=0; i<n; ++i)
+        worklist[i] = static_cast<unsigned int>(i);
+
+      std::vector<unsigned int> new_colors(n);
+      unsigned int num_colors = 0;
+      while (worklist.size() > 0)
+      {
+        long worklist_size = static_cast<long>(worklist.size());
+
+        // Step 1: Find the independent set and its colors (colors are written in step 2, so that all threads see the state of the previous round):
+#ifdef VIENNACL_WITH_OPENMP
+        #pragma omp parallel
+#endif
+        {
+          std::vector<bool> used;
+#ifdef VIENNACL_WITH_OPENMP
+          #pragma omp for
+#endif
+          for (long k=0; k<worklist_size; ++k)
+          {
+            unsigned int i = worklist[static_cast<std::size_t>(k)];
+            bool is_local_maximum = true;
+            used.assign(graph.degree(i) + 1, false);
+            for (unsigned int const * it = graph.begin(i); it != graph.end(i); ++it)
+            {
+              if (colors[*it] == uncolored)
+              {
+                if (multicolor_precedes(*it, i))
+                {
+                  is_local_maximum = false;
+                  break;
+                }
+              }
+              else if (colors[*it] < used.size())
+                used[colors[*it]] = true;
+            }
+
+            unsigned int color = uncolored;
+            if (is_local_maximum)
+            {
+              color = 0;
+              while (used[color])
+                ++color;
+            }
+            new_colors[i] = color;
+          }
+        }
+
+        // Step 2: Assign colors and shrink the worklist:
+        std::size_t remaining = 0;
+        for (std::size_t k=0; k<worklist.size(); ++k)
+        {
+          unsigned int i = worklist[k];
+          if (new_colors[i] != uncolored)
+          {
+            colors[i] = new_colors[i];
+            num_colors = std::max(num_colors, new_colors[i] + 1);
+          }
+          else
+            worklist[remaining++] = i;
+        }
+        worklist.resize(remaining);
+      }
+
+      return num_colors;
+    }
+
+  } //namespace detail
+
+
+  /** @brief Tag for the multicolor reordering */
+  class multicolor_tag {};
+
+
+  /** @brief Computes a multicolor ordering of a compressed_matrix: The rows are sorted by the colors of a graph coloring of the symmetrized sparsity pattern A + A^T.
+   *
+   * Within a color, the original order of the rows is kept. Rows of the same color do not couple, thus the lower triangular part of the reordered matrix
+   * has at most as many levels as there are colors.
+   *
+   * @param matrix  The square system matrix. May reside in any memory domain.
+   * @param tag     Tag selecting the multicolor reordering
+   * @return permutation vector r. r[l] = i means that the new label of node i will be l. Use viennacl::permute() to apply it to the matrix and to vectors.
+   */
+  template <typename NumericT, unsigned int AlignmentV>
+  std::vector<int> reorder(viennacl::compressed_matrix<NumericT, AlignmentV> const & matrix,
+                           multicolor_tag const & /*tag*/)
+  {
+    detail::csr_graph graph(matrix);
+
+    std::vector<unsigned int> colors;
+    unsigned int num_colors = detail::multicolor_coloring(graph, colors);
+
+    // Counting sort by color:
+    std::vector<std::size_t> color_offsets(num_colors + 1);
+    for (std::size_t i=0; i<colors.size(); ++i)
+      ++color_offsets[colors[i] + 1];
+    for (std::size_t c=0; c<num_colors; ++c)
+      color_offsets[c+1] += color_offsets[c];
+
+    std::vector<int> r(colors.size());
+    for (std::size_t i=0; i<colors.size(); ++i)
+      r[color_offsets[colors[i]]++] = static_cast<int>(i);
+    return r;
+  }
+
+} //namespace viennacl
+
+
+#endif
@@ -0,0 +1,219 @@
+#ifndef VIENNACL_MISC_NESTED_DISSECTION_HPP
+#define VIENNACL_MISC_NESTED_DISSECTION_HPP
+
+/* =========================================================================
+   Copyright (c) 2010-2013, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+
+/** @file viennacl/misc/nested_dissection.hpp
+*    @brief Nested dissection reordering of a compressed_matrix based on level-set bisection.
+*
+*   Each partition is split by the median level of a breadth-first search from a pseudo-peripheral node.
+*   The partitions of one bisection step are processed in parallel if OpenMP is enabled.
+*/
+
+#include <vector>
+
+#include "viennacl/forwards.h"
+#include "viennacl/compressed_matrix.hpp"
+#include "viennacl/misc/reverse_cuthill_mckee.hpp"
+
+namespace viennacl
+{
+
+  namespace detail
+  {
+
+    /** @brief A partition of the graph in nested dissection, occupying the new labels [begin, begin + nodes.size()) */
+    struct nested_dissection_partition
+    {
+      int id;
+      std::size_t begin;
+      std::vector<unsigned int> nodes;
+    };
+
+    /** @brief Writes the new labels of the nodes of a partition in reverse Cuthill-McKee order */
+    inline void nested_dissection_leaf(csr_graph const & graph, nested_dissection_partition const & partition,
+                                       std::vector<int> & level, std::vector<unsigned int> & position, int const * part,
+                                       std::vector<int> & r)
+    {
+      std::vector<unsigned int> ordering;
+      cuthill_mckee_ordering(graph, partition.nodes, level, position, ordering, part, partition.id);
+      for (std::size_t i=0; i<ordering.size(); ++i)
+        r[partition.begin + i] = static_cast<int>(ordering[ordering.size() - 1 - i]);
+    }
+
+    /** @brief Splits a partition into two parts separated by a level of a breadth-first search. The separator is numbered last.
+    *
+    * Small or non-separable partitions are ordered by reverse Cuthill-McKee and yield no children.
+    * A disconnected partition is split into its first connected component and the remaining nodes.
+    */
+    inline void nested_dissection_step(csr_graph const & graph, nested_dissection_partition const & partition, std::size_t min_partition_size,
+                                       std::vector<int> & level, std::vector<unsigned int> & position, int const * part,
+                                       std::vector<int> & r, std::vector<nested_dissection_partition> & children)
+    {
+      std::size_t size = partition.nodes.size();
+      if (size <= min_partition_size)
+      {
+        nested_dissection_leaf(graph, partition, level, position, part, r);
+        return;
+      }
+
+      std::vector<unsigned int> order;
+      std::vector<std::size_t> level_starts;
+      unsigned int start = pseudo_peripheral_node(graph, partition.nodes[0], level, position, part, partition.id);
+      std::size_t num_levels = bfs_levels(graph, start, level, position, order, level_starts, false, part, partition.id);
+
+      if (order.size() < size) // disconnected: each connected component becomes a partition
+      {
+        std::size_t begin = partition.begin;
+        for (std::size_t i=0; ; ++i)
+        {
+          children.push_back(nested_dissection_partition());
+          children.back().begin = begin;
+          children.back().nodes.swap(order);
+          begin += children.back().nodes.size();
+
+          while (i < size && level[partition.nodes[i]] >= 0)
+            ++i;
+          if (i == size)
+            break;
+          bfs_levels(graph, partition.nodes[i], level, position, order, level_starts, false, part, partition.id);
+        }
+        for (std::size_t i=0; i<children.size(); ++i)
+          bfs_reset(children[i].nodes, level);
+        return;
+      }
+
+      bfs_reset(order, level);
+
+      if (num_levels < 3)
+      {
+        nested_dissection_leaf(graph, partition, level, position, part, r);
+        return;
+      }
+
+      // separator: the level containing the median node, such that both parts are nonempty
+      std::size_t separator = 1;
+      while (separator + 2 < num_levels && level_starts[separator + 1] <= size / 2)
+        ++separator;
+
+      std::size_t separator_begin = level_starts[separator];
+      std::size_t separator_end   = level_starts[separator + 1];
+
+      children.resize(2);
+      children[0].begin = partition.begin;
+      children[0].nodes.assign(order.begin(), order.begin() + separator_begin);
+      children[1].begin = partition.begin + separator_begin;
+      children[1].nodes.assign(order.begin() + separator_end, order.end());
+
+      std::size_t offset = partition.begin + separator_begin + (order.size() - separator_end);
+      for (std::size_t i=separator_begin; i<separator_end; ++i)
+        r[offset + i - separator_begin] = static_cast<int>(order[i]);
+    }
+
+  } //namespace detail
+
+
+  /** @brief Tag for the nested dissection reordering */
+  class nested_dissection_tag
+  {
+    public:
+      /** @brief CTOR
+      *
+      * @param min_partition_size   Partitions with at most this number of nodes are not split further, but ordered by reverse Cuthill-McKee
+      */
+      nested_dissection_tag(std::size_t min_partition_size = 64) : min_partition_size_(min_partition_size) {}
+
+      std::size_t min_partition_size() const { return min_partition_size_; }
+      void min_partition_size(std::size_t s) { min_partition_size_ = s; }
+
+    private:
+      std::size_t min_partition_size_;
+  };
+
+
+  /** @brief Computes a nested dissection ordering of a compressed_matrix.
+   *
+   * The graph of the symmetrized sparsity pattern A + A^T is recursively bisected by level-set separators. Each separator is numbered after the two parts it separates,
+   * which reduces the fill-in of factorizations and groups the unknowns into independent blocks. The partitions are ordered by reverse Cuthill-McKee once they are small enough.
+   *
+   * @param matrix  The square system matrix. May reside in any memory domain.
+   * @param tag     Nested dissection parameters
+   * @return permutation vector r. r[l] = i means that the new label of node i will be l. Use viennacl::permute() to apply it to the matrix and to vectors.
+   */
+  template <typename NumericT, unsigned int AlignmentV>
+  std::vector<int> reorder(viennacl::compressed_matrix<NumericT, AlignmentV> const & matrix,
+                           nested_dissection_tag const & tag)
+  {
+    detail::csr_graph graph(matrix);
+    std::size_t n = graph.size();
+
+    std::vector<int> part(n, 0);
+    std::vector<int> level(n, -1);
+    std::vector<unsigned int> position(n);
+    std::vector<int> r(n);
+
+    std::vector<detail::nested_dissection_partition> partitions(1);
+    partitions[0].id = 0;
+    partitions[0].begin = 0;
+    partitions[0].nodes.resize(n);
+    for (std::size_t i=0; i<n; ++i)
+      partitions[0].nodes[i] = static_cast<unsigned int>(i);
+
+    int next_id = 1;
+    while (partitions.size() > 0)
+    {
+      // Bisect all partitions of the current level:
+      std::vector< std::vector<detail::nested_dissection_partition> > children(partitions.size());
+      long num_partitions = static_cast<long>(partitions.size());
+#ifdef VIENNACL_WITH_OPENMP
+      #pragma omp parallel for schedule(dynamic)
+#endif
+      for (long i=0; i<num_partitions; ++i)
+        detail::nested_dissection_step(graph, partitions[static_cast<std::size_t>(i)], tag.min_partition_size(), level, position, &(part[0]), r, children[static_cast<std::size_t>(i)]);
+
+      // Collect the new partitions. Separators keep the id of their parent, which is not used any further:
+      std::vector<detail::nested_dissection_partition> next_partitions;
+      for (std::size_t i=0; i<children.size(); ++i)
+        for (std::size_t j=0; j<children[i].size(); ++j)
+        {
+          next_partitions.push_back(children[i][j]);
+          next_partitions.back().id = next_id++;
+        }
+
+      long num_next = static_cast<long>(next_partitions.size());
+#ifdef VIENNACL_WITH_OPENMP
+      #pragma omp parallel for
+#endif
+      for (long i=0; i<num_next; ++i)
+      {
+        detail::nested_dissection_partition const & p = next_partitions[static_cast<std::size_t>(i)];
+        for (std::size_t j=0; j<p.nodes.size(); ++j)
+          part[p.nodes[j]] = p.id;
+      }
+
+      partitions.swap(next_partitions);
+    }
+
+    return r;
+  }
+
+} //namespace viennacl
+
+
+#endif
@@ -0,0 +1,175 @@
+#ifndef VIENNACL_MISC_PERMUTATION_HPP
+#define VIENNACL_MISC_PERMUTATION_HPP
+
+/* =========================================================================
+   Copyright (c) 2010-2013, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+
+/** @file viennacl/misc/permutation.hpp
+*    @brief Applies node permutations as returned by viennacl::reorder() to a compressed_matrix and to vectors.
+*/
+
+#include <vector>
+#include <cassert>
+
+#include "viennacl/forwards.h"
+#include "viennacl/vector.hpp"
+#include "viennacl/compressed_matrix.hpp"
+#include "viennacl/backend/memory.hpp"
+#include "viennacl/tools/sparse_matrix_builder.hpp"
+
+namespace viennacl
+{
+
+  namespace detail
+  {
+    /** @brief Computes the triplets of the symmetrically permuted matrix P A P^T. Alignment padding is skipped.
+    *
+    * @param A             The square matrix. May reside in any memory domain.
+    * @param r             Permutation vector as returned by viennacl::reorder()
+    * @param row_indices   Row index of each nonzero of P A P^T
+    * @param col_indices   Column index of each nonzero of P A P^T
+    * @param sources       Index of each nonzero of P A P^T in the value array of A
+    */
+    template <typename NumericT, unsigned int AlignmentV>
+    void permuted_pattern(viennacl::compressed_matrix<NumericT, AlignmentV> const & A, std::vector<int> const & r,
+                          std::vector<unsigned int> & row_indices, std::vector<unsigned int> & col_indices, std::vector<unsigned int> & sources)
+    {
+      assert( (A.size1() == A.size2()) && bool("Symmetric permutation requires a square matrix!"));
+      assert( (r.size() == A.size1()) && bool("Size mismatch of permutation vector"));
+
+      std::size_t n = A.size1();
+      row_indices.clear();
+      col_indices.clear();
+      sources.clear();
+      if (n == 0 || A.nnz() == 0)
+        return;
+
+      viennacl::backend::typesafe_host_array<unsigned int> row_buffer(A.handle1(), n + 1);
+      viennacl::backend::typesafe_host_array<unsigned int> col_buffer(A.handle2(), A.nnz());
+      viennacl::backend::memory_read(A.handle1(), 0, row_buffer.raw_size(), row_buffer.get());
+      viennacl::backend::memory_read(A.handle2(), 0, col_buffer.raw_size(), col_buffer.get());
+
+      std::vector<unsigned int> r_inverse(n);
+      for (std::size_t l=0; l<n; ++l)
+        r_inverse[static_cast<std::size_t>(r[l])] = static_cast<unsigned int>(l);
+
+      row_indices.reserve(A.nnz());
+      col_indices.reserve(A.nnz());
+      sources.reserve(A.nnz());
+      for (std::size_t i=0; i<n; ++i)
+        for (std::size_t k = row_buffer[i]; k < row_buffer[i+1]; ++k)
+        {
+          std::size_t j = col_buffer[k];
+          if (AlignmentV > 1 && j == 0 && k > row_buffer[i])  //alignment padding (column indices are sorted)
+            continue;
+          row_indices.push_back(r_inverse[i]);
+          col_indices.push_back(r_inverse[j]);
+          sources.push_back(static_cast<unsigned int>(k));
+        }
+    }
+
+    /** @brief Gathers the values of the nonzeros of A given by 'sources', cf. permuted_pattern() */
+    template <typename NumericT, unsigned int AlignmentV>
+    void permuted_values(viennacl::compressed_matrix<NumericT, AlignmentV> const & A, std::vector<unsigned int> const & sources,
+                         std::vector<NumericT> & values)
+    {
+      std::vector<NumericT> elements(A.nnz());
+      if (elements.size() > 0)
+        viennacl::backend::memory_read(A.handle(), 0, sizeof(NumericT) * elements.size(), &(elements[0]));
+
+      values.resize(sources.size());
+      for (std::size_t k=0; k<sources.size(); ++k)
+        values[k] = elements[sources[k]];
+    }
+  }
+
+  /** @brief Replaces a square compressed_matrix A by the symmetrically permuted matrix P A P^T, i.e. new entry (l, m) is old entry (r[l], r[m]).
+  *
+  * @param A   The matrix to be permuted in place. The memory domain is preserved.
+  * @param r   Permutation vector as returned by viennacl::reorder(): r[l] = i means that row and column i become row and column l.
+  */
+  template <typename NumericT, unsigned int AlignmentV>
+  void permute(viennacl::compressed_matrix<NumericT, AlignmentV> & A, std::vector<int> const & r)
+  {
+    std::vector<unsigned int> row_indices;
+    std::vector<unsigned int> col_indices;
+    std::vector<unsigned int> sources;
+    detail::permuted_pattern(A, r, row_indices, col_indices, sources);
+    if (sources.size() == 0)
+      return;
+
+    std::vector<NumericT> values;
+    detail::permuted_values(A, sources, values);
+
+    tools::sparse_matrix_builder(A.size1(), A.size2(), row_indices, col_indices, AlignmentV).assemble(values, A);
+  }
+
+
+  /** @brief Permutes the entries of a vector in place: new entry l is old entry r[l]. Use this for right hand sides of the system permuted by viennacl::permute().
+  *
+  * @param x   The vector to be permuted
+  * @param r   Permutation vector as returned by viennacl::reorder()
+  */
+  template <typename NumericT, unsigned int AlignmentV>
+  void permute(viennacl::vector<NumericT, AlignmentV> & x, std::vector<int> const & r)
+  {
+    assert( (r.size() == x.size()) && bool("Size mismatch of permutation vector"));
+
+    std::vector<NumericT> x_old(x.size());
+    std::vector<NumericT> x_new(x.size());
+    viennacl::fast_copy(x.begin(), x.end(), x_old.begin());
+
+    long size = static_cast<long>(x.size());
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel for
+#endif
+    for (long l=0; l<size; ++l)
+      x_new[static_cast<std::size_t>(l)] = x_old[static_cast<std::size_t>(r[static_cast<std::size_t>(l)])];
+
+    viennacl::fast_copy(x_new.begin(), x_new.end(), x.begin());
+  }
+
+
+  /** @brief Reverts viennacl::permute() on a vector in place: old entry r[l] is new entry l. Use this for solutions of the system permuted by viennacl::permute().
+  *
+  * @param x   The vector to be permuted
+  * @param r   Permutation vector as returned by viennacl::reorder()
+  */
+  template <typename NumericT, unsigned int AlignmentV>
+  void inverse_permute(viennacl::vector<NumericT, AlignmentV> & x, std::vector<int> const & r)
+  {
+    assert( (r.size() == x.size()) && bool("Size mismatch of permutation vector"));
+
+    std::vector<NumericT> x_old(x.size());
+    std::vector<NumericT> x_new(x.size());
+    viennacl::fast_copy(x.begin(), x.end(), x_old.begin());
+
+    long size = static_cast<long>(x.size());
+#ifdef VIENNACL_WITH_OPENMP
+    #pragma omp parallel for
+#endif
+    for (long l=0; l<size; ++l)
+      x_new[static_cast<std::size_t>(r[static_cast<std::size_t>(l)])] = x_old[static_cast<std::size_t>(l)];
+
+    viennacl::fast_copy(x_new.begin(), x_new.end(), x.begin());
+  }
+
+} //namespace viennacl
+
+
+#endif
@@ -0,0 +1,394 @@
+#ifndef VIENNACL_MISC_REVERSE_CUTHILL_MCKEE_HPP
+#define VIENNACL_MISC_REVERSE_CUTHILL_MCKEE_HPP
+
+/* =========================================================================
+   Copyright (c) 2010-2013, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+
+/** @file viennacl/misc/reverse_cuthill_mckee.hpp
+*    @brief Reverse Cuthill-McKee reordering operating directly on the CSR arrays of a compressed_matrix.
+*
+*   In contrast to the algorithms in cuthill_mckee.hpp, no std::vector<std::map<> > representation of the matrix is required.
+*   Each level of the breadth-first search is processed in parallel if OpenMP is enabled.
+*/
+
+#include <vector>
+#include <algorithm>
+#include <cassert>
+
+#include "viennacl/forwards.h"
+#include "viennacl/compressed_matrix.hpp"
+#include "viennacl/backend/memory.hpp"
+
+#ifdef VIENNACL_WITH_OPENMP
+#include <omp.h>
+#endif
+
+// Minimum number of nodes in a level of the breadth-first search for processing the level in parallel:
+#ifndef VIENNACL_OPENMP_BFS_MIN_SIZE
+  #define VIENNACL_OPENMP_BFS_MIN_SIZE  1000
+#endif
+
+namespace viennacl
+{
+
+  namespace detail
+  {
+
+    /** @brief Adjacency structure of the symmetrized sparsity pattern (A + A^T) of a square CSR matrix without diagonal entries */
+    class csr_graph
+    {
+      public:
+        /** @brief Sets up the graph from the sparsity pattern of a compressed_matrix. The matrix may reside in any memory domain. */
+        template <typename NumericT, unsigned int AlignmentV>
+        explicit csr_graph(viennacl::compressed_matrix<NumericT, AlignmentV> const & A)
+        {
+          assert( (A.size1() == A.size2()) && bool("Reordering requires a square matrix!"));
+
+          viennacl::backend::typesafe_host_array<unsigned int> row_buffer(A.handle1(), A.size1() + 1);
+          viennacl::backend::typesafe_host_array<unsigned int> col_buffer(A.handle2(), A.nnz());
+          viennacl::backend::memory_read(A.handle1(), 0, row_buffer.raw_size(), row_buffer.get());
+          viennacl::backend::memory_read(A.handle2(), 0, col_buffer.raw_size(), col_buffer.get());
+
+          init(A.size1(), row_buffer, col_buffer, AlignmentV > 1);
+        }
+
+        /** @brief Number of nodes */
+        std::size_t size() const { return row_ptr_.size() - 1; }
+
+        /** @brief Number of neighbors of node i */
+        unsigned int degree(unsigned int i) const { return row_ptr_[i+1] - row_ptr_[i]; }
+
+        /** @brief Pointer to the first neighbor of node i */
+        unsigned int const * begin(unsigned int i) const { return &(cols_[0]) + row_ptr_[i]; }
+
+        /** @brief Pointer past the last neighbor of node i */
+        unsigned int const * end(unsigned int i) const { return &(cols_[0]) + row_ptr_[i+1]; }
+
+      private:
+        template <typename RowArrayT, typename ColArrayT>
+        void init(std::size_t n, RowArrayT const & row_buffer, ColArrayT const & col_buffer, bool padded)
+        {
+          // Step 1: Number of entries of A + A^T in each row (duplicates are removed below):
+          row_ptr_.resize(n + 1);
+          std::vector<unsigned int> row_nnz(n + 1);
+          for (std::size_t i=0; i<n; ++i)
+            for (std::size_t k = row_buffer[i]; k < row_buffer[i+1]; ++k)
+            {
+              std::size_t j = col_buffer[k];
+              if (j == i || (padded && j == 0 && k > row_buffer[i]))  //diagonal or alignment padding (column indices are sorted)
+                continue;
+              ++row_nnz[i+1];
+              ++row_nnz[j+1];
+            }
+          for (std::size_t i=0; i<n; ++i)
+            row_nnz[i+1] += row_nnz[i];
+
+          // Step 2: Scatter entries of A and A^T:
+          std::vector<unsigned int> cols(std::max<std::size_t>(row_nnz[n], 1));
+          std::vector<unsigned int> fill(row_nnz.begin(), row_nnz.end() - 1);
+          for (std::size_t i=0; i<n; ++i)
+            for (std::size_t k = row_buffer[i]; k < row_buffer[i+1]; ++k)
+            {
+              std::size_t j = col_buffer[k];
+              if (j == i || (padded && j == 0 && k > row_buffer[i]))
+                continue;
+              cols[fill[i]++] = static_cast<unsigned int>(j);
+              cols[fill[j]++] = static_cast<unsigned int>(i);
+            }
+
+          // Step 3: Sort neighbors and remove duplicates:
+          long size = static_cast<long>(n);
+#ifdef VIENNACL_WITH_OPENMP
+          #pragma omp parallel for
+#endif
+          for (long i=0; i<size; ++i)
+          {
+            unsigned int * row_begin = &(cols[0]) + row_nnz[static_cast<std::size_t>(i)];
+            unsigned int * row_end   = &(cols[0]) + row_nnz[static_cast<std::size_t>(i+1)];
+            std::sort(row_begin, row_end);
+            fill[static_cast<std::size_t>(i)] = static_cast<unsigned int>(std::unique(row_begin, row_end) - row_begin);
+          }
+
+          row_ptr_[0] = 0;
+          for (std::size_t i=0; i<n; ++i)
+            row_ptr_[i+1] = row_ptr_[i] + fill[i];
+
+          cols_.resize(std::max<std::size_t>(row_ptr_[n], 1));
+          for (std::size_t i=0; i<n; ++i)
+            std::copy(cols.begin() + row_nnz[i], cols.begin() + row_nnz[i] + fill[i], cols_.begin() + row_ptr_[i]);
+        }
+
+        std::vector<unsigned int> row_ptr_;
+        std::vector<unsigned int> cols_;
+    };
+
+
+    /** @brief Sort key for the nodes of a level in Cuthill-McKee order: position of the first neighbor in the previous level, degree, index */
+    struct cuthill_mckee_key
+    {
+      unsigned int parent_position;
+      unsigned int degree;
+      unsigned int node;
+
+      bool operator<(cuthill_mckee_key const & other) const
+      {
+        if (parent_position != other.parent_position)
+          return parent_position < other.parent_position;
+        if (degree != other.degree)
+          return degree < other.degree;
+        return node < other.node;
+      }
+    };
+
+    /** @brief Returns true if node i takes part in a search restricted to the nodes with part[i] == part_id (all nodes if part is NULL) */
+    inline bool bfs_in_part(int const * part, int part_id, unsigned int i)
+    {
+      return part == NULL || part[i] == part_id;
+    }
+
+    /** @brief Level-synchronous breadth-first search starting at node 'start'.
+    *
+    * Only nodes i with level[i] < 0 and part[i] == part_id (or all nodes if part is NULL) are visited. The neighbors of each level are collected in parallel.
+    * The visited nodes are written to 'order' level by level, the first node of each level is order[level_starts[l]].
+    * For each visited node, level[i] is set to its level and position[i] to its index in 'order'.
+    *
+    * @param cuthill_mckee_order   If true, the nodes of each level are sorted by the position of their first neighbor in the previous level and by degree.
+    * @return The number of levels
+    */
+    inline std::size_t bfs_levels(csr_graph const & graph, unsigned int start,
+                                  std::vector<int> & level, std::vector<unsigned int> & position,
+                                  std::vector<unsigned int> & order, std::vector<std::size_t> & level_starts,
+                                  bool cuthill_mckee_order,
+                                  int const * part = NULL, int part_id = 0)
+    {
+      std::vector<std::size_t> counts;
+      std::vector<unsigned int> candidates;
+      std::vector<cuthill_mckee_key> keys;
+
+      order.clear();
+      level_starts.clear();
+
+      order.push_back(start);
+      level_starts.push_back(0);
+      level[start] = 0;
+      position[start] = 0;
+
+      for (int current_level = 0; ; ++current_level)
+      {
+        std::size_t level_begin = level_starts.back();
+        std::size_t level_end   = order.size();
+        long level_size = static_cast<long>(level_end - level_begin);
+
+        // Step 1: Count the unvisited neighbors of each node in the current level:
+        counts.resize(static_cast<std::size_t>(level_size) + 1);
+        counts[0] = 0;
+#ifdef VIENNACL_WITH_OPENMP
+        #pragma omp parallel for if (level_size > VIENNACL_OPENMP_BFS_MIN_SIZE)
+#endif
+        for (long i=0; i<level_size; ++i)
+        {
+          unsigned int node = order[level_begin + static_cast<std::size_t>(i)];
+          std::size_t num_unvisited = 0;
+          for (unsigned int const * it = graph.begin(node); it != graph.end(node); ++it)
+            if (bfs_in_part(part, part_id, *it) && level[*it] < 0)   //part is checked first: nodes of other parts may be visited concurrently
+              ++num_unvisited;
+          counts[static_cast<std::size_t>(i) + 1] = num_unvisited;
+        }
+        for (std::size_t i=0; i<static_cast<std::size_t>(level_size); ++i)
+          counts[i+1] += counts[i];
+
+        // Step 2: Collect the unvisited neighbors:
+        candidates.resize(counts[static_cast<std::size_t>(level_size)]);
+#ifdef VIENNACL_WITH_OPENMP
+        #pragma omp parallel for if (level_size > VIENNACL_OPENMP_BFS_MIN_SIZE)
+#endif
+        for (long i=0; i<level_size; ++i)
+        {
+          unsigned int node = order[level_begin + static_cast<std::size_t>(i)];
+          std::size_t offset = counts[static_cast<std::size_t>(i)];
+          for (unsigned int const * it = graph.begin(node); it != graph.end(node); ++it)
+            if (bfs_in_part(part, part_id, *it) && level[*it] < 0)
+              candidates[offset++] = *it;
+        }
+
+        // Step 3: Remove duplicates, keeping the first occurrence:
+        for (std::size_t i=0; i<candidates.size(); ++i)
+        {
+          unsigned int node = candidates[i];
+          if (level[node] < 0)
+          {
+            level[node] = current_level + 1;
+            order.push_back(node);
+          }
+        }
+
+        if (order.size() == level_end)
+          break;
+        level_starts.push_back(level_end);
+
+        // Step 4: Cuthill-McKee order within the new level:
+        long next_size = static_cast<long>(order.size() - level_end);
+        if (cuthill_mckee_order)
+        {
+          keys.resize(static_cast<std::size_t>(next_size));
+#ifdef VIENNACL_WITH_OPENMP
+          #pragma omp parallel for if (next_size > VIENNACL_OPENMP_BFS_MIN_SIZE)
+#endif
+          for (long i=0; i<next_size; ++i)
+          {
+            unsigned int node = order[level_end + static_cast<std::size_t>(i)];
+            cuthill_mckee_key key;
+            key.parent_position = static_cast<unsigned int>(level_end);
+            key.degree = graph.degree(node);
+            key.node = node;
+            for (unsigned int const * it = graph.begin(node); it != graph.end(node); ++it)
+              if (bfs_in_part(part, part_id, *it) && level[*it] == current_level)
+                key.parent_position = std::min(key.parent_position, position[*it]);
+            keys[static_cast<std::size_t>(i)] = key;
+          }
+          std::sort(keys.begin(), keys.end());
+          for (std::size_t i=0; i<keys.size(); ++i)
+            order[level_end + i] = keys[i].node;
+        }
+
+        for (std::size_t i=level_end; i<order.size(); ++i)
+          position[order[i]] = static_cast<unsigned int>(i);
+      }
+
+      return level_starts.size();
+    }
+
+    /** @brief Resets the level of all nodes in 'nodes' to 'unvisited' */
+    inline void bfs_reset(std::vector<unsigned int> const & nodes, std::vector<int> & level)
+    {
+      for (std::size_t i=0; i<nodes.size(); ++i)
+        level[nodes[i]] = -1;
+    }
+
+    /** @brief Finds a pseudo-peripheral node in the connected component of 'start' by repeated breadth-first searches (George and Liu).
+    *
+    * The node with minimum degree in the last level is taken as the next candidate as long as the number of levels increases. The levels of all visited nodes are reset afterwards.
+    */
+    inline unsigned int pseudo_peripheral_node(csr_graph const & graph, unsigned int start,
+                                               std::vector<int> & level, std::vector<unsigned int> & position,
+                                               int const * part = NULL, int part_id = 0)
+    {
+      std::vector<unsigned int> order;
+      std::vector<std::size_t> level_starts;
+
+      unsigned int node = start;
+      std::size_t num_levels = bfs_levels(graph, node, level, position, order, level_starts, false, part, part_id);
+      bfs_reset(order, level);
+
+      for (;;)
+      {
+        unsigned int candidate = order[level_starts.back()];
+        for (std::size_t i = level_starts.back() + 1; i < order.size(); ++i)
+          if (graph.degree(order[i]) < graph.degree(candidate))
+            candidate = order[i];
+
+        std::size_t candidate_levels = bfs_levels(graph, candidate, level, position, order, level_starts, false, part, part_id);
+        bfs_reset(order, level);
+
+        if (candidate_levels <= num_levels)
+          return node;
+
+        node = candidate;
+        num_levels = candidate_levels;
+      }
+    }
+
+    /** @brief Appends the Cuthill-McKee ordering of 'nodes' to 'result'. Each connected component is started at a pseudo-peripheral node.
+    *
+    * All nodes in 'nodes' must be unvisited (level < 0) and satisfy part[i] == part_id (if part is not NULL). They are marked as visited afterwards.
+    */
+    inline void cuthill_mckee_ordering(csr_graph const & graph, std::vector<unsigned int> const & nodes,
+                                       std::vector<int> & level, std::vector<unsigned int> & position,
+                                       std::vector<unsigned int> & result,
+                                       int const * part = NULL, int part_id = 0)
+    {
+      std::vector<unsigned int> order;
+      std::vector<std::size_t> level_starts;
+
+      for (std::size_t i=0; i<nodes.size(); ++i)
+      {
+        if (level[nodes[i]] >= 0)
+          continue;
+
+        unsigned int start = pseudo_peripheral_node(graph, nodes[i], level, position, part, part_id);
+        bfs_levels(graph, start, level, position, order, level_starts, true, part, part_id);
+        result.insert(result.end(), order.begin(), order.end());
+      }
+    }
+
+  } //namespace detail
+
+
+  /** @brief Tag for the reverse Cuthill-McKee algorithm operating on the CSR arrays of a compressed_matrix */
+  class reverse_cuthill_mckee_tag
+  {
+    public:
+      /** @brief CTOR
+      *
+      * @param reverse   If false, the (non-reversed) Cuthill-McKee ordering is computed
+      */
+      reverse_cuthill_mckee_tag(bool reverse = true) : reverse_(reverse) {}
+
+      bool reverse() const { return reverse_; }
+      void reverse(bool b) { reverse_ = b; }
+
+    private:
+      bool reverse_;
+  };
+
+
+  /** @brief Computes a node permutation reducing the bandwidth and the profile of a compressed_matrix by the reverse Cuthill-McKee algorithm.
+   *
+   * The symmetrized sparsity pattern A + A^T is used. Each connected component is started at a pseudo-peripheral node, and each level of the breadth-first search is processed in parallel if OpenMP is enabled.
+   *
+   * @param matrix  The square system matrix. May reside in any memory domain.
+   * @param tag     Tag selecting reverse Cuthill-McKee
+   * @return permutation vector r. r[l] = i means that the new label of node i will be l. Use viennacl::permute() to apply it to the matrix and to vectors.
+   */
+  template <typename NumericT, unsigned int AlignmentV>
+  std::vector<int> reorder(viennacl::compressed_matrix<NumericT, AlignmentV> const & matrix,
+                           reverse_cuthill_mckee_tag const & tag)
+  {
+    detail::csr_graph graph(matrix);
+    std::size_t n = graph.size();
+
+    std::vector<unsigned int> nodes(n);
+    for (std::size_t i=0; i<n; ++i)
+      nodes[i] = static_cast<unsigned int>(i);
+
+    std::vector<int> level(n, -1);
+    std::vector<unsigned int> position(n);
+    std::vector<unsigned int> ordering;
+    ordering.reserve(n);
+    detail::cuthill_mckee_ordering(graph, nodes, level, position, ordering);
+
+    std::vector<int> r(n);
+    for (std::size_t i=0; i<n; ++i)
+      r[i] = static_cast<int>(tag.reverse() ? ordering[n - 1 - i] : ordering[i]);
+    return r;
+  }
+
+} //namespace viennacl
+
+
+#endif
@@ -25,29 +25,36 @@
 #include <vector>
 #include "viennacl/ocl/context.hpp"
 #include "viennacl/ocl/enqueue.hpp"
+#include "viennacl/tools/mutex.hpp"
 
 namespace viennacl
 {
   namespace ocl
   {
 
-    /** @brief A backend that provides contexts for ViennaCL objects (vector, matrix, etc.) */
+    /** @brief A backend that provides contexts for ViennaCL objects (vector, matrix, etc.)
+    *
+    * The current context is selected per thread, so concurrent threads may work in different contexts without interfering.
+    * Creation and setup of contexts is serialized by a lock.
+    */
     template <bool dummy = false>  //never use parameter other than default (introduced for linkage issues only)
     class backend
     {
       public:
-        /** @brief Switches the current context to the context identified by i
+        /** @brief Switches the current context of the calling thread to the context identified by i
         *
         * @param i   ID of the new active context
         */
         static void switch_context(long i)
         {
-          current_context_id_ = i;
+          current_context_id() = i;
         }
 
         /** @brief Returns the current active context */
         static viennacl::ocl::context & context(long id)
         {
+          viennacl::tools::scoped_lock lock(mutex_);
+
           if (!initialized_[id])
           {
             //std::cout << "Initializing context no. " << current_context_id_ << std::endl;
@@ -65,10 +72,10 @@ namespace viennacl
           return contexts_[id];
         }
 
-        /** @brief Returns the current active context */
+        /** @brief Returns the current active context of the calling thread */
         static viennacl::ocl::context & current_context()
         {
-          return backend<dummy>::context(current_context_id_);
+          return backend<dummy>::context(current_context_id());
         }
 
         /** @brief Returns the current queue for the active device in the active context */
@@ -85,6 +92,8 @@ namespace viennacl
         static void setup_context(long i,
                                   std::vector<cl_device_id> const & devices)
         {
+          viennacl::tools::scoped_lock lock(mutex_);
+
           if (initialized_[i])
             std::cerr << "ViennaCL: Warning in init_context(): Providing a list of devices has no effect, because context for ViennaCL is already created!" << std::endl;
           else
@@ -109,6 +118,8 @@ namespace viennacl
         {
           assert(devices.size() == queues.size() && bool("ViennaCL expects one queue per device!"));
 
+          viennacl::tools::scoped_lock lock(mutex_);
+
           if (initialized_[i])
             std::cerr << "ViennaCL: Warning in init_context(): Providing a list of devices has no effect, because context for ViennaCL is already created!" << std::endl;
           else
@@ -157,29 +168,39 @@ namespace viennacl
         /** @brief Sets the context device type */
         static void set_context_device_type(long i, cl_device_type t)
         {
+          viennacl::tools::scoped_lock lock(mutex_);
           contexts_[i].default_device_type(t);
         }
 
         /** @brief Sets the maximum number of devices per context. Ignored if a device array is provided as well.  */
         static void set_context_device_num(long i, std::size_t num)
         {
+          viennacl::tools::scoped_lock lock(mutex_);
           contexts_[i].default_device_num(num);
         }
 
         /** @brief Sets the context device type */
         static void set_context_platform_index(long i, std::size_t pf_index)
         {
+          viennacl::tools::scoped_lock lock(mutex_);
           contexts_[i].platform_index(pf_index);
         }
 
       private:
-        static long current_context_id_;
+        /** @brief The ID of the current context of the calling thread. Zero for threads which never switched the context. */
+        static long & current_context_id()
+        {
+          static VIENNACL_THREAD_LOCAL long id = 0;
+          return id;
+        }
+
+        static viennacl::tools::mutex mutex_;
         static std::map<long, bool> initialized_;
         static std::map<long, viennacl::ocl::context> contexts_;
     };
 
     template <bool dummy>
-    long backend<dummy>::current_context_id_ = 0;
+    viennacl::tools::mutex backend<dummy>::mutex_;
 
     template <bool dummy>
     std::map<long, bool> backend<dummy>::initialized_;
@@ -194,7 +215,7 @@ namespace viennacl
       return viennacl::ocl::backend<>::current_context();
     }
 
-    /** @brief Convenience function for switching the current context */
+    /** @brief Convenience function for switching the current context of the calling thread */
     inline void switch_context(long i)
     {
       viennacl::ocl::backend<>::switch_context(i);
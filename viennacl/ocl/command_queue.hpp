@@ -33,6 +33,7 @@
 #include <sstream>
 #include "viennacl/ocl/context.hpp"
 #include "viennacl/ocl/device.hpp"
+#include "viennacl/ocl/event.hpp"
 #include "viennacl/ocl/handle.hpp"
 
 namespace viennacl
@@ -79,6 +80,40 @@ namespace viennacl
           clFlush(handle_.get());
         }
 
+        /** @brief Enqueues a marker and returns its event, which completes once all commands enqueued so far have completed.
+        *
+        * Allows to wait for (or to make other queues wait for) operations such as viennacl::linalg::prod(), which do not return an event themselves.
+        */
+        viennacl::ocl::event marker() const
+        {
+          cl_event e;
+          cl_int err = clEnqueueMarker(handle_.get(), &e);
+          VIENNACL_ERR_CHECK(err);
+          return viennacl::ocl::event(e, handle_.context());
+        }
+
+        /** @brief Commands enqueued after this call do not start before the command identified by the provided event has completed. The event may stem from a different queue of the same context. */
+        void wait_for(viennacl::ocl::event const & e) const
+        {
+          if (e.valid())
+          {
+            cl_event evt = e.handle().get();
+            cl_int err = clEnqueueWaitForEvents(handle_.get(), 1, &evt);
+            VIENNACL_ERR_CHECK(err);
+          }
+        }
+
+        /** @brief Commands enqueued after this call do not start before all commands identified by the provided events have completed. The events may stem from different queues of the same context. */
+        void wait_for(std::vector<viennacl::ocl::event> const & events) const
+        {
+          std::vector<cl_event> wait_list = viennacl::ocl::detail::event_wait_list(events);
+          if (wait_list.size() > 0)
+          {
+            cl_int err = clEnqueueWaitForEvents(handle_.get(), static_cast<cl_uint>(wait_list.size()), &(wait_list[0]));
+            VIENNACL_ERR_CHECK(err);
+          }
+        }
+
         viennacl::ocl::handle<cl_command_queue> const & handle() const { return handle_; }
         viennacl::ocl::handle<cl_command_queue>       & handle()       { return handle_; }
 
@@ -29,6 +29,7 @@
 #endif
 
 #include <algorithm>
+#include <deque>
 #include <vector>
 #include <map>
 #include "viennacl/ocl/forwards.h"
@@ -38,22 +39,47 @@
 #include "viennacl/ocl/device.hpp"
 #include "viennacl/ocl/platform.hpp"
 #include "viennacl/ocl/command_queue.hpp"
+#include "viennacl/tools/mutex.hpp"
+#include "viennacl/tools/profiler.hpp"
 
 namespace viennacl
 {
   namespace ocl
   {
+    /** @brief Represents an OpenCL context.
+    *
+    * The active device and queue are selected per thread. Programs, queues and the per-thread selections are protected by a lock,
+    * so that several threads can use the same context concurrently. Programs and queues are kept in containers which do not
+    * invalidate references when growing, thus references obtained by one thread stay valid while other threads add programs or queues.
+    */
     class context
     {
-      typedef std::vector< viennacl::ocl::program >   ProgramContainer;
+      typedef std::deque< viennacl::ocl::program >                                      ProgramContainer;
+      typedef std::map< cl_device_id, std::deque<viennacl::ocl::command_queue> >        QueueContainer;
+
+      /** @brief The device and queue selected by a thread */
+      struct selection
+      {
+        selection() : device_id(0), queue_id(0) {}
+
+        std::size_t device_id;
+        std::size_t queue_id;
+      };
 
       public:
+        /** @brief Serializes the one-time setup of a program in the init() functions of the OpenCL kernels and records whether it is done */
+        struct program_init_flag
+        {
+          program_init_flag() : done(false) {}
+
+          viennacl::tools::mutex mutex;
+          bool done;
+        };
+
         context() : initialized_(false),
                     device_type_(CL_DEVICE_TYPE_DEFAULT),
-                    current_device_id_(0),
                     default_device_num_(1),
-                    pf_index_(0),
-                    current_queue_id_(0) {}
+                    pf_index_(0) {}
 
         //////// Get and set default number of devices per context */
         /** @brief Returns the maximum number of devices to be set up for the context */
@@ -86,33 +112,35 @@ namespace viennacl
           return devices_;
         }
 
-        /** @brief Returns the current device */
+        /** @brief Returns the current device of the calling thread */
         viennacl::ocl::device const & current_device() const
         {
-          //std::cout << "Current device id in context: " << current_device_id_ << std::endl;
-          return devices_[current_device_id_];
+          viennacl::tools::scoped_lock lock(mutex_);
+          return devices_[current_selection().device_id];
         }
 
-        /** @brief Switches the current device to the i-th device in this context */
+        /** @brief Switches the current device of the calling thread to the i-th device in this context */
         void switch_device(std::size_t i)
         {
           assert(i < devices_.size() && bool("Provided device index out of range!"));
-          current_device_id_ = i;
+          viennacl::tools::scoped_lock lock(mutex_);
+          current_selection().device_id = i;
         }
 
-        /** @brief If the supplied device is used within the context, it becomes the current active device. */
+        /** @brief If the supplied device is used within the context, it becomes the current active device of the calling thread. */
         void switch_device(viennacl::ocl::device const & d)
         {
           #if defined(VIENNACL_DEBUG_ALL) || defined(VIENNACL_DEBUG_CONTEXT)
           std::cout << "ViennaCL: Setting new current device for context " << h_ << std::endl;
           #endif
+          viennacl::tools::scoped_lock lock(mutex_);
           bool found = false;
           for (std::size_t i=0; i<devices_.size(); ++i)
           {
             if (devices_[i] == d)
             {
               found = true;
-              current_device_id_ = i;
+              current_selection().device_id = i;
               break;
             }
           }
@@ -216,6 +244,7 @@ namespace viennacl
           std::cout << "ViennaCL: Adding existing queue " << q << " for device " << dev << " to context " << h_ << std::endl;
           #endif
           viennacl::ocl::handle<cl_command_queue> queue_handle(q, *this);
+          viennacl::tools::scoped_lock lock(mutex_);
           queues_[dev].push_back(viennacl::ocl::command_queue(queue_handle));
           queues_[dev].back().handle().inc();
         }
@@ -228,12 +257,15 @@ namespace viennacl
           #endif
           cl_int err;
 #ifdef VIENNACL_PROFILING_ENABLED
-          viennacl::ocl::handle<cl_command_queue> temp(clCreateCommandQueue(h_.get(), dev, CL_QUEUE_PROFILING_ENABLE, &err), *this);
+          cl_command_queue_properties properties = CL_QUEUE_PROFILING_ENABLE;
 #else
-          viennacl::ocl::handle<cl_command_queue> temp(clCreateCommandQueue(h_.get(), dev, 0, &err), *this);
+          // device timestamps for the profiler, see viennacl/tools/profiler.hpp:
+          cl_command_queue_properties properties = viennacl::tools::profiler::enabled() ? CL_QUEUE_PROFILING_ENABLE : 0;
 #endif
+          viennacl::ocl::handle<cl_command_queue> temp(clCreateCommandQueue(h_.get(), dev, properties, &err), *this);
           VIENNACL_ERR_CHECK(err);
 
+          viennacl::tools::scoped_lock lock(mutex_);
           queues_[dev].push_back(viennacl::ocl::command_queue(temp));
         }
 
@@ -241,26 +273,31 @@ namespace viennacl
         void add_queue(viennacl::ocl::device d) { add_queue(d.id()); }
 
         //get queue for default device:
+        /** @brief Returns the current queue of the calling thread */
         viennacl::ocl::command_queue & get_queue()
         {
-          return queues_[devices_[current_device_id_].id()][current_queue_id_];
+          viennacl::tools::scoped_lock lock(mutex_);
+          selection const & sel = current_selection();
+          return queues_[devices_[sel.device_id].id()][sel.queue_id];
         }
 
+        /** @brief Returns the current queue of the calling thread */
         viennacl::ocl::command_queue const & get_queue() const
         {
-          typedef std::map< cl_device_id, std::vector<viennacl::ocl::command_queue> >    QueueContainer;
+          viennacl::tools::scoped_lock lock(mutex_);
+          selection const & sel = current_selection();
 
           // find queue:
-          QueueContainer::const_iterator it = queues_.find(devices_[current_device_id_].id());
+          QueueContainer::const_iterator it = queues_.find(devices_[sel.device_id].id());
           if (it != queues_.end())
-            return (it->second)[current_queue_id_];
+            return (it->second)[sel.queue_id];
 
           std::cerr << "ViennaCL: FATAL ERROR: Could not obtain current command queue!" << std::endl;
           std::cout << "Number of queues in context: " << queues_.size() << std::endl;
           std::cout << "Number of devices in context: " << devices_.size() << std::endl;
           throw "queue not found!";
 
-          //return (it->second)[current_queue_id_];
+          //return (it->second)[sel.queue_id];
         }
 
         //get a particular queue:
@@ -280,46 +317,52 @@ namespace viennacl
 
           assert(device_index < devices_.size() && bool("Device not within context"));
 
+          viennacl::tools::scoped_lock lock(mutex_);
           return queues_[devices_[device_index].id()][i];
         }
 
-        /** @brief Returns the current device */
+        /** @brief Returns the current queue of the calling thread */
         // TODO: work out the const issues
         viennacl::ocl::command_queue const & current_queue() //const
         {
-          return queues_[devices_[current_device_id_].id()][current_queue_id_];
+          return get_queue();
         }
 
-        /** @brief Switches the current device to the i-th device in this context */
+        /** @brief Switches the current queue of the calling thread to the i-th queue of its current device */
         void switch_queue(std::size_t i)
         {
-          assert(i < queues_[devices_[current_device_id_].id()].size() && bool("In class 'context': Provided queue index out of range for device!"));
-          current_queue_id_ = i;
+          viennacl::tools::scoped_lock lock(mutex_);
+          selection & sel = current_selection();
+          assert(i < queues_[devices_[sel.device_id].id()].size() && bool("In class 'context': Provided queue index out of range for device!"));
+          sel.queue_id = i;
         }
 
 #if 1
-        /** @brief If the supplied command_queue is used within the context, it becomes the current active command_queue, the command_queue's device becomes current active device. */
+        /** @brief If the supplied command_queue is used within the context, it becomes the current active command_queue of the calling thread, the command_queue's device becomes its current active device. */
         void switch_queue(viennacl::ocl::command_queue const & q)
         {
           #if defined(VIENNACL_DEBUG_ALL) || defined(VIENNACL_DEBUG_CONTEXT)
           std::cout << "ViennaCL: Setting new current queue for context " << h_ << std::endl;
           #endif
+          viennacl::tools::scoped_lock lock(mutex_);
           bool found = false;
-          typedef std::map< cl_device_id, std::vector<viennacl::ocl::command_queue> >    QueueContainer;
 
           // For each device:
-          unsigned int j = 0;
-          for (QueueContainer::const_iterator it=queues_.begin(); it != queues_.end(); it++,j++)
+          for (std::size_t j = 0; j < devices_.size() && !found; ++j)
           {
-              const std::vector<viennacl::ocl::command_queue> & qv = (it->second);
+              QueueContainer::const_iterator it = queues_.find(devices_[j].id());
+              if (it == queues_.end())
+                continue;
+
+              const std::deque<viennacl::ocl::command_queue> & qv = (it->second);
               // For each queue candidate
               for (std::size_t i=0; i<qv.size(); ++i)
               {
                   if (qv[i] == q)
                   {
                       found = true;
-                      current_device_id_ = j;
-                      current_queue_id_ = i;
+                      current_selection().device_id = j;
+                      current_selection().queue_id = i;
                       break;
                   }
               }
@@ -334,11 +377,15 @@ namespace viennacl
         */
         viennacl::ocl::program & add_program(cl_program p, std::string const & prog_name)
         {
+          viennacl::tools::scoped_lock lock(mutex_);
           programs_.push_back(viennacl::ocl::program(p, *this, prog_name));
           return programs_.back();
         }
 
         /** @brief Adds a new program with the provided source to the context. Compiles the program and extracts all kernels from it
+        *
+        * Compilation takes place without holding the context lock, so threads may build different programs concurrently.
+        * If another thread added a program with the same name in the meantime, the newly built program is discarded and the existing one is returned.
         */
         viennacl::ocl::program & add_program(std::string const & source, std::string const & prog_name)
         {
@@ -357,7 +404,9 @@ namespace viennacl
           VIENNACL_ERR_CHECK(err);
 
           const char * options = build_options_.c_str();
+          double build_start = viennacl::tools::profiler::now();
           err = clBuildProgram(temp, 0, NULL, options, NULL, NULL);
+          viennacl::tools::profiler::record(prog_name, "build", viennacl::OPENCL_MEMORY, build_start, viennacl::tools::profiler::now() - build_start);
           if (err != CL_SUCCESS)
           {
             char buffer[8192];
@@ -370,6 +419,19 @@ namespace viennacl
           }
           VIENNACL_ERR_CHECK(err);
 
+          viennacl::tools::scoped_lock lock(mutex_);
+
+          for (ProgramContainer::iterator it = programs_.begin();
+                it != programs_.end();
+                ++it)
+          {
+            if (it->name() == prog_name)
+            {
+              clReleaseProgram(temp);
+              return *it;
+            }
+          }
+
           programs_.push_back(viennacl::ocl::program(temp, *this, prog_name));
 
           viennacl::ocl::program & prog = programs_.back();
@@ -394,6 +456,7 @@ namespace viennacl
 
         /** @brief Delete the program with the provided name */
         void delete_program(std::string const & name){
+          viennacl::tools::scoped_lock lock(mutex_);
           for (ProgramContainer::iterator it = programs_.begin();
                 it != programs_.end();
                 ++it)
@@ -411,6 +474,7 @@ namespace viennacl
           #if defined(VIENNACL_DEBUG_ALL) || defined(VIENNACL_DEBUG_CONTEXT)
           std::cout << "ViennaCL: Getting program '" << name << "' from context " << h_ << std::endl;
           #endif
+          viennacl::tools::scoped_lock lock(mutex_);
           for (ProgramContainer::iterator it = programs_.begin();
                 it != programs_.end();
                 ++it)
@@ -428,6 +492,7 @@ namespace viennacl
           #if defined(VIENNACL_DEBUG_ALL) || defined(VIENNACL_DEBUG_CONTEXT)
           std::cout << "ViennaCL: Getting program '" << name << "' from context " << h_ << std::endl;
           #endif
+          viennacl::tools::scoped_lock lock(mutex_);
           for (ProgramContainer::const_iterator it = programs_.begin();
                 it != programs_.end();
                 ++it)
@@ -440,8 +505,16 @@ namespace viennacl
           //return programs_[0];  //return a defined object
         }
 
+        /** @brief Returns the flag guarding the one-time setup of the program with the provided name. Threads setting up different programs do not block each other. */
+        program_init_flag & program_init(std::string const & prog_name)
+        {
+          viennacl::tools::scoped_lock lock(mutex_);
+          return program_init_flags_[prog_name];
+        }
+
         /** @brief Returns whether the program with the provided name exists or not */
         bool has_program(std::string const & name){
+            viennacl::tools::scoped_lock lock(mutex_);
             for (ProgramContainer::iterator it = programs_.begin();
                   it != programs_.end();
                   ++it)
@@ -454,14 +527,19 @@ namespace viennacl
         /** @brief Returns the program with the provided id */
         viennacl::ocl::program & get_program(std::size_t id)
         {
+          viennacl::tools::scoped_lock lock(mutex_);
           assert(id < programs_.size() && bool("In class 'context': id invalid in get_program()"));
           return programs_[id];
         }
 
         /** @brief Returns the number of programs within this context */
-        std::size_t program_num() { return programs_.size(); }
+        std::size_t program_num()
+        {
+          viennacl::tools::scoped_lock lock(mutex_);
+          return programs_.size();
+        }
 
-        /** @brief Convenience function for retrieving the kernel of a program directly from the context */
+        /** @brief Convenience function for retrieving the kernel of a program directly from the context. The kernel object is exclusive to the calling thread. */
         viennacl::ocl::kernel & get_kernel(std::string const & program_name, std::string const & kernel_name) { return get_program(program_name).get_kernel(kernel_name); }
 
         /** @brief Returns the number of devices within this context */
@@ -596,7 +674,7 @@ namespace viennacl
             for (std::size_t i=0; i<num_devices; ++i)
               devices_.push_back(viennacl::ocl::device(device_ids[i]));
           }
-          current_device_id_ = 0;
+          selections_.clear();
 
           initialized_ = true;
           #if defined(VIENNACL_DEBUG_ALL) || defined(VIENNACL_DEBUG_CONTEXT)
@@ -605,45 +683,97 @@ namespace viennacl
         }
 
 
+        /** @brief Returns the device and queue selected by the calling thread. Must only be called while holding the lock.
+        *
+        * The selections of terminated threads are released when a thread accesses the context for the first time.
+        */
+        selection & current_selection() const
+        {
+          viennacl::tools::thread_id_type id = viennacl::tools::current_thread_id();
+          std::map< viennacl::tools::thread_id_type, selection >::iterator it = selections_.find(id);
+          if (it != selections_.end())
+            return it->second;
+          viennacl::tools::erase_terminated_threads(selections_);
+          return selections_[id];
+        }
+
         bool initialized_;
         cl_device_type device_type_;
         viennacl::ocl::handle<cl_context> h_;
         std::vector< viennacl::ocl::device > devices_;
-        unsigned int current_device_id_;
         std::size_t default_device_num_;
         ProgramContainer programs_;
-        std::map< cl_device_id, std::vector< viennacl::ocl::command_queue> > queues_;
+        QueueContainer queues_;
         std::string build_options_;
         std::size_t pf_index_;
-        unsigned int current_queue_id_;
+        std::map< std::string, program_init_flag > program_init_flags_;
+        mutable std::map< viennacl::tools::thread_id_type, selection > selections_;
+        mutable viennacl::tools::mutex mutex_;
     }; //context
 
 
 
-    /** @brief Adds a kernel to the program */
+    /** @brief Adds a kernel to the program. The kernel object belongs to the calling thread. */
     inline viennacl::ocl::kernel & viennacl::ocl::program::add_kernel(cl_kernel kernel_handle, std::string const & kernel_name)
     {
       assert(p_context_ != NULL && bool("Pointer to context invalid in viennacl::ocl::program object"));
       viennacl::ocl::kernel temp(kernel_handle, *this, *p_context_, kernel_name);
-      kernels_.push_back(temp);
-      return kernels_.back();
+      viennacl::tools::scoped_lock lock(mutex_);
+      KernelContainer & kernels = thread_kernels();
+      kernels.push_back(temp);
+      return kernels.back();
     }
 
-    /** @brief Returns the kernel with the provided name */
+    /** @brief Returns the kernel with the provided name.
+    *
+    * Kernel arguments and work sizes are state of the kernel object, hence each thread obtains its own kernel object.
+    * If the calling thread requests a kernel for the first time, a new OpenCL kernel is created from the program.
+    */
     inline viennacl::ocl::kernel & viennacl::ocl::program::get_kernel(std::string const & name)
     {
       //std::cout << "Requiring kernel " << name << " from program " << name_ << std::endl;
-      for (KernelContainer::iterator it = kernels_.begin();
-            it != kernels_.end();
-           ++it)
+      bool found = false;
+      {
+        viennacl::tools::scoped_lock lock(mutex_);
+
+        KernelContainer & kernels = thread_kernels();
+        for (KernelContainer::iterator it = kernels.begin();
+              it != kernels.end();
+             ++it)
+        {
+          if (it->name() == name)
+            return *it;
+        }
+
+        for (ThreadKernelContainer::const_iterator tit = kernels_.begin();
+              tit != kernels_.end() && !found;
+             ++tit)
+        {
+          for (KernelContainer::const_iterator it = tit->second.begin();
+                it != tit->second.end();
+               ++it)
+          {
+            if (it->name() == name)
+            {
+              found = true;
+              break;
+            }
+          }
+        }
+      }
+
+      if (!found)
       {
-        if (it->name() == name)
-          return *it;
+        std::cerr << "ViennaCL: FATAL ERROR: Could not find kernel '" << name << "'" << std::endl;
+        throw "Kernel not found";
+        //return kernels_[0];  //return a defined object
       }
-      std::cerr << "ViennaCL: FATAL ERROR: Could not find kernel '" << name << "'" << std::endl;
-      std::cout << "Number of kernels in program: " << kernels_.size() << std::endl;
-      throw "Kernel not found";
-      //return kernels_[0];  //return a defined object
+
+      // first request of the kernel by the calling thread: create a kernel object exclusive to this thread
+      cl_int err;
+      cl_kernel kernel_handle = clCreateKernel(handle_.get(), name.c_str(), &err);
+      VIENNACL_ERR_CHECK(err);
+      return add_kernel(kernel_handle, name);
     }
 
 
@@ -28,8 +28,12 @@
 #include <CL/cl.h>
 #endif
 
+#include <vector>
+#include <string>
+#include "viennacl/tools/profiler.hpp"
 #include "viennacl/ocl/kernel.hpp"
 #include "viennacl/ocl/command_queue.hpp"
+#include "viennacl/ocl/event.hpp"
 
 namespace viennacl
 {
@@ -41,69 +45,130 @@ namespace viennacl
   namespace ocl
   {
 
-    /** @brief Enqueues a kernel in the provided queue */
-    template <typename KernelType>
-    void enqueue(KernelType & k, viennacl::ocl::command_queue const & queue)
+    namespace detail
     {
-      // 1D kernel:
-      if (k.local_work_size(1) == 0)
+      /** @brief Waits for the kernel identified by 'evt' and passes its execution time to the profiler.
+      *
+      * @param name        Name of the kernel as it appears in the recorded event
+      * @param evt         The event of the kernel launch
+      * @param host_start  Profiler time (viennacl::tools::profiler::now()) at which the kernel was enqueued
+      *
+      * The device timestamps are mapped to the host clock relative to the time 'host_start' at which the kernel was enqueued.
+      * If the queue was not created with profiling enabled, the host time between enqueuing and completion is recorded instead.
+      */
+      inline void profile_kernel(std::string const & name, cl_event evt, double host_start)
       {
-        #if defined(VIENNACL_DEBUG_ALL) || defined(VIENNACL_DEBUG_KERNEL)
-        std::cout << "ViennaCL: Starting 1D-kernel '" << k.name() << "'..." << std::endl;
-        std::cout << "ViennaCL: Global work size: '"  << k.global_work_size() << "'..." << std::endl;
-        std::cout << "ViennaCL: Local work size: '"   << k.local_work_size() << "'..." << std::endl;
-        #endif
-
-        std::size_t tmp_global = k.global_work_size();
-        std::size_t tmp_local = k.local_work_size();
-
-        cl_int err;
-        if (tmp_global == 1 && tmp_local == 1)
-          err = clEnqueueTask(queue.handle().get(), k.handle().get(), 0, NULL, NULL);
+        cl_int err = clWaitForEvents(1, &evt);
+        VIENNACL_ERR_CHECK(err);
+
+        cl_ulong queued = 0, start = 0, end = 0;
+        if (   clGetEventProfilingInfo(evt, CL_PROFILING_COMMAND_QUEUED, sizeof(cl_ulong), &queued, NULL) == CL_SUCCESS
+            && clGetEventProfilingInfo(evt, CL_PROFILING_COMMAND_START,  sizeof(cl_ulong), &start,  NULL) == CL_SUCCESS
+            && clGetEventProfilingInfo(evt, CL_PROFILING_COMMAND_END,    sizeof(cl_ulong), &end,    NULL) == CL_SUCCESS)
+          viennacl::tools::profiler::record(name, "kernel", viennacl::OPENCL_MEMORY, host_start + 1e-9 * double(start - queued), 1e-9 * double(end - start));
         else
-          err = clEnqueueNDRangeKernel(queue.handle().get(), k.handle().get(), 1, NULL, &tmp_global, &tmp_local, 0, NULL, NULL);
-
-        if (err != CL_SUCCESS)
-        {
-          std::cerr << "ViennaCL: FATAL ERROR: Kernel start failed for '" << k.name() << "'." << std::endl;
-          std::cerr << "ViennaCL: Smaller work sizes could not solve the problem. " << std::endl;
-          VIENNACL_ERR_CHECK(err);
-        }
+          viennacl::tools::profiler::record(name, "kernel", viennacl::OPENCL_MEMORY, host_start, viennacl::tools::profiler::now() - host_start);
       }
-      else //2D or 3D kernel
-      {
-        #if defined(VIENNACL_DEBUG_ALL) || defined(VIENNACL_DEBUG_KERNEL)
-        std::cout << "ViennaCL: Starting 2D/3D-kernel '" << k.name() << "'..." << std::endl;
-        std::cout << "ViennaCL: Global work size: '"  << k.global_work_size(0) << ", " << k.global_work_size(1) << ", " << k.global_work_size(2) << "'..." << std::endl;
-        std::cout << "ViennaCL: Local work size: '"   << k.local_work_size(0) << ", " << k.local_work_size(1) << ", " << k.local_work_size(2) << "'..." << std::endl;
-        #endif
 
-        std::size_t tmp_global[3];
-        tmp_global[0] = k.global_work_size(0);
-        tmp_global[1] = k.global_work_size(1);
-        tmp_global[2] = k.global_work_size(2);
+      /** @brief Enqueues a kernel in the provided queue after the commands in 'wait_list'. Returns the event of the launch in 'evt' unless 'evt' is NULL. */
+      template <typename KernelType>
+      void enqueue_kernel(KernelType & k, viennacl::ocl::command_queue const & queue, std::vector<cl_event> const & wait_list, cl_event * evt)
+      {
+        cl_uint num_events = static_cast<cl_uint>(wait_list.size());
+        cl_event const * events = (num_events > 0) ? &(wait_list[0]) : NULL;
 
-        std::size_t tmp_local[3];
-        tmp_local[0] = k.local_work_size(0);
-        tmp_local[1] = k.local_work_size(1);
-        tmp_local[2] = k.local_work_size(2);
+        // the profiler requires the event of the launch even if the caller does not:
+        bool profile = viennacl::tools::profiler::enabled();
+        double host_start = profile ? viennacl::tools::profiler::now() : 0;
+        cl_event profile_evt;
+        cl_event * launch_evt = (profile && !evt) ? &profile_evt : evt;
 
-        cl_int err = clEnqueueNDRangeKernel(queue.handle().get(), k.handle().get(), (tmp_global[2] == 0) ? 2 : 3, NULL, tmp_global, tmp_local, 0, NULL, NULL);
+        // 1D kernel:
+        if (k.local_work_size(1) == 0)
+        {
+          #if defined(VIENNACL_DEBUG_ALL) || defined(VIENNACL_DEBUG_KERNEL)
+          std::cout << "ViennaCL: Starting 1D-kernel '" << k.name() << "'..." << std::endl;
+          std::cout << "ViennaCL: Global work size: '"  << k.global_work_size() << "'..." << std::endl;
+          std::cout << "ViennaCL: Local work size: '"   << k.local_work_size() << "'..." << std::endl;
+          #endif
+
+          std::size_t tmp_global = k.global_work_size();
+          std::size_t tmp_local = k.local_work_size();
+
+          cl_int err;
+          if (tmp_global == 1 && tmp_local == 1)
+            err = clEnqueueTask(queue.handle().get(), k.handle().get(), num_events, events, launch_evt);
+          else
+            err = clEnqueueNDRangeKernel(queue.handle().get(), k.handle().get(), 1, NULL, &tmp_global, &tmp_local, num_events, events, launch_evt);
+
+          if (err != CL_SUCCESS)
+          {
+            std::cerr << "ViennaCL: FATAL ERROR: Kernel start failed for '" << k.name() << "'." << std::endl;
+            std::cerr << "ViennaCL: Smaller work sizes could not solve the problem. " << std::endl;
+            VIENNACL_ERR_CHECK(err);
+          }
+        }
+        else //2D or 3D kernel
+        {
+          #if defined(VIENNACL_DEBUG_ALL) || defined(VIENNACL_DEBUG_KERNEL)
+          std::cout << "ViennaCL: Starting 2D/3D-kernel '" << k.name() << "'..." << std::endl;
+          std::cout << "ViennaCL: Global work size: '"  << k.global_work_size(0) << ", " << k.global_work_size(1) << ", " << k.global_work_size(2) << "'..." << std::endl;
+          std::cout << "ViennaCL: Local work size: '"   << k.local_work_size(0) << ", " << k.local_work_size(1) << ", " << k.local_work_size(2) << "'..." << std::endl;
+          #endif
+
+          std::size_t tmp_global[3];
+          tmp_global[0] = k.global_work_size(0);
+          tmp_global[1] = k.global_work_size(1);
+          tmp_global[2] = k.global_work_size(2);
+
+          std::size_t tmp_local[3];
+          tmp_local[0] = k.local_work_size(0);
+          tmp_local[1] = k.local_work_size(1);
+          tmp_local[2] = k.local_work_size(2);
+
+          cl_int err = clEnqueueNDRangeKernel(queue.handle().get(), k.handle().get(), (tmp_global[2] == 0) ? 2 : 3, NULL, tmp_global, tmp_local, num_events, events, launch_evt);
+
+          if (err != CL_SUCCESS)
+          {
+            //could not start kernel with any parameters
+            std::cerr << "ViennaCL: FATAL ERROR: Kernel start failed for '" << k.name() << "'." << std::endl;
+            VIENNACL_ERR_CHECK(err);
+          }
+        }
 
-        if (err != CL_SUCCESS)
+        if (profile)
         {
-          //could not start kernel with any parameters
-          std::cerr << "ViennaCL: FATAL ERROR: Kernel start failed for '" << k.name() << "'." << std::endl;
-          VIENNACL_ERR_CHECK(err);
+          profile_kernel(k.name(), *launch_evt, host_start);
+          if (!evt)
+            clReleaseEvent(profile_evt);
         }
+
+        #if defined(VIENNACL_DEBUG_ALL) || defined(VIENNACL_DEBUG_KERNEL)
+        queue.finish();
+        std::cout << "ViennaCL: Kernel " << k.name() << " finished!" << std::endl;
+        #endif
       }
+    }
 
-      #if defined(VIENNACL_DEBUG_ALL) || defined(VIENNACL_DEBUG_KERNEL)
-      queue.finish();
-      std::cout << "ViennaCL: Kernel " << k.name() << " finished!" << std::endl;
-      #endif
+    /** @brief Enqueues a kernel in the provided queue */
+    template <typename KernelType>
+    void enqueue(KernelType & k, viennacl::ocl::command_queue const & queue)
+    {
+      detail::enqueue_kernel(k, queue, std::vector<cl_event>(), NULL);
     } //enqueue()
 
+    /** @brief Enqueues a kernel in the provided queue such that it starts only after the commands identified by 'dependencies' have completed.
+    *
+    * The dependencies may stem from other queues of the same context. The kernel launch is asynchronous, the returned event identifies it.
+    */
+    template <typename KernelType>
+    viennacl::ocl::event enqueue(KernelType & k, viennacl::ocl::command_queue const & queue, std::vector<viennacl::ocl::event> const & dependencies)
+    {
+      cl_event evt;
+      detail::enqueue_kernel(k, queue, detail::event_wait_list(dependencies), &evt);
+      return viennacl::ocl::event(evt, k.context());
+    }
+
 
     /** @brief Convenience function that enqueues the provided kernel into the first queue of the currently active device in the currently active context */
     template <typename KernelType>
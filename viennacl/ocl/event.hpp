@@ -0,0 +1,110 @@
+#ifndef VIENNACL_OCL_EVENT_HPP_
+#define VIENNACL_OCL_EVENT_HPP_
+
+/* =========================================================================
+   Copyright (c) 2010-2013, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/ocl/event.hpp
+    @brief Representation of OpenCL events, which identify enqueued commands and allow for waiting on their completion
+*/
+
+#ifdef __APPLE__
+#include <OpenCL/cl.h>
+#else
+#include <CL/cl.h>
+#endif
+
+#include <vector>
+#include "viennacl/ocl/forwards.h"
+#include "viennacl/ocl/handle.hpp"
+#include "viennacl/ocl/error.hpp"
+
+namespace viennacl
+{
+  namespace ocl
+  {
+
+    /** @brief An event identifying a command enqueued in a command queue (kernel launch, transfer, or marker).
+    *
+    * Events are reference counted, copies refer to the same command. A default-constructed event does not refer to any command and is considered complete.
+    */
+    class event
+    {
+      public:
+        event() {}
+
+        /** @brief Wraps an OpenCL event. Takes ownership, i.e. the event is released when the last copy of the event object is destroyed. */
+        event(cl_event e, viennacl::ocl::context const & ctx) : handle_(e, ctx) {}
+
+        /** @brief Blocks until the command has completed */
+        void wait() const
+        {
+          if (handle_.get() != 0)
+          {
+            cl_event e = handle_.get();
+            cl_int err = clWaitForEvents(1, &e);
+            VIENNACL_ERR_CHECK(err);
+          }
+        }
+
+        /** @brief Returns true if the command has completed, false otherwise. Does not block. */
+        bool completed() const
+        {
+          if (handle_.get() == 0)
+            return true;
+
+          cl_int status;
+          cl_int err = clGetEventInfo(handle_.get(), CL_EVENT_COMMAND_EXECUTION_STATUS, sizeof(cl_int), &status, NULL);
+          VIENNACL_ERR_CHECK(err);
+          if (status < 0) //command terminated abnormally, status is an error code
+            VIENNACL_ERR_CHECK(status);
+          return status == CL_COMPLETE;
+        }
+
+        /** @brief Returns true if the event refers to an enqueued command */
+        bool valid() const { return handle_.get() != 0; }
+
+        viennacl::ocl::handle<cl_event> const & handle() const { return handle_; }
+
+      private:
+        viennacl::ocl::handle<cl_event> handle_;
+    };
+
+    /** @brief Blocks until all commands identified by the provided events have completed */
+    inline void wait(std::vector<viennacl::ocl::event> const & events)
+    {
+      for (std::size_t i=0; i<events.size(); ++i)
+        events[i].wait();
+    }
+
+    namespace detail
+    {
+      /** @brief Extracts the OpenCL handles of all valid events, e.g. for use as an event wait list of an OpenCL enqueue call */
+      inline std::vector<cl_event> event_wait_list(std::vector<viennacl::ocl::event> const & events)
+      {
+        std::vector<cl_event> wait_list;
+        for (std::size_t i=0; i<events.size(); ++i)
+          if (events[i].valid())
+            wait_list.push_back(events[i].handle().get());
+        return wait_list;
+      }
+    }
+
+  } //namespace ocl
+} //namespace viennacl
+
+#endif
@@ -44,6 +44,7 @@ namespace viennacl
     class kernel;
     class device;
     class command_queue;
+    class event;
     class context;
     class program;
 
@@ -39,7 +39,7 @@ namespace viennacl
   namespace ocl
   {
     /** @brief Helper for OpenCL reference counting used by class handle.
-    *   @tparam OCL_TYPE Must be one out of cl_mem, cl_program, cl_kernel, cl_command_queue and cl_context, otherwise a compile time error is thrown.
+    *   @tparam OCL_TYPE Must be one out of cl_mem, cl_program, cl_kernel, cl_command_queue, cl_context and cl_event, otherwise a compile time error is thrown.
     */
     template<class OCL_TYPE>
     class handle_inc_dec_helper
@@ -142,6 +142,24 @@ namespace viennacl
         #endif
       }
     };
+    //cl_event:
+    template <>
+    struct handle_inc_dec_helper<cl_event>
+    {
+      static void inc(cl_event & something)
+      {
+        cl_int err = clRetainEvent(something);
+        VIENNACL_ERR_CHECK(err);
+      }
+
+      static void dec(cl_event & something)
+      {
+        #ifndef __APPLE__
+        cl_int err = clReleaseEvent(something);
+        VIENNACL_ERR_CHECK(err);
+        #endif
+      }
+    };
     /** \endcond */
 
     /** @brief Handle class the effectively represents a smart pointer for OpenCL handles */
@@ -161,7 +179,8 @@ namespace viennacl
             dec();
           h_         = other.h_;
           p_context_ = other.p_context_;
-          inc();
+          if (h_ != 0)
+            inc();
           return *this;
         }
 
@@ -22,19 +22,26 @@
     @brief Implements an OpenCL program class for ViennaCL
 */
 
+#include <deque>
+#include <map>
 #include <string>
-#include <vector>
 #include "viennacl/ocl/forwards.h"
 #include "viennacl/ocl/handle.hpp"
 #include "viennacl/ocl/kernel.hpp"
+#include "viennacl/tools/mutex.hpp"
 
 namespace viennacl
 {
   namespace ocl
   {
+    /** @brief Represents an OpenCL program. Kernel objects are kept per thread, so that threads can set arguments and enqueue the same kernel concurrently.
+    *
+    * The kernel objects of terminated threads are released when another thread requests its first kernel from the program.
+    */
     class program
     {
-      typedef std::vector<viennacl::ocl::kernel>    KernelContainer;
+      typedef std::deque<viennacl::ocl::kernel>                                   KernelContainer;
+      typedef std::map<viennacl::tools::thread_id_type, KernelContainer>          ThreadKernelContainer;
 
     public:
       program() : p_context_(NULL) {}
@@ -57,17 +64,28 @@ namespace viennacl
       /** @brief Adds a kernel to the program */
       inline viennacl::ocl::kernel & add_kernel(cl_kernel kernel_handle, std::string const & kernel_name);   //see context.hpp for implementation
 
-      /** @brief Returns the kernel with the provided name */
+      /** @brief Returns the kernel with the provided name for the calling thread */
       inline viennacl::ocl::kernel & get_kernel(std::string const & name);    //see context.hpp for implementation
 
       const viennacl::ocl::handle<cl_program> & handle() const { return handle_; }
 
     private:
+      /** @brief Returns the kernel objects of the calling thread. Must only be called while holding the lock. */
+      KernelContainer & thread_kernels()
+      {
+        viennacl::tools::thread_id_type id = viennacl::tools::current_thread_id();
+        ThreadKernelContainer::iterator it = kernels_.find(id);
+        if (it != kernels_.end())
+          return it->second;
+        viennacl::tools::erase_terminated_threads(kernels_);
+        return kernels_[id];
+      }
 
       viennacl::ocl::handle<cl_program> handle_;
       viennacl::ocl::context const * p_context_;
       std::string name_;
-      KernelContainer kernels_;
+      ThreadKernelContainer kernels_;
+      viennacl::tools::mutex mutex_;
     };
   } //namespace ocl
 } //namespace viennacl
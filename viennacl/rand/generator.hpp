@@ -0,0 +1,159 @@
+#ifndef VIENNACL_RAND_GENERATOR_HPP_
+#define VIENNACL_RAND_GENERATOR_HPP_
+
+/* =========================================================================
+   Copyright (c) 2010-2013, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/rand/generator.hpp
+    @brief A counter-based random number generator for filling vectors and matrices on all compute backends.
+*/
+
+#include <cassert>
+
+#include "viennacl/forwards.h"
+#include "viennacl/vector.hpp"
+#include "viennacl/matrix.hpp"
+#include "viennacl/rand/utils.hpp"
+#include "viennacl/rand/uniform.hpp"
+#include "viennacl/rand/gaussian.hpp"
+#include "viennacl/linalg/host_based/random_operations.hpp"
+
+#ifdef VIENNACL_WITH_OPENCL
+  #include "viennacl/linalg/opencl/random_operations.hpp"
+#endif
+
+#ifdef VIENNACL_WITH_CUDA
+  #include "viennacl/linalg/cuda/random_operations.hpp"
+#endif
+
+namespace viennacl
+{
+  namespace rand
+  {
+    namespace detail
+    {
+      /** @brief Dispatcher for filling a vector or a matrix with random numbers, see e.g. viennacl::linalg::host_based::random_fill() */
+      template <typename T, typename DistributionT>
+      void random_fill(T & obj, DistributionT const & tag,
+                       unsigned int seed, unsigned int stream_id, std::size_t first_block)
+      {
+        switch (viennacl::traits::handle(obj).get_active_handle_id())
+        {
+          case viennacl::MAIN_MEMORY:
+            viennacl::linalg::host_based::random_fill(obj, tag, seed, stream_id, first_block);
+            break;
+#ifdef VIENNACL_WITH_OPENCL
+          case viennacl::OPENCL_MEMORY:
+            viennacl::linalg::opencl::random_fill(obj, tag, seed, stream_id, first_block);
+            break;
+#endif
+#ifdef VIENNACL_WITH_CUDA
+          case viennacl::CUDA_MEMORY:
+            viennacl::linalg::cuda::random_fill(obj, tag, seed, stream_id, first_block);
+            break;
+#endif
+          case viennacl::MEMORY_NOT_INITIALIZED:
+            throw memory_exception("not initialised!");
+          default:
+            throw memory_exception("not implemented");
+        }
+      }
+    }
+
+    /** @brief A random number stream of the counter-based generator Philox4x32-10.
+    *
+    * A stream is identified by the seed and the stream ID. Each fill consumes the next values of the stream, rounded up to a multiple of four.
+    * Since the i-th value of a stream is a function of (seed, stream ID, i) only, all compute backends produce the same values,
+    * irrespective of the number of threads, and any position of the stream can be accessed in constant time via offset().
+    * Uniform values agree exactly between the backends (no contraction to fused multiply-adds), normally distributed values up to the accuracy of the math library.
+    */
+    class generator
+    {
+      public:
+        explicit generator(unsigned int seed = 0, unsigned int stream_id = 0) : seed_(seed), stream_id_(stream_id), offset_(0) {}
+
+        unsigned int seed() const { return seed_; }
+        unsigned int stream_id() const { return stream_id_; }
+
+        /** @brief Returns the number of values of the stream consumed so far (always a multiple of four) */
+        std::size_t offset() const { return offset_; }
+
+        /** @brief Sets the position in the stream. Must be a multiple of four. */
+        void offset(std::size_t new_offset)
+        {
+          assert(new_offset % 4 == 0 && bool("Offset of random number stream must be a multiple of four"));
+          offset_ = new_offset;
+        }
+
+        /** @brief Skips the next n values of the stream (n is rounded up to a multiple of four) */
+        void skip(std::size_t n) { offset_ += (n + 3) / 4 * 4; }
+
+        /** @brief Fills the vector with the next values of the stream */
+        template <typename NumericT, typename DistributionT>
+        void fill(vector_base<NumericT> & vec, DistributionT const & tag)
+        {
+          if (vec.size() > 0)
+            detail::random_fill(vec, tag, seed_, stream_id_, offset_ / 4);
+          skip(vec.size());
+        }
+
+        /** @brief Fills the matrix with the next values of the stream. Entry (i,j) obtains the (i * size2 + j)-th value, independent of the memory layout. */
+        template <typename NumericT, typename F, typename DistributionT>
+        void fill(matrix_base<NumericT, F> & mat, DistributionT const & tag)
+        {
+          if (mat.size1() > 0 && mat.size2() > 0)
+            detail::random_fill(mat, tag, seed_, stream_id_, offset_ / 4);
+          skip(mat.size1() * mat.size2());
+        }
+
+      private:
+        unsigned int seed_;
+        unsigned int stream_id_;
+        std::size_t offset_;
+    };
+
+  }
+
+  /** @brief Returns a vector filled with random numbers, e.g. viennacl::random_vector<float>(100, viennacl::rand::gaussian_tag(0, 1)).
+  *
+  * @param size      Number of entries
+  * @param tag       The distribution (viennacl::rand::uniform_tag or viennacl::rand::gaussian_tag)
+  * @param seed      The seed of the random number stream (stream ID 0)
+  * @param ctx       The context in which the vector is created
+  */
+  template <typename NumericT, typename DistributionT>
+  viennacl::vector<NumericT> random_vector(std::size_t size, DistributionT const & tag, unsigned int seed = 0, viennacl::context ctx = viennacl::context())
+  {
+    viennacl::vector<NumericT> result(size, ctx);
+    viennacl::rand::generator gen(seed);
+    gen.fill(result, tag);
+    return result;
+  }
+
+  /** @brief Returns a row-major matrix filled with random numbers. See random_vector() for the parameters. */
+  template <typename NumericT, typename DistributionT>
+  viennacl::matrix<NumericT> random_matrix(std::size_t size1, std::size_t size2, DistributionT const & tag, unsigned int seed = 0, viennacl::context ctx = viennacl::context())
+  {
+    viennacl::matrix<NumericT> result(size1, size2, ctx);
+    viennacl::rand::generator gen(seed);
+    gen.fill(result, tag);
+    return result;
+  }
+
+}
+
+#endif
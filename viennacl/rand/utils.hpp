@@ -1,49 +1,151 @@
 #ifndef VIENNACL_RAND_UTILS_HPP_
 #define VIENNACL_RAND_UTILS_HPP_
 
-#ifdef VIENNACL_WITH_OPENCL
-#include "viennacl/linalg/kernels/rand_kernels.h"
+/* =========================================================================
+   Copyright (c) 2010-2013, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
 
-namespace viennacl{
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
 
-namespace rand{
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
 
+   (A list of authors and contributors can be found in the PDF manual)
 
-template<class SCALARTYPE, class DISTRIBUTION>
-struct random_matrix_t{
-    typedef size_t size_type;
-    random_matrix_t(size_type _size1, unsigned int _size2, DISTRIBUTION const & _distribution) : size1(_size1), size2(_size2), distribution(_distribution){
-        #ifdef VIENNACL_WITH_OPENCL
-        viennacl::linalg::kernels::rand<SCALARTYPE,1>::init();
-        #endif
-    }
-    size_type size1;
-    size_type size2;
-    DISTRIBUTION distribution;
-};
-
-
-template<class SCALARTYPE, class DISTRIBUTION>
-struct random_vector_t{
-    typedef size_t size_type;
-    random_vector_t(size_type _size, DISTRIBUTION const & _distribution) : size(_size), distribution(_distribution){
-        #ifdef VIENNACL_WITH_OPENCL
-        viennacl::linalg::kernels::rand<SCALARTYPE,1>::init();
-        #endif
-    }
-    size_type size;
-    DISTRIBUTION distribution;
-};
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
 
-template<class ScalarType, class Distribution>
-struct buffer_dumper;
+/** @file viennacl/rand/utils.hpp
+    @brief The counter-based Philox4x32-10 generator (Salmon et al., SC'11) and the mapping of its output to floating point values.
 
+    All backends produce the same random numbers: The value with logical index j of a fill is computed from word (j % 4) of
+    the Philox output for the 64-bit block counter b = first_block + j / 4 (counter words: low and high 32 bits of b, 0, 0)
+    and the key (seed, stream_id). Logical indices of matrices are row-major (i * size2 + j), hence the values do not depend
+    on the memory layout.
+*/
 
-}
+#include <cstddef>
+#include <cmath>
 
-}
+#ifndef _MSC_VER
+#include <stdint.h>
+#endif
 
+namespace viennacl
+{
+  namespace rand
+  {
+    namespace detail
+    {
+#if defined(_MSC_VER)
+      typedef unsigned __int64         philox_uint64_type;
+#else
+      typedef uint64_t                 philox_uint64_type;
 #endif
 
+      static const unsigned int philox_m0 = 0xD2511F53;
+      static const unsigned int philox_m1 = 0xCD9E8D57;
+      static const unsigned int philox_w0 = 0x9E3779B9;
+      static const unsigned int philox_w1 = 0xBB67AE85;
+
+      /** @brief Applies the ten Philox4x32 rounds to 'count' counters stored in structure-of-arrays form.
+      *
+      * The loop over the counters is innermost, so the compiler can vectorize it (32x32->64 bit multiplications are available in SSE2).
+      */
+      inline void philox4x32_10(unsigned int * c0, unsigned int * c1, unsigned int * c2, unsigned int * c3,
+                                std::size_t count, unsigned int key0, unsigned int key1)
+      {
+        for (unsigned int round = 0; round < 10; ++round)
+        {
+          for (std::size_t i = 0; i < count; ++i)
+          {
+            philox_uint64_type prod0 = static_cast<philox_uint64_type>(philox_m0) * c0[i];
+            philox_uint64_type prod1 = static_cast<philox_uint64_type>(philox_m1) * c2[i];
+            unsigned int new_c0 = static_cast<unsigned int>(prod1 >> 32) ^ c1[i] ^ key0;
+            unsigned int new_c2 = static_cast<unsigned int>(prod0 >> 32) ^ c3[i] ^ key1;
+            c1[i] = static_cast<unsigned int>(prod1);
+            c3[i] = static_cast<unsigned int>(prod0);
+            c0[i] = new_c0;
+            c2[i] = new_c2;
+          }
+          key0 += philox_w0;
+          key1 += philox_w1;
+        }
+      }
+
+      /** @brief Splits a block counter into its low and high 32 bits (without shifting by 32 if std::size_t is a 32-bit type) */
+      inline unsigned int block_lo(std::size_t block) { return static_cast<unsigned int>(block); }
+      inline unsigned int block_hi(std::size_t block) { return static_cast<unsigned int>((block >> 16) >> 16); }
+
+      /** @brief Maps a random word to a uniformly distributed value in [0, 1): 24 random bits for float, 32 random bits for double */
+      inline float  unit_uniform(unsigned int w, float)  { return static_cast<float>(w >> 8) * (1.0f / 16777216.0f); }
+      inline double unit_uniform(unsigned int w, double) { return static_cast<double>(w) * (1.0 / 4294967296.0); }
+
+      /** @brief Uniform distribution on [a, b) with b_minus_a = b - a */
+      template <typename NumericT>
+      struct uniform_transformation
+      {
+        uniform_transformation(NumericT a, NumericT b_minus_a) : a_(a), b_minus_a_(b_minus_a) {}
+
+        /** @brief Maps the four words of a Philox block to four values */
+        void operator()(unsigned int w0, unsigned int w1, unsigned int w2, unsigned int w3, NumericT * values) const
+        {
+          values[0] = a_ + b_minus_a_ * unit_uniform(w0, NumericT());
+          values[1] = a_ + b_minus_a_ * unit_uniform(w1, NumericT());
+          values[2] = a_ + b_minus_a_ * unit_uniform(w2, NumericT());
+          values[3] = a_ + b_minus_a_ * unit_uniform(w3, NumericT());
+        }
+
+        NumericT a_;
+        NumericT b_minus_a_;
+      };
+
+      /** @brief Normal distribution N(mu, sigma^2) using the Box-Muller transformation of the word pairs (w0, w1) and (w2, w3).
+      *
+      * Box-Muller consumes a fixed number of words per value, which keeps the one-to-one mapping of counters to values (unlike rejection methods such as the Ziggurat).
+      */
+      template <typename NumericT>
+      struct gaussian_transformation
+      {
+        gaussian_transformation(NumericT mu, NumericT sigma) : mu_(mu), sigma_(sigma) {}
+
+        void operator()(unsigned int w0, unsigned int w1, unsigned int w2, unsigned int w3, NumericT * values) const
+        {
+          box_muller(w0, w1, values);
+          box_muller(w2, w3, values + 2);
+        }
+
+        void box_muller(unsigned int w_radius, unsigned int w_angle, NumericT * values) const
+        {
+          NumericT two_pi = NumericT(6.283185307179586476925286766559);
+          NumericT u1 = NumericT(1) - unit_uniform(w_radius, NumericT()); // in (0, 1], hence the logarithm is finite
+          NumericT u2 = unit_uniform(w_angle, NumericT());
+          NumericT r  = std::sqrt(NumericT(-2) * std::log(u1));
+          values[0] = mu_ + sigma_ * r * std::cos(two_pi * u2);
+          values[1] = mu_ + sigma_ * r * std::sin(two_pi * u2);
+        }
+
+        NumericT mu_;
+        NumericT sigma_;
+      };
+
+    }
+
+    /** @brief Reference implementation of Philox4x32-10 for a single counter. Mostly useful for testing.
+    *
+    * @param counter   The four counter words, overwritten by the four random words
+    * @param key0      First key word (the seed)
+    * @param key1      Second key word (the stream ID)
+    */
+    inline void philox4x32_10(unsigned int * counter, unsigned int key0, unsigned int key1)
+    {
+      detail::philox4x32_10(counter, counter + 1, counter + 2, counter + 3, 1, key0, key1);
+    }
+
+  }
+}
 
 #endif
@@ -30,6 +30,7 @@
 #include "viennacl/scheduler/execute_axbx.hpp"
 #include "viennacl/scheduler/execute_elementwise.hpp"
 #include "viennacl/scheduler/execute_matrix_prod.hpp"
+#include "viennacl/scheduler/execute_fused.hpp"
 
 namespace viennacl
 {
@@ -218,7 +219,9 @@ namespace viennacl
         switch (root_node.rhs.type_family)
         {
           case COMPOSITE_OPERATION_FAMILY:
-            execute_composite(s, root_node);
+            // element-wise operations and reductions in main memory are evaluated in a single pass without temporaries:
+            if (!execute_fused(s, root_node))
+              execute_composite(s, root_node);
             break;
           case SCALAR_TYPE_FAMILY:
           case VECTOR_TYPE_FAMILY:
@@ -0,0 +1,636 @@
+#ifndef VIENNACL_SCHEDULER_EXECUTE_FUSED_HPP
+#define VIENNACL_SCHEDULER_EXECUTE_FUSED_HPP
+
+/* =========================================================================
+   Copyright (c) 2010-2013, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+
+/** @file viennacl/scheduler/execute_fused.hpp
+    @brief Fused evaluation of element-wise statements and reductions on the host backend.
+
+    A statement such as x = a*y + b*z - c*element_prod(u,v) is translated into a flat list of instructions,
+    which is then evaluated on small chunks of the operands. Intermediate results only live in chunk-sized buffers,
+    hence the statement is computed in a single pass over memory without any temporary vectors or matrices.
+*/
+
+#include <cmath>
+#include <vector>
+#include <algorithm>
+
+#include "viennacl/forwards.h"
+#include "viennacl/scalar.hpp"
+#include "viennacl/vector.hpp"
+#include "viennacl/matrix.hpp"
+#include "viennacl/traits/size.hpp"
+#include "viennacl/traits/start.hpp"
+#include "viennacl/traits/stride.hpp"
+#include "viennacl/traits/handle.hpp"
+#include "viennacl/linalg/host_based/common.hpp"
+#include "viennacl/scheduler/forwards.h"
+
+namespace viennacl
+{
+  namespace scheduler
+  {
+    namespace detail
+    {
+      /** @brief Number of entries processed by one instruction at a time. Chosen such that the buffers of typical expressions fit into the L1 cache. */
+      inline long fused_chunk_size() { return 128; }
+
+      /** @brief Number of entries of the innermost dimension assigned to one OpenMP work item */
+      inline long fused_block_size() { return 4096; }
+
+      /** @brief An instruction of a fused statement. Leaves are dense operands or scalars, all other instructions refer to the results of previous instructions.
+      *
+      * Entry (o, t) of a dense operand is located at data[offset + o * outer_inc + t * inner_inc], where o and t are the outer and inner index of the result.
+      */
+      template <typename NumericT>
+      struct fused_instruction
+      {
+        fused_instruction() : op(OPERATION_INVALID_TYPE), is_scalar(false), scalar_value(0),
+                              data(NULL), offset(0), outer_inc(0), inner_inc(0), lhs(0), rhs(0) {}
+
+        operation_node_type op;           // OPERATION_INVALID_TYPE for leaves
+        bool                is_scalar;
+        NumericT            scalar_value;
+
+        NumericT *          data;
+        long                offset;
+        long                outer_inc;
+        long                inner_inc;
+
+        std::size_t         lhs;
+        std::size_t         rhs;
+      };
+
+      /** @brief A statement translated to a list of instructions in post-order, evaluated chunk by chunk */
+      template <typename NumericT>
+      class fused_program
+      {
+        public:
+          typedef fused_instruction<NumericT>   instruction_type;
+
+          /** @brief Sets up the iteration space from the result operand. Row-major matrices are traversed row by row, column-major matrices column by column. */
+          fused_program(long outer_size, long inner_size, bool row_major) : outer_size_(outer_size), inner_size_(inner_size), row_major_(row_major) {}
+
+          long outer_size() const { return outer_size_; }
+          long inner_size() const { return inner_size_; }
+
+          std::vector<instruction_type> const & instructions() const { return instructions_; }
+
+          /** @brief Returns the access pattern of a vector within the iteration space */
+          instruction_type make_operand(viennacl::vector_base<NumericT> & vec) const
+          {
+            instruction_type leaf;
+            leaf.data      = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(vec);
+            leaf.offset    = static_cast<long>(viennacl::traits::start(vec));
+            leaf.outer_inc = 0;
+            leaf.inner_inc = static_cast<long>(viennacl::traits::stride(vec));
+            return leaf;
+          }
+
+          /** @brief Returns the access pattern of a matrix within the iteration space. The layout of the matrix may differ from the layout of the result. */
+          template <typename F>
+          instruction_type make_operand(viennacl::matrix_base<NumericT, F> & mat) const
+          {
+            long start1  = static_cast<long>(viennacl::traits::start1(mat));
+            long start2  = static_cast<long>(viennacl::traits::start2(mat));
+            long stride1 = static_cast<long>(viennacl::traits::stride1(mat));
+            long stride2 = static_cast<long>(viennacl::traits::stride2(mat));
+            long inc_row, inc_col;   // distance between two consecutive rows/columns in memory
+
+            instruction_type leaf;
+            leaf.data = viennacl::linalg::host_based::detail::extract_raw_pointer<NumericT>(mat);
+            if (viennacl::is_row_major<F>::value)
+            {
+              inc_row = stride1 * static_cast<long>(mat.internal_size2());
+              inc_col = stride2;
+              leaf.offset = start1 * static_cast<long>(mat.internal_size2()) + start2;
+            }
+            else
+            {
+              inc_row = stride1;
+              inc_col = stride2 * static_cast<long>(mat.internal_size1());
+              leaf.offset = start1 + start2 * static_cast<long>(mat.internal_size1());
+            }
+            leaf.outer_inc = row_major_ ? inc_row : inc_col;
+            leaf.inner_inc = row_major_ ? inc_col : inc_row;
+            return leaf;
+          }
+
+          /** @brief Appends an instruction and returns its index */
+          std::size_t add(instruction_type const & instr)
+          {
+            instructions_.push_back(instr);
+            return instructions_.size() - 1;
+          }
+
+          /** @brief Evaluates all instructions on the entries (o, t_start), ..., (o, t_start + length - 1).
+          *
+          * @param o         Outer index
+          * @param t_start   First inner index
+          * @param length    Number of entries, at most fused_chunk_size()
+          * @param buffer    Scratch buffer of size instructions().size() * fused_chunk_size()
+          * @param results   Array of size instructions().size(), receives pointers to the (unit-stride) results of all instructions
+          */
+          void evaluate(long o, long t_start, long length, NumericT * buffer, NumericT const ** results) const
+          {
+            long chunk = fused_chunk_size();
+            for (std::size_t i=0; i<instructions_.size(); ++i)
+            {
+              instruction_type const & instr = instructions_[i];
+              NumericT * out = buffer + static_cast<long>(i) * chunk;
+
+              if (instr.op == OPERATION_INVALID_TYPE)
+              {
+                if (instr.is_scalar)
+                {
+                  results[i] = NULL;
+                  continue;
+                }
+
+                NumericT const * in = instr.data + instr.offset + o * instr.outer_inc + t_start * instr.inner_inc;
+                if (instr.inner_inc == 1)
+                  results[i] = in;
+                else
+                {
+                  for (long t=0; t<length; ++t)
+                    out[t] = in[t * instr.inner_inc];
+                  results[i] = out;
+                }
+                continue;
+              }
+
+              NumericT const * a = results[instr.lhs];
+              NumericT const * b = results[instr.rhs];   // not used by unary operations and scalar operands
+              switch (instr.op)
+              {
+                case OPERATION_BINARY_ADD_TYPE:
+                  for (long t=0; t<length; ++t) out[t] = a[t] + b[t];
+                  break;
+                case OPERATION_BINARY_SUB_TYPE:
+                  for (long t=0; t<length; ++t) out[t] = a[t] - b[t];
+                  break;
+                case OPERATION_BINARY_MULT_TYPE:
+                {
+                  NumericT alpha = instructions_[instr.rhs].scalar_value;
+                  for (long t=0; t<length; ++t) out[t] = a[t] * alpha;
+                  break;
+                }
+                case OPERATION_BINARY_DIV_TYPE:
+                {
+                  NumericT alpha = instructions_[instr.rhs].scalar_value;
+                  for (long t=0; t<length; ++t) out[t] = a[t] / alpha;
+                  break;
+                }
+                case OPERATION_BINARY_ELEMENT_PROD_TYPE:
+                  for (long t=0; t<length; ++t) out[t] = a[t] * b[t];
+                  break;
+                case OPERATION_BINARY_ELEMENT_DIV_TYPE:
+                  for (long t=0; t<length; ++t) out[t] = a[t] / b[t];
+                  break;
+                case OPERATION_UNARY_ABS_TYPE:
+                case OPERATION_UNARY_FABS_TYPE:
+                  for (long t=0; t<length; ++t) out[t] = std::fabs(a[t]);
+                  break;
+                case OPERATION_UNARY_ACOS_TYPE:  for (long t=0; t<length; ++t) out[t] = std::acos(a[t]);  break;
+                case OPERATION_UNARY_ASIN_TYPE:  for (long t=0; t<length; ++t) out[t] = std::asin(a[t]);  break;
+                case OPERATION_UNARY_ATAN_TYPE:  for (long t=0; t<length; ++t) out[t] = std::atan(a[t]);  break;
+                case OPERATION_UNARY_CEIL_TYPE:  for (long t=0; t<length; ++t) out[t] = std::ceil(a[t]);  break;
+                case OPERATION_UNARY_COS_TYPE:   for (long t=0; t<length; ++t) out[t] = std::cos(a[t]);   break;
+                case OPERATION_UNARY_COSH_TYPE:  for (long t=0; t<length; ++t) out[t] = std::cosh(a[t]);  break;
+                case OPERATION_UNARY_EXP_TYPE:   for (long t=0; t<length; ++t) out[t] = std::exp(a[t]);   break;
+                case OPERATION_UNARY_FLOOR_TYPE: for (long t=0; t<length; ++t) out[t] = std::floor(a[t]); break;
+                case OPERATION_UNARY_LOG_TYPE:   for (long t=0; t<length; ++t) out[t] = std::log(a[t]);   break;
+                case OPERATION_UNARY_LOG10_TYPE: for (long t=0; t<length; ++t) out[t] = std::log10(a[t]); break;
+                case OPERATION_UNARY_SIN_TYPE:   for (long t=0; t<length; ++t) out[t] = std::sin(a[t]);   break;
+                case OPERATION_UNARY_SINH_TYPE:  for (long t=0; t<length; ++t) out[t] = std::sinh(a[t]);  break;
+                case OPERATION_UNARY_SQRT_TYPE:  for (long t=0; t<length; ++t) out[t] = std::sqrt(a[t]);  break;
+                case OPERATION_UNARY_TAN_TYPE:   for (long t=0; t<length; ++t) out[t] = std::tan(a[t]);   break;
+                case OPERATION_UNARY_TANH_TYPE:  for (long t=0; t<length; ++t) out[t] = std::tanh(a[t]);  break;
+                default:
+                  throw statement_not_supported_exception("Invalid operation in fused statement");
+              }
+              results[i] = out;
+            }
+          }
+
+        private:
+          long outer_size_;
+          long inner_size_;
+          bool row_major_;
+          std::vector<instruction_type> instructions_;
+      };
+
+
+
+      //
+      // Access to the operands of a statement for a given numeric type
+      //
+      inline viennacl::vector_base<float>  * fused_vector(lhs_rhs_element const & e, float)  { return e.vector_float; }
+      inline viennacl::vector_base<double> * fused_vector(lhs_rhs_element const & e, double) { return e.vector_double; }
+
+      inline viennacl::matrix_base<float,  viennacl::row_major> * fused_row_matrix(lhs_rhs_element const & e, float)  { return e.matrix_row_float; }
+      inline viennacl::matrix_base<double, viennacl::row_major> * fused_row_matrix(lhs_rhs_element const & e, double) { return e.matrix_row_double; }
+
+      inline viennacl::matrix_base<float,  viennacl::column_major> * fused_col_matrix(lhs_rhs_element const & e, float)  { return e.matrix_col_float; }
+      inline viennacl::matrix_base<double, viennacl::column_major> * fused_col_matrix(lhs_rhs_element const & e, double) { return e.matrix_col_double; }
+
+      inline viennacl::scalar<float>  * fused_scalar(lhs_rhs_element const & e, float)  { return e.scalar_float; }
+      inline viennacl::scalar<double> * fused_scalar(lhs_rhs_element const & e, double) { return e.scalar_double; }
+
+      template <typename T>
+      bool fused_in_main_memory(T const & obj) { return viennacl::traits::handle(obj).get_active_handle_id() == viennacl::MAIN_MEMORY; }
+
+      /** @brief Adds the leaf 'e' to the program. Returns false if the operand cannot be fused (wrong type, memory domain, or size) */
+      template <typename NumericT>
+      bool fused_add_leaf(fused_program<NumericT> & prog, lhs_rhs_element const & e,
+                          long size1, long size2, std::size_t & index)
+      {
+        if (e.numeric_type != statement_node_numeric_type(result_of::numeric_type_id<NumericT>::value))
+          return false;
+
+        typedef fused_instruction<NumericT>  instruction_type;
+
+        if (e.type_family == SCALAR_TYPE_FAMILY)
+        {
+          instruction_type leaf;
+          leaf.is_scalar = true;
+          if (e.subtype == HOST_SCALAR_TYPE)
+            leaf.scalar_value = (e.numeric_type == FLOAT_TYPE) ? NumericT(e.host_float) : NumericT(e.host_double);
+          else if (e.subtype == DEVICE_SCALAR_TYPE && fused_in_main_memory(*fused_scalar(e, NumericT())))
+            leaf.scalar_value = *fused_scalar(e, NumericT());
+          else
+            return false;
+          index = prog.add(leaf);
+          return true;
+        }
+
+        if (e.type_family == VECTOR_TYPE_FAMILY && e.subtype == DENSE_VECTOR_TYPE)
+        {
+          viennacl::vector_base<NumericT> & vec = *fused_vector(e, NumericT());
+          if (!fused_in_main_memory(vec) || size1 != 1 || static_cast<long>(vec.size()) != size2)
+            return false;
+          index = prog.add(prog.make_operand(vec));
+          return true;
+        }
+
+        if (e.type_family == MATRIX_TYPE_FAMILY && e.subtype == DENSE_ROW_MATRIX_TYPE)
+        {
+          viennacl::matrix_base<NumericT, viennacl::row_major> & mat = *fused_row_matrix(e, NumericT());
+          if (!fused_in_main_memory(mat) || static_cast<long>(mat.size1()) != size1 || static_cast<long>(mat.size2()) != size2)
+            return false;
+          index = prog.add(prog.make_operand(mat));
+          return true;
+        }
+
+        if (e.type_family == MATRIX_TYPE_FAMILY && e.subtype == DENSE_COL_MATRIX_TYPE)
+        {
+          viennacl::matrix_base<NumericT, viennacl::column_major> & mat = *fused_col_matrix(e, NumericT());
+          if (!fused_in_main_memory(mat) || static_cast<long>(mat.size1()) != size1 || static_cast<long>(mat.size2()) != size2)
+            return false;
+          index = prog.add(prog.make_operand(mat));
+          return true;
+        }
+
+        return false;
+      }
+
+      /** @brief Recursively translates an element-wise (sub)expression to instructions. Returns false if the expression cannot be fused.
+      *
+      * @param s       The statement
+      * @param e       The operand or subexpression to translate
+      * @param prog    The program the instructions are appended to
+      * @param size1   Number of rows of the result (1 for vectors)
+      * @param size2   Number of columns of the result (size for vectors)
+      * @param index   Receives the index of the instruction holding the result of 'e'
+      */
+      template <typename NumericT>
+      bool fused_compile(statement const & s, lhs_rhs_element const & e, fused_program<NumericT> & prog,
+                         long size1, long size2, std::size_t & index)
+      {
+        if (e.type_family != COMPOSITE_OPERATION_FAMILY)
+          return fused_add_leaf(prog, e, size1, size2, index);
+
+        statement_node const & node = s.array()[e.node_index];
+        fused_instruction<NumericT> instr;
+        instr.op = node.op.type;
+
+        switch (node.op.type)
+        {
+          case OPERATION_BINARY_ADD_TYPE:
+          case OPERATION_BINARY_SUB_TYPE:
+          case OPERATION_BINARY_ELEMENT_PROD_TYPE:
+          case OPERATION_BINARY_ELEMENT_DIV_TYPE:
+            if (!fused_compile(s, node.lhs, prog, size1, size2, instr.lhs) || !fused_compile(s, node.rhs, prog, size1, size2, instr.rhs))
+              return false;
+            if (prog.instructions()[instr.lhs].is_scalar || prog.instructions()[instr.rhs].is_scalar)
+              return false;
+            break;
+
+          case OPERATION_BINARY_MULT_TYPE:
+          case OPERATION_BINARY_DIV_TYPE:
+            // the scalar must be a leaf, scalar subexpressions such as x = inner_prod(y, z) * w are left to the default implementation:
+            if (node.rhs.type_family != SCALAR_TYPE_FAMILY)
+              return false;
+            if (!fused_compile(s, node.lhs, prog, size1, size2, instr.lhs) || !fused_compile(s, node.rhs, prog, size1, size2, instr.rhs))
+              return false;
+            if (prog.instructions()[instr.lhs].is_scalar)
+              return false;
+            break;
+
+          case OPERATION_UNARY_ABS_TYPE:
+          case OPERATION_UNARY_ACOS_TYPE:
+          case OPERATION_UNARY_ASIN_TYPE:
+          case OPERATION_UNARY_ATAN_TYPE:
+          case OPERATION_UNARY_CEIL_TYPE:
+          case OPERATION_UNARY_COS_TYPE:
+          case OPERATION_UNARY_COSH_TYPE:
+          case OPERATION_UNARY_EXP_TYPE:
+          case OPERATION_UNARY_FABS_TYPE:
+          case OPERATION_UNARY_FLOOR_TYPE:
+          case OPERATION_UNARY_LOG_TYPE:
+          case OPERATION_UNARY_LOG10_TYPE:
+          case OPERATION_UNARY_SIN_TYPE:
+          case OPERATION_UNARY_SINH_TYPE:
+          case OPERATION_UNARY_SQRT_TYPE:
+          case OPERATION_UNARY_TAN_TYPE:
+          case OPERATION_UNARY_TANH_TYPE:
+            if (!fused_compile(s, node.lhs, prog, size1, size2, instr.lhs) || prog.instructions()[instr.lhs].is_scalar)
+              return false;
+            break;
+
+          default:   // products, transpositions, and nested reductions are not element-wise
+            return false;
+        }
+
+        index = prog.add(instr);
+        return true;
+      }
+
+      /** @brief Returns true if one of the dense operands of the program shares memory with 'target' using a different access pattern.
+      *
+      * Entry-wise aliasing as in x = x + y is fine, because each chunk is read completely before it is written.
+      */
+      template <typename NumericT>
+      bool fused_has_hazard(fused_program<NumericT> const & prog, fused_instruction<NumericT> const & target)
+      {
+        typedef typename std::vector< fused_instruction<NumericT> >::const_iterator  iterator;
+        for (iterator it = prog.instructions().begin(); it != prog.instructions().end(); ++it)
+        {
+          if (it->op != OPERATION_INVALID_TYPE || it->is_scalar || it->data != target.data)
+            continue;
+          if (it->offset != target.offset || it->outer_inc != target.outer_inc || it->inner_inc != target.inner_inc)
+            return true;
+        }
+        return false;
+      }
+
+      /** @brief Runs the program and stores (or adds/subtracts) the result of the last instruction to 'target' */
+      template <typename NumericT>
+      void fused_run_assign(fused_program<NumericT> const & prog, fused_instruction<NumericT> const & target, operation_node_type assign_op)
+      {
+        long chunk = fused_chunk_size();
+        long block = fused_block_size();
+        long num_instr = static_cast<long>(prog.instructions().size());
+        long blocks_per_outer = (prog.inner_size() - 1) / block + 1;
+        long num_blocks = prog.outer_size() * blocks_per_outer;
+
+#ifdef VIENNACL_WITH_OPENMP
+        #pragma omp parallel if (prog.outer_size() * prog.inner_size() > 5000)
+#endif
+        {
+          std::vector<NumericT>         buffer(static_cast<std::size_t>(num_instr * chunk));
+          std::vector<NumericT const *> results(static_cast<std::size_t>(num_instr));
+
+#ifdef VIENNACL_WITH_OPENMP
+          #pragma omp for
+#endif
+          for (long block_id = 0; block_id < num_blocks; ++block_id)
+          {
+            long o = block_id / blocks_per_outer;
+            long t_end = std::min(prog.inner_size(), (block_id % blocks_per_outer + 1) * block);
+            for (long t_start = (block_id % blocks_per_outer) * block; t_start < t_end; t_start += chunk)
+            {
+              long length = std::min(chunk, t_end - t_start);
+              prog.evaluate(o, t_start, length, &(buffer[0]), &(results[0]));
+
+              NumericT const * result = results[static_cast<std::size_t>(num_instr - 1)];
+              NumericT * out = target.data + target.offset + o * target.outer_inc + t_start * target.inner_inc;
+              long inc = target.inner_inc;
+              switch (assign_op)
+              {
+                case OPERATION_BINARY_ASSIGN_TYPE:      for (long t=0; t<length; ++t) out[t*inc]  = result[t]; break;
+                case OPERATION_BINARY_INPLACE_ADD_TYPE: for (long t=0; t<length; ++t) out[t*inc] += result[t]; break;
+                default:                                for (long t=0; t<length; ++t) out[t*inc] -= result[t]; break;
+              }
+            }
+          }
+        }
+      }
+
+      /** @brief Runs the program and returns the reduction 'reduction_op' of the results of the instructions 'lhs' and 'rhs' (rhs is only used for inner products) */
+      template <typename NumericT>
+      NumericT fused_run_reduction(fused_program<NumericT> const & prog, operation_node_type reduction_op, std::size_t lhs, std::size_t rhs)
+      {
+        long chunk = fused_chunk_size();
+        long block = fused_block_size();
+        long num_instr = static_cast<long>(prog.instructions().size());
+        long num_blocks = (prog.inner_size() - 1) / block + 1;
+
+        std::vector<NumericT> partial(static_cast<std::size_t>(num_blocks));
+
+#ifdef VIENNACL_WITH_OPENMP
+        #pragma omp parallel if (prog.inner_size() > 5000)
+#endif
+        {
+          std::vector<NumericT>         buffer(static_cast<std::size_t>(num_instr * chunk));
+          std::vector<NumericT const *> results(static_cast<std::size_t>(num_instr));
+
+#ifdef VIENNACL_WITH_OPENMP
+          #pragma omp for
+#endif
+          for (long block_id = 0; block_id < num_blocks; ++block_id)
+          {
+            NumericT temp = 0;
+            long t_end = std::min(prog.inner_size(), (block_id + 1) * block);
+            for (long t_start = block_id * block; t_start < t_end; t_start += chunk)
+            {
+              long length = std::min(chunk, t_end - t_start);
+              prog.evaluate(0, t_start, length, &(buffer[0]), &(results[0]));
+
+              NumericT const * x = results[lhs];
+              NumericT const * y = results[rhs];
+              switch (reduction_op)
+              {
+                case OPERATION_BINARY_INNER_PROD_TYPE: for (long t=0; t<length; ++t) temp += x[t] * y[t]; break;
+                case OPERATION_UNARY_NORM_1_TYPE:      for (long t=0; t<length; ++t) temp += std::fabs(x[t]); break;
+                case OPERATION_UNARY_NORM_2_TYPE:      for (long t=0; t<length; ++t) temp += x[t] * x[t]; break;
+                default:                               for (long t=0; t<length; ++t) temp = std::max(temp, std::fabs(x[t])); break;
+              }
+            }
+            partial[static_cast<std::size_t>(block_id)] = temp;
+          }
+        }
+
+        NumericT result = 0;
+        for (std::size_t i=0; i<partial.size(); ++i)
+          result = (reduction_op == OPERATION_UNARY_NORM_INF_TYPE) ? std::max(result, partial[i]) : result + partial[i];
+
+        return (reduction_op == OPERATION_UNARY_NORM_2_TYPE) ? std::sqrt(result) : result;
+      }
+
+      /** @brief Tries to execute x = RHS, x += RHS, x -= RHS for a vector or matrix x and an element-wise expression RHS in a single pass. Returns false if not applicable. */
+      template <typename NumericT>
+      bool execute_fused_assign(statement const & s, statement_node const & root_node)
+      {
+        lhs_rhs_element const & lhs = root_node.lhs;
+        long size1 = 0, size2 = 0;
+        bool row_major = true;
+        fused_instruction<NumericT> target;
+
+        if (lhs.type_family == VECTOR_TYPE_FAMILY && lhs.subtype == DENSE_VECTOR_TYPE)
+        {
+          viennacl::vector_base<NumericT> & vec = *fused_vector(lhs, NumericT());
+          if (!fused_in_main_memory(vec))
+            return false;
+          size1 = 1;
+          size2 = static_cast<long>(vec.size());
+          target = fused_program<NumericT>(size1, size2, true).make_operand(vec);
+        }
+        else if (lhs.type_family == MATRIX_TYPE_FAMILY && lhs.subtype == DENSE_ROW_MATRIX_TYPE)
+        {
+          viennacl::matrix_base<NumericT, viennacl::row_major> & mat = *fused_row_matrix(lhs, NumericT());
+          if (!fused_in_main_memory(mat))
+            return false;
+          size1 = static_cast<long>(mat.size1());
+          size2 = static_cast<long>(mat.size2());
+          target = fused_program<NumericT>(size1, size2, true).make_operand(mat);
+        }
+        else if (lhs.type_family == MATRIX_TYPE_FAMILY && lhs.subtype == DENSE_COL_MATRIX_TYPE)
+        {
+          viennacl::matrix_base<NumericT, viennacl::column_major> & mat = *fused_col_matrix(lhs, NumericT());
+          if (!fused_in_main_memory(mat))
+            return false;
+          size1 = static_cast<long>(mat.size1());
+          size2 = static_cast<long>(mat.size2());
+          row_major = false;
+          target = fused_program<NumericT>(size2, size1, false).make_operand(mat);
+        }
+        else
+          return false;
+
+        if (size1 == 0 || size2 == 0)
+          return false;
+
+        fused_program<NumericT> prog(row_major ? size1 : size2, row_major ? size2 : size1, row_major);
+        std::size_t result_index = 0;
+        if (!fused_compile(s, root_node.rhs, prog, size1, size2, result_index) || prog.instructions()[result_index].is_scalar)
+          return false;
+        if (fused_has_hazard(prog, target))
+          return false;
+
+        fused_run_assign(prog, target, root_node.op.type);
+        return true;
+      }
+
+      /** @brief Tries to execute alpha = inner_prod(RHS1, RHS2) or alpha = norm_X(RHS) for element-wise vector expressions in a single pass. Returns false if not applicable. */
+      template <typename NumericT>
+      bool execute_fused_reduction(statement const & s, statement_node const & root_node)
+      {
+        if (root_node.lhs.subtype != DEVICE_SCALAR_TYPE || root_node.op.type != OPERATION_BINARY_ASSIGN_TYPE)
+          return false;
+
+        viennacl::scalar<NumericT> & alpha = *fused_scalar(root_node.lhs, NumericT());
+        if (!fused_in_main_memory(alpha))
+          return false;
+
+        statement_node const & node = s.array()[root_node.rhs.node_index];
+        if (   node.op.type != OPERATION_BINARY_INNER_PROD_TYPE
+            && node.op.type != OPERATION_UNARY_NORM_1_TYPE
+            && node.op.type != OPERATION_UNARY_NORM_2_TYPE
+            && node.op.type != OPERATION_UNARY_NORM_INF_TYPE)
+          return false;
+
+        // the size of the reduction is determined by one of the vector operands:
+        lhs_rhs_element const * vec = &node.lhs;
+        while (vec->type_family == COMPOSITE_OPERATION_FAMILY)
+          vec = &(s.array()[vec->node_index].lhs);
+        if (vec->type_family != VECTOR_TYPE_FAMILY || vec->subtype != DENSE_VECTOR_TYPE || vec->numeric_type != root_node.lhs.numeric_type)
+          return false;
+        long size = static_cast<long>(fused_vector(*vec, NumericT())->size());
+        if (size == 0)
+          return false;
+
+        fused_program<NumericT> prog(1, size, true);
+        std::size_t lhs_index = 0;
+        std::size_t rhs_index = 0;
+        if (!fused_compile(s, node.lhs, prog, 1, size, lhs_index) || prog.instructions()[lhs_index].is_scalar)
+          return false;
+        if (node.op.type == OPERATION_BINARY_INNER_PROD_TYPE)
+        {
+          if (!fused_compile(s, node.rhs, prog, 1, size, rhs_index) || prog.instructions()[rhs_index].is_scalar)
+            return false;
+        }
+        else
+          rhs_index = lhs_index;
+
+        alpha = fused_run_reduction(prog, node.op.type, lhs_index, rhs_index);
+        return true;
+      }
+
+      /** @brief Tries to execute the statement with root node 'root_node' in a single fused pass on the host. Returns false if the statement is left to the default implementation.
+      *
+      * Applicable to statements with a composite right hand side in main memory consisting of
+      *   - element-wise operations (+, -, multiplication and division by a scalar, element_prod(), element_div(), element_exp(), ...) on dense vectors or matrices of identical size,
+      *   - inner products and norms of such vector expressions.
+      */
+      inline bool execute_fused(statement const & s, statement_node const & root_node)
+      {
+        if (root_node.rhs.type_family != COMPOSITE_OPERATION_FAMILY)
+          return false;
+
+        if (   root_node.op.type != OPERATION_BINARY_ASSIGN_TYPE
+            && root_node.op.type != OPERATION_BINARY_INPLACE_ADD_TYPE
+            && root_node.op.type != OPERATION_BINARY_INPLACE_SUB_TYPE)
+          return false;
+
+        switch (root_node.lhs.type_family)
+        {
+          case SCALAR_TYPE_FAMILY:
+            if (root_node.lhs.numeric_type == FLOAT_TYPE)
+              return execute_fused_reduction<float>(s, root_node);
+            if (root_node.lhs.numeric_type == DOUBLE_TYPE)
+              return execute_fused_reduction<double>(s, root_node);
+            return false;
+          case VECTOR_TYPE_FAMILY:
+          case MATRIX_TYPE_FAMILY:
+            if (root_node.lhs.numeric_type == FLOAT_TYPE)
+              return execute_fused_assign<float>(s, root_node);
+            if (root_node.lhs.numeric_type == DOUBLE_TYPE)
+              return execute_fused_assign<double>(s, root_node);
+            return false;
+          default:
+            return false;
+        }
+      }
+
+    } // namespace detail
+  } // namespace scheduler
+} // namespace viennacl
+
+#endif
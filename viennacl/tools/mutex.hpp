@@ -0,0 +1,208 @@
+#ifndef VIENNACL_TOOLS_MUTEX_HPP_
+#define VIENNACL_TOOLS_MUTEX_HPP_
+
+/* =========================================================================
+   Copyright (c) 2010-2013, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/tools/mutex.hpp
+    @brief A minimal mutex, a scoped lock and thread identification used for protecting the shared state of the OpenCL backend.
+*/
+
+#include <cstddef>
+#include <set>
+
+#ifdef _WIN32
+
+#ifndef WIN32_LEAN_AND_MEAN
+  #define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+  #define NOMINMAX
+#endif
+#include <windows.h>
+
+#define VIENNACL_THREAD_LOCAL  __declspec(thread)
+
+#else
+
+#include <pthread.h>
+
+#define VIENNACL_THREAD_LOCAL  __thread
+
+#endif
+
+namespace viennacl
+{
+  namespace tools
+  {
+
+    /** @brief A recursive mutex, i.e. the thread holding the lock may lock it again.
+    *
+    * Copying a mutex yields a new, unlocked mutex, so that classes holding a mutex remain copyable (e.g. for use in std::map).
+    */
+    class mutex
+    {
+      public:
+#ifdef _WIN32
+        mutex()                { InitializeCriticalSection(&m_); }
+        mutex(mutex const &)   { InitializeCriticalSection(&m_); }
+        ~mutex()               { DeleteCriticalSection(&m_); }
+
+        void lock()   { EnterCriticalSection(&m_); }
+        void unlock() { LeaveCriticalSection(&m_); }
+#else
+        mutex()                { init(); }
+        mutex(mutex const &)   { init(); }
+        ~mutex()               { pthread_mutex_destroy(&m_); }
+
+        void lock()   { pthread_mutex_lock(&m_); }
+        void unlock() { pthread_mutex_unlock(&m_); }
+#endif
+
+        mutex & operator=(mutex const &) { return *this; }
+
+      private:
+#ifndef _WIN32
+        void init()
+        {
+          pthread_mutexattr_t attr;
+          pthread_mutexattr_init(&attr);
+          pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+          pthread_mutex_init(&m_, &attr);
+          pthread_mutexattr_destroy(&attr);
+        }
+#endif
+
+#ifdef _WIN32
+        CRITICAL_SECTION m_;
+#else
+        pthread_mutex_t m_;
+#endif
+    };
+
+    /** @brief Locks the mutex for the lifetime of the object */
+    class scoped_lock
+    {
+      public:
+        explicit scoped_lock(mutex & m) : m_(m) { m_.lock(); }
+        ~scoped_lock() { m_.unlock(); }
+
+      private:
+        scoped_lock(scoped_lock const &);
+        scoped_lock & operator=(scoped_lock const &);
+
+        mutex & m_;
+    };
+
+    /** @brief Identifies a thread. Identifiers are assigned consecutively starting at one and are never reused, also not after a thread has terminated. */
+    typedef std::size_t   thread_id_type;
+
+    namespace detail
+    {
+      template <bool dummy = false>  //never use parameter other than default (introduced for linkage issues only)
+      struct thread_registry
+      {
+        static mutex                      mutex_;
+        static thread_id_type             last_id_;
+        static std::set<thread_id_type>   alive_;
+        static bool                       exit_hook_created_;
+#ifdef _WIN32
+        static DWORD                      exit_hook_;
+#else
+        static pthread_key_t              exit_hook_;
+#endif
+      };
+
+      template <bool dummy> mutex                      thread_registry<dummy>::mutex_;
+      template <bool dummy> thread_id_type             thread_registry<dummy>::last_id_ = 0;
+      template <bool dummy> std::set<thread_id_type>   thread_registry<dummy>::alive_;
+      template <bool dummy> bool                       thread_registry<dummy>::exit_hook_created_ = false;
+#ifdef _WIN32
+      template <bool dummy> DWORD                      thread_registry<dummy>::exit_hook_;
+#else
+      template <bool dummy> pthread_key_t              thread_registry<dummy>::exit_hook_;
+#endif
+
+      /** @brief Called by the operating system when a registered thread terminates. The value passed is the identifier of the thread. */
+#ifdef _WIN32
+      inline VOID WINAPI on_thread_exit(PVOID value)
+#else
+      inline void on_thread_exit(void * value)
+#endif
+      {
+        if (value == NULL)
+          return;
+        scoped_lock lock(thread_registry<>::mutex_);
+        thread_registry<>::alive_.erase(reinterpret_cast<thread_id_type>(value));
+      }
+
+      /** @brief Assigns a new identifier to the calling thread and registers it for removal from the set of alive threads upon termination */
+      inline thread_id_type register_thread()
+      {
+        scoped_lock lock(thread_registry<>::mutex_);
+        if (!thread_registry<>::exit_hook_created_)
+        {
+#ifdef _WIN32
+          thread_registry<>::exit_hook_ = FlsAlloc(&on_thread_exit);
+#else
+          pthread_key_create(&thread_registry<>::exit_hook_, &on_thread_exit);
+#endif
+          thread_registry<>::exit_hook_created_ = true;
+        }
+
+        thread_id_type id = ++thread_registry<>::last_id_;
+        thread_registry<>::alive_.insert(id);
+#ifdef _WIN32
+        FlsSetValue(thread_registry<>::exit_hook_, reinterpret_cast<PVOID>(id));
+#else
+        pthread_setspecific(thread_registry<>::exit_hook_, reinterpret_cast<void *>(id));
+#endif
+        return id;
+      }
+    }
+
+    /** @brief Returns the identifier of the calling thread */
+    inline thread_id_type current_thread_id()
+    {
+      static VIENNACL_THREAD_LOCAL thread_id_type id = 0;
+      if (id == 0)
+        id = detail::register_thread();
+      return id;
+    }
+
+    /** @brief Removes the entries of terminated threads from a std::map keyed by thread_id_type.
+    *
+    * Containers of per-thread data call this whenever a thread adds its first entry, so that the container holds
+    * at most one entry per thread alive at that time and the data of terminated threads is released.
+    */
+    template <typename MapT>
+    void erase_terminated_threads(MapT & per_thread_data)
+    {
+      scoped_lock lock(detail::thread_registry<>::mutex_);
+      for (typename MapT::iterator it = per_thread_data.begin(); it != per_thread_data.end(); )
+      {
+        if (detail::thread_registry<>::alive_.find(it->first) == detail::thread_registry<>::alive_.end())
+          per_thread_data.erase(it++);
+        else
+          ++it;
+      }
+    }
+
+  }
+}
+
+#endif
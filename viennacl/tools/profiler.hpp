@@ -0,0 +1,399 @@
+#ifndef VIENNACL_TOOLS_PROFILER_HPP_
+#define VIENNACL_TOOLS_PROFILER_HPP_
+
+/* =========================================================================
+   Copyright (c) 2010-2013, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/tools/profiler.hpp
+    @brief An opt-in profiler recording wall time, bytes moved, and floating point operations of the operations of all compute backends.
+
+    The profiler is only compiled in if VIENNACL_WITH_PROFILER is defined, otherwise all hooks in the compute backends are empty inline functions
+    and no thread library is required. Once compiled in, it is disabled by default and enabled either via viennacl::tools::profiler::enable() or by setting the environment variable VIENNACL_PROFILE,
+    in which case a trace in the Chrome trace event format is written to the file given by VIENNACL_PROFILE and a summary table is printed to std::cout at program exit.
+*/
+
+#include <cstdlib>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <map>
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <iomanip>
+
+#include "viennacl/forwards.h"
+#include "viennacl/tools/timer.hpp"
+
+#ifdef VIENNACL_WITH_PROFILER
+#include "viennacl/tools/mutex.hpp"
+#endif
+
+namespace viennacl
+{
+  namespace backend
+  {
+    // defined in viennacl/backend/memory.hpp, which includes this file:
+    inline void finish();
+  }
+
+  namespace tools
+  {
+
+    /** @brief A single record of the profiler: an operation (e.g. inner_prod, spmv, gemm), a memory transfer, a kernel execution on the device, or a program build. */
+    struct profiler_event
+    {
+      std::string            name;       ///< Name of the operation, the kernel, or the program
+      std::string            category;   ///< One of "operation", "transfer", "kernel", "build"
+      viennacl::memory_types backend;    ///< The compute backend carrying out the operation
+      double                 start;      ///< Start time in seconds after the first use of the profiler
+      double                 duration;   ///< Duration in seconds
+      double                 bytes;      ///< Number of bytes read and written (zero if unknown)
+      double                 flops;      ///< Number of floating point operations (zero if unknown)
+      std::size_t            thread;     ///< Index of the calling thread in the order of first appearance
+    };
+
+#ifdef VIENNACL_WITH_PROFILER
+
+    namespace detail
+    {
+      /** @brief Returns a short name of the compute backend */
+      inline std::string backend_name(viennacl::memory_types backend)
+      {
+        switch (backend)
+        {
+          case viennacl::MAIN_MEMORY:   return "host";
+          case viennacl::OPENCL_MEMORY: return "opencl";
+          case viennacl::CUDA_MEMORY:   return "cuda";
+          default:                      return "none";
+        }
+      }
+
+      /** @brief Escapes a string for use in a JSON document */
+      inline std::string json_escape(std::string const & str)
+      {
+        std::string result;
+        for (std::size_t i=0; i<str.size(); ++i)
+        {
+          if (str[i] == '"' || str[i] == '\\')
+            result += '\\';
+          if (static_cast<unsigned char>(str[i]) >= 0x20)
+            result += str[i];
+        }
+        return result;
+      }
+
+      /** @brief Accumulated numbers of all events with the same category, name, and backend */
+      struct profiler_summary_entry
+      {
+        profiler_summary_entry() : calls(0), time(0), bytes(0), flops(0) {}
+
+        std::string name;
+        std::string category;
+        std::string backend;
+        std::size_t calls;
+        double      time;
+        double      bytes;
+        double      flops;
+      };
+
+      inline bool profiler_summary_less(profiler_summary_entry const & a, profiler_summary_entry const & b) { return a.time > b.time; }
+
+
+      /** @brief The shared state of the profiler. Written to the file given by the environment variable VIENNACL_PROFILE (if set) upon destruction. */
+      struct profiler_state
+      {
+        profiler_state() : enabled(false)
+        {
+          clock.start();
+          char const * env = std::getenv("VIENNACL_PROFILE");
+          if (env && *env)
+          {
+            trace_file = env;
+            enabled = true;
+          }
+        }
+
+        ~profiler_state();
+
+        bool                        enabled;
+        std::string                 trace_file;
+        viennacl::tools::timer      clock;
+        std::vector<profiler_event> events;
+        std::vector<viennacl::tools::thread_id_type> threads;
+        viennacl::tools::mutex      mutex;   //operations may be issued from several threads, e.g. within OpenMP parallel regions
+      };
+
+      inline profiler_state & get_profiler_state()
+      {
+        static profiler_state state;
+        return state;
+      }
+    }
+
+    /** @brief The interface to the profiler. All member functions are static.
+    *
+    * While enabled, each operation synchronizes with the compute device upon completion, so that the recorded wall time reflects the execution time of the operation.
+    * Device execution times of OpenCL kernels are obtained from OpenCL events if the command queue was created with profiling enabled,
+    * which is the case for all queues created while the profiler is enabled (i.e. enable the profiler before the first use of OpenCL).
+    */
+    class profiler
+    {
+      public:
+        /** @brief Starts recording */
+        static void enable()  { set_enabled(true); }
+
+        /** @brief Stops recording. Recorded events are kept. */
+        static void disable() { set_enabled(false); }
+
+        /** @brief Returns true if the profiler is recording */
+        static bool enabled()
+        {
+          detail::profiler_state & state = detail::get_profiler_state();
+          viennacl::tools::scoped_lock lock(state.mutex);
+          return state.enabled;
+        }
+
+        /** @brief Returns the time in seconds after the first use of the profiler */
+        static double now() { return detail::get_profiler_state().clock.get(); }
+
+        /** @brief Removes all recorded events */
+        static void clear()
+        {
+          detail::profiler_state & state = detail::get_profiler_state();
+          viennacl::tools::scoped_lock lock(state.mutex);
+          state.events.clear();
+        }
+
+        /** @brief Returns a copy of all recorded events */
+        static std::vector<profiler_event> events()
+        {
+          detail::profiler_state & state = detail::get_profiler_state();
+          viennacl::tools::scoped_lock lock(state.mutex);
+          return state.events;
+        }
+
+        /** @brief Records an event. Ignored if the profiler is disabled.
+        *
+        * @param name      Name of the operation
+        * @param category  Category of the operation, e.g. "operation"
+        * @param backend   The compute backend
+        * @param start     Start time as returned by now()
+        * @param duration  Duration in seconds
+        * @param bytes     Number of bytes read and written
+        * @param flops     Number of floating point operations
+        */
+        static void record(std::string const & name, std::string const & category, viennacl::memory_types backend,
+                           double start, double duration, double bytes = 0, double flops = 0)
+        {
+          detail::profiler_state & state = detail::get_profiler_state();
+          viennacl::tools::scoped_lock lock(state.mutex);
+          if (!state.enabled)
+            return;
+
+          viennacl::tools::thread_id_type id = viennacl::tools::current_thread_id();
+          std::size_t thread = std::find(state.threads.begin(), state.threads.end(), id) - state.threads.begin();
+          if (thread == state.threads.size())
+            state.threads.push_back(id);
+
+          profiler_event e;
+          e.name     = name;
+          e.category = category;
+          e.backend  = backend;
+          e.start    = start;
+          e.duration = duration;
+          e.bytes    = bytes;
+          e.flops    = flops;
+          e.thread   = thread;
+          state.events.push_back(e);
+        }
+
+        /** @brief Writes all recorded events in the Chrome trace event format (load in chrome://tracing or Perfetto).
+        *
+        * Operations, transfers, and builds appear in the timeline of the calling thread, OpenCL kernels in a separate timeline per thread.
+        */
+        static void write_chrome_trace(std::ostream & os) { write_chrome_trace(os, events()); }
+
+        /** @brief Writes the provided events in the Chrome trace event format */
+        static void write_chrome_trace(std::ostream & os, std::vector<profiler_event> const & all_events)
+        {
+          std::ios::fmtflags flags = os.flags();
+          std::streamsize precision = os.precision();
+
+          os << "{\"traceEvents\":[" << std::endl;
+          for (std::size_t i=0; i<all_events.size(); ++i)
+          {
+            profiler_event const & e = all_events[i];
+            bool device = (e.category == "kernel");
+            char buffer[128];
+            std::sprintf(buffer, "\"ts\":%.3f,\"dur\":%.3f", e.start * 1e6, e.duration * 1e6);
+
+            os << "{\"name\":\"" << detail::json_escape(e.name) << "\",\"cat\":\"" << e.category << "\",\"ph\":\"X\","
+               << buffer << ",\"pid\":" << (device ? 1 : 0) << ",\"tid\":" << e.thread
+               << ",\"args\":{\"backend\":\"" << detail::backend_name(e.backend) << "\"";
+            if (e.bytes > 0)
+              os << ",\"bytes\":" << std::fixed << std::setprecision(0) << e.bytes;
+            if (e.flops > 0)
+              os << ",\"flops\":" << std::fixed << std::setprecision(0) << e.flops;
+            os << "}}" << (i + 1 < all_events.size() ? "," : "") << std::endl;
+          }
+          os << "],\"displayTimeUnit\":\"ms\"," << std::endl;
+          os << "\"metadata\":{\"pid 0\":\"host\",\"pid 1\":\"device\"}}" << std::endl;
+
+          os.flags(flags);
+          os.precision(precision);
+        }
+
+        /** @brief Prints a table with the number of calls, the total and average time, and the achieved bandwidth and floating point rate per operation, sorted by total time */
+        static void write_summary(std::ostream & os) { write_summary(os, events()); }
+
+        /** @brief Prints the summary table for the provided events */
+        static void write_summary(std::ostream & os, std::vector<profiler_event> const & all_events)
+        {
+          std::map<std::string, detail::profiler_summary_entry> entries;
+          for (std::size_t i=0; i<all_events.size(); ++i)
+          {
+            profiler_event const & e = all_events[i];
+            detail::profiler_summary_entry & entry = entries[e.category + "|" + detail::backend_name(e.backend) + "|" + e.name];
+            entry.name     = e.name;
+            entry.category = e.category;
+            entry.backend  = detail::backend_name(e.backend);
+            entry.calls   += 1;
+            entry.time    += e.duration;
+            entry.bytes   += e.bytes;
+            entry.flops   += e.flops;
+          }
+
+          std::vector<detail::profiler_summary_entry> sorted_entries;
+          for (std::map<std::string, detail::profiler_summary_entry>::const_iterator it = entries.begin(); it != entries.end(); ++it)
+            sorted_entries.push_back(it->second);
+          std::sort(sorted_entries.begin(), sorted_entries.end(), detail::profiler_summary_less);
+
+          std::ios::fmtflags flags = os.flags();
+          std::streamsize precision = os.precision();
+
+          os << std::left << std::setw(32) << "Operation" << std::setw(10) << "Category" << std::setw(8) << "Backend"
+             << std::right << std::setw(8) << "Calls" << std::setw(14) << "Total [ms]" << std::setw(14) << "Avg [us]"
+             << std::setw(10) << "GB/s" << std::setw(10) << "GFLOP/s" << std::endl;
+          for (std::size_t i=0; i<sorted_entries.size(); ++i)
+          {
+            detail::profiler_summary_entry const & entry = sorted_entries[i];
+            os << std::left << std::setw(32) << entry.name.substr(0, 31) << std::setw(10) << entry.category << std::setw(8) << entry.backend
+               << std::right << std::setw(8) << entry.calls
+               << std::fixed << std::setprecision(3) << std::setw(14) << entry.time * 1e3
+               << std::setw(14) << entry.time * 1e6 / static_cast<double>(entry.calls)
+               << std::setprecision(2);
+            if (entry.bytes > 0 && entry.time > 0)
+              os << std::setw(10) << entry.bytes / entry.time * 1e-9;
+            else
+              os << std::setw(10) << "-";
+            if (entry.flops > 0 && entry.time > 0)
+              os << std::setw(10) << entry.flops / entry.time * 1e-9;
+            else
+              os << std::setw(10) << "-";
+            os << std::endl;
+          }
+
+          os.flags(flags);
+          os.precision(precision);
+        }
+
+      private:
+        static void set_enabled(bool value)
+        {
+          detail::profiler_state & state = detail::get_profiler_state();
+          viennacl::tools::scoped_lock lock(state.mutex);
+          state.enabled = value;
+        }
+    };
+
+    namespace detail
+    {
+      inline profiler_state::~profiler_state()
+      {
+        if (trace_file.empty())
+          return;
+
+        std::ofstream file(trace_file.c_str());
+        profiler::write_chrome_trace(file, events);
+        std::cout << "ViennaCL: Profiler trace written to " << trace_file << std::endl;
+        profiler::write_summary(std::cout, events);
+      }
+    }
+
+
+    /** @brief Records the wall time of the enclosing scope as an event, provided that the profiler is enabled.
+    *
+    * Waits for the completion of all commands of the compute device (viennacl::backend::finish()) at the end of the scope unless the backend is the host.
+    */
+    class profiler_scope
+    {
+      public:
+        profiler_scope(char const * name, viennacl::memory_types backend, double bytes = 0, double flops = 0, char const * category = "operation")
+          : active_(profiler::enabled()), name_(name), category_(category), backend_(backend), bytes_(bytes), flops_(flops), start_(0)
+        {
+          if (active_)
+            start_ = profiler::now();
+        }
+
+        ~profiler_scope()
+        {
+          if (active_)
+          {
+            if (backend_ != viennacl::MAIN_MEMORY)
+              viennacl::backend::finish();
+            profiler::record(name_, category_, backend_, start_, profiler::now() - start_, bytes_, flops_);
+          }
+        }
+
+      private:
+        profiler_scope(profiler_scope const &);
+        profiler_scope & operator=(profiler_scope const &);
+
+        bool                   active_;
+        char const *           name_;
+        char const *           category_;
+        viennacl::memory_types backend_;
+        double                 bytes_;
+        double                 flops_;
+        double                 start_;
+    };
+
+#else
+
+    /** @brief The hooks of the profiler used by the compute backends if VIENNACL_WITH_PROFILER is not defined: nothing is recorded. */
+    class profiler
+    {
+      public:
+        static bool enabled() { return false; }
+        static double now() { return 0; }
+        static void record(std::string const &, std::string const &, viennacl::memory_types, double, double, double = 0, double = 0) {}
+    };
+
+    /** @brief Does nothing if VIENNACL_WITH_PROFILER is not defined */
+    class profiler_scope
+    {
+      public:
+        profiler_scope(char const *, viennacl::memory_types, double = 0, double = 0, char const * = "operation") {}
+    };
+
+#endif
+
+  }
+}
+
+#endif
@@ -0,0 +1,323 @@
+#ifndef VIENNACL_TOOLS_SPARSE_MATRIX_BUILDER_HPP_
+#define VIENNACL_TOOLS_SPARSE_MATRIX_BUILDER_HPP_
+
+/* =========================================================================
+   Copyright (c) 2010-2013, Institute for Microelectronics,
+                            Institute for Analysis and Scientific Computing,
+                            TU Wien.
+   Portions of this software are copyright by UChicago Argonne, LLC.
+
+                            -----------------
+                  ViennaCL - The Vienna Computing Library
+                            -----------------
+
+   Project Head:    Karl Rupp                   rupp@iue.tuwien.ac.at
+
+   (A list of authors and contributors can be found in the PDF manual)
+
+   License:         MIT (X11), see file LICENSE in the base directory
+============================================================================= */
+
+/** @file viennacl/tools/sparse_matrix_builder.hpp
+    @brief Assembly of compressed_matrix objects from coordinate (COO) triplets without intermediate std::map based storage
+*/
+
+#include <vector>
+#include <algorithm>
+#include <assert.h>
+
+#include "viennacl/forwards.h"
+#include "viennacl/backend/memory.hpp"
+#include "viennacl/backend/util.hpp"
+#include "viennacl/tools/tools.hpp"
+
+#ifdef VIENNACL_WITH_OPENMP
+#include <omp.h>
+#endif
+
+namespace viennacl
+{
+  namespace tools
+  {
+    namespace detail
+    {
+      /** @brief Orders triplet indices by their column index. Ties are broken by the triplet index, so duplicates are always summed in the same order. */
+      template <typename IndexT>
+      struct triplet_column_less
+      {
+        triplet_column_less(IndexT const * col_indices) : col_indices_(col_indices) {}
+
+        bool operator()(unsigned int a, unsigned int b) const
+        {
+          return (col_indices_[a] < col_indices_[b]) || (col_indices_[a] == col_indices_[b] && a < b);
+        }
+
+        IndexT const * col_indices_;
+      };
+    }
+
+    /** @brief Assembles compressed_matrix objects from coordinate (COO) triplets (row_indices[k], col_indices[k], values[k]).
+    *
+    * Duplicate triplets are summed up. The sparsity pattern is analyzed once at construction:
+    * The triplets are bucketed by row (a counting sort with one histogram per thread) and sorted by column within each row.
+    * The CSR arrays are then written directly, without intermediate std::map based storage.
+    *
+    * Since the pattern is stored, the same object can reassemble matrices for new values of triplets with the same indices (e.g. in each step of a nonlinear or time-dependent FEM simulation)
+    * at the cost of a gather operation per nonzero: Only the values need to be transferred to the matrix in that case, cf. update().
+    */
+    class sparse_matrix_builder
+    {
+      public:
+        /** @brief Creates a builder without pattern. Assign a builder constructed from triplet indices before use. */
+        sparse_matrix_builder() : size1_(0), size2_(0), alignment_(1), num_triplets_(0) {}
+
+        /** @brief Analyzes the sparsity pattern given by the triplet indices
+        *
+        * @param rows          Number of rows of the matrix
+        * @param cols          Number of columns of the matrix
+        * @param row_indices   Row index of each triplet
+        * @param col_indices   Column index of each triplet
+        * @param alignment     Alignment of the matrix to be assembled, i.e. the ALIGNMENT template parameter of compressed_matrix
+        */
+        template <typename IndexT>
+        sparse_matrix_builder(std::size_t rows, std::size_t cols,
+                              std::vector<IndexT> const & row_indices,
+                              std::vector<IndexT> const & col_indices,
+                              unsigned int alignment = 1)
+          : size1_(rows), size2_(cols), alignment_(alignment), num_triplets_(row_indices.size())
+        {
+          assert( (row_indices.size() == col_indices.size()) && bool("sparse_matrix_builder: Number of row and column indices differs!"));
+          assert( (rows > 0) && (cols > 0) && bool("sparse_matrix_builder: Matrix must not be empty!"));
+
+          if (num_triplets_ > 0)
+            init(&row_indices[0], &col_indices[0]);
+          else
+            init(static_cast<IndexT const *>(NULL), static_cast<IndexT const *>(NULL));
+        }
+
+        /** @brief Returns the number of rows of the assembled matrix */
+        std::size_t size1() const { return size1_; }
+        /** @brief Returns the number of columns of the assembled matrix */
+        std::size_t size2() const { return size2_; }
+        /** @brief Returns the number of distinct nonzeros (i.e. without duplicates and alignment padding) */
+        std::size_t nnz() const { return entry_positions_.size(); }
+
+        /** @brief Writes the row, column and value arrays of the matrix. The triplet values must be given in the same order as the indices passed to the constructor. */
+        template <typename SCALARTYPE, unsigned int ALIGNMENT>
+        void assemble(std::vector<SCALARTYPE> const & values,
+                      compressed_matrix<SCALARTYPE, ALIGNMENT> & gpu_matrix) const
+        {
+          assert( (ALIGNMENT == alignment_) && bool("sparse_matrix_builder: Alignment of the matrix differs from the alignment of the pattern!"));
+
+          std::vector<SCALARTYPE> elements;
+          sum_values(values, elements);
+
+          viennacl::backend::typesafe_host_array<unsigned int> row_buffer(gpu_matrix.handle1(), size1_ + 1);
+          viennacl::backend::typesafe_host_array<unsigned int> col_buffer(gpu_matrix.handle2(), col_indices_.size());
+          for (std::size_t i=0; i<row_jumper_.size(); ++i)
+            row_buffer.set(i, row_jumper_[i]);
+          for (std::size_t i=0; i<col_indices_.size(); ++i)
+            col_buffer.set(i, col_indices_[i]);
+
+          gpu_matrix.set(row_buffer.get(),
+                         col_buffer.get(),
+                         &elements[0],
+                         size1_,
+                         size2_,
+                         elements.size());
+        }
+
+        /** @brief Updates the values of a matrix previously assembled by this object. Only the value array is transferred. */
+        template <typename SCALARTYPE, unsigned int ALIGNMENT>
+        void update(std::vector<SCALARTYPE> const & values,
+                    compressed_matrix<SCALARTYPE, ALIGNMENT> & gpu_matrix) const
+        {
+          assert( (gpu_matrix.size1() == size1_) && (gpu_matrix.size2() == size2_) && (gpu_matrix.nnz() == col_indices_.size())
+                  && bool("sparse_matrix_builder: Matrix was not assembled with this pattern!"));
+
+          std::vector<SCALARTYPE> elements;
+          sum_values(values, elements);
+
+          gpu_matrix.set_values(&elements[0]);
+        }
+
+      private:
+        template <typename IndexT>
+        void init(IndexT const * row_indices, IndexT const * col_indices)
+        {
+          long size1 = static_cast<long>(size1_);
+          long num_triplets = static_cast<long>(num_triplets_);
+
+          //
+          // Step 1: Histogram of the row indices for each block of triplets. Each block is handled by one thread.
+          //         The number of blocks is limited such that the histograms do not take more memory than the triplets.
+          //
+          long num_blocks = 1;
+#ifdef VIENNACL_WITH_OPENMP
+          num_blocks = std::max<long>(1, std::min<long>(omp_get_max_threads(), num_triplets / std::max<long>(size1, 1)));
+#endif
+          long block_size = (num_triplets - 1) / num_blocks + 1;
+          std::vector<unsigned int> block_offsets(static_cast<std::size_t>(num_blocks * size1));
+
+#ifdef VIENNACL_WITH_OPENMP
+          #pragma omp parallel for
+#endif
+          for (long block = 0; block < num_blocks; ++block)
+          {
+            unsigned int * counts = &block_offsets[static_cast<std::size_t>(block * size1)];
+            long block_end = std::min(num_triplets, (block + 1) * block_size);
+            for (long k = block * block_size; k < block_end; ++k)
+            {
+              assert( (static_cast<std::size_t>(row_indices[k]) < size1_) && (static_cast<std::size_t>(col_indices[k]) < size2_) && bool("sparse_matrix_builder: Index out of bounds!"));
+              ++counts[row_indices[k]];
+            }
+          }
+
+          //
+          // Step 2: Start of each row in the triplet order, and start of each block within each row
+          //
+          std::vector<unsigned int> row_start(size1_ + 1);
+          for (std::size_t row = 0; row < size1_; ++row)   //O(rows + num_triplets), since num_blocks * rows <= max(rows, num_triplets)
+          {
+            unsigned int count = 0;
+            for (long block = 0; block < num_blocks; ++block)
+              count += block_offsets[static_cast<std::size_t>(block) * size1_ + row];
+            row_start[row + 1] = row_start[row] + count;
+          }
+
+#ifdef VIENNACL_WITH_OPENMP
+          #pragma omp parallel for
+#endif
+          for (long row = 0; row < size1; ++row)
+          {
+            unsigned int offset = row_start[static_cast<std::size_t>(row)];
+            for (long block = 0; block < num_blocks; ++block)
+            {
+              unsigned int & block_offset = block_offsets[static_cast<std::size_t>(block * size1 + row)];
+              unsigned int count = block_offset;
+              block_offset = offset;
+              offset += count;
+            }
+          }
+
+          //
+          // Step 3: Scatter the triplets to their rows. The order of the triplets within each row is preserved.
+          //
+          triplet_order_.resize(num_triplets_);
+#ifdef VIENNACL_WITH_OPENMP
+          #pragma omp parallel for
+#endif
+          for (long block = 0; block < num_blocks; ++block)
+          {
+            unsigned int * offsets = &block_offsets[static_cast<std::size_t>(block * size1)];
+            long block_end = std::min(num_triplets, (block + 1) * block_size);
+            for (long k = block * block_size; k < block_end; ++k)
+              triplet_order_[offsets[row_indices[k]]++] = static_cast<unsigned int>(k);
+          }
+
+          //
+          // Step 4: Sort each row by column index and count the distinct column indices
+          //
+          std::vector<unsigned int> row_nnz(size1_ + 1);
+#ifdef VIENNACL_WITH_OPENMP
+          #pragma omp parallel for
+#endif
+          for (long row = 0; row < size1; ++row)
+          {
+            unsigned int row_begin = row_start[static_cast<std::size_t>(row)];
+            unsigned int row_end   = row_start[static_cast<std::size_t>(row + 1)];
+            if (row_begin == row_end)
+              continue;
+
+            std::sort(triplet_order_.begin() + row_begin, triplet_order_.begin() + row_end, detail::triplet_column_less<IndexT>(col_indices));
+
+            unsigned int distinct = 1;
+            for (unsigned int k = row_begin + 1; k < row_end; ++k)
+              if (col_indices[triplet_order_[k]] != col_indices[triplet_order_[k-1]])
+                ++distinct;
+            row_nnz[static_cast<std::size_t>(row + 1)] = distinct;
+          }
+
+          //
+          // Step 5: Row jumper of the CSR format (with alignment padding) and offsets of the distinct entries of each row
+          //
+          row_jumper_.resize(size1_ + 1);
+          for (std::size_t row = 0; row < size1_; ++row)
+          {
+            row_jumper_[row + 1] = row_jumper_[row] + viennacl::tools::align_to_multiple<unsigned int>(row_nnz[row + 1], alignment_);
+            row_nnz[row + 1] += row_nnz[row];
+          }
+
+          //
+          // Step 6: Column indices and the triplets contributing to each entry
+          //
+          col_indices_.resize(std::max<std::size_t>(row_jumper_[size1_], 1));   //nonzero array sizes are enforced for empty matrices, cf. copy()
+          entry_positions_.resize(row_nnz[size1_]);
+          entry_begin_.resize(row_nnz[size1_] + 1);
+          entry_begin_[row_nnz[size1_]] = static_cast<unsigned int>(num_triplets_);
+
+#ifdef VIENNACL_WITH_OPENMP
+          #pragma omp parallel for
+#endif
+          for (long row = 0; row < size1; ++row)
+          {
+            unsigned int entry    = row_nnz[static_cast<std::size_t>(row)];
+            unsigned int position = row_jumper_[static_cast<std::size_t>(row)];
+            unsigned int row_end  = row_start[static_cast<std::size_t>(row + 1)];
+            for (unsigned int k = row_start[static_cast<std::size_t>(row)]; k < row_end; ++k)
+            {
+              if (k > row_start[static_cast<std::size_t>(row)] && col_indices[triplet_order_[k]] == col_indices[triplet_order_[k-1]])
+                continue;
+              entry_begin_[entry]     = k;
+              entry_positions_[entry] = position;
+              col_indices_[position]  = static_cast<unsigned int>(col_indices[triplet_order_[k]]);
+              ++entry;
+              ++position;
+            }
+            //alignment padding:
+            for (; position < row_jumper_[static_cast<std::size_t>(row + 1)]; ++position)
+              col_indices_[position] = 0;
+          }
+          if (row_jumper_[size1_] == 0)
+            col_indices_[0] = 0;
+        }
+
+        /** @brief Sums up the triplet values for each entry of the CSR value array. Padding entries are set to zero. */
+        template <typename SCALARTYPE>
+        void sum_values(std::vector<SCALARTYPE> const & values, std::vector<SCALARTYPE> & elements) const
+        {
+          assert( (values.size() == num_triplets_) && bool("sparse_matrix_builder: Number of values differs from the number of indices!"));
+
+          elements.resize(col_indices_.size());
+          if (entry_positions_.size() < elements.size())   //alignment padding or empty matrix
+            std::fill(elements.begin(), elements.end(), SCALARTYPE(0));
+
+          long num_entries = static_cast<long>(entry_positions_.size());
+#ifdef VIENNACL_WITH_OPENMP
+          #pragma omp parallel for
+#endif
+          for (long entry = 0; entry < num_entries; ++entry)
+          {
+            SCALARTYPE sum = 0;
+            for (unsigned int k = entry_begin_[static_cast<std::size_t>(entry)]; k < entry_begin_[static_cast<std::size_t>(entry + 1)]; ++k)
+              sum += values[triplet_order_[k]];
+            elements[entry_positions_[static_cast<std::size_t>(entry)]] = sum;
+          }
+        }
+
+        std::size_t size1_;
+        std::size_t size2_;
+        unsigned int alignment_;
+        std::size_t num_triplets_;
+
+        std::vector<unsigned int> row_jumper_;        //CSR row jumper including alignment padding
+        std::vector<unsigned int> col_indices_;       //CSR column indices including alignment padding
+        std::vector<unsigned int> triplet_order_;     //triplet indices sorted by row and column
+        std::vector<unsigned int> entry_begin_;       //first triplet (in triplet_order_) of each distinct entry
+        std::vector<unsigned int> entry_positions_;   //position of each distinct entry in the CSR arrays
+    };
+
+  } //namespace tools
+} //namespace viennacl
+
+#endif
@@ -32,7 +32,6 @@
 #include "viennacl/linalg/detail/op_executor.hpp"
 #include "viennacl/linalg/vector_operations.hpp"
 #include "viennacl/meta/result_of.hpp"
-//#include "viennacl/rand/utils.hpp"
 #include "viennacl/context.hpp"
 #include "viennacl/traits/handle.hpp"
 
@@ -133,12 +132,6 @@ namespace viennacl
   };
 
 
-//#ifdef VIENNACL_WITH_OPENCL
-//  template<class SCALARTYPE, class DISTRIBUTION>
-//  rand::random_vector_t<SCALARTYPE, DISTRIBUTION> random_vector(unsigned int size, DISTRIBUTION const & distribution){
-//      return rand::random_vector_t<SCALARTYPE,DISTRIBUTION>(size,distribution);
-//  }
-//#endif
 
 
   //
@@ -444,16 +437,6 @@ namespace viennacl
       }
 #endif
 
-      /** @brief Creates the vector from the supplied random vector. */
-      /*template<class DISTRIBUTION>
-      vector(rand::random_vector_t<SCALARTYPE, DISTRIBUTION> v) : size_(v.size)
-      {
-        if(size_ > 0)
-        {
-          viennacl::backend::memory_create(elements_, sizeof(SCALARTYPE)*internal_size());
-          rand::buffer_dumper<SCALARTYPE, DISTRIBUTION>::dump(elements_,v.distribution,0,size_);
-        }
-      } */
 
       template <typename LHS, typename RHS, typename OP>
       explicit vector_base(vector_expression<const LHS, const RHS, OP> const & proxy)
@@ -1522,6 +1505,67 @@ namespace viennacl
     viennacl::async_copy(cpu_vec.begin(), cpu_vec.end(), gpu_vec.begin());
   }
 
+#ifdef VIENNACL_WITH_OPENCL
+  /** @brief Asynchronous transfer from a cpu vector to a gpu vector in the provided OpenCL queue. Returns the event of the transfer.
+  *
+  * The transfer starts after the commands identified by 'dependencies' have completed. Using a queue different from the one used for computations
+  * allows for overlapping transfers with computations, cf. viennacl::ocl::command_queue::wait_for() for synchronizing the queues.
+  * The cpu vector must reside in a linear piece of memory and must not be modified before the transfer has completed.
+  *
+  * @param cpu_vec       A cpu vector with entries linear in memory (e.g. std::vector)
+  * @param gpu_vec       The gpu vector with unit stride, residing in the context of 'queue'. Must not be shorter than the cpu vector.
+  * @param queue         The queue used for the transfer
+  * @param dependencies  Events of commands which need to complete before the transfer starts
+  */
+  template <typename CPUVECTOR, typename NumericT>
+  viennacl::ocl::event async_copy(const CPUVECTOR & cpu_vec, vector_base<NumericT> & gpu_vec,
+                                  viennacl::ocl::command_queue const & queue,
+                                  std::vector<viennacl::ocl::event> const & dependencies = std::vector<viennacl::ocl::event>())
+  {
+    assert(viennacl::traits::active_handle_id(gpu_vec) == viennacl::OPENCL_MEMORY && bool("Asynchronous transfers with events require an OpenCL vector"));
+    assert(gpu_vec.stride() == 1 && bool("Asynchronous transfers with events require a vector with unit stride"));
+    assert(cpu_vec.size() <= gpu_vec.size() && bool("Size mismatch in async_copy()"));
+
+    if (cpu_vec.size() == 0)
+      return viennacl::ocl::event();
+
+    return viennacl::backend::opencl::memory_write(gpu_vec.handle().opencl_handle(),
+                                                   sizeof(NumericT) * gpu_vec.start(),
+                                                   sizeof(NumericT) * cpu_vec.size(),
+                                                   &(cpu_vec[0]),
+                                                   queue, dependencies);
+  }
+
+  /** @brief Asynchronous transfer from a gpu vector to a cpu vector in the provided OpenCL queue. Returns the event of the transfer.
+  *
+  * The transfer starts after the commands identified by 'dependencies' have completed.
+  * The cpu vector must reside in a linear piece of memory and must not be accessed before the transfer has completed.
+  *
+  * @param gpu_vec       The gpu vector with unit stride, residing in the context of 'queue'
+  * @param cpu_vec       A cpu vector with entries linear in memory (e.g. std::vector). Must not be shorter than the gpu vector.
+  * @param queue         The queue used for the transfer
+  * @param dependencies  Events of commands which need to complete before the transfer starts
+  */
+  template <typename NumericT, typename CPUVECTOR>
+  viennacl::ocl::event async_copy(vector_base<NumericT> const & gpu_vec, CPUVECTOR & cpu_vec,
+                                  viennacl::ocl::command_queue const & queue,
+                                  std::vector<viennacl::ocl::event> const & dependencies = std::vector<viennacl::ocl::event>())
+  {
+    assert(viennacl::traits::active_handle_id(gpu_vec) == viennacl::OPENCL_MEMORY && bool("Asynchronous transfers with events require an OpenCL vector"));
+    assert(gpu_vec.stride() == 1 && bool("Asynchronous transfers with events require a vector with unit stride"));
+    assert(gpu_vec.size() <= cpu_vec.size() && bool("Size mismatch in async_copy()"));
+
+    if (gpu_vec.size() == 0)
+      return viennacl::ocl::event();
+
+    return viennacl::backend::opencl::memory_read(gpu_vec.handle().opencl_handle(),
+                                                  sizeof(NumericT) * gpu_vec.start(),
+                                                  sizeof(NumericT) * gpu_vec.size(),
+                                                  &(cpu_vec[0]),
+                                                  queue, dependencies);
+  }
+#endif
+
   //from cpu to gpu. Safe assumption: cpu_vector does not necessarily occupy a linear memory segment, but is not larger than the allocated memory on the GPU
   /** @brief STL-like transfer for the entries of a GPU vector to the CPU. The cpu type does not need to lie in a linear piece of memory.
   *